@@ -10,6 +10,7 @@
  */
 
 #include "HousingMarket.hpp"
+#include <algorithm>
 #include "workers/Worker.hpp"
 #include "event/LT_EventArgs.hpp"
 #include "message/MessageBus.hpp"
@@ -272,9 +273,11 @@ std::set<BigSerial> HousingMarket::getBTOEntries()
     return btoEntries;
 }
 
-std::unordered_multimap<int, BigSerial>& HousingMarket::getunitsByZoneHousingType()
+const std::vector<BigSerial>& HousingMarket::getUnitsByZoneHousingType(int zoneHousingType) const
 {
-    return unitsByZoneHousingType;
+    static const std::vector<BigSerial> noUnits;
+    auto itr = unitsByZoneHousingType.find(zoneHousingType);
+    return (itr != unitsByZoneHousingType.end()) ? itr->second : noUnits;
 }
             
 const HousingMarket::Entry* HousingMarket::getEntryById(const BigSerial& unitId)
@@ -329,7 +332,7 @@ void HousingMarket::HandleMessage(Message::MessageType type, const Message& mess
                    btoEntries.insert(unitId);
                }
 
-               unitsByZoneHousingType.insert(std::make_pair<int,BigSerial>( msg.entry.getZoneHousingType(), msg.entry.getUnitId()));
+               unitsByZoneHousingType[msg.entry.getZoneHousingType()].push_back(msg.entry.getUnitId());
             }
             break;
         }
@@ -342,13 +345,16 @@ void HousingMarket::HandleMessage(Message::MessageType type, const Message& mess
                 if( entry->isBTO() )
                     btoEntries.erase(entry->getUnitId());
 
-                auto itr = unitsByZoneHousingType.equal_range(entry->getZoneHousingType());
-                for (auto it = itr.first; it != itr.second; it++)
+                //the order of the units does not matter, so the removed unit is replaced by the last one
+                auto itr = unitsByZoneHousingType.find(entry->getZoneHousingType());
+                if (itr != unitsByZoneHousingType.end())
                 {
-                    if (it->second == entry->getUnitId())
+                    std::vector<BigSerial>& units = itr->second;
+                    auto unitItr = std::find(units.begin(), units.end(), entry->getUnitId());
+                    if (unitItr != units.end())
                     {
-                        unitsByZoneHousingType.erase(it);
-                        break;
+                        *unitItr = units.back();
+                        units.pop_back();
                     }
                 }
 
@@ -15,6 +15,7 @@
 #include "entities/Entity.hpp"
 #include "database/entity/Unit.hpp"
 #include <set>
+#include <vector>
 
 namespace sim_mob
 {
@@ -168,7 +169,12 @@ namespace sim_mob
 
             std::set<BigSerial> getBTOEntries();
 
-            std::unordered_multimap<int, BigSerial>& getunitsByZoneHousingType();
+            /**
+             * Gets the units on the market of a zone housing type.
+             * @param zoneHousingType zone housing type id.
+             * @return ids of the units; empty if there are none.
+             */
+            const std::vector<BigSerial>& getUnitsByZoneHousingType(int zoneHousingType) const;
 
 
         protected:
@@ -191,7 +197,7 @@ namespace sim_mob
             EntryMapById entriesByTazId; // only lookup.
 
             std::set<BigSerial> btoEntries;
-            std::unordered_multimap<int, BigSerial>unitsByZoneHousingType;
+            std::unordered_map<int, std::vector<BigSerial> > unitsByZoneHousingType;
 
         };
     }
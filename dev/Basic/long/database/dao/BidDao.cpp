@@ -84,5 +84,14 @@ void BidDao::insertBid(Bid& bid,std::string schema)
 
 }
 
+bool BidDao::insertBids(const std::vector<boost::shared_ptr<Bid> >& bids, std::string schema)
+{
+    const std::vector<std::string> columns = {"bid_id", "simulation_day", "seller_id", "bidder_id", "current_unit_id", "new_unit_id",
+                                               "willingness_to_pay", "wtp_error_term", "affordability_amount", "current_unit_price", "target_price",
+                                               "hedonic_price", "lag_coefficient", "asking_price", "bid_value", "bids_counter", "logsum",
+                                               "unit_floor_area", "unit_type_id", "current_postcode", "new_postcode", "move_in_date", "accepted"};
+    return insertViaCopy(bids, schema + ".bids", columns);
+}
+
 
 
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <boost/shared_ptr.hpp>
 #include "database/dao/SqlAbstractDao.hpp"
 #include "database/entity/Bid.hpp"
 
@@ -40,6 +41,11 @@ namespace sim_mob {
 
         public:
             void insertBid(Bid& bid,std::string schema);
+
+            /*
+             * Inserts the given bids with a single COPY
+             */
+            bool insertBids(const std::vector<boost::shared_ptr<Bid> >& bids, std::string schema);
         };
     }
 }
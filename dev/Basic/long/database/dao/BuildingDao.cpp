@@ -82,3 +82,12 @@ void BuildingDao::insertBuilding(Building& building,std::string schema)
     insertViaQuery(building,DB_INSERT_BUILDING_OP);
 
 }
+
+bool BuildingDao::insertBuildings(const std::vector<boost::shared_ptr<Building> >& buildings, std::string schema)
+{
+    const std::vector<std::string> columns = {"fm_building_id", "fm_project_id", "fm_parcel_id", "storeys_above_ground", "storeys_below_ground",
+                                               "from_date", "to_date", "building_status", "gross_sq_m_res", "gross_sq_m_office",
+                                               "gross_sq_m_retail", "gross_sq_m_other", "last_changed_date", "freehold", "floor_space",
+                                               "building_type"};
+    return insertViaCopy(buildings, schema + ".fm_building", columns);
+}
@@ -10,6 +10,7 @@
  */
 #pragma once
 
+#include <boost/shared_ptr.hpp>
 #include "database/dao/SqlAbstractDao.hpp"
 #include "database/entity/Building.hpp"
 
@@ -50,6 +51,11 @@ namespace sim_mob
             std::vector<Building*> getBuildingsByParcelId(const long long parcelId,std::string schema);
 
             void insertBuilding(Building& building,std::string schema);
+
+            /*
+             * Inserts the given buildings with a single COPY
+             */
+            bool insertBuildings(const std::vector<boost::shared_ptr<Building> >& buildings, std::string schema);
         };
     }
 }
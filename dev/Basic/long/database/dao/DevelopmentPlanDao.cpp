@@ -51,6 +51,13 @@ void DevelopmentPlanDao::insertDevelopmentPlan(DevelopmentPlan& devPlan,std::str
 
 }
 
+bool DevelopmentPlanDao::insertDevelopmentPlans(const std::vector<boost::shared_ptr<DevelopmentPlan> >& devPlans, std::string schema)
+{
+    const std::vector<std::string> columns = {"fm_parcel_id", "development_template_id", "unit_type_id", "num_units", "simulation_date",
+                                               "construction_start_date", "launch_date"};
+    return insertViaCopy(devPlans, schema + ".development_plans", columns);
+}
+
 
 
 
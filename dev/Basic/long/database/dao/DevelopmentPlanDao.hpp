@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <boost/shared_ptr.hpp>
 #include "database/dao/SqlAbstractDao.hpp"
 #include "database/entity/DevelopmentPlan.hpp"
 
@@ -46,6 +47,11 @@ namespace sim_mob
             */
 
             void insertDevelopmentPlan(DevelopmentPlan& devPlan,std::string schema);
+
+            /*
+             * Inserts the given development plans with a single COPY
+             */
+            bool insertDevelopmentPlans(const std::vector<boost::shared_ptr<DevelopmentPlan> >& devPlans, std::string schema);
         };
     }
 }
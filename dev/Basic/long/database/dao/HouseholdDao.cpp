@@ -163,6 +163,17 @@ void HouseholdDao::insertHousehold(Household& houseHold,std::string schema)
 
 }
 
+bool HouseholdDao::insertHouseholds(const std::vector<Household*>& households, std::string schema)
+{
+    const std::vector<std::string> columns = {"hh_id", "lifestyle_id", DB_FIELD_UNIT_ID, DB_FIELD_ETHNICITY_ID, DB_FIELD_VEHICLE_CATEGORY_ID,
+                                               DB_FIELD_SIZE, DB_FIELD_CHILDUNDER4, DB_FIELD_CHILDUNDER15, "num_adults", DB_FIELD_INCOME,
+                                               DB_FIELD_HOUSING_DURATION, "workers", "age_of_head", "pending_status_id", "pending_from_date",
+                                               "unit_pending", "taxi_availability", "vehicle_ownership_option_id", "time_on_market",
+                                               "time_off_market", "is_bidder", "is_seller", "buy_sell_interval", "tenure_status", "awakened_day",
+                                               "last_bid_status"};
+    return insertViaCopy(households, schema + ".household", columns);
+}
+
 std::vector<Household*> HouseholdDao::getPendingHouseholds(std::tm currentSimYear,std::tm lastDayOfCurrentSimYear)
 {
     const std::string DB_GETALL_PENDING_HH = "SELECT * FROM " + connection.getSchema() + "household" + " WHERE  pending_status_id = 1 and  pending_from_date >= :v1 and pending_from_date  < :v2 and tenure_status <> 3";
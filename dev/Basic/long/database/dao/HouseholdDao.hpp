@@ -43,6 +43,11 @@ namespace sim_mob {
 
         public:
             void insertHousehold(Household& houseHold,std::string schema);
+
+            /*
+             * Inserts the given households, which do not exist on the datasource yet, with a single COPY
+             */
+            bool insertHouseholds(const std::vector<Household*>& households, std::string schema);
             std::vector<Household*> getPendingHouseholds(std::tm currentSimYear,std::tm lastDayOfCurrentSimYear);
         };
     }
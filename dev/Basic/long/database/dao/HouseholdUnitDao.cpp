@@ -37,6 +37,12 @@ void HouseholdUnitDao::insertHouseholdUnit(HouseholdUnit& houseHold,std::string
     insertViaQuery(houseHold,DB_INSERT_HOUSEHOLD_UNIT);
 }
 
+bool HouseholdUnitDao::insertHouseholdUnits(const std::vector<boost::shared_ptr<HouseholdUnit> >& householdUnits, std::string schema)
+{
+    const std::vector<std::string> columns = {"household_id", "unit_id", "move_in_date"};
+    return insertViaCopy(householdUnits, schema + ".household_unit", columns);
+}
+
 
 
 
@@ -6,6 +6,7 @@
  */
 
 #pragma once
+#include <boost/shared_ptr.hpp>
 #include "database/dao/SqlAbstractDao.hpp"
 #include "database/entity/HouseholdUnit.hpp"
 
@@ -40,6 +41,11 @@ namespace sim_mob {
 
         public:
             void insertHouseholdUnit(HouseholdUnit& houseHoldUnit,std::string schema);
+
+            /*
+             * Inserts the given household units with a single COPY
+             */
+            bool insertHouseholdUnits(const std::vector<boost::shared_ptr<HouseholdUnit> >& householdUnits, std::string schema);
         };
     }
 }
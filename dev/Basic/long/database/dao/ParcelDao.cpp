@@ -112,6 +112,16 @@ void ParcelDao::insertParcel(Parcel& parcel,std::string schema)
 
 }
 
+bool ParcelDao::insertParcels(const std::vector<boost::shared_ptr<Parcel> >& parcels, std::string schema)
+{
+    const std::vector<std::string> columns = {"fm_parcel_id", "taz_id", "lot_size", "gpr", "land_use_type_id", "owner_name", "owner_category",
+                                               "last_transaction_date", "last_transaction_type_total", "psm_per_gps", "lease_type",
+                                               "lease_start_date", "centroid_x", "centroid_y", "award_date", "award_status", "use_restriction",
+                                               "development_type_code", "successful_tender_id", "successful_tender_price", "tender_closing_date",
+                                               "lease", "development_status", "development_allowed", "next_available_date", "last_changed_date"};
+    return insertViaCopy(parcels, schema + ".fm_parcel", columns);
+}
+
 std::vector<Parcel*> ParcelDao::getFreeholdParcels()
 {
     const std::string queryStr = "SELECT P.* FROM " + connection.getSchema() + "fm_parcel P," + connection.getSchema() +  "fm_building B" + " WHERE p.fm_parcel_id = b.fm_parcel_id and freehold = 1";
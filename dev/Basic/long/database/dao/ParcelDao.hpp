@@ -9,6 +9,7 @@
  * Created on Mar 10, 2014, 5:17 PM
  */
 #pragma once
+#include <boost/shared_ptr.hpp>
 #include "database/dao/SqlAbstractDao.hpp"
 #include "database/entity/Parcel.hpp"
 
@@ -56,6 +57,11 @@ namespace sim_mob {
 
             void insertParcel(Parcel& parcel,std::string schema);
 
+            /*
+             * Inserts the given parcels with a single COPY
+             */
+            bool insertParcels(const std::vector<boost::shared_ptr<Parcel> >& parcels, std::string schema);
+
             /*
              * Get the parcels with freehold buildings as a vector
              */
@@ -68,6 +68,14 @@ void ProjectDao::insertProject(Project& project,std::string schema)
 
 }
 
+bool ProjectDao::insertProjects(const std::vector<boost::shared_ptr<Project> >& projects, std::string schema)
+{
+    const std::vector<std::string> columns = {"fm_project_id", "fm_parcel_id", "developer_id", "template_id", "project_name", "construction_date",
+                                               "completion_date", "construction_cost", "demolition_cost", "total_cost", "fm_lot_size",
+                                               "gross_ratio", "gross_area", "planned_date", "project_status"};
+    return insertViaCopy(projects, schema + ".fm_project", columns);
+}
+
 std::vector<Project*> ProjectDao::loadOngoingProjects(std::string schema)
 {
     const std::string queryStr = "SELECT * FROM " + schema + "fm_project  where project_status =  'Active'";
@@ -6,6 +6,7 @@
  */
 #pragma once
 
+#include <boost/shared_ptr.hpp>
 #include "database/dao/SqlAbstractDao.hpp"
 #include "database/entity/Project.hpp"
 
@@ -37,6 +38,11 @@ namespace sim_mob {
 
         public:
             void insertProject(Project& project,std::string schema);
+
+            /*
+             * Inserts the given projects with a single COPY
+             */
+            bool insertProjects(const std::vector<boost::shared_ptr<Project> >& projects, std::string schema);
             std::vector<Project*> loadOngoingProjects(std::string schema);
         };
     }
@@ -140,6 +140,15 @@ void UnitDao::insertUnit(Unit& unit,std::string schema)
 
 }
 
+bool UnitDao::insertUnits(const std::vector<Unit*>& units, std::string schema)
+{
+    const std::vector<std::string> columns = {"fm_unit_id", "fm_building_id", "unit_type", "storey_range", "construction_status", "floor_area",
+                                               "storey", "monthly_rent", "sale_from_date", "occupancy_from_date", "sale_status", "occupancy_status",
+                                               "last_changed_date", "total_price", "bto_price", "value_date", "tenure_status", "time_on_market",
+                                               "time_off_market", "bidding_market_entry_day", "asking_price"};
+    return insertViaCopy(units, schema + ".fm_unit_res", columns);
+}
+
 std::vector<Unit*> UnitDao::getUnitsByBuildingId(const long long buildingId,std::string schema)
 {
     const std::string DB_GET_UNITS_BY_BUILDINGID      = "SELECT * FROM " + schema + ".fm_unit_res" + " WHERE fm_buildingl_id = :v1;";
@@ -45,6 +45,11 @@ namespace sim_mob {
 
             void insertUnit(Unit& unit,std::string schema);
 
+            /*
+             * Inserts the given units, which do not exist on the datasource yet, with a single COPY
+             */
+            bool insertUnits(const std::vector<Unit*>& units, std::string schema);
+
             /*
              * Get the units of given building id
              */
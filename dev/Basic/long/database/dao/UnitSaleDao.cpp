@@ -51,5 +51,12 @@ void UnitSaleDao::insertUnitSale(UnitSale& unitSale,std::string schema)
 
 }
 
+bool UnitSaleDao::insertUnitSales(const std::vector<boost::shared_ptr<UnitSale> >& unitSales, std::string schema)
+{
+    const std::vector<std::string> columns = {"unit_sale_id", "unit_id", "buyer_id", "seller_id", "unit_price", "transaction_day",
+                                               "days_on_market_unit", "days_on_market_bidder"};
+    return insertViaCopy(unitSales, schema + ".unit_sale", columns);
+}
+
 
 
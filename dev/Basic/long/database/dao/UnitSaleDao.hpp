@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <boost/shared_ptr.hpp>
 #include "database/dao/SqlAbstractDao.hpp"
 #include "database/entity/UnitSale.hpp"
 
@@ -40,6 +41,11 @@ namespace sim_mob {
 
         public:
             void insertUnitSale(UnitSale& bid,std::string schema);
+
+            /*
+             * Inserts the given unit sales with a single COPY
+             */
+            bool insertUnitSales(const std::vector<boost::shared_ptr<UnitSale> >& unitSales, std::string schema);
         };
     }
 }
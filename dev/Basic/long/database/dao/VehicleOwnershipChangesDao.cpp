@@ -41,6 +41,12 @@ void VehicleOwnershipChangesDao::insertVehicleOwnershipChanges(VehicleOwnershipC
 
 }
 
+bool VehicleOwnershipChangesDao::insertVehicleOwnershipChangesList(const std::vector<boost::shared_ptr<VehicleOwnershipChanges> >& vehicleOwnershipChanges, std::string schema)
+{
+    const std::vector<std::string> columns = {"household_id", "old_vehicle_ownership_option_id", "new_vehicle_ownership_option_id", "start_date"};
+    return insertViaCopy(vehicleOwnershipChanges, schema + ".vehicle_ownership_changes", columns);
+}
+
 
 
 
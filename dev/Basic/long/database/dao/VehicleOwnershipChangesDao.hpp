@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <boost/shared_ptr.hpp>
 #include "database/dao/SqlAbstractDao.hpp"
 #include "database/entity/VehicleOwnershipChanges.hpp"
 
@@ -46,6 +47,11 @@ namespace sim_mob
             */
 
             void insertVehicleOwnershipChanges(VehicleOwnershipChanges& devPlan,std::string schema);
+
+            /*
+             * Inserts the given vehicle ownership changes with a single COPY
+             */
+            bool insertVehicleOwnershipChangesList(const std::vector<boost::shared_ptr<VehicleOwnershipChanges> >& vehicleOwnershipChanges, std::string schema);
         };
     }
 }
@@ -9,6 +9,7 @@
  */
 
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <ctime>
@@ -17,6 +18,8 @@
 #include "GenConfig.h"
 //#include "tinyxml.h"
 #include <boost/format.hpp>
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
 #include "conf/ConfigManager.hpp"
 #include "conf/ConfigParams.hpp"
 #include "conf/ParseConfigFile.hpp"
@@ -120,6 +123,104 @@ void createOutputSchema(db::DB_Connection& conn,const std::string& currentOutput
 
 }
 
+/**
+ * Write of an output table, named for the report of its failure.
+ */
+typedef std::pair<std::string, boost::function<bool ()> > TableWrite;
+
+/**
+ * Executes the given writes concurrently, each on a thread of its own (the rows are copied over a connection per table).
+ * Throws if any of them fails, once all are completed.
+ */
+void writeTablesConcurrently(const std::vector<TableWrite>& writes)
+{
+    std::vector<char> written(writes.size(), 0);
+    boost::thread_group writers;
+    for (size_t i = 0; i < writes.size(); i++)
+    {
+        writers.create_thread([&writes, &written, i]()
+        {
+            try
+            {
+                written[i] = writes[i].second();
+            }
+            catch (std::exception& ex)
+            {
+                PrintOutV("Writing of " << writes[i].first << " failed: " << ex.what() << endl);
+            }
+        });
+    }
+    writers.join_all();
+
+    for (size_t i = 0; i < writes.size(); i++)
+    {
+        if (!written[i])
+        {
+            throw std::runtime_error("failed to write the output table " + writes[i].first);
+        }
+    }
+}
+
+/**
+ * Rows added by the housing market model during the simulation, taken from it to be written to the output schema.
+ */
+struct OutputRows
+{
+    std::vector<boost::shared_ptr<Bid> > bids;
+    std::vector<boost::shared_ptr<UnitSale> > unitSales;
+    std::vector<boost::shared_ptr<HouseholdUnit> > householdUnits;
+    std::vector<boost::shared_ptr<VehicleOwnershipChanges> > vehicleOwnershipChanges;
+};
+
+/**
+ * Takes the rows added by the housing market model since they were last written, and adds their writes to the given list.
+ * The rows must outlive the writes.
+ */
+void addOutputRowWrites(db::DB_Connection& conn, const std::string& currentOutputSchema, HM_Model& housingMarketModel, OutputRows& rows,
+                        std::vector<TableWrite>& writes)
+{
+    housingMarketModel.takeOutputRows(rows.bids, rows.unitSales, rows.householdUnits, rows.vehicleOwnershipChanges);
+
+    writes.push_back(TableWrite("bids", [&conn, &currentOutputSchema, &rows]()
+    {
+        BidDao bidDao(conn);
+        return bidDao.insertBids(rows.bids, currentOutputSchema);
+    }));
+    writes.push_back(TableWrite("unit_sale", [&conn, &currentOutputSchema, &rows]()
+    {
+        UnitSaleDao unitSaleDao(conn);
+        return unitSaleDao.insertUnitSales(rows.unitSales, currentOutputSchema);
+    }));
+    writes.push_back(TableWrite("household_unit", [&conn, &currentOutputSchema, &rows]()
+    {
+        HouseholdUnitDao hhUnitDao(conn);
+        return hhUnitDao.insertHouseholdUnits(rows.householdUnits, currentOutputSchema);
+    }));
+    writes.push_back(TableWrite("vehicle_ownership_changes", [&conn, &currentOutputSchema, &rows]()
+    {
+        VehicleOwnershipChangesDao vehOwnChangeDao(conn);
+        return vehOwnChangeDao.insertVehicleOwnershipChangesList(rows.vehicleOwnershipChanges, currentOutputSchema);
+    }));
+}
+
+/**
+ * Writes the rows added by the housing market model since they were last written to the output schema, and releases them.
+ */
+void flushOutputRows(db::DB_Connection& conn, const std::string& currentOutputSchema, HM_Model& housingMarketModel)
+{
+    if(conn.isConnected())
+    {
+        OutputRows rows;
+        std::vector<TableWrite> writes;
+        addOutputRowWrites(conn, currentOutputSchema, housingMarketModel, rows, writes);
+        writeTablesConcurrently(writes);
+
+        PrintOutV("Flushed to the output schema: " << rows.bids.size() << " bids, " << rows.unitSales.size() << " unit sales, "
+                  << rows.householdUnits.size() << " household units, " << rows.vehicleOwnershipChanges.size()
+                  << " vehicle ownership changes" << endl);
+    }
+}
+
 void loadDataToOutputSchema(db::DB_Connection& conn,std::string &currentOutputSchema,BigSerial simVersionId,int simStoppedTick,DeveloperModel &developerModel,HM_Model &housingMarketModel)
 {
     ConfigParams& config = ConfigManager::GetInstanceRW().FullConfig();
@@ -143,74 +244,48 @@ void loadDataToOutputSchema(db::DB_Connection& conn,std::string &currentOutputSc
         simStartPointDao.insertSimulationStartPoint(*simStartPointObj.get(),currentOutputSchema);
 
         std::vector<boost::shared_ptr<Building> > buildings = developerModel.getBuildingsVec();
-        std::vector<boost::shared_ptr<Building> >::iterator buildingsItr;
-        BuildingDao buildingDao(conn);
-        for(buildingsItr = buildings.begin(); buildingsItr != buildings.end(); ++buildingsItr)
-        {
-            buildingDao.insertBuilding(*(*buildingsItr),currentOutputSchema);
-        }
-
         std::vector<boost::shared_ptr<Parcel> > parcels = developerModel.getProfitableParcelsVec();
-        std::vector<boost::shared_ptr<Parcel> >::iterator parcelsItr;
-        ParcelDao parcelDao(conn,"fm_parcel");
-        for(parcelsItr = parcels.begin(); parcelsItr != parcels.end(); ++parcelsItr)
-        {
-            parcelDao.insertParcel(*(*parcelsItr),currentOutputSchema);
-        }
+        std::vector<boost::shared_ptr<Project> > projects = developerModel.getProjectsVec();
+        std::vector<boost::shared_ptr<DevelopmentPlan> > devPlans = developerModel.getDevelopmentPlansVec();
 
+        //units and households which already exist on the output schema are updated (once the new rows are written), the others are inserted
         std::vector<boost::shared_ptr<Unit> > units = developerModel.getUnitsVec();
         std::vector<boost::shared_ptr<Unit> >::iterator unitsItr;
-        UnitDao unitDao(conn);
+        std::vector<Unit*> newUnits;
+        std::vector<Unit*> existingUnits;
         for(unitsItr = units.begin(); unitsItr != units.end(); ++unitsItr)
         {
-            unitDao.insertUnit(*(*unitsItr),currentOutputSchema);
-        }
-
-
-        std::vector<boost::shared_ptr<Project> > projects = developerModel.getProjectsVec();
-        std::vector<boost::shared_ptr<Project> >::iterator projectsItr;
-        ProjectDao projectDao(conn);
-        for(projectsItr = projects.begin(); projectsItr != projects.end(); ++projectsItr)
-        {
-            projectDao.insertProject(*(*projectsItr),currentOutputSchema);
-        }
-
-        std::vector<boost::shared_ptr<Bid> > bids = housingMarketModel.getNewBids();
-        std::vector<boost::shared_ptr<Bid> >::iterator bidsItr;
-        BidDao bidDao(conn);
-        for(bidsItr = bids.begin(); bidsItr != bids.end(); ++bidsItr)
-        {
-            bidDao.insertBid(*(*bidsItr),currentOutputSchema);
-        }
-
-        std::vector<boost::shared_ptr<UnitSale> > unitSales = housingMarketModel.getUnitSales();
-        std::vector<boost::shared_ptr<UnitSale> >::iterator unitSalesItr;
-        UnitSaleDao unitSaleDao(conn);
-        for(unitSalesItr = unitSales.begin(); unitSalesItr != unitSales.end(); ++unitSalesItr)
-        {
-            unitSaleDao.insertUnitSale(*(*unitSalesItr),currentOutputSchema);
-        }
-
-        std::vector<boost::shared_ptr<DevelopmentPlan> > devPlans = developerModel.getDevelopmentPlansVec();
-        std::vector<boost::shared_ptr<DevelopmentPlan> >::iterator devPlansItr;
-        DevelopmentPlanDao devPlanDao(conn);
-        for(devPlansItr = devPlans.begin(); devPlansItr != devPlans.end(); ++devPlansItr)
-        {
-            devPlanDao.insertDevelopmentPlan(*(*devPlansItr),currentOutputSchema);
+            if((*unitsItr)->isExistInDb())
+            {
+                existingUnits.push_back(unitsItr->get());
+            }
+            else
+            {
+                newUnits.push_back(unitsItr->get());
+            }
         }
 
-        std::vector<boost::shared_ptr<VehicleOwnershipChanges> > vehicleOwnershipChanges = housingMarketModel.getVehicleOwnershipChanges();
-        std::vector<boost::shared_ptr<VehicleOwnershipChanges> >::iterator vehOwnChangeItr;
-        VehicleOwnershipChangesDao vehOwnChangeDao(conn);
-        for(vehOwnChangeItr = vehicleOwnershipChanges.begin(); vehOwnChangeItr != vehicleOwnershipChanges.end(); ++vehOwnChangeItr)
+        HM_Model::UnitList updatedUnits = housingMarketModel.getUnits();
+        updatedUnits.resize(100);
+        HM_Model::UnitList::iterator updatedUnitsItr;
+        for(updatedUnitsItr = updatedUnits.begin(); updatedUnitsItr != updatedUnits.end(); ++updatedUnitsItr)
         {
-            vehOwnChangeDao.insertVehicleOwnershipChanges(*(*vehOwnChangeItr),currentOutputSchema);
+            (*updatedUnitsItr)->setTimeOnMarket((*updatedUnitsItr)->getRemainingTimeOnMarket());
+            (*updatedUnitsItr)->setTimeOffMarket((*updatedUnitsItr)->getRemainingTimeOffMarket());
+            if((*updatedUnitsItr)->isExistInDb())
+            {
+                existingUnits.push_back(*updatedUnitsItr);
+            }
+            else
+            {
+                newUnits.push_back(*updatedUnitsItr);
+            }
         }
 
-        HouseholdDao hhDao(conn);
-
         HM_Model::HouseholdList *households = housingMarketModel.getHouseholdList();
         HM_Model::HouseholdList::iterator houseHoldItr;
+        std::vector<Household*> newHouseholds;
+        std::vector<Household*> existingHouseholds;
         for(houseHoldItr = households->begin(); houseHoldItr != households->end(); ++houseHoldItr)
         {
 
@@ -220,25 +295,66 @@ void loadDataToOutputSchema(db::DB_Connection& conn,std::string &currentOutputSc
                     {
                         (*houseHoldItr)->setExistInDB(true);
                     }
-                    hhDao.insertHousehold(*(*houseHoldItr),currentOutputSchema);
+
+                    if((*houseHoldItr)->getExistInDB())
+                    {
+                        existingHouseholds.push_back(*houseHoldItr);
+                    }
+                    else
+                    {
+                        newHouseholds.push_back(*houseHoldItr);
+                    }
                 }
         }
 
-        std::vector<boost::shared_ptr<HouseholdUnit> > hhUnits = housingMarketModel.getNewHouseholdUnits();
-        HouseholdUnitDao hhUnitDao(conn);
-        for (boost::shared_ptr<HouseholdUnit> hhUnit :hhUnits)
+        //each table is copied concurrently over a connection of its own
+        OutputRows rows;
+        std::vector<TableWrite> writes;
+        writes.push_back(TableWrite("fm_building", [&conn, &currentOutputSchema, &buildings]()
+        {
+            BuildingDao buildingDao(conn);
+            return buildingDao.insertBuildings(buildings, currentOutputSchema);
+        }));
+        writes.push_back(TableWrite("fm_parcel", [&conn, &currentOutputSchema, &parcels]()
+        {
+            ParcelDao parcelDao(conn,"fm_parcel");
+            return parcelDao.insertParcels(parcels, currentOutputSchema);
+        }));
+        writes.push_back(TableWrite("fm_unit_res", [&conn, &currentOutputSchema, &newUnits]()
+        {
+            UnitDao unitDao(conn);
+            return unitDao.insertUnits(newUnits, currentOutputSchema);
+        }));
+        writes.push_back(TableWrite("fm_project", [&conn, &currentOutputSchema, &projects]()
+        {
+            ProjectDao projectDao(conn);
+            return projectDao.insertProjects(projects, currentOutputSchema);
+        }));
+        writes.push_back(TableWrite("development_plans", [&conn, &currentOutputSchema, &devPlans]()
         {
-            hhUnitDao.insertHouseholdUnit(*hhUnit,currentOutputSchema);
+            DevelopmentPlanDao devPlanDao(conn);
+            return devPlanDao.insertDevelopmentPlans(devPlans, currentOutputSchema);
+        }));
+        writes.push_back(TableWrite("household", [&conn, &currentOutputSchema, &newHouseholds]()
+        {
+            HouseholdDao hhDao(conn);
+            return hhDao.insertHouseholds(newHouseholds, currentOutputSchema);
+        }));
+        addOutputRowWrites(conn, currentOutputSchema, housingMarketModel, rows, writes);
+        writeTablesConcurrently(writes);
+
+        UnitDao unitDao(conn);
+        std::vector<Unit*>::iterator existingUnitsItr;
+        for(existingUnitsItr = existingUnits.begin(); existingUnitsItr != existingUnits.end(); ++existingUnitsItr)
+        {
+            unitDao.insertUnit(*(*existingUnitsItr),currentOutputSchema);
         }
 
-        HM_Model::UnitList updatedUnits = housingMarketModel.getUnits();
-        updatedUnits.resize(100);
-        HM_Model::UnitList::iterator updatedUnitsItr;
-        for(updatedUnitsItr = updatedUnits.begin(); updatedUnitsItr != updatedUnits.end(); ++updatedUnitsItr)
+        HouseholdDao hhDao(conn);
+        std::vector<Household*>::iterator existingHouseholdsItr;
+        for(existingHouseholdsItr = existingHouseholds.begin(); existingHouseholdsItr != existingHouseholds.end(); ++existingHouseholdsItr)
         {
-            (*updatedUnitsItr)->setTimeOnMarket((*updatedUnitsItr)->getRemainingTimeOnMarket());
-            (*updatedUnitsItr)->setTimeOffMarket((*updatedUnitsItr)->getRemainingTimeOffMarket());
-            unitDao.insertUnit(*(*updatedUnitsItr),currentOutputSchema);
+            hhDao.insertHousehold(*(*existingHouseholdsItr),currentOutputSchema);
         }
 
         SimulationStoppedPointDao simStoppedPointDao(conn);
@@ -265,6 +381,7 @@ void performMain(int simulationNumber, std::list<std::string>& resLogFiles)
 
     const unsigned int timeIntervalDevModel = config.ltParams.developerModel.timeInterval;
     unsigned int opSchemaloadingInterval = config.ltParams.opSchemaloadingInterval;
+    const unsigned int opSchemaFlushInterval = config.ltParams.opSchemaFlushInterval;
 
     int lastStoppedDay = 0;
     int simStoppedTick = 0;
@@ -404,6 +521,7 @@ void performMain(int simulationNumber, std::list<std::string>& resLogFiles)
         PrintOutV("XML Config resume " << config.ltParams.resume << endl);
         PrintOutV("XML Config currentOutputSchema " << config.ltParams.currentOutputSchema << endl);
         PrintOutV("XML Config opSchemaloadingInterval " << config.ltParams.opSchemaloadingInterval << endl);
+        PrintOutV("XML Config opSchemaFlushInterval " << config.ltParams.opSchemaFlushInterval << endl);
         PrintOutV("XML Config initialLoading " << config.ltParams.initialLoading << endl);
         PrintOutV("XML Config launch BTO " << config.ltParams.launchBTO << endl);
         PrintOutV("XML Config launch private presale " << config.ltParams.launchPrivatePresale << endl);
@@ -485,7 +603,9 @@ void performMain(int simulationNumber, std::list<std::string>& resLogFiles)
         for (unsigned int currTick = currentTick; currTick < days; currTick++)
         {
             simStoppedTick = currTick;
-            if(((currTick+1) == opSchemaloadingInterval) && (!resume))
+            //when the rows are flushed, the output schema is needed from the first day
+            const bool createOpSchema = (opSchemaFlushInterval > 0) ? (currTick == currentTick) : ((currTick+1) == opSchemaloadingInterval);
+            if(createOpSchema && (!resume))
             {
                 createOutputSchema(conn,currentOutputSchema);
             }
@@ -555,6 +675,10 @@ void performMain(int simulationNumber, std::list<std::string>& resLogFiles)
             {
                 loadDataToOutputSchema(conn,currentOutputSchema,simVersionId,simStoppedTick,*developerModel,*housingMarketModel);
             }
+            else if((opSchemaFlushInterval > 0) && ((currTick+1)%opSchemaFlushInterval == 0))
+            {
+                flushOutputRows(conn,currentOutputSchema,*housingMarketModel);
+            }
 
             PrintOutV(" Day " << currTick
                                        << " HUnits: " << std::dec << (dynamic_cast<HM_Model*>(models[0]))->getMarket()->getEntrySize(currTick)
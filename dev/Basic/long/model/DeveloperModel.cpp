@@ -12,6 +12,7 @@
 #include "DeveloperModel.hpp"
 #include "util/LangHelpers.hpp"
 #include "util/HelperFunctions.hpp"
+#include "util/ParallelTableLoader.hpp"
 #include "agent/impl/DeveloperAgent.hpp"
 #include "core/AgentsLookup.hpp"
 #include "database/DB_Connection.hpp"
@@ -88,18 +89,9 @@ void DeveloperModel::startImpl() {
     conn.setSchema(config.schemas.main_schema);
     conn.connect();
 
-    DB_Connection conn_calibration(sim_mob::db::POSTGRES, dbConfig);
-    conn_calibration.setSchema(config.schemas.calibration_schema);
-    conn_calibration.connect();
-
     const std::string parcelTable = config.ltParams.scenario.parcelsTable;
     const std::string scenarioSchema = config.ltParams.scenario.scenarioSchema;
 
-    //config the db connection based on the scenario.
-    DB_Connection conn_scenario(sim_mob::db::POSTGRES, dbConfig);
-    conn_scenario.setSchema(scenarioSchema);
-    conn_scenario.connect();
-
     if (conn.isConnected())
     {
         ParcelsWithHDB *HDB_Parcel = nullptr;
@@ -117,60 +109,74 @@ void DeveloperModel::startImpl() {
             PrintOutV("parcelsWithHDB loaded from disk"<<parcelsWithHDB.size() << std::endl );
         }
 
+        //The tables are loaded concurrently.
+        const std::string mainSchema = config.schemas.main_schema;
+        const std::string calibrationSchema = config.schemas.calibration_schema;
+        ParallelTableLoader loader(dbConfig, config.ltParams.dbLoadingConnections);
+
         //Load developers
-        //loadData<DeveloperDao>(conn, developers);
+        //loader.addTable<DeveloperDao>("developers", mainSchema, developers);
         //Load templates
-        loadData<TemplateDao>(conn, templates);
+        loader.addTable<TemplateDao>("templates", mainSchema, templates);
         //Load parcels
-        loadData<ParcelDao>(conn_scenario, parcelTable, initParcelList, parcelsById, &Parcel::getId);
-        ParcelDao parcelDao(conn,parcelTable);
-        emptyParcels = parcelDao.getEmptyParcels();
-        //Index all empty parcels.
-        for (ParcelList::iterator it = emptyParcels.begin(); it != emptyParcels.end(); it++) {
-            emptyParcelsById.insert(std::make_pair((*it)->getId(), *it));
-        }
+        loader.add("parcels", scenarioSchema, [this, parcelTable](DB_Connection& conn) -> size_t
+        {
+            loadData<ParcelDao>(conn, parcelTable, initParcelList, parcelsById, &Parcel::getId);
+            return initParcelList.size();
+        });
 
-        freeholdParcels = parcelDao.getFreeholdParcels();
-        //Index all freehold parcels.
-        for (ParcelList::iterator it = freeholdParcels.begin(); it != freeholdParcels.end(); it++) {
-            freeholdParcelsById.insert(std::make_pair((*it)->getId(), *it));
-        }
+        loader.add("empty parcels", mainSchema, [this, parcelTable](DB_Connection& conn) -> size_t
+        {
+            ParcelDao parcelDao(conn,parcelTable);
+            emptyParcels = parcelDao.getEmptyParcels();
+            //Index all empty parcels.
+            indexData(emptyParcels, emptyParcelsById, &Parcel::getId);
+            return emptyParcels.size();
+        });
+
+        loader.add("freehold parcels", mainSchema, [this, parcelTable](DB_Connection& conn) -> size_t
+        {
+            ParcelDao parcelDao(conn,parcelTable);
+            freeholdParcels = parcelDao.getFreeholdParcels();
+            //Index all freehold parcels.
+            indexData(freeholdParcels, freeholdParcelsById, &Parcel::getId);
+            return freeholdParcels.size();
+        });
+
+        loader.add("postcodes by taz", mainSchema, [this](DB_Connection& conn) -> size_t
+        {
+            PostcodeDao postcodeDao(conn);
+            postcodes = postcodeDao.getPostcodeByTaz();
+            indexData(postcodes, postcodeByTaz, &Postcode::getTazId);
+            return postcodes.size();
+        });
 
-        PostcodeDao postcodeDao(conn);
-        postcodes = postcodeDao.getPostcodeByTaz();
-        for (PostcodeList::iterator it = postcodes.begin(); it != postcodes.end(); it++) {
-            postcodeByTaz.insert(std::make_pair((*it)->getTazId(), *it));
-        }
         //load DevelopmentType-Templates
-        loadData<DevelopmentTypeTemplateDao>(conn, developmentTypeTemplates);
+        loader.addTable<DevelopmentTypeTemplateDao>("development type templates", mainSchema, developmentTypeTemplates);
         //load Template - UnitType
-        loadData<TemplateUnitTypeDao>(conn, templateUnitTypes);
+        loader.addTable<TemplateUnitTypeDao>("template unit types", mainSchema, templateUnitTypes);
         //load the unit types
-        loadData<UnitTypeDao>(conn, unitTypes, unitTypeById,&UnitType::getId);
+        loader.addTable<UnitTypeDao>("unit types", mainSchema, unitTypes, unitTypeById, &UnitType::getId);
         //load buildings
-        loadData<BuildingDao>(conn,buildings);
+        loader.addTable<BuildingDao>("buildings", mainSchema, buildings);
 
-        loadData<ParcelAmenitiesDao>(conn,amenities,amenitiesById,&ParcelAmenities::getFmParcelId);
+        loader.addTable<ParcelAmenitiesDao>("parcel amenities", mainSchema, amenities, amenitiesById, &ParcelAmenities::getFmParcelId);
 
-        loadData<MacroEconomicsDao>(conn,macroEconomics,macroEconomicsById,&MacroEconomics::getExFactorId);
+        loader.addTable<MacroEconomicsDao>("macro economics", mainSchema, macroEconomics, macroEconomicsById, &MacroEconomics::getExFactorId);
 
         //commented as this is not used in 2012 now.
-        //loadData<LogsumForDevModelDao>(conn,accessibilityList,accessibilityByTazId,&LogsumForDevModel::gettAZ2012Id);
+        //loader.addTable<LogsumForDevModelDao>("logsums for developer model", mainSchema, accessibilityList, accessibilityByTazId, &LogsumForDevModel::gettAZ2012Id);
 
-        //loadData<TAO_Dao>(conn_calibration,taoList,taoByQuarterStr,&TAO::getQuarter);
-        //PrintOutV("TAO by quarters loaded " << taoList.size() << std::endl);
-        loadTAO(conn_calibration);
+        loader.add("tao by quarters", calibrationSchema, [this](DB_Connection& conn) -> size_t { loadTAO(conn); return taoList.size(); });
 
-        loadData<UnitPriceSumDao>(conn,unitPriceSumList,unitPriceSumByParcelId,&UnitPriceSum::getFmParcelId);
-        PrintOutV("unit price sums loaded " << unitPriceSumList.size() << std::endl);
+        loader.addTable<UnitPriceSumDao>("unit price sums", mainSchema, unitPriceSumList, unitPriceSumByParcelId, &UnitPriceSum::getFmParcelId);
+        loader.addTable<TazLevelLandPriceDao>("land values", calibrationSchema, tazLevelLandPriceList, tazLevelLandPriceByTazId, &TazLevelLandPrice::getTazId);
+        loader.addTable<BuildingAvgAgePerParcelDao>("building average age per parcel", mainSchema, buildingAvgAgePerParcel, BuildingAvgAgeByParceld, &BuildingAvgAgePerParcel::getFmParcelId);
+        loader.addTable<ROILimitsDao>("roi limits", calibrationSchema, roiLimits, roiLimitsByDevTypeId, &ROILimits::getDevelopmentTypeId);
 
-        loadData<TazLevelLandPriceDao>(conn_calibration,tazLevelLandPriceList,tazLevelLandPriceByTazId,&TazLevelLandPrice::getTazId);
-        PrintOutV("land values loaded " << tazLevelLandPriceList.size() << std::endl);
+        loader.run();
 
-        loadData<BuildingAvgAgePerParcelDao>(conn,buildingAvgAgePerParcel,BuildingAvgAgeByParceld,&BuildingAvgAgePerParcel::getFmParcelId);
-        PrintOutV("building average age per parcel loaded " << buildingAvgAgePerParcel.size() << std::endl);
-        loadData<ROILimitsDao>(conn_calibration,roiLimits,roiLimitsByDevTypeId,&ROILimits::getDevelopmentTypeId);
-        PrintOutV("roi limits loaded " << roiLimits.size() << std::endl);
+        ParcelDao parcelDao(conn,parcelTable);
 
         std::tm currentSimYear = getDateBySimDay(simYear,0);
         UnitDao unitDao(conn);
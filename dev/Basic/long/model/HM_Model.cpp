@@ -63,6 +63,7 @@
 #include "core/DataManager.hpp"
 #include "core/AgentsLookup.hpp"
 #include "util/HelperFunctions.hpp"
+#include "util/ParallelTableLoader.hpp"
 #include "conf/ConfigManager.hpp"
 #include "conf/ConfigParams.hpp"
 #include "message/LT_Message.hpp"
@@ -1507,44 +1508,68 @@ void HM_Model::startImpl()
         loadStudyAreas(conn);
         loadResidentialWTP_Coeffs(conn_calibration);
 
-        loadData<ScreeningModelFactorsDao>( conn_calibration, screeningModelFactorsList, screeningModelFactorsMap, &ScreeningModelFactors::getId );
-        PrintOutV("Number of screening Model Factors: " << screeningModelFactorsList.size() << std::endl );
+        //The tables are loaded concurrently; loads which use the data of others depend on them.
+        const std::string mainSchema = config.schemas.main_schema;
+        const std::string calibrationSchema = config.schemas.calibration_schema;
+        ParallelTableLoader loader(dbConfig, config.ltParams.dbLoadingConnections);
 
+        loader.addTable<ScreeningModelFactorsDao>("screening model factors", calibrationSchema, screeningModelFactorsList, screeningModelFactorsMap, &ScreeningModelFactors::getId);
+
+        std::tm currentSimYear = getDateBySimDay(simYear,0);
+        std::tm lastDayOfCurrentSimYear = getDateBySimDay(simYear,364);
 
         if(config.ltParams.schoolAssignmentModel.enabled)
         {
-            loadSchools(conn);
-            loadTravelTime(conn_calibration);
-            loadEzLinkStops(conn_calibration);
-            loadStudentStops(conn_calibration);
-            loadSchoolDesks(conn);
+            loader.add("schools", mainSchema, [this](DB_Connection& conn) -> size_t { loadSchools(conn); return schools.size(); });
+            loader.add("travel times", calibrationSchema, [this](DB_Connection& conn) -> size_t { loadTravelTime(conn); return travelTimeByOriginDestTaz.size(); });
+            loader.add("ezlink stops", calibrationSchema, [this](DB_Connection& conn) -> size_t { loadEzLinkStops(conn); return ezLinkStops.size(); });
+            loader.add("student stops", calibrationSchema, [this](DB_Connection& conn) -> size_t { loadStudentStops(conn); return studentStops.size(); });
+            loader.add("school desks", mainSchema, [this](DB_Connection& conn) -> size_t { loadSchoolDesks(conn); return schoolDesksBySchoolId.size(); });
 
-            loadData<HouseholdPlanningAreaDao>( conn, hhPlanningAreaList, hhPlanningAreaMap, &HouseholdPlanningArea::getHouseHoldId);
-            PrintOutV("Number of household planning area rows: " << hhPlanningAreaList.size() << std::endl );
-
-            loadData<HHCoordinatesDao>( conn, hhCoordinates, hhCoordinatesById, &HHCoordinates::getHouseHoldId);
-            PrintOutV("Number of household coordinate rows: " << hhCoordinates.size() << std::endl );
+            loader.add("nearest schools of ezlink stops", mainSchema, [this](DB_Connection& conn) -> size_t
+            {
+                assignNearestUniToEzLinkStops();
+                assignNearestPolytechToEzLinkStops();
+                return ezLinkStopsWithNearestUni.size() + ezLinkStopsWithNearestPolyTech.size();
+            }, {"schools", "ezlink stops", "student stops"});
 
-            loadData<SchoolAssignmentCoefficientsDao>( conn_calibration, schoolAssignmentCoefficients, SchoolAssignmentCoefficientsById, &SchoolAssignmentCoefficients::getParameterId);
-            PrintOutV("Number of School Assignment Coefficients rows: " << schoolAssignmentCoefficients.size() << std::endl );
+            loader.addTable<HouseholdPlanningAreaDao>("household planning areas", mainSchema, hhPlanningAreaList, hhPlanningAreaMap, &HouseholdPlanningArea::getHouseHoldId);
+            loader.addTable<HHCoordinatesDao>("household coordinates", mainSchema, hhCoordinates, hhCoordinatesById, &HHCoordinates::getHouseHoldId);
+            loader.addTable<SchoolAssignmentCoefficientsDao>("school assignment coefficients", calibrationSchema, schoolAssignmentCoefficients, SchoolAssignmentCoefficientsById, &SchoolAssignmentCoefficients::getParameterId);
 
-            assignNearestUniToEzLinkStops();
-            assignNearestPolytechToEzLinkStops();
+            loader.add("primary school individuals", mainSchema, [this, currentSimYear](DB_Connection& conn) -> size_t
+            {
+                IndividualDao indDao(conn);
+                primarySchoolIndList = indDao.getPrimarySchoolIndividual(currentSimYear);
+                indexData(primarySchoolIndList, primarySchoolIndById, &Individual::getId);
+                return primarySchoolIndList.size();
+            });
 
+            loader.add("pre school individuals", mainSchema, [this, currentSimYear](DB_Connection& conn) -> size_t
+            {
+                IndividualDao indDao(conn);
+                preSchoolIndList = indDao.getPreSchoolIndividual(currentSimYear);
+                indexData(preSchoolIndList, preSchoolIndById, &Individual::getId);
+                return preSchoolIndList.size();
+            });
         }
 
         if(config.ltParams.jobAssignmentModel.enabled)
         {
-            loadJobsByTazAndIndustryType(conn);
-            loadJobAssignments(conn);
-            loadJobsByTazAndIndustryType(conn);
+            //the jobs are loaded before and after the coefficients, on the same connection, as they have always been
+            loader.add("jobs by taz and industry type", mainSchema, [this](DB_Connection& conn) -> size_t
+            {
+                loadJobsByTazAndIndustryType(conn);
+                loadJobAssignments(conn);
+                loadJobsByTazAndIndustryType(conn);
+                return jobsWithTazAndIndustryType.size();
+            });
         }
 
+        loader.add("workers grouped by logsum parameters", mainSchema, [this, calibrationSchema](DB_Connection& conn) -> size_t
         {
-            soci::session sql;
-            sql.open(soci::postgresql, conn.getConnectionStr());
-
-            std::string storedProc = config.schemas.calibration_schema + "workers_grp_by_logsum_params";
+            soci::session& sql = conn.getSession<soci::session>();
+            std::string storedProc = calibrationSchema + "workers_grp_by_logsum_params";
 
             //SQL statement
             soci::rowset<WorkersGrpByLogsumParams> workers_grp_by_logsum_params = (sql.prepare << "select * from " + storedProc);
@@ -1557,16 +1582,12 @@ void HM_Model::startImpl()
                 workersGrpByLogsumParams.push_back(this_row);
                 workersGrpByLogsumParamsById.insert(std::make_pair(this_row->getIndividualId(), this_row));
             }
+            return workersGrpByLogsumParams.size();
+        });
 
-            PrintOutV("Number of WorkersGrpByLogsumParams: " << workersGrpByLogsumParams.size() << std::endl );
-        }
-
-
-
+        loader.add("building matches", mainSchema, [this](DB_Connection& conn) -> size_t
         {
-            soci::session sql;
-            sql.open(soci::postgresql, conn.getConnectionStr());
-
+            soci::session& sql = conn.getSession<soci::session>();
             std::string storedProc = conn.getSchema() + "building_match";
 
             //SQL statement
@@ -1580,15 +1601,12 @@ void HM_Model::startImpl()
                 buildingMatch.push_back(this_row);
                 buildingMatchById.insert(std::make_pair(this_row->getFm_building(), this_row));
             }
+            return buildingMatch.size();
+        });
 
-            PrintOutV("Number of BuildingMatch: " << buildingMatch.size() << std::endl );
-        }
-
-
+        loader.add("sla buildings", mainSchema, [this](DB_Connection& conn) -> size_t
         {
-            soci::session sql;
-            sql.open(soci::postgresql, conn.getConnectionStr());
-
+            soci::session& sql = conn.getSession<soci::session>();
             std::string storedProc = conn.getSchema() + "sla_building";
 
             //SQL statement
@@ -1602,170 +1620,77 @@ void HM_Model::startImpl()
                 slaBuilding.push_back(this_row);
                 slaBuildingById.insert(std::make_pair(this_row->getSla_building_id(), this_row));
             }
+            return slaBuilding.size();
+        });
 
-            PrintOutV("Number of Sla Buildings: " << slaBuilding.size() << std::endl );
-        }
-
-        loadData<LogsumMtzV2Dao>( conn_calibration, logsumMtzV2, logsumMtzV2ById, &LogsumMtzV2::getTazId );
-        PrintOutV("Number of LogsumMtzV2: " << logsumMtzV2.size() << std::endl );
-
-        loadData<ScreeningModelCoefficientsDao>( conn_calibration, screeningModelCoefficientsList, screeningModelCoefficicientsMap, &ScreeningModelCoefficients::getId );
-        PrintOutV("Number of screening Model Coefficients: " << screeningModelCoefficientsList.size() << std::endl );
+        loader.addTable<LogsumMtzV2Dao>("logsum mtz v2", calibrationSchema, logsumMtzV2, logsumMtzV2ById, &LogsumMtzV2::getTazId);
+        loader.addTable<ScreeningModelCoefficientsDao>("screening model coefficients", calibrationSchema, screeningModelCoefficientsList, screeningModelCoefficicientsMap, &ScreeningModelCoefficients::getId);
 
         //if initial loading load data from database. otherwise load data from binary files saved in the disk from the initial run.
         if(initialLoading)
         {
-
-            //Load households
-            loadData<HouseholdDao>(conn, households, householdsById, &Household::getId);
-            PrintOutV("Number of households: " << households.size() << " Households used: " << households.size()  << std::endl);
-
-            //load individuals
-            loadData<IndividualDao>(conn, individuals, individualsById, &Individual::getId);
-            PrintOutV("Initial Individuals: " << individuals.size() << std::endl);
-
-            loadData<AlternativeHedonicPriceDao>( conn, alternativeHedonicPrices, alternativeHedonicPriceById, &AlternativeHedonicPrice::getId );
-            PrintOutV("Number of Alternative Hedonic Price rows: " << alternativeHedonicPrices.size() << std::endl );
-
-            loadData<ZonalLanduseVariableValuesDao>( conn_calibration, zonalLanduseVariableValues, zonalLanduseVariableValuesById, &ZonalLanduseVariableValues::getAltId );
-            PrintOutV("Number of zonal landuse variable values: " << zonalLanduseVariableValues.size() << std::endl );
-
-            loadData<PopulationPerPlanningAreaDao>( conn, populationPerPlanningArea, populationPerPlanningAreaById, &PopulationPerPlanningArea::getPlanningAreaId );
-            PrintOutV("Number of PopulationPerPlanningArea rows: " << populationPerPlanningArea.size() << std::endl );
-
-            loadData<DistanceMRTDao>( conn, mrtDistances, mrtDistancesById, &DistanceMRT::getHouseholdId);
-            PrintOutV("Number of mrt distances: " << mrtDistances.size() << std::endl );
-
-            loadData<AwakeningDao>(conn_calibration, awakening, awakeningById,  &Awakening::getId);
-            PrintOutV("Awakening probability: " << awakening.size() << std::endl );
+            loader.addTable<HouseholdDao>("households", mainSchema, households, householdsById, &Household::getId);
+            loader.addTable<IndividualDao>("individuals", mainSchema, individuals, individualsById, &Individual::getId);
+            loader.addTable<AlternativeHedonicPriceDao>("alternative hedonic prices", mainSchema, alternativeHedonicPrices, alternativeHedonicPriceById, &AlternativeHedonicPrice::getId);
+            loader.addTable<ZonalLanduseVariableValuesDao>("zonal landuse variable values", calibrationSchema, zonalLanduseVariableValues, zonalLanduseVariableValuesById, &ZonalLanduseVariableValues::getAltId);
+            loader.addTable<PopulationPerPlanningAreaDao>("population per planning area", mainSchema, populationPerPlanningArea, populationPerPlanningAreaById, &PopulationPerPlanningArea::getPlanningAreaId);
+            loader.addTable<DistanceMRTDao>("mrt distances", mainSchema, mrtDistances, mrtDistancesById, &DistanceMRT::getHouseholdId);
+            loader.addTable<AwakeningDao>("awakening probabilities", calibrationSchema, awakening, awakeningById, &Awakening::getId);
         }
 
         //Load units
-        loadData<UnitDao>(conn, units, unitsById, &Unit::getId);
+        loader.addTable<UnitDao>("units", mainSchema, units, unitsById, &Unit::getId);
         if(config.ltParams.launchPrivatePresale)
         {
-            UnitDao unitDao(conn);
-            privatePresaleUnits =  unitDao.getPrivatePresaleUnits();
-            for (UnitList::const_iterator it = privatePresaleUnits.begin(); it != privatePresaleUnits.end(); it++)
+            loader.add("private presale units", mainSchema, [this](DB_Connection& conn) -> size_t
             {
-                privatePresaleUnitsMap.insert(std::make_pair((*it)->getId(), (*it)->getId()));
-            }
+                UnitDao unitDao(conn);
+                privatePresaleUnits =  unitDao.getPrivatePresaleUnits();
+                for (UnitList::const_iterator it = privatePresaleUnits.begin(); it != privatePresaleUnits.end(); it++)
+                {
+                    privatePresaleUnitsMap.insert(std::make_pair((*it)->getId(), (*it)->getId()));
+                }
+                return privatePresaleUnits.size();
+            });
         }
 
-        PrintOutV("Number of units: " << units.size() << ". Units Used: " << units.size() << std::endl);
-
-        HouseholdDao hhDao(conn);
-        std::tm currentSimYear = getDateBySimDay(simYear,0);
-        std::tm lastDayOfCurrentSimYear = getDateBySimDay(simYear,364);
-        pendingHouseholds = hhDao.getPendingHouseholds(currentSimYear,lastDayOfCurrentSimYear);
-
-
-        //Load unit types
-        loadData<UnitTypeDao>(conn, unitTypes, unitTypesById, &UnitType::getId);
-        PrintOutV("Number of unit types: " << unitTypes.size() << std::endl);
-
-        if(config.ltParams.schoolAssignmentModel.enabled)
+        loader.add("pending households", mainSchema, [this, currentSimYear, lastDayOfCurrentSimYear](DB_Connection& conn) -> size_t
         {
-            IndividualDao indDao(conn);
-            primarySchoolIndList = indDao.getPrimarySchoolIndividual(currentSimYear);
-            //Index all primary school inds.
-            for (IndividualList::iterator it = primarySchoolIndList.begin(); it != primarySchoolIndList.end(); it++) {
-                primarySchoolIndById.insert(std::make_pair((*it)->getId(), *it));
-            }
-
-            preSchoolIndList = indDao.getPreSchoolIndividual(currentSimYear);
-            //Index all pre school inds.
-            for (IndividualList::iterator it = preSchoolIndList.begin(); it != preSchoolIndList.end(); it++) {
-                preSchoolIndById.insert(std::make_pair((*it)->getId(), *it));
-
-            }
-
-            loadData<HouseholdPlanningAreaDao>( conn, hhPlanningAreaList, hhPlanningAreaMap, &HouseholdPlanningArea::getHouseHoldId);
-            PrintOutV("Number of household planning area rows: " << hhPlanningAreaList.size() << std::endl );
-
-            loadData<HHCoordinatesDao>( conn, hhCoordinates, hhCoordinatesById, &HHCoordinates::getHouseHoldId);
-            PrintOutV("Number of household coordinate rows: " << hhCoordinates.size() << std::endl );
-
-            loadData<SchoolAssignmentCoefficientsDao>( conn_calibration, schoolAssignmentCoefficients, SchoolAssignmentCoefficientsById, &SchoolAssignmentCoefficients::getParameterId);
-            PrintOutV("Number of School Assignment Coefficients rows: " << schoolAssignmentCoefficients.size() << std::endl );
-
-            loadData<IndvidualEmpSecDao>( conn, indEmpSecList, indEmpSecbyIndId, &IndvidualEmpSec::getIndvidualId );
-            PrintOutV("Number of Indvidual Emp Sec rows: " << indEmpSecList.size() << std::endl );
-        }
-
-        PrintOutV("Number of pre school individuals: " << preSchoolIndList.size() << std::endl );
-        PrintOutV("Number of primary school individuals: " << primarySchoolIndList.size() << std::endl );
-
-        loadData<PostcodeDao>(conn, postcodes, postcodesById,   &Postcode::getAddressId);
-        PrintOutV("Number of postcodes: " << postcodes.size() << std::endl );
-        PrintOutV("Number of postcodes by id: " << postcodesById.size() << std::endl );
-
-        loadData<VehicleOwnershipCoefficientsDao>(conn,vehicleOwnershipCoeffs,vehicleOwnershipCoeffsById, &VehicleOwnershipCoefficients::getVehicleOwnershipOptionId);
-        PrintOutV("Vehicle Ownership coefficients: " << vehicleOwnershipCoeffs.size() << std::endl );
-
-        loadData<TaxiAccessCoefficientsDao>(conn_calibration,taxiAccessCoeffs,taxiAccessCoeffsById, &TaxiAccessCoefficients::getParameterId);
-        PrintOutV("Taxi access coefficients: " << taxiAccessCoeffs.size() << std::endl );
-
-        loadData<EstablishmentDao>(conn, establishments, establishmentsById, &Establishment::getId);
-        PrintOutV("Number of establishments: " << establishments.size() << std::endl );
-
-        loadData<JobDao>( conn, jobs, jobsById, &Job::getId);
-        PrintOutV("Number of jobs: " << jobs.size() << std::endl );
-
-        loadData<HousingInterestRateDao>( conn, housingInterestRates, housingInterestRatesById, &HousingInterestRate::getId);
-        PrintOutV("Number of interest rate quarters: " << housingInterestRates.size() << std::endl );
-
-        loadData<LogSumVehicleOwnershipDao>( conn, vehicleOwnershipLogsums, vehicleOwnershipLogsumById, &LogSumVehicleOwnership::getHouseholdId);
-        PrintOutV("Number of vehicle ownership logsums: " << vehicleOwnershipLogsums.size() << std::endl );
+            HouseholdDao hhDao(conn);
+            pendingHouseholds = hhDao.getPendingHouseholds(currentSimYear,lastDayOfCurrentSimYear);
+            return pendingHouseholds.size();
+        });
 
-        loadData<TazDao>( conn, tazs, tazById, &Taz::getId);
-        PrintOutV("Number of taz: " << tazs.size() << std::endl );
-
-        loadData<HouseHoldHitsSampleDao>( conn, houseHoldHits, houseHoldHitsById, &HouseHoldHitsSample::getHouseholdId);
-        PrintOutV("Number of houseHoldHits: " << houseHoldHits.size() << std::endl );
-
-        loadData<TazLogsumWeightDao>( conn_calibration, tazLogsumWeights, tazLogsumWeightById, &TazLogsumWeight::getGroupLogsum );
-        PrintOutV("Number of tazLogsumWeights: " << tazLogsumWeights.size() << std::endl );
-
-        loadData<PlanningAreaDao>( conn, planningArea, planningAreaById, &PlanningArea::getId );
-        PrintOutV("Number of planning areas: " << planningArea.size() << std::endl );
-
-        loadData<PlanningSubzoneDao>( conn, planningSubzone, planningSubzoneById, &PlanningSubzone::getId );
-        PrintOutV("Number of planing subzones: " << planningSubzone.size() << std::endl );
-
-        loadData<MtzDao>( conn, mtz, mtzById, &Mtz::getId );
-        PrintOutV("Number of Mtz: " << mtz.size() << std::endl );
-
-        loadData<MtzTazDao>( conn, mtzTaz, mtzTazById, &MtzTaz::getMtzId );
-        PrintOutV("Number of mtz taz lookups: " << mtzTaz.size() << std::endl );
-
-        loadData<AlternativeDao>( conn_calibration, alternative, alternativeById, &Alternative::getId );
-        PrintOutV("Number of alternative region names: " << alternative.size() << std::endl );
+        //Load unit types
+        loader.addTable<UnitTypeDao>("unit types", mainSchema, unitTypes, unitTypesById, &UnitType::getId);
+        loader.addTable<PostcodeDao>("postcodes", mainSchema, postcodes, postcodesById, &Postcode::getAddressId);
+        loader.addTable<VehicleOwnershipCoefficientsDao>("vehicle ownership coefficients", mainSchema, vehicleOwnershipCoeffs, vehicleOwnershipCoeffsById, &VehicleOwnershipCoefficients::getVehicleOwnershipOptionId);
+        loader.addTable<TaxiAccessCoefficientsDao>("taxi access coefficients", calibrationSchema, taxiAccessCoeffs, taxiAccessCoeffsById, &TaxiAccessCoefficients::getParameterId);
+        loader.addTable<EstablishmentDao>("establishments", mainSchema, establishments, establishmentsById, &Establishment::getId);
+        loader.addTable<JobDao>("jobs", mainSchema, jobs, jobsById, &Job::getId);
+        loader.addTable<HousingInterestRateDao>("housing interest rates", mainSchema, housingInterestRates, housingInterestRatesById, &HousingInterestRate::getId);
+        loader.addTable<LogSumVehicleOwnershipDao>("vehicle ownership logsums", mainSchema, vehicleOwnershipLogsums, vehicleOwnershipLogsumById, &LogSumVehicleOwnership::getHouseholdId);
+        loader.addTable<TazDao>("tazs", mainSchema, tazs, tazById, &Taz::getId);
+        loader.addTable<HouseHoldHitsSampleDao>("household hits samples", mainSchema, houseHoldHits, houseHoldHitsById, &HouseHoldHitsSample::getHouseholdId);
+        loader.addTable<TazLogsumWeightDao>("taz logsum weights", calibrationSchema, tazLogsumWeights, tazLogsumWeightById, &TazLogsumWeight::getGroupLogsum);
+        loader.addTable<PlanningAreaDao>("planning areas", mainSchema, planningArea, planningAreaById, &PlanningArea::getId);
+        loader.addTable<PlanningSubzoneDao>("planning subzones", mainSchema, planningSubzone, planningSubzoneById, &PlanningSubzone::getId);
+        loader.addTable<MtzDao>("mtz", mainSchema, mtz, mtzById, &Mtz::getId);
+        loader.addTable<MtzTazDao>("mtz taz lookups", mainSchema, mtzTaz, mtzTazById, &MtzTaz::getMtzId);
+        loader.addTable<AlternativeDao>("alternative region names", calibrationSchema, alternative, alternativeById, &Alternative::getId);
 
         //only used with Hits2008 data
-        //loadData<Hits2008ScreeningProbDao>( conn, hits2008ScreeningProb, hits2008ScreeningProbById, &Hits2008ScreeningProb::getId );
-        //PrintOutV("Number of hits2008 screening probabilities: " << hits2008ScreeningProb.size() << std::endl );
-
-        loadData<HitsIndividualLogsumDao>( conn, hitsIndividualLogsum, hitsIndividualLogsumById, &HitsIndividualLogsum::getId );
-        PrintOutV("Number of Hits Individual Logsum rows: " << hitsIndividualLogsum.size() << std::endl );
+        //loader.addTable<Hits2008ScreeningProbDao>("hits2008 screening probabilities", mainSchema, hits2008ScreeningProb, hits2008ScreeningProbById, &Hits2008ScreeningProb::getId);
 
-        loadData<IndvidualVehicleOwnershipLogsumDao>( conn_calibration, IndvidualVehicleOwnershipLogsums, IndvidualVehicleOwnershipLogsumById, &IndvidualVehicleOwnershipLogsum::getHouseholdId );
-        PrintOutV("Number of Hits Individual VehicleOwnership Logsum rows: " << IndvidualVehicleOwnershipLogsums.size() << std::endl );
+        loader.addTable<HitsIndividualLogsumDao>("hits individual logsums", mainSchema, hitsIndividualLogsum, hitsIndividualLogsumById, &HitsIndividualLogsum::getId);
+        loader.addTable<IndvidualVehicleOwnershipLogsumDao>("individual vehicle ownership logsums", calibrationSchema, IndvidualVehicleOwnershipLogsums, IndvidualVehicleOwnershipLogsumById, &IndvidualVehicleOwnershipLogsum::getHouseholdId);
+        loader.addTable<ScreeningCostTimeDao>("screening cost times", calibrationSchema, screeningCostTime, screeningCostTimeById, &ScreeningCostTime::getId);
+        loader.addTable<AccessibilityFixedPzidDao>("accessibility fixed pz ids", calibrationSchema, accessibilityFixedPzid, accessibilityFixedPzidById, &AccessibilityFixedPzid::getId);
+        loader.addTable<TenureTransitionRateDao>("tenure transition rates", calibrationSchema, tenureTransitionRate, tenureTransitionRateById, &TenureTransitionRate::getId);
+        loader.addTable<OwnerTenantMovingRateDao>("owner tenant moving rates", calibrationSchema, ownerTenantMovingRate, ownerTenantMovingRateById, &OwnerTenantMovingRate::getId);
+        loader.addTable<IndvidualEmpSecDao>("individual employment sectors", mainSchema, indEmpSecList, indEmpSecbyIndId, &IndvidualEmpSec::getIndvidualId);
 
-        loadData<ScreeningCostTimeDao>( conn_calibration, screeningCostTime, screeningCostTimeById, &ScreeningCostTime::getId );
-        PrintOutV("Number of Screening Cost Time rows: " << screeningCostTime.size() << std::endl );
-
-        loadData<AccessibilityFixedPzidDao>( conn_calibration, accessibilityFixedPzid, accessibilityFixedPzidById, &AccessibilityFixedPzid::getId );
-        PrintOutV("Number of Accessibility fixed pz id rows: " << accessibilityFixedPzid.size() << std::endl );
-
-        loadData<TenureTransitionRateDao>( conn_calibration, tenureTransitionRate, tenureTransitionRateById, &TenureTransitionRate::getId );
-        PrintOutV("Number of Tenure Transition rate rows: " << tenureTransitionRate.size() << std::endl );
-
-        loadData<OwnerTenantMovingRateDao>( conn_calibration, ownerTenantMovingRate, ownerTenantMovingRateById, &OwnerTenantMovingRate::getId );
-        PrintOutV("Number of Owner Tenant Moving Rate rows: " << ownerTenantMovingRate.size() << std::endl );
-
-        loadData<IndvidualEmpSecDao>( conn, indEmpSecList, indEmpSecbyIndId, &IndvidualEmpSec::getIndvidualId );
-        PrintOutV("Number of Indvidual Emp Sec rows: " << indEmpSecList.size() << std::endl );
+        loader.run();
 
     }
 
@@ -4029,6 +3954,22 @@ std::vector<boost::shared_ptr<VehicleOwnershipChanges> > HM_Model::getVehicleOwn
     return vehicleOwnershipChangesVector;
 }
 
+void HM_Model::takeOutputRows(std::vector<boost::shared_ptr<Bid> > &bids, std::vector<boost::shared_ptr<UnitSale> > &unitSales,
+                              std::vector<boost::shared_ptr<HouseholdUnit> > &householdUnits,
+                              std::vector<boost::shared_ptr<VehicleOwnershipChanges> > &vehicleOwnershipChanges)
+{
+    DBLock.lock();
+    bids.swap(newBids);
+    newBids.clear();
+    unitSales.swap(this->unitSales);
+    this->unitSales.clear();
+    householdUnits.swap(newHouseholdUnits);
+    newHouseholdUnits.clear();
+    vehicleOwnershipChanges.swap(vehicleOwnershipChangesVector);
+    vehicleOwnershipChangesVector.clear();
+    DBLock.unlock();
+}
+
 
 IndvidualVehicleOwnershipLogsum* HM_Model::getIndvidualVehicleOwnershipLogsumsByHHId(BigSerial householdId) const
 {
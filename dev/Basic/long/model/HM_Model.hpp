@@ -451,6 +451,14 @@ namespace sim_mob
             std::vector<boost::shared_ptr<Household> > getHouseholdsWithBids();
             void addVehicleOwnershipChanges(boost::shared_ptr<VehicleOwnershipChanges> &vehicleOwnershipChange);
             std::vector<boost::shared_ptr<VehicleOwnershipChanges> > getVehicleOwnershipChanges();
+
+            /**
+             * Moves the bids, unit sales, household units and vehicle ownership changes added since the last call
+             * to the given (empty) lists, so that they are released once written to the output schema.
+             */
+            void takeOutputRows(std::vector<boost::shared_ptr<Bid> > &bids, std::vector<boost::shared_ptr<UnitSale> > &unitSales,
+                                std::vector<boost::shared_ptr<HouseholdUnit> > &householdUnits,
+                                std::vector<boost::shared_ptr<VehicleOwnershipChanges> > &vehicleOwnershipChanges);
             ScreeningModelCoefficientsList getScreeningModelCoefficientsList();
 
             IndvidualVehicleOwnershipLogsumList getIndvidualVehicleOwnershipLogsums() const;
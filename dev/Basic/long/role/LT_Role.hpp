@@ -115,7 +115,7 @@ namespace sim_mob {
             //      Templates make this more difficult than it should be.
             NullableOutputStream Log()
             {
-                return NullableOutputStream( dynamic_cast<Agent_LT*>(parent)->currWorkerProvider->getLogFile() );
+                return NullableOutputStream( dynamic_cast<Agent_LT*>(parent)->currWorkerProvider->getExecutingLogFile() );
             }
 
         private:
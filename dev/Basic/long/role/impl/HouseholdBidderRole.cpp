@@ -10,6 +10,7 @@
  * Created on May 16, 2013, 5:13 PM
  */
 
+#include <algorithm>
 #include <cmath>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
@@ -33,6 +34,7 @@
 #include "model/HedonicPriceSubModel.hpp"
 #include "model/WillingnessToPaySubModel.hpp"
 #include "util/PrintLog.hpp"
+#include "util/CounterRandom.hpp"
 #include "model/VehicleOwnershipModel.hpp"
 
 
@@ -141,7 +143,8 @@ void HouseholdBidderRole::CurrentBiddingEntry::setWtp_e(double value)
 
 
 HouseholdBidderRole::HouseholdBidderRole(HouseholdAgent* parent): parent(parent), waitingForResponse(false), lastTime(0, 0), bidOnCurrentDay(false), active(false), unitIdToBeOwned(0),
-                                                                  moveInWaitingTimeInDays(-1),vehicleBuyingWaitingTimeInDays(0), day(0), initBidderRole(true),year(0),bidComplete(true){}
+                                                                  moveInWaitingTimeInDays(-1),vehicleBuyingWaitingTimeInDays(0), day(0), initBidderRole(true),year(0),bidComplete(true),
+                                                                  screeningAliasTableBuilt(false){}
 
 HouseholdBidderRole::~HouseholdBidderRole(){}
 
@@ -617,6 +620,52 @@ void HouseholdBidderRole::calculateMaxSurplusEntry(const HousingMarket::Entry* e
 
 }
 
+std::vector<double> HouseholdBidderRole::getScreeningInputs(const Household* household)
+{
+    std::vector<double> inputs;
+    inputs.push_back(household->getUnitId());
+    inputs.push_back(household->getCurrentUnitPrice());
+    inputs.push_back(household->getIncome());
+    inputs.push_back(household->getSize());
+    inputs.push_back(household->getEthnicityId());
+
+    std::vector<BigSerial> individualIds = household->getIndividuals();
+
+    for( int n = 0; n < individualIds.size(); n++ )
+    {
+        const Individual* member = getParent()->getModel()->getIndividualById(individualIds[n]);
+        inputs.push_back(member ? member->getAgeCategoryId() : -1);
+    }
+
+    return inputs;
+}
+
+void HouseholdBidderRole::updateScreeningAliasTable()
+{
+    const Household* household = getParent()->getHousehold();
+    std::vector<double> inputs = getScreeningInputs(household);
+
+    //the zonal terms of the screening probabilities are fixed, so they only change with the household itself
+    if( screeningAliasTableBuilt && screeningInputs == inputs )
+        return;
+
+    std::vector<double>householdScreeningProbabilities;
+
+    //We cannot use those probabilities because they are based on HITS2008 ids
+    //model->getScreeningProbabilities(hitsId, householdScreeningProbabilities);
+    //getScreeningProbabilities(household->getId(), householdScreeningProbabilities);
+
+    ScreeningSubModel screeningSubmodel;
+    screeningSubmodel.getScreeningProbabilities( household->getId(), householdScreeningProbabilities, getParent()->getModel(), day);
+
+    if(householdScreeningProbabilities.size() > 0 )
+        printProbabilityList(household->getId(), householdScreeningProbabilities);
+
+    screeningAliasTable.build(householdScreeningProbabilities);
+    screeningAliasTableBuilt = true;
+    screeningInputs.swap(inputs);
+}
+
 bool HouseholdBidderRole::pickEntryToBid()
 {
     const Household* household = getParent()->getHousehold();
@@ -648,17 +697,7 @@ bool HouseholdBidderRole::pickEntryToBid()
 
     HouseHoldHitsSample *householdHits = model->getHouseHoldHitsById( household->getId() );
 
-    std::vector<double>householdScreeningProbabilities;
-
-    //We cannot use those probabilities because they are based on HITS2008 ids
-    //model->getScreeningProbabilities(hitsId, householdScreeningProbabilities);
-    //getScreeningProbabilities(household->getId(), householdScreeningProbabilities);
-
-    ScreeningSubModel screeningSubmodel;
-    screeningSubmodel.getScreeningProbabilities( household->getId(), householdScreeningProbabilities, model, day);
-
-    if(householdScreeningProbabilities.size() > 0 )
-        printProbabilityList(household->getId(), householdScreeningProbabilities);
+    updateScreeningAliasTable();
 
     std::set<const HousingMarket::Entry*> screenedEntries;
     std::vector<const HousingMarket::Entry*> screenedEntriesVec; //This vector's only purpose is to print the choiceset
@@ -675,36 +714,23 @@ bool HouseholdBidderRole::pickEntryToBid()
     else
     if(config.ltParams.housingModel.bidderUnitChoiceset.shanRobertoChoiceset == true)
     {
-        for (int n = 0; n < entries.size() && screenedEntries.size() < config.ltParams.housingModel.bidderUnitChoiceset.bidderChoicesetSize; n++)
-        {
-            double randomDraw = (double) rand() / RAND_MAX;
-            int zoneHousingType = -1;
-            double cummulativeProbability = 0.0;
-            for (int m = 0; m < householdScreeningProbabilities.size(); m++)
-            {
-                cummulativeProbability += householdScreeningProbabilities[m];
-                if (cummulativeProbability > randomDraw)
-                {
-                    zoneHousingType = m + 1; //housing type is a one-based index
-                    break;
-                }
-            }
+        //the draws depend on the household and the day only, not on the thread updating the household
+        CounterRandom random(config.getSeedValueForRNG(), household->getId(), day);
 
+        //without screening probabilities no zone housing type can be drawn
+        for (int n = 0; n < entries.size() && !screeningAliasTable.empty() && screenedEntries.size() < config.ltParams.housingModel.bidderUnitChoiceset.bidderChoicesetSize; n++)
+        {
+            int zoneHousingType = screeningAliasTable.sample(random.nextUniform()) + 1; //housing type is a one-based index
 
-            auto range = market->getunitsByZoneHousingType().equal_range(zoneHousingType);
-            int numUnits = distance(range.first, range.second); //find the number of units in the above zoneHousingType
+            const std::vector<BigSerial>& unitsInZoneHousingType = market->getUnitsByZoneHousingType(zoneHousingType);
+            int numUnits = unitsInZoneHousingType.size(); //find the number of units in the above zoneHousingType
 
             if (numUnits < minUnitsInZoneHousingType)
                 continue;
 
+            int offset = random.nextInt(0, numUnits - 1); // choose a random unit in that zoneHousingType
 
-            if (numUnits == 0)
-                continue;
-
-            int offset = (float) rand() / RAND_MAX * (numUnits - 1);
-            advance(range.first, offset); // change a random unit in that zoneHousingType
-
-            const BigSerial unitId = (range.first)->second;
+            const BigSerial unitId = unitsInZoneHousingType[offset];
 
 
             const HousingMarket::Entry *entry = market->getEntryById(unitId);
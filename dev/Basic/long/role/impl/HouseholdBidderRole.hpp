@@ -13,6 +13,7 @@
 #include "event/LT_EventArgs.hpp"
 #include "database/entity/Household.hpp"
 #include "core/HousingMarket.hpp"
+#include "util/AliasTable.hpp"
 #include <util/TimeCheck.hpp>
 
 namespace sim_mob
@@ -147,6 +148,18 @@ namespace sim_mob
              * @return true if a unit was picked false otherwise;
              */
             bool pickEntryToBid();
+
+            /**
+             * Computes the screening probabilities of the household and builds the alias table of the zone housing
+             * type choice, unless the table was already built for the current screening inputs of the household.
+             */
+            void updateScreeningAliasTable();
+
+            /**
+             * Collects the household attributes read by the screening sub model: unit, unit price, income, size,
+             * ethnicity and the age category of each member.
+             */
+            std::vector<double> getScreeningInputs(const Household* household);
             double calculateWillingnessToPay(const Unit* unit, const Household* household, double& wtp_e);
 
             volatile bool waitingForResponse;
@@ -162,6 +175,12 @@ namespace sim_mob
             uint32_t day;
             int year;
 
+            /** zone housing type choice (index = zone housing type - 1), cached across days */
+            AliasTable screeningAliasTable;
+            bool screeningAliasTableBuilt;
+            /** screening inputs of the household the alias table was built for */
+            std::vector<double> screeningInputs;
+
             enum EthnicityId
             {
                 CHINESE = 1, MALAY, INDIAN, OTHERS
@@ -0,0 +1,195 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "ParallelTableLoader.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <boost/chrono.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include "logging/Log.hpp"
+
+using namespace sim_mob::long_term;
+using namespace sim_mob::db;
+
+namespace
+{
+    typedef boost::chrono::steady_clock Clock;
+
+    /**
+     * Progress of a run, shared by its worker threads.
+     */
+    struct RunState
+    {
+        RunState() : numRunning(0), numDone(0) {}
+
+        boost::mutex mutex;
+        boost::condition_variable changed;
+
+        /** loads whose dependencies are completed, in the order they were declared */
+        std::deque<size_t> ready;
+
+        /** number of uncompleted dependencies of each load */
+        std::vector<size_t> numWaiting;
+
+        /** the loads waiting for each load */
+        std::vector<std::vector<size_t> > dependents;
+
+        size_t numRunning;
+        size_t numDone;
+
+        /** the first failure */
+        std::exception_ptr error;
+    };
+
+    double getMilliseconds(const Clock::time_point& start)
+    {
+        return boost::chrono::duration_cast<boost::chrono::microseconds>(Clock::now() - start).count() / 1000.0;
+    }
+}
+
+ParallelTableLoader::ParallelTableLoader(const DB_Config& config, unsigned int numConnections)
+    : config(config), numConnections(numConnections > 0 ? numConnections : 1)
+{
+}
+
+void ParallelTableLoader::add(const std::string& name, const std::string& schema, LoadFunction load,
+                              const std::vector<std::string>& dependencies)
+{
+    if (!loadIndex.insert(std::make_pair(name, loads.size())).second)
+    {
+        throw std::runtime_error("ParallelTableLoader: load " + name + " declared twice");
+    }
+
+    Load newLoad;
+    newLoad.name = name;
+    newLoad.schema = schema;
+    newLoad.function = load;
+    newLoad.dependencies = dependencies;
+    loads.push_back(newLoad);
+}
+
+void ParallelTableLoader::run()
+{
+    const Clock::time_point start = Clock::now();
+    RunState state;
+    state.numWaiting.resize(loads.size(), 0);
+    state.dependents.resize(loads.size());
+
+    for (size_t i = 0; i < loads.size(); i++)
+    {
+        for (std::vector<std::string>::const_iterator it = loads[i].dependencies.begin(); it != loads[i].dependencies.end(); ++it)
+        {
+            std::map<std::string, size_t>::const_iterator dependency = loadIndex.find(*it);
+            if (dependency == loadIndex.end())
+            {
+                throw std::runtime_error("ParallelTableLoader: load " + loads[i].name + " depends on undeclared load " + *it);
+            }
+            state.dependents[dependency->second].push_back(i);
+            state.numWaiting[i]++;
+        }
+        if (state.numWaiting[i] == 0)
+        {
+            state.ready.push_back(i);
+        }
+    }
+
+    PrintOutV("Loading " << loads.size() << " tables over " << numConnections << " connections" << std::endl);
+
+    boost::thread_group workers;
+    const size_t numWorkers = std::min<size_t>(numConnections, loads.size());
+    for (size_t i = 0; i < numWorkers; i++)
+    {
+        workers.create_thread([this, &state]()
+        {
+            //connections of this thread, by schema
+            std::map<std::string, boost::shared_ptr<DB_Connection> > connections;
+
+            boost::unique_lock<boost::mutex> lock(state.mutex);
+            while (true)
+            {
+                //wait for a load, unless all loads are done (or can no longer start)
+                while (state.ready.empty() && !state.error && state.numDone < loads.size() && state.numRunning > 0)
+                {
+                    state.changed.wait(lock);
+                }
+                if (state.ready.empty() || state.error)
+                {
+                    break;
+                }
+
+                const size_t index = state.ready.front();
+                state.ready.pop_front();
+                state.numRunning++;
+                lock.unlock();
+
+                const Load& load = loads[index];
+                const Clock::time_point loadStart = Clock::now();
+                size_t numRows = 0;
+                std::exception_ptr error;
+                try
+                {
+                    boost::shared_ptr<DB_Connection>& conn = connections[load.schema];
+                    if (!conn)
+                    {
+                        conn.reset(new DB_Connection(POSTGRES, config));
+                        conn->setSchema(load.schema);
+                        conn->connect();
+                    }
+                    if (!conn->isConnected())
+                    {
+                        throw std::runtime_error("ParallelTableLoader: no connection to the database for " + load.name);
+                    }
+                    numRows = load.function(*conn);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                const double loadTime = getMilliseconds(loadStart);
+
+                lock.lock();
+                state.numRunning--;
+                if (error)
+                {
+                    if (!state.error)
+                    {
+                        state.error = error;
+                    }
+                    PrintOutV("Loading of " << load.name << " failed after " << loadTime << " ms" << std::endl);
+                }
+                else
+                {
+                    state.numDone++;
+                    for (std::vector<size_t>::const_iterator it = state.dependents[index].begin(); it != state.dependents[index].end(); ++it)
+                    {
+                        if (--state.numWaiting[*it] == 0)
+                        {
+                            state.ready.push_back(*it);
+                        }
+                    }
+                    PrintOutV("Loaded " << load.name << " (" << state.numDone << "/" << loads.size() << "): " << numRows
+                              << " rows in " << loadTime << " ms" << std::endl);
+                }
+                state.changed.notify_all();
+            }
+        });
+    }
+    workers.join_all();
+
+    if (state.error)
+    {
+        std::rethrow_exception(state.error);
+    }
+    if (state.numDone < loads.size())
+    {
+        throw std::runtime_error("ParallelTableLoader: the dependencies of the loads are circular");
+    }
+
+    PrintOutV("Loaded " << loads.size() << " tables in " << getMilliseconds(start) << " ms" << std::endl);
+}
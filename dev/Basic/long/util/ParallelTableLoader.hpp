@@ -0,0 +1,134 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+
+#include "database/DB_Config.hpp"
+#include "database/DB_Connection.hpp"
+#include "util/HelperFunctions.hpp"
+
+namespace sim_mob
+{
+    namespace long_term
+    {
+        /**
+         * Loads the tables of a model concurrently, at its start.
+         *
+         * The loads are declared first, each with the schema of the connection it needs and the names of the loads
+         * which must be completed before it starts (for loads that use data loaded by others, or that append to the
+         * same containers). run() then executes them on a pool of worker threads, each with its own connections,
+         * starting every load as soon as its dependencies are done, and reports the rows and time of each table.
+         *
+         * Each load fills its own containers, so the loads need no locking; a container shared by several loads must
+         * be protected by dependencies between them.
+         */
+        class ParallelTableLoader : private boost::noncopyable
+        {
+        public:
+            /**
+             * Loads a table.
+             * @param conn connection to the schema of the load, owned by the worker thread.
+             * @return number of rows loaded.
+             */
+            typedef boost::function<size_t (db::DB_Connection&)> LoadFunction;
+
+            /**
+             * @param config database configuration of the connections.
+             * @param numConnections maximum number of loads running at the same time (at least 1).
+             */
+            ParallelTableLoader(const db::DB_Config& config, unsigned int numConnections);
+
+            /**
+             * Declares a load.
+             * @param name unique name of the load, used for the dependencies and the report.
+             * @param schema schema of the connection given to the load.
+             * @param load function loading the table.
+             * @param dependencies names of the loads to complete before this one.
+             */
+            void add(const std::string& name, const std::string& schema, LoadFunction load,
+                     const std::vector<std::string>& dependencies = std::vector<std::string>());
+
+            /**
+             * Declares the load of a table with the given DAO, as loadData.
+             */
+            template <typename T, typename K>
+            void addTable(const std::string& name, const std::string& schema, K& list,
+                          const std::vector<std::string>& dependencies = std::vector<std::string>())
+            {
+                add(name, schema, TableLoad<T, K, void, void>(list), dependencies);
+            }
+
+            /**
+             * Declares the load of a table with the given DAO, indexed by the given getter, as loadData.
+             */
+            template <typename T, typename K, typename M, typename F>
+            void addTable(const std::string& name, const std::string& schema, K& list, M& map, F getter,
+                          const std::vector<std::string>& dependencies = std::vector<std::string>())
+            {
+                add(name, schema, TableLoad<T, K, M, F>(list, map, getter), dependencies);
+            }
+
+            /**
+             * Executes all declared loads, and returns once they are completed.
+             * If a load fails, no other load is started, and the error of the first failure is thrown once the
+             * running loads are completed.
+             */
+            void run();
+
+        private:
+            template <typename T, typename K, typename M, typename F>
+            struct TableLoad
+            {
+                TableLoad(K& list, M& map, F getter) : list(list), map(map), getter(getter) {}
+
+                size_t operator()(db::DB_Connection& conn)
+                {
+                    loadData<T>(conn, list, map, getter);
+                    return list.size();
+                }
+
+                K& list;
+                M& map;
+                F getter;
+            };
+
+            template <typename T, typename K>
+            struct TableLoad<T, K, void, void>
+            {
+                explicit TableLoad(K& list) : list(list) {}
+
+                size_t operator()(db::DB_Connection& conn)
+                {
+                    loadData<T>(conn, list);
+                    return list.size();
+                }
+
+                K& list;
+            };
+
+            struct Load
+            {
+                std::string name;
+                std::string schema;
+                LoadFunction function;
+                std::vector<std::string> dependencies;
+            };
+
+            const db::DB_Config config;
+            const unsigned int numConnections;
+
+            /** the loads, in the order they were declared */
+            std::vector<Load> loads;
+
+            /** name -> index in loads */
+            std::map<std::string, size_t> loadIndex;
+        };
+    }
+}
@@ -0,0 +1,129 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "ActivityScheduleWriter.hpp"
+
+#include <stdexcept>
+#include <boost/bind.hpp>
+#include "logging/Log.hpp"
+
+using namespace sim_mob;
+using namespace sim_mob::medium;
+
+ActivityScheduleWriter::ActivityScheduleWriter(std::size_t maxPendingBuffers) : buffers(maxPendingBuffers), closed(false)
+{
+}
+
+ActivityScheduleWriter::~ActivityScheduleWriter()
+{
+    try
+    {
+        finish(false);
+    }
+    catch (const std::exception& ex)
+    {
+        Warn() << ex.what() << std::endl;
+    }
+}
+
+bool ActivityScheduleWriter::openCopy(const std::string& connectionStr, const std::string& tableName,
+        const std::vector<std::string>& columnNames)
+{
+    std::unique_ptr<PG_BulkInserter> inserter(new PG_BulkInserter(0));
+    if (!inserter->connect(connectionStr) || !inserter->buildQuery(tableName, columnNames) || !inserter->beginCopy())
+    {
+        return false;
+    }
+    copyInserter = std::move(inserter);
+    writerThread = boost::thread(boost::bind(&ActivityScheduleWriter::run, this));
+    return true;
+}
+
+bool ActivityScheduleWriter::openFile(const std::string& fileName)
+{
+    file.open(fileName.c_str(), std::ios::trunc | std::ios::out);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    writerThread = boost::thread(boost::bind(&ActivityScheduleWriter::run, this));
+    return true;
+}
+
+void ActivityScheduleWriter::write(std::string& buffer)
+{
+    if (!buffer.empty())
+    {
+        buffers.push(buffer);
+    }
+}
+
+void ActivityScheduleWriter::close()
+{
+    finish(true);
+}
+
+void ActivityScheduleWriter::finish(bool completed)
+{
+    if (closed)
+    {
+        return;
+    }
+    closed = true;
+
+    buffers.close();
+    if (writerThread.joinable())
+    {
+        writerThread.join();
+    }
+
+    if (!completed && error.empty() && (copyInserter.get() || file.is_open()))
+    {
+        error = "aborted before all activity schedules were written";
+    }
+
+    if (copyInserter.get() && !copyInserter->endCopy(error))
+    {
+        if (error.empty())
+        {
+            error = "activity schedule COPY failed";
+        }
+    }
+    if (file.is_open())
+    {
+        file.close();
+        if (file.fail() && error.empty())
+        {
+            error = "activity schedule file could not be written";
+        }
+    }
+
+    if (!error.empty())
+    {
+        throw std::runtime_error("ActivityScheduleWriter: " + error);
+    }
+}
+
+void ActivityScheduleWriter::run()
+{
+    std::string buffer;
+    while (buffers.pop(buffer))
+    {
+        if (!error.empty())
+        {
+            continue; // drain the queue so that the preday threads are not blocked
+        }
+        if (copyInserter.get())
+        {
+            if (!copyInserter->putCopyData(buffer))
+            {
+                error = "failed to send activity schedule rows to the database";
+            }
+        }
+        else if (!file.write(buffer.data(), buffer.size()))
+        {
+            error = "failed to write activity schedule rows to file";
+        }
+    }
+}
@@ -0,0 +1,116 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/thread.hpp>
+#include <boost/utility.hpp>
+#include "database/PG_BulkInserter.hpp"
+#include "util/BoundedQueue.hpp"
+
+namespace sim_mob
+{
+namespace medium
+{
+
+/**
+ * Writes the activity schedules produced by the preday threads to their destination on a dedicated thread.
+ *
+ * The preday threads hand over buffers of complete activity schedule rows with write(). The writer thread either
+ * streams them into the day activity schedule table through a single COPY, or appends them to a single csv file
+ * (the fallback when the database cannot be reached, or when the schedules are only written to file).
+ */
+class ActivityScheduleWriter : private boost::noncopyable
+{
+public:
+    /**
+     * @param maxPendingBuffers maximum number of buffers waiting to be written; write() blocks beyond this
+     */
+    explicit ActivityScheduleWriter(std::size_t maxPendingBuffers);
+
+    /**
+     * Aborts the writer if close() was not called (e.g. while an exception unwinds the preday run), so that a partial
+     * COPY is rolled back rather than committed; errors are only logged
+     */
+    ~ActivityScheduleWriter();
+
+    /**
+     * Starts streaming the rows into a table through a single COPY
+     *
+     * @param connectionStr database connection string
+     * @param tableName name of the (existing) table
+     * @param columnNames columns of the rows, in order
+     *
+     * @return true if the COPY was started; false if the writer was not opened
+     */
+    bool openCopy(const std::string& connectionStr, const std::string& tableName, const std::vector<std::string>& columnNames);
+
+    /**
+     * Starts writing the rows to a file
+     *
+     * @param fileName name of the file; truncated if it exists
+     *
+     * @return true if the file was opened; false if the writer was not opened
+     */
+    bool openFile(const std::string& fileName);
+
+    /**
+     * Hands a buffer of complete rows over to the writer thread. Thread safe.
+     *
+     * @param buffer rows to write; moved out (left empty)
+     */
+    void write(std::string& buffer);
+
+    /**
+     * Writes the remaining buffers, ends the COPY or closes the file, and stops the writer thread
+     *
+     * @throws std::runtime_error if the rows could not be written
+     */
+    void close();
+
+    /**
+     * @return true if the rows are streamed into the database
+     */
+    bool isCopying() const
+    {
+        return copyInserter.get() != nullptr;
+    }
+
+private:
+    /**
+     * Body of the writer thread
+     */
+    void run();
+
+    /**
+     * Stops the writer thread and ends the COPY or closes the file
+     *
+     * @param completed true if all rows were handed over; otherwise the COPY is aborted
+     *
+     * @throws std::runtime_error if the rows could not be written, or were aborted
+     */
+    void finish(bool completed);
+
+    BoundedQueue<std::string> buffers;
+
+    /// COPY session when streaming into the database
+    std::unique_ptr<PG_BulkInserter> copyInserter;
+
+    /// output file when writing to file
+    std::ofstream file;
+
+    boost::thread writerThread;
+
+    /// description of the first write error; set by the writer thread, read after it is joined
+    std::string error;
+
+    bool closed;
+};
+
+}
+}
@@ -30,9 +30,12 @@
 #include "database/predaydao/ZoneCostSqlDao.hpp"
 #include "logging/NullableOutputStream.hpp"
 #include "logging/Log.hpp"
+#include "util/ChunkScheduler.hpp"
 #include "util/CSVReader.hpp"
 #include "util/LangHelpers.hpp"
 #include "util/Utils.hpp"
+#include "ActivityScheduleWriter.hpp"
+#include "PredayPopulationLoader.hpp"
 
 using namespace std;
 using namespace sim_mob;
@@ -50,6 +53,7 @@ const std::string LOWER_LIMIT_CSV_HEADER = "lower_limit";
 const std::string UPPER_LIMIT_CSV_HEADER = "upper_limit";
 
 const std::size_t NUM_INSERTS_PER_QUERY = 100000;
+const std::string ACTIVITY_SCHEDULE_FILE_NAME = "activity_schedule";
 
 /** vector of variables to be calibrated. used only in calibration mode of Preday*/
 std::vector<CalibrationVariable> calibrationVariablesList;
@@ -474,63 +478,21 @@ void printParameters(const std::vector<CalibrationVariable>& calVarList, const s
 }
 
 /**
- * flush stream contents to file
- * @param logHandle handle to output file
- * @param strm stringstream to flush
+ * prints the busy and idle time of each thread in the last run of a scheduler
+ * @param scheduler the scheduler
+ * @param phase name of the work done in the run
  */
-void outputToFile(std::ofstream& logHandle, std::stringstream& strm)
+void printSchedulerStatistics(const ChunkScheduler& scheduler, const std::string& phase)
 {
-	NullableOutputStream(&logHandle) << strm.str() << std::flush;
-	strm.str(std::string());
-}
-
-/**
- * constructs unique file name strings by appending serial numbers to prefix
- * @param numFiles number of file names to generate
- * @param prefix prefix string to use in file
- * @param outFileNamesList out list to populate with generated file names
- */
-void constructFileNames(size_t numFiles, const std::string& prefix, std::list<std::string>& outFileNamesList)
-{
-	std::stringstream fileName;
-	for (unsigned i = 1; i <= numFiles; i++)
-	{
-		fileName << prefix << i << ".log";
-		outFileNamesList.push_back(fileName.str());
-		fileName.str(std::string());
-	}
-}
-
-void mergeCSV_Files(const std::list<std::string>& fileNameList, const std::string& fileName)
-{
-	//This can take some time.
-	StopWatch sw;
-	sw.start();
-	std::cout << "Merging files, this can take several minutes...\n";
-
-	//One-by-one.
-	std::ofstream out(fileName.c_str(), std::ios::trunc | std::ios::binary);
-	if (!out.good())
-	{
-		throw std::runtime_error("Error: Can't write to file.");
-	}
-	for (std::list<std::string>::const_iterator it = fileNameList.begin(); it != fileNameList.end(); it++)
+	const std::vector<ChunkScheduler::ThreadStatistics>& statistics = scheduler.getStatistics();
+	std::stringstream out;
+	out << phase << " threads (chunk size " << scheduler.getChunkSize() << "):\n";
+	for (size_t i = 0; i < statistics.size(); i++)
 	{
-		Print() << "  Merging: " << *it << std::endl;
-		std::ifstream src(it->c_str(), std::ios::binary);
-		if (src.fail())
-		{
-			throw std::runtime_error("Error: Can't read from file.");
-		}
-
-		//If src is good, this part's easy.
-		out << src.rdbuf();
-		src.close();
+		out << "  thread " << (i + 1) << ": busy " << statistics[i].busySeconds << "s, idle " << statistics[i].idleSeconds
+				<< "s, " << statistics[i].items << " persons in " << statistics[i].chunks << " chunks\n";
 	}
-	out.close();
-
-	sw.stop();
-	std::cout << "Files merged; took " << sw.getTime() << "s\n";
+	Print() << out.str();
 }
 
 /**
@@ -551,10 +513,95 @@ DB_Connection getDB_Connection(const DatabaseDetails& dbInfo)
 	return DB_Connection(sim_mob::db::POSTGRES, dbConfig);
 }
 
+/**
+ * (re)creates the day activity schedule table
+ * @param sql_ database session
+ * @param tableName qualified name of the table
+ */
+void createDayActivityScheduleTable(soci::session& sql_, const std::string& tableName)
+{
+	/// Delete the table if it already exists
+	soci::statement query = (sql_.prepare << "DROP TABLE IF EXISTS " << tableName);
+
+	query.execute();
+
+	/// Create the table
+	if (!(MT_Config::getInstance().isEnergyModelEnabled()))
+    {
+		query = (sql_.prepare << "CREATE TABLE " << tableName
+							  << "(person_id character varying,"
+									  "tour_no integer,"
+									  "tour_type character varying,"
+									  "stop_no integer,"
+									  "stop_type character varying,"
+									  "stop_location integer,"
+									  "stop_zone integer,"
+									  "stop_mode character varying,"
+									  "primary_stop boolean,"
+									  "arrival_time numeric,"
+									  "departure_time numeric,"
+									  "prev_stop_location integer,"
+									  "prev_stop_zone integer,"
+									  "prev_stop_departure_time numeric,"
+									  "pid bigserial NOT NULL"
+									  ") WITH (OIDS=FALSE)");
+	}
+	else if (MT_Config::getInstance().isEnergyModelEnabled())
+	{
+
+		query = (sql_.prepare << "CREATE TABLE " << tableName
+							  << "(person_id character varying,"
+									  "tour_no integer,"
+									  "tour_type character varying,"
+									  "stop_no integer,"
+									  "stop_type character varying,"
+									  "stop_location integer,"
+									  "stop_zone integer,"
+									  "stop_mode character varying,"
+									  "primary_stop boolean,"
+									  "arrival_time numeric,"
+									  "departure_time numeric,"
+									  "prev_stop_location integer,"
+									  "prev_stop_zone integer,"
+									  "prev_stop_departure_time numeric,"
+									  "pid bigserial NOT NULL, "
+									  "drivetrain character varying DEFAULT 'ICE',"
+									  "make character varying  DEFAULT ' ',"
+									  "model character varying  DEFAULT ' '"
+									  ") WITH (OIDS=FALSE)");
+	}
+	query.execute();
+
+	/// Alter table owner
+	query = (sql_.prepare << "ALTER TABLE " << tableName << " OWNER TO postgres");
+	query.execute();
+}
+
+/**
+ * @return columns of the day activity schedule table written by the preday simulation, in order
+ */
+std::vector<std::string> getDayActivityScheduleColumns()
+{
+    std::vector<std::string> columnNames;
+    if(!(MT_Config::getInstance().isEnergyModelEnabled()))
+    {
+        columnNames = {"person_id", "tour_no", "tour_type", "stop_no", "stop_type", "stop_location",
+                                                "stop_zone", "stop_mode", "primary_stop", "arrival_time", "departure_time",
+                                                "prev_stop_location", "prev_stop_zone", "prev_stop_departure_time"};
+    }
+    else
+    {
+        columnNames = {"person_id", "tour_no", "tour_type", "stop_no", "stop_type", "stop_location",
+                       "stop_zone", "stop_mode", "primary_stop", "arrival_time", "departure_time",
+                       "prev_stop_location", "prev_stop_zone", "prev_stop_departure_time","drivetrain","make","model"};
+    }
+    return columnNames;
+}
+
 } //end anonymous namespace
 
 sim_mob::medium::PredayManager::PredayManager() :
-		mtConfig(MT_Config::getInstance()), logFile(nullptr)
+		mtConfig(MT_Config::getInstance()), logFile(nullptr), activityScheduleCopied(false)
 {
 }
 
@@ -761,17 +808,94 @@ void sim_mob::medium::PredayManager::loadUnavailableODs()
 	}
 }
 
-void sim_mob::medium::PredayManager::dispatchLT_Persons()
+void sim_mob::medium::PredayManager::loadTravelTimeMatrix()
 {
-	boost::thread_group threadGroup;
-	unsigned numWorkers = mtConfig.getNumPredayThreads();
-	std::list<std::string> logFileNames;
-	std::string logFileNamePrefix;
-	if (mtConfig.runningPredaySimulation())
+	if (!mtConfig.isTravelTimeMatrixEnabled())
+	{
+		return;
+	}
+
+	std::vector<int> zoneCodes;
+	zoneCodes.reserve(zoneMap.size());
+	for (ZoneMap::const_iterator zoneIt = zoneMap.begin(); zoneIt != zoneMap.end(); zoneIt++)
+	{
+		zoneCodes.push_back(zoneIt->second->getZoneCode());
+	}
+
+	// the travel time tables are rewritten between iterations of the mid-term full loop under the same names,
+	// so the cache is keyed on their configured version as well as their names
+	const uint64_t fingerprint = TimeDependentTT_Matrix::computeFingerprint(TimeDependentTT_SqlDao::getTableName(TravelTimeMode::TT_PRIVATE)
+			+ "|" + TimeDependentTT_SqlDao::getTableName(TravelTimeMode::TT_PUBLIC) + "|" + mtConfig.getTravelTimeMatrixVersion());
+
+	const std::string& cacheFile = mtConfig.getTravelTimeMatrixCacheFile();
+	if (!cacheFile.empty() && ttMatrix.load(cacheFile, zoneCodes, fingerprint))
+	{
+		Print() << "Travel time matrix mapped from " << cacheFile << " (" << ttMatrix.getNumZones() << " zones)\n";
+		return;
+	}
+
+	DB_Connection simmobConn = getDB_Connection(ConfigManager::GetInstance().FullConfig().networkDatabase);
+	simmobConn.connect();
+	if (!simmobConn.isConnected())
+	{
+		throw std::runtime_error("simmob db connection failure!");
+	}
+	ttMatrix.initialize(zoneCodes, fingerprint);
+	TimeDependentTT_SqlDao tcostDao(simmobConn);
+	std::size_t numPvtRecords = tcostDao.getAll(TravelTimeMode::TT_PRIVATE, ttMatrix);
+	std::size_t numPubRecords = tcostDao.getAll(TravelTimeMode::TT_PUBLIC, ttMatrix);
+	Print() << "Travel time matrix loaded: " << ttMatrix.getNumZones() << " zones, " << numPvtRecords << " private and "
+			<< numPubRecords << " public transit ODs, " << (ttMatrix.getStorageSize() >> 20) << " MB\n";
+
+	if (!cacheFile.empty())
+	{
+		if (ttMatrix.save(cacheFile))
+		{
+			Print() << "Travel time matrix saved to " << cacheFile << "\n";
+		}
+		else
+		{
+			Warn() << "Travel time matrix could not be saved to " << cacheFile << "\n";
+		}
+	}
+}
+
+void sim_mob::medium::PredayManager::loadTourModeDestinationLogsumModels()
+{
+	if (!mtConfig.isCompiledLogsumsEnabled() || mtConfig.runningPredayCalibration())
+	{
+		return;
+	}
+
+	const ConfigParams& cfg = ConfigManager::GetInstance().FullConfig();
+	const std::string& scriptsPath = cfg.predayLuaScriptsMap.getPath();
+	const std::map<std::string, std::string>& scriptFileNames = cfg.predayLuaScriptsMap.getScriptsFileNameMap();
+	for (const auto& activity : cfg.getActivityTypeConfigMap())
 	{
-		logFileNamePrefix = "activity_schedule";
+		const std::string& modelName = activity.second.tourModeDestModel;
+		if (modelName.empty() || tmdLogsumModels.count(modelName) || !TourModeDestinationLogsumModel::isSupported(modelName))
+		{
+			continue;
+		}
+		std::map<std::string, std::string>::const_iterator scriptIt = scriptFileNames.find(modelName);
+		if (scriptIt == scriptFileNames.end())
+		{
+			continue;
+		}
+
+		std::ifstream script((scriptsPath + scriptIt->second).c_str());
+		std::unique_ptr<TourModeDestinationLogsumModel> model(new TourModeDestinationLogsumModel());
+		if (script && model->load(modelName, script, mtConfig.getCompiledLogsumValidationSamples(), mtConfig.getCompiledLogsumTolerance()))
+		{
+			Print() << "Compiled logsums enabled for tour mode/destination model " << modelName << "\n";
+			tmdLogsumModels[modelName] = std::move(model);
+		}
 	}
-	constructFileNames(numWorkers, logFileNamePrefix, logFileNames);
+}
+
+void sim_mob::medium::PredayManager::dispatchLT_Persons()
+{
+	unsigned numWorkers = mtConfig.getNumPredayThreads();
 
 	if(mtConfig.runningPredayLogsumComputation())
 	{
@@ -803,76 +927,46 @@ void sim_mob::medium::PredayManager::dispatchLT_Persons()
 		}
 	}
 
-	if (numWorkers == 1)
-	{ // if single threaded execution was requested
-		if (mtConfig.runningPredaySimulation())
-		{
-			processPersonsForLT_Population(ltPersonIdList.begin(), ltPersonIdList.end(), logFileNames.front());
-		}
-		else if (mtConfig.runningPredayLogsumComputation())
-		{
-			computeLogsumsForLT_Population(ltPersonIdList.begin(), ltPersonIdList.end());
-		}
-	}
-	else
+	/*
+	 * The threads claim small chunks of the person id list as they go, so that threads processing costlier persons
+	 * do not hold up the others. The person id list must not be changed while the threads are running.
+	 */
+	ChunkScheduler scheduler(numWorkers, mtConfig.getPopulationBatchSize());
+	Print() << "numPersons:" << ltPersonIdList.size() << "|numWorkers:" << numWorkers << "|chunkSize:" << scheduler.getChunkSize() << std::endl;
+	if (mtConfig.runningPredaySimulation())
 	{
-		LT_PersonIdList::size_type numPersons = ltPersonIdList.size();
-		LT_PersonIdList::size_type numPersonsPerThread = numPersons / numWorkers;
-		Print() << "numPersons:" << numPersons << "|numWorkers:" << numWorkers << "|numPersonsPerThread:" << numPersonsPerThread << std::endl;
-
-		/*
-		 * We are passing different iterators on the same list into the threaded
-		 * function. Each thread will iterate through a mutually exclusive and
-		 * exhaustive set of persons from the population.
-		 *
-		 * Note that each thread will iterate the same personList with different
-		 * start and end iterators. It is therefore important that none of the
-		 * threads change the personList.
-		 */
-		LT_PersonIdList::iterator first = ltPersonIdList.begin();
-		LT_PersonIdList::iterator last = ltPersonIdList.begin() + numPersonsPerThread;
-		std::list<std::string>::const_iterator fileNameIt = logFileNames.begin();
-		for (int i = 1; i <= numWorkers; i++)
+		// the activity schedules of all threads are written to a single file by a writer thread
+		ActivityScheduleWriter scheduleWriter(2 * numWorkers);
+		ActivityScheduleWriter* scheduleWriterPtr = nullptr;
+		if (mtConfig.isFileOutputEnabled())
 		{
-			if (mtConfig.runningPredaySimulation())
-			{
-				threadGroup.create_thread(boost::bind(&PredayManager::processPersonsForLT_Population, this, first, last, (*fileNameIt)));
-				fileNameIt++;
-			}
-			else if (mtConfig.runningPredayLogsumComputation())
-			{
-				threadGroup.create_thread(boost::bind(&PredayManager::computeLogsumsForLT_Population, this, first, last));
-			}
-
-			first = last;
-			if (i + 1 == numWorkers)
+			if (!scheduleWriter.openFile(ACTIVITY_SCHEDULE_FILE_NAME))
 			{
-				// if the next iteration is the last take all remaining persons
-				last = ltPersonIdList.end();
-			}
-			else
-			{
-				last = last + numPersonsPerThread;
+				throw std::runtime_error("Error: Can't write to file " + ACTIVITY_SCHEDULE_FILE_NAME);
 			}
+			scheduleWriterPtr = &scheduleWriter;
 		}
-		threadGroup.join_all();
+		scheduler.run(ltPersonIdList.size(), [this, scheduleWriterPtr](ChunkScheduler::Worker& worker)
+		{
+			processPersonsForLT_Population(worker, scheduleWriterPtr);
+		});
+		scheduleWriter.close();
+		printSchedulerStatistics(scheduler, "preday simulation");
 	}
-
-	// merge log files from each thread into 1 file.
-	if (mtConfig.isFileOutputEnabled())
+	else if (mtConfig.runningPredayLogsumComputation())
 	{
-		mergeCSV_Files(logFileNames, logFileNamePrefix);
+		scheduler.run(ltPersonIdList.size(), [this](ChunkScheduler::Worker& worker)
+		{
+			computeLogsumsForLT_Population(worker);
+		});
+		printSchedulerStatistics(scheduler, "logsum computation");
 	}
 }
 
 
 void PredayManager::runLogSumComputation()
 {
-    boost::thread_group threadGroup;
     unsigned numWorkers = mtConfig.getNumPredayThreads();
-    std::list<std::string> logFileNames;
-    std::string logFileNamePrefix;
-    constructFileNames(numWorkers, logFileNamePrefix, logFileNames);
 
     // logsum data source
     DB_Connection simmobConn = getDB_Connection(ConfigManager::GetInstance().FullConfig().networkDatabase);
@@ -901,103 +995,61 @@ void PredayManager::runLogSumComputation()
         Print() << logsumTableName << " truncation failed!\n";
     }
 
-    if (numWorkers == 1)
-    { // if single threaded execution was requested
-        computeLogsumsForLT_Population(ltPersonIdList.begin(), ltPersonIdList.end());
-    }
-    else
+    // the threads claim small chunks of the person id list as they go
+    ChunkScheduler scheduler(numWorkers, mtConfig.getPopulationBatchSize());
+    Print() << "numPersons:" << ltPersonIdList.size() << "|numWorkers:" << numWorkers << "|chunkSize:" << scheduler.getChunkSize() << std::endl;
+    scheduler.run(ltPersonIdList.size(), [this](ChunkScheduler::Worker& worker)
     {
-        LT_PersonIdList::size_type numPersons = ltPersonIdList.size();
-        LT_PersonIdList::size_type numPersonsPerThread = numPersons / numWorkers;
-        Print() << "numPersons:" << numPersons << "|numWorkers:" << numWorkers << "|numPersonsPerThread:" << numPersonsPerThread << std::endl;
-
-        /*
-         * We are passing different iterators on the same list into the threaded
-         * function. Each thread will iterate through a mutually exclusive and
-         * exhaustive set of persons from the population.
-         *
-         * Note that each thread will iterate the same personList with different
-         * start and end iterators. It is therefore important that none of the
-         * threads change the personList.
-         */
-        LT_PersonIdList::iterator first = ltPersonIdList.begin();
-        LT_PersonIdList::iterator last = ltPersonIdList.begin() + numPersonsPerThread;
-        std::list<std::string>::const_iterator fileNameIt = logFileNames.begin();
-        for (int i = 1; i <= numWorkers; i++)
-        {
-            threadGroup.create_thread(boost::bind(&PredayManager::computeLogsumsForLT_Population, this, first, last));
-            first = last;
-            if (i + 1 == numWorkers)
-            {
-                // if the next iteration is the last take all remaining persons
-                last = ltPersonIdList.end();
-            }
-            else
-            {
-                last = last + numPersonsPerThread;
-            }
-        }
-        threadGroup.join_all();
-    }
-
-
+        computeLogsumsForLT_Population(worker);
+    });
+    printSchedulerStatistics(scheduler, "logsum computation");
 }
 
 
 void PredayManager::runPredaySimulation()
 {
-    boost::thread_group threadGroup;
     unsigned numWorkers = mtConfig.getNumPredayThreads();
-    std::list<std::string> logFileNames;
-    std::string logFileNamePrefix;
-    logFileNamePrefix = "activity_schedule";
-    constructFileNames(numWorkers, logFileNamePrefix, logFileNames);
-    if (numWorkers == 1)
-    { // if single threaded execution was requested
-        processPersonsForLT_Population(ltPersonIdList.begin(), ltPersonIdList.end(), logFileNames.front());
-    }
-    else
+
+    /*
+     * The activity schedules of all threads are handed to a writer thread, which streams them into the day activity
+     * schedule table through a single COPY. If the COPY cannot be started, they are written to the activity schedule
+     * file instead, from which updateDayActivityScheduleTable() loads them.
+     */
+    ActivityScheduleWriter scheduleWriter(2 * numWorkers);
+    ActivityScheduleWriter* scheduleWriterPtr = nullptr;
+    activityScheduleCopied = false;
+    if (mtConfig.isFileOutputEnabled())
     {
-        LT_PersonIdList::size_type numPersons = ltPersonIdList.size();
-        LT_PersonIdList::size_type numPersonsPerThread = numPersons / numWorkers;
-        Print() << "numPersons:" << numPersons << "|numWorkers:" << numWorkers << "|numPersonsPerThread:" << numPersonsPerThread << std::endl;
-
-        /*
-         * We are passing different iterators on the same list into the threaded
-         * function. Each thread will iterate through a mutually exclusive and
-         * exhaustive set of persons from the population.
-         *
-         * Note that each thread will iterate the same personList with different
-         * start and end iterators. It is therefore important that none of the
-         * threads change the personList.
-         */
-        LT_PersonIdList::iterator first = ltPersonIdList.begin();
-        LT_PersonIdList::iterator last = ltPersonIdList.begin() + numPersonsPerThread;
-        std::list<std::string>::const_iterator fileNameIt = logFileNames.begin();
-        for (int i = 1; i <= numWorkers; i++)
+        const std::string tableName = mtConfig.dasConfig.schema + "." + mtConfig.dasConfig.table;
+        if (mtConfig.dasConfig.streamToTable)
         {
-            threadGroup.create_thread(boost::bind(&PredayManager::processPersonsForLT_Population, this, first, last, (*fileNameIt)));
-            fileNameIt++;
-
-            first = last;
-            if (i + 1 == numWorkers)
+            const std::string connectionStr = ConfigManager::GetInstance().FullConfig().getDatabaseConnectionString(false);
+            soci::session sql_(soci::postgresql, connectionStr);
+            createDayActivityScheduleTable(sql_, tableName);
+            sql_.close();
+            activityScheduleCopied = scheduleWriter.openCopy(connectionStr, tableName, getDayActivityScheduleColumns());
+            if (!activityScheduleCopied)
             {
-                // if the next iteration is the last take all remaining persons
-                last = ltPersonIdList.end();
-            }
-            else
-            {
-                last = last + numPersonsPerThread;
+                Warn() << "COPY into " << tableName << " could not be started; writing activity schedules to "
+                        << mtConfig.dasConfig.fileName << " instead" << std::endl;
             }
         }
-        threadGroup.join_all();
+        if (!activityScheduleCopied && !scheduleWriter.openFile(mtConfig.dasConfig.fileName))
+        {
+            throw std::runtime_error("Error: Can't write to file " + mtConfig.dasConfig.fileName);
+        }
+        scheduleWriterPtr = &scheduleWriter;
     }
 
-    // merge log files from each thread into 1 file.
-    if (mtConfig.isFileOutputEnabled())
+    // the threads claim small chunks of the person id list as they go
+    ChunkScheduler scheduler(numWorkers, mtConfig.getPopulationBatchSize());
+    Print() << "numPersons:" << ltPersonIdList.size() << "|numWorkers:" << numWorkers << "|chunkSize:" << scheduler.getChunkSize() << std::endl;
+    scheduler.run(ltPersonIdList.size(), [this, scheduleWriterPtr](ChunkScheduler::Worker& worker)
     {
-        mergeCSV_Files(logFileNames, logFileNamePrefix);
-    }
+        processPersonsForLT_Population(worker, scheduleWriterPtr);
+    });
+    scheduleWriter.close();
+    printSchedulerStatistics(scheduler, "preday simulation");
 }
 
 
@@ -1008,83 +1060,21 @@ void PredayManager::updateDayActivityScheduleTable()
 	std::string tableName = mtCfg.dasConfig.schema + "." + mtCfg.dasConfig.table;
 
 	soci::session sql_(soci::postgresql, ConfigManager::GetInstanceRW().FullConfig().getDatabaseConnectionString(false));
-	/// Delete the table if it already exists
-	soci::statement query = (sql_.prepare << "DROP TABLE IF EXISTS " << tableName);
 
-	query.execute();
-
-	/// Create the table
-	if (!(MT_Config::getInstance().isEnergyModelEnabled()))
-    {
-		query = (sql_.prepare << "CREATE TABLE " << tableName
-							  << "(person_id character varying,"
-									  "tour_no integer,"
-									  "tour_type character varying,"
-									  "stop_no integer,"
-									  "stop_type character varying,"
-									  "stop_location integer,"
-									  "stop_zone integer,"
-									  "stop_mode character varying,"
-									  "primary_stop boolean,"
-									  "arrival_time numeric,"
-									  "departure_time numeric,"
-									  "prev_stop_location integer,"
-									  "prev_stop_zone integer,"
-									  "prev_stop_departure_time numeric,"
-									  "pid bigserial NOT NULL"
-									  ") WITH (OIDS=FALSE)");
-	}
-	else if (MT_Config::getInstance().isEnergyModelEnabled())
+	if (!activityScheduleCopied)
 	{
+		// the activity schedules were written to file; load them into a new table
+		createDayActivityScheduleTable(sql_, tableName);
 
-		query = (sql_.prepare << "CREATE TABLE " << tableName
-							  << "(person_id character varying,"
-									  "tour_no integer,"
-									  "tour_type character varying,"
-									  "stop_no integer,"
-									  "stop_type character varying,"
-									  "stop_location integer,"
-									  "stop_zone integer,"
-									  "stop_mode character varying,"
-									  "primary_stop boolean,"
-									  "arrival_time numeric,"
-									  "departure_time numeric,"
-									  "prev_stop_location integer,"
-									  "prev_stop_zone integer,"
-									  "prev_stop_departure_time numeric,"
-									  "pid bigserial NOT NULL, "
-									  "drivetrain character varying DEFAULT 'ICE',"
-									  "make character varying  DEFAULT ' ',"
-									  "model character varying  DEFAULT ' '"
-									  ") WITH (OIDS=FALSE)");
+		PG_BulkInserter bulkInserter(NUM_INSERTS_PER_QUERY);
+		bulkInserter.setInputFile(mtCfg.dasConfig.fileName);
+		bulkInserter.buildQuery(tableName, getDayActivityScheduleColumns());
+		bulkInserter.connect(ConfigManager::GetInstance().FullConfig().getDatabaseConnectionString(false));
+		bulkInserter.bulkInsert();
 	}
-	query.execute();
-
-	/// Alter table owner
-	query = (sql_.prepare << "ALTER TABLE " << tableName << " OWNER TO postgres");
-	query.execute();
-
-	PG_BulkInserter bulkInserter(NUM_INSERTS_PER_QUERY);
-	bulkInserter.setInputFile(mtCfg.dasConfig.fileName);
-    std::vector<std::string> columnNames;
-    if(!(MT_Config::getInstance().isEnergyModelEnabled()))
-    {
-        columnNames = {"person_id", "tour_no", "tour_type", "stop_no", "stop_type", "stop_location",
-                                                "stop_zone", "stop_mode", "primary_stop", "arrival_time", "departure_time",
-                                                "prev_stop_location", "prev_stop_zone", "prev_stop_departure_time"};
-    }
-    else
-    {
-        columnNames = {"person_id", "tour_no", "tour_type", "stop_no", "stop_type", "stop_location",
-                       "stop_zone", "stop_mode", "primary_stop", "arrival_time", "departure_time",
-                       "prev_stop_location", "prev_stop_zone", "prev_stop_departure_time","drivetrain","make","model"};
-    }
-	bulkInserter.buildQuery(tableName, columnNames);
-	bulkInserter.connect(ConfigManager::GetInstance().FullConfig().getDatabaseConnectionString(false));
-	bulkInserter.bulkInsert();
 
 	/// Create Indexes and update sharing modes
-	query = (sql_.prepare << "SELECT " << mtCfg.dasConfig.updateProc << "('" << mtCfg.dasConfig.schema << "','" << mtCfg.dasConfig.table << "');");
+	soci::statement query = (sql_.prepare << "SELECT " << mtCfg.dasConfig.updateProc << "('" << mtCfg.dasConfig.schema << "','" << mtCfg.dasConfig.table << "');");
 	query.execute();
 
 	sql_.close();
@@ -1164,46 +1154,16 @@ void PredayManager::updateGetPersonBetweenStoredProc()
 
 void sim_mob::medium::PredayManager::distributeAndProcessForCalibration(threadedFnPtr fnPtr)
 {
-	boost::thread_group threadGroup;
-	size_t numWorkers = mtConfig.getNumPredayThreads();
-	if (numWorkers == 1)
-	{ // if single threaded execution was requested
-		(this->*fnPtr)(personList.begin(), personList.end(), 0);
-	}
-	else
+	/*
+	 * The threads claim small chunks of the person list as they go, so that threads processing costlier persons
+	 * do not hold up the others. The person list must not be changed while the threads are running.
+	 */
+	ChunkScheduler scheduler(mtConfig.getNumPredayThreads(), mtConfig.getPredayChunkSize());
+	scheduler.run(personList.size(), [this, fnPtr](ChunkScheduler::Worker& worker)
 	{
-		size_t numPersons = personList.size();
-		size_t numPersonsPerThread = numPersons / numWorkers;
-		PersonList::iterator first = personList.begin();
-		PersonList::iterator last = personList.begin() + numPersonsPerThread;
-		Print() << "numPersons:" << numPersons << "|numWorkers:" << numWorkers << "|numPersonsPerThread:" << numPersonsPerThread << std::endl;
-
-		/*
-		 * Passing different iterators on the same list into the threaded
-		 * function. So each thread will iterate mutually exclusive and
-		 * exhaustive set of persons from the population.
-		 *
-		 * Note that each thread will iterate the same personList with different
-		 * start and end iterators. It is therefore important that none of the
-		 * threads change the personList.
-		 */
-		for (size_t i = 1; i <= numWorkers; i++)
-		{
-			threadGroup.create_thread(boost::bind(fnPtr, this, first, last, i - 1));
-
-			first = last;
-			if (i + 1 == numWorkers)
-			{
-				// if the next iteration is the last take all remaining persons
-				last = personList.end();
-			}
-			else
-			{
-				last = last + numPersonsPerThread;
-			}
-		}
-		threadGroup.join_all();
-	}
+		(this->*fnPtr)(worker);
+	});
+	printSchedulerStatistics(scheduler, "calibration");
 }
 
 void sim_mob::medium::PredayManager::calibratePreday()
@@ -1408,33 +1368,39 @@ void sim_mob::medium::PredayManager::loadWeightMatrix()
 	}
 }
 
-void sim_mob::medium::PredayManager::processPersonsForCalibration(const PersonList::iterator& firstPersonIt, const PersonList::iterator& oneAfterLastPersonIt,
-		size_t threadNum)
+void sim_mob::medium::PredayManager::processPersonsForCalibration(ChunkScheduler::Worker& worker)
 {
-	CalibrationStatistics& simStats = simulatedStatsVector.at(threadNum);
+	CalibrationStatistics& simStats = simulatedStatsVector.at(worker.getThreadNum());
 	bool consoleOutput = mtConfig.isConsoleOutput();
 
     const ConfigParams& cfg = ConfigManager::GetInstance().FullConfig();
 
-	// time dependent zone-zone travel time data source
-    DB_Connection simmobConn = getDB_Connection(cfg.networkDatabase);
-	simmobConn.connect();
-	if (!simmobConn.isConnected())
+	// time dependent zone-zone travel time data source; not queried when the travel time matrix is loaded
+	DB_Connection simmobConn = getDB_Connection(cfg.networkDatabase);
+	if (!ttMatrix.isLoaded())
 	{
-		throw std::runtime_error("simmobility db connection failure!");
+		simmobConn.connect();
+		if (!simmobConn.isConnected())
+		{
+			throw std::runtime_error("simmobility db connection failure!");
+		}
 	}
 	TimeDependentTT_SqlDao tcostDao(simmobConn);
 
     const std::unordered_map<StopType, ActivityTypeConfig>& activityTypeConfig = cfg.getActivityTypeConfigMap();
 
-	for (PersonList::iterator i = firstPersonIt; i != oneAfterLastPersonIt; i++)
+	size_t first, last;
+	while (worker.claim(first, last))
 	{
-        PredaySystem predaySystem(**i, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
-		predaySystem.planDay();
-		predaySystem.updateStatistics(simStats);
-		if (consoleOutput)
+		for (PersonList::iterator i = personList.begin() + first; i != personList.begin() + last; i++)
 		{
-			predaySystem.printLogs();
+			PredaySystem predaySystem(**i, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, ttMatrix, tmdLogsumModels, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
+			predaySystem.planDay();
+			predaySystem.updateStatistics(simStats);
+			if (consoleOutput)
+			{
+				predaySystem.printLogs();
+			}
 		}
 	}
 }
@@ -1517,10 +1483,8 @@ void sim_mob::medium::PredayManager::computeWeightedGradient(const std::vector<s
 	}
 }
 
-void sim_mob::medium::PredayManager::processPersonsForLT_Population(const LT_PersonIdList::iterator& firstPersonIdIt,
-		const LT_PersonIdList::iterator& oneAfterLastPersonIdIt, const std::string& activityScheduleLog)
+void sim_mob::medium::PredayManager::processPersonsForLT_Population(ChunkScheduler::Worker& worker, ActivityScheduleWriter* scheduleWriter)
 {
-	bool outputTripchains = mtConfig.isFileOutputEnabled();
 	bool consoleOutput = mtConfig.isConsoleOutput();
 
     const ConfigParams& cfg = ConfigManager::GetInstance().FullConfig();
@@ -1534,10 +1498,10 @@ void sim_mob::medium::PredayManager::processPersonsForLT_Population(const LT_Per
 	}
 	PopulationSqlDao populationDao(populationConn);
 
-	// logsum data source
-    DB_Connection simmobConn = getDB_Connection(cfg.networkDatabase);
-	simmobConn.connect();
-	if (!simmobConn.isConnected())
+	// logsum data source; used by the population loader thread only
+    DB_Connection logsumConn = getDB_Connection(cfg.networkDatabase);
+	logsumConn.connect();
+	if (!logsumConn.isConnected())
 	{
 		throw std::runtime_error("simmobility db connection failure!");
 	}
@@ -1550,68 +1514,94 @@ void sim_mob::medium::PredayManager::processPersonsForLT_Population(const LT_Per
 	activityLogsumColumns.push_back(activityTypeConfig.at(i).logsumTableColumn);
 	}
 
-	SimmobSqlDao logsumSqlDao(simmobConn, logsumTableName, activityLogsumColumns);
+	SimmobSqlDao logsumSqlDao(logsumConn, logsumTableName, activityLogsumColumns);
+
+	// time dependent zone-zone travel time data source
+    DB_Connection simmobConn = getDB_Connection(cfg.networkDatabase);
+	simmobConn.connect();
+	if (!simmobConn.isConnected())
+	{
+		throw std::runtime_error("simmobility db connection failure!");
+	}
 	TimeDependentTT_SqlDao tcostDao(simmobConn);
 
-	// open log file for this thread
-	std::ofstream activityScheduleLogFile(activityScheduleLog.c_str(), std::ios::trunc | std::ios::out);
 	std::stringstream activityScheduleStream;
+	std::string activityScheduleBuffer;
+
+	// persons and their logsums are loaded in batches while the day of the previous persons is being planned
+	PredayPopulationLoader populationLoader(ltPersonIdList, worker, mtConfig.getPopulationPrefetchBatches(),
+			[&populationDao, &logsumSqlDao](const PredayPopulationLoader::PersonIdList& ids, std::vector<PersonParams>& persons)
+			{
+				populationDao.getByIds(ids, persons);
+				logsumSqlDao.getLogsumsByIds(persons);
+			});
+	populationLoader.start();
 
 	// loop through all persons within the range and plan their day
-	for (LT_PersonIdList::iterator i = firstPersonIdIt; i != oneAfterLastPersonIdIt; i++)
+	std::vector<PersonParams> persons;
+	while (populationLoader.nextBatch(persons))
 	{
-		PersonParams personParams;
-		populationDao.getOneById(*i, personParams);
-		if (personParams.getPersonId().empty())
+		for (std::vector<PersonParams>::iterator i = persons.begin(); i != persons.end(); i++)
 		{
-			continue;
-		} // some persons are not complete in the database
-		logsumSqlDao.getLogsumById(*i, personParams);
-		PredaySystem predaySystem(personParams, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
-		predaySystem.planDay();
+			PersonParams& personParams = *i;
+			PredaySystem predaySystem(personParams, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, ttMatrix, tmdLogsumModels, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
+			predaySystem.planDay();
 
-		if (outputTripchains)
-		{
-			predaySystem.outputActivityScheduleToStream(zoneNodeMap, activityScheduleStream);
-			outputToFile(activityScheduleLogFile, activityScheduleStream);
+			if (scheduleWriter)
+			{
+				predaySystem.outputActivityScheduleToStream(zoneNodeMap, activityScheduleStream);
+			}
+			if (consoleOutput)
+			{
+				predaySystem.printLogs();
+			}
 		}
-		if (consoleOutput)
+
+		// hand the schedules of the batch over to the writer thread
+		if (scheduleWriter)
 		{
-			predaySystem.printLogs();
+			activityScheduleBuffer = activityScheduleStream.str();
+			activityScheduleStream.str(std::string());
+			scheduleWriter->write(activityScheduleBuffer);
 		}
 	}
 }
 
-void sim_mob::medium::PredayManager::computeLogsumsForCalibration(const PersonList::iterator& firstPersonIt, const PersonList::iterator& oneAfterLastPersonIt,
-		size_t threadNum)
+void sim_mob::medium::PredayManager::computeLogsumsForCalibration(ChunkScheduler::Worker& worker)
 {
 	bool consoleOutput = mtConfig.isConsoleOutput();
 	const ConfigParams& cfg = ConfigManager::GetInstance().FullConfig();
 
-	// time dependent zone-zone travel time data source
+	// time dependent zone-zone travel time data source; not queried when the travel time matrix is loaded
 	DB_Connection simmobConn = getDB_Connection(cfg.networkDatabase);
-	simmobConn.connect();
-	if (!simmobConn.isConnected())
+	if (!ttMatrix.isLoaded())
 	{
-		throw std::runtime_error("simmobility db connection failure!");
+		simmobConn.connect();
+		if (!simmobConn.isConnected())
+		{
+			throw std::runtime_error("simmobility db connection failure!");
+		}
 	}
 	TimeDependentTT_SqlDao tcostDao(simmobConn);
 	const std::unordered_map<StopType, ActivityTypeConfig>& activityTypeConfig = cfg.getActivityTypeConfigMap();
 
-	// loop through all persons within the range and plan their day
-	for (PersonList::iterator i = firstPersonIt; i != oneAfterLastPersonIt; i++)
+	// loop through the persons of the claimed chunks and compute their logsums
+	size_t first, last;
+	while (worker.claim(first, last))
 	{
-		PredaySystem predaySystem(**i, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
-		predaySystem.computeLogsums();
-		if (consoleOutput)
+		for (PersonList::iterator i = personList.begin() + first; i != personList.begin() + last; i++)
 		{
-			predaySystem.printLogs();
+			PredaySystem predaySystem(**i, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, ttMatrix, tmdLogsumModels, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
+			predaySystem.computeLogsums();
+			if (consoleOutput)
+			{
+				predaySystem.printLogs();
+			}
 		}
 	}
 }
 
-void sim_mob::medium::PredayManager::computeLogsumsForLT_Population(const LT_PersonIdList::iterator& firstPersonIdIt,
-		const LT_PersonIdList::iterator& oneAfterLastPersonIdIt)
+void sim_mob::medium::PredayManager::computeLogsumsForLT_Population(ChunkScheduler::Worker& worker)
 {
 	bool consoleOutput = mtConfig.isConsoleOutput();
 
@@ -1644,21 +1634,28 @@ void sim_mob::medium::PredayManager::computeLogsumsForLT_Population(const LT_Per
 	SimmobSqlDao logsumSqlDao(simmobConn, logsumTableName, activityLogsumColumns);
 	TimeDependentTT_SqlDao tcostDao(simmobConn);
 
-	// loop through all persons within the range and plan their day
-	for (LT_PersonIdList::iterator i = firstPersonIdIt; i != oneAfterLastPersonIdIt; i++)
+	// persons are loaded in batches while the logsums of the previous persons are being computed
+	PredayPopulationLoader populationLoader(ltPersonIdList, worker, mtConfig.getPopulationPrefetchBatches(),
+			[&populationDao](const PredayPopulationLoader::PersonIdList& ids, std::vector<PersonParams>& persons)
+			{
+				populationDao.getByIds(ids, persons);
+			});
+	populationLoader.start();
+
+	// loop through all persons within the range and compute their logsums
+	std::vector<PersonParams> persons;
+	while (populationLoader.nextBatch(persons))
 	{
-		PersonParams personParams;
-		populationDao.getOneById(*i, personParams);
-		if (personParams.getPersonId().empty())
+		for (std::vector<PersonParams>::iterator i = persons.begin(); i != persons.end(); i++)
 		{
-			continue;
-		} // some persons are not complete in the database
-        PredaySystem predaySystem(personParams, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
-		predaySystem.computeLogsums();
-		logsumSqlDao.insert(personParams);
-		if (consoleOutput)
-		{
-			predaySystem.printLogs();
+			PersonParams& personParams = *i;
+			PredaySystem predaySystem(personParams, zoneMap, zoneIdLookup, amCostMap, pmCostMap, opCostMap, tcostDao, ttMatrix, tmdLogsumModels, unavailableODs, activityTypeConfig, cfg.getNumTravelModes());
+			predaySystem.computeLogsums();
+			logsumSqlDao.insert(personParams);
+			if (consoleOutput)
+			{
+				predaySystem.printLogs();
+			}
 		}
 	}
 }
@@ -11,6 +11,9 @@
 #include <vector>
 #include "behavioral/params/PersonParams.hpp"
 #include "behavioral/params/ZoneCostParams.hpp"
+#include "behavioral/TimeDependentTT_Matrix.hpp"
+#include "behavioral/TourModeDestinationLogsumModel.hpp"
+#include "util/ChunkScheduler.hpp"
 #include "CalibrationStatistics.hpp"
 #include "config/MT_Config.hpp"
 #include "PredaySystem.hpp"
@@ -20,6 +23,7 @@ namespace sim_mob
 {
 namespace medium
 {
+class ActivityScheduleWriter;
 
 /**
  * structure to hold a calibration variable and its pertinent details.
@@ -145,6 +149,18 @@ public:
      */
     void loadUnavailableODs();
 
+    /**
+     * loads the time dependent travel times of all ODs into memory, if enabled in the config.
+     * The zones must have been loaded already.
+     */
+    void loadTravelTimeMatrix();
+
+    /**
+     * loads the coefficients of the tour mode/destination models which have a compiled implementation,
+     * if enabled in the config. Not used in calibration, since calibration changes the coefficients in the scripts.
+     */
+    void loadTourModeDestinationLogsumModels();
+
     /**
      * Distributes long-term persons to different threads and starts the threads which process the persons
      */
@@ -177,19 +193,17 @@ private:
     typedef std::vector<std::string> PersonIdList;
     typedef std::vector<long> LT_PersonIdList;
 
-    typedef void (PredayManager::*threadedFnPtr)(const PersonList::iterator&, const PersonList::iterator&, size_t);
+    typedef void (PredayManager::*threadedFnPtr)(ChunkScheduler::Worker&);
 
     /**
      * Threaded function loop for simulation of LT population
-     * Loops through all elements in personList within the specified range and
-     * invokes the Preday system of models for each of them.
+     * Loops through the persons of the chunks of ltPersonIdList claimed by the
+     * worker and invokes the Preday system of models for each of them.
      *
-     * @param first personIdList iterator corresponding to the first person to be
-     *              processed
-     * @param last personIdList iterator corresponding to the person after the
-     *              last person to be processed
+     * @param worker scheduler worker of the thread
+     * @param scheduleWriter writer of the activity schedules; nullptr if the schedules are not output
      */
-    void processPersonsForLT_Population(const LT_PersonIdList::iterator& first, const LT_PersonIdList::iterator& last, const std::string& scheduleLog);
+    void processPersonsForLT_Population(ChunkScheduler::Worker& worker, ActivityScheduleWriter* scheduleWriter);
 
     /**
      * Distributes persons to different threads and starts the threads which process the persons for calibration
@@ -198,41 +212,33 @@ private:
 
     /**
      * Threaded function loop for calibration.
-     * Loops through all elements in personList within the specified range and
-     * invokes the Preday system of models for each of them.
+     * Loops through the persons of the chunks of personList claimed by the
+     * worker and invokes the Preday system of models for each of them.
+     * Statistics are collected into the element of simulatedStatsVector of the
+     * worker's thread.
      *
-     * @param first personList iterator corresponding to the first person to be
-     *              processed
-     * @param last personList iterator corresponding to the person after the
-     *              last person to be processed
-     * @param simStats the object to collect statistics into
+     * @param worker scheduler worker of the thread
      */
-    void processPersonsForCalibration(const PersonList::iterator& first, const PersonList::iterator& last, size_t threadNum);
+    void processPersonsForCalibration(ChunkScheduler::Worker& worker);
 
     /**
      * Threaded logsum computation for LT population
-     * Loops through all elements in personIdList within the specified range and
-     * invokes logsum computations for each of them.
+     * Loops through the persons of the chunks of ltPersonIdList claimed by the
+     * worker and invokes logsum computations for each of them.
      *
-     * @param first personIdList iterator corresponding to the first person to be
-     *              processed
-     * @param last personIdList iterator corresponding to the person after the
-     *              last person to be processed
+     * @param worker scheduler worker of the thread
      */
-    void computeLogsumsForLT_Population(const LT_PersonIdList::iterator& firstPersonIdIt, const LT_PersonIdList::iterator& oneAfterLastPersonIdIt);
+    void computeLogsumsForLT_Population(ChunkScheduler::Worker& worker);
 
     /**
      * Threaded logsum computation for calibration
-     * Loops through all elements in personList within the specified range and
-     * invokes logsum computations for each of them.
+     * Loops through the persons of the chunks of personList claimed by the
+     * worker and invokes logsum computations for each of them.
      * This function does not update new logsums in DB. Updates only in memory.
      *
-     * @param first personList iterator corresponding to the first person to be
-     *              processed
-     * @param last personList iterator corresponding to the person after the
-     *              last person to be processed
+     * @param worker scheduler worker of the thread
      */
-    void computeLogsumsForCalibration(const PersonList::iterator& firstPersonIt, const PersonList::iterator& oneAfterLastPersonIt, size_t threadNum);
+    void computeLogsumsForCalibration(ChunkScheduler::Worker& worker);
 
     /**
      * loads csv containing calibration variables for preday
@@ -323,6 +329,12 @@ private:
     /** for each origin, has a list of unavailable destinations */
     std::vector<OD_Pair> unavailableODs;
 
+    /** time dependent travel times of all ODs; shared read-only by all preday threads */
+    TimeDependentTT_Matrix ttMatrix;
+
+    /** compiled tour mode/destination models; shared by all preday threads */
+    TourModeDestinationLogsumModelMap tmdLogsumModels;
+
     /**
      * list of values computed for objective function
      * objectiveFunctionValue[i] is the objective function value for iteration i
@@ -345,6 +357,11 @@ private:
      */
     std::ostream* logFile;
 
+    /**
+     * whether the activity schedules of the last preday simulation run were copied straight into the database
+     */
+    bool activityScheduleCopied;
+
     /**
      * stream for logging calibration results
      */
@@ -0,0 +1,85 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "PredayPopulationLoader.hpp"
+
+#include <algorithm>
+#include <boost/bind.hpp>
+
+using namespace sim_mob;
+using namespace sim_mob::medium;
+
+namespace
+{
+bool isIncomplete(const PersonParams& person)
+{
+    return person.getPersonId().empty();
+}
+}
+
+PredayPopulationLoader::PredayPopulationLoader(const PersonIdList& personIds, ChunkScheduler::Worker& worker,
+        unsigned int maxPrefetchedBatches, const FetchFunction& fetch) :
+        personIds(personIds), worker(worker), fetch(fetch), loadedBatches(maxPrefetchedBatches)
+{
+}
+
+PredayPopulationLoader::~PredayPopulationLoader()
+{
+    // closing the queue makes the loader thread stop at its next batch if the consumer stopped early
+    loadedBatches.close();
+    if (loaderThread.joinable())
+    {
+        loaderThread.join();
+    }
+}
+
+void PredayPopulationLoader::start()
+{
+    loaderThread = boost::thread(boost::bind(&PredayPopulationLoader::load, this));
+}
+
+bool PredayPopulationLoader::nextBatch(std::vector<PersonParams>& batch)
+{
+    batch.clear();
+    if (loadedBatches.pop(batch))
+    {
+        return true;
+    }
+    if (loadError)
+    {
+        std::rethrow_exception(loadError);
+    }
+    return false;
+}
+
+void PredayPopulationLoader::load()
+{
+    try
+    {
+        PersonIdList ids;
+        std::size_t first, last;
+        while (worker.claim(first, last))
+        {
+            ids.assign(personIds.begin() + first, personIds.begin() + last);
+
+            std::vector<PersonParams> persons;
+            persons.reserve(ids.size());
+            fetch(ids, persons);
+            persons.erase(std::remove_if(persons.begin(), persons.end(), isIncomplete), persons.end());
+            if (persons.empty())
+            {
+                continue;
+            }
+            if (!loadedBatches.push(persons))
+            {
+                break; // the consumer is gone
+            }
+        }
+    }
+    catch (...)
+    {
+        loadError = std::current_exception();
+    }
+    loadedBatches.close();
+}
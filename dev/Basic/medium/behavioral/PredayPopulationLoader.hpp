@@ -0,0 +1,87 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <exception>
+#include <vector>
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+#include <boost/utility.hpp>
+#include "behavioral/params/PersonParams.hpp"
+#include "util/BoundedQueue.hpp"
+#include "util/ChunkScheduler.hpp"
+
+namespace sim_mob
+{
+namespace medium
+{
+
+/**
+ * Loads persons of the LT population on a separate thread, in batches, so that the database queries overlap with the
+ * preday computations of the thread consuming the persons.
+ *
+ * Each batch is a chunk of the person id list claimed from the ChunkScheduler worker of the consuming thread, so that
+ * the consuming threads of a run share the population dynamically. The loader thread fetches the persons of each chunk
+ * with the given fetch function and keeps at most maxPrefetchedBatches loaded batches ahead of the consumer. The fetch function is only called from the loader
+ * thread, hence the database connections it uses must not be used by the consumer while the loader is alive.
+ */
+class PredayPopulationLoader : private boost::noncopyable
+{
+public:
+    typedef std::vector<long> PersonIdList;
+
+    /**
+     * function loading the persons of a list of ids; persons which are not found may be left out of the output
+     */
+    typedef boost::function<void (const PersonIdList& ids, std::vector<PersonParams>& persons)> FetchFunction;
+
+    /**
+     * @param personIds ids of the whole population, indexed by the chunks claimed from worker
+     * @param worker worker of the consuming thread, from which the chunks of person ids are claimed
+     * @param maxPrefetchedBatches maximum number of loaded batches waiting to be consumed
+     * @param fetch function loading a batch of persons
+     */
+    PredayPopulationLoader(const PersonIdList& personIds, ChunkScheduler::Worker& worker, unsigned int maxPrefetchedBatches,
+            const FetchFunction& fetch);
+
+    /**
+     * Stops the loader thread and waits for it to finish
+     */
+    ~PredayPopulationLoader();
+
+    /**
+     * Starts the loader thread
+     */
+    void start();
+
+    /**
+     * Gets the next batch of loaded persons, waiting for it if it is not loaded yet. Persons with an empty id
+     * (incomplete in the database) are not returned. If loading failed, the exception thrown by the loader thread is
+     * rethrown here.
+     *
+     * @param batch output batch of persons
+     * @return true if a batch was returned; false if all persons have been returned
+     */
+    bool nextBatch(std::vector<PersonParams>& batch);
+
+private:
+    /**
+     * Body of the loader thread
+     */
+    void load();
+
+    const PersonIdList& personIds;
+    ChunkScheduler::Worker& worker;
+    FetchFunction fetch;
+
+    BoundedQueue<std::vector<PersonParams> > loadedBatches;
+    boost::thread loaderThread;
+
+    /// exception thrown by the loader thread; read by the consumer once the queue is closed
+    std::exception_ptr loadError;
+};
+
+}
+}
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <boost/algorithm/string.hpp>
+#include <boost/chrono.hpp>
 #include <boost/lexical_cast.hpp>
 #include <cmath>
 #include <cstdlib>
@@ -146,17 +147,56 @@ namespace {
 		id << pid << "-" << tourNum << "-" << seqNum << suffix;
 		return id.str();
 	}
+
+	/**
+	 * copies the zone level variables of the tour mode/destination models into dense arrays
+	 *
+	 * @param tmdParams tour mode/destination parameters of the person
+	 * @param numZones number of zones
+	 * @param numModes number of modes
+	 * @param inputs output arrays
+	 */
+	void loadTourModeDestinationInputs(TourModeDestinationParams& tmdParams, int numZones, int numModes, TourModeDestinationInputs& inputs) {
+		inputs.resize(numZones, numModes);
+		inputs.costIncrease = tmdParams.getCostIncrease();
+		for (int zoneId = 1; zoneId <= numZones; zoneId++) {
+			const int z = zoneId - 1;
+			inputs.costPublicFirst[z] = tmdParams.getCostPublicFirst(zoneId);
+			inputs.costPublicSecond[z] = tmdParams.getCostPublicSecond(zoneId);
+			inputs.costCarERP_First[z] = tmdParams.getCostCarERPFirst(zoneId);
+			inputs.costCarERP_Second[z] = tmdParams.getCostCarERPSecond(zoneId);
+			inputs.costCarOP_First[z] = tmdParams.getCostCarOPFirst(zoneId);
+			inputs.costCarOP_Second[z] = tmdParams.getCostCarOPSecond(zoneId);
+			inputs.costCarParking[z] = tmdParams.getCostCarParking(zoneId);
+			inputs.walkDistanceFirst[z] = tmdParams.getWalkDistance1(zoneId);
+			inputs.walkDistanceSecond[z] = tmdParams.getWalkDistance2(zoneId);
+			inputs.ttPublicIvtFirst[z] = tmdParams.getTT_PublicIvtFirst(zoneId);
+			inputs.ttPublicIvtSecond[z] = tmdParams.getTT_PublicIvtSecond(zoneId);
+			inputs.ttPublicOutFirst[z] = tmdParams.getTT_PublicOutFirst(zoneId);
+			inputs.ttPublicOutSecond[z] = tmdParams.getTT_PublicOutSecond(zoneId);
+			inputs.ttCarIvtFirst[z] = tmdParams.getTT_CarIvtFirst(zoneId);
+			inputs.ttCarIvtSecond[z] = tmdParams.getTT_CarIvtSecond(zoneId);
+			inputs.centralDummy[z] = tmdParams.getCentralDummy(zoneId);
+			inputs.shop[z] = tmdParams.getShop(zoneId);
+			inputs.area[z] = tmdParams.getArea(zoneId);
+			inputs.population[z] = tmdParams.getPopulation(zoneId);
+		}
+		for (int choiceId = 1; choiceId <= numModes * numZones; choiceId++) {
+			inputs.availability[choiceId - 1] = tmdParams.isAvailable_TMD(choiceId);
+		}
+		inputs.prepare();
+	}
 } // anon namespace
 
 PredaySystem::PredaySystem(PersonParams& personParams,
         const ZoneMap& zoneMap, const boost::unordered_map<int,int>& zoneIdLookup,
         const CostMap& amCostMap, const CostMap& pmCostMap, const CostMap& opCostMap,
-        TimeDependentTT_SqlDao& tcostDao,
-        const std::vector<OD_Pair>& unavailableODs, const std::unordered_map<StopType, ActivityTypeConfig> &activityTypeConfig,
+        TimeDependentTT_SqlDao& tcostDao, const TimeDependentTT_Matrix& ttMatrix,
+        const TourModeDestinationLogsumModelMap& tmdLogsumModels, const std::vector<OD_Pair>& unavailableODs, const std::unordered_map<StopType, ActivityTypeConfig> &activityTypeConfig,
         const int numModes)
 : personParams(personParams), zoneMap(zoneMap), zoneIdLookup(zoneIdLookup),
   amCostMap(amCostMap), pmCostMap(pmCostMap), opCostMap(opCostMap),
-  tcostDao(tcostDao), unavailableODs(unavailableODs),
+  tcostDao(tcostDao), ttMatrix(ttMatrix), tmdLogsumModels(tmdLogsumModels), unavailableODs(unavailableODs),
   firstAvailableTimeIndex(FIRST_INDEX), logStream(std::stringstream::out),
   activityTypeConfigMap(activityTypeConfig), numModes(numModes)
 {}
@@ -523,7 +563,7 @@ TimeWindowAvailability PredaySystem::predictTourTimeOfDay(Tour& tour)
         case PT_TRAVEL_MODE:
         case PRIVATE_BUS_MODE:
 		{
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PUBLIC, origin, destination, todBasedTT);
+			fetchTimeDependentTT(TravelTimeMode::TT_PUBLIC, origin, destination, todBasedTT);
 			break;
 		}
         case PVT_CAR_MODE: // Fall through
@@ -531,7 +571,7 @@ TimeWindowAvailability PredaySystem::predictTourTimeOfDay(Tour& tour)
         case PVT_BIKE_MODE:
         case TAXI_MODE:
 		{
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PRIVATE, origin, destination, todBasedTT);
+			fetchTimeDependentTT(TravelTimeMode::TT_PRIVATE, origin, destination, todBasedTT);
 			break;
 		}
         case WALK_MODE:
@@ -1056,7 +1096,7 @@ bool PredaySystem::predictStopTimeOfDay(Stop* stop, int destination, bool isBefo
         case PT_TRAVEL_MODE:
         case PRIVATE_BUS_MODE:
 		{
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PUBLIC, origin, destination, todBasedTT);
+			fetchTimeDependentTT(TravelTimeMode::TT_PUBLIC, origin, destination, todBasedTT);
 			break;
 		}
         case PVT_CAR_MODE:
@@ -1064,7 +1104,7 @@ bool PredaySystem::predictStopTimeOfDay(Stop* stop, int destination, bool isBefo
         case PVT_BIKE_MODE:
         case TAXI_MODE:
 		{
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PRIVATE, origin, destination, todBasedTT);
+			fetchTimeDependentTT(TravelTimeMode::TT_PRIVATE, origin, destination, todBasedTT);
 			break;
 		}
         case WALK_MODE:
@@ -1304,6 +1344,15 @@ bool PredaySystem::predictStopTimeOfDay(Stop* stop, int destination, bool isBefo
 	return true;
 }
 
+bool PredaySystem::fetchTimeDependentTT(TravelTimeMode ttMode, int origin, int destination, TimeDependentTT_Params& outObj)
+{
+	if (ttMatrix.isLoaded())
+	{
+		return ttMatrix.getTT_ByOD(ttMode, origin, destination, outObj);
+	}
+	return tcostDao.getTT_ByOD(ttMode, origin, destination, outObj);
+}
+
 double PredaySystem::fetchTravelTime(int origin, int destination, int mode,  bool arrivalBased, double timeIdx)
 {
 	double travelTime = 0.0;
@@ -1316,7 +1365,7 @@ double PredaySystem::fetchTravelTime(int origin, int destination, int mode,  boo
         case PRIVATE_BUS_MODE:
 		{
 			TimeDependentTT_Params todBasedTT;
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PUBLIC, origin, destination, todBasedTT);
+			fetchTimeDependentTT(TravelTimeMode::TT_PUBLIC, origin, destination, todBasedTT);
 			if(arrivalBased)
 			{
 				travelTime = todBasedTT.getArrivalBasedTT_at(timeIdx-1);
@@ -1333,7 +1382,7 @@ double PredaySystem::fetchTravelTime(int origin, int destination, int mode,  boo
         case TAXI_MODE:
 		{
 			TimeDependentTT_Params todBasedTT;
-			tcostDao.getTT_ByOD(TravelTimeMode::TT_PRIVATE, origin, destination, todBasedTT);
+			fetchTimeDependentTT(TravelTimeMode::TT_PRIVATE, origin, destination, todBasedTT);
 			if(arrivalBased)
 			{
 				travelTime = todBasedTT.getArrivalBasedTT_at(timeIdx-1);
@@ -1704,7 +1753,7 @@ void sim_mob::medium::PredaySystem::computeLogsums()
 	TourModeDestinationParams tmdParams(zoneMap, amCostMap, pmCostMap, personParams, NULL_STOP, powertrain, numModes, unavailableODs);
 	tmdParams.setCbdOrgZone(zoneMap.at(zoneIdLookup.at(personParams.getHomeLocation()))->getCbdDummy());
     PredayLuaProvider::getPredayModel().initializeLogsums(personParams, activityTypeConfigMap);
-    PredayLuaProvider::getPredayModel().computeTourModeDestinationLogsum(personParams, activityTypeConfigMap, tmdParams, zoneMap.size());
+    computeTourModeDestinationLogsums(tmdParams);
 
 	if(personParams.hasFixedWorkPlace())
 	{
@@ -1734,6 +1783,64 @@ void sim_mob::medium::PredaySystem::computeLogsums()
 		<< ", dpb: " << personParams.getDpbLogsum() <<std::endl; //jo
 }
 
+void sim_mob::medium::PredaySystem::computeTourModeDestinationLogsums(TourModeDestinationParams& tmdParams)
+{
+	const PredayLuaModel& luaModel = PredayLuaProvider::getPredayModel();
+	const int numZones = zoneMap.size();
+	if (tmdLogsumModels.empty())
+	{
+		luaModel.computeTourModeDestinationLogsum(personParams, activityTypeConfigMap, tmdParams, numZones);
+		return;
+	}
+
+	TourModeDestinationInputs inputs;
+	bool inputsLoaded = false;
+	for (const auto& activity : activityTypeConfigMap)
+	{
+		const ActivityTypeConfig& actConfig = activity.second;
+		if (actConfig.type == EDUCATION_ACTIVITY_TYPE || actConfig.tourModeDestModel.empty())
+		{
+			continue;
+		}
+
+		double logsum = 0;
+		bool computed = false;
+		TourModeDestinationLogsumModelMap::const_iterator modelIt = tmdLogsumModels.find(actConfig.tourModeDestModel);
+		if (modelIt != tmdLogsumModels.end() && modelIt->second->isEnabled())
+		{
+			const TourModeDestinationLogsumModel& model = *modelIt->second;
+			if (!inputsLoaded)
+			{
+				loadTourModeDestinationInputs(tmdParams, numZones, numModes, inputs);
+				inputsLoaded = true;
+			}
+
+			boost::chrono::high_resolution_clock::time_point start = boost::chrono::high_resolution_clock::now();
+			computed = model.computeLogsum(personParams.getIncomeId(), personParams.getIsFemale(),
+					personParams.getVehicleOwnershipCategory(), inputs, logsum);
+			if (computed && model.claimValidationSample())
+			{
+				boost::chrono::high_resolution_clock::time_point end = boost::chrono::high_resolution_clock::now();
+				long long compiledNanos = boost::chrono::duration_cast<boost::chrono::nanoseconds>(end - start).count();
+				start = end;
+				double referenceLogsum = luaModel.computeTourModeDestinationLogsum(actConfig.tourModeDestModel, personParams, tmdParams, numZones);
+				long long referenceNanos = boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+						boost::chrono::high_resolution_clock::now() - start).count();
+				if (!model.validate(logsum, referenceLogsum, compiledNanos, referenceNanos))
+				{
+					logsum = referenceLogsum;
+				}
+			}
+		}
+
+		if (!computed)
+		{
+			logsum = luaModel.computeTourModeDestinationLogsum(actConfig.tourModeDestModel, personParams, tmdParams, numZones);
+		}
+		personParams.setActivityLogsum(activity.first, logsum);
+	}
+}
+
 void sim_mob::medium::PredaySystem::computeLogsumsForLT(std::stringstream& outStream)
 {
 	computeLogsums();
@@ -11,6 +11,7 @@
 #include <sstream>
 #include "behavioral/lua/PredayLuaProvider.hpp"
 #include "behavioral/params/PersonParams.hpp"
+#include "behavioral/TourModeDestinationLogsumModel.hpp"
 #include "CalibrationStatistics.hpp"
 #include "PredayClasses.hpp"
 #include "database/predaydao/PopulationSqlDao.hpp"
@@ -152,6 +153,24 @@ private:
 	 */
 	double fetchTravelTime(int origin, int destination, int mode, bool isArrivalBased, double timeIdx);
 
+	/**
+	 * fetches time dependent travel times of an OD from the travel time matrix if it is loaded;
+	 * from the time dependent travel time table otherwise
+	 * @param ttMode mode type - (public transit / private)
+	 * @param origin the origin zone code
+	 * @param destination the destination zone code
+	 * @param outObj output object to fill
+	 * @return true if travel times were found for the OD; false otherwise
+	 */
+	bool fetchTimeDependentTT(TravelTimeMode ttMode, int origin, int destination, TimeDependentTT_Params& outObj);
+
+	/**
+	 * computes the tour mode/destination logsums of all activity types; with the compiled model of the activity type
+	 * if there is one, with the lua script otherwise
+	 * @param tmdParams tour mode/destination parameters of the person
+	 */
+	void computeTourModeDestinationLogsums(TourModeDestinationParams& tmdParams);
+
 	/**
 	 * Calculates the arrival time for stops in the second half tour.
 	 * this function sets the departure time for the currentStop
@@ -280,6 +299,16 @@ private:
 	 */
 	TimeDependentTT_SqlDao& tcostDao;
 
+	/**
+	 * In-memory time dependent travel times; used instead of tcostDao when loaded
+	 */
+	const TimeDependentTT_Matrix& ttMatrix;
+
+	/**
+	 * Compiled tour mode/destination models; the lua scripts are used for the models not in this map
+	 */
+	const TourModeDestinationLogsumModelMap& tmdLogsumModels;
+
 	/**
 	 * used for logging messages
 	 */
@@ -296,7 +325,8 @@ private:
 
 public:
 	PredaySystem(PersonParams& personParams, const ZoneMap& zoneMap, const boost::unordered_map<int, int>& zoneIdLookup, const CostMap& amCostMap,
-            const CostMap& pmCostMap, const CostMap& opCostMap, TimeDependentTT_SqlDao& tcosDao, const std::vector<OD_Pair>& unavailableODs,
+            const CostMap& pmCostMap, const CostMap& opCostMap, TimeDependentTT_SqlDao& tcosDao, const TimeDependentTT_Matrix& ttMatrix,
+            const TourModeDestinationLogsumModelMap& tmdLogsumModels, const std::vector<OD_Pair>& unavailableODs,
             const std::unordered_map<StopType, ActivityTypeConfig>& activityTypeConfig, const int numModes);
 
 	virtual ~PredaySystem();
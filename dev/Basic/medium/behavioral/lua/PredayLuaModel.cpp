@@ -399,29 +399,23 @@ void sim_mob::medium::PredayLuaModel::computeTourModeDestinationLogsum(PersonPar
                 continue;
         }
 
-        if (actConfig.type == WORK_ACTIVITY_TYPE && !personParams.hasFixedWorkPlace())
+        if (!actConfig.tourModeDestModel.empty())
         {
-            if (!actConfig.tourModeDestModel.empty())
-            {
-                std::string luaFunc = "compute_logsum_" + actConfig.tourModeDestModel;
-                LuaRef computeLogsumTMDW = getGlobal(state.get(), luaFunc.c_str());
-                LuaRef workLogSum = computeLogsumTMDW(&personParams, &tourModeDestinationParams, zoneSize);
-                personParams.setActivityLogsum(activity.first, workLogSum.cast<double>());
-            }
-        }
-        else
-        {
-            if (!actConfig.tourModeDestModel.empty())
-            {
-                 std::string luaFunc = "compute_logsum_" + actConfig.tourModeDestModel;
-                LuaRef computeLogsumTMD = getGlobal(state.get(), luaFunc.c_str());
-                LuaRef logsum = computeLogsumTMD(&personParams, &tourModeDestinationParams, zoneSize);
-                personParams.setActivityLogsum(activity.first, logsum.cast<double>());
-            }
+            double logsum = computeTourModeDestinationLogsum(actConfig.tourModeDestModel, personParams, tourModeDestinationParams, zoneSize);
+            personParams.setActivityLogsum(activity.first, logsum);
         }
     }
 }
 
+double sim_mob::medium::PredayLuaModel::computeTourModeDestinationLogsum(const std::string& tourModeDestModel, PersonParams& personParams,
+                                                                         TourModeDestinationParams& tourModeDestinationParams, int zoneSize) const
+{
+    std::string luaFunc = "compute_logsum_" + tourModeDestModel;
+    LuaRef computeLogsumTMD = getGlobal(state.get(), luaFunc.c_str());
+    LuaRef logsum = computeLogsumTMD(&personParams, &tourModeDestinationParams, zoneSize);
+    return logsum.cast<double>();
+}
+
 int sim_mob::medium::PredayLuaModel::predictTourModeDestination(PersonParams& personParams, const std::unordered_map<int, ActivityTypeConfig> &activityTypes,
                                                                 TourModeDestinationParams& tourModeDestinationParams) const
 {
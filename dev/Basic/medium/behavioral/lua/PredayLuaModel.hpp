@@ -90,6 +90,17 @@ public:
     void computeTourModeDestinationLogsum(PersonParams& personParams, const std::unordered_map<int, ActivityTypeConfig> &activityTypes,
                                           TourModeDestinationParams& tourModeDestinationParams, int zoneSize) const;
 
+    /**
+     * Computes the log sum of one tour mode-destination model
+     *
+     * @param tourModeDestModel name of the tour mode-destination model
+     * @param personParams object containing person and household related variables
+     * @param tourModeDestinationParams parameters specific to tour mode-destination models
+     * @return the log sum
+     */
+    double computeTourModeDestinationLogsum(const std::string& tourModeDestModel, PersonParams& personParams,
+                                            TourModeDestinationParams& tourModeDestinationParams, int zoneSize) const;
+
     /**
      * Computes log sums for work tour type for persons with fixed work location
      *
@@ -340,6 +340,12 @@ void ExpandMidTermConfigFile::printSettings()
     case WorkGroup::ASSIGN_SMALLEST:
 	std::cout << "smallest" << std::endl;
 	break;
+    case WorkGroup::ASSIGN_WORKSTEALING:
+	std::cout << "workstealing" << std::endl;
+	break;
+    case WorkGroup::ASSIGN_TIMEBASED:
+	std::cout << "timebased (rebalanced every " << cfg.workGroupRebalanceInterval() << "s)" << std::endl;
+	break;
     default:
 	std::cout << "<unknown>" << std::endl;
 	break;
@@ -352,6 +358,7 @@ void ExpandMidTermConfigFile::printSettings()
     std::cout << "  Total Warmup: " << cfg.totalWarmupTicks << " " << "ticks" << "\n";
     std::cout << "  Person Granularity: " << mtCfg.granPersonTicks << " " << "ticks" << "\n";
     std::cout << "  Mutex strategy: " << (cfg.mutexStategy() == MtxStrat_Locked ? "Locked" : cfg.mutexStategy() == MtxStrat_Buffered ? "Buffered" : "Unknown") << "\n";
+    std::cout << "  Message distribution: " << (cfg.simulation.batchedMessageDistribution ? "batched" : "centralized") << "\n";
 
 	//Multi-threading
 	std::cout << "\nNumber of threads:\n"
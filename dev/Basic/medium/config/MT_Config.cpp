@@ -23,9 +23,11 @@ PredayCalibrationParams::PredayCalibrationParams() :
 
 MT_Config::MT_Config() :
        regionRestrictionEnabled(false), midTermRunMode(MT_Config::MT_NONE), pedestrianWalkSpeed(0), numPredayThreads(0),
-			configSealed(false), fileOutputEnabled(false), consoleOutput(false), predayRunMode(MT_Config::PREDAY_NONE),
+			configSealed(false), fileOutputEnabled(false), consoleOutput(false), travelTimeMatrixEnabled(false),
+			compiledLogsumsEnabled(false), compiledLogsumValidationSamples(0), compiledLogsumTolerance(0),
+			predayChunkSize(100), populationBatchSize(1000), populationPrefetchBatches(2), predayRunMode(MT_Config::PREDAY_NONE),
 			calibrationMethodology(MT_Config::WSPSA), logsumComputationFrequency(0), supplyUpdateInterval(0),
-			activityScheduleLoadInterval(0), busCapacity(0), populationSource(db::POSTGRES), granPersonTicks(0),threadsNumInPersonLoader(0),
+			activityScheduleLoadInterval(0), busCapacity(0), populationSource(db::POSTGRES), granPersonTicks(0),threadsNumInPersonLoader(0), personLoaderPrefetchEnabled(true),
 			energyModelEnabled(false)
 {
 }
@@ -186,6 +188,123 @@ void MT_Config::setConsoleOutput(bool consoleOutput)
 	}
 }
 
+bool MT_Config::isTravelTimeMatrixEnabled() const
+{
+	return travelTimeMatrixEnabled;
+}
+
+void MT_Config::setTravelTimeMatrixEnabled(bool travelTimeMatrixEnabled)
+{
+	if(!configSealed)
+	{
+		this->travelTimeMatrixEnabled = travelTimeMatrixEnabled;
+	}
+}
+
+const std::string& MT_Config::getTravelTimeMatrixCacheFile() const
+{
+	return travelTimeMatrixCacheFile;
+}
+
+void MT_Config::setTravelTimeMatrixCacheFile(const std::string& travelTimeMatrixCacheFile)
+{
+	if(!configSealed)
+	{
+		this->travelTimeMatrixCacheFile = travelTimeMatrixCacheFile;
+	}
+}
+
+const std::string& MT_Config::getTravelTimeMatrixVersion() const
+{
+	return travelTimeMatrixVersion;
+}
+
+void MT_Config::setTravelTimeMatrixVersion(const std::string& travelTimeMatrixVersion)
+{
+	if(!configSealed)
+	{
+		this->travelTimeMatrixVersion = travelTimeMatrixVersion;
+	}
+}
+
+bool MT_Config::isCompiledLogsumsEnabled() const
+{
+	return compiledLogsumsEnabled;
+}
+
+void MT_Config::setCompiledLogsumsEnabled(bool compiledLogsumsEnabled)
+{
+	if(!configSealed)
+	{
+		this->compiledLogsumsEnabled = compiledLogsumsEnabled;
+	}
+}
+
+unsigned int MT_Config::getCompiledLogsumValidationSamples() const
+{
+	return compiledLogsumValidationSamples;
+}
+
+void MT_Config::setCompiledLogsumValidationSamples(unsigned int compiledLogsumValidationSamples)
+{
+	if(!configSealed)
+	{
+		this->compiledLogsumValidationSamples = compiledLogsumValidationSamples;
+	}
+}
+
+double MT_Config::getCompiledLogsumTolerance() const
+{
+	return compiledLogsumTolerance;
+}
+
+void MT_Config::setCompiledLogsumTolerance(double compiledLogsumTolerance)
+{
+	if(!configSealed)
+	{
+		this->compiledLogsumTolerance = compiledLogsumTolerance;
+	}
+}
+
+unsigned int MT_Config::getPredayChunkSize() const
+{
+	return predayChunkSize;
+}
+
+void MT_Config::setPredayChunkSize(unsigned int predayChunkSize)
+{
+	if(!configSealed)
+	{
+		this->predayChunkSize = predayChunkSize;
+	}
+}
+
+unsigned int MT_Config::getPopulationBatchSize() const
+{
+	return populationBatchSize;
+}
+
+void MT_Config::setPopulationBatchSize(unsigned int populationBatchSize)
+{
+	if(!configSealed)
+	{
+		this->populationBatchSize = populationBatchSize;
+	}
+}
+
+unsigned int MT_Config::getPopulationPrefetchBatches() const
+{
+	return populationPrefetchBatches;
+}
+
+void MT_Config::setPopulationPrefetchBatches(unsigned int populationPrefetchBatches)
+{
+	if(!configSealed)
+	{
+		this->populationPrefetchBatches = populationPrefetchBatches;
+	}
+}
+
 bool MT_Config::runningPredaySimulation() const
 {
 	return (predayRunMode == MT_Config::PREDAY_SIMULATION);
@@ -313,6 +432,19 @@ void MT_Config::setThreadsNumInPersonLoader(unsigned int number)
 	}
 }
 
+bool MT_Config::isPersonLoaderPrefetchEnabled() const
+{
+	return personLoaderPrefetchEnabled;
+}
+
+void MT_Config::setPersonLoaderPrefetchEnabled(bool enabled)
+{
+	if(!configSealed)
+	{
+		personLoaderPrefetchEnabled = enabled;
+	}
+}
+
 bool MT_Config::RunningMidSupply() const {
     return (midTermRunMode == MT_Config::MT_SUPPLY);
 }
@@ -299,12 +299,31 @@ struct TripChainOutputConfig
 
 };
 
+/**
+ * Represents the supply_stats_output section of the config file
+ */
+struct SupplyStatsOutputConfig
+{
+	SupplyStatsOutputConfig() : binary(false), segmentStatsFile("segment_stats.bin"), linkStatsFile("link_stats.bin"),
+			chunkRows(65536)
+	{}
+
+	/// whether the segment and link statistics are written to binary columnar files rather than to the text log
+	bool binary;
+	/// File name of the segment statistics (binary format only)
+	std::string segmentStatsFile;
+	/// File name of the link statistics (binary format only)
+	std::string linkStatsFile;
+	/// Number of rows buffered by a worker before they are handed over to be written (binary format only)
+	unsigned int chunkRows;
+};
+
 /**
  * Structure to store das table config information
  */
 struct DAS_Config
 {
-	DAS_Config() : schema(""), table(""), updateProc(""), fileName(""), vehicleTable("")
+	DAS_Config() : schema(""), table(""), updateProc(""), fileName(""), vehicleTable(""), streamToTable(true)
 	{}
 
 	std::string schema;
@@ -312,6 +331,8 @@ struct DAS_Config
 	std::string updateProc;
 	std::string fileName;
 	std::string vehicleTable; // Eytan Gross
+	/// whether activity schedules are copied straight into the table; if false (or if the copy fails) they go through fileName
+	bool streamToTable;
 };
 
 
@@ -459,6 +480,133 @@ public:
 	 */
 	void setConsoleOutput(bool consoleOutput);
 
+	/**
+	 * Checks whether preday reads time dependent travel times from an in-memory matrix
+	 *
+	 * @return true if enabled, else false
+	 */
+	bool isTravelTimeMatrixEnabled() const;
+
+	/**
+	 * Sets in-memory travel time matrix enabled/disabled status
+	 *
+	 * @param travelTimeMatrixEnabled status to be set
+	 */
+	void setTravelTimeMatrixEnabled(bool travelTimeMatrixEnabled);
+
+	/**
+	 * get name of binary cache file of the travel time matrix
+	 *
+	 * @return name of cache file; empty if the matrix is not to be cached
+	 */
+	const std::string& getTravelTimeMatrixCacheFile() const;
+
+	/**
+	 * Sets name of binary cache file of the travel time matrix
+	 *
+	 * @param travelTimeMatrixCacheFile name of cache file
+	 */
+	void setTravelTimeMatrixCacheFile(const std::string& travelTimeMatrixCacheFile);
+
+	/**
+	 * get version stamp of the travel time tables
+	 *
+	 * @return version stamp; a cache file built from another version is rebuilt
+	 */
+	const std::string& getTravelTimeMatrixVersion() const;
+
+	/**
+	 * Sets version stamp of the travel time tables
+	 *
+	 * @param travelTimeMatrixVersion version stamp, to be changed whenever the tables are rewritten
+	 */
+	void setTravelTimeMatrixVersion(const std::string& travelTimeMatrixVersion);
+
+	/**
+	 * Checks whether preday computes tour mode/destination logsums with the compiled models where available
+	 *
+	 * @return true if enabled, else false
+	 */
+	bool isCompiledLogsumsEnabled() const;
+
+	/**
+	 * Sets compiled logsums enabled/disabled status
+	 *
+	 * @param compiledLogsumsEnabled status to be set
+	 */
+	void setCompiledLogsumsEnabled(bool compiledLogsumsEnabled);
+
+	/**
+	 * get number of compiled logsums of each model to be validated against the lua scripts
+	 *
+	 * @return number of validation samples
+	 */
+	unsigned int getCompiledLogsumValidationSamples() const;
+
+	/**
+	 * Sets number of compiled logsums of each model to be validated against the lua scripts
+	 *
+	 * @param compiledLogsumValidationSamples number of validation samples
+	 */
+	void setCompiledLogsumValidationSamples(unsigned int compiledLogsumValidationSamples);
+
+	/**
+	 * get maximum difference allowed between compiled and lua logsums
+	 *
+	 * @return tolerance
+	 */
+	double getCompiledLogsumTolerance() const;
+
+	/**
+	 * Sets maximum difference allowed between compiled and lua logsums
+	 *
+	 * @param compiledLogsumTolerance tolerance
+	 */
+	void setCompiledLogsumTolerance(double compiledLogsumTolerance);
+
+	/**
+	 * get number of persons of the in-memory population (calibration) claimed at a time by a preday thread
+	 *
+	 * @return chunk size
+	 */
+	unsigned int getPredayChunkSize() const;
+
+	/**
+	 * Sets number of persons of the in-memory population (calibration) claimed at a time by a preday thread
+	 *
+	 * @param predayChunkSize chunk size
+	 */
+	void setPredayChunkSize(unsigned int predayChunkSize);
+
+	/**
+	 * get number of persons loaded from the population database in a single query; this is also the number of persons
+	 * of the LT population claimed at a time by a preday thread
+	 *
+	 * @return batch size
+	 */
+	unsigned int getPopulationBatchSize() const;
+
+	/**
+	 * Sets number of persons loaded from the population database in a single query
+	 *
+	 * @param populationBatchSize batch size
+	 */
+	void setPopulationBatchSize(unsigned int populationBatchSize);
+
+	/**
+	 * get maximum number of loaded batches of persons waiting to be processed by each preday thread
+	 *
+	 * @return number of batches
+	 */
+	unsigned int getPopulationPrefetchBatches() const;
+
+	/**
+	 * Sets maximum number of loaded batches of persons waiting to be processed by each preday thread
+	 *
+	 * @param populationPrefetchBatches number of batches
+	 */
+	void setPopulationPrefetchBatches(unsigned int populationPrefetchBatches);
+
 	/**
 	 * Checks whether preday simulation is running
 	 *
@@ -800,6 +948,18 @@ public:
 	 */
 	void setThreadsNumInPersonLoader(unsigned int number);
 
+	/**
+	 * whether the person loader fetches the demand rows of the next load interval in the background
+	 * @return true if prefetching is enabled; false otherwise
+	 */
+	bool isPersonLoaderPrefetchEnabled() const;
+
+	/**
+	 * enables or disables background fetching of the next load interval
+	 * @param enabled whether to prefetch
+	 */
+	void setPersonLoaderPrefetchEnabled(bool enabled);
+
 	/**
 	 * Enumerator for mid term run mode
 	 */
@@ -823,6 +983,9 @@ public:
 	/// Configuration for trip chain output
 	TripChainOutputConfig tripChainOutput;
 
+	/// Configuration for the output of the segment and link statistics
+	SupplyStatsOutputConfig supplyStatsOutput;
+
 	/// Day Activity Schedule config information
 	DAS_Config dasConfig;
 
@@ -862,6 +1025,33 @@ private:
 	/// flag to indicate whether console output is required
 	bool consoleOutput;
 
+	/// flag to indicate whether preday loads the time dependent travel times into memory
+	bool travelTimeMatrixEnabled;
+
+	/// binary cache file of the time dependent travel times
+	std::string travelTimeMatrixCacheFile;
+
+	/// version stamp of the travel time tables the cache file is built from
+	std::string travelTimeMatrixVersion;
+
+	/// flag to indicate whether preday computes tour mode/destination logsums with the compiled models
+	bool compiledLogsumsEnabled;
+
+	/// number of compiled logsums of each model validated against the lua scripts
+	unsigned int compiledLogsumValidationSamples;
+
+	/// maximum difference allowed between compiled and lua logsums
+	double compiledLogsumTolerance;
+
+	/// number of persons of the in-memory population claimed at a time by a preday thread
+	unsigned int predayChunkSize;
+
+	/// number of persons loaded from the population database in a single query
+	unsigned int populationBatchSize;
+
+	/// maximum number of loaded batches of persons waiting to be processed by each preday thread
+	unsigned int populationPrefetchBatches;
+
 	/// Container for service controller script
 	ModelScriptsMap ServiceControllerScriptsMap;
 
@@ -871,6 +1061,9 @@ private:
 	/** the threads number in person loader*/
 	unsigned int threadsNumInPersonLoader;
 
+	/** whether the person loader prefetches the next load interval*/
+	bool personLoaderPrefetchEnabled;
+
 	/// supply update interval in frames
 	unsigned supplyUpdateInterval;
 
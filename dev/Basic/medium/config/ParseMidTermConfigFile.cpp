@@ -96,6 +96,7 @@ void ParseMidTermConfigFile::processXmlFile(xercesc::XercesDOMParser& parser)
 		processRegionRestrictionNode(GetSingleElementByName(rootNode, "region_restriction"));
 		processPathSetFileName(GetSingleElementByName(rootNode, "pathset_config_file", true));
 		processTripChainOutputNode(GetSingleElementByName(rootNode, "trip_chain_output"));
+		processSupplyStatsOutputNode(GetSingleElementByName(rootNode, "supply_stats_output"));
 		processOnCallTaxiTrajectoryNode(GetSingleElementByName(rootNode, "onCallTaxiTrajectory"));
 		processOnHailTaxiTrajectoryNode(GetSingleElementByName(rootNode, "onHailTaxiTrajectory"));
         processEnergyModelNode(GetSingleElementByName(rootNode, "energy_model", true));
@@ -168,6 +169,7 @@ void ParseMidTermConfigFile::processPredayNode(xercesc::DOMElement* node)
 
 	childNode = GetSingleElementByName(node, "threads", true);
 	mtCfg.setNumPredayThreads(ParseUnsignedInt(GetNamedAttributeValue(childNode, "value", true), DEFAULT_NUM_THREADS_DEMAND));
+	mtCfg.setPredayChunkSize(ParseUnsignedInt(GetNamedAttributeValue(childNode, "chunk_size", false), 100));
 
 	if(mtCfg.runningPredaySimulation() || mtCfg.RunningMidFullLoop() || mtCfg.RunningMidPredayFull() )
 	{
@@ -178,6 +180,20 @@ void ParseMidTermConfigFile::processPredayNode(xercesc::DOMElement* node)
 	childNode = GetSingleElementByName(node, "console_output", true);
 	mtCfg.setConsoleOutput(ParseBoolean(GetNamedAttributeValue(childNode, "enabled", true)));
 
+	childNode = GetSingleElementByName(node, "travel_time_matrix");
+	mtCfg.setTravelTimeMatrixEnabled(ParseBoolean(GetNamedAttributeValue(childNode, "enabled", false), false));
+	mtCfg.setTravelTimeMatrixCacheFile(ParseString(GetNamedAttributeValue(childNode, "cache_file", false), ""));
+	mtCfg.setTravelTimeMatrixVersion(ParseString(GetNamedAttributeValue(childNode, "version", false), ""));
+
+	childNode = GetSingleElementByName(node, "compiled_logsums");
+	mtCfg.setCompiledLogsumsEnabled(ParseBoolean(GetNamedAttributeValue(childNode, "enabled", false), false));
+	mtCfg.setCompiledLogsumValidationSamples(ParseUnsignedInt(GetNamedAttributeValue(childNode, "validation_samples", false), 100));
+	mtCfg.setCompiledLogsumTolerance(ParseFloat(GetNamedAttributeValue(childNode, "tolerance", false), 1e-6f));
+
+	childNode = GetSingleElementByName(node, "population_loader");
+	mtCfg.setPopulationBatchSize(ParseUnsignedInt(GetNamedAttributeValue(childNode, "batch_size", false), 1000));
+	mtCfg.setPopulationPrefetchBatches(ParseUnsignedInt(GetNamedAttributeValue(childNode, "prefetch_batches", false), 2));
+
 	childNode = GetSingleElementByName(node, "logsum_table", true);
 	mtCfg.setLogsumTableName(ParseString(GetNamedAttributeValue(childNode, "name", true)));
 
@@ -189,6 +205,7 @@ void ParseMidTermConfigFile::processPredayNode(xercesc::DOMElement* node)
 	//jo {Apr12 for vehicle table
 	mtCfg.dasConfig.vehicleTable = ParseString(GetNamedAttributeValue(childNode, "vehicleTable", true));
 	//}jo
+	mtCfg.dasConfig.streamToTable = ParseBoolean(GetNamedAttributeValue(childNode, "stream", false), true);
 
 	ModelScriptsMap luaModelsMap = processModelScriptsNode(GetSingleElementByName(node, "model_scripts", true));
 	cfg.predayLuaScriptsMap = luaModelsMap;
@@ -444,6 +461,7 @@ void ParseMidTermConfigFile::processThreadsNumInPersonLoaderElement(xercesc::DOM
 
 	unsigned int num = ParseUnsignedInt(GetNamedAttributeValue(node, "value", true), 1);
 	mtCfg.setThreadsNumInPersonLoader(num);
+	mtCfg.setPersonLoaderPrefetchEnabled(ParseBoolean(GetNamedAttributeValue(node, "prefetch", false), true));
 }
 
 void ParseMidTermConfigFile::processBusCapactiyElement(xercesc::DOMElement* node)
@@ -855,6 +873,29 @@ void ParseMidTermConfigFile::processTripChainOutputNode(DOMElement *node)
 			mtCfg.tripChainOutput.tripActivitiesFile = ParseString(GetNamedAttributeValue(node, "trip_activities_file"), "trip_activities.csv");
 		}
 }
+
+void ParseMidTermConfigFile::processSupplyStatsOutputNode(DOMElement *node)
+{
+	if (!node)
+	{
+		return;
+	}
+
+	std::string format = ParseString(GetNamedAttributeValue(node, "format"), "text");
+	if (format == "binary")
+	{
+		mtCfg.supplyStatsOutput.binary = true;
+	}
+	else if (format != "text")
+	{
+		throw std::runtime_error("supply_stats_output: format must be text or binary");
+	}
+
+	SupplyStatsOutputConfig& outputCfg = mtCfg.supplyStatsOutput;
+	outputCfg.segmentStatsFile = ParseString(GetNamedAttributeValue(node, "segment_file"), outputCfg.segmentStatsFile);
+	outputCfg.linkStatsFile = ParseString(GetNamedAttributeValue(node, "link_file"), outputCfg.linkStatsFile);
+	outputCfg.chunkRows = ParseUnsignedInt(GetNamedAttributeValue(node, "chunk_rows"), outputCfg.chunkRows);
+}
 void ParseMidTermConfigFile::processTravelModesNode(DOMElement *node)
 {
     if (!node)
@@ -259,6 +259,12 @@ private:
   */
 	void processTripChainOutputNode(xercesc::DOMElement* node);
 
+	/**
+	 * Process the supply stats output node in simrun_MidTerm.xml
+	 * @param node is the node corresponding to the supply_stats_output element inside simrun_Midterm.xml file
+	 */
+	void processSupplyStatsOutputNode(xercesc::DOMElement* node);
+
     /**
      * Processes the travel modes element in config xml
      *
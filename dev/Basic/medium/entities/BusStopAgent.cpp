@@ -147,7 +147,7 @@ Entity::UpdateStatus BusStopAgent::frame_tick(timeslice now)
                             if (twinStopAgent)
                             {
                                 messaging::MessageBus::SendMessage(twinStopAgent, MSG_WAITING_PERSON_ARRIVAL,
-                                        messaging::MessageBus::MessagePtr(new ArrivalAtStopMessage(person)));
+                                        messaging::MessageBus::MakeMessage<ArrivalAtStopMessage>(person));
                             }
                         }
                         else
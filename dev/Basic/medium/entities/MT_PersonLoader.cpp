@@ -362,7 +362,8 @@ private:
 };
 
 MT_PersonLoader::MT_PersonLoader(std::set<sim_mob::Entity*>& activeAgents, StartTimePriorityQueue& pendinAgents)
-	: PeriodicPersonLoader(activeAgents, pendinAgents),isLoadPersonInfo(false)
+	: PeriodicPersonLoader(activeAgents, pendinAgents),isLoadPersonInfo(false),
+	  prefetchEnabled(MT_Config::getInstance().isPersonLoaderPrefetchEnabled()), queryStart(0.0), queryEnd(0.0)
 {
 	ConfigParams& cfg = ConfigManager::GetInstanceRW().FullConfig();
 	dataLoadInterval = SECONDS_IN_ONE_HOUR; //1 hour by default. TODO: must be configurable.
@@ -386,70 +387,75 @@ MT_PersonLoader::MT_PersonLoader(std::set<sim_mob::Entity*>& activeAgents, Start
 
 MT_PersonLoader::~MT_PersonLoader()
 {
+	// the rows of the last prefetched interval are never used
+	if (prefetchThread.joinable())
+	{
+		prefetchThread.join();
+	}
 }
 
-void MT_PersonLoader::makeSubTrip(const soci::row& r, Trip* parentTrip, unsigned short subTripNo)
+void MT_PersonLoader::makeSubTrip(const ScheduleRow& r, Trip* parentTrip, unsigned short subTripNo)
 {
 	const RoadNetwork* rn = RoadNetwork::getInstance();
 	SubTrip subTrip;
-	subTrip.setPersonID(r.get<string>(0));
+	subTrip.setPersonID(r.personId);
 	subTrip.itemType = TripChainItem::IT_TRIP;
 	subTrip.tripID = parentTrip->tripID + "-" + boost::lexical_cast<string>(subTripNo);
-	subTrip.origin = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.get<int>(10)));
+	subTrip.origin = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.prevStopNode));
 	subTrip.originType = TripChainItem::LT_NODE;
-	subTrip.destination = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.get<int>(5)));
+	subTrip.destination = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.stopNode));
 	subTrip.destinationType = TripChainItem::LT_NODE;
-	subTrip.travelMode = r.get<string>(6);
+	subTrip.travelMode = r.stopMode;
 	subTrip.startTime = parentTrip->startTime;
 	parentTrip->addSubTrip(subTrip);
 }
 
-Activity* MT_PersonLoader::makeActivity(const soci::row& r, unsigned int seqNo)
+Activity* MT_PersonLoader::makeActivity(const ScheduleRow& r, unsigned int seqNo)
 {
 	const RoadNetwork* rn = RoadNetwork::getInstance();
 	Activity* activity = new Activity();
-	activity->setPersonID(r.get<string>(0));
+	activity->setPersonID(r.personId);
 	activity->itemType = TripChainItem::IT_ACTIVITY;
 	activity->sequenceNumber = seqNo;
-	activity->purpose = TripChainItem::getItemPurpose(r.get<string>(4));
-	activity->isPrimary = r.get<int>(7);
+	activity->purpose = TripChainItem::getItemPurpose(r.stopType);
+	activity->isPrimary = r.isPrimaryStop;
 	activity->isFlexible = false;
 	activity->isMandatory = true;
-	activity->destination = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.get<int>(5)));
+	activity->destination = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.stopNode));
 	activity->destinationType = TripChainItem::LT_NODE;
-	activity->destinationZoneCode = r.get<int>(13);
-	setActivityStartEnd(activity, r.get<double>(8), r.get<double>(9));
+	activity->destinationZoneCode = r.stopZone;
+	setActivityStartEnd(activity, r.arrivalWindow, r.departureWindow);
 	return activity;
 }
 
-Trip* MT_PersonLoader::makeTrip(const soci::row& r, unsigned int seqNo)
+Trip* MT_PersonLoader::makeTrip(const ScheduleRow& r, unsigned int seqNo)
 {
 	const RoadNetwork* rn = RoadNetwork::getInstance();
 	Trip* trip = new Trip();
 	trip->sequenceNumber = seqNo;
-	trip->tripID = boost::lexical_cast<string>(r.get<int>(1) * 100 + r.get<int>(3)); //each row corresponds to 1 trip and 1 activity. The tour and stop number can be used to generate unique tripID
-	trip->setPersonID(r.get<string>(0));
+	trip->tripID = boost::lexical_cast<string>(r.tourNo * 100 + r.stopNo); //each row corresponds to 1 trip and 1 activity. The tour and stop number can be used to generate unique tripID
+	trip->setPersonID(r.personId);
 	trip->itemType = TripChainItem::IT_TRIP;
-	trip->purpose = TripChainItem::getItemPurpose(r.get<string>(4));
-	trip->origin = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.get<int>(10)));
+	trip->purpose = TripChainItem::getItemPurpose(r.stopType);
+	trip->origin = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.prevStopNode));
 	trip->originType = TripChainItem::LT_NODE;
-	trip->originZoneCode = r.get<int>(12);
-	trip->destination = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.get<int>(5)));
+	trip->originZoneCode = r.prevStopZone;
+	trip->destination = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.stopNode));
 	trip->destinationType = TripChainItem::LT_NODE;
-	trip->destinationZoneCode = r.get<int>(13);
-	trip->startTime = DailyTime(getRandomTimeInWindow(r.get<double>(11), false));
-	trip->travelMode = r.get<string>(6);
+	trip->destinationZoneCode = r.stopZone;
+	trip->startTime = DailyTime(getRandomTimeInWindow(r.prevStopDepartureWindow, false));
+	trip->travelMode = r.stopMode;
 
-	// SC: if energy model is enabled, pull drivetrain type from database
+	// SC: if energy model is enabled, the drivetrain type is pulled from database
 	// default to ICE if drivetrain type can't be pulled
 	trip->vehicleTypeDriven = "ICE";
 	if (MT_Config::getInstance().isEnergyModelEnabled())
 	{
-		try
+		if (!r.drivetrain.empty())
 		{
-			trip->vehicleTypeDriven = r.get<string>(14);
+			trip->vehicleTypeDriven = r.drivetrain;
 		}
-		catch (...)
+		else
 		{
 			Warn() << "Vehicle drivetrain type cannot be accessed from database. Defaulting to ICE." << std::endl;
 		}
@@ -468,22 +474,22 @@ Trip* MT_PersonLoader::makeTrip(const soci::row& r, unsigned int seqNo)
 	return trip;
 }
 
-Trip* MT_PersonLoader::makeFreightTrip(const soci::row& r)
+Trip* MT_PersonLoader::makeFreightTrip(const FreightRow& r)
 {
 	const RoadNetwork* rn = RoadNetwork::getInstance();
 	Trip* trip = new Trip();
 	trip->sequenceNumber = 1;
-	trip->tripID = r.get<string>(0);
-	trip->setPersonID(r.get<string>(0));
+	trip->tripID = r.tripId;
+	trip->setPersonID(r.tripId);
 	trip->itemType = TripChainItem::IT_TRIP;
-	trip->origin = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.get<unsigned int>(2)));
+	trip->origin = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.originNode));
 	trip->originType = TripChainItem::LT_NODE;
-	trip->originZoneCode = r.get<int>(1);
-	trip->destination = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.get<unsigned int>(4)));
+	trip->originZoneCode = r.originZone;
+	trip->destination = WayPoint(rn->getById(rn->getMapOfIdvsNodes(), r.destinationNode));
 	trip->destinationType = TripChainItem::LT_NODE;
-	trip->destinationZoneCode = r.get<int>(3);
-	trip->startTime = DailyTime(getRandomTimeInWindow(r.get<double>(5), false));
-	trip->travelMode = r.get<string>(6);
+	trip->destinationZoneCode = r.destinationZone;
+	trip->startTime = DailyTime(getRandomTimeInWindow(r.startWindow, false));
+	trip->travelMode = r.mode;
 	//just a sanity check
 	if(trip->origin == trip->destination)
 	{
@@ -492,7 +498,7 @@ Trip* MT_PersonLoader::makeFreightTrip(const soci::row& r)
 	}
 
 	SubTrip subtrip;
-	subtrip.setPersonID(r.get<string>(0));
+	subtrip.setPersonID(r.tripId);
 	subtrip.itemType = TripChainItem::IT_TRIP;
 	subtrip.tripID = trip->tripID + "-" + boost::lexical_cast<string>(1);
 	subtrip.origin = trip->origin;
@@ -591,29 +597,113 @@ void MT_PersonLoader::loadMRT_Demand()
 	Print() << "PersonLoader:: MRT loaded " << personsLoaded << endl;
 	Print() << "active_agents: " << activeAgents.size() << " | pending_agents: "<< pendingAgents.size() << endl;
 }
-void MT_PersonLoader::loadPersonDemand()
+
+void MT_PersonLoader::prepareQueries()
 {
-	if(storedProcName.empty())
+	if (demandQuery)
 	{
-		loadMRT_Demand();
 		return;
 	}
-    //Our SQL statement
-	stringstream query;
-    ConfigParams& cfg = ConfigManager::GetInstanceRW().FullConfig();
-	double end = nextLoadStart + DEFAULT_LOAD_INTERVAL;
-	query << "select * from " << storedProcName << "(" << nextLoadStart << "," << end << ")";
-	soci::session sql_(soci::postgresql, cfg.getDatabaseConnectionString(false));
+	ConfigParams& cfg = ConfigManager::GetInstanceRW().FullConfig();
+	sql_.open(soci::postgresql, cfg.getDatabaseConnectionString(false));
+
+	//the interval bounds are bound to queryStart and queryEnd, so the statements are prepared only once
+	const std::string intervalArgs = "(CAST(:start AS numeric), CAST(:end AS numeric))";
+	demandQuery.reset(new soci::statement((sql_.prepare << "select * from " << storedProcName << intervalArgs,
+			soci::use(queryStart), soci::use(queryEnd), soci::into(demandRow))));
+	if (!freightStoredProcName.empty())
+	{
+		freightQuery.reset(new soci::statement((sql_.prepare << "select * from " << freightStoredProcName << intervalArgs,
+				soci::use(queryStart), soci::use(queryEnd), soci::into(freightRow))));
+	}
+}
+
+void MT_PersonLoader::fetchInterval(double start, double end, DemandBatch& batch)
+{
+	prepareQueries();
+	queryStart = start;
+	queryEnd = end;
+	const bool fetchDrivetrain = MT_Config::getInstance().isEnergyModelEnabled();
+
+	demandQuery->execute();
+	while (demandQuery->fetch())
+	{
+		const soci::row &r = demandRow;
+		ScheduleRow row;
+		row.personId = r.get<string>(0);
+		row.tourNo = r.get<int>(1);
+		row.stopNo = r.get<int>(3);
+		row.stopType = r.get<string>(4);
+		row.stopNode = r.get<int>(5);
+		row.stopMode = r.get<string>(6);
+		row.isPrimaryStop = r.get<int>(7);
+		row.arrivalWindow = r.get<double>(8);
+		row.departureWindow = r.get<double>(9);
+		row.prevStopNode = r.get<int>(10);
+		row.prevStopDepartureWindow = r.get<double>(11);
+		row.prevStopZone = r.get<int>(12);
+		row.stopZone = r.get<int>(13);
+		if (fetchDrivetrain)
+		{
+			try
+			{
+				row.drivetrain = r.get<string>(14);
+			}
+			catch (...)
+			{
+				//left empty; makeTrip() warns and defaults to ICE
+			}
+		}
+		batch.scheduleRows.push_back(row);
+	}
+
+	if (freightQuery)
+	{
+		freightQuery->execute();
+		while (freightQuery->fetch())
+		{
+			const soci::row& r = freightRow;
+			FreightRow row;
+			row.tripId = r.get<string>(0);
+			row.originZone = r.get<int>(1);
+			row.originNode = r.get<unsigned int>(2);
+			row.destinationZone = r.get<int>(3);
+			row.destinationNode = r.get<unsigned int>(4);
+			row.startWindow = r.get<double>(5);
+			row.mode = r.get<string>(6);
+			batch.freightRows.push_back(row);
+		}
+	}
+}
+
+void MT_PersonLoader::prefetchInterval(double start, double end)
+{
+	try
+	{
+		fetchInterval(start, end, prefetchedBatch);
+	}
+	catch (...)
+	{
+		prefetchedBatch.error = std::current_exception();
+	}
+}
+
+void MT_PersonLoader::addBatch(DemandBatch& batch)
+{
+	if (batch.error)
+	{
+		std::rethrow_exception(batch.error);
+	}
 
-	soci::rowset<soci::row> rs = (sql_.prepare << query.str());
+	//the trip chains and persons are constructed here rather than on the prefetch thread, since their construction
+	//draws random numbers and updates the shared configuration
+	ConfigParams& cfg = ConfigManager::GetInstanceRW().FullConfig();
 	unordered_map<string, vector<TripChainItem*> > tripchains;
-	for (soci::rowset<soci::row>::const_iterator it=rs.begin(); it!=rs.end(); ++it)
+	for (vector<ScheduleRow>::const_iterator rowIt = batch.scheduleRows.begin(); rowIt != batch.scheduleRows.end(); rowIt++)
 	{
-		const soci::row &r = (*it);
-		std::string personId = r.get<string>(0);
-		bool isLastInSchedule =
-				(r.get<double>(9) == LAST_30MIN_WINDOW_OF_DAY) && (r.get<string>(4) == HOME_ACTIVITY_TYPE);
-		std::vector<TripChainItem *> &personTripChain = tripchains[personId];
+		const ScheduleRow& r = *rowIt;
+		bool isLastInSchedule = (r.departureWindow == LAST_30MIN_WINDOW_OF_DAY) && (r.stopType == HOME_ACTIVITY_TYPE);
+		std::vector<TripChainItem *> &personTripChain = tripchains[r.personId];
 		//add trip and activity
 		unsigned int seqNo = personTripChain.size(); //seqNo of last trip chain item
 		sim_mob::Trip *constructedTrip = makeTrip(r, ++seqNo);
@@ -623,11 +713,11 @@ void MT_PersonLoader::loadPersonDemand()
 			personTripChain.push_back(constructedTrip);
 
 			//Record the number of trips loaded
-            cfg.numTripsLoaded++;
+			cfg.numTripsLoaded++;
 		}
 		else
 		{
-            cfg.numTripsNotLoaded++;
+			cfg.numTripsNotLoaded++;
 			continue;
 		}
 
@@ -638,41 +728,47 @@ void MT_PersonLoader::loadPersonDemand()
 	}
 
 	//Record the total number of persons loaded from the day activity schedule
-    cfg.numPersonsLoaded += tripchains.size();
+	cfg.numPersonsLoaded += tripchains.size();
 
-	if (!freightStoredProcName.empty())
+	for (vector<FreightRow>::const_iterator rowIt = batch.freightRows.begin(); rowIt != batch.freightRows.end(); rowIt++)
 	{
-		//Our SQL statement
-		stringstream freightQuery;
-		freightQuery << "select * from " << freightStoredProcName << "(" << nextLoadStart << "," << end << ")";
-		std::string freightSql_str = freightQuery.str();
-
-		soci::rowset<soci::row> rsFreight = (sql_.prepare << freightSql_str);
-		for (soci::rowset<soci::row>::const_iterator it=rsFreight.begin(); it!=rsFreight.end(); ++it)
+		std::vector<TripChainItem*>& personTripChain = tripchains[rowIt->tripId];
+		//add trip and activity
+		sim_mob::Trip* constructedTrip = makeFreightTrip(*rowIt);
+		if(constructedTrip)
 		{
-			const soci::row& r = (*it);
-			std::string freightTripId = r.get<string>(0);
-			std::vector<TripChainItem*>& personTripChain = tripchains[freightTripId];
-			//add trip and activity
-			sim_mob::Trip* constructedTrip = makeFreightTrip(r);
-			if(constructedTrip)
-			{
-				personTripChain.push_back(constructedTrip);
-			}
-			else
-			{
-				continue;
-			}
+			personTripChain.push_back(constructedTrip);
 		}
 	}
 
 	vector<Person_MT*> persons;
-	int personsLoaded = CellLoader::load(tripchains, persons);
-
+	CellLoader::load(tripchains, persons);
 	for(vector<Person_MT*>::iterator i=persons.begin(); i!=persons.end(); i++)
 	{
 		addOrStashPerson(*i);
 	}
+}
+
+void MT_PersonLoader::loadPersonDemand()
+{
+	if(storedProcName.empty())
+	{
+		loadMRT_Demand();
+		return;
+	}
+
+	double end = nextLoadStart + DEFAULT_LOAD_INTERVAL;
+	if (prefetchThread.joinable())
+	{
+		//the rows of the interval were fetched in the background during the previous interval
+		prefetchThread.join();
+	}
+	else
+	{
+		fetchInterval(nextLoadStart, end, prefetchedBatch);
+	}
+	DemandBatch batch;
+	std::swap(batch, prefetchedBatch);
 
 	//update next load start
 	nextLoadStart = end + DEFAULT_LOAD_INTERVAL;
@@ -680,5 +776,12 @@ void MT_PersonLoader::loadPersonDemand()
 	{
 		nextLoadStart = nextLoadStart - TWENTY_FOUR_HOURS; //next day starts at 3.25
 	}
-}
 
+	//start fetching the next interval while this one is simulated
+	if (prefetchEnabled && !batch.error)
+	{
+		prefetchThread = boost::thread(&MT_PersonLoader::prefetchInterval, this, nextLoadStart, nextLoadStart + DEFAULT_LOAD_INTERVAL);
+	}
+
+	addBatch(batch);
+}
@@ -3,6 +3,10 @@
 //   license.txt   (http://opensource.org/licenses/MIT)
 
 #pragma once
+#include <exception>
+#include <memory>
+#include <vector>
+#include <boost/thread.hpp>
 #include <soci/soci.h>
 #include <soci/postgresql/soci-postgresql.h>
 #include "entities/PersonLoader.hpp"
@@ -12,9 +16,15 @@ namespace sim_mob
 {
 namespace medium
 {
+class Person_MT;
+
 /**
  * Sub-class of PersonLoader tailored for loading mid-term persons from day activity schedule
  *
+ * Unless disabled in the config, the demand rows of the next load interval are queried by a background thread while
+ * the current interval is simulated. The trip chains and persons are constructed from those rows on the calling
+ * thread when loadPersonDemand() is called at the interval boundary.
+ *
  * \author Harish Loganathan
  * \zhang huai peng
  */
@@ -26,6 +36,7 @@ public:
 
     /**
      * load activity schedules for next interval
+     * waits for the rows of the interval if they are still being fetched in the background
      */
     virtual void loadPersonDemand();
 protected:
@@ -34,43 +45,142 @@ protected:
      */
     void loadMRT_Demand();
 private:
+    /**
+     * columns of a day activity schedule row; each row describes a trip and the activity at its destination
+     */
+    struct ScheduleRow
+    {
+        std::string personId;
+        int tourNo;
+        int stopNo;
+        std::string stopType;
+        int stopNode;
+        std::string stopMode;
+        int isPrimaryStop;
+        double arrivalWindow;
+        double departureWindow;
+        int prevStopNode;
+        double prevStopDepartureWindow;
+        int prevStopZone;
+        int stopZone;
+
+        /** drivetrain of the vehicle driven, fetched if the energy model is enabled; empty if unavailable*/
+        std::string drivetrain;
+    };
+
+    /**
+     * columns of a freight trip row
+     */
+    struct FreightRow
+    {
+        std::string tripId;
+        int originZone;
+        unsigned int originNode;
+        int destinationZone;
+        unsigned int destinationNode;
+        double startWindow;
+        std::string mode;
+    };
+
+    /**
+     * demand rows fetched for one interval
+     */
+    struct DemandBatch
+    {
+        std::vector<ScheduleRow> scheduleRows;
+        std::vector<FreightRow> freightRows;
+
+        /** exception thrown while fetching the batch in the background, if any */
+        std::exception_ptr error;
+    };
+
+    /**
+     * opens the database session and prepares the demand queries, if not already done
+     */
+    void prepareQueries();
+
+    /**
+     * queries the activity schedules and freight trips of an interval
+     * only copies the fetched columns, so that it can run on the prefetch thread
+     * @param start start of the interval in preday's half hour window representation
+     * @param end end of the interval in preday's half hour window representation
+     * @param batch output batch
+     */
+    void fetchInterval(double start, double end, DemandBatch& batch);
+
+    /**
+     * function executed by the prefetch thread; fetches an interval into prefetchedBatch
+     * @param start start of the interval
+     * @param end end of the interval
+     */
+    void prefetchInterval(double start, double end);
+
+    /**
+     * constructs the persons of a batch, adds them to the active or pending agents and records the load statistics
+     * @param batch the batch; rethrows the exception of the batch, if any
+     */
+    void addBatch(DemandBatch& batch);
+
     /**
      * makes a single sub trip for trip (for now)
-     * @param r row from database table
+     * @param r activity schedule row
      * @param parentTrip parent Trip for the subtrip to be constructed
      * @param subTripNo the sub trip number
      */
-    static void makeSubTrip(const soci::row& r, Trip* parentTrip, unsigned short subTripNo=1);
+    static void makeSubTrip(const ScheduleRow& r, Trip* parentTrip, unsigned short subTripNo=1);
 
     /**
      * makes an activity
-     * @param r row from database table
+     * @param r activity schedule row
      * @param seqNo tripchain item sequence number
      * @return the activity constructed from the supplied row
      */
-    static Activity* makeActivity(const soci::row& r, unsigned int seqNo);
+    static Activity* makeActivity(const ScheduleRow& r, unsigned int seqNo);
 
     /**
      * makes a trip
-     * @param r row from database table
+     * @param r activity schedule row
      * @param seqNo tripchain item sequence number
      * @return the trip constructed from the supplied row
      */
-    static Trip* makeTrip(const soci::row& r, unsigned int seqNo);
+    static Trip* makeTrip(const ScheduleRow& r, unsigned int seqNo);
 
     /**
      * makes a freight trip
-     * @param r row from database table
-     * @param seqNo tripchain item sequence number
+     * @param r freight trip row
      * @return the trip constructed from the supplied row
      */
-    static Trip* makeFreightTrip(const soci::row& r     );
+    static Trip* makeFreightTrip(const FreightRow& r);
 
     /** stored procedure to periodically load freight demand*/
     std::string freightStoredProcName;
 
     /**indicate whether load personal info*/
     bool isLoadPersonInfo;
+
+    /** whether the rows of the next interval are fetched in the background*/
+    bool prefetchEnabled;
+
+    /** database session used for all demand queries; used by one thread at a time*/
+    soci::session sql_;
+
+    /** bounds of the interval bound to the prepared queries*/
+    double queryStart;
+    double queryEnd;
+
+    /** prepared activity schedule query and the row it fetches into*/
+    std::unique_ptr<soci::statement> demandQuery;
+    soci::row demandRow;
+
+    /** prepared freight trips query and the row it fetches into*/
+    std::unique_ptr<soci::statement> freightQuery;
+    soci::row freightRow;
+
+    /** thread fetching the rows of the next interval; joinable while a batch is being prefetched*/
+    boost::thread prefetchThread;
+
+    /** batch fetched by prefetchThread*/
+    DemandBatch prefetchedBatch;
 };
 
 } // namespace medium
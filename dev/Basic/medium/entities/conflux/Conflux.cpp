@@ -12,6 +12,7 @@
 #include <stdint.h>
 #include <string>
 #include <boost/algorithm/string.hpp>
+#include <boost/chrono.hpp>
 #include <sstream>
 #include <vector>
 #include <entities/roles/driver/OnCallDriverFacets.hpp>
@@ -48,6 +49,7 @@
 #include "geospatial/network/RoadNetwork.hpp"
 #include "geospatial/network/RoadSegment.hpp"
 #include "geospatial/streetdir/StreetDirectory.hpp"
+#include "logging/ColumnarOutput.hpp"
 #include "logging/ControllerLog.hpp"
 #include "logging/Log.hpp"
 #include "message/MessageBus.hpp"
@@ -88,12 +90,14 @@ void sim_mob::medium::sortPersonsDecreasingRemTime(std::deque<Person_MT*>& perso
 }
 
 unsigned Conflux::updateInterval = 0;
+ColumnarWriter* Conflux::segStatsWriter = nullptr;
+ColumnarWriter* Conflux::lnkStatsWriter = nullptr;
 int Conflux::currentframenumber =-1;
 boost::mutex Conflux::activeAgentsLock;
 
 std::unordered_map<const Node *,Conflux *> Conflux::nodeConfluxMap;
 Conflux::Conflux(Node* confluxNode, const MutexStrategy& mtxStrat, int id, bool isLoader) :
-        Agent(mtxStrat, id), confluxNode(confluxNode), parentWorkerAssigned(false), currFrame(0, 0), isLoader(isLoader), numUpdatesThisTick(0),
+        Agent(mtxStrat, id), confluxNode(confluxNode), parentWorkerAssigned(false), currFrame(0, 0), isLoader(isLoader), numUpdatesThisTick(0), updateCost(0),
         tickTimeInS(ConfigManager::GetInstance().FullConfig().baseGranSecond()), evadeVQ_Bounds(false), segStatsOutput(std::string()),
         lnkStatsOutput(std::string())
 {
@@ -462,13 +466,17 @@ void Conflux::loadPersons()
 
 void Conflux::processAgents(timeslice frameNumber)
 {
-    PersonList orderedPersons;
+    //the measured time is used to balance the load of workers (see ConfluxRebalancer)
+    boost::chrono::high_resolution_clock::time_point start = boost::chrono::high_resolution_clock::now();
+
+    std::vector<Person_MT*>& orderedPersons = updateOrder;
+    orderedPersons.clear();
     getAllPersonsUsingTopCMerge(orderedPersons); //merge on-road agents of this conflux into a single list
     orderedPersons.insert(orderedPersons.end(), activityPerformers.begin(), activityPerformers.end()); // append activity performers
     orderedPersons.insert(orderedPersons.end(), travelingPersons.begin(), travelingPersons.end());
     orderedPersons.insert(orderedPersons.end(), brokenPersons.begin(), brokenPersons.end());
 
-    for (PersonList::iterator personIt = orderedPersons.begin(); personIt != orderedPersons.end(); personIt++) //iterate and update all persons
+    for (std::vector<Person_MT*>::iterator personIt = orderedPersons.begin(); personIt != orderedPersons.end(); personIt++) //iterate and update all persons
     {
         (*personIt)->currTick = currFrame;
         updateAgent(*personIt);
@@ -486,6 +494,8 @@ void Conflux::processAgents(timeslice frameNumber)
 
     //Update the parking agents
     updateParkingAgents();
+
+    updateCost += boost::chrono::duration_cast<boost::chrono::microseconds>(boost::chrono::high_resolution_clock::now() - start).count();
 }
 
 void  Conflux::processStartingAgents()
@@ -633,7 +643,7 @@ bool Conflux::handleRoleChange(PersonProps& beforeUpdate, PersonProps& afterUpda
             if (taxiStandAgent)
             {
                 messaging::MessageBus::SendMessage(taxiStandAgent, MSG_WAITING_PERSON_ARRIVAL,
-                                                   messaging::MessageBus::MessagePtr(new ArrivalAtStopMessage(person)));
+                                                   messaging::MessageBus::MakeMessage<ArrivalAtStopMessage>(person));
             }
             else
             {
@@ -663,7 +673,7 @@ bool Conflux::handleRoleChange(PersonProps& beforeUpdate, PersonProps& afterUpda
             else //post a message to the next conflux to handover this person for thread safety
             {
                 sim_mob::messaging::MessageBus::PostMessage(afterUpdate.segStats->getParentConflux(), sim_mob::medium::MSG_PERSON_TRANSFER,
-                        sim_mob::messaging::MessageBus::MessagePtr(new PersonTransferMessage(person, afterUpdate.segStats, afterUpdate.lane)));
+                        sim_mob::messaging::MessageBus::MakeMessage<PersonTransferMessage>(person, afterUpdate.segStats, afterUpdate.lane));
             }
         }
         else
@@ -1056,6 +1066,16 @@ void Conflux::updateAndReportSupplyStats(timeslice frameNumber)
     const ConfigManager& cfg = ConfigManager::GetInstance();
     bool outputEnabled = cfg.CMakeConfig().OutputEnabled();
     bool updateThisTick = ((frameNumber.frame() % updateInterval) == 0);
+
+    //the binary statistics are recorded straight into the buffers of this thread, the text ones kept until the next tick
+    ColumnarBuffer* segStatsBuffer = nullptr;
+    ColumnarBuffer* lnkStatsBuffer = nullptr;
+    if (updateThisTick && outputEnabled && segStatsWriter)
+    {
+        segStatsBuffer = &segStatsWriter->getThreadBuffer();
+        lnkStatsBuffer = &lnkStatsWriter->getThreadBuffer();
+    }
+
     for (UpstreamSegmentStatsMap::iterator upstreamIt = upstreamSegStatsMap.begin(); upstreamIt != upstreamSegStatsMap.end(); upstreamIt++)
     {
         const SegmentStatsList& linkSegments = upstreamIt->second;
@@ -1065,7 +1085,14 @@ void Conflux::updateAndReportSupplyStats(timeslice frameNumber)
             SegmentStats* segStats = (*segIt);
             if (updateThisTick && outputEnabled)
             {
-                segStatsOutput.append(segStats->reportSegmentStats(frameNumber.frame() / updateInterval));
+                if (segStatsBuffer)
+                {
+                    segStats->recordSegmentStats(*segStatsBuffer, frameNumber.frame() / updateInterval);
+                }
+                else
+                {
+                    segStatsOutput.append(segStats->reportSegmentStats(frameNumber.frame() / updateInterval));
+                }
                 lnkTotalVehicleLength = lnkTotalVehicleLength + segStats->getTotalVehicleLength();
                 segStats->resetSegFlow();
             }
@@ -1081,7 +1108,14 @@ void Conflux::updateAndReportSupplyStats(timeslice frameNumber)
         {
             LinkStats& lnkStats = (linkStatsMap.find(upstreamIt->first))->second;
             lnkStats.computeLinkDensity(lnkTotalVehicleLength);
-            lnkStatsOutput.append(lnkStats.writeOutLinkStats(frameNumber.frame() / updateInterval));
+            if (lnkStatsBuffer)
+            {
+                lnkStats.recordLinkStats(*lnkStatsBuffer, frameNumber.frame() / updateInterval);
+            }
+            else
+            {
+                lnkStatsOutput.append(lnkStats.writeOutLinkStats(frameNumber.frame() / updateInterval));
+            }
         }
     }
 
@@ -1838,7 +1872,7 @@ void Conflux::assignPersonToBusStopAgent(Person_MT* person)
         BusStopAgent* busStopAgent = BusStopAgent::getBusStopAgentForStop(stop);
         if (busStopAgent)
         {
-            messaging::MessageBus::SendMessage(busStopAgent, MSG_WAITING_PERSON_ARRIVAL, messaging::MessageBus::MessagePtr(new ArrivalAtStopMessage(person)));
+            messaging::MessageBus::SendMessage(busStopAgent, MSG_WAITING_PERSON_ARRIVAL, messaging::MessageBus::MakeMessage<ArrivalAtStopMessage>(person));
         }
     }
 }
@@ -2122,12 +2156,15 @@ PersonCount Conflux::countPersons() const
     return count;
 }
 
-void Conflux::getAllPersonsUsingTopCMerge(std::deque<Person_MT*>& mergedPersonDeque)
+void Conflux::getAllPersonsUsingTopCMerge(std::vector<Person_MT*>& mergedPersons)
 {
     SegmentStats* segStats = nullptr;
-    std::vector<PersonList> allPersonLists;
     int sumCapacity = 0;
 
+    //the per-link lists are kept across ticks, so that their memory is re-used
+    size_t linkIdx = 0;
+    linkPersonLists.resize(upstreamSegStatsMap.size());
+
     //need to calculate the time to intersection for each vehicle.
     //basic test-case shows that this calculation is kind of costly.
     for (UpstreamSegmentStatsMap::iterator upStrmSegMapIt = upstreamSegStatsMap.begin(); upStrmSegMapIt != upstreamSegStatsMap.end(); upStrmSegMapIt++)
@@ -2135,7 +2172,8 @@ void Conflux::getAllPersonsUsingTopCMerge(std::deque<Person_MT*>& mergedPersonDe
         const SegmentStatsList& upstreamSegments = upStrmSegMapIt->second;
         sumCapacity += (int) (ceil((*upstreamSegments.rbegin())->getCapacity()));
         double totalTimeToSegEnd = 0;
-        std::deque<Person_MT*> oneDeque;
+        std::vector<Person_MT*>& linkPersons = linkPersonLists[linkIdx++];
+        linkPersons.clear();
         for (SegmentStatsList::const_reverse_iterator rdSegIt = upstreamSegments.rbegin(); rdSegIt != upstreamSegments.rend(); rdSegIt++)
         {
             segStats = (*rdSegIt);
@@ -2146,82 +2184,70 @@ void Conflux::getAllPersonsUsingTopCMerge(std::deque<Person_MT*>& mergedPersonDe
                 speed = INFINITESIMAL_DOUBLE;
             }
             segStats->updateLinkDrivingTimes(totalTimeToSegEnd);
-            PersonList tmpAgents;
-            segStats->topCMergeLanesInSegment(tmpAgents);
+            segStats->topCMergeLanesInSegment(linkPersons);
             totalTimeToSegEnd += segStats->getLength() / speed;
-            oneDeque.insert(oneDeque.end(), tmpAgents.begin(), tmpAgents.end());
         }
-        allPersonLists.push_back(oneDeque);
     }
 
-    topCMergeDifferentLinksInConflux(mergedPersonDeque, allPersonLists, sumCapacity);
+    topCMergeDifferentLinksInConflux(mergedPersons, linkPersonLists, sumCapacity);
 }
 
-void Conflux::topCMergeDifferentLinksInConflux(std::deque<Person_MT*>& mergedPersonDeque, std::vector<std::deque<Person_MT*> >& allPersonLists, int capacity)
+void Conflux::topCMergeDifferentLinksInConflux(std::vector<Person_MT*>& mergedPersons, const std::vector< std::vector<Person_MT*> >& allPersonLists,
+        int capacity)
 {
-    std::vector<std::deque<Person_MT*>::iterator> iteratorLists;
-
-    //init location
-    size_t dequeSize = allPersonLists.size();
-    for (std::vector<std::deque<Person_MT*> >::iterator it = allPersonLists.begin(); it != allPersonLists.end(); ++it)
-    {
-        iteratorLists.push_back(((*it)).begin());
-    }
+    //init read positions
+    const size_t numLists = allPersonLists.size();
+    mergeCursors.assign(numLists, 0);
 
     //pick the Top C
-    for (size_t c = 0; c < capacity; c++)
+    for (int c = 0; c < capacity; c++)
     {
+        //find the smallest driving time among the list fronts, and the number of lists sharing it
         double minVal = MAX_DOUBLE;
-        Person_MT* currPerson = nullptr;
-        std::vector<std::pair<int, Person_MT*> > equiTimeList;
-        for (size_t i = 0; i < dequeSize; i++)
+        size_t numEquiTime = 0;
+        for (size_t i = 0; i < numLists; i++)
         {
-            if (iteratorLists[i] != (allPersonLists[i]).end())
+            if (mergeCursors[i] < allPersonLists[i].size())
             {
-                currPerson = (*(iteratorLists[i]));
-                if (currPerson->drivingTimeToEndOfLink == minVal)
+                double drivingTime = allPersonLists[i][mergeCursors[i]]->drivingTimeToEndOfLink;
+                if (drivingTime == minVal)
                 {
-                    equiTimeList.push_back(std::make_pair(i, currPerson));
+                    numEquiTime++;
                 }
-                else if (currPerson->drivingTimeToEndOfLink < minVal)
+                else if (drivingTime < minVal)
                 {
-                    minVal = (*iteratorLists[i])->drivingTimeToEndOfLink;
-                    equiTimeList.clear();
-                    equiTimeList.push_back(std::make_pair(i, currPerson));
+                    minVal = drivingTime;
+                    numEquiTime = 1;
                 }
             }
         }
 
-        if (equiTimeList.empty())
+        if (numEquiTime == 0)
         {
             return; //no more vehicles
         }
-        else
+
+        //we have to randomly choose from the lists whose front persons have the same driving time
+        size_t chosenIdx = (numEquiTime == 1) ? 0 : (rand() % numEquiTime);
+        for (size_t i = 0; i < numLists; i++)
         {
-            //we have to randomly choose from persons in equiDistantList
-            size_t numElements = equiTimeList.size();
-            std::pair<int, Person_MT*> chosenPair;
-            if (numElements == 1)
+            if (mergeCursors[i] < allPersonLists[i].size() && allPersonLists[i][mergeCursors[i]]->drivingTimeToEndOfLink == minVal)
             {
-                chosenPair = equiTimeList.front();
-            }
-            else
-            {
-                int chosenIdx = rand() % numElements;
-                chosenPair = equiTimeList[chosenIdx];
+                if (chosenIdx == 0)
+                {
+                    mergedPersons.push_back(allPersonLists[i][mergeCursors[i]]);
+                    mergeCursors[i]++;
+                    break;
+                }
+                chosenIdx--;
             }
-            iteratorLists.at(chosenPair.first)++;
-            mergedPersonDeque.push_back(chosenPair.second);
         }
     }
 
-    //After pick the Top C, there are still some vehicles left in the deque
-    for (size_t i = 0; i < dequeSize; i++)
+    //After pick the Top C, there are still some vehicles left in the lists
+    for (size_t i = 0; i < numLists; i++)
     {
-        if (iteratorLists[i] != (allPersonLists[i]).end())
-        {
-            mergedPersonDeque.insert(mergedPersonDeque.end(), iteratorLists[i], (allPersonLists[i]).end());
-        }
+        mergedPersons.insert(mergedPersons.end(), allPersonLists[i].begin() + mergeCursors[i], allPersonLists[i].end());
     }
 }
 //
@@ -2511,6 +2537,29 @@ Conflux* sim_mob::medium::Conflux::getConflux(const RoadSegment* rdSeg)
     return MT_Config::getInstance().getConfluxForNode(rdSeg->getParentLink()->getToNode());
 }
 
+void Conflux::openStatsOutput()
+{
+    const SupplyStatsOutputConfig& outputCfg = MT_Config::getInstance().supplyStatsOutput;
+    if (outputCfg.binary && ConfigManager::GetInstance().CMakeConfig().OutputEnabled() && !segStatsWriter)
+    {
+        segStatsWriter = new ColumnarWriter(outputCfg.segmentStatsFile, "seg", SegmentStats::getStatsColumns(),
+                                            outputCfg.chunkRows);
+        lnkStatsWriter = new ColumnarWriter(outputCfg.linkStatsFile, "lnk", LinkStats::getStatsColumns(),
+                                            outputCfg.chunkRows);
+    }
+}
+
+void Conflux::closeStatsOutput()
+{
+    if (segStatsWriter)
+    {
+        segStatsWriter->close();
+        lnkStatsWriter->close();
+        safe_delete_item(segStatsWriter);
+        safe_delete_item(lnkStatsWriter);
+    }
+}
+
 void sim_mob::medium::Conflux::writeOutputs()
 {
     if(segStatsOutput.length() > 0)
@@ -2543,6 +2592,52 @@ void Conflux::removeIncident(SegmentStats* segStats)
     }
 }
 
+void Conflux::updateWorkerContext(void* newContext)
+{
+    MessageBus::ReRegisterHandler(this, newContext);
+
+    PersonList allPersons = getAllPersons();
+    allPersons.insert(allPersons.end(), mrt.begin(), mrt.end());
+    allPersons.insert(allPersons.end(), travelingPersons.begin(), travelingPersons.end());
+    allPersons.insert(allPersons.end(), brokenPersons.begin(), brokenPersons.end());
+    allPersons.insert(allPersons.end(), stashedPersons.begin(), stashedPersons.end());
+    for (PersonList::iterator personIt = allPersons.begin(); personIt != allPersons.end(); personIt++)
+    {
+        (*personIt)->currWorkerProvider = currWorkerProvider;
+        if ((*personIt)->GetContext())
+        {
+            MessageBus::ReRegisterHandler(*personIt, newContext);
+        }
+    }
+
+    for (UpstreamSegmentStatsMap::iterator upStrmSegMapIt = upstreamSegStatsMap.begin(); upStrmSegMapIt != upstreamSegStatsMap.end(); upStrmSegMapIt++)
+    {
+        const SegmentStatsList& upstreamSegments = upStrmSegMapIt->second;
+        for (SegmentStatsList::const_iterator rdSegIt = upstreamSegments.begin(); rdSegIt != upstreamSegments.end(); rdSegIt++)
+        {
+            (*rdSegIt)->reRegisterStopAgents(newContext);
+        }
+    }
+
+    for (std::vector<Agent*>::iterator it = stationAgents.begin(); it != stationAgents.end(); it++)
+    {
+        (*it)->currWorkerProvider = currWorkerProvider;
+        if ((*it)->GetContext())
+        {
+            MessageBus::ReRegisterHandler(*it, newContext);
+        }
+    }
+
+    for (std::vector<Agent*>::iterator it = parkingAgents.begin(); it != parkingAgents.end(); it++)
+    {
+        (*it)->currWorkerProvider = currWorkerProvider;
+        if ((*it)->GetContext())
+        {
+            MessageBus::ReRegisterHandler(*it, newContext);
+        }
+    }
+}
+
 void Conflux::addStationAgent(Agent* stationAgent)
 {
     if(!stationAgent){
@@ -2994,7 +3089,6 @@ void Conflux::CreateLaneGroups()
         return;
     }
 
-    typedef std::map<const Lane*, LaneStats*> LaneStatsMap;
     for (std::set<Conflux*>::const_iterator cfxIt = confluxes.begin(); cfxIt != confluxes.end(); cfxIt++)
     {
         UpstreamSegmentStatsMap& upSegsMap = (*cfxIt)->upstreamSegStatsMap;
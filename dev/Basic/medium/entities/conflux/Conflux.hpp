@@ -19,6 +19,7 @@
 
 namespace sim_mob
 {
+class ColumnarWriter;
 class RoadSegment;
 class Worker;
 
@@ -181,10 +182,26 @@ static std::unordered_map<const Node *,Conflux *> nodeConfluxMap;
 
     /**list of persons who are about to get into the simulation in the next tick*/
     PersonList loadingQueue;
+
+    /**
+     * scratch buffers of processAgents() and the top C merge.
+     * They are only used within a single update of this conflux, but kept as members so that
+     * their memory is re-used from tick to tick.
+     */
+    std::vector<Person_MT*> updateOrder;
+    std::vector< std::vector<Person_MT*> > linkPersonLists;
+    std::vector<size_t> mergeCursors;
         
     /**interval of output updates*/
     static uint32_t updateInterval;
 
+    /**
+     * writers of the binary segment and link statistics, shared by all confluxes;
+     * null when the statistics are written to the text log
+     */
+    static ColumnarWriter* segStatsWriter;
+    static ColumnarWriter* lnkStatsWriter;
+
     /**time in seconds of a single tick*/
     const double tickTimeInS;
 
@@ -199,6 +216,11 @@ static std::unordered_map<const Node *,Conflux *> nodeConfluxMap;
      */
     unsigned int numUpdatesThisTick;
 
+    /**
+     * wall-clock time (in microseconds) spent in processAgents() since the last call to resetUpdateCost()
+     */
+    uint64_t updateCost;
+
     /**
      * flag to indicate whether the VQ size limits are to be ignored
      */
@@ -469,6 +491,30 @@ public:
      */
     void addConnectedConflux(Conflux* conflux);
 
+    /**
+     * retrieves the measured cost of updating this conflux
+     * @return wall-clock time (in microseconds) spent in processAgents() since the last call to resetUpdateCost()
+     */
+    uint64_t getUpdateCost() const
+    {
+        return updateCost;
+    }
+
+    /**
+     * starts a new measurement of the update cost of this conflux
+     */
+    void resetUpdateCost()
+    {
+        updateCost = 0;
+    }
+
+    /**
+     * re-registers the message handlers of this conflux and of the agents managed by it with a new context.
+     * Must be called after this conflux is moved to a different worker, while the workers are blocked.
+     * @param newContext the message bus context of the new worker's thread
+     */
+    void updateWorkerContext(void* newContext);
+
     /**
      * accept broken driver
      * @param person is pointer to a person who is broken
@@ -611,18 +657,18 @@ public:
 
     /**
      * get an ordered list of all persons in this conflux
-     * @param mergedPersonDeque output list that must contain the merged list of persons
+     * @param mergedPersons output list to which the merged list of persons is appended
      */
-    void getAllPersonsUsingTopCMerge(std::deque<Person_MT*>& mergedPersonDeque);
+    void getAllPersonsUsingTopCMerge(std::vector<Person_MT*>& mergedPersons);
 
     /**
      * merges the ordered list of persons on each link of the conflux into 1
-     * @param mergedPersonDeque output list that must contain the merged list of persons
+     * @param mergedPersons output list to which the merged list of persons is appended
      * @param allPersonLists list of list of persons to merge
      * @param capacity capacity till which the relative ordering of persons is important
      */
-    void topCMergeDifferentLinksInConflux(std::deque<Person_MT*>& mergedPersonDeque,
-            std::vector< std::deque<Person_MT*> >& allPersonLists, int capacity);
+    void topCMergeDifferentLinksInConflux(std::vector<Person_MT*>& mergedPersons,
+            const std::vector< std::vector<Person_MT*> >& allPersonLists, int capacity);
 
     /**
      * get number of persons in lane infinities of this conflux
@@ -696,6 +742,18 @@ public:
      */
     static void CreateLaneGroups();
 
+    /**
+     * opens the binary segment and link statistics files, if enabled in the mid-term config;
+     * must be called before the workers start
+     */
+    static void openStatsOutput();
+
+    /**
+     * writes out the remaining binary segment and link statistics and closes the files;
+     * must be called after the workers have stopped
+     */
+    static void closeStatsOutput();
+
     void updateQueuingTaxiDriverAgent(Person_MT *&person, timeslice now);
 
     void updateParkedServiceDriver(Person_MT *&person, timeslice now);
@@ -0,0 +1,290 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "ConfluxRebalancer.hpp"
+
+#include <algorithm>
+#include <map>
+#include <boost/unordered_map.hpp>
+
+#include "config/MT_Config.hpp"
+#include "entities/conflux/Conflux.hpp"
+#include "logging/Log.hpp"
+#include "workers/WorkGroup.hpp"
+
+using namespace sim_mob;
+using namespace sim_mob::medium;
+
+namespace
+{
+
+/** a candidate move of a vertex to another partition */
+struct Move
+{
+    Move(long gain, size_t vertex, unsigned int dest) : gain(gain), vertex(vertex), dest(dest)
+    {
+    }
+
+    /** orders moves by decreasing gain */
+    bool operator<(const Move& rhs) const
+    {
+        return gain > rhs.gain;
+    }
+
+    /** reduction in the number of cut edges if the vertex is moved */
+    long gain;
+
+    /** the vertex to move */
+    size_t vertex;
+
+    /** the destination partition */
+    unsigned int dest;
+};
+
+/** counts the neighbours of a vertex which are in a given partition */
+long countNeighbours(const ConfluxRebalancer::Graph& graph, const std::vector<unsigned int>& assignment, size_t vertex, unsigned int part)
+{
+    long count = 0;
+    for (std::vector<size_t>::const_iterator it = graph[vertex].begin(); it != graph[vertex].end(); it++)
+    {
+        if (assignment[*it] == part)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+/** collects the moves of the vertices in partition src to each of their adjacent partitions, best moves first */
+void collectBoundaryMoves(const ConfluxRebalancer::Graph& graph, const std::vector<unsigned int>& assignment, unsigned int src,
+        std::vector<Move>& moves)
+{
+    std::vector<unsigned int> destinations;
+    for (size_t vertex = 0; vertex < graph.size(); vertex++)
+    {
+        if (assignment[vertex] != src)
+        {
+            continue;
+        }
+
+        destinations.clear();
+        for (std::vector<size_t>::const_iterator it = graph[vertex].begin(); it != graph[vertex].end(); it++)
+        {
+            unsigned int part = assignment[*it];
+            if (part != src && std::find(destinations.begin(), destinations.end(), part) == destinations.end())
+            {
+                destinations.push_back(part);
+            }
+        }
+
+        long internal = countNeighbours(graph, assignment, vertex, src);
+        for (std::vector<unsigned int>::const_iterator it = destinations.begin(); it != destinations.end(); it++)
+        {
+            moves.push_back(Move(countNeighbours(graph, assignment, vertex, *it) - internal, vertex, *it));
+        }
+    }
+    std::stable_sort(moves.begin(), moves.end());
+}
+
+}
+
+ConfluxRebalancer::ConfluxRebalancer(double imbalanceTolerance) : imbalanceTolerance(imbalanceTolerance)
+{
+}
+
+ConfluxRebalancer::~ConfluxRebalancer()
+{
+}
+
+size_t ConfluxRebalancer::partition(const Graph& graph, const std::vector<uint64_t>& weights, unsigned int numPartitions,
+        double imbalanceTolerance, std::vector<unsigned int>& assignment)
+{
+    const std::vector<unsigned int> initialAssignment(assignment);
+
+    std::vector<uint64_t> loads(numPartitions, 0);
+    uint64_t totalLoad = 0;
+    for (size_t vertex = 0; vertex < graph.size(); vertex++)
+    {
+        loads[assignment[vertex]] += weights[vertex];
+        totalLoad += weights[vertex];
+    }
+    const uint64_t averageLoad = totalLoad / numPartitions;
+    const uint64_t maxLoad = (uint64_t) ((double) totalLoad / numPartitions * (1.0 + imbalanceTolerance));
+
+    //Step 1: diffuse load from the heaviest partitions to their neighbours, until no partition is overloaded.
+    //An overloaded partition sheds load to any lighter neighbour; a partition which is not overloaded passes load on
+    //to neighbours below the average, making room for the load of the overloaded partitions further up the gradient.
+    //Every move reduces the load difference between the two partitions involved (and so the sum of the squared loads),
+    //so this terminates; the pass limit merely bounds the time spent when the graph structure does not allow a good
+    //balance.
+    std::vector<bool> exhausted(numPartitions, false);
+    std::vector<Move> moves;
+    for (size_t pass = 0; pass < graph.size(); pass++)
+    {
+        if (*std::max_element(loads.begin(), loads.end()) <= maxLoad)
+        {
+            break;
+        }
+
+        unsigned int heaviest = numPartitions;
+        for (unsigned int part = 0; part < numPartitions; part++)
+        {
+            if (!exhausted[part] && (heaviest == numPartitions || loads[part] > loads[heaviest]))
+            {
+                heaviest = part;
+            }
+        }
+        if (heaviest == numPartitions)
+        {
+            break;
+        }
+
+        moves.clear();
+        collectBoundaryMoves(graph, assignment, heaviest, moves);
+
+        bool moved = false;
+        for (std::vector<Move>::const_iterator it = moves.begin(); it != moves.end(); it++)
+        {
+            uint64_t weight = weights[it->vertex];
+            if (weight == 0 || assignment[it->vertex] != heaviest || loads[it->dest] + weight >= loads[heaviest]
+                    || (loads[heaviest] <= maxLoad && loads[it->dest] + weight > averageLoad))
+            {
+                continue;
+            }
+            assignment[it->vertex] = it->dest;
+            loads[heaviest] -= weight;
+            loads[it->dest] += weight;
+            moved = true;
+        }
+
+        if (moved)
+        {
+            //the loads of the neighbours changed; partitions which were stuck may be able to shed load again
+            std::fill(exhausted.begin(), exhausted.end(), false);
+        }
+        else
+        {
+            exhausted[heaviest] = true;
+        }
+    }
+
+    //Step 2: reduce the edge cut by moving boundary vertices to the partition holding most of their neighbours,
+    //without overloading that partition.
+    for (unsigned int pass = 0; pass < 2; pass++)
+    {
+        size_t numMoved = 0;
+        for (size_t vertex = 0; vertex < graph.size(); vertex++)
+        {
+            unsigned int src = assignment[vertex];
+            long internal = countNeighbours(graph, assignment, vertex, src);
+            long bestGain = 0;
+            unsigned int bestDest = src;
+            for (std::vector<size_t>::const_iterator it = graph[vertex].begin(); it != graph[vertex].end(); it++)
+            {
+                unsigned int part = assignment[*it];
+                if (part == src || loads[part] + weights[vertex] > maxLoad)
+                {
+                    continue;
+                }
+                long gain = countNeighbours(graph, assignment, vertex, part) - internal;
+                if (gain > bestGain)
+                {
+                    bestGain = gain;
+                    bestDest = part;
+                }
+            }
+
+            if (bestDest != src)
+            {
+                assignment[vertex] = bestDest;
+                loads[src] -= weights[vertex];
+                loads[bestDest] += weights[vertex];
+                numMoved++;
+            }
+        }
+
+        if (numMoved == 0)
+        {
+            break;
+        }
+    }
+
+    size_t numChanged = 0;
+    for (size_t vertex = 0; vertex < assignment.size(); vertex++)
+    {
+        if (assignment[vertex] != initialAssignment[vertex])
+        {
+            numChanged++;
+        }
+    }
+    return numChanged;
+}
+
+void ConfluxRebalancer::rebalance(WorkGroup& workGroup)
+{
+    const unsigned int numWorkers = workGroup.size();
+    const std::map<const Node*, Conflux*>& confluxNodes = MT_Config::getInstance().getConfluxNodes();
+
+    std::vector<Conflux*> confluxes;
+    std::vector<uint64_t> weights;
+    std::vector<unsigned int> assignment;
+    boost::unordered_map<const Conflux*, size_t> vertexOf;
+
+    for (std::map<const Node*, Conflux*>::const_iterator it = confluxNodes.begin(); it != confluxNodes.end(); it++)
+    {
+        Conflux* conflux = it->second;
+        int workerIdx = workGroup.getWorkerIndex(conflux->currWorkerProvider);
+        if (workerIdx < 0)
+        {
+            continue;
+        }
+
+        vertexOf[conflux] = confluxes.size();
+        confluxes.push_back(conflux);
+        //even an empty conflux takes some time to update
+        weights.push_back(std::max<uint64_t>(conflux->getUpdateCost(), 1));
+        assignment.push_back(workerIdx);
+        conflux->resetUpdateCost();
+    }
+
+    if (numWorkers < 2 || confluxes.empty())
+    {
+        return;
+    }
+
+    //connectedConfluxes are directed (downstream confluxes only); persons flow both ways across worker boundaries
+    Graph graph(confluxes.size());
+    for (size_t vertex = 0; vertex < confluxes.size(); vertex++)
+    {
+        const std::set<Conflux*>& connected = confluxes[vertex]->getConnectedConfluxes();
+        for (std::set<Conflux*>::const_iterator it = connected.begin(); it != connected.end(); it++)
+        {
+            boost::unordered_map<const Conflux*, size_t>::const_iterator adjIt = vertexOf.find(*it);
+            if (adjIt != vertexOf.end() && adjIt->second != vertex)
+            {
+                graph[vertex].push_back(adjIt->second);
+                graph[adjIt->second].push_back(vertex);
+            }
+        }
+    }
+    for (Graph::iterator it = graph.begin(); it != graph.end(); it++)
+    {
+        std::sort(it->begin(), it->end());
+        it->erase(std::unique(it->begin(), it->end()), it->end());
+    }
+
+    size_t numMoved = partition(graph, weights, numWorkers, imbalanceTolerance, assignment);
+
+    for (size_t vertex = 0; vertex < confluxes.size(); vertex++)
+    {
+        Conflux* conflux = confluxes[vertex];
+        if (workGroup.getWorkerIndex(conflux->currWorkerProvider) != (int) assignment[vertex])
+        {
+            workGroup.migrateEntity(conflux, assignment[vertex]);
+            conflux->updateWorkerContext(workGroup.getWorkerMessageContext(assignment[vertex]));
+        }
+    }
+
+    Print() << "Conflux rebalance: moved " << numMoved << " of " << confluxes.size() << " confluxes" << std::endl;
+}
@@ -0,0 +1,65 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+#include "workers/EntityRebalancer.hpp"
+
+namespace sim_mob
+{
+
+namespace medium
+{
+
+/**
+ * Re-distributes confluxes among the workers of the person work group, based on the time each conflux spent
+ * in Conflux::processAgents() since the previous rebalance (ASSIGN_TIMEBASED strategy).
+ *
+ * The confluxes are the vertices of a graph whose edges are the conflux adjacencies (Conflux::getConnectedConfluxes()),
+ * and each worker is a partition. Starting from the current assignment, the rebalancer
+ *  1. diffuses load away from the heaviest workers by moving boundary confluxes to adjacent, lighter workers,
+ *     preferring the confluxes whose move cuts the fewest edges, until every worker is within the imbalance tolerance
+ *  2. runs a Fiduccia-Mattheyses style refinement pass which moves boundary confluxes to the partition holding most
+ *     of their neighbours, as long as the balance is not violated.
+ * Keeping adjacent confluxes on the same worker minimises the persons (and messages) transferred between workers.
+ * Only the confluxes whose worker changed are migrated.
+ */
+class ConfluxRebalancer : public EntityRebalancer
+{
+public:
+    /**
+     * @param imbalanceTolerance a worker is considered overloaded when its load exceeds the average load by this fraction
+     */
+    explicit ConfluxRebalancer(double imbalanceTolerance = 0.05);
+    virtual ~ConfluxRebalancer();
+
+    virtual void rebalance(WorkGroup& workGroup);
+
+    /** adjacency list of the conflux graph; vertices are indices into the weight and partition vectors */
+    typedef std::vector< std::vector<size_t> > Graph;
+
+    /**
+     * computes a balanced partition of a weighted graph, starting from (and staying close to) an existing one
+     *
+     * @param graph adjacency list of the graph (undirected; each edge must be listed for both of its vertices)
+     * @param weights weight of each vertex
+     * @param numPartitions number of partitions
+     * @param imbalanceTolerance allowed fraction by which the weight of a partition may exceed the average
+     * @param assignment input: current partition of each vertex; output: new partition of each vertex
+     *
+     * @return number of vertices whose partition changed
+     */
+    static size_t partition(const Graph& graph, const std::vector<uint64_t>& weights, unsigned int numPartitions,
+            double imbalanceTolerance, std::vector<unsigned int>& assignment);
+
+private:
+    /** allowed fraction by which the load of a worker may exceed the average load */
+    const double imbalanceTolerance;
+};
+
+}
+}
@@ -16,6 +16,7 @@
 #include "entities/Vehicle.hpp"
 //aa{
 #include "config/MT_Config.hpp"
+#include "logging/ColumnarOutput.hpp"
 //aa}
 
 
@@ -166,6 +167,31 @@ std::string LinkStats::writeOutLinkStats(unsigned int updateNumber)
     return std::string(buf);
 }
 
+void LinkStats::recordLinkStats(ColumnarBuffer& buffer, unsigned int updateNumber)
+{
+    buffer << updateNumber << linkId << linkLengthKm << density << entryCount << exitCount << carCount << taxiCount
+            << motorcycleCount << busCount << otherVehiclesCount;
+    buffer.endRow();
+    resetStats();
+}
+
+std::vector<ColumnSchema> LinkStats::getStatsColumns()
+{
+    std::vector<ColumnSchema> columns;
+    columns.push_back(ColumnSchema("interval", ColumnSchema::INTEGER));
+    columns.push_back(ColumnSchema("link_id", ColumnSchema::INTEGER));
+    columns.push_back(ColumnSchema("length", ColumnSchema::REAL, 3));
+    columns.push_back(ColumnSchema("density", ColumnSchema::REAL, 3));
+    columns.push_back(ColumnSchema("entry", ColumnSchema::INTEGER));
+    columns.push_back(ColumnSchema("exit", ColumnSchema::INTEGER));
+    columns.push_back(ColumnSchema("car", ColumnSchema::INTEGER));
+    columns.push_back(ColumnSchema("taxi", ColumnSchema::INTEGER));
+    columns.push_back(ColumnSchema("motorcycle", ColumnSchema::INTEGER));
+    columns.push_back(ColumnSchema("bus", ColumnSchema::INTEGER));
+    columns.push_back(ColumnSchema("other", ColumnSchema::INTEGER));
+    return columns;
+}
+
 void LinkStats::computeLinkDensity(double vehicleLength)
 {
     double totalPCUs = vehicleLength / PASSENGER_CAR_UNIT;
@@ -7,6 +7,8 @@
 
 namespace sim_mob
 {
+class ColumnarBuffer;
+struct ColumnSchema;
 class Link;
 namespace medium
 {
@@ -102,6 +104,18 @@ public:
 	 */
 	std::string writeOutLinkStats(unsigned int updateNumber);
 
+	/**
+	 * records all stats collected so far as a row of the binary link statistics and resets
+	 * @param buffer buffer of the link statistics of the current thread
+	 * @param updateNumber update interval number at which the output was requested
+	 */
+	void recordLinkStats(ColumnarBuffer& buffer, unsigned int updateNumber);
+
+	/**
+	 * @return the columns of the binary link statistics; the columns of the csv output of writeOutLinkStats()
+	 */
+	static std::vector<ColumnSchema> getStatsColumns();
+
 	/**
 	 * computes and sets link density
 	 * @param total length of all vehicles on the link
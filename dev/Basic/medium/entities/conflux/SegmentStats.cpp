@@ -9,6 +9,7 @@
 #include "entities/BusStopAgent.hpp"
 #include "entities/roles/driver/OnHailDriverFacets.hpp"
 #include "entities/TaxiStandAgent.hpp"
+#include "logging/ColumnarOutput.hpp"
 
 
 using std::string;
@@ -282,114 +283,86 @@ void SegmentStats::getInfinityPersons(std::deque<Person_MT*>& segAgents)
 	segAgents.insert(segAgents.end(), lnAgents.begin(), lnAgents.end());
 }
 
-void SegmentStats::topCMergeLanesInSegment(PersonList& mergedPersonList)
+void SegmentStats::topCMergeLanesInSegment(std::vector<Person_MT*>& mergedPersonList)
 {
-	mergedPersonList.clear();
 	//Bus drivers go in the front of the list, because bus stops are (virtually) located at the end of the segment
 	for (BusStopList::const_reverse_iterator stopIt = busStops.rbegin(); stopIt != busStops.rend(); stopIt++)
 	{
-		const BusStop* stop = *stopIt;
-		PersonList& driversAtStop = busDrivers.at(stop);
-		for (PersonList::iterator pIt = driversAtStop.begin(); pIt != driversAtStop.end(); pIt++)
-		{
-			mergedPersonList.push_back(*pIt);
-		}
+		const PersonList& driversAtStop = busDrivers.at(*stopIt);
+		mergedPersonList.insert(mergedPersonList.end(), driversAtStop.begin(), driversAtStop.end());
 	}
 
-	int capacity = (int) (ceil(supplyParams.getCapacity()));
-	//init iterator list to the front of each lane
-	std::vector<PersonList::iterator> iteratorLists;
-	for (LaneStatsMap::iterator lnIt = laneStatsMap.begin(); lnIt != laneStatsMap.end(); lnIt++)
+	//init the read position of each lane to its front. Lane infinity is the last entry of laneStatsMap
+	const size_t numLanes = laneStatsMap.size() - 1;
+	mergeCursors.clear();
+	for (size_t i = 0; i < numLanes; i++)
 	{
-		if(!lnIt->second->isLaneInfinity())
-		{
-			iteratorLists.push_back(lnIt->second->laneAgents.begin());
-		}
+		mergeCursors.push_back((laneStatsMap.begin() + i)->second->laneAgents.begin());
 	}
 
 	//pick the Top C
+	const bool byDistance = (orderBySetting == SEGMENT_ORDERING_BY_DISTANCE_TO_INTERSECTION);
+	int capacity = (int) (ceil(supplyParams.getCapacity()));
 	for (int c = 0; c < capacity; c++)
 	{
+		//find the smallest key among the lane fronts, and the number of lanes sharing it
 		double minVal = std::numeric_limits<double>::max();
-		Person_MT* currPerson = nullptr;
-		std::vector<std::pair<int, Person_MT*> > equiDistantList;
-		int i = 0;
-		for (LaneStatsMap::iterator lnIt = laneStatsMap.begin(); lnIt != laneStatsMap.end(); lnIt++)
+		size_t numEquiDistant = 0;
+		for (size_t i = 0; i < numLanes; i++)
 		{
-			if(!lnIt->second->isLaneInfinity())
+			if (mergeCursors[i] != (laneStatsMap.begin() + i)->second->laneAgents.end())
 			{
-				PersonList& personsInLane = lnIt->second->laneAgents;
-				if (iteratorLists[i] != personsInLane.end())
+				const Person_MT* currPerson = *mergeCursors[i];
+				double val = byDistance ? currPerson->distanceToEndOfSegment : currPerson->drivingTimeToEndOfLink;
+				if (val == minVal)
 				{
-					currPerson = (*(iteratorLists[i]));
-					if (orderBySetting == SEGMENT_ORDERING_BY_DISTANCE_TO_INTERSECTION)
-					{
-						if (currPerson->distanceToEndOfSegment == minVal)
-						{
-							equiDistantList.push_back(std::make_pair(i, currPerson));
-						}
-						else if (currPerson->distanceToEndOfSegment < minVal)
-						{
-							minVal = currPerson->distanceToEndOfSegment;
-							equiDistantList.clear();
-							equiDistantList.push_back(std::make_pair(i, currPerson));
-						}
-					}
-					else if (orderBySetting == SEGMENT_ORDERING_BY_DRIVING_TIME_TO_INTERSECTION)
-					{
-						if (currPerson->drivingTimeToEndOfLink == minVal)
-						{
-							equiDistantList.push_back(std::make_pair(i, currPerson));
-						}
-						else if (currPerson->drivingTimeToEndOfLink < minVal)
-						{
-							minVal = currPerson->drivingTimeToEndOfLink;
-							equiDistantList.clear();
-							equiDistantList.push_back(std::make_pair(i, currPerson));
-						}
-					}
+					numEquiDistant++;
+				}
+				else if (val < minVal)
+				{
+					minVal = val;
+					numEquiDistant = 1;
 				}
-				i++;
 			}
 		}
 
-		if (!equiDistantList.empty())
+		if (numEquiDistant == 0)
 		{
-			//we have to randomly choose from persons in equiDistantList
-			size_t numElements = equiDistantList.size();
-			std::pair<int, Person_MT*> chosenPair;
-			if (numElements == 1)
-			{
-				chosenPair = equiDistantList.front();
-			}
-			else
+			break; //no more vehicles
+		}
+
+		//we have to randomly choose from the lanes whose front persons are equidistant
+		size_t chosenIdx = (numEquiDistant == 1) ? 0 : (rand() % numEquiDistant);
+		for (size_t i = 0; i < numLanes; i++)
+		{
+			if (mergeCursors[i] != (laneStatsMap.begin() + i)->second->laneAgents.end())
 			{
-				int chosenIdx = rand() % numElements;
-				chosenPair = equiDistantList[chosenIdx];
+				const Person_MT* currPerson = *mergeCursors[i];
+				double val = byDistance ? currPerson->distanceToEndOfSegment : currPerson->drivingTimeToEndOfLink;
+				if (val == minVal)
+				{
+					if (chosenIdx == 0)
+					{
+						mergedPersonList.push_back(*mergeCursors[i]);
+						mergeCursors[i]++;
+						break;
+					}
+					chosenIdx--;
+				}
 			}
-			iteratorLists.at(chosenPair.first)++;
-			mergedPersonList.push_back(chosenPair.second);
 		}
 	}
 
 	//After picking the Top C, just append the remaining vehicles in the output list
-	int i = 0;
-	for (LaneStatsMap::iterator lnIt = laneStatsMap.begin(); lnIt != laneStatsMap.end(); lnIt++)
+	for (size_t i = 0; i < numLanes; i++)
 	{
-		if(!lnIt->second->isLaneInfinity())
-		{
-			PersonList& personsInLane = lnIt->second->laneAgents;
-			if (iteratorLists[i] != personsInLane.end())
-			{
-				mergedPersonList.insert(mergedPersonList.end(), iteratorLists[i], personsInLane.end());
-			}
-			i++;
-		}
+		const PersonList& personsInLane = (laneStatsMap.begin() + i)->second->laneAgents;
+		mergedPersonList.insert(mergedPersonList.end(), mergeCursors[i], personsInLane.end());
 	}
 
 	//insert lane infinity persons at the tail of mergedPersonList
-	LaneStats* lnInfStats =  laneStatsMap[laneInfinity];
-	mergedPersonList.insert(mergedPersonList.end(), lnInfStats->laneAgents.begin(), lnInfStats->laneAgents.end());
+	const PersonList& lnInfAgents = (laneStatsMap.end() - 1)->second->laneAgents;
+	mergedPersonList.insert(mergedPersonList.end(), lnInfAgents.begin(), lnInfAgents.end());
 }
 
 std::pair<unsigned int, unsigned int> SegmentStats::getLaneAgentCounts(const Lane* lane) const
@@ -988,6 +961,36 @@ void SegmentStats::updateLaneInputCounter()
 	}
 }
 
+void SegmentStats::recordSegmentStats(ColumnarBuffer& buffer, uint32_t frameNumber)
+{
+	buffer << frameNumber << roadSegment->getRoadSegmentId() << statsNumberInSegment
+			<< speedDensityFunction((getTotalDensity(true)/METERS_IN_KM)) << segFlow << getTotalDensity(true)
+			<< (numPersons - numAgentsInLane(laneInfinity)) << getTotalVehicleLength() << numMovingInSegment(true)
+			<< getMovingLength() << numQueuingInSegment(true) << getQueueLength() << numVehicleLanes << length;
+	buffer.endRow();
+	resetEnergyStats();
+}
+
+std::vector<ColumnSchema> SegmentStats::getStatsColumns()
+{
+	std::vector<ColumnSchema> columns;
+	columns.push_back(ColumnSchema("interval", ColumnSchema::INTEGER));
+	columns.push_back(ColumnSchema("segment_id", ColumnSchema::INTEGER));
+	columns.push_back(ColumnSchema("stats_number", ColumnSchema::INTEGER));
+	columns.push_back(ColumnSchema("speed", ColumnSchema::REAL, 2));
+	columns.push_back(ColumnSchema("flow", ColumnSchema::INTEGER));
+	columns.push_back(ColumnSchema("density", ColumnSchema::REAL, 2));
+	columns.push_back(ColumnSchema("total", ColumnSchema::INTEGER));
+	columns.push_back(ColumnSchema("total_length", ColumnSchema::REAL, 2));
+	columns.push_back(ColumnSchema("moving", ColumnSchema::INTEGER));
+	columns.push_back(ColumnSchema("moving_length", ColumnSchema::REAL, 2));
+	columns.push_back(ColumnSchema("queuing", ColumnSchema::INTEGER));
+	columns.push_back(ColumnSchema("queue_length", ColumnSchema::REAL, 2));
+	columns.push_back(ColumnSchema("lanes", ColumnSchema::INTEGER));
+	columns.push_back(ColumnSchema("length", ColumnSchema::REAL, 2));
+	return columns;
+}
+
 std::string SegmentStats::reportSegmentStats(uint32_t frameNumber)
 {
 	if (ConfigManager::GetInstance().CMakeConfig().OutputEnabled())
@@ -1118,7 +1121,7 @@ void SegmentStats::setPositionOfLastUpdatedAgentInLane(double positionOfLastUpda
 	laneIt->second->setPositionOfLastUpdatedAgent(positionOfLastUpdatedAgentInLane);
 }
 
-std::map<const Lane*, LaneStats*> SegmentStats::getLaneStats() const
+const LaneStatsMap& SegmentStats::getLaneStats() const
 {
 	return laneStatsMap;
 }
@@ -1233,6 +1236,25 @@ void SegmentStats::registerBusStopAgents()
 	}
 }
 
+void SegmentStats::reRegisterStopAgents(void* newContext)
+{
+	for (BusStopAgentList::iterator stopIt = busStopAgents.begin(); stopIt != busStopAgents.end(); stopIt++)
+	{
+		if ((*stopIt)->GetContext())
+		{
+			messaging::MessageBus::ReRegisterHandler(*stopIt, newContext);
+		}
+	}
+
+	for (std::vector<TaxiStandAgent*>::iterator standIt = taxiStandAgents.begin(); standIt != taxiStandAgents.end(); standIt++)
+	{
+		if ((*standIt)->GetContext())
+		{
+			messaging::MessageBus::ReRegisterHandler(*standIt, newContext);
+		}
+	}
+}
+
 bool SegmentStats::isConnectedToDownstreamLink(const Link* downstreamLink, const Lane* lane) const
 {
 	if (!downstreamLink)
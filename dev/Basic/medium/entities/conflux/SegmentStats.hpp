@@ -4,8 +4,10 @@
 
 #pragma once
 #include <boost/thread/shared_mutex.hpp>
+#include <stdexcept>
 #include <string>
 #include <set>
+#include <utility>
 #include <vector>
 #include "entities/Person_MT.hpp"
 #include "geospatial/network/RoadSegment.hpp"
@@ -16,6 +18,8 @@
 
 namespace sim_mob
 {
+class ColumnarBuffer;
+struct ColumnSchema;
 
 namespace medium
 {
@@ -407,6 +411,99 @@ public:
 	LaneParams* laneParams;
 };
 
+/**
+ * Flat container of the LaneStats of a SegmentStats, keyed by lane.
+ * A segment has only a handful of lanes, so the entries are kept contiguously in lane order
+ * (lane infinity last) and looked up by a linear scan. This avoids the node allocations and
+ * pointer chasing of a std::map in the per-tick supply update, and gives a deterministic iteration order.
+ * The interface mirrors the subset of std::map used by the mid-term supply.
+ */
+class LaneStatsMap
+{
+public:
+	typedef std::pair<const Lane*, LaneStats*> value_type;
+	typedef std::vector<value_type>::iterator iterator;
+	typedef std::vector<value_type>::const_iterator const_iterator;
+
+	iterator begin()
+	{
+		return entries.begin();
+	}
+
+	iterator end()
+	{
+		return entries.end();
+	}
+
+	const_iterator begin() const
+	{
+		return entries.begin();
+	}
+
+	const_iterator end() const
+	{
+		return entries.end();
+	}
+
+	size_t size() const
+	{
+		return entries.size();
+	}
+
+	iterator find(const Lane* lane)
+	{
+		iterator it = entries.begin();
+		while (it != entries.end() && it->first != lane)
+		{
+			it++;
+		}
+		return it;
+	}
+
+	const_iterator find(const Lane* lane) const
+	{
+		const_iterator it = entries.begin();
+		while (it != entries.end() && it->first != lane)
+		{
+			it++;
+		}
+		return it;
+	}
+
+	/**
+	 * @param lane the lane to look up
+	 * @return the lane stats of lane
+	 * @throws std::out_of_range if lane is not in this container
+	 */
+	LaneStats* at(const Lane* lane) const
+	{
+		const_iterator it = find(lane);
+		if (it == entries.end())
+		{
+			throw std::out_of_range("LaneStatsMap::at lane not found");
+		}
+		return it->second;
+	}
+
+	/**
+	 * appends an entry, unless its lane is already present
+	 * @param entry lane and its lane stats
+	 * @return true if the entry was added
+	 */
+	bool insert(const value_type& entry)
+	{
+		if (find(entry.first) != entries.end())
+		{
+			return false;
+		}
+		entries.push_back(entry);
+		return true;
+	}
+
+private:
+	std::vector<value_type> entries;
+};
+
 /**
  * Keeps a lane wise count of moving and queuing vehicles in a road segment.
  * Keeps a map of LaneStats corresponding
@@ -421,7 +518,6 @@ protected:
 
 	//typedefs
 	typedef std::deque<Person_MT*> PersonList;
-	typedef std::map<const Lane*, LaneStats*> LaneStatsMap;
 	typedef std::vector<const BusStop*> BusStopList;
 	typedef std::vector<const TaxiStand*> TaxiStandList;
 	typedef std::vector<BusStopAgent*> BusStopAgentList;
@@ -464,6 +560,9 @@ protected:
 	 */
 	LaneStatsMap laneStatsMap;
 
+	/** read positions of each lane (excluding lane infinity) during topCMergeLanesInSegment; kept to avoid re-allocation */
+	std::vector<PersonList::const_iterator> mergeCursors;
+
 	/**taxiStandAgents for taxi-stand agents in this segment stats*/
 	std::vector<TaxiStandAgent*> taxiStandAgents;
 
@@ -712,9 +811,9 @@ public:
 	/**
 	 * merges the persons in segment in one list, thus forming the order in which
 	 * those persons need to be updated in this tick
-	 * @param mergedPersonList output list of persons to be populated
+	 * @param mergedPersonList output list to which the persons are appended
 	 */
-	void topCMergeLanesInSegment(PersonList& mergedPersonList);
+	void topCMergeLanesInSegment(std::vector<Person_MT*>& mergedPersonList);
 
 	/**
 	 * returns the queuing and moiving persons count in lane
@@ -892,6 +991,19 @@ public:
 	 */
 	std::string reportSegmentStats(uint32_t frameNumber);
 
+	/**
+	 * records the statistics of this segment stats as a row of the binary segment statistics;
+	 * the columns are those of reportSegmentStats()
+	 * @param buffer buffer of the segment statistics of the current thread
+	 * @param frameNumber the timeslice of current frame
+	 */
+	void recordSegmentStats(ColumnarBuffer& buffer, uint32_t frameNumber);
+
+	/**
+	 * @return the columns of the binary segment statistics
+	 */
+	static std::vector<ColumnSchema> getStatsColumns();
+
 	/**
 	 * computes the density of the moving part of the segment
 	 * the density value computed here is meant to be used in speed density function
@@ -919,6 +1031,12 @@ public:
 	 */
 	void registerBusStopAgents();
 
+	/**
+	 * re-registers the (already registered) bus stop and taxi-stand agents in this seg stats with a new message bus context
+	 * @param newContext the message bus context of the worker thread which now manages this seg stats
+	 */
+	void reRegisterStopAgents(void* newContext);
+
 	/**
 	 * checks whether lane stats for lane is connected (eventually) to the next down stream link
 	 * @param downstreamLink next down stream link
@@ -1000,7 +1118,7 @@ public:
 	 */
 	Lane* laneInfinity;
 
-	std::map<const Lane*, LaneStats*> getLaneStats() const ;
+	const LaneStatsMap& getLaneStats() const;
 };
 } // namespace medium
 } // namespace sim_mob
@@ -35,6 +35,7 @@
 #include "entities/BusStopAgent.hpp"
 #include "entities/TrainStationAgent.hpp"
 #include "entities/ClosedLoopRunManager.hpp"
+#include "entities/conflux/ConfluxRebalancer.hpp"
 #include "entities/MT_PersonLoader.hpp"
 #include "entities/profile/ProfileBuilder.hpp"
 #include "entities/PT_Statistics.hpp"
@@ -359,6 +360,11 @@ bool performMainSupply(const std::string& configFileName, std::list<std::string>
 
 	//distribute confluxes among workers
 	assignConfluxToWorkers(personWorkers);
+	if (config.defaultWrkGrpAssignment() == WorkGroup::ASSIGN_TIMEBASED)
+	{
+		//periodically re-distribute the confluxes based on their measured update times
+		personWorkers->setRebalancer(new ConfluxRebalancer());
+	}
 
 	//distribute station agents among confluxes
 	
@@ -408,6 +414,9 @@ bool performMainSupply(const std::string& configFileName, std::list<std::string>
 	        << config.getDatabaseProcMappings().procedureMappings["day_activity_schedule"] << std::endl;
 	Print() << "\nSimulating...\n";
 
+	//The binary segment and link statistics (if enabled) are recorded by the workers from the first tick
+	Conflux::openStatsOutput();
+
 	//Start work groups and all threads.
 	wgMgr.startAllWorkGroups();
 
@@ -424,6 +433,7 @@ bool performMainSupply(const std::string& configFileName, std::list<std::string>
 	StateSwitcher<int> numTicksShown(0); //Only goes up to 10
 	StateSwitcher<int> lastTickPercent(0); //So we have some idea how much time is left.
 	bool firstTick = true;
+	const unsigned int ttIntervalMS = TravelTimeManager::getInstance()->intervalMS;
 
 	for (unsigned int currTick = 0; currTick < config.totalRuntimeTicks; currTick++)
 	{
@@ -485,6 +495,13 @@ bool performMainSupply(const std::string& configFileName, std::list<std::string>
 			SurveillanceStation::writeSurveillanceOutput(config, currTimeMS + config.baseGranMS());
 			ClosedLoopRunManager::waitForDynaMIT(config);
 		}
+
+		//Publish the in-simulation travel times of the interval that ended, for path evaluation
+		//(the travel time intervals are aligned to the time of day, not to the start of the simulation)
+		if (ttIntervalMS > 0 && (config.simStartTime().getValue() + currTimeMS + config.baseGranMS()) % ttIntervalMS == 0)
+		{
+			TravelTimeManager::getInstance()->publishTravelTimeTable();
+		}
 	}
 
 	timeval loop_end_time;
@@ -638,6 +655,8 @@ bool performMainSupply(const std::string& configFileName, std::list<std::string>
 
 	}  //End scope: WorkGroups.
 
+	Conflux::closeStatsOutput();
+
     //Save screen line counts
     if(screenLnCtr)
     {
@@ -729,6 +748,8 @@ bool performMainDemand()
 	predayManager.loadCosts();
 	predayManager.loadPersonIds();
 	predayManager.loadUnavailableODs();
+	predayManager.loadTravelTimeMatrix();
+	predayManager.loadTourModeDestinationLogsumModels();
 
 	/// The seed for RNG's in lua is set before any choice is made for any of the preday models
 	ConfigManager& cfg = ConfigManager::GetInstanceRW();
@@ -773,6 +794,8 @@ bool performPredayFullLoop(const std::string& configFileName, std::list<std::str
 	predayManager.loadCosts();
 	predayManager.loadPersonIds();
 	predayManager.loadUnavailableODs();
+	predayManager.loadTravelTimeMatrix();
+	predayManager.loadTourModeDestinationLogsumModels();
 
 
 	Print() << "LogSum computation: Started\n";
@@ -807,6 +830,8 @@ bool performMidFullLoop(const std::string& configFileName, std::list<std::string
 	predayManager.loadCosts();
 	predayManager.loadPersonIds();
 	predayManager.loadUnavailableODs();
+	predayManager.loadTravelTimeMatrix();
+	predayManager.loadTourModeDestinationLogsumModels();
 
 
 	Print() << "LogSum computation: Started\n";
@@ -0,0 +1,143 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <stdint.h>
+#include <vector>
+
+#include "entities/conflux/ConfluxRebalancer.hpp"
+
+#include "ConfluxRebalancerUnitTests.hpp"
+
+using namespace sim_mob::medium;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::ConfluxRebalancerUnitTests);
+
+namespace
+{
+
+const unsigned int GRID_SIZE = 16;
+
+const unsigned int NUM_PARTITIONS = 4;
+
+const double TOLERANCE = 0.05;
+
+///Builds a GRID_SIZE x GRID_SIZE grid graph; vertex (row, column) is row * GRID_SIZE + column
+ConfluxRebalancer::Graph makeGrid()
+{
+    ConfluxRebalancer::Graph graph(GRID_SIZE * GRID_SIZE);
+    for (unsigned int row = 0; row < GRID_SIZE; row++)
+    {
+        for (unsigned int column = 0; column < GRID_SIZE; column++)
+        {
+            size_t vertex = row * GRID_SIZE + column;
+            if (column + 1 < GRID_SIZE)
+            {
+                graph[vertex].push_back(vertex + 1);
+                graph[vertex + 1].push_back(vertex);
+            }
+            if (row + 1 < GRID_SIZE)
+            {
+                graph[vertex].push_back(vertex + GRID_SIZE);
+                graph[vertex + GRID_SIZE].push_back(vertex);
+            }
+        }
+    }
+    return graph;
+}
+
+///Assigns the columns of the grid to the partitions; columnPartition holds the partition of each column
+std::vector<unsigned int> assignColumns(const unsigned int* columnPartition)
+{
+    std::vector<unsigned int> assignment(GRID_SIZE * GRID_SIZE);
+    for (size_t vertex = 0; vertex < assignment.size(); vertex++)
+    {
+        assignment[vertex] = columnPartition[vertex % GRID_SIZE];
+    }
+    return assignment;
+}
+
+///Fails unless no partition is heavier than the tolerance allows
+void checkBalance(const std::vector<uint64_t>& weights, const std::vector<unsigned int>& assignment)
+{
+    std::vector<uint64_t> loads(NUM_PARTITIONS, 0);
+    uint64_t totalLoad = 0;
+    for (size_t vertex = 0; vertex < assignment.size(); vertex++)
+    {
+        CPPUNIT_ASSERT(assignment[vertex] < NUM_PARTITIONS);
+        loads[assignment[vertex]] += weights[vertex];
+        totalLoad += weights[vertex];
+    }
+    for (unsigned int part = 0; part < NUM_PARTITIONS; part++)
+    {
+        CPPUNIT_ASSERT(loads[part] <= (double) totalLoad / NUM_PARTITIONS * (1.0 + TOLERANCE));
+    }
+}
+
+size_t countChanged(const std::vector<unsigned int>& before, const std::vector<unsigned int>& after)
+{
+    size_t numChanged = 0;
+    for (size_t vertex = 0; vertex < before.size(); vertex++)
+    {
+        if (before[vertex] != after[vertex])
+        {
+            numChanged++;
+        }
+    }
+    return numChanged;
+}
+
+}
+
+void unit_tests::ConfluxRebalancerUnitTests::test_BalancesGrid()
+{
+    //partition 0 holds ten of the sixteen columns
+    const unsigned int columns[GRID_SIZE] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 3, 3 };
+    const ConfluxRebalancer::Graph graph = makeGrid();
+    const std::vector<uint64_t> weights(graph.size(), 10);
+    const std::vector<unsigned int> initial = assignColumns(columns);
+
+    std::vector<unsigned int> assignment(initial);
+    size_t numChanged = ConfluxRebalancer::partition(graph, weights, NUM_PARTITIONS, TOLERANCE, assignment);
+
+    checkBalance(weights, assignment);
+    CPPUNIT_ASSERT(numChanged > 0);
+    CPPUNIT_ASSERT_EQUAL(countChanged(initial, assignment), numChanged);
+}
+
+void unit_tests::ConfluxRebalancerUnitTests::test_KeepsBalancedPartition()
+{
+    //four adjacent columns per partition
+    const unsigned int columns[GRID_SIZE] = { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3 };
+    const ConfluxRebalancer::Graph graph = makeGrid();
+    const std::vector<uint64_t> weights(graph.size(), 10);
+    const std::vector<unsigned int> initial = assignColumns(columns);
+
+    std::vector<unsigned int> assignment(initial);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), ConfluxRebalancer::partition(graph, weights, NUM_PARTITIONS, TOLERANCE, assignment));
+    CPPUNIT_ASSERT(assignment == initial);
+}
+
+void unit_tests::ConfluxRebalancerUnitTests::test_Deterministic()
+{
+    //uneven weights, with the heavy vertices crowded into partitions 0 and 1
+    const unsigned int columns[GRID_SIZE] = { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3 };
+    const ConfluxRebalancer::Graph graph = makeGrid();
+    std::vector<uint64_t> weights(graph.size());
+    for (size_t vertex = 0; vertex < weights.size(); vertex++)
+    {
+        weights[vertex] = (vertex % GRID_SIZE < GRID_SIZE / 2) ? 20 + (vertex * 7) % 13 : 1 + (vertex * 5) % 3;
+    }
+    const std::vector<unsigned int> initial = assignColumns(columns);
+
+    std::vector<unsigned int> first(initial);
+    size_t numChangedFirst = ConfluxRebalancer::partition(graph, weights, NUM_PARTITIONS, TOLERANCE, first);
+    checkBalance(weights, first);
+
+    for (int run = 0; run < 3; run++)
+    {
+        std::vector<unsigned int> repeated(initial);
+        CPPUNIT_ASSERT_EQUAL(numChangedFirst, ConfluxRebalancer::partition(graph, weights, NUM_PARTITIONS, TOLERANCE, repeated));
+        CPPUNIT_ASSERT(repeated == first);
+    }
+}
@@ -0,0 +1,36 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the partitioning of the conflux graph among the workers.
+ */
+class ConfluxRebalancerUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that an unbalanced partition of a grid is balanced within the tolerance, and that only the moved vertices are counted.
+    void test_BalancesGrid();
+
+    ///Test that a partition which is balanced and cuts few edges is left unchanged.
+    void test_KeepsBalancedPartition();
+
+    ///Test that the same input always gives the same partition.
+    void test_Deterministic();
+
+private:
+    CPPUNIT_TEST_SUITE(ConfluxRebalancerUnitTests);
+        CPPUNIT_TEST(test_BalancesGrid);
+        CPPUNIT_TEST(test_KeepsBalancedPartition);
+        CPPUNIT_TEST(test_Deterministic);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
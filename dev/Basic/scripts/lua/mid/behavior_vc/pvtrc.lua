@@ -22,6 +22,23 @@ local beta_minDistanceParam = 0.08777962943862566
 local beta_minSignalParam = 0.020236935452274854
 local beta_maxHighwayParam = 0.125971989288778
 
+--coefficients of the utility function below, for the evaluation of the model in C++
+--(see <route_choice evaluation=""/> in the pathset configuration)
+pvtrc_coefficients = {
+	travel_time = beta_bTTVOT,
+	travel_cost = beta_bCost,
+	common_factor = beta_bCommonFactor,
+	length = beta_bLength,
+	highway_distance = beta_bHighway,
+	highway_bias = beta_highwayBias,
+	signal_number = beta_bSigInter,
+	right_turn_number = beta_bLeftTurns,
+	min_distance = beta_minDistanceParam,
+	min_signal = beta_minSignalParam,
+	max_highway_usage = beta_maxHighwayParam,
+	work = beta_bWork,
+	leisure = beta_bLeisure
+}
 
 --utility
 --utility[i] for choice[i]
@@ -0,0 +1,107 @@
+# Converts the binary columnar statistics of the mid-term (e.g. segment_stats.bin, link_stats.bin; see
+# shared/logging/ColumnarOutput.hpp for the file layout) to csv, in the format of the text output:
+# one line per row, starting with the table name ("seg" or "lnk").
+#
+# usage: python columnar_to_csv.py segment_stats.bin segment_stats.csv
+import argparse
+import struct
+import sys
+
+MAGIC = b"SMCOLS1\n"
+INTEGER = 0
+FULL_PRECISION = 255
+
+
+def readVarint(data, pos):
+	value = 0
+	shift = 0
+	while True:
+		if pos >= len(data):
+			raise ValueError("truncated file")
+		byte = ord(data[pos:pos + 1])
+		pos += 1
+		value |= (byte & 0x7F) << shift
+		if byte & 0x80 == 0:
+			return value, pos
+		shift += 7
+
+
+def readString(data, pos):
+	length, pos = readVarint(data, pos)
+	return data[pos:pos + length], pos + length
+
+
+def decodeIntegers(data, numRows):
+	values = []
+	previous = 0
+	pos = 0
+	for _ in range(numRows):
+		zigzag, pos = readVarint(data, pos)
+		delta = (zigzag >> 1) ^ -(zigzag & 1)
+		previous = (previous + delta) & 0xFFFFFFFFFFFFFFFF
+		values.append(previous - (1 << 64) if previous >= (1 << 63) else previous)
+	return values
+
+
+def decodeReals(data, numRows):
+	values = []
+	previous = 0
+	pos = 0
+	for _ in range(numRows):
+		numBytes = 8 - ord(data[pos:pos + 1])
+		xored = 0
+		for byte in bytearray(data[pos + 1:pos + 1 + numBytes]):
+			xored = (xored << 8) | byte
+		pos += 1 + numBytes
+		previous ^= xored
+		values.append(struct.unpack("<d", struct.pack("<Q", previous))[0])
+	return values
+
+
+def formatValue(value, columnType, precision):
+	if columnType == INTEGER:
+		return str(value)
+	if precision == FULL_PRECISION:
+		return "%.17g" % value
+	return "%.*f" % (precision, value)
+
+
+def convert(inputFile, outputFile):
+	data = inputFile.read()
+	if data[:len(MAGIC)] != MAGIC:
+		raise ValueError("not a columnar output file")
+	tableName, pos = readString(data, len(MAGIC))
+	tableName = tableName.decode("utf-8")
+	numColumns, pos = readVarint(data, pos)
+	columns = []
+	for _ in range(numColumns):
+		columnType, precision = bytearray(data[pos:pos + 2])
+		name, pos = readString(data, pos + 2)
+		columns.append((columnType, precision))
+
+	while pos < len(data):
+		numRows, pos = readVarint(data, pos)
+		values = []
+		for columnType, precision in columns:
+			column, pos = readString(data, pos)
+			if columnType == INTEGER:
+				values.append(decodeIntegers(column, numRows))
+			else:
+				values.append(decodeReals(column, numRows))
+		for row in range(numRows):
+			fields = [formatValue(values[i][row], columns[i][0], columns[i][1]) for i in range(numColumns)]
+			outputFile.write(tableName + "," + ",".join(fields) + "\n")
+
+
+if __name__ == "__main__":
+	parser = argparse.ArgumentParser(description="Converts binary columnar statistics to csv")
+	parser.add_argument("input", help="binary statistics file")
+	parser.add_argument("output", nargs="?", help="csv file; standard output if omitted")
+	args = parser.parse_args()
+
+	with open(args.input, "rb") as inputFile:
+		if args.output:
+			with open(args.output, "w") as outputFile:
+				convert(inputFile, outputFile)
+		else:
+			convert(inputFile, sys.stdout)
@@ -0,0 +1,271 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "TimeDependentTT_Matrix.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace sim_mob;
+
+namespace
+{
+const char FILE_MAGIC[8] = { 'S', 'M', 'T', 'D', 'T', 'T', 'M', 'X' };
+const uint32_t FILE_VERSION = 1;
+
+/** header at the start of the storage block (and of the cache file) */
+struct MatrixHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t numZones;
+    uint32_t numTimeWindows;
+    uint32_t reserved;
+    uint64_t sourceFingerprint;
+};
+
+/** rounds up to a multiple of the alignment of double */
+std::size_t alignToDouble(std::size_t size)
+{
+    return (size + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+}
+
+std::size_t getZoneCodesOffset()
+{
+    return sizeof(MatrixHeader);
+}
+
+std::size_t getTravelTimesOffset(uint32_t nZones)
+{
+    return alignToDouble(getZoneCodesOffset() + nZones * sizeof(int32_t));
+}
+}
+
+TimeDependentTT_Matrix::TimeDependentTT_Matrix() : numZones(0), mappedSize(0), storage(nullptr), storageSize(0)
+{
+    bindArrays(nullptr);
+}
+
+TimeDependentTT_Matrix::~TimeDependentTT_Matrix()
+{
+    clear();
+}
+
+uint32_t TimeDependentTT_Matrix::setZones(const std::vector<int>& zoneCodes, std::vector<int>& sortedCodes)
+{
+    sortedCodes = zoneCodes;
+    std::sort(sortedCodes.begin(), sortedCodes.end());
+    sortedCodes.erase(std::unique(sortedCodes.begin(), sortedCodes.end()), sortedCodes.end());
+    if (!sortedCodes.empty() && sortedCodes.front() < 0)
+    {
+        throw std::runtime_error("TimeDependentTT_Matrix: zone codes must not be negative");
+    }
+
+    zoneIndexByCode.assign(sortedCodes.empty() ? 0 : sortedCodes.back() + 1, -1);
+    for (std::size_t i = 0; i < sortedCodes.size(); i++)
+    {
+        zoneIndexByCode[sortedCodes[i]] = i;
+    }
+    return sortedCodes.size();
+}
+
+std::size_t TimeDependentTT_Matrix::computeStorageSize(uint32_t nZones)
+{
+    const std::size_t numODs = (std::size_t) nZones * nZones;
+    return getTravelTimesOffset(nZones)
+            + NUM_TT_MODES * 2 * numODs * NUM_30MIN_TIME_WINDOWS_IN_DAY * sizeof(double)
+            + NUM_TT_MODES * numODs * sizeof(uint8_t);
+}
+
+void TimeDependentTT_Matrix::bindArrays(char* base)
+{
+    const std::size_t numODs = (std::size_t) numZones * numZones;
+    const std::size_t numTravelTimes = numODs * NUM_30MIN_TIME_WINDOWS_IN_DAY;
+    double* travelTimes = base ? reinterpret_cast<double*>(base + getTravelTimesOffset(numZones)) : nullptr;
+    uint8_t* odFlags = base ? reinterpret_cast<uint8_t*>(travelTimes + NUM_TT_MODES * 2 * numTravelTimes) : nullptr;
+    for (int mode = 0; mode < NUM_TT_MODES; mode++)
+    {
+        arrivalBasedTT[mode] = base ? travelTimes + (2 * mode) * numTravelTimes : nullptr;
+        departureBasedTT[mode] = base ? travelTimes + (2 * mode + 1) * numTravelTimes : nullptr;
+        flags[mode] = base ? odFlags + mode * numODs : nullptr;
+    }
+}
+
+void TimeDependentTT_Matrix::initialize(const std::vector<int>& zoneCodes, uint64_t sourceFingerprint)
+{
+    clear();
+    std::vector<int> sortedCodes;
+    numZones = setZones(zoneCodes, sortedCodes);
+
+    storageSize = computeStorageSize(numZones);
+    ownedStorage.assign(storageSize, 0);
+    storage = &ownedStorage[0];
+
+    MatrixHeader* header = reinterpret_cast<MatrixHeader*>(storage);
+    std::memcpy(header->magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header->version = FILE_VERSION;
+    header->numZones = numZones;
+    header->numTimeWindows = NUM_30MIN_TIME_WINDOWS_IN_DAY;
+    header->reserved = 0;
+    header->sourceFingerprint = sourceFingerprint;
+    std::copy(sortedCodes.begin(), sortedCodes.end(), reinterpret_cast<int32_t*>(storage + getZoneCodesOffset()));
+
+    bindArrays(storage);
+}
+
+void TimeDependentTT_Matrix::clear()
+{
+    if (isMapped())
+    {
+        munmap(storage, mappedSize);
+        mappedSize = 0;
+    }
+    std::vector<char>().swap(ownedStorage);
+    zoneIndexByCode.clear();
+    numZones = 0;
+    storage = nullptr;
+    storageSize = 0;
+    bindArrays(nullptr);
+}
+
+long TimeDependentTT_Matrix::getOD_Index(int originZn, int destZn) const
+{
+    if (originZn < 0 || destZn < 0 || originZn >= (int) zoneIndexByCode.size() || destZn >= (int) zoneIndexByCode.size())
+    {
+        return -1;
+    }
+    int originIdx = zoneIndexByCode[originZn];
+    int destIdx = zoneIndexByCode[destZn];
+    if (originIdx < 0 || destIdx < 0)
+    {
+        return -1;
+    }
+    return (long) originIdx * numZones + destIdx;
+}
+
+bool TimeDependentTT_Matrix::setTT(TravelTimeMode ttMode, const TimeDependentTT_Params& ttParams)
+{
+    if (isMapped())
+    {
+        throw std::runtime_error("TimeDependentTT_Matrix: cannot modify a memory-mapped matrix");
+    }
+    long odIdx = getOD_Index(ttParams.getOriginZone(), ttParams.getDestinationZone());
+    if (odIdx < 0)
+    {
+        return false;
+    }
+
+    const int mode = static_cast<int>(ttMode);
+    double* arrivalTT = arrivalBasedTT[mode] + odIdx * NUM_30MIN_TIME_WINDOWS_IN_DAY;
+    double* departureTT = departureBasedTT[mode] + odIdx * NUM_30MIN_TIME_WINDOWS_IN_DAY;
+    for (int i = 0; i < (int) NUM_30MIN_TIME_WINDOWS_IN_DAY; i++)
+    {
+        arrivalTT[i] = ttParams.getArrivalBasedTT_at(i);
+        departureTT[i] = ttParams.getDepartureBasedTT_at(i);
+    }
+    flags[mode][odIdx] = TT_AVAILABLE | (ttParams.isInfoUnavailable() ? TT_INFO_UNAVAILABLE : 0);
+    return true;
+}
+
+bool TimeDependentTT_Matrix::getTT_ByOD(TravelTimeMode ttMode, int originZn, int destZn, TimeDependentTT_Params& outObj) const
+{
+    long odIdx = getOD_Index(originZn, destZn);
+    const int mode = static_cast<int>(ttMode);
+    if (odIdx < 0 || !(flags[mode][odIdx] & TT_AVAILABLE))
+    {
+        return false;
+    }
+
+    outObj.setOriginZone(originZn);
+    outObj.setDestinationZone(destZn);
+    outObj.setInfoUnavailable(flags[mode][odIdx] & TT_INFO_UNAVAILABLE);
+    std::memcpy(outObj.getArrivalBasedTT(), arrivalBasedTT[mode] + odIdx * NUM_30MIN_TIME_WINDOWS_IN_DAY,
+            NUM_30MIN_TIME_WINDOWS_IN_DAY * sizeof(double));
+    std::memcpy(outObj.getDepartureBasedTT(), departureBasedTT[mode] + odIdx * NUM_30MIN_TIME_WINDOWS_IN_DAY,
+            NUM_30MIN_TIME_WINDOWS_IN_DAY * sizeof(double));
+    return true;
+}
+
+bool TimeDependentTT_Matrix::save(const std::string& fileName) const
+{
+    if (!isLoaded())
+    {
+        return false;
+    }
+
+    std::ofstream out(fileName.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        return false;
+    }
+    out.write(storage, storageSize);
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+bool TimeDependentTT_Matrix::load(const std::string& fileName, const std::vector<int>& zoneCodes, uint64_t sourceFingerprint)
+{
+    clear();
+
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t) sizeof(MatrixHeader))
+    {
+        close(fd);
+        return false;
+    }
+
+    const std::size_t fileSize = fileStat.st_size;
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); //the mapping remains valid
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    //validate the header, the size and the zones before accepting the mapping
+    std::vector<int> sortedCodes;
+    uint32_t nZones = setZones(zoneCodes, sortedCodes);
+    const char* base = static_cast<const char*>(mapping);
+    const MatrixHeader* header = reinterpret_cast<const MatrixHeader*>(base);
+    bool valid = std::memcmp(header->magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0 && header->version == FILE_VERSION
+            && header->numZones == nZones && header->numTimeWindows == NUM_30MIN_TIME_WINDOWS_IN_DAY
+            && header->sourceFingerprint == sourceFingerprint && fileSize == computeStorageSize(nZones)
+            && std::equal(sortedCodes.begin(), sortedCodes.end(), reinterpret_cast<const int32_t*>(base + getZoneCodesOffset()));
+    if (!valid)
+    {
+        munmap(mapping, fileSize);
+        zoneIndexByCode.clear();
+        return false;
+    }
+
+    numZones = nZones;
+    mappedSize = fileSize;
+    storage = static_cast<char*>(mapping);
+    storageSize = fileSize;
+    bindArrays(storage);
+    return true;
+}
+
+uint64_t TimeDependentTT_Matrix::computeFingerprint(const std::string& description)
+{
+    //FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (std::string::const_iterator it = description.begin(); it != description.end(); it++)
+    {
+        hash ^= (unsigned char) *it;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
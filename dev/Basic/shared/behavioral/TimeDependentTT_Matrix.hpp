@@ -0,0 +1,186 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <boost/utility.hpp>
+#include "behavioral/PredayUtils.hpp"
+#include "behavioral/params/ZoneCostParams.hpp"
+
+namespace sim_mob
+{
+
+/**
+ * Dense in-memory store of the time dependent zone to zone travel times of both travel time modes
+ * (private traffic and public transit).
+ *
+ * The travel times are kept as struct-of-arrays: for each mode, one array of arrival based and one array of
+ * departure based travel times, indexed by [origin zone index][destination zone index][half-hour window], and one
+ * array of per-OD flags. All arrays live in a single block of memory whose layout is identical to the layout of the
+ * binary cache file written by save(), so that load() can simply memory-map the file. Zone codes are translated to
+ * dense indices with a lookup table.
+ *
+ * The matrix is filled once (before the preday threads start) and is read-only afterwards; lookups take no locks.
+ * Note that the matrix holds 2 * 2 * 48 doubles for each OD pair, i.e. about 1.5KB per OD pair.
+ */
+class TimeDependentTT_Matrix : private boost::noncopyable
+{
+public:
+    TimeDependentTT_Matrix();
+    ~TimeDependentTT_Matrix();
+
+    /**
+     * Allocates storage for all OD pairs of the given zones.
+     * Travel times of OD pairs which are never set are 0 and such OD pairs are reported as unavailable by getTT_ByOD.
+     *
+     * @param zoneCodes codes of all zones
+     * @param sourceFingerprint identifies the data source (e.g. the travel time tables) the matrix is filled from
+     */
+    void initialize(const std::vector<int>& zoneCodes, uint64_t sourceFingerprint);
+
+    /**
+     * Stores travel times of one OD pair
+     *
+     * @param ttMode travel time mode of the travel times
+     * @param ttParams travel times to store
+     *
+     * @return true if the travel times were stored; false if the origin or destination zone is unknown
+     */
+    bool setTT(TravelTimeMode ttMode, const TimeDependentTT_Params& ttParams);
+
+    /**
+     * Fetches travel times of one OD pair. Has the same semantics as TimeDependentTT_SqlDao::getTT_ByOD.
+     *
+     * @param ttMode travel time mode
+     * @param originZn origin zone code
+     * @param destZn destination zone code
+     * @param outObj output object to fill
+     *
+     * @return true if travel times were set for the OD pair; false otherwise (outObj is left unchanged)
+     */
+    bool getTT_ByOD(TravelTimeMode ttMode, int originZn, int destZn, TimeDependentTT_Params& outObj) const;
+
+    /**
+     * Saves the matrix as a binary cache file
+     *
+     * @param fileName file to write
+     *
+     * @return true if the file was written
+     */
+    bool save(const std::string& fileName) const;
+
+    /**
+     * Memory-maps a cache file written by save()
+     *
+     * @param fileName file to map
+     * @param zoneCodes codes of all zones
+     * @param sourceFingerprint identifies the data source the matrix is expected to be filled from
+     *
+     * @return true if the file was mapped; false if the file does not exist, is corrupt, or was created for other zones
+     *          or another data source
+     */
+    bool load(const std::string& fileName, const std::vector<int>& zoneCodes, uint64_t sourceFingerprint);
+
+    /**
+     * Releases the storage
+     */
+    void clear();
+
+    /**
+     * @return true if the matrix is initialized or loaded
+     */
+    bool isLoaded() const
+    {
+        return storage != nullptr;
+    }
+
+    /**
+     * @return true if the storage is a memory-mapped cache file
+     */
+    bool isMapped() const
+    {
+        return mappedSize > 0;
+    }
+
+    std::size_t getNumZones() const
+    {
+        return numZones;
+    }
+
+    /**
+     * @return size of the storage in bytes
+     */
+    std::size_t getStorageSize() const
+    {
+        return storageSize;
+    }
+
+    /**
+     * Computes a fingerprint of a data source description; the description must change whenever the data does
+     * (e.g. fully qualified table names together with a version stamp of their contents)
+     *
+     * @param description description of the data source
+     *
+     * @return the fingerprint
+     */
+    static uint64_t computeFingerprint(const std::string& description);
+
+private:
+    /** number of travel time modes */
+    static const int NUM_TT_MODES = 2;
+
+    /** flag set for OD pairs whose travel times were set */
+    static const uint8_t TT_AVAILABLE = 1;
+
+    /** flag set for OD pairs marked info_unavailable */
+    static const uint8_t TT_INFO_UNAVAILABLE = 2;
+
+    /**
+     * sorts and de-duplicates zone codes and builds the code to index lookup table
+     * @return number of zones
+     */
+    uint32_t setZones(const std::vector<int>& zoneCodes, std::vector<int>& sortedCodes);
+
+    /** computes the size of the storage for the given number of zones */
+    static std::size_t computeStorageSize(uint32_t nZones);
+
+    /** sets the array pointers into the storage block */
+    void bindArrays(char* base);
+
+    /** @return the index of the OD pair; -1 if either zone is unknown */
+    long getOD_Index(int originZn, int destZn) const;
+
+    /** zone code -> dense zone index; -1 for codes of unknown zones */
+    std::vector<int> zoneIndexByCode;
+
+    /** number of zones */
+    uint32_t numZones;
+
+    /** storage owned by the matrix, when not mapped */
+    std::vector<char> ownedStorage;
+
+    /** size of the mapping, when mapped */
+    std::size_t mappedSize;
+
+    /** start of the storage block */
+    char* storage;
+
+    /** size of the storage block */
+    std::size_t storageSize;
+
+    /** arrival based travel times of each mode */
+    double* arrivalBasedTT[NUM_TT_MODES];
+
+    /** departure based travel times of each mode */
+    double* departureBasedTT[NUM_TT_MODES];
+
+    /** per-OD flags of each mode */
+    uint8_t* flags[NUM_TT_MODES];
+};
+
+}
@@ -0,0 +1,644 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "TourModeDestinationLogsumModel.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <set>
+#include "logging/Log.hpp"
+
+using namespace sim_mob;
+
+namespace
+{
+/** cost terms of the tour mode/destination utilities */
+enum CostTerm
+{
+    COST_NONE, COST_PUBLIC, COST_DRIVE1, COST_SHARE2, COST_SHARE3, COST_MOTOR, COST_TAXI, COST_SMS, COST_SMS_POOL,
+    COST_RAIL_SMS, COST_RAIL_SMS_POOL
+};
+
+/** travel time terms of the tour mode/destination utilities */
+enum TravelTimeTerm
+{
+    TT_PUBLIC, TT_CAR, TT_CAR_WITH_WAIT, TT_WALK, TT_RAIL_SMS, TT_SMS_POOL, TT_RAIL_SMS_POOL
+};
+
+/** size (attraction) terms of the tour mode/destination utilities */
+enum SizeTerm
+{
+    SIZE_WITH_SHOP, SIZE_WITH_SHOP_PLUS_ONE, SIZE_WITHOUT_SHOP, NUM_SIZE_TERMS
+};
+
+/** factor applied to the cost over income term */
+enum IncomeMask
+{
+    ONE_MINUS_MISSING_INCOME, MINUS_MISSING_INCOME
+};
+
+/** names of the coefficients of a mode, in the order of ModeCoefficients; nullptr for unused terms */
+enum CoefficientIndex
+{
+    CONSTANT, COST_OVER_INCOME, COST, TRAVEL_TIME, CENTRAL, DISTANCE, FEMALE, ZERO_CAR, ONE_PLUS_CAR, TWO_PLUS_CAR,
+    THREE_PLUS_CAR, ZERO_MOTOR, ONE_PLUS_MOTOR, TWO_PLUS_MOTOR, THREE_PLUS_MOTOR, NUM_COEFFICIENTS
+};
+
+struct ModeForm
+{
+    CostTerm cost;
+    TravelTimeTerm travelTime;
+    SizeTerm size;
+    IncomeMask incomeMask;
+    const char* coefficients[NUM_COEFFICIENTS];
+};
+
+struct ModelForm
+{
+    const char* name;
+    double incomeMidpoints[14];
+    double rideHailFareFactor;
+    ModeForm modes[TourModeDestinationLogsumModel::NUM_MODES];
+};
+
+/**
+ * Functional forms of the supported scripts. Modes are in the order of the scripts: public bus, MRT/LRT,
+ * private bus, drive1, shared2, shared3+, motor, walk, taxi, SMS, Rail_SMS, SMS_Pool, Rail_SMS_Pool.
+ */
+const ModelForm MODEL_FORMS[] =
+{
+    {
+        "tmds",
+        { 500, 1250, 1750, 2250, 2750, 3500, 4500, 5500, 6500, 7500, 8500, 0, 99999, 99999 },
+        0.72,
+        {
+            { COST_PUBLIC, TT_PUBLIC, SIZE_WITH_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_bus", "beta_cost_bus_mrt_1", "beta_cost_bus_mrt_2", "beta_tt_bus_mrt", "beta_central_bus_mrt",
+                "beta_distance_bus_mrt", "beta_female_bus", "beta_zero_bus", "beta_oneplus_bus", "beta_twoplus_bus" } },
+            { COST_PUBLIC, TT_PUBLIC, SIZE_WITH_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_mrt", "beta_cost_bus_mrt_1", "beta_cost_bus_mrt_2", "beta_tt_bus_mrt", "beta_central_bus_mrt",
+                "beta_distance_bus_mrt", "beta_female_mrt", "beta_zero_mrt", "beta_oneplus_mrt", "beta_twoplus_mrt" } },
+            { COST_PUBLIC, TT_CAR, SIZE_WITH_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_private_bus", "beta_cost_private_bus_2", "beta_cost_private_bus_2", "beta_tt_bus_mrt",
+                "beta_central_private_bus", "beta_distance_private_bus", "beta_female_private_bus", "beta_zero_privatebus",
+                "beta_oneplus_privatebus", "beta_twoplus_privatebus" } },
+            { COST_DRIVE1, TT_CAR_WITH_WAIT, SIZE_WITH_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_drive1", "beta_cost_drive1_1", "beta_cost_drive1_2", "beta_tt_drive1", "beta_central_drive1",
+                "beta_distance_drive1", "beta_female_drive1", "beta_zero_drive1", "beta_oneplus_drive1",
+                "beta_twoplus_drive1", "beta_threeplus_drive1" } },
+            { COST_SHARE2, TT_CAR_WITH_WAIT, SIZE_WITH_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_share2", "beta_cost_share2_1", "beta_cost_share2_2", "beta_tt_share2", "beta_central_share2",
+                "beta_distance_share2", "beta_female_share2", "beta_zero_share2", "beta_oneplus_share2",
+                "beta_twoplus_share2", "beta_threeplus_share2" } },
+            { COST_SHARE3, TT_CAR_WITH_WAIT, SIZE_WITH_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_share3", "beta_cost_share3_1", "beta_cost_share2_2", "beta_tt_share3", "beta_central_share3",
+                "beta_distance_share3", "beta_female_share3", "beta_zero_share3", "beta_oneplus_share3",
+                "beta_twoplus_share3", "beta_threeplus_share3" } },
+            { COST_MOTOR, TT_CAR_WITH_WAIT, SIZE_WITH_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_motor", "beta_cost_motor_1", "beta_cost_motor_2", "beta_tt_drive1", "beta_central_motor",
+                "beta_distance_motor", "beta_female_motor", "beta_zero_car_motor", "beta_oneplus_car_motor",
+                "beta_twoplus_car_motor", nullptr, "beta_zero_motor", "beta_oneplus_motor", "beta_twoplus_motor",
+                "beta_threeplus_motor" } },
+            { COST_NONE, TT_WALK, SIZE_WITH_SHOP_PLUS_ONE, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_walk", nullptr, nullptr, "beta_tt_walk", "beta_central_walk", "beta_distance_walk",
+                "beta_female_walk", "beta_zero_walk", "beta_oneplus_walk", "beta_twoplus_walk" } },
+            { COST_TAXI, TT_CAR_WITH_WAIT, SIZE_WITH_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_taxi", "beta_cost_taxi_1", "beta_cost_taxi_2", "beta_tt_taxi", "beta_central_taxi",
+                "beta_distance_taxi", "beta_female_taxi", "beta_zero_taxi", "beta_oneplus_taxi", "beta_twoplus_taxi" } },
+            { COST_SMS, TT_CAR_WITH_WAIT, SIZE_WITHOUT_SHOP, MINUS_MISSING_INCOME,
+              { "beta_cons_SMS", "beta_cost_SMS_1", "beta_cost_bus_mrt_2", "beta_tt_SMS", "beta_central_SMS",
+                "beta_distance_SMS", "beta_female_SMS", "beta_zero_SMS", "beta_oneplus_SMS", "beta_twoplus_SMS" } },
+            { COST_RAIL_SMS, TT_RAIL_SMS, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_Rail_SMS", "beta_cost_Rail_SMS_1", "beta_cost_Rail_SMS_2", "beta_tt_Rail_SMS",
+                "beta_central_Rail_SMS", "beta_distance_Rail_SMS", "beta_female_Rail_SMS", "beta_zero_Rail_SMS",
+                "beta_oneplus_Rail_SMS", "beta_twoplus_Rail_SMS" } },
+            { COST_SMS_POOL, TT_SMS_POOL, SIZE_WITHOUT_SHOP, MINUS_MISSING_INCOME,
+              { "beta_cons_SMS_Pool", "beta_cost_SMS_Pool_1", "beta_cost_bus_mrt_2", "beta_tt_SMS_Pool",
+                "beta_central_SMS_Pool", "beta_distance_SMS_Pool", "beta_female_SMS_Pool", "beta_zero_SMS_Pool",
+                "beta_oneplus_SMS_Pool", "beta_twoplus_SMS_Pool" } },
+            { COST_RAIL_SMS_POOL, TT_RAIL_SMS_POOL, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_Rail_SMS_Pool", "beta_cost_Rail_SMS_Pool_1", "beta_cost_Rail_SMS_Pool_2",
+                "beta_tt_Rail_SMS_Pool", "beta_central_Rail_SMS_Pool", "beta_distance_Rail_SMS_Pool",
+                "beta_female_Rail_SMS_Pool", "beta_zero_Rail_SMS_Pool", "beta_oneplus_Rail_SMS_Pool",
+                "beta_twoplus_Rail_SMS_Pool" } }
+        }
+    },
+    {
+        "tmdo",
+        { 500.5, 1250, 1749.5, 2249.5, 2749.5, 3499.5, 4499.5, 5499.5, 6499.5, 7499.5, 8500, 0, 99999, 99999 },
+        0.6,
+        {
+            { COST_PUBLIC, TT_PUBLIC, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_bus", "beta_cost_bus_mrt_1", "beta_cost_bus_mrt_2", "beta_tt_bus_mrt", "beta_central_bus_mrt",
+                "beta_distance_bus_mrt", "beta_female_bus", "beta_zero_bus", "beta_oneplus_bus", "beta_twoplus_bus" } },
+            { COST_PUBLIC, TT_PUBLIC, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_mrt", "beta_cost_bus_mrt_1", "beta_cost_bus_mrt_2", "beta_tt_bus_mrt", "beta_central_bus_mrt",
+                "beta_distance_bus_mrt", "beta_female_mrt", "beta_zero_mrt", "beta_oneplus_mrt", "beta_twoplus_mrt" } },
+            { COST_PUBLIC, TT_CAR, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_private_bus", "beta_cost_private_bus_1", "beta_cost_bus_mrt_2", "beta_tt_private_bus",
+                "beta_central_private_bus", "beta_distance_private_bus", "beta_female_private_bus", "beta_zero_privatebus",
+                "beta_oneplus_privatebus", "beta_twoplus_privatebus" } },
+            { COST_DRIVE1, TT_CAR_WITH_WAIT, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_drive1", "beta_cost_drive1_1", "beta_cost_bus_mrt_2", "beta_tt_drive1", "beta_central_drive1",
+                "beta_distance_drive1", "beta_female_drive1", "beta_zero_drive1", "beta_oneplus_drive1",
+                "beta_twoplus_drive1", "beta_threeplus_drive1" } },
+            { COST_SHARE2, TT_CAR_WITH_WAIT, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_share2", "beta_cost_share2_1", "beta_cost_bus_mrt_2", "beta_tt_share2", "beta_central_share2",
+                "beta_distance_share2", "beta_female_share2", "beta_zero_share2", "beta_oneplus_share2",
+                "beta_twoplus_share2", "beta_threeplus_share2" } },
+            { COST_SHARE3, TT_CAR_WITH_WAIT, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_share3", "beta_cost_share3_1", "beta_cost_bus_mrt_2", "beta_tt_share3", "beta_central_share3",
+                "beta_distance_share3", "beta_female_share3", "beta_zero_share3", "beta_oneplus_share3",
+                "beta_twoplus_share3", "beta_threeplus_share3" } },
+            { COST_MOTOR, TT_CAR_WITH_WAIT, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_motor", "beta_cost_motor_1", "beta_cost_bus_mrt_2", "beta_tt_motor", "beta_central_motor",
+                "beta_distance_motor", "beta_female_motor", "beta_zero_car_motor", "beta_oneplus_car_motor",
+                "beta_twoplus_car_motor", nullptr, "beta_zero_motor", "beta_oneplus_motor", "beta_twoplus_motor",
+                "beta_threeplus_motor" } },
+            { COST_NONE, TT_WALK, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_walk", nullptr, nullptr, "beta_tt_walk", "beta_central_walk", "beta_distance_walk",
+                "beta_female_walk", "beta_zero_walk", "beta_oneplus_walk", "beta_twoplus_walk" } },
+            { COST_TAXI, TT_CAR_WITH_WAIT, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_taxi", "beta_cost_taxi_1", "beta_cost_bus_mrt_2", "beta_tt_taxi", "beta_central_taxi",
+                "beta_distance_taxi", "beta_female_taxi", "beta_zero_taxi", "beta_oneplus_taxi", "beta_twoplus_taxi" } },
+            { COST_SMS, TT_CAR_WITH_WAIT, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_SMS", "beta_cost_SMS_1", "beta_cost_SMS_2", "beta_tt_SMS", "beta_central_SMS",
+                "beta_distance_SMS", "beta_female_SMS", "beta_zero_SMS", "beta_oneplus_SMS", "beta_twoplus_SMS" } },
+            { COST_RAIL_SMS, TT_RAIL_SMS, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_Rail_SMS", "beta_cost_Rail_SMS_1", "beta_cost_Rail_SMS_2", "beta_tt_Rail_SMS",
+                "beta_central_Rail_SMS", "beta_distance_Rail_SMS", "beta_female_Rail_SMS", "beta_zero_Rail_SMS",
+                "beta_oneplus_Rail_SMS", "beta_twoplus_Rail_SMS" } },
+            { COST_SMS_POOL, TT_CAR_WITH_WAIT, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_SMS_Pool", "beta_cost_SMS_Pool_1", "beta_cost_SMS_Pool_2", "beta_tt_SMS_Pool",
+                "beta_central_SMS_Pool", "beta_distance_SMS_Pool", "beta_female_SMS_Pool", "beta_zero_SMS_Pool",
+                "beta_oneplus_SMS_Pool", "beta_twoplus_SMS_Pool" } },
+            { COST_RAIL_SMS_POOL, TT_RAIL_SMS_POOL, SIZE_WITHOUT_SHOP, ONE_MINUS_MISSING_INCOME,
+              { "beta_cons_Rail_SMS_Pool", "beta_cost_Rail_SMS_Pool_1", "beta_cost_Rail_SMS_Pool_2",
+                "beta_tt_Rail_SMS_Pool", "beta_central_Rail_SMS_Pool", "beta_distance_Rail_SMS_Pool",
+                "beta_female_Rail_SMS_Pool", "beta_zero_Rail_SMS_Pool", "beta_oneplus_Rail_SMS_Pool",
+                "beta_twoplus_Rail_SMS_Pool" } }
+        }
+    }
+};
+
+const int NUM_MODEL_FORMS = sizeof(MODEL_FORMS) / sizeof(MODEL_FORMS[0]);
+
+/** access/egress distance of the rail + SMS modes */
+const double ACCESS_EGRESS_DISTANCE = 2.0;
+
+/** pooled SMS fare as a fraction of the SMS fare */
+const double POOL_FARE_FACTOR = 0.7;
+
+int findModelForm(const std::string& modelName)
+{
+    for (int i = 0; i < NUM_MODEL_FORMS; i++)
+    {
+        if (modelName == MODEL_FORMS[i].name)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * taxi fare for a distance, excluding ERP and the central surcharge.
+ * Written exactly as in the scripts, i.e. branch-free and with the same NaN behaviour.
+ */
+inline double getTaxiFare(double distance)
+{
+    const double over = (distance > 10) ? 1 : 0;
+    return 3.4 + ((distance * over - 10 * over) / 0.35 + (distance * (1 - over) + 10 * over) / 0.4) * 0.22;
+}
+
+/** coefficients of the size terms, common to all modes */
+const char* const SIZE_COEFFICIENTS[] = { "beta_log", "beta_area", "beta_population" };
+
+/**
+ * looks up a coefficient; unused terms (name is nullptr) have coefficient 0
+ * @return true if found; false if the coefficient is missing (its name is appended to missingNames)
+ */
+bool lookupCoefficient(const std::map<std::string, double>& coefficients, const char* name, double& value,
+        std::string& missingNames)
+{
+    if (!name)
+    {
+        value = 0;
+        return true;
+    }
+    std::map<std::string, double>::const_iterator it = coefficients.find(name);
+    if (it == coefficients.end())
+    {
+        missingNames += (missingNames.empty() ? "" : ", ") + std::string(name);
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+}
+
+TourModeDestinationInputs::TourModeDestinationInputs() : costIncrease(0), numZones(0), numModes(0)
+{
+}
+
+void TourModeDestinationInputs::resize(int numZones, int numModes)
+{
+    this->numZones = numZones;
+    this->numModes = numModes;
+    std::vector<double>* zoneArrays[] = { &costPublicFirst, &costPublicSecond, &costCarERP_First, &costCarERP_Second,
+            &costCarOP_First, &costCarOP_Second, &costCarParking, &walkDistanceFirst, &walkDistanceSecond,
+            &ttPublicIvtFirst, &ttPublicIvtSecond, &ttPublicOutFirst, &ttPublicOutSecond, &ttCarIvtFirst,
+            &ttCarIvtSecond, &centralDummy, &shop, &area, &population, &walkDistance, &costPublic, &costCar,
+            &costMotorBase, &fareFirst, &fareSecond, &fareAccessEgressAvg, &ttPublic, &ttPublicIvt, &ttPublicOut,
+            &ttCar, &scratchCost, &scratchTT };
+    for (std::vector<double>* zoneArray : zoneArrays)
+    {
+        zoneArray->assign(numZones, 0);
+    }
+    scratchLogSize.assign(NUM_SIZE_TERMS * numZones, 0);
+    availability.assign(numModes * numZones, 0);
+    scratchUtility.assign(numModes * numZones, 0);
+}
+
+void TourModeDestinationInputs::prepare()
+{
+    const double accessEgressFare = getTaxiFare(ACCESS_EGRESS_DISTANCE);
+    for (int z = 0; z < numZones; z++)
+    {
+        walkDistance[z] = walkDistanceFirst[z] + walkDistanceSecond[z];
+        costPublic[z] = costPublicFirst[z] + costPublicSecond[z];
+        costCar[z] = costCarERP_First[z] + costCarERP_Second[z] + costCarOP_First[z] + costCarOP_Second[z] + costCarParking[z];
+        costMotorBase[z] = 0.5 * (costCarERP_First[z] + costCarERP_Second[z] + costCarOP_First[z] + costCarOP_Second[z])
+                + 0.65 * costCarParking[z];
+        fareFirst[z] = getTaxiFare(walkDistanceFirst[z]) + costCarERP_First[z] + centralDummy[z] * 3;
+        fareSecond[z] = getTaxiFare(walkDistanceSecond[z]) + costCarERP_Second[z] + centralDummy[z] * 3;
+        fareAccessEgressAvg[z] = ((accessEgressFare + costCarERP_First[z] + centralDummy[z] * 3)
+                + (accessEgressFare + costCarERP_Second[z] + centralDummy[z] * 3)) / 2.0;
+        ttPublicIvt[z] = ttPublicIvtFirst[z] + ttPublicIvtSecond[z];
+        ttPublicOut[z] = ttPublicOutFirst[z] + ttPublicOutSecond[z];
+        ttPublic[z] = ttPublicIvt[z] + ttPublicOutFirst[z] + ttPublicOutSecond[z];
+        ttCar[z] = ttCarIvtFirst[z] + ttCarIvtSecond[z];
+    }
+}
+
+TourModeDestinationLogsumModel::TourModeDestinationLogsumModel() :
+        form(-1), betaLog(0), expBetaArea(0), expBetaPopulation(0), tolerance(0), numValidationSamples(0),
+        enabled(false), remainingValidationSamples(0), validatedSamples(0), compiledNanosTotal(0), referenceNanosTotal(0)
+{
+}
+
+bool TourModeDestinationLogsumModel::isSupported(const std::string& modelName)
+{
+    return findModelForm(modelName) >= 0;
+}
+
+void TourModeDestinationLogsumModel::getCoefficientNames(const std::string& modelName, std::vector<std::string>& names)
+{
+    names.clear();
+    int formIdx = findModelForm(modelName);
+    if (formIdx < 0)
+    {
+        return;
+    }
+    std::set<std::string> uniqueNames(SIZE_COEFFICIENTS, SIZE_COEFFICIENTS + 3);
+    for (const ModeForm& modeForm : MODEL_FORMS[formIdx].modes)
+    {
+        for (const char* name : modeForm.coefficients)
+        {
+            if (name)
+            {
+                uniqueNames.insert(name);
+            }
+        }
+    }
+    names.assign(uniqueNames.begin(), uniqueNames.end());
+}
+
+void TourModeDestinationLogsumModel::parseCoefficients(std::istream& script, std::map<std::string, double>& coefficients)
+{
+    const std::string prefix = "local beta_";
+    std::string line;
+    while (std::getline(script, line))
+    {
+        std::size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line.compare(start, prefix.size(), prefix) != 0)
+        {
+            continue;
+        }
+        std::size_t nameStart = start + prefix.size() - 5; //keep "beta_"
+        std::size_t nameEnd = nameStart;
+        while (nameEnd < line.size() && (std::isalnum((unsigned char) line[nameEnd]) || line[nameEnd] == '_'))
+        {
+            nameEnd++;
+        }
+        std::size_t assign = line.find_first_not_of(" \t", nameEnd);
+        if (assign == std::string::npos || line[assign] != '=')
+        {
+            continue;
+        }
+
+        //value: a number, optionally signed with blanks between the sign and the number, optionally followed by a comment
+        std::string value = line.substr(assign + 1);
+        std::size_t comment = value.find("--");
+        if (comment != std::string::npos)
+        {
+            value.erase(comment);
+        }
+        std::string compact;
+        for (char c : value)
+        {
+            if (c != ' ' && c != '\t' && c != '\r')
+            {
+                compact += c;
+            }
+        }
+        const std::string name = line.substr(nameStart, nameEnd - nameStart);
+        char* end = nullptr;
+        double number = compact.empty() ? 0 : std::strtod(compact.c_str(), &end);
+        if (compact.empty() || *end != '\0')
+        {
+            coefficients.erase(name); //not a plain number
+            continue;
+        }
+        coefficients[name] = number;
+    }
+}
+
+bool TourModeDestinationLogsumModel::load(const std::string& modelName, std::istream& script,
+        unsigned int numValidationSamples, double tolerance)
+{
+    enabled = false;
+    form = findModelForm(modelName);
+    if (form < 0)
+    {
+        return false;
+    }
+
+    std::map<std::string, double> coefficients;
+    parseCoefficients(script, coefficients);
+
+    //look up all coefficients, so that all missing ones are reported
+    std::string missingNames;
+    double betaArea = 0, betaPopulation = 0;
+    bool found = lookupCoefficient(coefficients, SIZE_COEFFICIENTS[0], betaLog, missingNames);
+    found = lookupCoefficient(coefficients, SIZE_COEFFICIENTS[1], betaArea, missingNames) && found;
+    found = lookupCoefficient(coefficients, SIZE_COEFFICIENTS[2], betaPopulation, missingNames) && found;
+    for (int mode = 0; mode < NUM_MODES; mode++)
+    {
+        const char* const* names = MODEL_FORMS[form].modes[mode].coefficients;
+        ModeCoefficients& coeffs = modes[mode];
+        double* values[NUM_COEFFICIENTS] = { &coeffs.constant, &coeffs.costOverIncome, &coeffs.cost, &coeffs.travelTime,
+                &coeffs.central, &coeffs.distance, &coeffs.female, &coeffs.carOwnership[0], &coeffs.carOwnership[1],
+                &coeffs.carOwnership[2], &coeffs.carOwnership[3], &coeffs.motorOwnership[0], &coeffs.motorOwnership[1],
+                &coeffs.motorOwnership[2], &coeffs.motorOwnership[3] };
+        for (int i = 0; i < NUM_COEFFICIENTS; i++)
+        {
+            found = lookupCoefficient(coefficients, names[i], *values[i], missingNames) && found;
+        }
+    }
+    if (!found)
+    {
+        Warn() << "TourModeDestinationLogsumModel: coefficients " << missingNames << " of " << modelName
+                << " could not be read from its script; the Lua script will be used\n";
+        return false;
+    }
+
+    this->modelName = modelName;
+    expBetaArea = std::exp(betaArea);
+    expBetaPopulation = std::exp(betaPopulation);
+    this->tolerance = tolerance;
+    this->numValidationSamples = numValidationSamples;
+    remainingValidationSamples = numValidationSamples;
+    validatedSamples = 0;
+    compiledNanosTotal = 0;
+    referenceNanosTotal = 0;
+    enabled = true;
+    return true;
+}
+
+bool TourModeDestinationLogsumModel::computeLogsum(int incomeId, int isFemale, int vehicleOwnershipCategory,
+        TourModeDestinationInputs& inputs, double& logsum) const
+{
+    const ModelForm& modelForm = MODEL_FORMS[form];
+    if (incomeId < 1 || incomeId > 14 || inputs.getNumModes() != NUM_MODES)
+    {
+        return false;
+    }
+
+    //person level variables
+    const double incomeDenominator = 0.5 + modelForm.incomeMidpoints[incomeId - 1];
+    const double missingIncome = (incomeId >= 13) ? 1 : 0;
+    const double incomeMasks[] = { 1 - missingIncome, -missingIncome };
+    const int vehOwnCat = vehicleOwnershipCategory;
+    const double carOwnership[] = { (double) (vehOwnCat == 0 || vehOwnCat == 1 || vehOwnCat == 2),
+            (double) (vehOwnCat == 3 || vehOwnCat == 4 || vehOwnCat == 5), (double) (vehOwnCat == 5),
+            (double) (vehOwnCat == 5) };
+    const double anyMotor = (vehOwnCat == 1 || vehOwnCat == 2 || vehOwnCat == 4 || vehOwnCat == 5);
+    const double motorOwnership[] = { (double) (vehOwnCat == 0 || vehOwnCat == 3), anyMotor, anyMotor, anyMotor };
+
+    const int numZones = inputs.getNumZones();
+    const double costIncrease = inputs.costIncrease;
+    const double fareFactor = modelForm.rideHailFareFactor;
+
+    //log of the size terms, shared by all modes
+    double* logSize = &inputs.scratchLogSize[0];
+    for (int z = 0; z < numZones; z++)
+    {
+        const double sizeWithoutShop = expBetaArea * inputs.area[z] + expBetaPopulation * inputs.population[z];
+        const double sizeWithShop = inputs.shop[z] + expBetaArea * inputs.area[z] + expBetaPopulation * inputs.population[z];
+        logSize[SIZE_WITH_SHOP * numZones + z] = std::log(sizeWithShop);
+        logSize[SIZE_WITH_SHOP_PLUS_ONE * numZones + z] = std::log(sizeWithShop + 1);
+        logSize[SIZE_WITHOUT_SHOP * numZones + z] = std::log(sizeWithoutShop);
+    }
+
+    double* cost = &inputs.scratchCost[0];
+    double* travelTime = &inputs.scratchTT[0];
+    for (int mode = 0; mode < NUM_MODES; mode++)
+    {
+        const ModeForm& modeForm = modelForm.modes[mode];
+        const ModeCoefficients& coeffs = modes[mode];
+
+        switch (modeForm.cost)
+        {
+        case COST_NONE:
+            std::fill(cost, cost + numZones, 0.0);
+            break;
+        case COST_PUBLIC:
+            for (int z = 0; z < numZones; z++)
+            {
+                cost[z] = inputs.costPublic[z] + costIncrease;
+            }
+            break;
+        case COST_DRIVE1:
+            for (int z = 0; z < numZones; z++)
+            {
+                cost[z] = inputs.costCar[z] + costIncrease;
+            }
+            break;
+        case COST_SHARE2:
+            for (int z = 0; z < numZones; z++)
+            {
+                cost[z] = (inputs.costCar[z] + costIncrease) / 2;
+            }
+            break;
+        case COST_SHARE3:
+            for (int z = 0; z < numZones; z++)
+            {
+                cost[z] = (inputs.costCar[z] + costIncrease) / 3;
+            }
+            break;
+        case COST_MOTOR:
+            for (int z = 0; z < numZones; z++)
+            {
+                cost[z] = inputs.costMotorBase[z] + costIncrease;
+            }
+            break;
+        case COST_TAXI:
+            for (int z = 0; z < numZones; z++)
+            {
+                cost[z] = inputs.fareFirst[z] + inputs.fareSecond[z] + costIncrease;
+            }
+            break;
+        case COST_SMS:
+            for (int z = 0; z < numZones; z++)
+            {
+                cost[z] = (inputs.fareFirst[z] + inputs.fareSecond[z]) * fareFactor + costIncrease;
+            }
+            break;
+        case COST_SMS_POOL:
+            for (int z = 0; z < numZones; z++)
+            {
+                cost[z] = (inputs.fareFirst[z] + inputs.fareSecond[z]) * fareFactor * POOL_FARE_FACTOR + costIncrease;
+            }
+            break;
+        case COST_RAIL_SMS:
+            for (int z = 0; z < numZones; z++)
+            {
+                cost[z] = inputs.costPublic[z] + costIncrease + inputs.fareAccessEgressAvg[z] * 2 * fareFactor;
+            }
+            break;
+        case COST_RAIL_SMS_POOL:
+            for (int z = 0; z < numZones; z++)
+            {
+                cost[z] = inputs.costPublic[z] + costIncrease
+                        + inputs.fareAccessEgressAvg[z] * 2 * fareFactor * POOL_FARE_FACTOR;
+            }
+            break;
+        }
+
+        switch (modeForm.travelTime)
+        {
+        case TT_PUBLIC:
+            std::copy(inputs.ttPublic.begin(), inputs.ttPublic.end(), travelTime);
+            break;
+        case TT_CAR:
+            std::copy(inputs.ttCar.begin(), inputs.ttCar.end(), travelTime);
+            break;
+        case TT_CAR_WITH_WAIT:
+            for (int z = 0; z < numZones; z++)
+            {
+                travelTime[z] = inputs.ttCar[z] + 1.0 / 6;
+            }
+            break;
+        case TT_WALK:
+            for (int z = 0; z < numZones; z++)
+            {
+                travelTime[z] = inputs.walkDistance[z] / 5;
+            }
+            break;
+        case TT_RAIL_SMS:
+            for (int z = 0; z < numZones; z++)
+            {
+                travelTime[z] = inputs.ttPublicIvt[z] + inputs.ttPublicOut[z] / 6;
+            }
+            break;
+        case TT_SMS_POOL:
+            for (int z = 0; z < numZones; z++)
+            {
+                travelTime[z] = inputs.ttCar[z] + 1.0 / 6 + 1.0 / 10 + inputs.walkDistance[z] / 2 / 60 + 1.0 / 6;
+            }
+            break;
+        case TT_RAIL_SMS_POOL:
+            for (int z = 0; z < numZones; z++)
+            {
+                travelTime[z] = inputs.ttPublicIvt[z] + inputs.ttPublicOut[z] / 6
+                        + (ACCESS_EGRESS_DISTANCE + ACCESS_EGRESS_DISTANCE) / 60 + 1.0 / 10;
+            }
+            break;
+        }
+
+        double personTerms = coeffs.female * isFemale;
+        for (int i = 0; i < 4; i++)
+        {
+            personTerms += coeffs.carOwnership[i] * carOwnership[i] + coeffs.motorOwnership[i] * motorOwnership[i];
+        }
+        const double costOverIncomeCoeff = incomeMasks[modeForm.incomeMask] * coeffs.costOverIncome;
+        const double* modeLogSize = logSize + modeForm.size * numZones;
+        double* utility = &inputs.scratchUtility[mode * numZones];
+        for (int z = 0; z < numZones; z++)
+        {
+            utility[z] = coeffs.constant + 30 * cost[z] / incomeDenominator * costOverIncomeCoeff + cost[z] * coeffs.cost
+                    + travelTime[z] * coeffs.travelTime + coeffs.central * inputs.centralDummy[z]
+                    + betaLog * modeLogSize[z] + inputs.walkDistance[z] * coeffs.distance + personTerms;
+        }
+    }
+
+    //multinomial logit logsum; a utility which is not a number makes the choice unavailable
+    double evSum = 0;
+    const double* utility = &inputs.scratchUtility[0];
+    const double* availability = &inputs.availability[0];
+    const int numChoices = NUM_MODES * numZones;
+    for (int c = 0; c < numChoices; c++)
+    {
+        if (utility[c] == utility[c])
+        {
+            evSum += availability[c] * std::exp(utility[c]);
+        }
+    }
+    logsum = std::log(evSum);
+    return true;
+}
+
+bool TourModeDestinationLogsumModel::claimValidationSample() const
+{
+    unsigned int remaining = remainingValidationSamples.load();
+    while (remaining > 0)
+    {
+        if (remainingValidationSamples.compare_exchange_weak(remaining, remaining - 1))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TourModeDestinationLogsumModel::validate(double compiledLogsum, double referenceLogsum, long long compiledNanos,
+        long long referenceNanos) const
+{
+    //both logsums may be -inf when no choice is available
+    const bool match = (compiledLogsum == referenceLogsum) || std::abs(compiledLogsum - referenceLogsum) <= tolerance;
+    if (!match)
+    {
+        if (enabled.exchange(false))
+        {
+            Warn() << "TourModeDestinationLogsumModel: compiled logsum of " << modelName << " (" << compiledLogsum
+                    << ") differs from the logsum of the Lua script (" << referenceLogsum
+                    << "); the Lua script will be used for the rest of the run\n";
+        }
+        return false;
+    }
+
+    compiledNanosTotal += compiledNanos;
+    referenceNanosTotal += referenceNanos;
+    if (++validatedSamples == numValidationSamples)
+    {
+        Print() << "TourModeDestinationLogsumModel: " << modelName << " validated against the Lua script on "
+                << numValidationSamples << " logsums; average time per logsum: compiled "
+                << compiledNanosTotal / numValidationSamples / 1000.0 << "us, Lua "
+                << referenceNanosTotal / numValidationSamples / 1000.0 << "us\n";
+    }
+    return true;
+}
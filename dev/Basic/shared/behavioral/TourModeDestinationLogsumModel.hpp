@@ -0,0 +1,239 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <atomic>
+#include <istream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/utility.hpp>
+
+namespace sim_mob
+{
+
+/**
+ * Zone level inputs of the tour mode/destination models of one person, stored as dense arrays indexed by
+ * (zone id - 1) and, for availabilities, by (choice id - 1) = (mode - 1) * numZones + (zone id - 1).
+ *
+ * The raw arrays are filled by the caller; prepare() derives the model independent terms (combined costs, travel
+ * times and fares) once, so that they are shared by all mode/destination models evaluated for the person.
+ */
+class TourModeDestinationInputs
+{
+public:
+    TourModeDestinationInputs();
+
+    /**
+     * Sizes all arrays for the given number of zones and modes
+     */
+    void resize(int numZones, int numModes);
+
+    /**
+     * Computes the derived arrays from the raw arrays
+     */
+    void prepare();
+
+    int getNumZones() const
+    {
+        return numZones;
+    }
+
+    int getNumModes() const
+    {
+        return numModes;
+    }
+
+    /// cost increase applied to all modes
+    double costIncrease;
+
+    /// raw inputs; first = home to destination (AM), second = destination to home (PM)
+    std::vector<double> costPublicFirst;
+    std::vector<double> costPublicSecond;
+    std::vector<double> costCarERP_First;
+    std::vector<double> costCarERP_Second;
+    std::vector<double> costCarOP_First;
+    std::vector<double> costCarOP_Second;
+    std::vector<double> costCarParking;
+    std::vector<double> walkDistanceFirst;
+    std::vector<double> walkDistanceSecond;
+    std::vector<double> ttPublicIvtFirst;
+    std::vector<double> ttPublicIvtSecond;
+    std::vector<double> ttPublicOutFirst;
+    std::vector<double> ttPublicOutSecond;
+    std::vector<double> ttCarIvtFirst;
+    std::vector<double> ttCarIvtSecond;
+    std::vector<double> centralDummy;
+    std::vector<double> shop;
+    std::vector<double> area;
+    std::vector<double> population;
+    std::vector<double> availability;
+
+    /// derived inputs
+    std::vector<double> walkDistance;
+    std::vector<double> costPublic;
+    std::vector<double> costCar;
+    std::vector<double> costMotorBase;
+    std::vector<double> fareFirst;
+    std::vector<double> fareSecond;
+    std::vector<double> fareAccessEgressAvg;
+    std::vector<double> ttPublic;
+    std::vector<double> ttPublicIvt;
+    std::vector<double> ttPublicOut;
+    std::vector<double> ttCar;
+
+    /// scratch arrays used during evaluation
+    std::vector<double> scratchCost;
+    std::vector<double> scratchTT;
+    std::vector<double> scratchLogSize;
+    std::vector<double> scratchUtility;
+
+private:
+    int numZones;
+    int numModes;
+};
+
+/**
+ * Compiled counterpart of the tour mode/destination logsum computation of the preday Lua scripts
+ * (compute_logsum_<model> in tmds.lua and tmdo.lua).
+ *
+ * The functional form of each supported script is fixed in C++, while the coefficients are read from the
+ * "local beta_... = <number>" declarations of the script itself, so that re-estimated coefficients are picked up
+ * without recompiling. Utilities of all (mode, zone) choices are evaluated mode by mode in branch-free loops over the
+ * dense arrays of TourModeDestinationInputs.
+ *
+ * Since the script may also be edited in ways the compiled form does not know about, the Lua script remains the
+ * reference: the first few logsums computed by the compiled model are expected to be checked with validate(), which
+ * disables the compiled model for the rest of the run if the values differ.
+ */
+class TourModeDestinationLogsumModel : private boost::noncopyable
+{
+public:
+    /// number of modes in the supported scripts
+    static const int NUM_MODES = 13;
+
+    TourModeDestinationLogsumModel();
+
+    /**
+     * @param modelName name of the tour mode/destination model (e.g. tmds)
+     * @return true if the functional form of the model is known
+     */
+    static bool isSupported(const std::string& modelName);
+
+    /**
+     * Lists the coefficients a supported model reads from its script
+     *
+     * @param modelName name of the model
+     * @param names output list of coefficient names; left empty if the model is not supported
+     */
+    static void getCoefficientNames(const std::string& modelName, std::vector<std::string>& names);
+
+    /**
+     * Reads the numeric "local beta_<name> = <number>" declarations of a Lua script
+     *
+     * @param script stream of the script
+     * @param coefficients output map of coefficient name to value; coefficients declared with an expression instead
+     *          of a number are not included
+     */
+    static void parseCoefficients(std::istream& script, std::map<std::string, double>& coefficients);
+
+    /**
+     * Loads the coefficients of a supported model from its Lua script
+     *
+     * @param modelName name of the model
+     * @param script stream of the Lua script of the model
+     * @param numValidationSamples number of logsums to be checked against the Lua script
+     * @param tolerance maximum absolute difference allowed between the compiled and the Lua logsum
+     *
+     * @return true if loaded; false if the model is not supported or a coefficient could not be read
+     */
+    bool load(const std::string& modelName, std::istream& script, unsigned int numValidationSamples, double tolerance);
+
+    /**
+     * Computes the logsum of the model
+     *
+     * @param incomeId income category id of the person
+     * @param isFemale 1 if the person is female; 0 otherwise
+     * @param vehicleOwnershipCategory vehicle ownership category of the person
+     * @param inputs prepared zone level inputs (the scratch arrays are overwritten)
+     * @param logsum output logsum
+     *
+     * @return true if the logsum was computed; false if the inputs are outside the domain of the compiled model
+     *          (the caller must use the Lua script instead)
+     */
+    bool computeLogsum(int incomeId, int isFemale, int vehicleOwnershipCategory, TourModeDestinationInputs& inputs,
+            double& logsum) const;
+
+    /**
+     * @return true if the model is loaded and has not been disabled
+     */
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Claims one validation sample. Thread safe.
+     *
+     * @return true if the caller must compute the reference logsum with the Lua script and pass it to validate()
+     */
+    bool claimValidationSample() const;
+
+    /**
+     * Compares a compiled logsum with the reference logsum computed by the Lua script. Disables the model if they
+     * differ by more than the tolerance. Thread safe.
+     *
+     * @param compiledLogsum logsum computed by computeLogsum
+     * @param referenceLogsum logsum computed by the Lua script
+     * @param compiledNanos time taken by computeLogsum, in nanoseconds
+     * @param referenceNanos time taken by the Lua script, in nanoseconds
+     *
+     * @return true if the logsums match
+     */
+    bool validate(double compiledLogsum, double referenceLogsum, long long compiledNanos, long long referenceNanos) const;
+
+    const std::string& getModelName() const
+    {
+        return modelName;
+    }
+
+private:
+    /** coefficients of one mode; unused terms are 0 */
+    struct ModeCoefficients
+    {
+        double constant;
+        double costOverIncome;
+        double cost;
+        double travelTime;
+        double central;
+        double distance;
+        double female;
+        double carOwnership[4];
+        double motorOwnership[4];
+    };
+
+    /** index of the functional form in the table of supported forms */
+    int form;
+
+    std::string modelName;
+    ModeCoefficients modes[NUM_MODES];
+    double betaLog;
+    double expBetaArea;
+    double expBetaPopulation;
+
+    double tolerance;
+    unsigned int numValidationSamples;
+    mutable std::atomic<bool> enabled;
+    mutable std::atomic<unsigned int> remainingValidationSamples;
+    mutable std::atomic<unsigned int> validatedSamples;
+    mutable std::atomic<long long> compiledNanosTotal;
+    mutable std::atomic<long long> referenceNanosTotal;
+};
+
+/** compiled tour mode/destination models by model name */
+typedef std::map<std::string, std::unique_ptr<TourModeDestinationLogsumModel> > TourModeDestinationLogsumModelMap;
+
+}
@@ -177,6 +177,11 @@ const WorkGroup::ASSIGNMENT_STRATEGY& sim_mob::ConfigParams::defaultWrkGrpAssign
     return simulation.workGroupAssigmentStrategy;
 }
 
+unsigned int sim_mob::ConfigParams::workGroupRebalanceInterval() const
+{
+    return simulation.workGroupRebalanceInterval;
+}
+
 sim_mob::MutexStrategy& sim_mob::ConfigParams::mutexStategy()
 {
     return simulation.mutexStategy;
@@ -366,6 +366,13 @@ public:
      */
     const WorkGroup::ASSIGNMENT_STRATEGY& defaultWrkGrpAssignment() const;
 
+    /**
+     * Retrieves the interval at which the "timebased" workgroup assignment re-distributes entities
+     *
+     * @return rebalance interval in seconds
+     */
+    unsigned int workGroupRebalanceInterval() const;
+
     /**
      * Retrieves the mutex stratergy
      *
@@ -33,10 +33,47 @@ WorkGroup::ASSIGNMENT_STRATEGY ParseWrkGrpAssignEnum(const XMLCh *srcX, WorkGrou
 		{
 			return WorkGroup::ASSIGN_SMALLEST;
 		}
+		else if (src == "workstealing")
+		{
+			return WorkGroup::ASSIGN_WORKSTEALING;
+		}
+		else if (src == "timebased")
+		{
+			return WorkGroup::ASSIGN_TIMEBASED;
+		}
 
 		stringstream msg;
 		msg << "Invalid value for \'workgroup_assignment\': \"" << src
-		    << "\". Expected: \"roundrobin\" or \"smallest\"";
+		    << "\". Expected: \"roundrobin\", \"smallest\", \"workstealing\" or \"timebased\"";
+		throw runtime_error(msg.str());
+	}
+
+	return defValue;
+}
+
+/**
+ * Parses the message distribution mode of the MessageBus
+ *
+ * @return true for "batched", false for "centralized"
+ */
+bool ParseBatchedMessageDistribution(const XMLCh *srcX, bool defValue)
+{
+	if (srcX)
+	{
+		string src = TranscodeString(srcX);
+
+		if (src == "centralized")
+		{
+			return false;
+		}
+		else if (src == "batched")
+		{
+			return true;
+		}
+
+		stringstream msg;
+		msg << "Invalid value for \'message_distribution\': \"" << src
+		    << "\". Expected: \"centralized\" or \"batched\"";
 		throw runtime_error(msg.str());
 	}
 
@@ -107,6 +144,7 @@ void ParseConfigFile::processXmlFile(XercesDOMParser &parser)
 		processSimulationNode(GetSingleElementByName(rootNode, "simulation", true));
 		processGenericPropsNode(GetSingleElementByName(rootNode, "generic_props"));
 		processMergeLogFilesNode(GetSingleElementByName(rootNode, "merge_log_files"));
+		processNetworkSnapshotNode(GetSingleElementByName(rootNode, "network_snapshot"));
 		processActivityTypesNode(GetSingleElementByName(rootNode, "activity_types", true));
 		processTravelModesNode(GetSingleElementByName(rootNode, "travel_modes", true));
 		processMobilityServiceControllerNode(GetSingleElementByName(rootNode, "mobilityServiceController"));
@@ -329,6 +367,14 @@ void ParseConfigFile::processLongTermParamsNode(xercesc::DOMElement *node)
 			ParseBoolean(GetNamedAttributeValue(GetSingleElementByName(
 					node, "launchPrivatePresale"), "value"), false);
 
+	cfg.ltParams.dbLoadingConnections =
+			ParseUnsignedInt(GetNamedAttributeValue(GetSingleElementByName(
+					node, "dbLoadingConnections"), "value"), (unsigned int) 4);
+
+	cfg.ltParams.opSchemaFlushInterval =
+			ParseUnsignedInt(GetNamedAttributeValue(GetSingleElementByName(
+					node, "opSchemaFlushInterval"), "value"), (unsigned int) 0);
+
 	processDeveloperModelNode(GetSingleElementByName(node, "developerModel"));
 	processHousingModelNode(GetSingleElementByName(node, "housingModel"));
 	processHouseHoldLogsumsNode(GetSingleElementByName(node, "outputHouseholdLogsums"));
@@ -767,6 +813,8 @@ void ParseConfigFile::processSimulationNode(xercesc::DOMElement *node)
 	processWorkgroupAssignmentNode(GetSingleElementByName(node, "workgroup_assignment"));
 	processOperationalCostNode(GetSingleElementByName(node, "operational_cost")) ;
 	processMutexEnforcementNode(GetSingleElementByName(node, "mutex_enforcement"));
+	cfg.simulation.batchedMessageDistribution =
+			ParseBatchedMessageDistribution(GetNamedAttributeValue(GetSingleElementByName(node, "message_distribution"), "value"), false);
 	processClosedLoopPropertiesNode(GetSingleElementByName(node, "closed_loop"));
 
 	cfg.simulation.startingAutoAgentID =
@@ -778,6 +826,17 @@ void ParseConfigFile::processMergeLogFilesNode(xercesc::DOMElement *node)
 	cfg.mergeLogFiles = ParseBoolean(GetNamedAttributeValue(node, "value"), false);
 }
 
+void ParseConfigFile::processNetworkSnapshotNode(xercesc::DOMElement *node)
+{
+	if (!node)
+	{
+		return;
+	}
+
+	cfg.networkSnapshot.file = ParseString(GetNamedAttributeValue(node, "file"), "");
+	cfg.networkSnapshot.rebuild = ParseBoolean(GetNamedAttributeValue(node, "rebuild"), false);
+}
+
 void ParseConfigFile::processGenericPropsNode(xercesc::DOMElement *node)
 {
 	if (!node)
@@ -824,6 +883,7 @@ void ParseConfigFile::processWorkgroupAssignmentNode(xercesc::DOMElement *node)
 {
 	cfg.simulation.workGroupAssigmentStrategy = ParseWrkGrpAssignEnum(GetNamedAttributeValue(node, "value"),
 	                                                                  WorkGroup::ASSIGN_SMALLEST);
+	cfg.simulation.workGroupRebalanceInterval = ParseUnsignedInt(GetNamedAttributeValue(node, "rebalance_interval"), (unsigned int) 900);
 }
 
 void ParseConfigFile::processOperationalCostNode(xercesc::DOMElement *node)
@@ -169,6 +169,13 @@ private:
 	 */
 	void processMergeLogFilesNode(xercesc::DOMElement *node);
 
+	/**
+	 * Processes the network_snapshot element in the config file
+	 *
+	 * @param node node corresponding to the network_snapshot element in the xml file
+	 */
+	void processNetworkSnapshotNode(xercesc::DOMElement *node);
+
 	/**
 	 * Processes the generic_props element in the config file
 	 *
@@ -12,13 +12,13 @@ sim_mob::RawConfigParams::RawConfigParams() : mergeLogFiles(false), generateBusR
 
 sim_mob::SimulationParams::SimulationParams() :
     baseGranMS(0), baseGranSecond(0), totalRuntimeMS(0), totalWarmupMS(0), inSimulationTTUsage(0),
-    workGroupAssigmentStrategy(WorkGroup::ASSIGN_ROUNDROBIN), startingAutoAgentID(0), operationalCostICE(0), operationalCostHEV(0), operationalCostBEV(0),
-    mutexStategy(MtxStrat_Buffered)
+    workGroupAssigmentStrategy(WorkGroup::ASSIGN_ROUNDROBIN), workGroupRebalanceInterval(0), startingAutoAgentID(0), operationalCostICE(0), operationalCostHEV(0), operationalCostBEV(0),
+    mutexStategy(MtxStrat_Buffered), batchedMessageDistribution(false)
 {}
 
 
 sim_mob::LongTermParams::LongTermParams(): enabled(false), workers(0), days(0), tickStep(0), maxIterations(0),year(0),resume(false),currentOutputSchema(std::string()),mainSchemaVersion(std::string()),configSchemaVersion(std::string()),calibrationSchemaVersion(std::string()),geometrySchemaVersion(std::string()),opSchemaloadingInterval(0)
-                                           ,initialLoading(false), launchBTO(false), launchPrivatePresale(false){}
+                                           ,initialLoading(false), launchBTO(false), launchPrivatePresale(false), dbLoadingConnections(4), opSchemaFlushInterval(0){}
 sim_mob::LongTermParams::DeveloperModel::DeveloperModel(): enabled(false), timeInterval(0), initialPostcode(0),initialUnitId(0),initialBuildingId(0),
                                                             initialProjectId(0),minLotSize(0), constructionStartDay(0), saleFromDay(0),occupancyFromDay(0), constructionCompletedDay(0) {}
 sim_mob::LongTermParams::HousingModel::HousingModel(): enabled(false), timeInterval(0), timeOnMarket(0), timeOffMarket(0), wtpOffsetEnabled(false),unitsFiltering(false),vacantUnitActivationProbability(0),
@@ -56,6 +56,13 @@ struct LongTermParams
 	bool launchBTO;
 	bool launchPrivatePresale;
 
+	/// number of database connections over which the tables of the models are loaded concurrently at their start
+	unsigned int dbLoadingConnections;
+
+	/// if not 0, the bids, unit sales, household units and vehicle ownership changes are written to the output schema
+	/// every so many days, and released, instead of being kept until opSchemaloadingInterval
+	unsigned int opSchemaFlushInterval;
+
 	struct DeveloperModel{
 		DeveloperModel();
 		bool enabled;
@@ -352,12 +359,18 @@ public:
     /// Defautl assignment strategy for Workgroups.
     WorkGroup::ASSIGNMENT_STRATEGY workGroupAssigmentStrategy;
 
+    /// Interval (in seconds) at which entities are re-distributed among workers under the "timebased" strategy.
+    unsigned int workGroupRebalanceInterval;
+
     /// Default starting ID for agents with auto-generated IDs.
     int startingAutoAgentID;
 
     /// Locking strategy for Shared<> properties.
     sim_mob::MutexStrategy mutexStategy;
 
+    /// Whether the MessageBus routes messages into per-destination batches ("batched") instead of through the main thread.
+    bool batchedMessageDistribution;
+
     /// The settings for the closed loop manager
     ClosedLoopParams closedLoop;
 };
@@ -376,6 +389,20 @@ struct DatabaseDetails {
     std::string procedures;
 };
 
+/**
+ * Settings of the compiled snapshot of the road network tables (see NetworkSnapshot)
+ */
+struct NetworkSnapshotParams {
+    NetworkSnapshotParams() : rebuild(false) {}
+
+    /// The snapshot file; the network is loaded from it if it matches the stored procedures, and it is (re)created
+    /// from the database otherwise. Empty if the network is always loaded from the database.
+    std::string file;
+
+    /// If true, the snapshot is recreated from the database even if it matches.
+    bool rebuild;
+};
+
 /**
  * contains the path and finle names of external scripts used in the simulation
  *
@@ -473,9 +500,23 @@ struct PathSetConf
 	PathSetConf() : enabled(false), supplyLinkFile(""), RTTT_Conf(""), DTT_Conf(""), psRetrievalWithoutBannedRegion(""), interval(0), recPS(false), reroute(false),
 			perturbationRange(std::pair<unsigned short,unsigned short>(0,0)), kspLevel(0),
 			perturbationIteration(0), threadPoolSize(0), maxSegSpeed(0), publickShortestPathLevel(10), simulationApproachIterations(10),
-			publicPathSetEnabled(true), privatePathSetEnabled(true)
+			publicPathSetEnabled(true), privatePathSetEnabled(true), cacheEnabled(false), cacheCapacity(128 * 1024 * 1024),
+			routeChoiceEvaluation(ROUTE_CHOICE_LUA)
 	{}
 
+    /// How the private traffic route choice model is evaluated
+	enum RouteChoiceEvaluation
+	{
+		/// by the choose_PVT_path function of the pvtrc script (required for custom models)
+		ROUTE_CHOICE_LUA,
+
+		/// in C++, with the coefficients of the pvtrc script
+		ROUTE_CHOICE_NATIVE,
+
+		/// both; the choice of the script is used, and the choices are compared
+		ROUTE_CHOICE_VALIDATE
+	};
+
     /// Whether pathset enabled
 	bool enabled;
 
@@ -537,6 +578,25 @@ struct PathSetConf
     ///	 enable rerouting?
 	bool reroute;
 
+    /// enable caching of private pathsets?
+	bool cacheEnabled;
+
+    /// memory budget of the private pathset cache, in bytes; each thread has its own cache with this budget
+	size_t cacheCapacity;
+
+    /// file of the path-set store, from which the private pathsets are read instead of the database (if not empty)
+	std::string storeFile;
+
+    /// table (or function) the path-set store is built from, when the store file is missing or stale
+	std::string storeSource;
+
+    /// version stamp of the store source, to be changed whenever the source is regenerated under the same name;
+    /// a store file built from another version is rebuilt
+	std::string storeSourceVersion;
+
+    /// evaluation of the private traffic route choice model
+	RouteChoiceEvaluation routeChoiceEvaluation;
+
     ///	number of iterations in random perturbation
 	int perturbationIteration;
 
@@ -777,6 +837,9 @@ public:
     /// If loading from the database, how do we connect?
     DatabaseDetails networkDatabase;
 
+    /// Snapshot of the network tables, to skip the database queries at start-up
+    NetworkSnapshotParams networkSnapshot;
+
     /// If loading population from the database, how do we connect?
     DatabaseDetails populationDatabase;
 
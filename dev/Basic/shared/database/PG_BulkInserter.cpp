@@ -4,7 +4,8 @@
 
 using namespace sim_mob;
 
-PG_BulkInserter::PG_BulkInserter(const int numInsertsPerQuery) : numInsertsPerQuery(numInsertsPerQuery), query("")
+PG_BulkInserter::PG_BulkInserter(const int numInsertsPerQuery) : inputFile(nullptr), query(""), connection(nullptr),
+        numInsertsPerQuery(numInsertsPerQuery)
 {
 
 }
@@ -12,6 +13,10 @@ PG_BulkInserter::PG_BulkInserter(const int numInsertsPerQuery) : numInsertsPerQu
 PG_BulkInserter::~PG_BulkInserter()
 {
     delete inputFile;
+    if (connection)
+    {
+        PQfinish(connection);
+    }
 }
 
 bool PG_BulkInserter::connect(const std::string &connectionStr)
@@ -57,6 +62,7 @@ bool PG_BulkInserter::setInputFile(const std::string& fileName)
 
 bool PG_BulkInserter::bulkInsert()
 {
+    bool retVal = true;
     std::string streamBuf;
     std::string line;
     int numLines = 0;
@@ -67,47 +73,87 @@ bool PG_BulkInserter::bulkInsert()
         streamBuf.append("\n");
         if(numLines > numInsertsPerQuery)
         {
-            copyToDB(streamBuf);
+            retVal = copyToDB(streamBuf) && retVal;
             streamBuf.clear();
             numLines = 0;
         }
     }
 
-    copyToDB(streamBuf);
+    return copyToDB(streamBuf) && retVal;
 }
 
 bool PG_BulkInserter::copyToDB(const std::string& buffer)
 {
-    bool retVal = true;
+    if (!beginCopy())
+    {
+        return false;
+    }
+    if (!putCopyData(buffer))
+    {
+        endCopy("PG_BulkInserter: failed to send rows");
+        return false;
+    }
+    return endCopy();
+}
+
+bool PG_BulkInserter::beginCopy()
+{
+    if (!connection || query.empty())
+    {
+        Print() << "PG_BulkInserter: Copy Failed: not connected or no query\n";
+        return false;
+    }
 
     PGresult* res = PQexec(connection, query.c_str());
+    bool retVal = (PQresultStatus(res) == PGRES_COPY_IN);
+    if (!retVal)
+    {
+        Print() << "PG_BulkInserter: Copy Failed: " << PQerrorMessage(connection);
+    }
+    PQclear(res);
+
+    return retVal;
+}
 
-    if(PQresultStatus(res) != PGRES_COPY_IN)
+bool PG_BulkInserter::putCopyData(const std::string& buffer)
+{
+    if (buffer.empty())
     {
-        Print() << "PG_BulkInserter: Copy Failed\n";
-        retVal = false;
+        return true;
     }
-    else
+    if (PQputCopyData(connection, buffer.c_str(), buffer.size()) != 1)
     {
-        if(PQputCopyData(connection, buffer.c_str(), strlen(buffer.c_str())))
+        Print() << PQerrorMessage(connection);
+        return false;
+    }
+    return true;
+}
+
+bool PG_BulkInserter::endCopy(const std::string& errorMessage)
+{
+    bool retVal = true;
+
+    if (PQputCopyEnd(connection, errorMessage.empty() ? NULL : errorMessage.c_str()) == 1)
+    {
+        PGresult* res = PQgetResult(connection);
+        if (PQresultStatus(res) != PGRES_COMMAND_OK)
         {
+            Print() << PQerrorMessage(connection);
+            retVal = false;
+        }
+        PQclear(res);
 
-            if (PQputCopyEnd(connection, NULL) == 1)
-            {
-                PGresult* res = PQgetResult(connection);
-                if (PQresultStatus(res) != PGRES_COMMAND_OK)
-                {
-                    Print() << PQerrorMessage(connection);
-                    retVal = false;
-                }
-            }
-            else
-            {
-                Print() << PQerrorMessage(connection);
-                retVal = false;
-            }
+        // consume the remaining results so that the connection can be used again
+        while ((res = PQgetResult(connection)) != NULL)
+        {
+            PQclear(res);
         }
     }
+    else
+    {
+        Print() << PQerrorMessage(connection);
+        retVal = false;
+    }
 
-    return retVal;
+    return retVal && errorMessage.empty();
 }
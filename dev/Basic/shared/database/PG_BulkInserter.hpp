@@ -22,6 +22,30 @@ public:
     bool setInputFile(const std::string& inputFile);
 
     bool bulkInsert();
+
+    /**
+     * Starts a COPY of the query built by buildQuery(). Rows are then sent with putCopyData() and committed by
+     * endCopy(), so that a caller producing rows over time can stream all of them in a single COPY.
+     *
+     * @return true if the server is ready to receive rows
+     */
+    bool beginCopy();
+
+    /**
+     * Sends rows to the COPY started by beginCopy()
+     *
+     * @param buffer complete rows in the format of the query
+     * @return true if sent
+     */
+    bool putCopyData(const std::string& buffer);
+
+    /**
+     * Ends the COPY started by beginCopy()
+     *
+     * @param errorMessage if not empty, the COPY is aborted with this message instead of committed
+     * @return true if the rows were committed
+     */
+    bool endCopy(const std::string& errorMessage = std::string());
 private:
     std::ifstream* inputFile;
 
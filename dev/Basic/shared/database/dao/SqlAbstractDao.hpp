@@ -3,11 +3,14 @@
 //   license.txt   (http://opensource.org/licenses/MIT)
 
 #pragma once
+#include <cmath>
+#include <cstdio>
 #include <vector>
 #include <boost/algorithm/string.hpp>
 #include <boost/unordered_map.hpp>
 #include "soci/soci.h"
 #include "database/DB_Connection.hpp"
+#include "database/PG_BulkInserter.hpp"
 #include "util/LangHelpers.hpp"
 #include "I_Dao.hpp"
 
@@ -33,6 +36,95 @@ public:
     soci::details::prepare_temp_type& statement;
 };
 
+/**
+ * Visitor that appends a variant value to a row of a COPY in text format,
+ * with the columns delimited by commas (as PG_BulkInserter builds the query)
+ */
+class CopyValueWriter: public boost::static_visitor<>
+{
+public:
+    CopyValueWriter(std::string& row) :
+            row(row)
+    {
+    }
+
+    void operator()(int val) const
+    {
+        row += std::to_string(val);
+    }
+
+    void operator()(long long val) const
+    {
+        row += std::to_string(val);
+    }
+
+    void operator()(unsigned long val) const
+    {
+        row += std::to_string(val);
+    }
+
+    void operator()(double val) const
+    {
+        if (std::isnan(val))
+        {
+            row += "NaN";
+        }
+        else if (std::isinf(val))
+        {
+            row += (val > 0) ? "Infinity" : "-Infinity";
+        }
+        else
+        {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.17g", val);
+            row += buf;
+        }
+    }
+
+    void operator()(const std::tm& val) const
+    {
+        //same format as the statements bound by soci
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "%d-%02d-%02d %02d:%02d:%02d", val.tm_year + 1900, val.tm_mon + 1, val.tm_mday,
+                val.tm_hour, val.tm_min, val.tm_sec);
+        row += buf;
+    }
+
+    void operator()(const std::string& val) const
+    {
+        for (std::string::const_iterator it = val.begin(); it != val.end(); ++it)
+        {
+            switch (*it)
+            {
+            case '\\':
+                row += "\\\\";
+                break;
+            case '\n':
+                row += "\\n";
+                break;
+            case '\r':
+                row += "\\r";
+                break;
+            case '\t':
+                row += "\\t";
+                break;
+            case ',':
+                row += "\\,";
+                break;
+            default:
+                row += *it;
+            }
+        }
+    }
+
+    std::string& row;
+};
+
+/**
+ * Size of the rows buffered by a COPY before they are sent to the server.
+ */
+const std::string::size_type DB_COPY_BUFFER_SIZE = 1 << 20;
+
 // POSTGRES dependent. Needs to be fixed.
 const std::string DB_RETURNING_CLAUSE = "RETURNING";
 const std::string DB_RETURNING_ALL_CLAUSE = " " + DB_RETURNING_CLAUSE + " * ";
@@ -191,6 +283,74 @@ public:
         return entity;
     }
 
+    /**
+     * Inserts the given entities with a single COPY over a connection of its own, instead of an INSERT per entity.
+     * The rows are built with toRow and sent as they are serialised, in buffers of DB_COPY_BUFFER_SIZE.
+     * @param entities pointers to the entities to insert.
+     * @param table name of the table, qualified by its schema.
+     * @param columns columns of the table, in the order of the parameters of toRow.
+     * @return true if all rows were committed, false otherwise (no row is committed).
+     */
+    template<typename C>
+    bool insertViaCopy(const C& entities, const std::string& table, const std::vector<std::string>& columns)
+    {
+        if (entities.empty())
+        {
+            return true;
+        }
+        if (!isConnected())
+        {
+            return false;
+        }
+
+        PG_BulkInserter inserter(0);
+        if (!inserter.connect(connection.getConnectionStr()) || !inserter.buildQuery(table, columns) || !inserter.beginCopy())
+        {
+            return false;
+        }
+
+        std::string buffer;
+        CopyValueWriter valueWriter(buffer);
+        Parameters params;
+        for (typename C::const_iterator it = entities.begin(); it != entities.end(); ++it)
+        {
+            params.clear();
+            toRow(**it, params, false);
+            if (params.size() != columns.size())
+            {
+                inserter.endCopy("SqlAbstractDao: the rows of " + table + " do not match its columns");
+                return false;
+            }
+
+            for (Parameters::const_iterator param = params.begin(); param != params.end(); ++param)
+            {
+                if (param != params.begin())
+                {
+                    buffer += ',';
+                }
+                boost::apply_visitor(valueWriter, *param);
+            }
+            buffer += '\n';
+
+            if (buffer.size() >= DB_COPY_BUFFER_SIZE)
+            {
+                if (!inserter.putCopyData(buffer))
+                {
+                    inserter.endCopy("SqlAbstractDao: failed to send the rows of " + table);
+                    return false;
+                }
+                buffer.clear();
+            }
+        }
+
+        if (!inserter.putCopyData(buffer))
+        {
+            inserter.endCopy("SqlAbstractDao: failed to send the rows of " + table);
+            return false;
+        }
+        return inserter.endCopy();
+    }
+
     //run a given query with given params
     virtual T& executeQueryWithParams(T& entity, std::string insertQuery, const Parameters& params,bool returning = false)
         {
@@ -46,6 +46,7 @@ const std::string DB_FIELD_V_MODEL = "vehicle_model";
 /**
  * Logsum fields
  */
+const std::string DB_FIELD_PERSON_ID = "person_id";
 const std::string DB_FIELD_WORK_LOGSUM = "work";
 const std::string DB_FIELD_EDUCATION_LOGSUM = "education";
 const std::string DB_FIELD_SHOP_LOGSUM = "shop";
@@ -4,6 +4,8 @@
 
 #include "PopulationSqlDao.hpp"
 
+#include <stdexcept>
+#include <unordered_map>
 #include <boost/lexical_cast.hpp>
 #include "conf/ConfigManager.hpp"
 #include <behavioral/params/ZoneCostParams.hpp>
@@ -18,6 +20,25 @@ using namespace sim_mob::db;
 namespace
 {
 typedef long long BigInt;
+
+/**
+ * builds a postgres array literal (e.g. {1,2,3}) from a list of ids, to be bound as a single parameter
+ */
+template<typename T>
+std::string toArrayLiteral(const std::vector<T>& ids)
+{
+	std::string literal = "{";
+	for (typename std::vector<T>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+	{
+		if (it != ids.begin())
+		{
+			literal += ",";
+		}
+		literal += boost::lexical_cast<std::string>(*it);
+	}
+	literal += "}";
+	return literal;
+}
 }
 
 PopulationSqlDao::PopulationSqlDao(DB_Connection& connection) :
@@ -82,6 +103,32 @@ void PopulationSqlDao::getOneById(long long id, PersonParams& outParam)
 	getById(params, outParam);
 }
 
+void PopulationSqlDao::getByIds(const std::vector<long>& ids, std::vector<PersonParams>& outList)
+{
+	if (ids.empty() || !isConnected())
+	{
+		return;
+	}
+
+	// the individual_by_id stored procedure takes a single id (bound as :_id); it is called once per id of the
+	// array within a single query, and the rows are returned in the order of the ids
+	ConfigParams& fullConfig = ConfigManager::GetInstanceRW().FullConfig();
+	std::string storedProc = fullConfig.dbStoredProcMap["individual_by_id"];
+	const std::string ID_PLACEHOLDER = ":_id";
+	std::size_t placeholderPos = storedProc.find(ID_PLACEHOLDER);
+	if (placeholderPos == std::string::npos)
+	{
+		throw std::runtime_error("individual_by_id stored procedure does not take an :_id parameter");
+	}
+	storedProc.replace(placeholderPos, ID_PLACEHOLDER.size(), "ids.id");
+	const std::string DB_GET_INDIVIDUALS_BY_IDS = "SELECT ind.* FROM unnest(CAST(:_ids AS bigint[])) WITH ORDINALITY AS ids(id, ord), LATERAL "
+			+ APPLY_SCHEMA(fullConfig.schemas.main_schema, storedProc) + " AS ind ORDER BY ids.ord";
+
+	db::Parameters params;
+	params.push_back(toArrayLiteral(ids));
+	getByValues(DB_GET_INDIVIDUALS_BY_IDS, params, outList);
+}
+
 void PopulationSqlDao::getAllIds(std::vector<long>& outList)
 {
 	if (isConnected())
@@ -232,7 +279,10 @@ SimmobSqlDao::SimmobSqlDao(db::DB_Connection& connection, const std::string& tab
 				"SELECT "
                     + getLogsumColumnsStr(activityLogsumColumns)
 					+ " FROM " + tableName + " where person_id = :_id" //get by id
-                ), activityLogsumColumns(activityLogsumColumns)
+                ), activityLogsumColumns(activityLogsumColumns),
+		getLogsumsByIdsQuery("SELECT CAST(" + DB_FIELD_PERSON_ID + " AS bigint) AS " + DB_FIELD_PERSON_ID + ","
+				+ getLogsumColumnsStr(activityLogsumColumns) + " FROM " + tableName
+				+ " where " + DB_FIELD_PERSON_ID + " = ANY(:_ids)") //the array literal takes the type of the person_id column
 {
 }
 
@@ -284,6 +334,37 @@ void SimmobSqlDao::getLogsumById(long long id, PersonParams& outObj)
 	getById(params, outObj);
 }
 
+void SimmobSqlDao::getLogsumsByIds(std::vector<PersonParams>& persons)
+{
+	if (persons.empty() || !isConnected())
+	{
+		return;
+	}
+
+	std::vector<std::string> ids;
+	std::unordered_map<BigInt, PersonParams*> personsById;
+	ids.reserve(persons.size());
+	for (std::vector<PersonParams>::iterator it = persons.begin(); it != persons.end(); ++it)
+	{
+		ids.push_back(it->getPersonId());
+		personsById[boost::lexical_cast<BigInt>(it->getPersonId())] = &(*it);
+	}
+
+	db::Parameters params;
+	params.push_back(toArrayLiteral(ids));
+	Statement query(connection.getSession<soci::session>());
+	prepareStatement(getLogsumsByIdsQuery, params, query);
+	ResultSet rs(query);
+	for (ResultSet::const_iterator it = rs.begin(); it != rs.end(); ++it)
+	{
+		std::unordered_map<BigInt, PersonParams*>::iterator personIt = personsById.find((*it).get<BigInt>(DB_FIELD_PERSON_ID));
+		if (personIt != personsById.end())
+		{
+			fromRow(*it, *(personIt->second));
+		}
+	}
+}
+
 void SimmobSqlDao::getPostcodeNodeMap()
 {
 	if (isConnected())
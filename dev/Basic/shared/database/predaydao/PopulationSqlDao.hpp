@@ -39,6 +39,14 @@ public:
 	 */
 	void getOneById(long long id, PersonParams& outParam);
 
+	/**
+	 * fetches data for several individual ids in a single query
+	 * @param ids individual ids
+	 * @param outList output list to which the individuals found are appended in the order of ids (individuals missing
+	 *          in the database are skipped)
+	 */
+	void getByIds(const std::vector<long>& ids, std::vector<PersonParams>& outList);
+
 	/**
 	 * fetches the lookup table for income categories
 	 * @param outArray output parameter for storing income lower limits
@@ -93,6 +101,12 @@ public:
 	 */
 	void getLogsumById(long long id, PersonParams& outObj);
 
+	/**
+	 * fetches logsum data for several individuals in a single query
+	 * @param persons individuals whose logsums are loaded; individuals without logsums are left unchanged
+	 */
+	void getLogsumsByIds(std::vector<PersonParams>& persons);
+
 	/**
 	 * fetches taz code for each address id in simmobility database
 	 * @param outMap output parameter for storing postcode -> simmobility node map
@@ -120,5 +134,8 @@ private:
     std::string getLogsumColumnsStr(const std::vector<std::string>& activityLogsumColumns);
 
     const std::vector<std::string>& activityLogsumColumns;
+
+    /// query to fetch the logsums of a list of persons
+    const std::string getLogsumsByIdsQuery;
 };
 } // end namespace sim_mib
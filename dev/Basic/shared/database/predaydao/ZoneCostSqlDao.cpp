@@ -3,6 +3,10 @@
 //   license.txt   (http://opensource.org/licenses/MIT)
 
 #include "ZoneCostSqlDao.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <libpq-fe.h>
+#include <stdexcept>
 #include <vector>
 #include "DatabaseHelper.hpp"
 #include "logging/Log.hpp"
@@ -27,6 +31,42 @@ std::vector<std::string> initTimeDependentTT_ColNames(const std::string& prefix)
 
 std::vector<std::string> ttArrivalBasedColumn = initTimeDependentTT_ColNames(DB_FIELD_TCOST_TT_ARRIVAL_PREFIX);
 std::vector<std::string> ttDepartureBasedColumn = initTimeDependentTT_ColNames(DB_FIELD_TCOST_TT_DEPARTURE_PREFIX);
+
+/**
+ * parses one row of the COPY text output (tab separated, in the column order of getAll)
+ * @return true if the row has the expected number of fields
+ */
+bool parseTimeDependentTT_CopyRow(const char* row, TimeDependentTT_Params& outObj)
+{
+	char* end = nullptr;
+	outObj.setOriginZone(std::strtol(row, &end, 10));
+	if (*end != '\t') { return false; }
+	outObj.setDestinationZone(std::strtol(end + 1, &end, 10));
+	if (*end != '\t') { return false; }
+
+	//info_unavailable may be a boolean ('t'/'f') or an integer column
+	const char* field = end + 1;
+	outObj.setInfoUnavailable(*field == 't' || (std::isdigit(*field) && std::strtol(field, nullptr, 10) != 0));
+	while (*field != '\t' && *field != '\0') { field++; }
+
+	double* arrivalBasedTT = outObj.getArrivalBasedTT();
+	double* departureBasedTT = outObj.getDepartureBasedTT();
+	for (int i = 0; i < 2 * NUM_30MIN_TIME_WINDOWS_IN_DAY; ++i)
+	{
+		if (*field != '\t') { return false; }
+		//NULLs (\N) are read as 0
+		double value = std::strtod(field + 1, &end);
+		if (end == field + 1)
+		{
+			value = 0;
+			while (*end != '\t' && *end != '\0' && *end != '\n') { end++; }
+		}
+		if (i < NUM_30MIN_TIME_WINDOWS_IN_DAY) { arrivalBasedTT[i] = value; }
+		else { departureBasedTT[i - NUM_30MIN_TIME_WINDOWS_IN_DAY] = value; }
+		field = end;
+	}
+	return (*field == '\n' || *field == '\0');
+}
 }
 
 CostSqlDao::CostSqlDao(DB_Connection& connection, const std::string& getAllQuery) :
@@ -292,3 +332,93 @@ void sim_mob::TimeDependentTT_SqlDao::getUnavailableODs(TravelTimeMode ttMode, s
 		}
 	}
 }
+
+std::size_t sim_mob::TimeDependentTT_SqlDao::getAll(TravelTimeMode ttMode, TimeDependentTT_Matrix& outMatrix)
+{
+	std::string query = "COPY (SELECT " + DB_FIELD_TCOST_ORIGIN + ", " + DB_FIELD_TCOST_DESTINATION + ", " + DB_FIELD_TCOST_INFO_UNAVAILABLE;
+	for (int i = 0; i < NUM_30MIN_TIME_WINDOWS_IN_DAY; ++i)
+	{
+		query += ", " + ttArrivalBasedColumn[i];
+	}
+	for (int i = 0; i < NUM_30MIN_TIME_WINDOWS_IN_DAY; ++i)
+	{
+		query += ", " + ttDepartureBasedColumn[i];
+	}
+	query += " FROM " + getTableName(ttMode) + ") TO STDOUT";
+
+	//COPY is not exposed by soci; use a dedicated libpq connection
+	PGconn* pgConn = PQconnectdb(connection.getConnectionStr().c_str());
+	if (PQstatus(pgConn) != CONNECTION_OK)
+	{
+		std::string error = PQerrorMessage(pgConn);
+		PQfinish(pgConn);
+		throw std::runtime_error("TimeDependentTT_SqlDao: connection for COPY failed: " + error);
+	}
+
+	PGresult* res = PQexec(pgConn, query.c_str());
+	bool copyStarted = (PQresultStatus(res) == PGRES_COPY_OUT);
+	PQclear(res);
+	if (!copyStarted)
+	{
+		std::string error = PQerrorMessage(pgConn);
+		PQfinish(pgConn);
+		throw std::runtime_error("TimeDependentTT_SqlDao: COPY failed: " + error);
+	}
+
+	std::size_t numRecords = 0;
+	std::size_t numSkipped = 0;
+	TimeDependentTT_Params ttParams;
+	char* row = nullptr;
+	int rowLength = 0;
+	while ((rowLength = PQgetCopyData(pgConn, &row, 0)) > 0)
+	{
+		if (parseTimeDependentTT_CopyRow(row, ttParams) && outMatrix.setTT(ttMode, ttParams))
+		{
+			numRecords++;
+		}
+		else
+		{
+			numSkipped++;
+		}
+		PQfreemem(row);
+	}
+
+	bool copyFailed = (rowLength == -2);
+	while ((res = PQgetResult(pgConn)) != nullptr)
+	{
+		copyFailed = copyFailed || (PQresultStatus(res) != PGRES_COMMAND_OK);
+		PQclear(res);
+	}
+	if (copyFailed)
+	{
+		std::string error = PQerrorMessage(pgConn);
+		PQfinish(pgConn);
+		throw std::runtime_error("TimeDependentTT_SqlDao: COPY failed: " + error);
+	}
+	PQfinish(pgConn);
+
+	if (numSkipped > 0)
+	{
+		Warn() << "TimeDependentTT_SqlDao: skipped " << numSkipped << " records of " << getTableName(ttMode)
+				<< " with unknown zones or unexpected format\n";
+	}
+	return numRecords;
+}
+
+std::string sim_mob::TimeDependentTT_SqlDao::getTableName(TravelTimeMode ttMode)
+{
+	ConfigParams& fullConfig = ConfigManager::GetInstanceRW().FullConfig();
+	const std::string& DEMAND_SCHEMA = fullConfig.schemas.demand_schema;
+	switch(ttMode)
+	{
+	case TravelTimeMode::TT_PRIVATE:
+	{
+		return APPLY_SCHEMA(DEMAND_SCHEMA, fullConfig.dbTableNamesMap["learned_travel_time_table_car"]);
+	}
+	case TravelTimeMode::TT_PUBLIC:
+	{
+		return APPLY_SCHEMA(DEMAND_SCHEMA, fullConfig.dbTableNamesMap["learned_travel_time_table_bus"]);
+	}
+	}
+	return std::string();
+}
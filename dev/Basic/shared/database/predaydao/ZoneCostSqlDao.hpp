@@ -10,6 +10,7 @@
 #include "database/DB_Connection.hpp"
 #include "behavioral/params/ZoneCostParams.hpp"
 #include "behavioral/PredayUtils.hpp"
+#include "behavioral/TimeDependentTT_Matrix.hpp"
 #include <unordered_set>
 #include "conf/ConfigManager.hpp"
 
@@ -160,6 +161,21 @@ public:
      */
     void getUnavailableODs(TravelTimeMode ttMode, std::vector<sim_mob::OD_Pair>& outVect);
 
+    /**
+     * streams the travel times of all ODs into the matrix with a single COPY ... TO STDOUT
+     * @param ttMode mode type - (public transit / private) for fetching travel time
+     * @param outMatrix initialized matrix to fill
+     * @return number of records loaded into outMatrix
+     */
+    std::size_t getAll(TravelTimeMode ttMode, TimeDependentTT_Matrix& outMatrix);
+
+    /**
+     * get the schema qualified name of the travel time table
+     * @param ttMode mode type - (public transit / private)
+     * @return table name
+     */
+    static std::string getTableName(TravelTimeMode ttMode);
+
 private:
     /** query to get public transit zone to zone travel time by OD */
     const std::string ptGetByOD_Query;
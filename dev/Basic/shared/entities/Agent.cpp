@@ -7,6 +7,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <boost/lexical_cast.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include "conf/ConfigManager.hpp"
 #include "conf/ConfigParams.hpp"
@@ -47,8 +48,16 @@ std::set<Entity*> sim_mob::Agent::all_agents;
 std::vector<Entity*>sim_mob::Agent::activeAgents;
 unsigned int sim_mob::Agent::nextAgentId = 0;
 
+namespace
+{
+/** guards nextAgentId; agents are constructed by the person loader threads while the simulation runs */
+boost::mutex nextAgentIdMutex;
+}
+
 unsigned int sim_mob::Agent::getAndIncrementID(int preferredID)
 {
+    boost::lock_guard<boost::mutex> lock(nextAgentIdMutex);
+
     //If the ID is valid, modify next_agent_id;
     if (preferredID > static_cast<int> (nextAgentId))
     {
@@ -273,7 +282,7 @@ void sim_mob::Agent::setToBeRemoved()
 
 NullableOutputStream sim_mob::Agent::Log() const
 {
-    return NullableOutputStream(currWorkerProvider->getLogFile());
+    return NullableOutputStream(currWorkerProvider->getExecutingLogFile());
 }
 
 void sim_mob::Agent::onEvent(EventId eventId, Context ctxId, EventPublisher* sender, const EventArgs& args)
@@ -230,7 +230,7 @@ void sim_mob::long_term::Agent_LT::clearToBeRemoved()
 
 NullableOutputStream sim_mob::long_term::Agent_LT::Log()
 {
-    return NullableOutputStream(currWorkerProvider->getLogFile());
+    return NullableOutputStream(currWorkerProvider->getExecutingLogFile());
 }
 
 void sim_mob::long_term::Agent_LT::HandleMessage(messaging::Message::MessageType type, const messaging::Message& message){}
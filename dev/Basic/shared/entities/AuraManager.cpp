@@ -17,6 +17,7 @@
 #include "spatial_trees/simtree/SimAuraManager.hpp"
 #include "spatial_trees/rdu_tree/RDUAuraManager.hpp"
 #include "spatial_trees/packing_tree/PackingTreeAuraManager.hpp"
+#include "spatial_trees/str_tree/STR_AuraManager.hpp"
 
 namespace sim_mob
 {
@@ -52,6 +53,11 @@ void AuraManager::init(AuraManagerImplementation implType)
         impl_ = new PackingTreeAuraManager();
         impl_->init();
     }
+    else if(implType == IMPL_STR)
+    {
+        impl_ = new STR_AuraManager();
+        impl_->init();
+    }
     else
     {
         throw std::runtime_error("Unknown AuraManager Implementation type selected.");
@@ -69,6 +75,11 @@ void AuraManager::update(const std::set<sim_mob::Entity *>& removedAgentPointers
     {
         impl_->update(time_step, removedAgentPointers);
     }
+
+    for (const std::function<void(const std::set<sim_mob::Entity *>&)> &listener : updateListeners)
+    {
+        listener(removedAgentPointers);
+    }
     time_step++;
 }
 
@@ -107,6 +118,11 @@ void AuraManager::registerNewAgent(Agent const *one_agent)
     }
 }
 
+void AuraManager::addUpdateListener(const std::function<void(const std::set<sim_mob::Entity *>&)> &listener)
+{
+    updateListeners.push_back(listener);
+}
+
 } // end of sim_mob
 
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <functional>
+#include <set>
 #include <vector>
 #include <boost/utility.hpp>
 
@@ -56,7 +58,10 @@ public:
         IMPL_RDU,
         
         /**R-Star with packing algorithm*/
-        IMPL_PACKING
+        IMPL_PACKING,
+
+        /**R-tree packed with the Sort-Tile-Recursive algorithm, rebuilt in parallel*/
+        IMPL_STR
     };
 
     static AuraManager& instance()
@@ -132,6 +137,16 @@ public:
      */
     void registerNewAgent(Agent const *one_agent);
 
+    /**
+     * Registers a function to be called at the end of every update(), with the same removed agents.
+     *
+     * This is meant for the indices of the published agent positions which are not spatial (e.g. the order of the
+     * vehicles on each lane), so that they are rebuilt at the same point of the time tick as the spatial index.
+     *
+     * @param listener the function
+     */
+    void addUpdateListener(const std::function<void(const std::set<sim_mob::Entity *>&)> &listener);
+
 private:
     AuraManager() : impl_(nullptr), time_step(0)
     {
@@ -144,6 +159,9 @@ private:
 
     //Current time step.
     int time_step;
+
+    //Functions called after each update
+    std::vector<std::function<void(const std::set<sim_mob::Entity *>&)> > updateListeners;
 };
 
 }
@@ -223,6 +223,8 @@ void ClosedLoopRunManager::waitForDynaMIT(const ConfigParams &config)
 
         guidanceMgr.removeFileLock();
 
+        TravelTimeManager::getInstance()->publishTravelTimeTable();
+
         Print() << "Predicted travel times updated\n";
     }
 
@@ -1,6 +1,7 @@
 #include "TravelTimeManager.hpp"
 #include "path/PathSetManager.hpp"
 #include "path/SOCI_Converters.hpp"
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <boost/foreach.hpp>
 #include <map>
@@ -10,6 +11,7 @@
 #include "path/PathSetManager.hpp"
 #include "util/LangHelpers.hpp"
 #include "geospatial/network/Node.hpp"
+#include "geospatial/network/RoadNetwork.hpp"
 #include "geospatial/network/TurningGroup.hpp"
 
 using namespace sim_mob;
@@ -177,6 +179,38 @@ double sim_mob::LinkTravelTime::getInSimulationLinkTT(unsigned int downstreamLin
     return -1;
 }
 
+void sim_mob::LinkTravelTime::addHistoricalToTravelTimeTable(TravelTimeTable& table) const
+{
+    for (TravelTimeStore::const_iterator ttMapIt = historicalTT_Map.begin(); ttMapIt != historicalTT_Map.end(); ttMapIt++)
+    {
+        const DownStreamLinkSpecificTT_Map& ttInnerMap = ttMapIt->second;
+        if (ttInnerMap.empty())
+        {
+            continue;
+        }
+        double totalTT = 0.0;
+        for (DownStreamLinkSpecificTT_Map::const_iterator ttInnerMapIt = ttInnerMap.begin(); ttInnerMapIt != ttInnerMap.end(); ttInnerMapIt++)
+        {
+            table.setHistoricalTurnTT(linkId, ttInnerMapIt->first, ttMapIt->first, ttInnerMapIt->second);
+            totalTT = totalTT + ttInnerMapIt->second;
+        }
+        table.setHistoricalLinkTT(linkId, ttMapIt->first, totalTT / ttInnerMap.size());
+    }
+}
+
+void sim_mob::LinkTravelTime::addInSimulationToTravelTimeTable(TravelTimeTable& table)
+{
+    boost::shared_lock<boost::shared_mutex> lock(ttMapMutex);
+    for (TimeAndCountStore::const_iterator tcIt = currentSimulationTT_Map.begin(); tcIt != currentSimulationTT_Map.end(); tcIt++)
+    {
+        const DownStreamLinkSpecificTimeAndCount_Map& tcMap = tcIt->second;
+        for (DownStreamLinkSpecificTimeAndCount_Map::const_iterator tcMapIt = tcMap.begin(); tcMapIt != tcMap.end(); tcMapIt++)
+        {
+            table.setInSimulationTurnTT(linkId, tcMapIt->first, tcIt->first, tcMapIt->second.getTravelTime());
+        }
+    }
+}
+
 void sim_mob::LinkTravelTime::dumpTravelTimesToFile(const std::string fileName) const
 {
     //  destination file
@@ -203,8 +237,11 @@ sim_mob::TravelTimeManager::TravelTimeManager()
     : intervalMS(sim_mob::ConfigManager::GetInstance().FullConfig().getPathSetConf().interval * 1000), //conversion from seconds to milliseconds
       enRouteTT(new sim_mob::TravelTimeManager::EnRouteTT(*this)),
       odIntervalMS(sim_mob::ConfigManager::GetInstance().FullConfig().odTTConfig.intervalMS),
-      segIntervalMS(sim_mob::ConfigManager::GetInstance().FullConfig().rsTTConfig.intervalMS)
-{}
+      segIntervalMS(sim_mob::ConfigManager::GetInstance().FullConfig().rsTTConfig.intervalMS),
+      travelTimeTableVersion(0)
+{
+    TT_STORAGE_TIME_INTERVAL_WIDTH = intervalMS; //re-initialized when the historical travel times are loaded
+}
 
 sim_mob::TravelTimeManager::~TravelTimeManager()
 {
@@ -219,6 +256,54 @@ void sim_mob::TravelTimeManager::loadTravelTimes()
     soci::session dbSession(soci::postgresql, dbStr);
     loadLinkDefaultTravelTime(dbSession);
     loadLinkHistoricalTravelTime(dbSession);
+    initTravelTimeTable(RoadNetwork::getInstance()->getMapOfIdVsLinks());
+}
+
+void sim_mob::TravelTimeManager::initTravelTimeTable(const std::map<unsigned int, Link *>& links)
+{
+    //The table covers the day and the simulated period; later times are looked up in the maps
+    const ConfigParams& cfg = ConfigManager::GetInstance().FullConfig();
+    const unsigned int endTime = std::max(24 * 3600 * 1000u, cfg.simStartTime().getValue() + cfg.simulation.totalRuntimeMS);
+    const unsigned int numIntervals = endTime / TT_STORAGE_TIME_INTERVAL_WIDTH + 1;
+
+    std::shared_ptr<TravelTimeTable> table(new TravelTimeTable(links, TT_STORAGE_TIME_INTERVAL_WIDTH, numIntervals,
+                                                               ++travelTimeTableVersion));
+    for (std::map<unsigned int, sim_mob::LinkTravelTime>::const_iterator it = lnkTravelTimeMap.begin(); it != lnkTravelTimeMap.end(); it++)
+    {
+        table->setDefaultTT(it->first, it->second.getDefaultTravelTime());
+        it->second.addHistoricalToTravelTimeTable(*table);
+    }
+    historicalTravelTimeTable = table;
+
+    publishTravelTimeTable();
+}
+
+void sim_mob::TravelTimeManager::publishTravelTimeTable()
+{
+    if (!historicalTravelTimeTable)
+    {
+        return; //travel times not loaded
+    }
+
+    std::shared_ptr<TravelTimeTable> table(new TravelTimeTable(*historicalTravelTimeTable, ++travelTimeTableVersion));
+    for (std::map<unsigned int, sim_mob::LinkTravelTime>::iterator it = lnkTravelTimeMap.begin(); it != lnkTravelTimeMap.end(); it++)
+    {
+        it->second.addInSimulationToTravelTimeTable(*table);
+    }
+
+    const ConfigParams& cfg = ConfigManager::GetInstance().FullConfig();
+    if (cfg.simulation.closedLoop.enabled && !predictedLinkTravelTimes.linkTravelTimes.empty())
+    {
+        table->setPredictionPeriod(predictedLinkTravelTimes.startTime, predictedLinkTravelTimes.numOfPeriods,
+                                   predictedLinkTravelTimes.secondsPerPeriod);
+        for (std::map<std::pair<unsigned int, unsigned int>, double *>::const_iterator it = predictedLinkTravelTimes.linkTravelTimes.begin();
+                it != predictedLinkTravelTimes.linkTravelTimes.end(); it++)
+        {
+            table->setPredictedTT(it->first.first, it->first.second, it->second);
+        }
+    }
+
+    std::atomic_store(&travelTimeTable, std::shared_ptr<const TravelTimeTable>(table));
 }
 
 void sim_mob::TravelTimeManager::loadLinkDefaultTravelTime(soci::session& sql)
@@ -229,8 +314,26 @@ void sim_mob::TravelTimeManager::loadLinkDefaultTravelTime(soci::session& sql)
 
     for (soci::rowset<sim_mob::LinkTravelTime>::iterator lttIt = rs.begin(); lttIt != rs.end(); ++lttIt)
     {
-        lnkTravelTimeMap[lttIt->getLinkId()] = *lttIt;
+        setDefaultLinkTT(lttIt->getLinkId(), lttIt->getDefaultTravelTime());
+    }
+}
+
+void sim_mob::TravelTimeManager::setDefaultLinkTT(unsigned int linkId, double travelTime)
+{
+    LinkTravelTime& lnkTT = lnkTravelTimeMap[linkId];
+    lnkTT.setLinkId(linkId);
+    lnkTT.setDefaultTravelTime(travelTime);
+}
+
+void sim_mob::TravelTimeManager::addHistoricalLinkTT(unsigned int linkId, unsigned int downstreamLinkId, const DailyTime& startTime,
+                                                     double travelTime)
+{
+    std::map<unsigned int, sim_mob::LinkTravelTime>::iterator lttIt = lnkTravelTimeMap.find(linkId); // must have an entry for all link ids after loading default travel times
+    if (lttIt == lnkTravelTimeMap.end())
+    {
+        throw std::runtime_error("linkId specified in historical travel time table does not have a default travel time");
     }
+    lttIt->second.addHistoricalTravelTime(startTime, downstreamLinkId, travelTime);
 }
 
 void sim_mob::TravelTimeManager::loadLinkHistoricalTravelTime(soci::session& sql)
@@ -259,13 +362,7 @@ void sim_mob::TravelTimeManager::loadLinkHistoricalTravelTime(soci::session& sql
         }
 
         //store data
-        std::map<unsigned int, sim_mob::LinkTravelTime>::iterator lttIt = lnkTravelTimeMap.find(linkId); // must have an entry for all link ids after loading default travel times
-        if (lttIt == lnkTravelTimeMap.end())
-        {
-            throw std::runtime_error("linkId specified in historical travel time table does not have a default travel time");
-        }
-        LinkTravelTime& lnkTT = lttIt->second;
-        lnkTT.addHistoricalTravelTime(startTime, downstreamLinkId, travelTime);
+        addHistoricalLinkTT(linkId, downstreamLinkId, startTime, travelTime);
     }
 
 }
@@ -1,11 +1,13 @@
 #pragma once
 #include <boost/thread/shared_mutex.hpp>
 #include <map>
+#include <memory>
 #include <soci/soci.h>
 #include <soci/postgresql/soci-postgresql.h>
 #include <string>
 #include "util/DailyTime.hpp"
 #include "path/Common.hpp"
+#include "TravelTimeTable.hpp"
 
 namespace sim_mob
 {
@@ -310,6 +312,18 @@ public:
      */
     double getHistoricalLinkTT(const DailyTime& dt) const;
 
+    /**
+     * copies the historical travel times of this link into a travel time table
+     * @param table the table being built
+     */
+    void addHistoricalToTravelTimeTable(TravelTimeTable& table) const;
+
+    /**
+     * copies the in-simulation travel times of this link into a travel time table
+     * @param table the table being built
+     */
+    void addInSimulationToTravelTimeTable(TravelTimeTable& table);
+
     /**
      * Writes the aggregated data into the file
      * @param fileName name of file to dump travel times
@@ -357,6 +371,46 @@ public:
      */
     double getDefaultLinkTT(const Link* lnk) const;
 
+    /**
+     * sets the default travel time of a link
+     * @param linkId id of the link
+     * @param travelTime travel time in seconds
+     */
+    void setDefaultLinkTT(unsigned int linkId, double travelTime);
+
+    /**
+     * adds a historical travel time of a link for a specific downstream link
+     * @param linkId id of the link; it must have a default travel time
+     * @param downstreamLinkId id of the downstream link
+     * @param startTime time of day at which the travel time is applicable
+     * @param travelTime travel time in seconds
+     */
+    void addHistoricalLinkTT(unsigned int linkId, unsigned int downstreamLinkId, const DailyTime& startTime, double travelTime);
+
+    /**
+     * builds the default and historical travel times of the given links into the travel time table, which is then
+     * shared by all tables published later, and publishes the first table.
+     * Must be called once the default and historical travel times are loaded
+     * @param links the links of the road network, by id
+     */
+    void initTravelTimeTable(const std::map<unsigned int, Link *>& links);
+
+    /**
+     * builds a table of the current travel times and publishes it for path evaluation, replacing the previous one.
+     * Only the in-simulation and predicted times are rebuilt; the rest is shared with the table built by initTravelTimeTable.
+     * Must be called while no travel times are added (e.g. between ticks)
+     */
+    void publishTravelTimeTable();
+
+    /**
+     * fetches the latest published travel time table; the table stays valid for as long as it is held
+     * @return the table; null if the travel times are not loaded
+     */
+    std::shared_ptr<const TravelTimeTable> getTravelTimeTable() const
+    {
+        return std::atomic_load(&travelTimeTable);
+    }
+
     /**
      * returns the travel time experienced by other drivers in the current simulation
      * @param mode mode of travel requested
@@ -507,6 +561,15 @@ private:
     /** default travel time table name */
     std::string defaultTT_TableName;
 
+    /** the table of the default and historical travel times, from which the published tables are derived */
+    std::shared_ptr<const TravelTimeTable> historicalTravelTimeTable;
+
+    /** the latest published travel time table; accessed with the atomic shared_ptr functions only */
+    std::shared_ptr<const TravelTimeTable> travelTimeTable;
+
+    /** version of the latest published travel time table */
+    uint64_t travelTimeTableVersion;
+
     static sim_mob::TravelTimeManager* instance;
 };
 }//namespace
@@ -0,0 +1,184 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "TravelTimeTable.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "entities/TravelTimeManager.hpp"
+#include "geospatial/network/Node.hpp"
+
+using namespace sim_mob;
+
+TravelTimeTable::TravelTimeTable(const std::map<unsigned int, Link *>& linkMap, unsigned int intervalWidthMS,
+                                 unsigned int numIntervals, uint64_t version) :
+        intervalWidthMS(intervalWidthMS), numIntervals(numIntervals), version(version), historical(new HistoricalTimes()),
+        predictionStartTime(0), numPeriods(0), secondsPerPeriod(0)
+{
+    if (intervalWidthMS == 0)
+    {
+        throw std::runtime_error("width of time interval for travel time storage is 0");
+    }
+
+    HistoricalTimes& hist = *historical;
+    hist.links.resize(linkMap.size(), nullptr);
+    for (std::map<unsigned int, Link *>::const_iterator it = linkMap.begin(); it != linkMap.end(); ++it)
+    {
+        const unsigned int index = it->second->getLinkIndex();
+        if (index >= hist.links.size() || hist.links[index])
+        {
+            throw std::runtime_error("TravelTimeTable: links are not densely indexed");
+        }
+        hist.links[index] = it->second;
+        hist.indexOfId[it->first] = index;
+    }
+
+    //The turns of each link, in link index order
+    hist.turnOffsets.reserve(hist.links.size() + 1);
+    for (std::vector<const Link*>::const_iterator it = hist.links.begin(); it != hist.links.end(); ++it)
+    {
+        hist.turnOffsets.push_back(hist.turnDownstreamLinks.size());
+        const std::map<unsigned int, TurningGroup *>& turningGroups = (*it)->getToNode()->getTurningGroups((*it)->getLinkId());
+        for (std::map<unsigned int, TurningGroup *>::const_iterator tgIt = turningGroups.begin(); tgIt != turningGroups.end(); ++tgIt)
+        {
+            const unsigned int downstream = getIndex(tgIt->first);
+            if (downstream != NO_TURN)
+            {
+                hist.turnDownstreamLinks.push_back(downstream);
+            }
+        }
+    }
+    hist.turnOffsets.push_back(hist.turnDownstreamLinks.size());
+
+    hist.defaultTT.resize(hist.links.size(), std::numeric_limits<double>::quiet_NaN());
+    hist.linkRows.resize(hist.links.size(), -1);
+    hist.turnRows.resize(hist.turnDownstreamLinks.size(), -1);
+    inSimulationTurnRows.resize(hist.turnDownstreamLinks.size(), -1);
+}
+
+TravelTimeTable::TravelTimeTable(const TravelTimeTable& base, uint64_t version) :
+        intervalWidthMS(base.intervalWidthMS), numIntervals(base.numIntervals), version(version),
+        historical(base.historical), inSimulationTurnRows(historical->turnDownstreamLinks.size(), -1),
+        predictionStartTime(0), numPeriods(0), secondsPerPeriod(0)
+{
+}
+
+unsigned int TravelTimeTable::getIndex(unsigned int linkId) const
+{
+    std::map<unsigned int, unsigned int>::const_iterator it = historical->indexOfId.find(linkId);
+    return (it != historical->indexOfId.end()) ? it->second : NO_TURN;
+}
+
+unsigned int TravelTimeTable::getTurn(unsigned int linkId, unsigned int downstreamLinkId) const
+{
+    const unsigned int link = getIndex(linkId);
+    const unsigned int downstream = getIndex(downstreamLinkId);
+    if (link == NO_TURN || downstream == NO_TURN)
+    {
+        return NO_TURN;
+    }
+    for (unsigned int i = historical->turnOffsets[link]; i < historical->turnOffsets[link + 1]; ++i)
+    {
+        if (historical->turnDownstreamLinks[i] == downstream)
+        {
+            return i;
+        }
+    }
+    return NO_TURN;
+}
+
+double& TravelTimeTable::getOrAddValue(std::vector<int32_t>& rows, std::vector<double>& values, unsigned int index,
+                                       unsigned int interval)
+{
+    if (rows[index] < 0)
+    {
+        rows[index] = values.size() / numIntervals;
+        values.resize(values.size() + numIntervals, -1);
+    }
+    return values[rows[index] * numIntervals + interval];
+}
+
+void TravelTimeTable::setDefaultTT(unsigned int linkId, double travelTime)
+{
+    const unsigned int link = getIndex(linkId);
+    if (link != NO_TURN)
+    {
+        historical->defaultTT[link] = travelTime;
+    }
+}
+
+void TravelTimeTable::setHistoricalLinkTT(unsigned int linkId, unsigned int interval, double travelTime)
+{
+    const unsigned int link = getIndex(linkId);
+    if (link != NO_TURN && interval < numIntervals)
+    {
+        getOrAddValue(historical->linkRows, historical->values, link, interval) = travelTime;
+    }
+}
+
+void TravelTimeTable::setHistoricalTurnTT(unsigned int linkId, unsigned int downstreamLinkId, unsigned int interval,
+                                          double travelTime)
+{
+    const unsigned int turn = getTurn(linkId, downstreamLinkId);
+    if (turn != NO_TURN && interval < numIntervals)
+    {
+        getOrAddValue(historical->turnRows, historical->values, turn, interval) = travelTime;
+    }
+}
+
+void TravelTimeTable::setInSimulationTurnTT(unsigned int linkId, unsigned int downstreamLinkId, unsigned int interval,
+                                            double travelTime)
+{
+    const unsigned int turn = getTurn(linkId, downstreamLinkId);
+    if (turn != NO_TURN && interval < numIntervals)
+    {
+        getOrAddValue(inSimulationTurnRows, inSimulationValues, turn, interval) = travelTime;
+    }
+}
+
+void TravelTimeTable::setPredictionPeriod(unsigned int startTime, unsigned int numPeriods, unsigned int secondsPerPeriod)
+{
+    if (secondsPerPeriod == 0)
+    {
+        throw std::runtime_error("TravelTimeTable: prediction period is 0");
+    }
+    this->predictionStartTime = startTime;
+    this->numPeriods = numPeriods;
+    this->secondsPerPeriod = secondsPerPeriod;
+    predictedLinkRows.assign(historical->links.size(), -1);
+    predictedTurnRows.assign(historical->turnDownstreamLinks.size(), -1);
+    predictedValues.clear();
+}
+
+void TravelTimeTable::setPredictedTT(unsigned int linkId, unsigned int downstreamLinkId, const double* travelTimes)
+{
+    int32_t* row = nullptr;
+    if (downstreamLinkId == 0)
+    {
+        const unsigned int link = getIndex(linkId);
+        row = (link != NO_TURN && numPeriods > 0) ? &predictedLinkRows[link] : nullptr;
+    }
+    else
+    {
+        const unsigned int turn = getTurn(linkId, downstreamLinkId);
+        row = (turn != NO_TURN && numPeriods > 0) ? &predictedTurnRows[turn] : nullptr;
+    }
+
+    if (row)
+    {
+        if (*row < 0)
+        {
+            *row = predictedValues.size() / numPeriods;
+            predictedValues.resize(predictedValues.size() + numPeriods);
+        }
+        std::copy(travelTimes, travelTimes + numPeriods, predictedValues.begin() + (*row) * numPeriods);
+    }
+}
+
+double TravelTimeTable::getLinkTT_FromManager(const Link* lnk, const DailyTime& startTime, const Link* downstreamLink,
+                                              bool useInSimulationTT) const
+{
+    return TravelTimeManager::getInstance()->getLinkTT(lnk, startTime, downstreamLink, useInSimulationTT);
+}
@@ -0,0 +1,258 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include "geospatial/network/Link.hpp"
+#include "util/DailyTime.hpp"
+
+namespace sim_mob
+{
+
+/**
+ * Immutable snapshot of the link travel times known to the TravelTimeManager, laid out for fast path evaluation.
+ *
+ * The times are held in flat arrays of rows, one value per time interval, addressed by the dense index of the links
+ * (Link::getLinkIndex) and of the turns to their downstream links (in the order of the turning groups of the link's
+ * end node). Each row already resolves the fallbacks of TravelTimeManager::getLinkTT, so a lookup is a few array
+ * reads. Links and turns without historical, in-simulation or predicted times have no row and use the default time.
+ *
+ * The link and turn indices and the default and historical times do not change during the simulation; they are built
+ * once and shared by all tables derived from the first one. The TravelTimeManager derives a new table whenever the
+ * in-simulation or predicted times change (at the end of each travel time interval, and when new predictions are
+ * received) and publishes it by swapping a shared pointer; readers keep the table they fetched for as long as they use
+ * it, without locking. Queries the table cannot answer (times outside the intervals of the table, consecutive links
+ * without a turning group, links without a default time) are passed on to TravelTimeManager::getLinkTT, so the
+ * results are the same.
+ */
+class TravelTimeTable : private boost::noncopyable
+{
+public:
+    /**
+     * Creates a table with the default times of all links unknown
+     * @param links the links of the road network, by id; their link indices must be dense
+     * @param intervalWidthMS width of the travel time intervals, in milliseconds
+     * @param numIntervals number of intervals held, starting with the one at 00:00:00
+     * @param version the version of the table
+     */
+    TravelTimeTable(const std::map<unsigned int, Link *>& links, unsigned int intervalWidthMS, unsigned int numIntervals,
+                    uint64_t version);
+
+    /**
+     * Creates a table sharing the links and the default and historical times of another table, without in-simulation
+     * or predicted times
+     * @param base the table to share; its default and historical times must no longer be set
+     * @param version the version of the table
+     */
+    TravelTimeTable(const TravelTimeTable& base, uint64_t version);
+
+    /**
+     * Sets the default travel time of a link. Only valid before the table is shared.
+     * @param linkId id of the link
+     * @param travelTime travel time in seconds
+     */
+    void setDefaultTT(unsigned int linkId, double travelTime);
+
+    /**
+     * Sets the historical travel time of a link, averaged over its downstream links. Only valid before the table is shared.
+     * @param linkId id of the link
+     * @param interval the time interval
+     * @param travelTime travel time in seconds
+     */
+    void setHistoricalLinkTT(unsigned int linkId, unsigned int interval, double travelTime);
+
+    /**
+     * Sets the historical travel time of a link towards one of its downstream links. Only valid before the table is shared.
+     * @param linkId id of the link
+     * @param downstreamLinkId id of the downstream link
+     * @param interval the time interval
+     * @param travelTime travel time in seconds
+     */
+    void setHistoricalTurnTT(unsigned int linkId, unsigned int downstreamLinkId, unsigned int interval, double travelTime);
+
+    /**
+     * Sets the travel time of a link towards one of its downstream links experienced in the current simulation
+     * @param linkId id of the link
+     * @param downstreamLinkId id of the downstream link
+     * @param interval the time interval in which the travel times were recorded
+     * @param travelTime travel time in seconds
+     */
+    void setInSimulationTurnTT(unsigned int linkId, unsigned int downstreamLinkId, unsigned int interval, double travelTime);
+
+    /**
+     * Sets the periods of the predicted travel times
+     * @param startTime start of the first period, in seconds
+     * @param numPeriods the number of periods
+     * @param secondsPerPeriod the width of a period, in seconds
+     */
+    void setPredictionPeriod(unsigned int startTime, unsigned int numPeriods, unsigned int secondsPerPeriod);
+
+    /**
+     * Sets the predicted travel times of a link, for each period
+     * @param linkId id of the link
+     * @param downstreamLinkId id of the downstream link; 0 for the times that do not depend on the downstream link
+     * @param travelTimes the travel times of the periods, in seconds
+     */
+    void setPredictedTT(unsigned int linkId, unsigned int downstreamLinkId, const double* travelTimes);
+
+    /**
+     * Gets the travel time of a link, as TravelTimeManager::getLinkTT
+     * @param lnk the link
+     * @param startTime time at which the link is entered
+     * @param downstreamLink the next link which is to be taken after lnk
+     * @param useInSimulationTT indicates whether in simulation travel times are to be used
+     * @return travel time in seconds
+     */
+    double getLinkTT(const Link* lnk, const DailyTime& startTime, const Link* downstreamLink, bool useInSimulationTT) const
+    {
+        const HistoricalTimes& hist = *historical;
+        const unsigned int link = lnk->getLinkIndex();
+        const unsigned int interval = startTime.getValue() / intervalWidthMS;
+        if (link >= hist.links.size() || hist.links[link] != lnk || interval >= numIntervals || std::isnan(hist.defaultTT[link]))
+        {
+            return getLinkTT_FromManager(lnk, startTime, downstreamLink, useInSimulationTT);
+        }
+
+        unsigned int turn = NO_TURN;
+        if (downstreamLink)
+        {
+            const unsigned int downstream = downstreamLink->getLinkIndex();
+            for (unsigned int i = hist.turnOffsets[link]; i < hist.turnOffsets[link + 1]; ++i)
+            {
+                if (hist.turnDownstreamLinks[i] == downstream)
+                {
+                    turn = i;
+                    break;
+                }
+            }
+            if (turn == NO_TURN)
+            {
+                return getLinkTT_FromManager(lnk, startTime, downstreamLink, useInSimulationTT);
+            }
+        }
+
+        if (numPeriods > 0)
+        {
+            const int32_t row = downstreamLink ? predictedTurnRows[turn] : predictedLinkRows[link];
+            if (row >= 0)
+            {
+                const unsigned int period = ((startTime.getValue() / 1000) - predictionStartTime) / secondsPerPeriod;
+                if (period < numPeriods)
+                {
+                    return predictedValues[row * numPeriods + period];
+                }
+            }
+        }
+
+        double res = 0;
+        if (downstreamLink)
+        {
+            //in-simulation times are taken from the previous interval
+            if (useInSimulationTT && interval > 0)
+            {
+                res = getValue(inSimulationTurnRows, inSimulationValues, turn, interval - 1);
+            }
+            if (res <= 0.0)
+            {
+                res = getValue(hist.turnRows, hist.values, turn, interval);
+            }
+        }
+        else
+        {
+            res = getValue(hist.linkRows, hist.values, link, interval);
+        }
+
+        if (res <= 0.0)
+        {
+            res = hist.defaultTT[link];
+        }
+        return res;
+    }
+
+    uint64_t getVersion() const
+    {
+        return version;
+    }
+
+private:
+    static const unsigned int NO_TURN = 0xffffffff;
+
+    /** the links, their turns and their default and historical times; shared by a table and the tables derived from it */
+    struct HistoricalTimes
+    {
+        /** the links, by dense index */
+        std::vector<const Link*> links;
+
+        /** link id -> dense index */
+        std::map<unsigned int, unsigned int> indexOfId;
+
+        /** the turns of link i are turnOffsets[i] to turnOffsets[i+1] - 1 */
+        std::vector<unsigned int> turnOffsets;
+
+        /** dense index of the downstream link of each turn */
+        std::vector<unsigned int> turnDownstreamLinks;
+
+        /** default travel time of each link; NaN if unknown */
+        std::vector<double> defaultTT;
+
+        /** row of each link (or turn) in values; -1 if it has no historical time for any interval */
+        std::vector<int32_t> linkRows;
+        std::vector<int32_t> turnRows;
+
+        /** the rows of historical travel times, numIntervals values each; -1 where there is no time */
+        std::vector<double> values;
+    };
+
+    double getValue(const std::vector<int32_t>& rows, const std::vector<double>& values, unsigned int index,
+                    unsigned int interval) const
+    {
+        const int32_t row = rows[index];
+        return (row >= 0) ? values[row * numIntervals + interval] : -1;
+    }
+
+    /** answers the queries the table does not cover */
+    double getLinkTT_FromManager(const Link* lnk, const DailyTime& startTime, const Link* downstreamLink,
+                                 bool useInSimulationTT) const;
+
+    /** @return the dense index of a link; NO_TURN if it is not in the network */
+    unsigned int getIndex(unsigned int linkId) const;
+
+    /** @return the turn from a link to a downstream link; NO_TURN if they are not connected */
+    unsigned int getTurn(unsigned int linkId, unsigned int downstreamLinkId) const;
+
+    /** @return the value of a row for an interval; a new row (filled with -1) is added if needed */
+    double& getOrAddValue(std::vector<int32_t>& rows, std::vector<double>& values, unsigned int index, unsigned int interval);
+
+    const unsigned int intervalWidthMS;
+    const unsigned int numIntervals;
+    const uint64_t version;
+
+    /** the part of the table which does not change during the simulation */
+    std::shared_ptr<HistoricalTimes> historical;
+
+    /** row of each turn in inSimulationValues; -1 if it has no in-simulation time for any interval */
+    std::vector<int32_t> inSimulationTurnRows;
+
+    /** the rows of in-simulation travel times, numIntervals values each; -1 where there is no time */
+    std::vector<double> inSimulationValues;
+
+    unsigned int predictionStartTime;
+    unsigned int numPeriods;
+    unsigned int secondsPerPeriod;
+
+    /** row of each link (or turn) in predictedValues; -1 if it has no predicted times */
+    std::vector<int32_t> predictedLinkRows;
+    std::vector<int32_t> predictedTurnRows;
+
+    /** the rows of predicted travel times, numPeriods values each */
+    std::vector<double> predictedValues;
+};
+
+}
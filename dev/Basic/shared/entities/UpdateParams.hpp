@@ -5,6 +5,7 @@
 #pragma once
 
 #include "metrics/Frame.hpp"
+#include "util/CounterRandom.hpp"
 #include <boost/random.hpp>
 
 namespace sim_mob
@@ -36,6 +37,9 @@ struct UpdateParams {
     boost::mt19937 local_gen;
     ///The random number generator being used by this Agent.
     boost::mt19937& gen;
+    ///Random numbers of this Agent for the current tick, identified by the Agent and the tick rather than by the thread
+    /// that updates it. Roles reset it in their own reset().
+    CounterRandom random;
 };
 
 
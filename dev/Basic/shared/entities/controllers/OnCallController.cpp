@@ -7,6 +7,8 @@
 
 #include "OnCallController.hpp"
 
+#include <algorithm>
+
 #include "geospatial/network/RoadNetwork.hpp"
 #include "path/PathSetManager.hpp"
 #include "util/GeomHelpers.hpp"
@@ -43,7 +45,7 @@ void OnCallController::subscribeDriver(Person *driver)
 #endif
 
     MobilityServiceController::subscribeDriver(driver);
-    availableDrivers.insert(driver);
+    addAvailableDriver(driver);
 
 #ifndef NDEBUG
     if (driverSchedules.find(driver) != driverSchedules.end() )
@@ -89,7 +91,7 @@ void OnCallController::unsubscribeDriver(Person *driver)
     driverSchedules.erase(driver);
     }
 
-    availableDrivers.erase(driver);
+    removeAvailableDriver(driver);
     partiallyAvailableDrivers.erase(driver);
     driversServingSharedReq.erase(driver);
     currentReq.erase(driver);
@@ -118,7 +120,7 @@ void OnCallController::driverAvailable(const Person *driver)
     }
 #endif
 
-    availableDrivers.insert(driver);
+    addAvailableDriver(driver);
 
     // The driver has an empty schedule now
     driverSchedules[driver] = Schedule();
@@ -139,7 +141,7 @@ void OnCallController::driverUnavailable(Person *person)
     consistencyChecks("driverUnavailable: start");
 #endif
 
-    availableDrivers.erase(person);
+    removeAvailableDriver(person);
 
 #ifndef NDEBUG
     consistencyChecks("driverUnavailable: end");
@@ -232,6 +234,7 @@ Entity::UpdateStatus OnCallController::frame_tick(timeslice now)
                             << ", driversServingSharedReq.size() = "<<driversServingSharedReq.size() <<" , "<< currTick
                             << std::endl;
 
+            updateAvailableDriversIndex();
             computeSchedules();
             ControllerLog() << "Computation schedule done: now " << requestQueue.size() << " requests are in the queue, available drivers "
                             << availableDrivers.size() <<", partiallyAvailableDrivers.size()="<< partiallyAvailableDrivers.size()
@@ -464,7 +467,7 @@ void OnCallController::assignSchedule(const Person *driver, const Schedule &sche
 
         driverSchedules[driver] = controllersCopy;
         // The driver is not available anymore
-        availableDrivers.erase(driver);
+        removeAvailableDriver(driver);
     }
     else
     {
@@ -625,84 +628,85 @@ const Node *OnCallController::getCurrentNode(const Person *driver) const
 
 const Person *OnCallController::findClosestDriver(const Node *node) const
 {
-    double bestDistance = std::numeric_limits<double>::max();
-    double bestX, bestY;
+    std::vector<const Person *> closestDrivers;
+    findClosestDrivers(node, 1, closestDrivers);
 
-    const Person *bestDriver = NULL;
-    auto driver = availableDrivers.begin();
+    if (!closestDrivers.empty())
+    {
+        return closestDrivers.front();
+    }
 
+    std::stringstream msg;
+    msg << "No available driver, availableDrivers.size()=" << availableDrivers.size()
+        << ", indexed drivers=" << availableDriversIndex.size();
+    ControllerLog() << msg.str() << std::endl;
 #ifndef NDEBUG
-    unsigned nonCruisingDrivers = 0;
+    if (! availableDrivers.empty() )
+    {
+        msg<<". In the scenarios where a driver subscribed to an OnCall service is only subscribed to that service, "<<
+        "ALL the available drivers MUST be cruising. If it is not the case, there is a bug. If you are running a more complex scenario, where a driver can be "
+        <<"subscribed to different services at the same time, please remove this exception, compile and run again";
+        throw std::runtime_error(msg.str() );
+    }
 #endif
 
-    while (driver != availableDrivers.end())
+    return NULL;
+}
+
+void OnCallController::findClosestDrivers(const Node *node, unsigned int k, std::vector<const Person *> &drivers) const
+{
+    availableDriversIndex.nearest(node->getPosX(), node->getPosY(), k, [this](const Person *driver)
     {
-#ifndef NDEBUG
-        if ( driverSchedules.find(*driver) == driverSchedules.end()  )
-        {
-            std::stringstream msg;
-            msg << "Driver " << (*driver)->getDatabaseId() << " and pointer " << *driver
-                << " exists in availableDrivers but not in driverSchedules";
-            throw std::runtime_error(msg.str());
-        }
-#endif
-        if (isCruising(*driver) || isParked(*driver) || isJustStated(*driver) || isDrivingToPark(*driver))
-        {
-            const Node *driverNode = getCurrentNode(*driver);
-            double currDistance = dist(node->getLocation(), driverNode->getLocation());
+        return isAssignable(driver);
+    }, drivers);
+}
 
-            if (currDistance < bestDistance)
-            {
-                bestDriver = *driver;
-                bestDistance = currDistance;
-                bestX = driverNode->getPosX();
-                bestY = driverNode->getPosY();
-            }
-        }
-#ifndef NDEBUG
-        else{
-            nonCruisingDrivers++;
-
-            const MobilityServiceDriver* mobilityServiceDriver = (*driver)->exportServiceDriver();
-            const std::string driverStatusStr = mobilityServiceDriver->getDriverStatusStr();
-            std::stringstream msg; msg<<"Error: "<<__FILE__<<":" <<__LINE__<< ":Driver " << (*driver)->getDatabaseId() <<
-                " is among the available drivers of a controller of type "<<
-                sim_mob::toString(controllerServiceType) <<", but her state is "<<
-                driverStatusStr<<
-                " This driver is subscribed to the following controller types "<< mobilityServiceDriver->getSubscribedControllerTypesStr()<<
-                ". In the scenarios where a driver subscribed to an OnCall service is only subscribed to that service, "<<
-                    "ALL the available drivers MUST be cruising. If it is not the case, there is a bug. If you are running a more complex scenario, where a driver can be "
-                    <<"subscribed to different services at the same time, please remove this exception, compile and run again";
-            throw std::runtime_error(msg.str() );
-        }
-#endif
-        driver++;
-    }
+void OnCallController::findDriversWithinRadius(const Node *node, double radius, std::vector<const Person *> &drivers) const
+{
+    availableDriversIndex.withinRadius(node->getPosX(), node->getPosY(), radius, drivers);
+    drivers.erase(std::remove_if(drivers.begin(), drivers.end(), [this](const Person *driver)
+    {
+        return !isAssignable(driver);
+    }), drivers.end());
+}
 
-    std::stringstream msg;
-    if (bestDriver != NULL)
+bool OnCallController::isAssignable(const Person *driver) const
+{
+    return isCruising(driver) || isParked(driver) || isJustStated(driver) || isDrivingToPark(driver);
+}
+
+void OnCallController::addAvailableDriver(const Person *driver)
+{
+    availableDrivers.insert(driver);
+
+    const Node *driverNode = getCurrentNode(driver);
+    if (driverNode)
     {
-        msg << "Closest vehicle is at (" << bestX << ", " << bestY << ")" << std::endl;
+        availableDriversIndex.insert(driver, driverNode->getPosX(), driverNode->getPosY());
     }
-    else
+}
+
+void OnCallController::removeAvailableDriver(const Person *driver)
+{
+    availableDrivers.erase(driver);
+    availableDriversIndex.erase(driver);
+}
+
+void OnCallController::updateAvailableDriversIndex()
+{
+    //Drivers move while they are available (e.g. cruising), but only drivers whose node changed are moved in the index
+    for (const Person *driver : availableDrivers)
     {
-        msg << "No available driver, availableDrivers.size()=" << availableDrivers.size();
-#ifndef NDEBUG
-        msg <<", cruisingDrivers="<<nonCruisingDrivers;
-#endif
-        ControllerLog() << msg.str() << std::endl;
-#ifndef NDEBUG
-        if (! availableDrivers.empty() )
+        const Node *driverNode = getCurrentNode(driver);
+        if (driverNode)
         {
-            msg<<". In the scenarios where a driver subscribed to an OnCall service is only subscribed to that service, "<<
-            "ALL the available drivers MUST be cruising. If it is not the case, there is a bug. If you are running a more complex scenario, where a driver can be "
-            <<"subscribed to different services at the same time, please remove this exception, compile and run again";
-            throw std::runtime_error(msg.str() );
+            availableDriversIndex.insert(driver, driverNode->getPosX(), driverNode->getPosY());
+        }
+        else
+        {
+            availableDriversIndex.erase(driver);
         }
-#endif
     }
-
-    return bestDriver;
 }
 
 
@@ -16,6 +16,7 @@
 #include "message/Message.hpp"
 #include "message/MobilityServiceControllerMessage.hpp"
 #include "MobilityServiceController.hpp"
+#include "spatial_trees/PointR_Tree.hpp"
 
 
 namespace sim_mob
@@ -137,6 +138,24 @@ public:
      */
     virtual const Person* findClosestDriver(const Node* node) const;
 
+    /**
+     * Finds the available drivers closest to a node, among those who can be assigned a schedule
+     * (cruising, parked, just started or driving to a parking)
+     * @param node the node
+     * @param k maximum number of drivers to find
+     * @param drivers output drivers, closest first
+     */
+    void findClosestDrivers(const Node* node, unsigned int k, std::vector<const Person*>& drivers) const;
+
+    /**
+     * Finds the available drivers within a (Euclidean) distance of a node, among those who can be assigned a
+     * schedule
+     * @param node the node
+     * @param radius maximum distance
+     * @param drivers output drivers, closest first
+     */
+    void findDriversWithinRadius(const Node* node, double radius, std::vector<const Person*>& drivers) const;
+
     virtual const std::string getRequestQueueStr() const;
 
     virtual void sendCruiseCommand(const Person* driver, const Node* nodeToCruiseTo, const timeslice currTick ) const;
@@ -187,6 +206,13 @@ protected:
     /** Store list of available drivers */
     std::set<const Person *> availableDrivers;
 
+    /**
+     * Spatial index of the available drivers whose current node is known, at the location of their current node.
+     * Drivers are added and removed along with availableDrivers; their locations are refreshed by
+     * updateAvailableDriversIndex() before each schedule computation.
+     */
+    PointR_Tree<Person> availableDriversIndex;
+
     /** Store queue of requests */
     std::list<TripRequestMessage> requestQueue;
 
@@ -344,6 +370,29 @@ protected:
     void assignSchedules(const std::unordered_map<const Person*, Schedule>& schedulesToAssign,
                 bool isUpdatedSchedule = false);
 
+    /**
+     * Adds a driver to the available drivers and to their spatial index
+     * @param driver the driver
+     */
+    void addAvailableDriver(const Person* driver);
+
+    /**
+     * Removes a driver from the available drivers and from their spatial index
+     * @param driver the driver
+     */
+    void removeAvailableDriver(const Person* driver);
+
+    /**
+     * Moves the available drivers to their current node in the spatial index
+     */
+    void updateAvailableDriversIndex();
+
+    /**
+     * @return true if the driver can be assigned a schedule, i.e. is cruising, parked, just started or driving to
+     * a parking
+     */
+    bool isAssignable(const Person* driver) const;
+
 #ifndef NDEBUG
     bool isComputingSchedules; //true during computing schedules. Used for debug purposes
     void consistencyChecks(const std::string& label) const;
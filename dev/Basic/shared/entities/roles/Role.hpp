@@ -94,7 +94,7 @@ protected:
 
     NullableOutputStream Log()
     {
-        return NullableOutputStream(parent->currWorkerProvider->getLogFile());
+        return NullableOutputStream(parent->currWorkerProvider->getExecutingLogFile());
     }
 
 public:
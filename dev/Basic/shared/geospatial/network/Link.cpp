@@ -3,13 +3,14 @@
 //   license.txt   (http://opensource.org/licenses/MIT)
 
 #include <algorithm>
+#include <limits>
 #include "Link.hpp"
 #include "util/LangHelpers.hpp"
 
 using namespace sim_mob;
 
 Link::Link() :
-length(0), linkId(0), fromNode(NULL), fromNodeId(0), linkCategory(LINK_CATEGORY_A), linkType(LINK_TYPE_DEFAULT), roadName(""), toNode(nullptr),
+length(0), linkId(0), linkIndex(std::numeric_limits<unsigned int>::max()), fromNode(NULL), fromNodeId(0), linkCategory(LINK_CATEGORY_A), linkType(LINK_TYPE_DEFAULT), roadName(""), toNode(nullptr),
 toNodeId(0)
 {
 }
@@ -30,6 +31,16 @@ void Link::setLinkId(unsigned int linkId)
     this->linkId = linkId;
 }
 
+unsigned int Link::getLinkIndex() const
+{
+    return linkIndex;
+}
+
+void Link::setLinkIndex(unsigned int linkIndex)
+{
+    this->linkIndex = linkIndex;
+}
+
 const Node* Link::getFromNode() const
 {
     return fromNode;
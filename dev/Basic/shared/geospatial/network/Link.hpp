@@ -79,6 +79,9 @@ private:
     /**Unique identifier for the link*/
     unsigned int linkId;
 
+    /**Dense index of the link in the road network (0 to number of links - 1), assigned when it is added to the network*/
+    unsigned int linkIndex;
+
     /**Pointer to the node from which this link begins*/
     Node *fromNode;
 
@@ -115,6 +118,9 @@ public:
     unsigned int getLinkId() const;
     void setLinkId(unsigned int linkId);
 
+    unsigned int getLinkIndex() const;
+    void setLinkIndex(unsigned int linkIndex);
+
     const Node* getFromNode() const;
     void setFromNode(Node *fromNode);
 
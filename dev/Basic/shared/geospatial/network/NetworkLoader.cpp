@@ -6,6 +6,7 @@
 
 #include <stdexcept>
 #include "logging/Log.hpp"
+#include "NetworkSnapshot.hpp"
 #include "SOCI_Converters.hpp"
 #include "conf/ConfigManager.hpp"
 #include "conf/ConfigParams.hpp"
@@ -65,6 +66,304 @@ string getStoredProcedure(const map<string, string>& storedProcs, const string&
         throw std::runtime_error("Stored-procedure '" + procedureName + "' not found in the configuration file");
     }
 }
+
+/**
+ * Returns the key of the network snapshot: the network database and the stored procedures of the tables, so that a
+ * snapshot is only used for the network it was created from
+ */
+string getSnapshotKey(const map<string, string>& storedProcs)
+{
+    const char* tables[] = { "nodes", "links", "road_segments", "segment_polylines", "lanes", "lane_polylines",
+                             "lane_connectors", "turning_groups", "turning_paths", "turning_polylines",
+                             "turning_conflicts", "traffic_sensors", "bus_stops", "taxi_stands" };
+
+    std::stringstream key;
+    key << "database=" << ConfigManager::GetInstance().FullConfig().networkDatabase.database << ";";
+    for (size_t i = 0; i < sizeof(tables) / sizeof(tables[0]); ++i)
+    {
+        key << tables[i] << "=" << getStoredProcedure(storedProcs, tables[i], false) << ";";
+    }
+    return key.str();
+}
+
+//Reading of the rows returned by the stored procedures into the records of the snapshot. The columns and default
+//values are those used when the network objects were read from the database directly.
+
+void readRow(const soci::row& row, NodeRecord& record, NetworkSnapshot& snapshot)
+{
+    record.id = row.get<unsigned int>("id", 0);
+    record.nodeType = row.get<unsigned int>("node_type", 0);
+    record.trafficLightId = row.get<unsigned int>("traffic_light_id", 0);
+    record.x = row.get<double>("x", 0);
+    record.y = row.get<double>("y", 0);
+    record.z = row.get<double>("z", 0);
+}
+
+void readRow(const soci::row& row, LinkRecord& record, NetworkSnapshot& snapshot)
+{
+    record.id = row.get<unsigned int>("id", 0);
+    record.fromNode = row.get<unsigned int>("from_node", 0);
+    record.category = row.get<unsigned int>("category", 0);
+    record.roadType = row.get<unsigned int>("road_type", 0);
+    record.roadName = snapshot.addString(row.get<std::string>("road_name", ""));
+    record.toNode = row.get<unsigned int>("to_node", 0);
+}
+
+void readRow(const soci::row& row, RoadSegmentRecord& record, NetworkSnapshot& snapshot)
+{
+    record.id = row.get<unsigned int>("id", 0);
+    record.capacity = row.get<unsigned int>("capacity", 0);
+    record.linkId = row.get<unsigned int>("link_id", 0);
+    record.maxSpeed = row.get<unsigned int>("max_speed", 0);
+    record.sequenceNumber = row.get<unsigned int>("sequence_num", 0);
+}
+
+void readRow(const soci::row& row, PolyPointRecord& record, NetworkSnapshot& snapshot)
+{
+    record.polyLineId = row.get<unsigned int>("polyline_id", 0);
+    record.sequenceNumber = row.get<unsigned int>("sequence_no", 0);
+    record.x = row.get<double>("x", 0);
+    record.y = row.get<double>("y", 0);
+    record.z = row.get<double>("z", 0);
+}
+
+void readRow(const soci::row& row, LaneRecord& record, NetworkSnapshot& snapshot)
+{
+    record.id = row.get<unsigned int>("id", 0);
+    record.busLane = row.get<unsigned int>("bus_lane", 0);
+    record.canPark = row.get<unsigned int>("can_park", 0);
+    record.canStop = row.get<unsigned int>("can_stop", 0);
+    record.hasRoadShoulder = row.get<unsigned int>("has_road_shoulder", 0);
+    record.highOccupancyVehicle = row.get<unsigned int>("high_occ_veh", 0);
+    record.segmentId = row.get<unsigned int>("segment_id", 0);
+    record.width = row.get<double>("width", 0);
+}
+
+void readRow(const soci::row& row, LaneConnectorRecord& record, NetworkSnapshot& snapshot)
+{
+    record.id = row.get<unsigned int>("id", 0);
+    record.fromLane = row.get<unsigned int>("from_lane", 0);
+    record.fromSegment = row.get<unsigned int>("from_segment", 0);
+    record.toLane = row.get<unsigned int>("to_lane", 0);
+    record.toSegment = row.get<unsigned int>("to_segment", 0);
+    record.isTrueConnector = row.get<unsigned int>("is_true_connector", 0);
+}
+
+void readRow(const soci::row& row, TurningGroupRecord& record, NetworkSnapshot& snapshot)
+{
+    record.id = row.get<unsigned int>("id", 0);
+    record.fromLink = row.get<unsigned int>("from_link", 0);
+    record.nodeId = row.get<unsigned int>("node_id", 0);
+    record.phases = snapshot.addString(row.get<std::string>("phases", ""));
+    record.rules = row.get<unsigned int>("rules", 0);
+    record.toLink = row.get<unsigned int>("to_link", 0);
+    record.visibility = row.get<double>("visibility", 0);
+}
+
+void readRow(const soci::row& row, TurningPathRecord& record, NetworkSnapshot& snapshot)
+{
+    record.id = (unsigned int) row.get<int>("id", 0);
+    record.fromLane = row.get<unsigned int>("from_lane", 0);
+    record.maxSpeed = row.get<unsigned int>("max_speed");
+    record.toLane = row.get<unsigned int>("to_lane", 0);
+    record.groupId = row.get<unsigned int>("group_id", 0);
+}
+
+void readRow(const soci::row& row, TurningConflictRecord& record, NetworkSnapshot& snapshot)
+{
+    record.id = row.get<unsigned int>("id", 0);
+    record.criticalGap = row.get<double>("gap_time", 0);
+    record.firstConflictDistance = row.get<double>("cd1", 0);
+    record.firstTurningId = row.get<unsigned int>("turning_path1", 0);
+    record.priority = row.get<unsigned int>("priority", 0);
+    record.secondConflictDistance = row.get<double>("cd2", 0);
+    record.secondTurningId = row.get<unsigned int>("turning_path2", 0);
+}
+
+void readRow(const soci::row& row, TrafficSensorRecord& record, NetworkSnapshot& snapshot)
+{
+    record.id = row.get<unsigned int>(0);
+    record.type = row.get<unsigned int>(1);
+    record.code = row.get<unsigned int>(2);
+    record.zone = row.get<double>(3);
+    record.offset = row.get<double>(4);
+    record.segmentId = row.get<unsigned int>(5);
+    record.trafficLight = row.get<unsigned int>(6);
+}
+
+void readRow(const soci::row& row, BusStopRecord& record, NetworkSnapshot& snapshot)
+{
+    record.id = row.get<unsigned int>("id", 0);
+    record.code = snapshot.addString(row.get<std::string>("code", ""));
+    record.segmentId = row.get<unsigned int>("section_id", 0);
+    record.name = snapshot.addString(row.get<std::string>("name", ""));
+    record.status = snapshot.addString(row.get<std::string>("status", ""));
+    record.terminal = row.get<int>("terminal", 0);
+    record.length = row.get<double>("length", 0.0);
+    record.offset = row.get<double>("section_offset", 0.0);
+    record.reverseSection = row.get<unsigned int>("reverse_section", 0);
+    record.terminalNode = row.get<unsigned int>("terminal_node", 0);
+    record.x = row.get<double>("x", 0);
+    record.y = row.get<double>("y", 0);
+    record.z = row.get<double>("z", 0);
+}
+
+void readRow(const soci::row& row, TaxiStandRecord& record, NetworkSnapshot& snapshot)
+{
+    record.id = row.get<unsigned int>("id", 0);
+    record.segmentId = row.get<unsigned int>("segment_id", 0);
+    record.length = row.get<double>("length", 0.0);
+    record.offset = row.get<double>("section_offset", 0.0);
+    record.x = row.get<double>("x", 0);
+    record.y = row.get<double>("y", 0);
+    record.z = row.get<double>("z", 0);
+}
+
+/**
+ * Reads the rows returned by a stored procedure into a table of the snapshot
+ *
+ * @param sql the database connection
+ * @param storedProc the stored procedure; the table is left empty if not provided
+ * @param table the table of the snapshot
+ * @param snapshot the snapshot
+ */
+template<typename Record>
+void readTable(soci::session& sql, const std::string& storedProc, NetworkSnapshotTable table, NetworkSnapshot& snapshot)
+{
+    std::vector<Record> records;
+
+    if (!storedProc.empty())
+    {
+        soci::rowset<soci::row> rows = (sql.prepare << "select * from " + storedProc);
+
+        for (soci::rowset<soci::row>::const_iterator itRows = rows.begin(); itRows != rows.end(); ++itRows)
+        {
+            //Value-initialised, so that the unused fields are written as zeros
+            Record record = Record();
+            readRow(*itRows, record, snapshot);
+            records.push_back(record);
+        }
+    }
+
+    snapshot.setRecords(table, records);
+}
+
+//Creation of the network objects from the records, with the unit conversions done by the setters
+
+void fromRecord(const NodeRecord& record, const NetworkSnapshot& snapshot, Node& res)
+{
+    res.setNodeId(record.id);
+    res.setNodeType((sim_mob::NodeType)record.nodeType);
+    res.setTrafficLightId(record.trafficLightId);
+    res.setLocation(Point(record.x, record.y, record.z));
+}
+
+void fromRecord(const LinkRecord& record, const NetworkSnapshot& snapshot, Link& res)
+{
+    res.setLinkId(record.id);
+    res.setFromNodeId(record.fromNode);
+    res.setLinkCategory((sim_mob::LinkCategory)record.category);
+    res.setLinkType((sim_mob::LinkType)record.roadType);
+    res.setRoadName(snapshot.getString(record.roadName));
+    res.setToNodeId(record.toNode);
+}
+
+void fromRecord(const RoadSegmentRecord& record, const NetworkSnapshot& snapshot, RoadSegment& res)
+{
+    res.setRoadSegmentId(record.id);
+    res.setCapacity(record.capacity);
+    res.setLinkId(record.linkId);
+    res.setMaxSpeed((double)record.maxSpeed);
+    res.setSequenceNumber(record.sequenceNumber);
+}
+
+void fromRecord(const PolyPointRecord& record, const NetworkSnapshot& snapshot, PolyPoint& res)
+{
+    res.setPolyLineId(record.polyLineId);
+    res.setSequenceNumber(record.sequenceNumber);
+    res.setX(record.x);
+    res.setY(record.y);
+    res.setZ(record.z);
+}
+
+void fromRecord(const LaneRecord& record, const NetworkSnapshot& snapshot, Lane& res)
+{
+    res.setLaneId(record.id);
+    res.setBusLaneRules((sim_mob::BusLaneRules)record.busLane);
+    res.setCanVehiclePark(record.canPark);
+    res.setCanVehicleStop(record.canStop);
+    res.setHasRoadShoulder(record.hasRoadShoulder);
+    res.setHighOccupancyVehicleAllowed(record.highOccupancyVehicle);
+    res.setRoadSegmentId(record.segmentId);
+    res.setWidth(record.width);
+}
+
+void fromRecord(const LaneConnectorRecord& record, const NetworkSnapshot& snapshot, LaneConnector& res)
+{
+    res.setLaneConnectionId(record.id);
+    res.setFromLaneId(record.fromLane);
+    res.setFromRoadSegmentId(record.fromSegment);
+    res.setToLaneId(record.toLane);
+    res.setToRoadSegmentId(record.toSegment);
+    res.setIsTrueConnector(record.isTrueConnector);
+}
+
+void fromRecord(const TurningGroupRecord& record, const NetworkSnapshot& snapshot, TurningGroup& res)
+{
+    res.setTurningGroupId(record.id);
+    res.setFromLinkId(record.fromLink);
+    res.setNodeId(record.nodeId);
+    res.setPhases(snapshot.getString(record.phases));
+    res.setRule((sim_mob::TurningGroupRule)record.rules);
+    res.setToLinkId(record.toLink);
+    res.setVisibility(record.visibility);
+}
+
+void fromRecord(const TurningPathRecord& record, const NetworkSnapshot& snapshot, TurningPath& res)
+{
+    res.setTurningPathId(record.id);
+    res.setFromLaneId(record.fromLane);
+    res.setMaxSpeed((double)record.maxSpeed);
+    res.setToLaneId(record.toLane);
+    res.setTurningGroupId(record.groupId);
+}
+
+void fromRecord(const TurningConflictRecord& record, const NetworkSnapshot& snapshot, TurningConflict& res)
+{
+    res.setConflictId(record.id);
+    res.setCriticalGap(record.criticalGap);
+    res.setFirstConflictDistance(record.firstConflictDistance);
+    res.setFirstTurningId(record.firstTurningId);
+    res.setPriority(record.priority);
+    res.setSecondConflictDistance(record.secondConflictDistance);
+    res.setSecondTurningId(record.secondTurningId);
+}
+
+void fromRecord(const BusStopRecord& record, const NetworkSnapshot& snapshot, BusStop& res)
+{
+    res.setStopId(record.id);
+    res.setRoadItemId(record.id);
+    res.setStopCode(snapshot.getString(record.code));
+    res.setRoadSegmentId(record.segmentId);
+    res.setStopName(snapshot.getString(record.name));
+    res.setStopStatus(snapshot.getString(record.status));
+    res.setTerminusType((sim_mob::TerminusType)record.terminal);
+    res.setLength(record.length);
+    res.setOffset(record.offset);
+    res.setReverseSectionId(record.reverseSection);
+    res.setTerminalNodeId(record.terminalNode);
+    res.setStopLocation(Point(record.x, record.y, record.z));
+}
+
+void fromRecord(const TaxiStandRecord& record, const NetworkSnapshot& snapshot, TaxiStand& res)
+{
+    res.setStandId(record.id);
+    res.setRoadItemId(record.id);
+    res.setRoadSegmentId(record.segmentId);
+    res.setLength(record.length);
+    res.setOffset(record.offset);
+    res.setLocation(Point(record.x, record.y, record.z));
+}
 }
 
 NetworkLoader::NetworkLoader() : roadNetwork(RoadNetwork::getWritableInstance()), isNetworkLoaded(false)
@@ -78,13 +377,14 @@ NetworkLoader::~NetworkLoader()
 
 void NetworkLoader::loadLanes(const std::string& storedProc)
 {
-    //SQL statement
-    soci::rowset<Lane> lanes = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const LaneRecord* records = snapshot->getRecords<LaneRecord>(SNAPSHOT_LANES, numRecords);
 
-    for (soci::rowset<Lane>::const_iterator itLanes = lanes.begin(); itLanes != lanes.end(); ++itLanes)
+    for (const LaneRecord* itLanes = records; itLanes != records + numRecords; ++itLanes)
     {
         //Create new lane and add it to the segment to which it belongs
-        Lane *lane = new Lane(*itLanes);
+        Lane *lane = new Lane();
+        fromRecord(*itLanes, *snapshot, *lane);
 
         try
         {
@@ -115,14 +415,15 @@ void NetworkLoader::loadLanes(const std::string& storedProc)
 
 void NetworkLoader::loadLaneConnectors(const std::string& storedProc)
 {
-    //SQL statement
-    soci::rowset<LaneConnector> connectors = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const LaneConnectorRecord* records = snapshot->getRecords<LaneConnectorRecord>(SNAPSHOT_LANE_CONNECTORS, numRecords);
     unsigned long connectorsLoaded = 0;
 
-    for (soci::rowset<LaneConnector>::const_iterator itConnectors = connectors.begin(); itConnectors != connectors.end(); ++itConnectors)
+    for (const LaneConnectorRecord* itConnectors = records; itConnectors != records + numRecords; ++itConnectors)
     {
         //Create new lane connector and add it to the lane to which it belongs
-        LaneConnector *connector = new LaneConnector(*itConnectors);
+        LaneConnector *connector = new LaneConnector();
+        fromRecord(*itConnectors, *snapshot, *connector);
 
         try
         {
@@ -152,14 +453,15 @@ void NetworkLoader::loadLaneConnectors(const std::string& storedProc)
 
 void NetworkLoader::loadLanePolyLines(const std::string& storedProc)
 {
-    //SQL statement
-    soci::rowset<PolyPoint> points = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const PolyPointRecord* records = snapshot->getRecords<PolyPointRecord>(SNAPSHOT_LANE_POLYLINES, numRecords);
     unsigned int prevLineId = 0, linesLoaded = 0;
 
-    for (soci::rowset<PolyPoint>::const_iterator itPoints = points.begin(); itPoints != points.end(); ++itPoints)
+    for (const PolyPointRecord* itPoints = records; itPoints != records + numRecords; ++itPoints)
     {
         //Create new point and add it to the poly-line, to which it belongs
-        PolyPoint point(*itPoints);
+        PolyPoint point;
+        fromRecord(*itPoints, *snapshot, point);
 
         try
         {
@@ -194,13 +496,14 @@ void NetworkLoader::loadLanePolyLines(const std::string& storedProc)
 
 void NetworkLoader::loadLinks(const std::string& storedProc)
 {
-    //SQL statement
-    soci::rowset<Link> links = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const LinkRecord* records = snapshot->getRecords<LinkRecord>(SNAPSHOT_LINKS, numRecords);
 
-    for (soci::rowset<Link>::const_iterator itLinks = links.begin(); itLinks != links.end(); ++itLinks)
+    for (const LinkRecord* itLinks = records; itLinks != records + numRecords; ++itLinks)
     {
         //Create new node and add it in the map of nodes
-        Link* link = new Link(*itLinks);
+        Link* link = new Link();
+        fromRecord(*itLinks, *snapshot, *link);
 
         try
         {
@@ -231,13 +534,14 @@ void NetworkLoader::loadLinks(const std::string& storedProc)
 
 void NetworkLoader::loadNodes(const std::string& storedProc)
 {
-    //SQL statement
-    soci::rowset<Node> nodes = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const NodeRecord* records = snapshot->getRecords<NodeRecord>(SNAPSHOT_NODES, numRecords);
     std::set<sim_mob::Node*> nodesSet;
-    for (soci::rowset<Node>::const_iterator itNodes = nodes.begin(); itNodes != nodes.end(); ++itNodes)
+    for (const NodeRecord* itNodes = records; itNodes != records + numRecords; ++itNodes)
     {
         //Create new node and add it in the map of nodes
-        Node* node = new Node(*itNodes);
+        Node* node = new Node();
+        fromRecord(*itNodes, *snapshot, *node);
         roadNetwork->addNode(node);
         nodesSet.insert(node);
     }
@@ -261,13 +565,14 @@ void NetworkLoader::loadNodes(const std::string& storedProc)
 
 void NetworkLoader::loadRoadSegments(const std::string& storedProc)
 {
-    //SQL statement
-    soci::rowset<RoadSegment> segments = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const RoadSegmentRecord* records = snapshot->getRecords<RoadSegmentRecord>(SNAPSHOT_ROAD_SEGMENTS, numRecords);
 
-    for (soci::rowset<RoadSegment>::const_iterator itSegments = segments.begin(); itSegments != segments.end(); ++itSegments)
+    for (const RoadSegmentRecord* itSegments = records; itSegments != records + numRecords; ++itSegments)
     {
         //Create new road segment and add it to the link to which it belongs
-        RoadSegment *segment = new RoadSegment(*itSegments);
+        RoadSegment *segment = new RoadSegment();
+        fromRecord(*itSegments, *snapshot, *segment);
 
         try
         {
@@ -298,14 +603,15 @@ void NetworkLoader::loadRoadSegments(const std::string& storedProc)
 
 void NetworkLoader::loadSegmentPolyLines(const std::string& storedProc)
 {
-    //SQL statement
-    soci::rowset<PolyPoint> points = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const PolyPointRecord* records = snapshot->getRecords<PolyPointRecord>(SNAPSHOT_SEGMENT_POLYLINES, numRecords);
     unsigned int prevLineId = 0, linesLoaded = 0;
 
-    for (soci::rowset<PolyPoint>::const_iterator itPoints = points.begin(); itPoints != points.end(); ++itPoints)
+    for (const PolyPointRecord* itPoints = records; itPoints != records + numRecords; ++itPoints)
     {
         //Create new point and add it to the poly-line, to which it belongs
-        PolyPoint point(*itPoints);
+        PolyPoint point;
+        fromRecord(*itPoints, *snapshot, point);
 
         try
         {
@@ -340,13 +646,14 @@ void NetworkLoader::loadSegmentPolyLines(const std::string& storedProc)
 
 void NetworkLoader::loadTurningConflicts(const std::string& storedProc)
 {
-    //SQL statement
-    soci::rowset<TurningConflict> turningConflicts = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const TurningConflictRecord* records = snapshot->getRecords<TurningConflictRecord>(SNAPSHOT_TURNING_CONFLICTS, numRecords);
 
-    for (soci::rowset<TurningConflict>::const_iterator itTurningConflicts = turningConflicts.begin(); itTurningConflicts != turningConflicts.end(); ++itTurningConflicts)
+    for (const TurningConflictRecord* itTurningConflicts = records; itTurningConflicts != records + numRecords; ++itTurningConflicts)
     {
         //Create new turning conflict and add it to the turning paths to which it belongs
-        TurningConflict* turningConflict = new TurningConflict(*itTurningConflicts);
+        TurningConflict* turningConflict = new TurningConflict();
+        fromRecord(*itTurningConflicts, *snapshot, *turningConflict);
 
         try
         {
@@ -368,13 +675,14 @@ void NetworkLoader::loadTurningConflicts(const std::string& storedProc)
 
 void NetworkLoader::loadTurningGroups(const std::string& storedProc)
 {
-    //SQL statement
-    soci::rowset<TurningGroup> turningGroups = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const TurningGroupRecord* records = snapshot->getRecords<TurningGroupRecord>(SNAPSHOT_TURNING_GROUPS, numRecords);
 
-    for (soci::rowset<TurningGroup>::const_iterator itTurningGroups = turningGroups.begin(); itTurningGroups != turningGroups.end(); ++itTurningGroups)
+    for (const TurningGroupRecord* itTurningGroups = records; itTurningGroups != records + numRecords; ++itTurningGroups)
     {
         //Create new turning group and add it in the map of turning groups
-        TurningGroup* turningGroup = new TurningGroup(*itTurningGroups);
+        TurningGroup* turningGroup = new TurningGroup();
+        fromRecord(*itTurningGroups, *snapshot, *turningGroup);
 
         try
         {
@@ -405,13 +713,14 @@ void NetworkLoader::loadTurningGroups(const std::string& storedProc)
 
 void NetworkLoader::loadTurningPaths(const std::string& storedProc)
 {
-    //SQL statement
-    soci::rowset<TurningPath> turningPaths = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const TurningPathRecord* records = snapshot->getRecords<TurningPathRecord>(SNAPSHOT_TURNING_PATHS, numRecords);
 
-    for (soci::rowset<TurningPath>::const_iterator itTurningPaths = turningPaths.begin(); itTurningPaths != turningPaths.end(); ++itTurningPaths)
+    for (const TurningPathRecord* itTurningPaths = records; itTurningPaths != records + numRecords; ++itTurningPaths)
     {
         //Create new turning path and add it in the map of turning paths
-        TurningPath* turningPath = new TurningPath(*itTurningPaths);
+        TurningPath* turningPath = new TurningPath();
+        fromRecord(*itTurningPaths, *snapshot, *turningPath);
 
         try
         {
@@ -442,14 +751,15 @@ void NetworkLoader::loadTurningPaths(const std::string& storedProc)
 
 void NetworkLoader::loadTurningPolyLines(const std::string& storedProc)
 {
-    //SQL statement
-    soci::rowset<PolyPoint> points = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const PolyPointRecord* records = snapshot->getRecords<PolyPointRecord>(SNAPSHOT_TURNING_POLYLINES, numRecords);
     unsigned int prevLineId = 0, linesLoaded = 0;
 
-    for (soci::rowset<PolyPoint>::const_iterator itPoints = points.begin(); itPoints != points.end(); ++itPoints)
+    for (const PolyPointRecord* itPoints = records; itPoints != records + numRecords; ++itPoints)
     {
         //Create new point and add it to the poly-line, to which it belongs
-        PolyPoint point(*itPoints);
+        PolyPoint point;
+        fromRecord(*itPoints, *snapshot, point);
 
         try
         {
@@ -494,15 +804,16 @@ void NetworkLoader::loadTaxiStands(const std::string& storedProc)
         return;
     }
 
-    //SQL statement
-    soci::rowset<sim_mob::TaxiStand> stands = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const TaxiStandRecord* records = snapshot->getRecords<TaxiStandRecord>(SNAPSHOT_TAXI_STANDS, numRecords);
     std::set<sim_mob::TaxiStand*> standSet;
-    for (soci::rowset<TaxiStand>::const_iterator itStand = stands.begin(); itStand != stands.end(); ++itStand)
+    for (const TaxiStandRecord* itStand = records; itStand != records + numRecords; ++itStand)
     {
         try
         {
             //Create new taxi stand and add it to road network
-            TaxiStand* stand = new TaxiStand(*itStand);
+            TaxiStand* stand = new TaxiStand();
+            fromRecord(*itStand, *snapshot, *stand);
             roadNetwork->addTaxiStand(stand);
             standSet.insert(stand);
             TaxiStand::allTaxiStandMap.update(standSet);
@@ -534,24 +845,14 @@ void NetworkLoader::loadSurveillanceStns(const string &storedProc)
 {
     if(!storedProc.empty())
     {
-        //SQL statement
-        soci::rowset<soci::row> surveillanceStns = (sql.prepare << "select * from " + storedProc);
-
-        unsigned int id, type, code, segmentId, trafficLight;
-        double zone, offset;
+        size_t numRecords = 0;
+        const TrafficSensorRecord* records = snapshot->getRecords<TrafficSensorRecord>(SNAPSHOT_TRAFFIC_SENSORS, numRecords);
 
-        for(soci::rowset<soci::row>::const_iterator itStn = surveillanceStns.begin(); itStn != surveillanceStns.end(); ++itStn)
+        for(const TrafficSensorRecord* itStn = records; itStn != records + numRecords; ++itStn)
         {
-            id = (*itStn).get<unsigned int>(0);
-            type = (*itStn).get<unsigned int>(1);
-            code = (*itStn).get<unsigned int>(2);
-            zone = (*itStn).get<double>(3);
-            offset = (*itStn).get<double>(4);
-            segmentId = (*itStn).get<unsigned int>(5);
-            trafficLight = (*itStn).get<unsigned int>(6);
-
             //Create a new surveillance station and add it to the network
-            SurveillanceStation *station = new SurveillanceStation(id, type, code, zone, offset, segmentId, trafficLight);
+            SurveillanceStation *station = new SurveillanceStation(itStn->id, itStn->type, itStn->code, itStn->zone,
+                                                                   itStn->offset, itStn->segmentId, itStn->trafficLight);
 
             try
             {
@@ -603,23 +904,26 @@ void NetworkLoader::loadBusStops(const std::string& storedProc)
         return;
     }
 
-    //SQL statement
-    soci::rowset<sim_mob::BusStop> stops = (sql.prepare << "select * from " + storedProc);
+    size_t numRecords = 0;
+    const BusStopRecord* records = snapshot->getRecords<BusStopRecord>(SNAPSHOT_BUS_STOPS, numRecords);
 
-    for (soci::rowset<BusStop>::const_iterator itStop = stops.begin(); itStop != stops.end(); ++itStop)
+    for (const BusStopRecord* itRecord = records; itRecord != records + numRecords; ++itRecord)
     {
-        if (!sim_mob::ConfigManager::GetInstance().FullConfig().isGenerateBusRoutes() && itStop->getStopName().find("Virtual Bus Stop") != std::string::npos)
+        BusStop busStop;
+        fromRecord(*itRecord, *snapshot, busStop);
+
+        if (!sim_mob::ConfigManager::GetInstance().FullConfig().isGenerateBusRoutes() && busStop.getStopName().find("Virtual Bus Stop") != std::string::npos)
         {
             continue;
         }
         
-        if (!itStop->getStopStatus().compare("NOP"))
+        if (!busStop.getStopStatus().compare("NOP"))
         {
             continue;
         }
 
         //Create new bus stop and add it to road network
-        BusStop* stop = new BusStop(*itStop);
+        BusStop* stop = new BusStop(busStop);
 
         //hackish data validation to evade errors
         if(stop->getLength() < sim_mob::BUS_LENGTH)
@@ -820,12 +1124,65 @@ void NetworkLoader::loadSMSVehicleParking(const std::string &storedProc)
 }
 
 
+void NetworkLoader::readTables(const map<string, string>& storedProcs)
+{
+    readTable<NodeRecord>(sql, getStoredProcedure(storedProcs, "nodes"), SNAPSHOT_NODES, *snapshot);
+    readTable<LinkRecord>(sql, getStoredProcedure(storedProcs, "links"), SNAPSHOT_LINKS, *snapshot);
+    readTable<RoadSegmentRecord>(sql, getStoredProcedure(storedProcs, "road_segments"), SNAPSHOT_ROAD_SEGMENTS, *snapshot);
+    readTable<PolyPointRecord>(sql, getStoredProcedure(storedProcs, "segment_polylines"), SNAPSHOT_SEGMENT_POLYLINES, *snapshot);
+    readTable<LaneRecord>(sql, getStoredProcedure(storedProcs, "lanes"), SNAPSHOT_LANES, *snapshot);
+    readTable<PolyPointRecord>(sql, getStoredProcedure(storedProcs, "lane_polylines"), SNAPSHOT_LANE_POLYLINES, *snapshot);
+    readTable<LaneConnectorRecord>(sql, getStoredProcedure(storedProcs, "lane_connectors"), SNAPSHOT_LANE_CONNECTORS, *snapshot);
+    readTable<TurningGroupRecord>(sql, getStoredProcedure(storedProcs, "turning_groups"), SNAPSHOT_TURNING_GROUPS, *snapshot);
+    readTable<TurningPathRecord>(sql, getStoredProcedure(storedProcs, "turning_paths"), SNAPSHOT_TURNING_PATHS, *snapshot);
+    readTable<PolyPointRecord>(sql, getStoredProcedure(storedProcs, "turning_polylines"), SNAPSHOT_TURNING_POLYLINES, *snapshot);
+    readTable<TurningConflictRecord>(sql, getStoredProcedure(storedProcs, "turning_conflicts"), SNAPSHOT_TURNING_CONFLICTS, *snapshot);
+    readTable<TrafficSensorRecord>(sql, getStoredProcedure(storedProcs, "traffic_sensors", false), SNAPSHOT_TRAFFIC_SENSORS, *snapshot);
+    readTable<BusStopRecord>(sql, getStoredProcedure(storedProcs, "bus_stops", false), SNAPSHOT_BUS_STOPS, *snapshot);
+    readTable<TaxiStandRecord>(sql, getStoredProcedure(storedProcs, "taxi_stands", false), SNAPSHOT_TAXI_STANDS, *snapshot);
+}
+
 void NetworkLoader::loadNetwork(const string& connectionStr, const map<string, string>& storedProcs)
 {
     try
     {
-        //Open the connection to the database
-        sql.open(soci::postgresql, connectionStr);
+        const NetworkSnapshotParams& snapshotParams = ConfigManager::GetInstance().FullConfig().networkSnapshot;
+        snapshot.reset(new NetworkSnapshot(getSnapshotKey(storedProcs)));
+        bool loadedFromSnapshot = false;
+
+        //Map the tables from the snapshot, if it was created from the same stored procedures
+        if (!snapshotParams.file.empty() && !snapshotParams.rebuild)
+        {
+            try
+            {
+                snapshot->load(snapshotParams.file);
+                loadedFromSnapshot = true;
+            }
+            catch (runtime_error const &err)
+            {
+                Warn() << err.what() << "\nLoading the network from the database\n";
+            }
+        }
+
+        //Otherwise, read them from the database and save them for the next run
+        if (!loadedFromSnapshot)
+        {
+            sql.open(soci::postgresql, connectionStr);
+            readTables(storedProcs);
+            sql.close();
+
+            if (!snapshotParams.file.empty())
+            {
+                try
+                {
+                    snapshot->save(snapshotParams.file);
+                }
+                catch (runtime_error const &err)
+                {
+                    Warn() << err.what() << "\n";
+                }
+            }
+        }
 
         //Load the components of the network
 
@@ -864,16 +1221,24 @@ void NetworkLoader::loadNetwork(const string& connectionStr, const map<string, s
         //loadParkingSlots(getStoredProcedure(storedProcs, "parking_slots", false));
 
         loadTaxiStands(getStoredProcedure(storedProcs, "taxi_stands", false));
+        //The parking depends on the simulation period, so it is not part of the snapshot
         loadSMSVehicleParking(getStoredProcedure(storedProcs, "sms_parking", false));
 
-        //Close the connection
-        sql.close();
+        //Unmap the snapshot; the network objects hold copies of the data
+        snapshot.reset();
 
         roadNetwork->loadLoopNodesOfNetwork();
 
         isNetworkLoaded = true;
 
-        Print() << "\nSimMobility Road Network loaded from database\n";
+        if (loadedFromSnapshot)
+        {
+            Print() << "\nSimMobility Road Network loaded from snapshot " << snapshotParams.file << "\n";
+        }
+        else
+        {
+            Print() << "\nSimMobility Road Network loaded from database\n";
+        }
     }
     catch (soci::soci_error const &err)
     {
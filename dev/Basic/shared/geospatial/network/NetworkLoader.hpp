@@ -6,6 +6,7 @@
 
 #include <map>
 #include <string>
+#include <boost/scoped_ptr.hpp>
 #include <soci/soci.h>
 #include <soci/postgresql/soci-postgresql.h>
 #include "RoadNetwork.hpp"
@@ -16,6 +17,8 @@ namespace sim_mob
 {
 
 class RoadNetwork;
+class NetworkSnapshot;
+
 /**
  * class for loading the network for simulation
  * \author Neeraj D
@@ -33,6 +36,9 @@ private:
     /**The database connection session*/
     soci::session sql;
 
+    /**The tables of the network being loaded, read from the database or mapped from a snapshot file*/
+    boost::scoped_ptr<NetworkSnapshot> snapshot;
+
     /**Indicates whether the road network has been loaded successfully*/
     bool isNetworkLoaded;
 
@@ -40,93 +46,100 @@ private:
     NetworkLoader();
 
     /**
-     * Loads the lanes using the given stored procedure
+     * Reads the rows returned by the stored procedures of the network into the tables of the snapshot
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProcs - the map of stored procedures
+     */
+    void readTables(const map<string, string>& storedProcs);
+
+    /**
+     * Loads the lanes from the snapshot tables
+     *
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadLanes(const std::string& storedProc);
 
     /**
-     * Loads the lane connectors using the given stored procedure
+     * Loads the lane connectors from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadLaneConnectors(const std::string& storedProc);
 
     /**
-     * Loads the lane poly-lines using the given stored procedure
+     * Loads the lane poly-lines from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadLanePolyLines(const std::string& storedProc);
 
     /**
-     * Loads the Links using the given stored procedure
+     * Loads the Links from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadLinks(const std::string& storedProc);
 
     /**
-     * Loads the Nodes using the given stored procedure
+     * Loads the Nodes from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadNodes(const std::string& storedProc);
 
     /**
-     * Load the road segments using the given stored procedure
+     * Load the road segments from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadRoadSegments(const std::string& storedProc);
 
     /**
-     * Loads the road segment poly-lines using the given stored procedure
+     * Loads the road segment poly-lines from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadSegmentPolyLines(const std::string& storedProc);
 
     /**
-     * Loads the turning conflicts using the given stored procedure
+     * Loads the turning conflicts from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadTurningConflicts(const std::string& storedProc);
 
     /**
-     * Loads the turning groups using the given stored procedure
+     * Loads the turning groups from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadTurningGroups(const std::string& storedProc);
 
     /**
-     * Loads the turning paths using the given stored procedure
+     * Loads the turning paths from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadTurningPaths(const std::string& storedProc);
 
     /**
-     * Loads the poly-lines associated with the turnings using the given stored procedure
+     * Loads the poly-lines associated with the turnings from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadTurningPolyLines(const std::string& storedProc);
 
     /**
-     * Loads bus stops associated with parent road segment using the given stored procedure
+     * Loads bus stops associated with parent road segment from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadBusStops(const std::string& storedProc);
 
     /**
-     * Loads taxi stands associated with parent road segment using the given stored procedure
+     * Loads taxi stands associated with parent road segment from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadTaxiStands(const std::string& storedProc);
     
@@ -145,9 +158,9 @@ private:
     void loadSMSVehicleParking(const std::string &storedProc);
 
     /**
-     * Loads the surveillance stations and traffic sensors within the network using the given stored procedure
+     * Loads the surveillance stations and traffic sensors within the network from the snapshot tables
      *
-     * @param storedProc - the stored procedure to be executed in order to retrieve the data
+     * @param storedProc - the stored procedure the data was retrieved with (empty if not provided)
      */
     void loadSurveillanceStns(const std::string& storedProc);
 
@@ -159,7 +172,9 @@ public:
 
     /**
      * Connects to the database using the given connection string and then loads the components of the
-     * network from the database using the stored procedures specified in the given map of stored procedures
+     * network from the database using the stored procedures specified in the given map of stored procedures.
+     * If a network snapshot is configured, the components are loaded from the snapshot instead when it was
+     * created from the same stored procedures, and the snapshot is (re)created from the database otherwise
      *
      * @param connectionStr - the database connection string
      * @param storedProcs - the map of stored procedures
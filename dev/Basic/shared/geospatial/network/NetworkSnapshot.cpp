@@ -0,0 +1,346 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "NetworkSnapshot.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+using namespace sim_mob;
+
+namespace
+{
+const char MAGIC[8] = {'S', 'M', 'N', 'E', 'T', 'S', 'S', '1'};
+
+/** Fixed part at the start of a snapshot file */
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t numTables;
+    uint64_t fileSize;
+    uint64_t checksum;
+    uint32_t keyLength;
+    uint32_t unused;
+};
+
+/** Entry of the table directory */
+struct TableEntry
+{
+    uint32_t id;
+    uint32_t recordSize;
+    uint64_t numRecords;
+    uint64_t offset;
+};
+
+uint64_t padded(uint64_t size)
+{
+    return (size + 7) & ~uint64_t(7);
+}
+
+/**
+ * FNV-1a hash over the 64-bit words of the data following the header. Fast enough to check a snapshot of the whole
+ * network on every start, and catches truncated or partly overwritten files.
+ */
+class Checksum
+{
+public:
+    Checksum() : hash(14695981039346656037ULL), numPending(0)
+    {
+    }
+
+    void update(const char* data, std::size_t size)
+    {
+        while (size > 0 && numPending > 0)
+        {
+            addByte(*data++);
+            --size;
+        }
+        for (; size >= 8; data += 8, size -= 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, data, 8);
+            addWord(word);
+        }
+        while (size > 0)
+        {
+            addByte(*data++);
+            --size;
+        }
+    }
+
+    /** @return the hash; the data must be a multiple of 8 bytes long */
+    uint64_t get() const
+    {
+        return hash;
+    }
+
+private:
+    void addByte(char byte)
+    {
+        pending[numPending++] = byte;
+        if (numPending == 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, pending, 8);
+            addWord(word);
+            numPending = 0;
+        }
+    }
+
+    void addWord(uint64_t word)
+    {
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+
+    uint64_t hash;
+    char pending[8];
+    std::size_t numPending;
+};
+
+/** Writes to the file and to the checksum */
+class Writer
+{
+public:
+    explicit Writer(std::ofstream& file) : file(file), written(0)
+    {
+    }
+
+    void write(const void* data, std::size_t size)
+    {
+        file.write(static_cast<const char*>(data), size);
+        checksum.update(static_cast<const char*>(data), size);
+        written += size;
+    }
+
+    /** Pads the data written so far to a multiple of 8 bytes */
+    void pad()
+    {
+        const char zeros[8] = {0};
+        write(zeros, padded(written) - written);
+    }
+
+    uint64_t getChecksum() const
+    {
+        return checksum.get();
+    }
+
+private:
+    std::ofstream& file;
+    Checksum checksum;
+    uint64_t written;
+};
+}
+
+NetworkSnapshot::NetworkSnapshot(const std::string& key) : key(key)
+{
+}
+
+NetworkSnapshot::~NetworkSnapshot()
+{
+}
+
+void NetworkSnapshot::clear()
+{
+    tables.clear();
+    strings.clear();
+    region.reset();
+}
+
+void NetworkSnapshot::load(const std::string& fileName)
+{
+    clear();
+
+    try
+    {
+        boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+        region.reset(new boost::interprocess::mapped_region(file, boost::interprocess::read_only));
+    }
+    catch (boost::interprocess::interprocess_exception& ex)
+    {
+        clear();
+        throw std::runtime_error("Network snapshot: cannot map " + fileName + ": " + ex.what());
+    }
+
+    const char* begin = static_cast<const char*>(region->get_address());
+    const uint64_t size = region->get_size();
+
+    try
+    {
+        FileHeader header;
+        if (size < sizeof(header))
+        {
+            throw std::runtime_error("truncated header");
+        }
+        std::memcpy(&header, begin, sizeof(header));
+
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            throw std::runtime_error("not a network snapshot");
+        }
+        if (header.version != VERSION)
+        {
+            throw std::runtime_error("unsupported version");
+        }
+        if (header.fileSize != size || size % 8 != 0)
+        {
+            throw std::runtime_error("truncated file");
+        }
+
+        Checksum checksum;
+        checksum.update(begin + sizeof(header), size - sizeof(header));
+        if (checksum.get() != header.checksum)
+        {
+            throw std::runtime_error("checksum mismatch");
+        }
+
+        //Everything after the header is covered by the checksum, but the sizes are still checked so that a file
+        //written by a faulty version cannot make us read outside the mapping
+        const uint64_t keyOffset = sizeof(header);
+        const uint64_t directoryOffset = keyOffset + padded(header.keyLength);
+        const uint64_t directoryEnd = directoryOffset + uint64_t(header.numTables) * sizeof(TableEntry);
+        if (directoryEnd > size)
+        {
+            throw std::runtime_error("truncated table directory");
+        }
+        if (std::string(begin + keyOffset, header.keyLength) != key)
+        {
+            throw std::runtime_error("created from another source");
+        }
+
+        for (uint32_t i = 0; i < header.numTables; ++i)
+        {
+            TableEntry entry;
+            std::memcpy(&entry, begin + directoryOffset + i * sizeof(TableEntry), sizeof(entry));
+
+            if (entry.recordSize == 0 || (entry.id == SNAPSHOT_STRINGS && entry.recordSize != 1)
+                    || entry.offset % 8 != 0 || entry.offset < directoryEnd || entry.offset > size
+                    || entry.numRecords > (size - entry.offset) / entry.recordSize)
+            {
+                throw std::runtime_error("invalid table");
+            }
+
+            Table& table = tables[entry.id];
+            table.recordSize = entry.recordSize;
+            table.numRecords = entry.numRecords;
+            table.data = begin + entry.offset;
+        }
+    }
+    catch (std::runtime_error& ex)
+    {
+        clear();
+        throw std::runtime_error("Network snapshot: cannot load " + fileName + ": " + ex.what());
+    }
+}
+
+void NetworkSnapshot::save(const std::string& fileName) const
+{
+    const std::string tmpFileName = fileName + ".tmp";
+    std::ofstream file(tmpFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("Network snapshot: cannot create " + tmpFileName);
+    }
+
+    //The string table is written as any other table (a mapped snapshot already has it among its tables)
+    std::map<uint32_t, const Table*> written;
+    for (std::map<uint32_t, Table>::const_iterator it = tables.begin(); it != tables.end(); ++it)
+    {
+        written[it->first] = &it->second;
+    }
+    Table stringTable;
+    stringTable.recordSize = 1;
+    stringTable.numRecords = strings.size();
+    stringTable.data = strings.data();
+    written.insert(std::make_pair(uint32_t(SNAPSHOT_STRINGS), &stringTable));
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.numTables = written.size();
+    header.keyLength = key.size();
+
+    //Place the tables after the directory
+    std::vector<TableEntry> directory;
+    uint64_t offset = sizeof(header) + padded(key.size()) + written.size() * sizeof(TableEntry);
+    for (std::map<uint32_t, const Table*>::const_iterator it = written.begin(); it != written.end(); ++it)
+    {
+        TableEntry entry;
+        entry.id = it->first;
+        entry.recordSize = it->second->recordSize;
+        entry.numRecords = it->second->numRecords;
+        entry.offset = offset;
+        directory.push_back(entry);
+        offset += padded(entry.recordSize * entry.numRecords);
+    }
+    header.fileSize = offset;
+
+    //Write the header last, once the checksum is known
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    Writer writer(file);
+    writer.write(key.data(), key.size());
+    writer.pad();
+    writer.write(directory.data(), directory.size() * sizeof(TableEntry));
+    for (std::map<uint32_t, const Table*>::const_iterator it = written.begin(); it != written.end(); ++it)
+    {
+        writer.write(it->second->data, it->second->recordSize * it->second->numRecords);
+        writer.pad();
+    }
+    header.checksum = writer.getChecksum();
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+
+    if (file.fail())
+    {
+        std::remove(tmpFileName.c_str());
+        throw std::runtime_error("Network snapshot: cannot write " + tmpFileName);
+    }
+    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    {
+        std::remove(tmpFileName.c_str());
+        throw std::runtime_error("Network snapshot: cannot rename " + tmpFileName + " to " + fileName);
+    }
+}
+
+SnapshotString NetworkSnapshot::addString(const std::string& text)
+{
+    if (isMapped())
+    {
+        throw std::runtime_error("Network snapshot: a mapped snapshot cannot be modified");
+    }
+    if (strings.size() + text.size() > std::numeric_limits<uint32_t>::max())
+    {
+        throw std::runtime_error("Network snapshot: string table is full");
+    }
+
+    SnapshotString ref;
+    ref.offset = strings.size();
+    ref.length = text.size();
+    strings.append(text);
+    return ref;
+}
+
+std::string NetworkSnapshot::getString(const SnapshotString& ref) const
+{
+    const char* data = strings.data();
+    uint64_t size = strings.size();
+    if (isMapped())
+    {
+        std::map<uint32_t, Table>::const_iterator it = tables.find(SNAPSHOT_STRINGS);
+        data = (it != tables.end()) ? it->second.data : nullptr;
+        size = (it != tables.end()) ? it->second.numRecords : 0;
+    }
+
+    if (uint64_t(ref.offset) + ref.length > size)
+    {
+        throw std::runtime_error("Network snapshot: invalid string reference");
+    }
+    return std::string(data + ref.offset, ref.length);
+}
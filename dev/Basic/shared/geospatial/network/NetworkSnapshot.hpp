@@ -0,0 +1,360 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <map>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+
+namespace boost
+{
+namespace interprocess
+{
+class mapped_region;
+}
+}
+
+namespace sim_mob
+{
+
+/**
+ * \file NetworkSnapshot.hpp
+ *
+ * Compiled snapshot of the road network tables, to load the network without querying the database.
+ *
+ * Each table holds the rows returned by one of the network stored procedures as an array of fixed size records.
+ * Records refer to each other by id (as in the database) and to text by offset into a shared string table, so the
+ * file contains no pointers and is used in place once mapped into memory.
+ *
+ * File layout (native byte order; every section starts at a multiple of 8 bytes):
+ *   header: magic "SMNETSS1" | version (uint32) | number of tables (uint32) | file size (uint64) |
+ *           checksum of everything after the header (uint64) | key length (uint32) | unused (uint32)
+ *   key (padded to 8 bytes): identifies the stored procedures the snapshot was created from
+ *   table directory: for each table: table id (uint32) | record size (uint32) | number of records (uint64) | offset (uint64)
+ *   table data (each padded to 8 bytes)
+ */
+
+/** Tables of a network snapshot */
+enum NetworkSnapshotTable
+{
+    SNAPSHOT_STRINGS = 0,
+    SNAPSHOT_NODES = 1,
+    SNAPSHOT_LINKS = 2,
+    SNAPSHOT_ROAD_SEGMENTS = 3,
+    SNAPSHOT_SEGMENT_POLYLINES = 4,
+    SNAPSHOT_LANES = 5,
+    SNAPSHOT_LANE_POLYLINES = 6,
+    SNAPSHOT_LANE_CONNECTORS = 7,
+    SNAPSHOT_TURNING_GROUPS = 8,
+    SNAPSHOT_TURNING_PATHS = 9,
+    SNAPSHOT_TURNING_POLYLINES = 10,
+    SNAPSHOT_TURNING_CONFLICTS = 11,
+    SNAPSHOT_TRAFFIC_SENSORS = 12,
+    SNAPSHOT_BUS_STOPS = 13,
+    SNAPSHOT_TAXI_STANDS = 14
+};
+
+/** Text in the string table of a snapshot */
+struct SnapshotString
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+/*
+ * Records of the tables, one per row of the corresponding stored procedure. The fields hold the column values as
+ * returned by the database (before any unit conversion); doubles come first so that the records have no implicit
+ * padding.
+ */
+
+/** Row of the "nodes" stored procedure */
+struct NodeRecord
+{
+    double x;
+    double y;
+    double z;
+    uint32_t id;
+    uint32_t nodeType;
+    uint32_t trafficLightId;
+    uint32_t unused;
+};
+
+/** Row of the "links" stored procedure */
+struct LinkRecord
+{
+    uint32_t id;
+    uint32_t fromNode;
+    uint32_t toNode;
+    uint32_t category;
+    uint32_t roadType;
+    uint32_t unused;
+    SnapshotString roadName;
+};
+
+/** Row of the "road_segments" stored procedure */
+struct RoadSegmentRecord
+{
+    uint32_t id;
+    uint32_t capacity;
+    uint32_t linkId;
+    uint32_t maxSpeed;
+    uint32_t sequenceNumber;
+    uint32_t unused;
+};
+
+/** Row of the poly-line stored procedures (segments, lanes and turning paths) */
+struct PolyPointRecord
+{
+    double x;
+    double y;
+    double z;
+    uint32_t polyLineId;
+    uint32_t sequenceNumber;
+};
+
+/** Row of the "lanes" stored procedure */
+struct LaneRecord
+{
+    double width;
+    uint32_t id;
+    uint32_t busLane;
+    uint32_t canPark;
+    uint32_t canStop;
+    uint32_t hasRoadShoulder;
+    uint32_t highOccupancyVehicle;
+    uint32_t segmentId;
+    uint32_t unused;
+};
+
+/** Row of the "lane_connectors" stored procedure */
+struct LaneConnectorRecord
+{
+    uint32_t id;
+    uint32_t fromLane;
+    uint32_t fromSegment;
+    uint32_t toLane;
+    uint32_t toSegment;
+    uint32_t isTrueConnector;
+};
+
+/** Row of the "turning_groups" stored procedure */
+struct TurningGroupRecord
+{
+    double visibility;
+    uint32_t id;
+    uint32_t fromLink;
+    uint32_t nodeId;
+    uint32_t rules;
+    uint32_t toLink;
+    uint32_t unused;
+    SnapshotString phases;
+};
+
+/** Row of the "turning_paths" stored procedure */
+struct TurningPathRecord
+{
+    uint32_t id;
+    uint32_t fromLane;
+    uint32_t maxSpeed;
+    uint32_t toLane;
+    uint32_t groupId;
+    uint32_t unused;
+};
+
+/** Row of the "turning_conflicts" stored procedure */
+struct TurningConflictRecord
+{
+    double criticalGap;
+    double firstConflictDistance;
+    double secondConflictDistance;
+    uint32_t id;
+    uint32_t firstTurningId;
+    uint32_t secondTurningId;
+    uint32_t priority;
+};
+
+/** Row of the "traffic_sensors" stored procedure */
+struct TrafficSensorRecord
+{
+    double zone;
+    double offset;
+    uint32_t id;
+    uint32_t type;
+    uint32_t code;
+    uint32_t segmentId;
+    uint32_t trafficLight;
+    uint32_t unused;
+};
+
+/** Row of the "bus_stops" stored procedure */
+struct BusStopRecord
+{
+    double length;
+    double offset;
+    double x;
+    double y;
+    double z;
+    uint32_t id;
+    uint32_t segmentId;
+    int32_t terminal;
+    uint32_t reverseSection;
+    uint32_t terminalNode;
+    uint32_t unused;
+    SnapshotString code;
+    SnapshotString name;
+    SnapshotString status;
+};
+
+/** Row of the "taxi_stands" stored procedure */
+struct TaxiStandRecord
+{
+    double length;
+    double offset;
+    double x;
+    double y;
+    double z;
+    uint32_t id;
+    uint32_t segmentId;
+};
+
+/**
+ * The tables of a road network, either filled from the database (and then saved) or mapped from a snapshot file.
+ */
+class NetworkSnapshot : private boost::noncopyable
+{
+public:
+    /** Version of the file layout and of the records; snapshots of other versions are rejected */
+    static const uint32_t VERSION = 1;
+
+    /**
+     * Creates an empty snapshot
+     * @param key identifies the source of the tables (e.g. the names of the stored procedures); a file is only
+     * loaded if it was saved with the same key
+     */
+    explicit NetworkSnapshot(const std::string& key);
+
+    ~NetworkSnapshot();
+
+    /**
+     * Maps a snapshot file into memory, replacing the current tables
+     * @param fileName the snapshot file
+     * @throws std::runtime_error if the file cannot be read, is truncated or corrupt, or has another version or key
+     */
+    void load(const std::string& fileName);
+
+    /**
+     * Writes the tables to a file. The file is written under a temporary name and then renamed, so that a
+     * simulation that is interrupted does not leave a truncated snapshot behind
+     * @param fileName the snapshot file; overwritten
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& fileName) const;
+
+    /**
+     * Sets the records of a table, replacing any previous records
+     * @param tableId the table (a NetworkSnapshotTable, or a table of another store kept in this format)
+     * @param records the records, in the order of the rows
+     */
+    template<typename Record>
+    void setRecords(uint32_t tableId, const std::vector<Record>& records)
+    {
+        static_assert(std::is_pod<Record>::value && alignof(Record) <= 8, "records must be plain and at most 8-byte aligned");
+        if (isMapped())
+        {
+            throw std::runtime_error("Network snapshot: a mapped snapshot cannot be modified");
+        }
+        Table& table = tables[tableId];
+        table.recordSize = sizeof(Record);
+        table.numRecords = records.size();
+        table.owned.assign(reinterpret_cast<const char*>(records.data()),
+                           reinterpret_cast<const char*>(records.data() + records.size()));
+        table.data = table.owned.data();
+    }
+
+    /**
+     * Finds the records of a table
+     * @param tableId the table
+     * @param numRecords output: the number of records
+     * @return the records; null if the table is empty or missing
+     * @throws std::runtime_error if the records of the table are not of the given type
+     */
+    template<typename Record>
+    const Record* getRecords(uint32_t tableId, std::size_t& numRecords) const
+    {
+        std::map<uint32_t, Table>::const_iterator it = tables.find(tableId);
+        if (it == tables.end() || it->second.numRecords == 0)
+        {
+            numRecords = 0;
+            return nullptr;
+        }
+        if (it->second.recordSize != sizeof(Record))
+        {
+            throw std::runtime_error("Network snapshot: unexpected record size");
+        }
+        numRecords = it->second.numRecords;
+        return reinterpret_cast<const Record*>(it->second.data);
+    }
+
+    /**
+     * Adds a text to the string table
+     * @param text the text
+     * @return the reference to store in a record
+     */
+    SnapshotString addString(const std::string& text);
+
+    /**
+     * @param ref a reference returned by addString (possibly in a saved snapshot)
+     * @return the text
+     */
+    std::string getString(const SnapshotString& ref) const;
+
+    /** @return true if the tables are mapped from a file */
+    bool isMapped() const
+    {
+        return region.get() != nullptr;
+    }
+
+    const std::string& getKey() const
+    {
+        return key;
+    }
+
+private:
+    struct Table
+    {
+        Table() : recordSize(0), numRecords(0), data(nullptr)
+        {
+        }
+
+        uint32_t recordSize;
+        uint64_t numRecords;
+
+        /** the records; point into owned, or into the mapped file */
+        const char* data;
+
+        /** the records of a table that was not mapped */
+        std::vector<char> owned;
+    };
+
+    /** drops the tables and unmaps the file, if any */
+    void clear();
+
+    const std::string key;
+
+    std::map<uint32_t, Table> tables;
+
+    /** the string table, if not mapped (when mapped, it is the SNAPSHOT_STRINGS table) */
+    std::string strings;
+
+    /** the mapped file, if loaded */
+    boost::scoped_ptr<boost::interprocess::mapped_region> region;
+};
+
+}
@@ -268,7 +268,10 @@ void RoadNetwork::addLink(Link *link)
         link->setToNode(itNodes->second);
 
         //Add link to the map of links
-        mapOfIdVsLinks.insert(std::make_pair(link->getLinkId(), link));
+        if (mapOfIdVsLinks.insert(std::make_pair(link->getLinkId(), link)).second)
+        {
+            link->setLinkIndex(mapOfIdVsLinks.size() - 1);
+        }
     }
     else
     {
@@ -0,0 +1,872 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "ContractionHierarchy.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+using namespace sim_mob;
+
+const unsigned int ContractionHierarchy::NONE = std::numeric_limits<unsigned int>::max();
+
+namespace
+{
+
+const double INFINITE_DISTANCE = std::numeric_limits<double>::infinity();
+
+/** identifies hierarchy files */
+const char FILE_MAGIC[4] = { 'S', 'M', 'C', 'H' };
+
+/** incremented whenever the file layout changes */
+const uint32_t FILE_VERSION = 1;
+
+/** maximum number of vertices settled by a witness search; a witness missed due to the limit only costs a superfluous shortcut */
+const unsigned int MAX_WITNESS_SETTLED = 1000;
+
+/** entry of the priority queues; a min-heap is kept with std::greater */
+typedef std::pair<double, unsigned int> QueueEntry;
+typedef std::vector<QueueEntry> Queue;
+
+void push(Queue& queue, double key, unsigned int vertex)
+{
+    queue.push_back(QueueEntry(key, vertex));
+    std::push_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+}
+
+QueueEntry pop(Queue& queue)
+{
+    std::pop_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+    QueueEntry top = queue.back();
+    queue.pop_back();
+    return top;
+}
+
+/** an arc of the graph being contracted */
+struct ContractionArc
+{
+    ContractionArc(unsigned int other, unsigned int middle, unsigned int inputArc, double weight) :
+            other(other), middle(middle), inputArc(inputArc), weight(weight)
+    {
+    }
+
+    /** other end of the arc (the target of an outgoing arc, the source of an incoming arc) */
+    unsigned int other;
+    unsigned int middle;
+    unsigned int inputArc;
+    double weight;
+};
+
+typedef std::vector< std::vector<ContractionArc> > ContractionGraph;
+
+/** removes the arcs to or from vertex from an adjacency list */
+void removeArcs(std::vector<ContractionArc>& arcs, unsigned int vertex)
+{
+    for (size_t i = 0; i < arcs.size();)
+    {
+        if (arcs[i].other == vertex)
+        {
+            arcs[i] = arcs.back();
+            arcs.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/** finds the arc to or from vertex in an adjacency list */
+ContractionArc* findArc(std::vector<ContractionArc>& arcs, unsigned int vertex)
+{
+    for (std::vector<ContractionArc>::iterator it = arcs.begin(); it != arcs.end(); it++)
+    {
+        if (it->other == vertex)
+        {
+            return &(*it);
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Contracts the vertices of a graph.
+ * The remaining graph is kept in adjacency lists from which the arcs of contracted vertices are removed.
+ */
+class Contractor
+{
+public:
+    Contractor(unsigned int numVertices) :
+            outArcs(numVertices), inArcs(numVertices), contractedNeighbours(numVertices, 0), level(numVertices, 0),
+            witnessDist(numVertices, INFINITE_DISTANCE), isTarget(numVertices, 0)
+    {
+    }
+
+    /** outgoing and incoming arcs of each remaining vertex */
+    ContractionGraph outArcs;
+    ContractionGraph inArcs;
+
+    /** number of contracted neighbours of each vertex */
+    std::vector<int> contractedNeighbours;
+
+    /** length of the longest chain of contracted vertices leading to each vertex */
+    std::vector<int> level;
+
+    /**
+     * Computes the contraction priority of a vertex; vertices with lower priority are contracted first.
+     * Contracting vertices which add few shortcuts keeps the hierarchy sparse; the number of contracted neighbours and
+     * the level spread the contraction uniformly over the graph, which keeps the searches shallow.
+     */
+    int getPriority(unsigned int vertex)
+    {
+        int edgeDifference = contract(vertex, true) - (int) (inArcs[vertex].size() + outArcs[vertex].size());
+        return 2 * edgeDifference + contractedNeighbours[vertex] + level[vertex];
+    }
+
+    /**
+     * Contracts a vertex, or just counts the shortcuts its contraction would need
+     *
+     * @param vertex the vertex
+     * @param simulate if true, the graph is not modified
+     *
+     * @return number of shortcuts needed
+     */
+    int contract(unsigned int vertex, bool simulate)
+    {
+        const std::vector<ContractionArc>& in = inArcs[vertex];
+        const std::vector<ContractionArc>& out = outArcs[vertex];
+        if (in.empty() || out.empty())
+        {
+            return 0;
+        }
+
+        double maxOutWeight = 0;
+        for (std::vector<ContractionArc>::const_iterator it = out.begin(); it != out.end(); it++)
+        {
+            maxOutWeight = std::max(maxOutWeight, it->weight);
+        }
+
+        int numShortcuts = 0;
+        std::vector<ContractionHierarchy::InputArc> shortcuts;
+        for (std::vector<ContractionArc>::const_iterator inIt = in.begin(); inIt != in.end(); inIt++)
+        {
+            const unsigned int source = inIt->other;
+            size_t numTargets = 0;
+            for (std::vector<ContractionArc>::const_iterator outIt = out.begin(); outIt != out.end(); outIt++)
+            {
+                if (outIt->other != source)
+                {
+                    isTarget[outIt->other] = 1;
+                    numTargets++;
+                }
+            }
+            if (numTargets == 0)
+            {
+                continue;
+            }
+
+            searchWitnesses(source, vertex, inIt->weight + maxOutWeight, numTargets);
+
+            for (std::vector<ContractionArc>::const_iterator outIt = out.begin(); outIt != out.end(); outIt++)
+            {
+                const unsigned int target = outIt->other;
+                if (target == source)
+                {
+                    continue;
+                }
+                isTarget[target] = 0;
+
+                double weight = inIt->weight + outIt->weight;
+                if (witnessDist[target] <= weight)
+                {
+                    continue;
+                }
+                numShortcuts++;
+                if (!simulate)
+                {
+                    shortcuts.push_back(ContractionHierarchy::InputArc(source, target, weight));
+                }
+            }
+            resetWitnessSearch();
+        }
+
+        if (!simulate)
+        {
+            //the arcs of a vertex are only modified after its witness searches, so that the in/out references stay valid
+            for (std::vector<ContractionHierarchy::InputArc>::const_iterator it = shortcuts.begin(); it != shortcuts.end(); it++)
+            {
+                addArc(it->source, it->target, vertex, ContractionHierarchy::NONE, it->weight);
+            }
+        }
+        return numShortcuts;
+    }
+
+    /** removes a contracted vertex from the remaining graph */
+    void remove(unsigned int vertex)
+    {
+        for (std::vector<ContractionArc>::const_iterator it = inArcs[vertex].begin(); it != inArcs[vertex].end(); it++)
+        {
+            removeArcs(outArcs[it->other], vertex);
+            contractedNeighbours[it->other]++;
+            level[it->other] = std::max(level[it->other], level[vertex] + 1);
+        }
+        for (std::vector<ContractionArc>::const_iterator it = outArcs[vertex].begin(); it != outArcs[vertex].end(); it++)
+        {
+            removeArcs(inArcs[it->other], vertex);
+            contractedNeighbours[it->other]++;
+            level[it->other] = std::max(level[it->other], level[vertex] + 1);
+        }
+        std::vector<ContractionArc>().swap(inArcs[vertex]);
+        std::vector<ContractionArc>().swap(outArcs[vertex]);
+    }
+
+    /** adds an arc, or lowers the weight of an existing arc between the same vertices */
+    void addArc(unsigned int source, unsigned int target, unsigned int middle, unsigned int inputArc, double weight)
+    {
+        ContractionArc* existing = findArc(outArcs[source], target);
+        if (existing)
+        {
+            if (existing->weight <= weight)
+            {
+                return;
+            }
+            *existing = ContractionArc(target, middle, inputArc, weight);
+            *findArc(inArcs[target], source) = ContractionArc(source, middle, inputArc, weight);
+            return;
+        }
+        outArcs[source].push_back(ContractionArc(target, middle, inputArc, weight));
+        inArcs[target].push_back(ContractionArc(source, middle, inputArc, weight));
+    }
+
+private:
+    /** Dijkstra search from source in the remaining graph without via, until all targets are settled or the bound is exceeded */
+    void searchWitnesses(unsigned int source, unsigned int via, double bound, size_t numTargets)
+    {
+        witnessDist[source] = 0;
+        touched.push_back(source);
+        push(queue, 0, source);
+
+        unsigned int numSettled = 0;
+        while (!queue.empty() && numTargets > 0 && numSettled < MAX_WITNESS_SETTLED)
+        {
+            QueueEntry top = pop(queue);
+            if (top.first > witnessDist[top.second])
+            {
+                continue;
+            }
+            if (top.first > bound)
+            {
+                break;
+            }
+            numSettled++;
+            if (isTarget[top.second])
+            {
+                numTargets--;
+            }
+
+            const std::vector<ContractionArc>& arcs = outArcs[top.second];
+            for (std::vector<ContractionArc>::const_iterator it = arcs.begin(); it != arcs.end(); it++)
+            {
+                if (it->other == via)
+                {
+                    continue;
+                }
+                double dist = top.first + it->weight;
+                if (dist < witnessDist[it->other])
+                {
+                    if (witnessDist[it->other] == INFINITE_DISTANCE)
+                    {
+                        touched.push_back(it->other);
+                    }
+                    witnessDist[it->other] = dist;
+                    push(queue, dist, it->other);
+                }
+            }
+        }
+    }
+
+    void resetWitnessSearch()
+    {
+        for (std::vector<unsigned int>::const_iterator it = touched.begin(); it != touched.end(); it++)
+        {
+            witnessDist[*it] = INFINITE_DISTANCE;
+        }
+        touched.clear();
+        queue.clear();
+    }
+
+    /** witness search state */
+    std::vector<double> witnessDist;
+    std::vector<char> isTarget;
+    std::vector<unsigned int> touched;
+    Queue queue;
+};
+
+/** groups arcs by vertex into an offset array (numVertices + 1 entries) and an arc array */
+template<typename ArcType>
+void flatten(const std::vector< std::vector<ArcType> >& lists, std::vector<unsigned int>& offsets, std::vector<ArcType>& arcs)
+{
+    offsets.assign(1, 0);
+    arcs.clear();
+    for (typename std::vector< std::vector<ArcType> >::const_iterator it = lists.begin(); it != lists.end(); it++)
+    {
+        arcs.insert(arcs.end(), it->begin(), it->end());
+        offsets.push_back(arcs.size());
+    }
+}
+
+/** FNV-1a hash */
+void hashBytes(uint64_t& hash, const void* data, size_t length)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+template<typename T>
+void write(std::ostream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool read(std::istream& in, T& value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template<typename ArcType>
+void writeArcs(std::ostream& out, const std::vector<unsigned int>& offsets, const std::vector<ArcType>& arcs)
+{
+    write(out, (uint32_t) arcs.size());
+    for (std::vector<unsigned int>::const_iterator it = offsets.begin(); it != offsets.end(); it++)
+    {
+        write(out, (uint32_t) *it);
+    }
+    for (typename std::vector<ArcType>::const_iterator it = arcs.begin(); it != arcs.end(); it++)
+    {
+        write(out, (uint32_t) it->target);
+        write(out, (uint32_t) it->middle);
+        write(out, (uint32_t) it->inputArc);
+        write(out, it->weight);
+    }
+}
+
+template<typename ArcType>
+bool readArcs(std::istream& in, unsigned int numVertices, std::vector<unsigned int>& offsets, std::vector<ArcType>& arcs)
+{
+    uint32_t numArcs = 0;
+    if (!read(in, numArcs))
+    {
+        return false;
+    }
+
+    offsets.resize(numVertices + 1);
+    for (unsigned int vertex = 0; vertex <= numVertices; vertex++)
+    {
+        uint32_t offset = 0;
+        if (!read(in, offset) || offset > numArcs || (vertex > 0 && offset < offsets[vertex - 1]))
+        {
+            return false;
+        }
+        offsets[vertex] = offset;
+    }
+    if (offsets[0] != 0 || offsets[numVertices] != numArcs)
+    {
+        return false;
+    }
+
+    arcs.resize(numArcs);
+    for (typename std::vector<ArcType>::iterator it = arcs.begin(); it != arcs.end(); it++)
+    {
+        uint32_t target = 0, middle = 0, inputArc = 0;
+        if (!read(in, target) || !read(in, middle) || !read(in, inputArc) || !read(in, it->weight) || target >= numVertices)
+        {
+            return false;
+        }
+        it->target = target;
+        it->middle = middle;
+        it->inputArc = inputArc;
+    }
+    return true;
+}
+
+}
+
+struct ContractionHierarchy::Workspace
+{
+    Workspace(unsigned int numVertices, unsigned int numInputArcs) : blocked(numInputArcs, 0)
+    {
+        for (int dir = 0; dir < 2; dir++)
+        {
+            dist[dir].assign(numVertices, INFINITE_DISTANCE);
+            parent[dir].assign(numVertices, NONE);
+            parentArc[dir].assign(numVertices, NONE);
+        }
+    }
+
+    /** records that a vertex was labelled by the current search */
+    void touch(unsigned int vertex)
+    {
+        if (dist[0][vertex] == INFINITE_DISTANCE && dist[1][vertex] == INFINITE_DISTANCE)
+        {
+            touched.push_back(vertex);
+        }
+    }
+
+    /** resets the labels of the current search */
+    void reset()
+    {
+        for (std::vector<unsigned int>::const_iterator it = touched.begin(); it != touched.end(); it++)
+        {
+            for (int dir = 0; dir < 2; dir++)
+            {
+                dist[dir][*it] = INFINITE_DISTANCE;
+                parent[dir][*it] = NONE;
+                parentArc[dir][*it] = NONE;
+            }
+        }
+        touched.clear();
+        queue[0].clear();
+        queue[1].clear();
+    }
+
+    /** forward (0) and backward (1) labels */
+    std::vector<double> dist[2];
+    std::vector<unsigned int> parent[2];
+    std::vector<unsigned int> parentArc[2];
+    Queue queue[2];
+    std::vector<unsigned int> touched;
+
+    /** flags the input arcs which must not be used */
+    std::vector<char> blocked;
+};
+
+ContractionHierarchy::ContractionHierarchy() : numVertices(0), fingerprint(0), numInputArcs(0)
+{
+}
+
+ContractionHierarchy::~ContractionHierarchy()
+{
+}
+
+void ContractionHierarchy::setInputGraph(unsigned int numVertices, const std::vector<InputArc>& arcs)
+{
+    this->numVertices = numVertices;
+    numInputArcs = arcs.size();
+
+    fingerprint = 14695981039346656037ULL;
+    uint32_t count = numVertices;
+    hashBytes(fingerprint, &count, sizeof(count));
+    count = arcs.size();
+    hashBytes(fingerprint, &count, sizeof(count));
+
+    std::vector< std::vector<Arc> > forward(numVertices), reverse(numVertices);
+    for (unsigned int id = 0; id < arcs.size(); id++)
+    {
+        const InputArc& arc = arcs[id];
+        if (arc.source >= numVertices || arc.target >= numVertices)
+        {
+            throw std::runtime_error("ContractionHierarchy: arc references an unknown vertex");
+        }
+        if (!(arc.weight >= 0))
+        {
+            throw std::runtime_error("ContractionHierarchy: arc weights must be non-negative");
+        }
+
+        uint32_t ends[2] = { arc.source, arc.target };
+        hashBytes(fingerprint, ends, sizeof(ends));
+        hashBytes(fingerprint, &arc.weight, sizeof(arc.weight));
+
+        forward[arc.source].push_back(Arc(arc.target, NONE, id, arc.weight));
+        reverse[arc.target].push_back(Arc(arc.source, NONE, id, arc.weight));
+    }
+    flatten(forward, inputOffsets, inputArcs);
+    flatten(reverse, reverseInputOffsets, reverseInputArcs);
+
+    workspace.reset();
+}
+
+void ContractionHierarchy::build(unsigned int numVertices, const std::vector<InputArc>& arcs)
+{
+    setInputGraph(numVertices, arcs);
+
+    Contractor contractor(numVertices);
+    for (unsigned int id = 0; id < arcs.size(); id++)
+    {
+        //parallel arcs are merged into the lightest one; loops never lie on a shortest path
+        if (arcs[id].source != arcs[id].target)
+        {
+            contractor.addArc(arcs[id].source, arcs[id].target, NONE, id, arcs[id].weight);
+        }
+    }
+
+    Queue order;
+    std::vector<int> priorities(numVertices);
+    for (unsigned int vertex = 0; vertex < numVertices; vertex++)
+    {
+        priorities[vertex] = contractor.getPriority(vertex);
+        push(order, priorities[vertex], vertex);
+    }
+
+    std::vector<char> contracted(numVertices, 0);
+    std::vector<unsigned int> neighbours;
+    std::vector< std::vector<Arc> > up(numVertices), down(numVertices);
+    while (!order.empty())
+    {
+        QueueEntry top = pop(order);
+        const unsigned int vertex = top.second;
+        if (contracted[vertex] || top.first != priorities[vertex])
+        {
+            //outdated entry
+            continue;
+        }
+
+        //lazy update: the priority may have grown since it was last computed
+        priorities[vertex] = contractor.getPriority(vertex);
+        if (!order.empty() && priorities[vertex] > order.front().first)
+        {
+            push(order, priorities[vertex], vertex);
+            continue;
+        }
+
+        //all remaining neighbours will be contracted later, so the arcs of the vertex are final
+        const std::vector<ContractionArc>& outArcs = contractor.outArcs[vertex];
+        for (std::vector<ContractionArc>::const_iterator it = outArcs.begin(); it != outArcs.end(); it++)
+        {
+            up[vertex].push_back(Arc(it->other, it->middle, it->inputArc, it->weight));
+        }
+        const std::vector<ContractionArc>& inArcs = contractor.inArcs[vertex];
+        for (std::vector<ContractionArc>::const_iterator it = inArcs.begin(); it != inArcs.end(); it++)
+        {
+            down[vertex].push_back(Arc(it->other, it->middle, it->inputArc, it->weight));
+        }
+
+        neighbours.clear();
+        for (std::vector<ContractionArc>::const_iterator it = outArcs.begin(); it != outArcs.end(); it++)
+        {
+            neighbours.push_back(it->other);
+        }
+        for (std::vector<ContractionArc>::const_iterator it = inArcs.begin(); it != inArcs.end(); it++)
+        {
+            neighbours.push_back(it->other);
+        }
+
+        contractor.contract(vertex, false);
+        contractor.remove(vertex);
+        contracted[vertex] = 1;
+
+        //the contraction changed the neighbourhood of the adjacent vertices
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (std::vector<unsigned int>::const_iterator it = neighbours.begin(); it != neighbours.end(); it++)
+        {
+            priorities[*it] = contractor.getPriority(*it);
+            push(order, priorities[*it], *it);
+        }
+    }
+
+    flatten(up, upOffsets, upArcs);
+    flatten(down, downOffsets, downArcs);
+}
+
+bool ContractionHierarchy::load(const std::string& fileName, unsigned int numVertices, const std::vector<InputArc>& arcs)
+{
+    std::ifstream in(fileName.c_str(), std::ios::binary);
+    if (!in)
+    {
+        return false;
+    }
+
+    char magic[sizeof(FILE_MAGIC)];
+    uint32_t version = 0, fileNumVertices = 0;
+    uint64_t fileFingerprint = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0
+            || !read(in, version) || version != FILE_VERSION || !read(in, fileNumVertices) || !read(in, fileFingerprint))
+    {
+        return false;
+    }
+
+    setInputGraph(numVertices, arcs);
+    if (fileNumVertices != numVertices || fileFingerprint != fingerprint)
+    {
+        return false;
+    }
+
+    if (!readArcs(in, numVertices, upOffsets, upArcs) || !readArcs(in, numVertices, downOffsets, downArcs))
+    {
+        upOffsets.clear();
+        upArcs.clear();
+        downOffsets.clear();
+        downArcs.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ContractionHierarchy::save(const std::string& fileName) const
+{
+    std::ofstream out(fileName.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        return false;
+    }
+
+    out.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    write(out, FILE_VERSION);
+    write(out, (uint32_t) numVertices);
+    write(out, fingerprint);
+    writeArcs(out, upOffsets, upArcs);
+    writeArcs(out, downOffsets, downArcs);
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+size_t ContractionHierarchy::getNumShortcuts() const
+{
+    size_t numShortcuts = 0;
+    for (std::vector<Arc>::const_iterator it = upArcs.begin(); it != upArcs.end(); it++)
+    {
+        numShortcuts += (it->middle != NONE);
+    }
+    for (std::vector<Arc>::const_iterator it = downArcs.begin(); it != downArcs.end(); it++)
+    {
+        numShortcuts += (it->middle != NONE);
+    }
+    return numShortcuts;
+}
+
+ContractionHierarchy::Workspace& ContractionHierarchy::getWorkspace() const
+{
+    Workspace* ws = workspace.get();
+    if (!ws)
+    {
+        ws = new Workspace(numVertices, numInputArcs);
+        workspace.reset(ws);
+    }
+    return *ws;
+}
+
+void ContractionHierarchy::unpack(unsigned int from, unsigned int to, const Arc& arc, std::vector<unsigned int>& path) const
+{
+    if (arc.middle == NONE)
+    {
+        path.push_back(arc.inputArc);
+        return;
+    }
+
+    //both halves of a shortcut were recorded when its middle vertex was contracted
+    const unsigned int middle = arc.middle;
+    for (unsigned int i = downOffsets[middle]; i < downOffsets[middle + 1]; i++)
+    {
+        if (downArcs[i].target == from)
+        {
+            unpack(from, middle, downArcs[i], path);
+            break;
+        }
+    }
+    for (unsigned int i = upOffsets[middle]; i < upOffsets[middle + 1]; i++)
+    {
+        if (upArcs[i].target == to)
+        {
+            unpack(middle, to, upArcs[i], path);
+            break;
+        }
+    }
+}
+
+double ContractionHierarchy::query(unsigned int source, unsigned int target, std::vector<unsigned int>& path) const
+{
+    path.clear();
+    if (source >= numVertices || target >= numVertices || upOffsets.empty())
+    {
+        return INFINITE_DISTANCE;
+    }
+    if (source == target)
+    {
+        return 0;
+    }
+
+    Workspace& ws = getWorkspace();
+    const unsigned int ends[2] = { source, target };
+    for (int dir = 0; dir < 2; dir++)
+    {
+        ws.touch(ends[dir]);
+        ws.dist[dir][ends[dir]] = 0;
+        push(ws.queue[dir], 0, ends[dir]);
+    }
+
+    //both searches only go upwards; they meet at the highest vertex of the shortest path
+    double best = INFINITE_DISTANCE;
+    unsigned int meeting = NONE;
+    while (!ws.queue[0].empty() || !ws.queue[1].empty())
+    {
+        int dir = (ws.queue[1].empty() || (!ws.queue[0].empty() && ws.queue[0].front() <= ws.queue[1].front())) ? 0 : 1;
+        QueueEntry top = pop(ws.queue[dir]);
+        if (top.first >= best)
+        {
+            //no shorter path can be found in this direction
+            ws.queue[dir].clear();
+            continue;
+        }
+        if (top.first > ws.dist[dir][top.second])
+        {
+            continue;
+        }
+
+        const std::vector<unsigned int>& offsets = (dir == 0) ? upOffsets : downOffsets;
+        const std::vector<Arc>& arcs = (dir == 0) ? upArcs : downArcs;
+        for (unsigned int i = offsets[top.second]; i < offsets[top.second + 1]; i++)
+        {
+            const unsigned int next = arcs[i].target;
+            double dist = top.first + arcs[i].weight;
+            if (dist < ws.dist[dir][next])
+            {
+                ws.touch(next);
+                ws.dist[dir][next] = dist;
+                ws.parent[dir][next] = top.second;
+                ws.parentArc[dir][next] = i;
+                push(ws.queue[dir], dist, next);
+                if (dist + ws.dist[1 - dir][next] < best)
+                {
+                    best = dist + ws.dist[1 - dir][next];
+                    meeting = next;
+                }
+            }
+        }
+    }
+
+    if (meeting != NONE)
+    {
+        std::vector<unsigned int> upwardPath;
+        for (unsigned int vertex = meeting; vertex != source; vertex = ws.parent[0][vertex])
+        {
+            upwardPath.push_back(vertex);
+        }
+        for (std::vector<unsigned int>::const_reverse_iterator it = upwardPath.rbegin(); it != upwardPath.rend(); it++)
+        {
+            unpack(ws.parent[0][*it], *it, upArcs[ws.parentArc[0][*it]], path);
+        }
+        for (unsigned int vertex = meeting; vertex != target; vertex = ws.parent[1][vertex])
+        {
+            unpack(vertex, ws.parent[1][vertex], downArcs[ws.parentArc[1][vertex]], path);
+        }
+    }
+
+    ws.reset();
+    return best;
+}
+
+double ContractionHierarchy::query(unsigned int source, unsigned int target, const std::vector<unsigned int>& blockedArcs,
+        std::vector<unsigned int>& path) const
+{
+    double length = query(source, target, path);
+    if (blockedArcs.empty() || length == INFINITE_DISTANCE)
+    {
+        //removing arcs cannot connect the vertices
+        return length;
+    }
+
+    Workspace& ws = getWorkspace();
+    for (std::vector<unsigned int>::const_iterator it = blockedArcs.begin(); it != blockedArcs.end(); it++)
+    {
+        if (*it < numInputArcs)
+        {
+            ws.blocked[*it] = 1;
+        }
+    }
+
+    bool usesBlockedArc = false;
+    for (std::vector<unsigned int>::const_iterator it = path.begin(); it != path.end() && !usesBlockedArc; it++)
+    {
+        usesBlockedArc = ws.blocked[*it];
+    }
+    if (usesBlockedArc)
+    {
+        //the shortcuts may hide blocked arcs, so the search falls back to the input graph
+        length = searchInputGraph(source, target, ws, path);
+    }
+
+    for (std::vector<unsigned int>::const_iterator it = blockedArcs.begin(); it != blockedArcs.end(); it++)
+    {
+        if (*it < numInputArcs)
+        {
+            ws.blocked[*it] = 0;
+        }
+    }
+    return length;
+}
+
+double ContractionHierarchy::searchInputGraph(unsigned int source, unsigned int target, Workspace& ws, std::vector<unsigned int>& path) const
+{
+    path.clear();
+    const unsigned int ends[2] = { source, target };
+    for (int dir = 0; dir < 2; dir++)
+    {
+        ws.touch(ends[dir]);
+        ws.dist[dir][ends[dir]] = 0;
+        push(ws.queue[dir], 0, ends[dir]);
+    }
+
+    double best = INFINITE_DISTANCE;
+    unsigned int meeting = NONE;
+    while (!ws.queue[0].empty() && !ws.queue[1].empty() && ws.queue[0].front().first + ws.queue[1].front().first < best)
+    {
+        int dir = (ws.queue[0].front() <= ws.queue[1].front()) ? 0 : 1;
+        QueueEntry top = pop(ws.queue[dir]);
+        if (top.first > ws.dist[dir][top.second])
+        {
+            continue;
+        }
+
+        const std::vector<unsigned int>& offsets = (dir == 0) ? inputOffsets : reverseInputOffsets;
+        const std::vector<Arc>& arcs = (dir == 0) ? inputArcs : reverseInputArcs;
+        for (unsigned int i = offsets[top.second]; i < offsets[top.second + 1]; i++)
+        {
+            if (ws.blocked[arcs[i].inputArc])
+            {
+                continue;
+            }
+            const unsigned int next = arcs[i].target;
+            double dist = top.first + arcs[i].weight;
+            if (dist < ws.dist[dir][next])
+            {
+                ws.touch(next);
+                ws.dist[dir][next] = dist;
+                ws.parent[dir][next] = top.second;
+                ws.parentArc[dir][next] = arcs[i].inputArc;
+                push(ws.queue[dir], dist, next);
+                if (dist + ws.dist[1 - dir][next] < best)
+                {
+                    best = dist + ws.dist[1 - dir][next];
+                    meeting = next;
+                }
+            }
+        }
+    }
+
+    if (meeting != NONE)
+    {
+        for (unsigned int vertex = meeting; vertex != source; vertex = ws.parent[0][vertex])
+        {
+            path.push_back(ws.parentArc[0][vertex]);
+        }
+        std::reverse(path.begin(), path.end());
+        for (unsigned int vertex = meeting; vertex != target; vertex = ws.parent[1][vertex])
+        {
+            path.push_back(ws.parentArc[1][vertex]);
+        }
+    }
+
+    ws.reset();
+    return best;
+}
@@ -0,0 +1,182 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <boost/thread/tss.hpp>
+#include <boost/utility.hpp>
+
+namespace sim_mob
+{
+
+/**
+ * Contraction hierarchy over a weighted, directed graph with non-negative arc weights.
+ *
+ * Preprocessing contracts the vertices one by one (in order of increasing edge difference, with lazy updates),
+ * adding a shortcut arc u->x for every in-neighbour u and out-neighbour x of the contracted vertex v whose
+ * shortest connection runs through v. Queries are bidirectional Dijkstra searches which only relax arcs
+ * towards vertices contracted later, and settle a tiny fraction of the graph. Shortcuts are unpacked into the
+ * original arcs of the path.
+ *
+ * The graph itself is not stored; vertices and arcs are identified by their indices in the input.
+ * The preprocessed hierarchy can be saved to and loaded from a binary file. The file records a fingerprint of the
+ * input graph, so that a file created for a different network (or different weights) is never used.
+ *
+ * Queries are thread-safe; each thread uses its own search workspace.
+ */
+class ContractionHierarchy : private boost::noncopyable
+{
+public:
+    /** marks the absence of a vertex or arc */
+    static const unsigned int NONE;
+
+    /** an arc of the input graph */
+    struct InputArc
+    {
+        InputArc(unsigned int source, unsigned int target, double weight) : source(source), target(target), weight(weight)
+        {
+        }
+
+        unsigned int source;
+        unsigned int target;
+        double weight;
+    };
+
+    ContractionHierarchy();
+    ~ContractionHierarchy();
+
+    /**
+     * Preprocesses the given graph
+     *
+     * @param numVertices number of vertices; vertices are numbered 0..numVertices-1
+     * @param arcs arcs of the graph; the index of an arc is its id in query results
+     */
+    void build(unsigned int numVertices, const std::vector<InputArc>& arcs);
+
+    /**
+     * Loads a hierarchy saved by save() for the given graph
+     *
+     * @param fileName file to read
+     * @param numVertices number of vertices of the graph
+     * @param arcs arcs of the graph
+     *
+     * @return true if the hierarchy was loaded; false if the file does not exist, is corrupt, or was created for another graph
+     */
+    bool load(const std::string& fileName, unsigned int numVertices, const std::vector<InputArc>& arcs);
+
+    /**
+     * Saves the hierarchy
+     *
+     * @param fileName file to write
+     *
+     * @return true if the file was written
+     */
+    bool save(const std::string& fileName) const;
+
+    /**
+     * Finds a shortest path
+     *
+     * @param source source vertex
+     * @param target target vertex
+     * @param path output: ids of the input arcs along the path, in order
+     *
+     * @return length of the path; infinity if target is not reachable from source
+     */
+    double query(unsigned int source, unsigned int target, std::vector<unsigned int>& path) const;
+
+    /**
+     * Finds a shortest path which does not use any of the given arcs.
+     * The hierarchy is tried first; if its path uses a blocked arc, a bidirectional Dijkstra search on the
+     * input graph without the blocked arcs is run instead.
+     *
+     * @param source source vertex
+     * @param target target vertex
+     * @param blockedArcs ids of the arcs which must not be used
+     * @param path output: ids of the input arcs along the path, in order
+     *
+     * @return length of the path; infinity if target is not reachable from source
+     */
+    double query(unsigned int source, unsigned int target, const std::vector<unsigned int>& blockedArcs, std::vector<unsigned int>& path) const;
+
+    /** @return number of vertices of the graph */
+    unsigned int getNumVertices() const
+    {
+        return numVertices;
+    }
+
+    /** @return number of shortcut arcs added by the preprocessing */
+    size_t getNumShortcuts() const;
+
+private:
+    /** an arc of the hierarchy or the input graph */
+    struct Arc
+    {
+        Arc() : target(NONE), middle(NONE), inputArc(NONE), weight(0)
+        {
+        }
+
+        Arc(unsigned int target, unsigned int middle, unsigned int inputArc, double weight) :
+                target(target), middle(middle), inputArc(inputArc), weight(weight)
+        {
+        }
+
+        /** other end of the arc */
+        unsigned int target;
+
+        /** for shortcuts: the vertex whose contraction created this arc; NONE otherwise */
+        unsigned int middle;
+
+        /** for original arcs: the id of the input arc; NONE otherwise */
+        unsigned int inputArc;
+
+        double weight;
+    };
+
+    /** search state of one thread */
+    struct Workspace;
+
+    /** stores the input graph in forward and reverse adjacency arrays, and computes its fingerprint */
+    void setInputGraph(unsigned int numVertices, const std::vector<InputArc>& arcs);
+
+    /** @return the search state of the calling thread */
+    Workspace& getWorkspace() const;
+
+    /** appends the input arcs of the hierarchy arc from -> arc.target (or arc.target -> from for a downward arc) to path */
+    void unpack(unsigned int from, unsigned int to, const Arc& arc, std::vector<unsigned int>& path) const;
+
+    /** bidirectional Dijkstra search on the input graph, skipping the arcs flagged in ws.blocked */
+    double searchInputGraph(unsigned int source, unsigned int target, Workspace& ws, std::vector<unsigned int>& path) const;
+
+    /** number of vertices */
+    unsigned int numVertices;
+
+    /** fingerprint of the input graph */
+    uint64_t fingerprint;
+
+    /** upward arcs: arcs u->x with x contracted after u, grouped by u */
+    std::vector<unsigned int> upOffsets;
+    std::vector<Arc> upArcs;
+
+    /** downward arcs: arcs x->u with x contracted after u, grouped by u (target holds x) */
+    std::vector<unsigned int> downOffsets;
+    std::vector<Arc> downArcs;
+
+    /** input graph, grouped by source (forward) and by target (reverse; target holds the source) */
+    std::vector<unsigned int> inputOffsets;
+    std::vector<Arc> inputArcs;
+    std::vector<unsigned int> reverseInputOffsets;
+    std::vector<Arc> reverseInputArcs;
+
+    /** number of input arcs */
+    unsigned int numInputArcs;
+
+    /** search state of each thread */
+    mutable boost::thread_specific_ptr<Workspace> workspace;
+};
+
+}
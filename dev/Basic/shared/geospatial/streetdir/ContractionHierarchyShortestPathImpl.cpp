@@ -0,0 +1,110 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "ContractionHierarchyShortestPathImpl.hpp"
+
+#include <map>
+
+#include "logging/Log.hpp"
+
+using namespace sim_mob;
+
+ContractionHierarchyShortestPathImpl::ContractionHierarchyShortestPathImpl(const RoadNetwork& network, const std::string& cacheFile) :
+        A_StarShortestPathImpl(network), hasHierarchy(false)
+{
+    if (isValidSegGraph)
+    {
+        Warn() << "Contraction hierarchy: the segment graph is in use, falling back to A* searches" << std::endl;
+        return;
+    }
+
+    std::vector<ContractionHierarchy::InputArc> arcs;
+    std::map<StreetDirectory::Edge, unsigned int> arcIds;
+    StreetDirectory::Graph::edge_iterator edgeIt, edgeEnd;
+    for (boost::tie(edgeIt, edgeEnd) = boost::edges(drivingLinkMap); edgeIt != edgeEnd; ++edgeIt)
+    {
+        arcIds[*edgeIt] = arcs.size();
+        linkGraphEdges.push_back(*edgeIt);
+        arcs.push_back(ContractionHierarchy::InputArc(boost::source(*edgeIt, drivingLinkMap), boost::target(*edgeIt, drivingLinkMap),
+                                                      boost::get(boost::edge_weight, drivingLinkMap, *edgeIt)));
+    }
+
+    for (LinkEdgeLookup::const_iterator it = drivingLinkEdgeLookup.begin(); it != drivingLinkEdgeLookup.end(); it++)
+    {
+        std::vector<unsigned int>& ids = linkArcs[it->first];
+        for (std::set<StreetDirectory::Edge>::const_iterator edgeIt = it->second.begin(); edgeIt != it->second.end(); edgeIt++)
+        {
+            std::map<StreetDirectory::Edge, unsigned int>::const_iterator idIt = arcIds.find(*edgeIt);
+            if (idIt != arcIds.end())
+            {
+                ids.push_back(idIt->second);
+            }
+        }
+    }
+
+    const unsigned int numVertices = boost::num_vertices(drivingLinkMap);
+    if (!cacheFile.empty() && hierarchy.load(cacheFile, numVertices, arcs))
+    {
+        Print() << "Contraction hierarchy loaded from " << cacheFile << std::endl;
+    }
+    else
+    {
+        hierarchy.build(numVertices, arcs);
+        Print() << "Contraction hierarchy built: " << numVertices << " vertices, " << arcs.size() << " edges, "
+                << hierarchy.getNumShortcuts() << " shortcuts" << std::endl;
+        if (!cacheFile.empty() && !hierarchy.save(cacheFile))
+        {
+            Warn() << "Contraction hierarchy: could not write " << cacheFile << std::endl;
+        }
+    }
+    hasHierarchy = true;
+}
+
+ContractionHierarchyShortestPathImpl::~ContractionHierarchyShortestPathImpl()
+{
+}
+
+std::vector<WayPoint> ContractionHierarchyShortestPathImpl::GetShortestDrivingPath(const StreetDirectory::VertexDesc &from,
+        const StreetDirectory::VertexDesc &to, const std::vector<const Link*> &blacklist, TimeRange timeRange, int randomGraphIdx) const
+{
+    if (!hasHierarchy)
+    {
+        return A_StarShortestPathImpl::GetShortestDrivingPath(from, to, blacklist, timeRange, randomGraphIdx);
+    }
+
+    //check whether invalid or not.
+    if (!(from.valid && to.valid))
+    {
+        return std::vector<WayPoint>();
+    }
+
+    StreetDirectory::Vertex fromV = from.source;
+    StreetDirectory::Vertex toV = to.sink;
+    if (fromV == toV)
+    {
+        return std::vector<WayPoint>();
+    }
+
+    //Convert the blacklist into a list of blocked arcs.
+    std::vector<unsigned int> blockedArcs;
+    for (std::vector<const Link*>::const_iterator it = blacklist.begin(); it != blacklist.end(); it++)
+    {
+        boost::unordered_map<const Link*, std::vector<unsigned int> >::const_iterator lookIt = linkArcs.find(*it);
+        if (lookIt != linkArcs.end())
+        {
+            blockedArcs.insert(blockedArcs.end(), lookIt->second.begin(), lookIt->second.end());
+        }
+    }
+
+    std::vector<unsigned int> path;
+    hierarchy.query(fromV, toV, blockedArcs, path);
+
+    std::vector<WayPoint> res;
+    res.reserve(path.size());
+    for (std::vector<unsigned int>::const_iterator it = path.begin(); it != path.end(); it++)
+    {
+        res.push_back(boost::get(boost::edge_name, drivingLinkMap, linkGraphEdges[*it]));
+    }
+    return res;
+}
@@ -0,0 +1,59 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <boost/unordered_map.hpp>
+
+#include "A_StarShortestPathImpl.hpp"
+#include "ContractionHierarchy.hpp"
+
+namespace sim_mob
+{
+
+/**
+ * Distance-based shortest path engine answering the link graph queries with a contraction hierarchy.
+ *
+ * The driving graphs are built exactly as by A_StarShortestPathImpl, so that the vertex lookups and the returned WayPoints
+ * are identical. The link graph (drivingLinkMap) is then preprocessed into a ContractionHierarchy, which answers a query
+ * in a fraction of the time needed by the A* search. Since the preprocessing takes a while on a large network, the
+ * hierarchy can be cached in a file; the cache is rebuilt whenever it does not match the current network.
+ *
+ * Queries with a blacklist use the hierarchy path if it avoids the blacklisted links, and otherwise a bidirectional
+ * Dijkstra search on the link graph without them.
+ * The segment graph (used when generating bus routes) is still searched with A*.
+ */
+class ContractionHierarchyShortestPathImpl : public A_StarShortestPathImpl
+{
+public:
+    /**
+     * @param network the road network
+     * @param cacheFile file to load the hierarchy from (and to save it to after building it); empty to always build it
+     */
+    ContractionHierarchyShortestPathImpl(const RoadNetwork& network, const std::string& cacheFile);
+    virtual ~ContractionHierarchyShortestPathImpl();
+
+    virtual std::vector<WayPoint> GetShortestDrivingPath(const StreetDirectory::VertexDesc &from, const StreetDirectory::VertexDesc &to,
+                                                        const std::vector<const Link*> &blacklist, TimeRange timeRange = Default, int randomGraphIdx = 0) const;
+
+    /** the segment-graph overload is inherited unchanged */
+    using A_StarShortestPathImpl::GetShortestDrivingPath;
+
+private:
+    /** the hierarchy of drivingLinkMap; the vertex ids are the graph vertices and the arc ids index linkGraphEdges */
+    ContractionHierarchy hierarchy;
+
+    /** edges of drivingLinkMap, in the order they were passed to the hierarchy */
+    std::vector<StreetDirectory::Edge> linkGraphEdges;
+
+    /** the arc ids of the edges belonging to each link, for translating blacklists */
+    boost::unordered_map<const Link*, std::vector<unsigned int> > linkArcs;
+
+    /** indicates whether the hierarchy was built; false when the segment graph is used */
+    bool hasHierarchy;
+};
+
+}
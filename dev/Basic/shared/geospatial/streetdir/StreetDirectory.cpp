@@ -12,6 +12,7 @@
 #include "A_StarShortestPathImpl.hpp"
 #include "A_StarPublicTransitShortestPathImpl.hpp"
 #include "A_StarShortestTravelTimePathImpl.hpp"
+#include "ContractionHierarchyShortestPathImpl.hpp"
 
 namespace sim_mob
 {
@@ -41,7 +42,14 @@ StreetDirectory::~StreetDirectory()
 void StreetDirectory::Init(const RoadNetwork& network)
 {
     if (!spImpl) {
-        spImpl = new A_StarShortestPathImpl(network);
+        const std::map<std::string, std::string>& props = ConfigManager::GetInstance().FullConfig().genericProps;
+        std::map<std::string, std::string>::const_iterator engineIt = props.find("shortest_path_engine");
+        if (engineIt != props.end() && engineIt->second == "contraction_hierarchy") {
+            std::map<std::string, std::string>::const_iterator cacheIt = props.find("ch_cache_file");
+            spImpl = new ContractionHierarchyShortestPathImpl(network, (cacheIt != props.end()) ? cacheIt->second : std::string());
+        } else {
+            spImpl = new A_StarShortestPathImpl(network);
+        }
     }
     if (!ptImpl && ConfigManager::GetInstance().FullConfig().isPublicTransitEnabled()) {
         ptImpl = new A_StarPublicTransitShortestPathImpl(PT_NetworkCreater::getInstance().PT_NetworkEdgeMap,PT_NetworkCreater::getInstance().PT_NetworkVertexMap);
@@ -0,0 +1,164 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "AsyncLogSink.hpp"
+
+#include <algorithm>
+#include <vector>
+#include <boost/bind.hpp>
+
+using namespace sim_mob;
+
+namespace {
+///Number of queue nodes allocated up front.
+const std::size_t INITIAL_QUEUE_NODES = 1024;
+
+///Longest wait of the background thread between polls of an empty queue, in microseconds.
+const int MAX_IDLE_WAIT_US = 5000;
+
+///Size above which the reused stream of a thread is released rather than kept.
+const std::size_t MAX_KEPT_STREAM_SIZE = 64 * 1024;
+
+/**
+ * The string streams of a thread not used by a message in progress. Usually holds a single stream, but a message
+ * may be started while another is being formatted (e.g. by a function called from within an output statement).
+ */
+struct StreamPool {
+    ~StreamPool() {
+        for (std::vector<std::ostringstream*>::iterator it = streams.begin(); it != streams.end(); ++it) {
+            delete *it;
+        }
+    }
+
+    std::vector<std::ostringstream*> streams;
+};
+
+boost::thread_specific_ptr<StreamPool> streamPools;
+
+///An output stream with default formatting, to reset the reused streams from.
+const std::ostringstream defaultFormat;
+}
+
+
+AsyncLogSink::AsyncLogSink(std::ostream& output, std::size_t maxPendingBytes, OverflowPolicy policy) :
+        output(output), maxPendingBytes(maxPendingBytes), policy(policy), entries(INITIAL_QUEUE_NODES),
+        pendingBytes(0), numDropped(0), done(false) {
+    writer = boost::thread(boost::bind(&AsyncLogSink::run, this));
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    done.store(true);
+    writer.join();
+}
+
+bool AsyncLogSink::submit(std::string& message) {
+    //Reserve room for the message; a message is always let through if nothing is pending, so that a message larger
+    //than the limit does not wait forever.
+    const std::size_t size = message.size();
+    std::size_t pending = pendingBytes.load(boost::memory_order_relaxed);
+    int waitUs = 1;
+    for (;;) {
+        if (pending == 0 || pending + size <= maxPendingBytes) {
+            if (pendingBytes.compare_exchange_weak(pending, pending + size)) {
+                break;
+            }
+            continue;
+        }
+        if (policy == DROP_ON_OVERFLOW) {
+            numDropped.fetch_add(1, boost::memory_order_relaxed);
+            return false;
+        }
+        boost::this_thread::sleep_for(boost::chrono::microseconds(waitUs));
+        waitUs = std::min(waitUs * 2, MAX_IDLE_WAIT_US);
+        pending = pendingBytes.load(boost::memory_order_relaxed);
+    }
+
+    Entry* entry = new Entry();
+    entry->text.swap(message);
+    entry->flushed = nullptr;
+    while (!entries.push(entry)) {
+        boost::this_thread::yield();
+    }
+    return true;
+}
+
+void AsyncLogSink::flush() {
+    boost::promise<void> flushed;
+    boost::unique_future<void> written = flushed.get_future();
+    Entry* entry = new Entry();
+    entry->flushed = &flushed;
+    while (!entries.push(entry)) {
+        boost::this_thread::yield();
+    }
+    written.wait();
+}
+
+void AsyncLogSink::run() {
+    int waitUs = 0;
+    for (;;) {
+        //Check before draining, so that messages submitted before the destructor was called are all written.
+        const bool stopping = done.load();
+        bool wrote = false;
+        Entry* entry = nullptr;
+        while (entries.pop(entry)) {
+            if (entry->flushed) {
+                output.flush();
+                entry->flushed->set_value();
+            } else {
+                output.write(entry->text.data(), entry->text.size());
+                pendingBytes.fetch_sub(entry->text.size());
+                wrote = true;
+            }
+            delete entry;
+        }
+
+        if (wrote) {
+            output.flush();
+            waitUs = 0;
+        } else if (stopping) {
+            break;
+        } else {
+            waitUs = std::min(std::max(waitUs * 2, 50), MAX_IDLE_WAIT_US);
+            boost::this_thread::sleep_for(boost::chrono::microseconds(waitUs));
+        }
+    }
+}
+
+
+AsyncLogMessage::~AsyncLogMessage() {
+    if (!stream) {
+        return;
+    }
+
+    std::string text = stream->str();
+    const std::size_t size = text.size();
+    if (size > 0) {
+        sink->submit(text);
+    }
+
+    if (size > MAX_KEPT_STREAM_SIZE) {
+        delete stream;
+        return;
+    }
+    stream->str(std::string());
+    stream->clear();
+    stream->copyfmt(defaultFormat);
+    streamPools->streams.push_back(stream);
+}
+
+std::ostream* AsyncLogMessage::begin(AsyncLogSink* sink) {
+    this->sink = sink;
+    if (!streamPools.get()) {
+        streamPools.reset(new StreamPool());
+    }
+
+    std::vector<std::ostringstream*>& streams = streamPools->streams;
+    if (streams.empty()) {
+        stream = new std::ostringstream();
+    } else {
+        stream = streams.back();
+        streams.pop_back();
+    }
+    return stream;
+}
@@ -0,0 +1,118 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <ostream>
+#include <sstream>
+#include <stdint.h>
+#include <string>
+#include <boost/align/aligned_allocator.hpp>
+#include <boost/atomic.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+
+namespace sim_mob {
+
+/**
+ * Writes log messages to an output stream from a background thread.
+ *
+ * Threads hand over complete messages through a lock-free queue, so that logging never waits on a mutex or on the
+ * file system. Memory is bounded: once the messages waiting to be written reach maxPendingBytes, submit() either
+ * waits for the background thread to catch up (BLOCK_ON_OVERFLOW) or drops the message (DROP_ON_OVERFLOW).
+ *
+ * Messages of one thread are written in the order they were submitted; messages of different threads are
+ * interleaved whole.
+ */
+class AsyncLogSink : private boost::noncopyable {
+public:
+    enum OverflowPolicy {
+        BLOCK_ON_OVERFLOW,
+        DROP_ON_OVERFLOW
+    };
+
+    /**
+     * Starts the background thread
+     * @param output the stream to write to; must outlive the sink
+     * @param maxPendingBytes maximum size of the messages waiting to be written (a larger single message is let through)
+     * @param policy what to do with messages submitted while the limit is reached
+     */
+    explicit AsyncLogSink(std::ostream& output, std::size_t maxPendingBytes = 64 * 1024 * 1024,
+                          OverflowPolicy policy = BLOCK_ON_OVERFLOW);
+
+    ///Writes out the remaining messages and stops the background thread. No message may be submitted concurrently.
+    ~AsyncLogSink();
+
+    /**
+     * Queues a message to be written
+     * @param message the message; moved from
+     * @return true if queued, false if dropped
+     */
+    bool submit(std::string& message);
+
+    ///Waits until the messages submitted so far by the calling thread have been written and the stream flushed.
+    void flush();
+
+    ///Number of messages dropped so far (DROP_ON_OVERFLOW only)
+    uint64_t getNumDropped() const {
+        return numDropped.load();
+    }
+
+private:
+    ///A queued message, or a flush request (if flushed is not null)
+    struct Entry {
+        std::string text;
+        boost::promise<void>* flushed;
+    };
+
+    ///Body of the background thread.
+    void run();
+
+    std::ostream& output;
+    const std::size_t maxPendingBytes;
+    const OverflowPolicy policy;
+
+    ///The queue nodes are cache line aligned, which std::allocator does not guarantee before C++17.
+    boost::lockfree::queue<Entry*, boost::lockfree::allocator<boost::alignment::aligned_allocator<Entry*, 64> > > entries;
+
+    ///Total size of the queued messages.
+    boost::atomic<std::size_t> pendingBytes;
+
+    boost::atomic<uint64_t> numDropped;
+
+    ///Set when the sink is destroyed; the background thread stops once the queue is empty.
+    boost::atomic<bool> done;
+
+    boost::thread writer;
+};
+
+
+/**
+ * The text of a single log statement, to be handed to an AsyncLogSink as a whole once the statement ends.
+ *
+ * The text is formatted into a string stream owned by the calling thread and reused by its later statements, so that
+ * formatting a message takes no lock and does not construct a stream. Submitting it still allocates: the text is
+ * copied out of the stream and queued in a newly allocated entry, and the queue may allocate a node.
+ */
+class AsyncLogMessage : private boost::noncopyable {
+public:
+    AsyncLogMessage() : sink(nullptr), stream(nullptr) {}
+
+    ///Submits the message, if any
+    ~AsyncLogMessage();
+
+    /**
+     * Starts a message
+     * @param sink the sink that receives the message on destruction
+     * @return the stream to format the message into
+     */
+    std::ostream* begin(AsyncLogSink* sink);
+
+private:
+    AsyncLogSink* sink;
+    std::ostringstream* stream;
+};
+
+}
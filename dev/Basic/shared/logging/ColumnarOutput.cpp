@@ -0,0 +1,454 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "ColumnarOutput.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+using namespace sim_mob;
+
+namespace
+{
+const char MAGIC[] = "SMCOLS1\n";
+const std::size_t MAGIC_LENGTH = sizeof(MAGIC) - 1;
+
+void writeVarint(std::string& output, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    output.push_back(static_cast<char>(value));
+}
+
+void writeString(std::string& output, const std::string& value)
+{
+    writeVarint(output, value.size());
+    output.append(value);
+}
+
+/**
+ * reads a varint from a stream
+ * @return false if the stream is at its end before the first byte
+ */
+bool readVarint(std::istream& input, uint64_t& value)
+{
+    value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+    {
+        const int byte = input.get();
+        if (byte == std::char_traits<char>::eof())
+        {
+            if (shift == 0)
+            {
+                return false;
+            }
+            throw std::runtime_error("columnar output: truncated file");
+        }
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    throw std::runtime_error("columnar output: invalid varint");
+}
+
+uint64_t readRequiredVarint(std::istream& input)
+{
+    uint64_t value;
+    if (!readVarint(input, value))
+    {
+        throw std::runtime_error("columnar output: truncated file");
+    }
+    return value;
+}
+
+std::string readString(std::istream& input)
+{
+    const uint64_t length = readRequiredVarint(input);
+    std::string value(length, '\0');
+    if (length > 0 && !input.read(&value[0], length))
+    {
+        throw std::runtime_error("columnar output: truncated file");
+    }
+    return value;
+}
+
+/** reads a varint from a buffer, advancing the position */
+uint64_t readVarint(const std::string& input, std::size_t& position)
+{
+    uint64_t value = 0;
+    for (unsigned int shift = 0; shift < 64 && position < input.size(); shift += 7)
+    {
+        const unsigned char byte = input[position++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+    throw std::runtime_error("columnar output: invalid column data");
+}
+
+void encodeIntegers(const std::vector<int64_t>& values, std::string& output)
+{
+    uint64_t previous = 0;
+    for (std::vector<int64_t>::const_iterator it = values.begin(); it != values.end(); ++it)
+    {
+        const uint64_t delta = static_cast<uint64_t>(*it) - previous;
+        //zigzag, so that small negative differences take few bytes too
+        writeVarint(output, (delta << 1) ^ (static_cast<int64_t>(delta) < 0 ? ~uint64_t(0) : 0));
+        previous = static_cast<uint64_t>(*it);
+    }
+}
+
+void decodeIntegers(const std::string& input, std::size_t numValues, std::vector<int64_t>& values)
+{
+    values.resize(numValues);
+    uint64_t previous = 0;
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < numValues; i++)
+    {
+        const uint64_t zigzag = readVarint(input, position);
+        previous += (zigzag >> 1) ^ (zigzag & 1 ? ~uint64_t(0) : 0);
+        values[i] = static_cast<int64_t>(previous);
+    }
+    if (position != input.size())
+    {
+        throw std::runtime_error("columnar output: invalid column data");
+    }
+}
+
+void encodeReals(const std::vector<double>& values, std::string& output)
+{
+    uint64_t previous = 0;
+    for (std::vector<double>::const_iterator it = values.begin(); it != values.end(); ++it)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &*it, sizeof(bits));
+        const uint64_t xored = bits ^ previous;
+        previous = bits;
+
+        unsigned int leadingZeroBytes = 0;
+        while (leadingZeroBytes < 8 && ((xored >> (8 * (7 - leadingZeroBytes))) & 0xFF) == 0)
+        {
+            leadingZeroBytes++;
+        }
+        output.push_back(static_cast<char>(leadingZeroBytes));
+        for (int byte = 7 - leadingZeroBytes; byte >= 0; byte--)
+        {
+            output.push_back(static_cast<char>((xored >> (8 * byte)) & 0xFF));
+        }
+    }
+}
+
+void decodeReals(const std::string& input, std::size_t numValues, std::vector<double>& values)
+{
+    values.resize(numValues);
+    uint64_t previous = 0;
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < numValues; i++)
+    {
+        if (position >= input.size() || static_cast<unsigned char>(input[position]) > 8
+                || position + 9 - static_cast<unsigned char>(input[position]) > input.size())
+        {
+            throw std::runtime_error("columnar output: invalid column data");
+        }
+        const unsigned int numBytes = 8 - static_cast<unsigned char>(input[position++]);
+        uint64_t xored = 0;
+        for (unsigned int byte = 0; byte < numBytes; byte++)
+        {
+            xored = (xored << 8) | static_cast<unsigned char>(input[position++]);
+        }
+        previous ^= xored;
+        std::memcpy(&values[i], &previous, sizeof(previous));
+    }
+    if (position != input.size())
+    {
+        throw std::runtime_error("columnar output: invalid column data");
+    }
+}
+}
+
+const unsigned int ColumnSchema::FULL_PRECISION;
+
+ColumnarBuffer::ColumnarBuffer(ColumnarWriter& writer) : writer(writer), nextColumn(0)
+{
+    resetChunk();
+}
+
+void ColumnarBuffer::resetChunk()
+{
+    const std::vector<ColumnSchema>& columns = writer.getColumns();
+    chunk.numRows = 0;
+    chunk.columns.clear();
+    chunk.columns.resize(columns.size());
+    for (std::size_t i = 0; i < columns.size(); i++)
+    {
+        if (columns[i].type == ColumnSchema::INTEGER)
+        {
+            chunk.columns[i].integers.reserve(writer.getChunkRows());
+        }
+        else
+        {
+            chunk.columns[i].reals.reserve(writer.getChunkRows());
+        }
+    }
+}
+
+void ColumnarBuffer::appendInteger(int64_t value)
+{
+    if (nextColumn >= chunk.columns.size())
+    {
+        throw std::runtime_error("columnar output: too many values in a row");
+    }
+    if (writer.getColumns()[nextColumn].type == ColumnSchema::INTEGER)
+    {
+        chunk.columns[nextColumn].integers.push_back(value);
+    }
+    else
+    {
+        chunk.columns[nextColumn].reals.push_back(static_cast<double>(value));
+    }
+    nextColumn++;
+}
+
+void ColumnarBuffer::appendReal(double value)
+{
+    if (nextColumn >= chunk.columns.size())
+    {
+        throw std::runtime_error("columnar output: too many values in a row");
+    }
+    if (writer.getColumns()[nextColumn].type != ColumnSchema::REAL)
+    {
+        throw std::runtime_error("columnar output: real value for integer column " + writer.getColumns()[nextColumn].name);
+    }
+    chunk.columns[nextColumn].reals.push_back(value);
+    nextColumn++;
+}
+
+void ColumnarBuffer::endRow()
+{
+    if (nextColumn != chunk.columns.size())
+    {
+        throw std::runtime_error("columnar output: row ended before its last column");
+    }
+    nextColumn = 0;
+    chunk.numRows++;
+    if (chunk.numRows >= writer.getChunkRows())
+    {
+        flush();
+    }
+}
+
+void ColumnarBuffer::flush()
+{
+    if (nextColumn > 0)
+    {
+        //drop the values of an unfinished row
+        for (std::vector<ColumnValues>::iterator it = chunk.columns.begin(); it != chunk.columns.end(); ++it)
+        {
+            it->integers.resize(std::min(it->integers.size(), chunk.numRows));
+            it->reals.resize(std::min(it->reals.size(), chunk.numRows));
+        }
+        nextColumn = 0;
+    }
+    if (chunk.numRows > 0)
+    {
+        writer.submit(chunk);
+        resetChunk();
+    }
+}
+
+ColumnarWriter::ColumnarWriter(const std::string& fileName, const std::string& tableName,
+                               const std::vector<ColumnSchema>& columns, std::size_t chunkRows,
+                               std::size_t maxPendingChunks) :
+        file(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc), columns(columns),
+        chunkRows(chunkRows > 0 ? chunkRows : 1), pendingChunks(maxPendingChunks), closed(false)
+{
+    if (!file)
+    {
+        throw std::runtime_error("columnar output: cannot open " + fileName);
+    }
+    if (columns.empty())
+    {
+        throw std::runtime_error("columnar output: table " + tableName + " has no columns");
+    }
+
+    std::string header(MAGIC, MAGIC_LENGTH);
+    writeString(header, tableName);
+    writeVarint(header, columns.size());
+    for (std::vector<ColumnSchema>::const_iterator it = columns.begin(); it != columns.end(); ++it)
+    {
+        header.push_back(static_cast<char>(it->type));
+        header.push_back(static_cast<char>(std::min(it->precision, ColumnSchema::FULL_PRECISION)));
+        writeString(header, it->name);
+    }
+    file.write(header.data(), header.size());
+
+    writerThread = boost::thread(&ColumnarWriter::writeChunks, this);
+}
+
+ColumnarWriter::~ColumnarWriter()
+{
+    try
+    {
+        close();
+    }
+    catch (const std::exception&)
+    {
+    }
+}
+
+ColumnarBuffer& ColumnarWriter::getThreadBuffer()
+{
+    boost::lock_guard<boost::mutex> lock(buffersMutex);
+    std::unique_ptr<ColumnarBuffer>& buffer = buffers[boost::this_thread::get_id()];
+    if (!buffer)
+    {
+        buffer.reset(new ColumnarBuffer(*this));
+    }
+    return *buffer;
+}
+
+void ColumnarWriter::close()
+{
+    {
+        boost::lock_guard<boost::mutex> lock(buffersMutex);
+        if (closed)
+        {
+            return;
+        }
+        for (std::map<boost::thread::id, std::unique_ptr<ColumnarBuffer> >::iterator it = buffers.begin(); it != buffers.end(); ++it)
+        {
+            it->second->flush();
+        }
+        closed = true;
+    }
+    pendingChunks.close();
+    writerThread.join();
+
+    const bool failed = !file;
+    file.close();
+    if (failed)
+    {
+        throw std::runtime_error("columnar output: write failed");
+    }
+}
+
+void ColumnarWriter::submit(ColumnarChunk& chunk)
+{
+    //rows recorded after closing are dropped by the closed queue
+    pendingChunks.push(chunk);
+}
+
+void ColumnarWriter::writeChunks()
+{
+    ColumnarChunk chunk;
+    std::string encoded;
+    std::string column;
+    while (pendingChunks.pop(chunk))
+    {
+        encoded.clear();
+        writeVarint(encoded, chunk.numRows);
+        for (std::size_t i = 0; i < columns.size(); i++)
+        {
+            column.clear();
+            if (columns[i].type == ColumnSchema::INTEGER)
+            {
+                encodeIntegers(chunk.columns[i].integers, column);
+            }
+            else
+            {
+                encodeReals(chunk.columns[i].reals, column);
+            }
+            writeString(encoded, column);
+        }
+        file.write(encoded.data(), encoded.size());
+    }
+    file.flush();
+}
+
+ColumnarReader::ColumnarReader(std::istream& input) : input(input)
+{
+    char magic[MAGIC_LENGTH];
+    if (!input.read(magic, MAGIC_LENGTH) || std::memcmp(magic, MAGIC, MAGIC_LENGTH) != 0)
+    {
+        throw std::runtime_error("columnar output: not a columnar output file");
+    }
+    tableName = readString(input);
+    const uint64_t numColumns = readRequiredVarint(input);
+    for (uint64_t i = 0; i < numColumns; i++)
+    {
+        const int type = input.get();
+        const int precision = input.get();
+        if (precision == std::char_traits<char>::eof() || (type != ColumnSchema::INTEGER && type != ColumnSchema::REAL))
+        {
+            throw std::runtime_error("columnar output: invalid column header");
+        }
+        const std::string name = readString(input);
+        columns.push_back(ColumnSchema(name, static_cast<ColumnSchema::Type>(type), precision));
+    }
+}
+
+bool ColumnarReader::readChunk(ColumnarChunk& chunk)
+{
+    uint64_t numRows;
+    if (!readVarint(input, numRows))
+    {
+        return false;
+    }
+    chunk.numRows = numRows;
+    chunk.columns.clear();
+    chunk.columns.resize(columns.size());
+    for (std::size_t i = 0; i < columns.size(); i++)
+    {
+        const std::string column = readString(input);
+        if (columns[i].type == ColumnSchema::INTEGER)
+        {
+            decodeIntegers(column, numRows, chunk.columns[i].integers);
+        }
+        else
+        {
+            decodeReals(column, numRows, chunk.columns[i].reals);
+        }
+    }
+    return true;
+}
+
+void ColumnarReader::writeCsv(std::ostream& output)
+{
+    ColumnarChunk chunk;
+    char value[400];
+    std::string line;
+    while (readChunk(chunk))
+    {
+        for (std::size_t row = 0; row < chunk.numRows; row++)
+        {
+            line = tableName;
+            for (std::size_t i = 0; i < columns.size(); i++)
+            {
+                if (columns[i].type == ColumnSchema::INTEGER)
+                {
+                    std::snprintf(value, sizeof(value), ",%lld", static_cast<long long>(chunk.columns[i].integers[row]));
+                }
+                else if (columns[i].precision == ColumnSchema::FULL_PRECISION)
+                {
+                    std::snprintf(value, sizeof(value), ",%.17g", chunk.columns[i].reals[row]);
+                }
+                else
+                {
+                    std::snprintf(value, sizeof(value), ",%.*f", static_cast<int>(columns[i].precision), chunk.columns[i].reals[row]);
+                }
+                line.append(value);
+            }
+            line.push_back('\n');
+            output << line;
+        }
+    }
+}
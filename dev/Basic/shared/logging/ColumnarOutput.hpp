@@ -0,0 +1,279 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+
+#include "util/BoundedQueue.hpp"
+
+/**
+ * \file ColumnarOutput.hpp
+ *
+ * Binary, column oriented output of tables of statistics (e.g. the segment and link statistics of the mid-term).
+ *
+ * Rows are recorded into per thread buffers without any formatting or locking, and the buffers are handed over in
+ * chunks to a background thread, which encodes each column of the chunk and appends it to the file.
+ *
+ * File layout (all counts are unsigned LEB128 varints):
+ *   magic "SMCOLS1\n" | table name length, table name | number of columns |
+ *   for each column: type (1 byte), csv precision (1 byte, 255 for full precision), name length, name |
+ *   chunks until the end of the file; for each chunk: number of rows |
+ *       for each column: number of bytes, encoded values
+ *
+ * Integer columns hold the zigzag encoded differences between consecutive values as varints. Real columns hold the
+ * bits of each value XOR-ed with the bits of the previous one, as one byte counting the leading zero bytes of the
+ * result followed by its remaining bytes (most significant first); repeated values therefore take a single byte.
+ */
+
+namespace sim_mob
+{
+
+/** column of a columnar table */
+struct ColumnSchema
+{
+    enum Type
+    {
+        INTEGER = 0,
+        REAL = 1
+    };
+
+    /** value of precision for which reals are printed in full */
+    static const unsigned int FULL_PRECISION = 255;
+
+    ColumnSchema() : type(INTEGER), precision(FULL_PRECISION)
+    {
+    }
+
+    ColumnSchema(const std::string& name, Type type, unsigned int precision = FULL_PRECISION) :
+            name(name), type(type), precision(precision)
+    {
+    }
+
+    std::string name;
+    Type type;
+
+    /** number of decimals of the column when converted to csv (reals only) */
+    unsigned int precision;
+};
+
+/** values of a column, in row order; only the vector matching the type of the column is used */
+struct ColumnValues
+{
+    std::vector<int64_t> integers;
+    std::vector<double> reals;
+};
+
+/** rows of a columnar table, stored column by column */
+struct ColumnarChunk
+{
+    ColumnarChunk() : numRows(0)
+    {
+    }
+
+    std::size_t numRows;
+    std::vector<ColumnValues> columns;
+};
+
+class ColumnarWriter;
+
+/**
+ * Rows recorded by one thread.
+ *
+ * Values are streamed in column order and each row is ended with endRow(), e.g.
+ *     buffer << interval << segmentId << density;
+ *     buffer.endRow();
+ * A buffer must only be used by the thread it was obtained by (see ColumnarWriter::getThreadBuffer()).
+ */
+class ColumnarBuffer : private boost::noncopyable
+{
+public:
+    /**
+     * Appends an integral value to the current row; converted to a real in real columns
+     * @param value the value
+     * @return the buffer
+     */
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value, ColumnarBuffer&>::type operator<<(T value)
+    {
+        appendInteger(static_cast<int64_t>(value));
+        return *this;
+    }
+
+    /**
+     * Appends a real value to the current row; only allowed in real columns
+     * @param value the value
+     * @return the buffer
+     */
+    template<typename T>
+    typename std::enable_if<std::is_floating_point<T>::value, ColumnarBuffer&>::type operator<<(T value)
+    {
+        appendReal(static_cast<double>(value));
+        return *this;
+    }
+
+    /**
+     * Ends the current row, which must have a value for every column. Hands the buffered rows over to the writer once
+     * a chunk is full
+     */
+    void endRow();
+
+    /**
+     * Hands the buffered rows over to the writer; does nothing if no row is buffered. The values of an unfinished row
+     * are dropped
+     */
+    void flush();
+
+private:
+    friend class ColumnarWriter;
+
+    ColumnarBuffer(ColumnarWriter& writer);
+
+    void appendInteger(int64_t value);
+    void appendReal(double value);
+
+    /** empties the chunk and prepares its columns */
+    void resetChunk();
+
+    ColumnarWriter& writer;
+
+    /** rows buffered so far */
+    ColumnarChunk chunk;
+
+    /** index of the next column of the current row */
+    std::size_t nextColumn;
+};
+
+/**
+ * Writes one columnar table to a file.
+ *
+ * Rows are recorded concurrently through the buffers of the recording threads, and encoded and written by a
+ * background thread. If the background thread falls behind by more than a few chunks, the recording threads wait.
+ */
+class ColumnarWriter : private boost::noncopyable
+{
+public:
+    /**
+     * Opens the file and writes the table header
+     *
+     * @param fileName output file; overwritten
+     * @param tableName name of the table, printed at the start of each row when converted to csv
+     * @param columns columns of the table
+     * @param chunkRows number of rows of a thread buffered before they are handed to the background thread
+     * @param maxPendingChunks number of chunks waiting to be written before the recording threads wait
+     *
+     * @throws std::runtime_error if the file cannot be opened or there are no columns
+     */
+    ColumnarWriter(const std::string& fileName, const std::string& tableName, const std::vector<ColumnSchema>& columns,
+                   std::size_t chunkRows = 65536, std::size_t maxPendingChunks = 8);
+
+    /**
+     * Closes the writer, if not closed yet
+     */
+    ~ColumnarWriter();
+
+    /**
+     * Finds the buffer of the calling thread; callers recording many rows should keep the reference rather than call
+     * this for every row
+     * @return the buffer of the calling thread, created on first use
+     */
+    ColumnarBuffer& getThreadBuffer();
+
+    /**
+     * Flushes the buffers of all threads, waits until everything has been written and closes the file. The buffers
+     * must not be in use by other threads. Rows recorded after closing are discarded.
+     */
+    void close();
+
+    const std::vector<ColumnSchema>& getColumns() const
+    {
+        return columns;
+    }
+
+    std::size_t getChunkRows() const
+    {
+        return chunkRows;
+    }
+
+private:
+    friend class ColumnarBuffer;
+
+    /** hands a chunk to the background thread */
+    void submit(ColumnarChunk& chunk);
+
+    /** body of the background thread */
+    void writeChunks();
+
+    std::ofstream file;
+    const std::vector<ColumnSchema> columns;
+    const std::size_t chunkRows;
+
+    /** chunks waiting to be written */
+    BoundedQueue<ColumnarChunk> pendingChunks;
+
+    /** background thread */
+    boost::thread writerThread;
+
+    /** buffers of the recording threads; owned here rather than by the threads so that rows of finished threads are not lost */
+    std::map<boost::thread::id, std::unique_ptr<ColumnarBuffer> > buffers;
+    boost::mutex buffersMutex;
+
+    bool closed;
+};
+
+/**
+ * Reads a file written by ColumnarWriter
+ */
+class ColumnarReader
+{
+public:
+    /**
+     * Reads the table header
+     * @param input stream positioned at the start of the file; opened in binary mode
+     * @throws std::runtime_error if the header is not valid
+     */
+    explicit ColumnarReader(std::istream& input);
+
+    const std::string& getTableName() const
+    {
+        return tableName;
+    }
+
+    const std::vector<ColumnSchema>& getColumns() const
+    {
+        return columns;
+    }
+
+    /**
+     * Reads and decodes the next chunk
+     * @param chunk output chunk
+     * @return true if a chunk was read; false at the end of the file
+     * @throws std::runtime_error if the chunk is truncated or not valid
+     */
+    bool readChunk(ColumnarChunk& chunk);
+
+    /**
+     * Converts the remaining rows to csv, one line per row starting with the table name (the format of the text
+     * output of the statistics)
+     * @param output output stream
+     */
+    void writeCsv(std::ostream& output);
+
+private:
+    std::istream& input;
+    std::string tableName;
+    std::vector<ColumnSchema> columns;
+};
+
+}
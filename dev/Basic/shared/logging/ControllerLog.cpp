@@ -14,16 +14,21 @@ using std::map;
 boost::shared_ptr<boost::mutex>   sim_mob::ControllerLog::log_mutex;
 std::ostream*   sim_mob::ControllerLog::log_handle = &std::cout;
 std::ofstream   sim_mob::ControllerLog::log_file;
+boost::scoped_ptr<AsyncLogSink>   sim_mob::ControllerLog::log_sink; //After log_file, so that it is destroyed first.
 
 
 //////////////////////////////////////////////////////////////
 // ControllerLog implementation
 //////////////////////////////////////////////////////////////
 
-sim_mob::ControllerLog::ControllerLog()
+sim_mob::ControllerLog::ControllerLog() : out(compiled_in ? log_handle : nullptr)
 {
-
-    if (log_mutex) {
+    if (!out) {
+        return;
+    }
+    if (log_sink) {
+        out = message.begin(log_sink.get());
+    } else if (log_mutex) {
         local_lock = boost::mutex::scoped_lock(*log_mutex);
     }
 }
@@ -31,9 +36,9 @@ sim_mob::ControllerLog::ControllerLog()
 
 sim_mob::ControllerLog::~ControllerLog()
 {
-    //Flush any pending output to stdout.
-    if (log_handle) {
-        (*log_handle) <<std::flush;
+    //Flush any pending output to stdout. Output to a file is handed to the sink (and flushed) by the message.
+    if (out && !log_sink) {
+        (*out) <<std::flush;
     }
 }
 
@@ -50,6 +55,7 @@ void sim_mob::ControllerLog::Init(const string& path)
 {
     log_handle = CreateStream(path, log_file);
     log_mutex = RegisterStream(log_handle);
+    log_sink.reset(CreateSink(log_handle, log_file));
 }
 
 void sim_mob::ControllerLog::Ignore()
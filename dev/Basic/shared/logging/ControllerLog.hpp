@@ -24,8 +24,8 @@ public:
     ///Hack to get manipulators (std::endl) to work.
     ///NOTE: I have *no* idea if this is extremely stupid or not. ~Seth
     ControllerLog& operator<<(StandardEndLine manip) {
-        if (log_handle) {
-            manip(*log_handle);
+        if (compiled_in && out) {
+            manip(*out);
         }
         return *this;
     }
@@ -60,8 +60,21 @@ private:
     /// closed automatically.
     static std::ofstream log_file;
 
+    ///Writes log_file in the background; null if logging to the console, which is written directly (under log_mutex)
+    /// so that it stays in order with other console output.
+    static boost::scoped_ptr<AsyncLogSink> log_sink;
+
+    ///False if ControllerLog output is compiled out (see SIMMOB_LOG_LEVEL).
+    static const bool compiled_in = (SIMMOB_LOG_LEVEL >= SIMMOB_LOG_LEVEL_PRINT);
+
     ///A scoped lock on the log_mutex. May be null, in which case output is not locked.
     boost::mutex::scoped_lock local_lock;
+
+    ///The message being formatted, if logging to log_sink.
+    AsyncLogMessage message;
+
+    ///Where this object writes to: log_handle, the stream of the message, or null if logging is disabled.
+    std::ostream* out;
 };
 }
 
@@ -70,7 +83,7 @@ private:
 // Macros for each StaticLogManager subclass.
 //////////////////////////////////////////////////////////////
 
-#ifdef SIMMOB_DISABLE_OUTPUT
+#if defined(SIMMOB_DISABLE_OUTPUT) || SIMMOB_LOG_LEVEL < SIMMOB_LOG_LEVEL_PRINT
 
 //Simply destroy this text; no logging; no locking
 #define ControllerLogOut( strm )  DO_NOTHING
@@ -84,13 +97,13 @@ private:
     } \
     while (0)
 
-#endif //SIMMOB_DISABLE_OUTPUT
+#endif
 
 template <typename T>
 sim_mob::ControllerLog& sim_mob::ControllerLog::operator<< (const T& val)
 {
-    if (log_handle) {
-        (*log_handle) <<val;
+    if (compiled_in && out) {
+        (*out) <<val;
     }
     return *this;
 }
@@ -22,21 +22,25 @@ map<const std::ostream*, boost::shared_ptr<boost::mutex> > sim_mob::StaticLogMan
 boost::shared_ptr<boost::mutex>   sim_mob::Warn::log_mutex;
 std::ostream*   sim_mob::Warn::log_handle = &std::cout;
 std::ofstream   sim_mob::Warn::log_file;
+boost::scoped_ptr<AsyncLogSink>   sim_mob::Warn::log_sink; //After log_file, so that it is destroyed first.
 
 //Print
 boost::shared_ptr<boost::mutex>   sim_mob::Print::log_mutex;
 std::ostream*   sim_mob::Print::log_handle = &std::cout;
 std::ofstream   sim_mob::Print::log_file;
+boost::scoped_ptr<AsyncLogSink>   sim_mob::Print::log_sink; //After log_file, so that it is destroyed first.
 
 //PassengerInfoPrint
 boost::shared_ptr<boost::mutex>   sim_mob::PassengerInfoPrint::log_mutex;
 std::ostream*   sim_mob::PassengerInfoPrint::log_handle = &std::cout;
 std::ofstream   sim_mob::PassengerInfoPrint::log_file;
+boost::scoped_ptr<AsyncLogSink>   sim_mob::PassengerInfoPrint::log_sink; //After log_file, so that it is destroyed first.
 
 //HeadwayAtBusStopInfoPrint
 boost::shared_ptr<boost::mutex>   sim_mob::HeadwayAtBusStopInfoPrint::log_mutex;
 std::ostream*   sim_mob::HeadwayAtBusStopInfoPrint::log_handle = &std::cout;
 std::ofstream   sim_mob::HeadwayAtBusStopInfoPrint::log_file;
+boost::scoped_ptr<AsyncLogSink>   sim_mob::HeadwayAtBusStopInfoPrint::log_sink; //After log_file, so that it is destroyed first.
 
 
 boost::shared_ptr<boost::mutex> sim_mob::StaticLogManager::RegisterStream(const std::ostream* str)
@@ -58,14 +62,26 @@ std::ostream* sim_mob::StaticLogManager::OpenStream(const string& path, std::ofs
 }
 
 
+AsyncLogSink* sim_mob::StaticLogManager::CreateSink(const std::ostream* handle, std::ofstream& file)
+{
+    if (handle != &file) { return nullptr; }
+    return new AsyncLogSink(file);
+}
+
+
 
 //////////////////////////////////////////////////////////////
 // Warn implementation
 //////////////////////////////////////////////////////////////
 
-sim_mob::Warn::Warn()
+sim_mob::Warn::Warn() : out(compiled_in ? log_handle : nullptr)
 {
-    if (log_mutex) {
+    if (!out) {
+        return;
+    }
+    if (log_sink) {
+        out = message.begin(log_sink.get());
+    } else if (log_mutex) {
         local_lock = boost::mutex::scoped_lock(*log_mutex);
     }
 }
@@ -73,9 +89,9 @@ sim_mob::Warn::Warn()
 
 sim_mob::Warn::~Warn()
 {
-    //Flush any pending output to stdout.
-    if (log_handle) {
-        (*log_handle) <<std::flush;
+    //Flush any pending output to stdout. Output to a file is handed to the sink (and flushed) by the message.
+    if (out && !log_sink) {
+        (*out) <<std::flush;
     }
 }
 
@@ -83,6 +99,7 @@ void sim_mob::Warn::Init(const string& path)
 {
     log_handle = OpenStream(path, log_file);
     log_mutex = RegisterStream(log_handle);
+    log_sink.reset(CreateSink(log_handle, log_file));
 }
 
 void sim_mob::Warn::Ignore()
@@ -101,9 +118,14 @@ bool sim_mob::Warn::IsEnabled()
 // Print implementation
 //////////////////////////////////////////////////////////////
 
-sim_mob::Print::Print()
+sim_mob::Print::Print() : out(compiled_in ? log_handle : nullptr)
 {
-    if (log_mutex) {
+    if (!out) {
+        return;
+    }
+    if (log_sink) {
+        out = message.begin(log_sink.get());
+    } else if (log_mutex) {
         local_lock = boost::mutex::scoped_lock(*log_mutex);
     }
 }
@@ -111,9 +133,9 @@ sim_mob::Print::Print()
 
 sim_mob::Print::~Print()
 {
-    //Flush any pending output to stdout.
-    if (log_handle) {
-        (*log_handle) <<std::flush;
+    //Flush any pending output to stdout. Output to a file is handed to the sink (and flushed) by the message.
+    if (out && !log_sink) {
+        (*out) <<std::flush;
     }
 }
 
@@ -121,6 +143,7 @@ void sim_mob::Print::Init(const string& path)
 {
     log_handle = OpenStream(path, log_file);
     log_mutex = RegisterStream(log_handle);
+    log_sink.reset(CreateSink(log_handle, log_file));
 }
 
 void sim_mob::Print::Ignore()
@@ -139,9 +162,14 @@ bool sim_mob::Print::IsEnabled()
 // PassengerInfoPrint implementation
 //////////////////////////////////////////////////////////////
 
-sim_mob::PassengerInfoPrint::PassengerInfoPrint()
+sim_mob::PassengerInfoPrint::PassengerInfoPrint() : out(compiled_in ? log_handle : nullptr)
 {
-    if (log_mutex) {
+    if (!out) {
+        return;
+    }
+    if (log_sink) {
+        out = message.begin(log_sink.get());
+    } else if (log_mutex) {
         local_lock = boost::mutex::scoped_lock(*log_mutex);
     }
 }
@@ -149,9 +177,9 @@ sim_mob::PassengerInfoPrint::PassengerInfoPrint()
 
 sim_mob::PassengerInfoPrint::~PassengerInfoPrint()
 {
-    //Flush any pending output to stdout.
-    if (log_handle) {
-        (*log_handle) <<std::flush;
+    //Flush any pending output to stdout. Output to a file is handed to the sink (and flushed) by the message.
+    if (out && !log_sink) {
+        (*out) <<std::flush;
     }
 }
 
@@ -159,6 +187,7 @@ void sim_mob::PassengerInfoPrint::Init(const string& path)
 {
     log_handle = OpenStream(path, log_file);
     log_mutex = RegisterStream(log_handle);
+    log_sink.reset(CreateSink(log_handle, log_file));
 }
 
 void sim_mob::PassengerInfoPrint::Ignore()
@@ -176,18 +205,23 @@ bool sim_mob::PassengerInfoPrint::IsEnabled()
 // HeadwayAtBusStopInfoPrint implementation
 //////////////////////////////////////////////////////////////
 
-sim_mob::HeadwayAtBusStopInfoPrint::HeadwayAtBusStopInfoPrint()
+sim_mob::HeadwayAtBusStopInfoPrint::HeadwayAtBusStopInfoPrint() : out(compiled_in ? log_handle : nullptr)
 {
-    if (log_mutex) {
+    if (!out) {
+        return;
+    }
+    if (log_sink) {
+        out = message.begin(log_sink.get());
+    } else if (log_mutex) {
         local_lock = boost::mutex::scoped_lock(*log_mutex);
     }
 }
 
 sim_mob::HeadwayAtBusStopInfoPrint::~HeadwayAtBusStopInfoPrint()
 {
-    //Flush any pending output to stdout.
-    if (log_handle) {
-        (*log_handle) <<std::flush;
+    //Flush any pending output to stdout. Output to a file is handed to the sink (and flushed) by the message.
+    if (out && !log_sink) {
+        (*out) <<std::flush;
     }
 }
 
@@ -195,6 +229,7 @@ void sim_mob::HeadwayAtBusStopInfoPrint::Init(const string& path)
 {
     log_handle = OpenStream(path, log_file);
     log_mutex = RegisterStream(log_handle);
+    log_sink.reset(CreateSink(log_handle, log_file));
 }
 
 void sim_mob::HeadwayAtBusStopInfoPrint::Ignore()
@@ -18,6 +18,7 @@
 
 //This is a minimal header file, so please keep includes to a minimum.
 #include "conf/settings/DisableOutput.h"
+#include "conf/settings/LogLevel.h"
 
 #include <iostream>
 #include <fstream>
@@ -25,13 +26,25 @@
 #include <map>
 
 #include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
 #include <boost/format.hpp>
 
+#include "logging/AsyncLogSink.hpp"
 #include "util/LangHelpers.hpp"
 
 
+//Logging levels for SIMMOB_LOG_LEVEL; output of a level above SIMMOB_LOG_LEVEL is compiled out.
+#ifndef SIMMOB_LOG_LEVEL
+#define SIMMOB_LOG_LEVEL 3
+#endif
+
+#define SIMMOB_LOG_LEVEL_NONE  0  ///<No logging at all.
+#define SIMMOB_LOG_LEVEL_WARN  1  ///<Warn() and WarnOut()
+#define SIMMOB_LOG_LEVEL_PRINT 2  ///<Print(), PrintOut() and the other printed output (e.g., ControllerLog)
+#define SIMMOB_LOG_LEVEL_ALL   3  ///<LogOut()
+
 namespace sim_mob {
 
 
@@ -69,6 +82,14 @@ namespace sim_mob {
  * the stream's operator of the same name. Finally, when the StaticLogManager temporary is destructed, the output
  * buffer is flushed and the mutex is released.
  *
+ * Output to a file is not locked: each StaticLogManager temporary formats its text into a string stream owned by the
+ * calling thread, and hands it over as a whole to an AsyncLogSink on destruction, which writes it to the file from
+ * a background thread. Statements of one thread appear in the file in order, those of different threads are not
+ * interleaved within a statement (as with locking).
+ *
+ * Each subclass belongs to a logging level; if SIMMOB_LOG_LEVEL (set in cmake) is below that level, its output
+ * compiles to nothing.
+ *
  * It is functionally possible to create a StaticLogManager object that does not lock, but this is considered useless,
  * since the user would have to know that locking is not required to use that function, and mutexes which
  * are only seized by one entity incur almost no overhead. If overhead is a proble, it is likely that one
@@ -98,6 +119,10 @@ protected:
     ///  return a pointer to cout.
     static std::ostream* OpenStream(const std::string& path, std::ofstream& file);
 
+    ///Helper function for subclasses: If "handle" (as returned by OpenStream) is the file, create a sink writing
+    ///  to it in the background. Else, return null, so that the console is written directly.
+    static AsyncLogSink* CreateSink(const std::ostream* handle, std::ofstream& file);
+
 public:
     //Type of cout.
     typedef std::basic_ostream<char, std::char_traits<char> > CoutType;
@@ -144,8 +169,8 @@ public:
     ///Hack to get manipulators (std::endl) to work.
     ///NOTE: I have *no* idea if this is extremely stupid or not. ~Seth
     Warn& operator<<(StandardEndLine manip) {
-        if (log_handle) {
-            manip(*log_handle);
+        if (compiled_in && out) {
+            manip(*out);
         }
         return *this;
     }
@@ -178,8 +203,21 @@ private:
     /// closed automatically.
     static std::ofstream log_file;
 
+    ///Writes log_file in the background; null if logging to the console, which is written directly (under log_mutex)
+    /// so that it stays in order with other console output.
+    static boost::scoped_ptr<AsyncLogSink> log_sink;
+
+    ///False if Warn output is compiled out (see SIMMOB_LOG_LEVEL).
+    static const bool compiled_in = (SIMMOB_LOG_LEVEL >= SIMMOB_LOG_LEVEL_WARN);
+
     ///A scoped lock on the log_mutex. May be null, in which case output is not locked.
     boost::mutex::scoped_lock local_lock;
+
+    ///The message being formatted, if logging to log_sink.
+    AsyncLogMessage message;
+
+    ///Where this object writes to: log_handle, the stream of the message, or null if logging is disabled.
+    std::ostream* out;
 };
 
 
@@ -220,8 +258,8 @@ public:
     ///Hack to get manipulators (std::endl) to work.
     ///NOTE: I have *no* idea if this is extremely stupid or not. ~Seth
     Print& operator<<(StandardEndLine manip) {
-        if (log_handle) {
-            manip(*log_handle);
+        if (compiled_in && out) {
+            manip(*out);
         }
         return *this;
     }
@@ -254,8 +292,21 @@ private:
     /// closed automatically.
     static std::ofstream log_file;
 
+    ///Writes log_file in the background; null if logging to the console, which is written directly (under log_mutex)
+    /// so that it stays in order with other console output.
+    static boost::scoped_ptr<AsyncLogSink> log_sink;
+
+    ///False if Print output is compiled out (see SIMMOB_LOG_LEVEL).
+    static const bool compiled_in = (SIMMOB_LOG_LEVEL >= SIMMOB_LOG_LEVEL_PRINT);
+
     ///A scoped lock on the log_mutex. May be null, in which case output is not locked.
     boost::mutex::scoped_lock local_lock;
+
+    ///The message being formatted, if logging to log_sink.
+    AsyncLogMessage message;
+
+    ///Where this object writes to: log_handle, the stream of the message, or null if logging is disabled.
+    std::ostream* out;
 };
 
 class PassengerInfoPrint : private StaticLogManager {
@@ -276,8 +327,8 @@ public:
     ///Hack to get manipulators (std::endl) to work.
     ///NOTE: I have *no* idea if this is extremely stupid or not. ~Seth
     PassengerInfoPrint& operator<<(StandardEndLine manip) {
-        if (log_handle) {
-            manip(*log_handle);
+        if (compiled_in && out) {
+            manip(*out);
         }
         return *this;
     }
@@ -310,8 +361,21 @@ private:
     /// closed automatically.
     static std::ofstream log_file;
 
+    ///Writes log_file in the background; null if logging to the console, which is written directly (under log_mutex)
+    /// so that it stays in order with other console output.
+    static boost::scoped_ptr<AsyncLogSink> log_sink;
+
+    ///False if PassengerInfoPrint output is compiled out (see SIMMOB_LOG_LEVEL).
+    static const bool compiled_in = (SIMMOB_LOG_LEVEL >= SIMMOB_LOG_LEVEL_PRINT);
+
     ///A scoped lock on the log_mutex. May be null, in which case output is not locked.
     boost::mutex::scoped_lock local_lock;
+
+    ///The message being formatted, if logging to log_sink.
+    AsyncLogMessage message;
+
+    ///Where this object writes to: log_handle, the stream of the message, or null if logging is disabled.
+    std::ostream* out;
 };
 
 class HeadwayAtBusStopInfoPrint : private StaticLogManager {
@@ -332,8 +396,8 @@ public:
     ///Hack to get manipulators (std::endl) to work.
     ///NOTE: I have *no* idea if this is extremely stupid or not. ~Seth
     HeadwayAtBusStopInfoPrint& operator<<(StandardEndLine manip) {
-        if (log_handle) {
-            manip(*log_handle);
+        if (compiled_in && out) {
+            manip(*out);
         }
         return *this;
     }
@@ -366,8 +430,21 @@ private:
     /// closed automatically.
     static std::ofstream log_file;
 
+    ///Writes log_file in the background; null if logging to the console, which is written directly (under log_mutex)
+    /// so that it stays in order with other console output.
+    static boost::scoped_ptr<AsyncLogSink> log_sink;
+
+    ///False if HeadwayAtBusStopInfoPrint output is compiled out (see SIMMOB_LOG_LEVEL).
+    static const bool compiled_in = (SIMMOB_LOG_LEVEL >= SIMMOB_LOG_LEVEL_PRINT);
+
     ///A scoped lock on the log_mutex. May be null, in which case output is not locked.
     boost::mutex::scoped_lock local_lock;
+
+    ///The message being formatted, if logging to log_sink.
+    AsyncLogMessage message;
+
+    ///Where this object writes to: log_handle, the stream of the message, or null if logging is disabled.
+    std::ostream* out;
 };
 
 } //End sim_mob namespace
@@ -378,19 +455,15 @@ private:
 // Macros for each StaticLogManager subclass.
 //////////////////////////////////////////////////////////////
 
-#ifdef SIMMOB_DISABLE_OUTPUT
+//Each group of macros simply destroys its text (no logging; no locking) if output is disabled, or if its
+//level is above SIMMOB_LOG_LEVEL.
 
-//Simply destroy this text; no logging; no locking
-#define WarnOut( strm )  DO_NOTHING
-#define PrintOut( strm )  DO_NOTHING
+#if defined(SIMMOB_DISABLE_OUTPUT) || SIMMOB_LOG_LEVEL < SIMMOB_LOG_LEVEL_WARN
 
-//TODO: Describe in detail later.
-#define LogOut( strm )  DO_NOTHING
+#define WarnOut( strm )  DO_NOTHING
 
 #else
 
-
-
 /**
  * Exactly the same as LogOut(), but for Warnings.
  * TODO: Describe better.
@@ -402,6 +475,16 @@ private:
     } \
     while (0)
 
+#endif
+
+#if defined(SIMMOB_DISABLE_OUTPUT) || SIMMOB_LOG_LEVEL < SIMMOB_LOG_LEVEL_PRINT
+
+#define PrintOut( strm )  DO_NOTHING
+#define PrintOutV( strm )  DO_NOTHING
+#define PrintOutF( strm )  DO_NOTHING
+
+#else
+
 /**
  * Exactly the same as LogOut(), but for Print statements.
  */
@@ -433,6 +516,13 @@ private:
     } \
     while (0)
 
+#endif
+
+#if defined(SIMMOB_DISABLE_OUTPUT) || SIMMOB_LOG_LEVEL < SIMMOB_LOG_LEVEL_ALL
+
+#define LogOut( strm )  DO_NOTHING
+
+#else
 
 /**
  * Write a message (statement_list) using "Log() <<statement_list"; Compiles to nothing if output is disabled.
@@ -447,8 +537,8 @@ private:
  *   \endcode
  *
  * \note
- * If SIMMOB_DISABLE_OUTPUT is defined, this macro will discard its arguments. Thus, it is safe to
- * call this function without #ifdef guards and let cmake handle whether or not to display output.
+ * If SIMMOB_DISABLE_OUTPUT is defined (or SIMMOB_LOG_LEVEL is below SIMMOB_LOG_LEVEL_ALL), this macro will
+ * discard its arguments. Thus, it is safe to call this function without #ifdef guards and let cmake handle whether or not to display output.
  * In some cases, it is still wise to check SIMMOB_DISABLE_OUTPUT; for example, if you are building up
  * an output std::stringstream. However, in this case you should call Log::IsEnabled().
  */
@@ -460,7 +550,7 @@ private:
     while (0)
 
 
-#endif //SIMMOB_DISABLE_OUTPUT
+#endif
 
 
 
@@ -473,8 +563,8 @@ private:
 template <typename T>
 sim_mob::Warn& sim_mob::Warn::operator<< (const T& val)
 {
-    if (log_handle) {
-        (*log_handle) <<val;
+    if (compiled_in && out) {
+        (*out) <<val;
     }
     return *this;
 }
@@ -482,8 +572,8 @@ sim_mob::Warn& sim_mob::Warn::operator<< (const T& val)
 template <typename T>
 sim_mob::Print& sim_mob::Print::operator<< (const T& val)
 {
-    if (log_handle) {
-        (*log_handle) <<val;
+    if (compiled_in && out) {
+        (*out) <<val;
     }
     return *this;
 }
@@ -491,8 +581,8 @@ sim_mob::Print& sim_mob::Print::operator<< (const T& val)
 template <typename T>
 sim_mob::PassengerInfoPrint& sim_mob::PassengerInfoPrint::operator<< (const T& val)
 {
-    if (log_handle) {
-        (*log_handle) <<val;
+    if (compiled_in && out) {
+        (*out) <<val;
     }
     return *this;
 }
@@ -500,8 +590,8 @@ sim_mob::PassengerInfoPrint& sim_mob::PassengerInfoPrint::operator<< (const T& v
 template <typename T>
 sim_mob::HeadwayAtBusStopInfoPrint& sim_mob::HeadwayAtBusStopInfoPrint::operator<< (const T& val)
 {
-    if (log_handle) {
-        (*log_handle) <<val;
+    if (compiled_in && out) {
+        (*out) <<val;
     }
     return *this;
 }
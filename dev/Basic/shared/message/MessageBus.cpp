@@ -17,6 +17,7 @@
 #include <boost/thread/tss.hpp>
 #include <boost/unordered/unordered_map.hpp>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <queue>
 #include <conf/ConfigManager.hpp>
@@ -91,17 +92,6 @@ namespace {
         triggerTime(0),type(0){
         }
 
-        MessageEntry(const MessageEntry& source) {
-            this->destination = source.destination;
-            this->message = source.message;
-            this->type = source.type;
-            this->internal = source.internal;
-            this->priority = source.priority;
-            this->event = source.event;
-            this->processOnMainThread = source.processOnMainThread;
-            this->triggerTime = source.triggerTime;
-        }
-
         MessageHandler* destination;
         MessageBus::MessagePtr message;
         Message::MessageType type;
@@ -119,6 +109,17 @@ namespace {
         }
     };
 
+    /**
+     * Orders a batch for stable sorting: higher priorities first,
+     * which is the same order in which a MessageQueue pops them.
+     */
+    struct HigherPriorityFirst {
+
+        bool operator()(const MessageEntry& t1, const MessageEntry& t2) const {
+            return (t1.priority > t2.priority);
+        }
+    };
+
     struct CompareTriggerTime {
 
         bool operator()(const MessageEntry& t1, const MessageEntry& t2) const {
@@ -130,6 +131,14 @@ namespace {
 
     typedef priority_queue<MessageEntry, std::deque<MessageEntry>, CompareTriggerTime> TimebasedMessageQueue;
 
+    typedef vector<MessageEntry> MessageBatch;
+
+    /**
+     * Outbox of a thread context in batched distribution mode.
+     * Element i holds the messages addressed to the context with index i.
+     */
+    typedef vector<MessageBatch> Outbox;
+
     /**
      * Represents a thread context.
      *
@@ -137,11 +146,17 @@ namespace {
      * @param main tells the context is associated with the main thread.
      * @param input queue for messages.
      * @param output queue for messages.
+     * @param outbox double-buffered outboxes (batched distribution only).
+     *        outbox[writeEpoch] is filled by this context's thread, while the other
+     *        one is drained by the destination threads.
+     * @param pending messages handed over to this context but not yet
+     *        dispatched when their outbox was about to be reused (batched distribution only).
      */
     struct ThreadContext {
 
         ThreadContext()
         : eventPublisher(nullptr),
+        index(0),
         input(ComparePriority()),
         output(ComparePriority()),
         futureEventList(CompareTriggerTime()),
@@ -169,9 +184,14 @@ namespace {
 
         boost::thread::id threadId;
         bool main;
+        unsigned int index;
         MessageQueue input;
         MessageQueue output;
         TimebasedMessageQueue futureEventList;
+        Outbox outbox[2];
+        MessageBatch pending;
+        //re-used buffer of ThreadDispatchMessages (batched distribution)
+        MessageBatch batch;
         //event publisher for each thread context.
         EventPublisher* eventPublisher;
         // statistics
@@ -321,6 +341,41 @@ namespace {
      */
     ThreadContext* GetThreadContext();
 
+    /**
+     * Gets the context in which the current thread registers and reaches handlers.
+     * This is the adopted context (if any) or the context of the thread itself.
+     * @return ThreadContext pointer or nullptr.
+     */
+    ThreadContext* GetHandlerContext();
+
+    /**
+     * Routes a message into the outbox of the sending context (batched distribution).
+     * Events are cloned for the event publisher of every context.
+     * @param entry message to route.
+     * @param sender context which owns the outbox.
+     * @param mainContext context of the main thread.
+     */
+    void RouteToOutbox(const MessageEntry& entry, ThreadContext* sender, ThreadContext* mainContext);
+
+    /**
+     * Hands the outboxes written during the last tick over to their destinations
+     * by flipping the write epoch (batched distribution).
+     * Must be called by the main thread while all other threads wait at a barrier.
+     */
+    void HandOverOutboxes();
+
+    /**
+     * Collects the messages handed over to the given context into context->batch,
+     * ordered by priority (batched distribution).
+     * @param context of the calling thread.
+     */
+    void CollectBatch(ThreadContext* context);
+
+    /**
+     * Counts the messages of a context which were not handed over or dispatched yet.
+     */
+    size_t CountOutstanding(ThreadContext* context);
+
     void deleteContext(ThreadContext* ctx){}
     /**
      * Deletes all contexts in the system
@@ -337,8 +392,14 @@ namespace {
      **************************************************************************/
 
     boost::thread_specific_ptr<ThreadContext> threadContext (deleteContext);
+    boost::thread_specific_ptr<ThreadContext> adoptedContext (deleteContext);
     ContextList threadContexts;
     boost::shared_mutex contextsMutex;
+
+    //selected in RegisterMainThread from the configuration
+    bool batchedDistribution = false;
+    //index of the outboxes being written in the current tick (batched distribution)
+    unsigned int writeEpoch = 0;
 }// anonymous namespace
 
 /***************************************************************************
@@ -351,7 +412,10 @@ void MessageBus::RegisterMainThread() {
         mainContext->threadId = boost::this_thread::get_id();
         mainContext->eventPublisher = new InternalEventPublisher();
         mainContext->main = true;
+        mainContext->index = threadContexts.size();
         GetInstance().context = static_cast<void*> (mainContext);
+        batchedDistribution = ConfigManager::GetInstance().FullConfig().simulation.batchedMessageDistribution;
+        writeEpoch = 0;
         threadContext.reset(mainContext);
         threadContexts.push_back(mainContext);
         RegisterHandler(dynamic_cast<MessageHandler*> (mainContext->eventPublisher));
@@ -380,6 +444,7 @@ void MessageBus::RegisterThread() {
         {// thread-safe scope
             upgrade_lock<shared_mutex> upgradeLock(contextsMutex);
             upgrade_to_unique_lock<shared_mutex> lock(upgradeLock);
+            context->index = threadContexts.size();
             threadContexts.push_back(context);
         }
         threadContext.reset(context);
@@ -405,7 +470,7 @@ void MessageBus::UnRegisterThread() {
 void MessageBus::RegisterHandler(MessageHandler* handler) {
     CheckThreadContext();
     if (handler) {
-        ThreadContext* context = GetThreadContext();
+        ThreadContext* context = GetHandlerContext();
         if (!(handler->context)) {
             handler->context = static_cast<void*> (context);
         } else if (context != handler->context) {
@@ -419,7 +484,7 @@ void MessageBus::UnRegisterHandler(MessageHandler* handler) {
     CheckThreadContext();
     if (handler && handler->context) {
         ThreadContext* context = GetThreadContext();
-        if (context == handler->context || context->main) {
+        if (context == handler->context || context->main || GetHandlerContext() == handler->context) {
             handler->context = nullptr;
         } else {
             throw runtime_error("MessageBus - To unregister the handler it is necessary to use the registered thread context.");
@@ -440,6 +505,17 @@ void MessageBus::ReRegisterHandler(MessageHandler* handler, void* newContext)
     }
 }
 
+void MessageBus::AdoptHandlerContext(void* context)
+{
+    CheckThreadContext();
+    adoptedContext.reset(static_cast<ThreadContext*> (context));
+}
+
+void* MessageBus::GetCurrentContext()
+{
+    return static_cast<void*> (GetThreadContext());
+}
+
 void MessageBus::DistributeMessages() {
     CheckMainThread();
     DispatchMessages();
@@ -493,7 +569,11 @@ void MessageBus::DispatchMessages() {
             while (!context->futureEventList.empty()) {
                 const MessageEntry& entry = context->futureEventList.top();
                 if (entry.triggerTime <= currentTime) {
-                    dispatch(entry, context, mainContext);
+                    if (batchedDistribution) {
+                        RouteToOutbox(entry, context, mainContext);
+                    } else {
+                        dispatch(entry, context, mainContext);
+                    }
                     context->futureEventList.pop();
                 } else {
                     break;
@@ -501,6 +581,9 @@ void MessageBus::DispatchMessages() {
             }
             lstItr++;
         }
+        if (batchedDistribution) {
+            HandOverOutboxes();
+        }
     }
 }
 
@@ -508,7 +591,33 @@ void MessageBus::ThreadDispatchMessages() {
     CheckThreadContext();
     //gets main collector;
     ThreadContext* context = GetThreadContext();
-    if (context) {
+    if (context && batchedDistribution) {
+        CollectBatch(context);
+        MessageBatch& batch = context->batch;
+        for (MessageBatch::iterator it = batch.begin(); it != batch.end(); it++) {
+            const MessageEntry& entry = *it;
+            if (entry.destination && entry.message.get()) {
+                ThreadContext* destinationContext = static_cast<ThreadContext*> (entry.destination->context);
+                if (!entry.processOnMainThread && destinationContext != context) {
+                    //The recepient of the message has moved to a different thread context
+                    //after the message was routed. This is possible in MT, but not in LT or ST
+                    if (!ConfigManager::GetInstance().FullConfig().RunningMidTerm()) {
+                        throw runtime_error("Thread contexts inconsistency.");
+                    }
+                    //Forward the message to the correct thread. The outbox is only
+                    //read by the other threads after the next hand-over, so the
+                    //message is handled there in the next tick.
+                    if (destinationContext) {
+                        RouteToOutbox(entry, context, static_cast<ThreadContext*> (GetInstance().context));
+                    }
+                } else {
+                    entry.destination->HandleMessage(entry.type, *(entry.message.get()));
+                }
+            }
+            context->processedMessages++;
+        }
+        batch.clear();
+    } else if (context) {
         while (!context->input.empty()) {
             const MessageEntry& entry = context->input.top();
             if (entry.destination && entry.message.get()) {
@@ -552,7 +661,14 @@ void MessageBus::PostMessage(MessageHandler* destination, Message::MessageType t
             entry.processOnMainThread = processOnMainThread;
             if (timeOffset == 0)
             {
-                context->output.push(entry);
+                if (batchedDistribution)
+                {
+                    RouteToOutbox(entry, context, static_cast<ThreadContext*> (GetInstance().context));
+                }
+                else
+                {
+                    context->output.push(entry);
+                }
             }
             else
             {
@@ -567,7 +683,12 @@ void MessageBus::SendInstantaneousMessage(MessageHandler* destination,
         Message::MessageType type, MessagePtr message) {
     CheckThreadContext();
     ThreadContext* context = GetThreadContext();
-    if (context && (destination->context==context || context->main)) {
+    if (context && destination && destination->context != context && !context->main
+            && destination->context == GetHandlerContext()) {
+        //the handler belongs to the context adopted by this (stealing) thread and may be updated by
+        //the owning thread right now, so the message is queued instead of being delivered here.
+        PostMessage(destination, type, message);
+    } else if (context && (destination->context==context || context->main)) {
         if (destination) {
             destination->HandleMessage(type, *(message.get()));
             context->receivedMessages++;
@@ -586,6 +707,8 @@ void sim_mob::messaging::MessageBus::SendMessage(MessageHandler* destination,
     ThreadContext* context = GetThreadContext();
     if (context)
     {
+        //only the thread owning the destination's context may deliver instantaneously; a thread
+        //updating entities of an adopted context queues its messages
         if (destination && destination->context == context)
         {
             SendInstantaneousMessage(destination, type, message);
@@ -713,6 +836,90 @@ namespace {
         return threadContext.get();
     }
 
+    ThreadContext* GetHandlerContext() {
+        ThreadContext* adopted = adoptedContext.get();
+        return (adopted ? adopted : threadContext.get());
+    }
+
+    void PushToOutbox(ThreadContext* sender, ThreadContext* destination, const MessageEntry& entry) {
+        Outbox& outbox = sender->outbox[writeEpoch];
+        if (outbox.size() <= destination->index) {
+            outbox.resize(destination->index + 1);
+        }
+        outbox[destination->index].push_back(entry);
+    }
+
+    void RouteToOutbox(const MessageEntry& entry, ThreadContext* sender, ThreadContext* mainContext) {
+        if (entry.event) {
+            sender->eventMessages++;
+            shared_lock<shared_mutex> lock(contextsMutex);
+            for (ContextList::iterator it = threadContexts.begin(); it != threadContexts.end(); it++) {
+                MessageEntry newEntry(entry);
+                newEntry.destination = dynamic_cast<MessageHandler*> ((*it)->eventPublisher);
+                PushToOutbox(sender, *it, newEntry);
+            }
+        } else {
+            sender->receivedMessages++;
+            if (entry.processOnMainThread) {
+                PushToOutbox(sender, mainContext, entry);
+            } else {
+                ThreadContext* destinationContext = static_cast<ThreadContext*> (entry.destination->GetContext());
+                if (destinationContext) {
+                    PushToOutbox(sender, destinationContext, entry);
+                }
+            }
+        }
+    }
+
+    void HandOverOutboxes() {
+        unsigned int readEpoch = writeEpoch ^ 1;
+        shared_lock<shared_mutex> lock(contextsMutex);
+        //Messages of the previous hand-over may not have been dispatched yet
+        //(e.g. by the workers of a group with a tick step > 1). Keep them aside,
+        //since their outboxes are written from now on.
+        for (ContextList::iterator srcItr = threadContexts.begin(); srcItr != threadContexts.end(); srcItr++) {
+            Outbox& outbox = (*srcItr)->outbox[readEpoch];
+            for (ContextList::iterator dstItr = threadContexts.begin(); dstItr != threadContexts.end(); dstItr++) {
+                ThreadContext* destination = (*dstItr);
+                if (destination->index < outbox.size() && !outbox[destination->index].empty()) {
+                    MessageBatch& bucket = outbox[destination->index];
+                    destination->pending.insert(destination->pending.end(),
+                            std::make_move_iterator(bucket.begin()), std::make_move_iterator(bucket.end()));
+                    bucket.clear();
+                }
+            }
+        }
+        writeEpoch = readEpoch;
+    }
+
+    void CollectBatch(ThreadContext* context) {
+        MessageBatch& batch = context->batch;
+        batch.swap(context->pending);
+        unsigned int readEpoch = writeEpoch ^ 1;
+        {// thread-safe scope
+            shared_lock<shared_mutex> lock(contextsMutex);
+            for (ContextList::iterator it = threadContexts.begin(); it != threadContexts.end(); it++) {
+                Outbox& outbox = (*it)->outbox[readEpoch];
+                if (context->index < outbox.size() && !outbox[context->index].empty()) {
+                    MessageBatch& bucket = outbox[context->index];
+                    batch.insert(batch.end(), std::make_move_iterator(bucket.begin()), std::make_move_iterator(bucket.end()));
+                    bucket.clear();
+                }
+            }
+        }
+        std::stable_sort(batch.begin(), batch.end(), HigherPriorityFirst());
+    }
+
+    size_t CountOutstanding(ThreadContext* context) {
+        size_t outstanding = context->input.size() + context->output.size() + context->pending.size();
+        for (unsigned int epoch = 0; epoch < 2; epoch++) {
+            for (Outbox::const_iterator it = context->outbox[epoch].begin(); it != context->outbox[epoch].end(); it++) {
+                outstanding += it->size();
+            }
+        }
+        return outstanding;
+    }
+
     void deleteAllContexts() {
         ContextList::iterator itr = threadContexts.begin();
         while (itr != threadContexts.end()) {
@@ -736,7 +943,7 @@ namespace {
         while (itr != threadContexts.end()) {
             ThreadContext* ctx = (*itr);
             if (ctx) {
-                long long int remaining = (ctx->input.size() + ctx->output.size());
+                long long int remaining = CountOutstanding(ctx);
                 boost::format fmtr = boost::format(REPORT_LINE);
                 fmtr % ctx->threadId %
                         ctx->receivedMessages %
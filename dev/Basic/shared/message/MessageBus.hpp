@@ -10,9 +10,11 @@
  */
 #pragma once
 #include "MessageHandler.hpp"
+#include "MessagePool.hpp"
 #include "event/EventListener.hpp"
 #include <boost/thread.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 
 namespace sim_mob {
 
@@ -27,6 +29,20 @@ namespace sim_mob {
          * workers still waiting in the frameTick barrier. Otherwise we cannot guarantee 
          * the thread-safety for the internal messages and main thread messages. 
          * 
+         * Two distribution modes are available (simulation/message_distribution in the config):
+         * 
+         * - centralized (default): each thread posts into its own output queue and
+         * the main thread moves every message into the input queue of its destination
+         * in DistributeMessages.
+         * 
+         * - batched: messages are routed when posted, into a per-destination outbox
+         * of the sending thread. DistributeMessages merely hands the outboxes over by
+         * flipping a double buffer, and each thread collects the batches addressed to
+         * it in ThreadDispatchMessages. Thanks to the barriers above, every outbox has
+         * a single writer and a single reader in each phase, so no locking is needed.
+         * Messages of the same priority are handled in the order of their sending
+         * thread's registration, and in posting order within a sender.
+         * 
          */
         class MessageBus : public MessageHandler {
         public:
@@ -94,6 +110,24 @@ namespace sim_mob {
              */
             static void ReRegisterHandler(MessageHandler* handler, void* newContext);
 
+            /**
+             * Lets the current thread act on behalf of another thread context while it updates
+             * entities owned by that context (see WorkStealingScheduler).
+             * Handlers registered by the current thread are placed in the adopted context.
+             * Messages sent to handlers of the adopted context are not delivered instantaneously,
+             * since the owning thread may be updating them; they are posted through the current
+             * thread's own output queue like any other message to another context.
+             * @param context the context to adopt, or nullptr to stop adopting.
+             * @throws runtime_exception if the current thread context is not registered
+             */
+            static void AdoptHandlerContext(void* context);
+
+            /**
+             * Gets the context of the calling thread.
+             * @return the context or nullptr if the thread is not registered.
+             */
+            static void* GetCurrentContext();
+
             /**
              * MessageBus distributes all messages for all registered threads.
              * Collects all messages from output queues of all thread contexts and
@@ -144,7 +178,8 @@ namespace sim_mob {
              * \note this function should be called only when the sender is aware
              * that all receivers are in the same thread context. Any attempt to
              * send a message outside the thread context will simply fail and
-             * throw a runtime error.
+             * throw a runtime error. A message to a handler of the context adopted
+             * by the sender (see AdoptHandlerContext()) is posted instead.
              *
              * @param target of the message.
              * @param type of the message.
@@ -246,6 +281,17 @@ namespace sim_mob {
              */
             static void PublishInstantaneousEvent(event::EventId id, event::Context ctx, EventArgsPtr args);
 
+            /**
+             * Creates a message in memory taken from the thread-cached MessagePool.
+             * Prefer this over MessagePtr(new ...) for messages sent at high rates.
+             * @param args arguments of the message constructor.
+             * @return the new message.
+             */
+            template<typename T, typename... Args>
+            static MessagePtr MakeMessage(Args&&... args) {
+                return boost::allocate_shared<T>(PooledAllocator<T>(), std::forward<Args>(args)...);
+            }
+
         public:
             static const unsigned int MB_MIN_MSG_PRIORITY;
             static const unsigned int MB_MSG_START;
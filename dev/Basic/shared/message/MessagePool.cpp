@@ -0,0 +1,107 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "MessagePool.hpp"
+
+#include <new>
+#include <boost/thread/tss.hpp>
+
+using namespace sim_mob::messaging;
+
+const std::size_t MessagePool::BLOCK_GRANULARITY;
+const std::size_t MessagePool::MAX_POOLED_SIZE;
+const std::size_t MessagePool::MAX_CACHED_BLOCKS;
+
+namespace {
+    const std::size_t NUM_SIZE_CLASSES = MessagePool::MAX_POOLED_SIZE / MessagePool::BLOCK_GRANULARITY;
+
+    /**
+     * Header overlaid on a free block.
+     */
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    /**
+     * Free lists of one thread, one per size class.
+     */
+    struct FreeLists {
+
+        FreeLists() {
+            for (std::size_t i = 0; i < NUM_SIZE_CLASSES; i++) {
+                heads[i] = nullptr;
+                counts[i] = 0;
+            }
+        }
+
+        ~FreeLists() {
+            for (std::size_t i = 0; i < NUM_SIZE_CLASSES; i++) {
+                while (heads[i]) {
+                    FreeBlock* block = heads[i];
+                    heads[i] = block->next;
+                    ::operator delete(block);
+                }
+            }
+        }
+
+        FreeBlock* heads[NUM_SIZE_CLASSES];
+        std::size_t counts[NUM_SIZE_CLASSES];
+    };
+
+    boost::thread_specific_ptr<FreeLists> freeLists;
+
+    FreeLists& GetFreeLists() {
+        FreeLists* lists = freeLists.get();
+        if (!lists) {
+            lists = new FreeLists();
+            freeLists.reset(lists);
+        }
+        return *lists;
+    }
+
+    /**
+     * Gets the size class of a request; only valid for 0 < size <= MAX_POOLED_SIZE.
+     */
+    inline std::size_t GetSizeClass(std::size_t size) {
+        return (size - 1) / MessagePool::BLOCK_GRANULARITY;
+    }
+}
+
+void* MessagePool::Allocate(std::size_t size) {
+    if (size == 0 || size > MAX_POOLED_SIZE) {
+        return ::operator new(size);
+    }
+
+    std::size_t sizeClass = GetSizeClass(size);
+    FreeLists& lists = GetFreeLists();
+    FreeBlock* block = lists.heads[sizeClass];
+    if (block) {
+        lists.heads[sizeClass] = block->next;
+        lists.counts[sizeClass]--;
+        return block;
+    }
+    //all blocks of a class have the same size, so that any of them can serve any request of the class.
+    return ::operator new((sizeClass + 1) * BLOCK_GRANULARITY);
+}
+
+void MessagePool::Deallocate(void* block, std::size_t size) {
+    if (!block) {
+        return;
+    }
+    if (size == 0 || size > MAX_POOLED_SIZE) {
+        ::operator delete(block);
+        return;
+    }
+
+    std::size_t sizeClass = GetSizeClass(size);
+    FreeLists& lists = GetFreeLists();
+    if (lists.counts[sizeClass] >= MAX_CACHED_BLOCKS) {
+        ::operator delete(block);
+        return;
+    }
+    FreeBlock* freeBlock = static_cast<FreeBlock*> (block);
+    freeBlock->next = lists.heads[sizeClass];
+    lists.heads[sizeClass] = freeBlock;
+    lists.counts[sizeClass]++;
+}
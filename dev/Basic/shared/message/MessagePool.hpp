@@ -0,0 +1,80 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+
+namespace sim_mob {
+
+    namespace messaging {
+
+        /**
+         * Thread-cached memory pool for short-lived message objects.
+         *
+         * Blocks are grouped in size classes of BLOCK_GRANULARITY bytes, up to MAX_POOLED_SIZE bytes.
+         * Each thread keeps its own free list per size class, so neither allocation nor de-allocation
+         * needs any synchronisation. A block released by a thread other than the one that allocated it
+         * simply joins the free list of the releasing thread; since messages typically flow in all
+         * directions between workers, the free lists stay balanced.
+         * Requests larger than MAX_POOLED_SIZE, and releases beyond MAX_CACHED_BLOCKS per size class,
+         * fall back to the global operator new/delete.
+         */
+        class MessagePool {
+        public:
+            /**
+             * Allocates a block of at least the given size.
+             * @param size of the block in bytes.
+             * @return pointer to the block.
+             */
+            static void* Allocate(std::size_t size);
+
+            /**
+             * Releases a block obtained from Allocate().
+             * @param block to release.
+             * @param size the size requested when the block was allocated.
+             */
+            static void Deallocate(void* block, std::size_t size);
+
+            static const std::size_t BLOCK_GRANULARITY = 16;
+            static const std::size_t MAX_POOLED_SIZE = 512;
+            static const std::size_t MAX_CACHED_BLOCKS = 4096;
+        };
+
+        /**
+         * Standard allocator backed by the MessagePool.
+         * Used by MessageBus::MakeMessage() to place messages (and their shared_ptr control block) in pooled memory.
+         */
+        template<typename T>
+        class PooledAllocator {
+        public:
+            typedef T value_type;
+
+            PooledAllocator() {
+            }
+
+            template<typename U>
+            PooledAllocator(const PooledAllocator<U>&) {
+            }
+
+            T* allocate(std::size_t n) {
+                return static_cast<T*> (MessagePool::Allocate(n * sizeof (T)));
+            }
+
+            void deallocate(T* p, std::size_t n) {
+                MessagePool::Deallocate(p, n * sizeof (T));
+            }
+
+            template<typename U>
+            bool operator==(const PooledAllocator<U>&) const {
+                return true;
+            }
+
+            template<typename U>
+            bool operator!=(const PooledAllocator<U>&) const {
+                return false;
+            }
+        };
+    }
+}
@@ -194,6 +194,61 @@ void sim_mob::ParsePathXmlConfig::processPrivatePathsetNode(xercesc::DOMElement*
         cfg.reroute = ParseBoolean(GetNamedAttributeValue(reroute, "enabled"), false);
     }
 
+    //pathset cache (one per thread; capacity_mb is the budget of each)
+    xercesc::DOMElement* cache = GetSingleElementByName(pvtConfNode, "pathset_cache");
+
+    if (cache)
+    {
+        cfg.cacheEnabled = ParseBoolean(GetNamedAttributeValue(cache, "enabled"), false);
+        int capacityMB = ParseInteger(GetNamedAttributeValue(cache, "capacity_mb", false), 128);
+
+        if (capacityMB <= 0)
+        {
+            stringstream msg;
+            msg << "Invalid value for <pathset_cache capacity_mb=\"" << capacityMB << "\">. Expected: value greater than 0";
+            throw runtime_error(msg.str());
+        }
+        cfg.cacheCapacity = (size_t) capacityMB * 1024 * 1024;
+    }
+
+    //path-set store
+    xercesc::DOMElement* store = GetSingleElementByName(pvtConfNode, "pathset_store");
+
+    if (store)
+    {
+        cfg.storeFile = ParseString(GetNamedAttributeValue(store, "file", true), "");
+        cfg.storeSource = ParseString(GetNamedAttributeValue(store, "source", false), "");
+        cfg.storeSourceVersion = ParseString(GetNamedAttributeValue(store, "source_version", false), "");
+    }
+
+    //route choice model evaluation
+    xercesc::DOMElement* routeChoice = GetSingleElementByName(pvtConfNode, "route_choice");
+
+    if (routeChoice)
+    {
+        std::string evaluation = ParseString(GetNamedAttributeValue(routeChoice, "evaluation"), "lua");
+
+        if (evaluation == "lua")
+        {
+            cfg.routeChoiceEvaluation = PathSetConf::ROUTE_CHOICE_LUA;
+        }
+        else if (evaluation == "native")
+        {
+            cfg.routeChoiceEvaluation = PathSetConf::ROUTE_CHOICE_NATIVE;
+        }
+        else if (evaluation == "validate")
+        {
+            cfg.routeChoiceEvaluation = PathSetConf::ROUTE_CHOICE_VALIDATE;
+        }
+        else
+        {
+            stringstream msg;
+            msg << "Invalid value for <route_choice evaluation=\"" << evaluation
+                << "\">. Expected: \"lua\", \"native\" or \"validate\"";
+            throw runtime_error(msg.str());
+        }
+    }
+
     //path generators configuration
     xercesc::DOMElement* gen = GetSingleElementByName(pvtConfNode, "path_generators");
 
@@ -164,6 +164,19 @@ sim_mob::PathSet::~PathSet()
     }
 }
 
+size_t sim_mob::PathSet::getMemoryFootprint() const
+{
+    //a node of the path choices set holds the element and about three pointers
+    const size_t setNodeSize = sizeof(sim_mob::SinglePath*) + 3 * sizeof(void*);
+    size_t bytes = sizeof(PathSet) + id.capacity() + scenario.capacity();
+    BOOST_FOREACH(const sim_mob::SinglePath* sp, pathChoices)
+    {
+        bytes += setNodeSize + sizeof(sim_mob::SinglePath) + sp->path.capacity() * sizeof(sim_mob::WayPoint)
+                + sp->id.capacity() + sp->pathSetId.capacity() + sp->scenario.capacity();
+    }
+    return bytes;
+}
+
 short sim_mob::PathSet::addOrDeleteSinglePath(sim_mob::SinglePath* s)
 {
     if(s->id.empty()) { return 0; }
@@ -191,6 +191,13 @@ public:
     ~PathSet();
 
     short addOrDeleteSinglePath(sim_mob::SinglePath* s);
+
+    /**
+     * Estimates the memory held by the pathset and its paths; used to budget the pathset cache
+     * @return approximate size in bytes
+     */
+    size_t getMemoryFootprint() const;
+
     std::vector<WayPoint>* bestPath;  //best choice
     SinglePath* oriPath;  // shortest path with all segments
     std::set<sim_mob::SinglePath*, sim_mob::SinglePath> pathChoices;
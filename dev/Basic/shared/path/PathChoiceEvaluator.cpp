@@ -0,0 +1,174 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "PathChoiceEvaluator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "path/Path.hpp"
+
+using namespace sim_mob;
+
+namespace
+{
+/** constants of the random number generator of the logit script */
+const double RANDOM_A1 = 1331;
+const double RANDOM_A2 = 798405;
+const double RANDOM_D20 = 1048576;
+const double RANDOM_D40 = 1099511627776;
+}
+
+RouteChoiceCoefficients::RouteChoiceCoefficients() :
+        travelTime(0), travelCost(0), commonFactor(0), length(0), highwayDistance(0), highwayBias(0), signalNumber(0),
+        rightTurnNumber(0), minDistance(0), minSignal(0), maxHighwayUsage(0), work(0), leisure(0)
+{
+}
+
+void PathChoiceAttributes::clear()
+{
+    travelTime.clear();
+    travelCost.clear();
+    partialUtility.clear();
+    pathSize.clear();
+    length.clear();
+    highwayDistance.clear();
+    signalNumber.clear();
+    rightTurnNumber.clear();
+    isMinDistance.clear();
+    isMinSignal.clear();
+    isMaxHighwayUsage.clear();
+    isWork.clear();
+    leisure.clear();
+}
+
+void PathChoiceAttributes::addPath(const SinglePath& path)
+{
+    travelTime.push_back(path.getTravelTime());
+    travelCost.push_back(path.getTravelCost());
+    partialUtility.push_back(path.getPartialUtility());
+    pathSize.push_back(path.getPathSize());
+    length.push_back(path.getLength());
+    highwayDistance.push_back(path.getHighWayDistance());
+    signalNumber.push_back(path.getSignalNumber());
+    rightTurnNumber.push_back(path.getRightTurnNumber());
+    isMinDistance.push_back(path.isMinDistance() ? 1 : 0);
+    isMinSignal.push_back(path.isMinSignal() ? 1 : 0);
+    isMaxHighwayUsage.push_back(path.isMaxHighWayUsage() ? 1 : 0);
+    isWork.push_back(path.getPurpose() == sim_mob::work ? 1 : 0);
+    leisure.push_back(path.getPurpose() == sim_mob::leisure ? 2 : 0);
+}
+
+PathChoiceEvaluator::PathChoiceEvaluator() : randomX1(0), randomX2(1)
+{
+}
+
+void PathChoiceEvaluator::setCoefficients(const RouteChoiceCoefficients& coefficients)
+{
+    this->coefficients = coefficients;
+}
+
+void PathChoiceEvaluator::computeUtilities(const PathChoiceAttributes& attributes, std::vector<double>& utilities) const
+{
+    const std::size_t numPaths = attributes.size();
+    utilities.resize(numPaths);
+
+    const RouteChoiceCoefficients& beta = coefficients;
+    const double* partialUtility = attributes.partialUtility.data();
+    const double* pathSize = attributes.pathSize.data();
+    const double* length = attributes.length.data();
+    const double* highwayDistance = attributes.highwayDistance.data();
+    const double* signalNumber = attributes.signalNumber.data();
+    const double* rightTurnNumber = attributes.rightTurnNumber.data();
+    const double* isMinDistance = attributes.isMinDistance.data();
+    const double* isMinSignal = attributes.isMinSignal.data();
+    const double* isMaxHighwayUsage = attributes.isMaxHighwayUsage.data();
+    const double* isWork = attributes.isWork.data();
+    const double* leisure = attributes.leisure.data();
+    const double* travelTime = attributes.travelTime.data();
+    const double* travelCost = attributes.travelCost.data();
+    double* utility = utilities.data();
+
+    //The terms are added in the order of the script, so that the results are identical
+    for (std::size_t i = 0; i < numPaths; ++i)
+    {
+        double pUtility = pathSize[i] * beta.commonFactor;
+        pUtility = pUtility + length[i] * beta.length;
+        pUtility = pUtility + highwayDistance[i] * beta.highwayDistance;
+        pUtility = pUtility + (highwayDistance[i] > 0 ? beta.highwayBias : 0);
+        pUtility = pUtility + signalNumber[i] * beta.signalNumber;
+        pUtility = pUtility + rightTurnNumber[i] * beta.rightTurnNumber;
+        pUtility = pUtility + isMinDistance[i] * beta.minDistance;
+        pUtility = pUtility + isMinSignal[i] * beta.minSignal;
+        pUtility = pUtility + isMaxHighwayUsage[i] * beta.maxHighwayUsage;
+        pUtility = pUtility + isWork[i] * beta.work;
+        pUtility = pUtility + leisure[i] * beta.leisure;
+
+        //partial utilities pre-computed for the path take precedence
+        pUtility = (partialUtility[i] > 0) ? partialUtility[i] : pUtility;
+
+        utility[i] = pUtility + travelTime[i] * beta.travelTime;
+        utility[i] = utility[i] + travelCost[i] * beta.travelCost;
+    }
+}
+
+void PathChoiceEvaluator::computeProbabilities(const std::vector<double>& utilities, std::vector<double>& probabilities)
+{
+    const std::size_t numPaths = utilities.size();
+    probabilities.resize(numPaths);
+
+    double evSum = 0;
+    for (std::size_t i = 0; i < numPaths; ++i)
+    {
+        probabilities[i] = std::isnan(utilities[i]) ? 0 : std::exp(utilities[i]);
+        evSum = evSum + probabilities[i];
+    }
+    for (std::size_t i = 0; i < numPaths; ++i)
+    {
+        if (probabilities[i] != 0)
+        {
+            probabilities[i] = probabilities[i] / evSum;
+        }
+    }
+}
+
+std::size_t PathChoiceEvaluator::chooseAlternative(const std::vector<double>& probabilities, double draw)
+{
+    if (probabilities.empty())
+    {
+        throw std::runtime_error("PathChoiceEvaluator: no alternative to choose from");
+    }
+
+    double cumulative = 0;
+    for (std::size_t i = 0; i < probabilities.size(); ++i)
+    {
+        if (!std::isnan(probabilities[i]))
+        {
+            cumulative = cumulative + probabilities[i];
+        }
+        if (cumulative > draw)
+        {
+            return i;
+        }
+    }
+    return probabilities.size() - 1;
+}
+
+std::size_t PathChoiceEvaluator::choosePath(const PathChoiceAttributes& attributes)
+{
+    computeUtilities(attributes, utilities);
+    computeProbabilities(utilities, probabilities);
+    return chooseAlternative(probabilities, nextRandom());
+}
+
+double PathChoiceEvaluator::nextRandom()
+{
+    //The values stay below 2^53, so that the arithmetic is exact, as in the script
+    const double u = randomX2 * RANDOM_A2;
+    double v = std::fmod(randomX1 * RANDOM_A2 + randomX2 * RANDOM_A1, RANDOM_D20);
+    v = std::fmod(v * RANDOM_D20 + u, RANDOM_D40);
+    randomX1 = std::floor(v / RANDOM_D20);
+    randomX2 = v - randomX1 * RANDOM_D20;
+    return v / RANDOM_D40;
+}
@@ -0,0 +1,137 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace sim_mob
+{
+
+class SinglePath;
+
+/**
+ * Coefficients of the private traffic route choice model (the betas of the pvtrc script)
+ */
+struct RouteChoiceCoefficients
+{
+    RouteChoiceCoefficients();
+
+    double travelTime;
+    double travelCost;
+    double commonFactor;
+    double length;
+    double highwayDistance;
+    double highwayBias;
+    double signalNumber;
+    double rightTurnNumber;
+    double minDistance;
+    double minSignal;
+    double maxHighwayUsage;
+    double work;
+    double leisure;
+};
+
+/**
+ * Attributes of the alternatives of a route choice, one array per attribute.
+ * The flags are held as 0 or 1, so that the utilities are computed without branching on them.
+ */
+struct PathChoiceAttributes
+{
+    void clear();
+
+    void addPath(const SinglePath& path);
+
+    std::size_t size() const
+    {
+        return travelTime.size();
+    }
+
+    std::vector<double> travelTime;
+    std::vector<double> travelCost;
+    std::vector<double> partialUtility;
+    std::vector<double> pathSize;
+    std::vector<double> length;
+    std::vector<double> highwayDistance;
+    std::vector<double> signalNumber;
+    std::vector<double> rightTurnNumber;
+    std::vector<double> isMinDistance;
+    std::vector<double> isMinSignal;
+    std::vector<double> isMaxHighwayUsage;
+
+    /** 1 for work trips, 0 otherwise */
+    std::vector<double> isWork;
+
+    /** 2 for leisure trips (the purpose is multiplied by its coefficient), 0 otherwise */
+    std::vector<double> leisure;
+};
+
+/**
+ * Evaluates the multinomial logit private traffic route choice model in C++.
+ *
+ * This is the model of the choose_PVT_path function of the pvtrc script, with the probabilities and the final choice
+ * of the logit script: the utilities are computed in the same order of operations and the draws are taken from the
+ * same generator, so that a thread makes the same choices with either implementation.
+ */
+class PathChoiceEvaluator
+{
+public:
+    PathChoiceEvaluator();
+
+    void setCoefficients(const RouteChoiceCoefficients& coefficients);
+
+    const RouteChoiceCoefficients& getCoefficients() const
+    {
+        return coefficients;
+    }
+
+    /**
+     * Computes the utilities of all alternatives
+     * @param attributes the attributes of the alternatives
+     * @param utilities output utility of each alternative
+     */
+    void computeUtilities(const PathChoiceAttributes& attributes, std::vector<double>& utilities) const;
+
+    /**
+     * Computes the choice probabilities of alternatives; alternatives whose utility is not a number are unavailable
+     * @param utilities the utilities of the alternatives
+     * @param probabilities output probability of each alternative
+     */
+    static void computeProbabilities(const std::vector<double>& utilities, std::vector<double>& probabilities);
+
+    /**
+     * Chooses an alternative
+     * @param probabilities the probabilities of the alternatives
+     * @param draw uniform random number in [0, 1)
+     * @return the index of the alternative whose cumulative probability first exceeds the draw (the last one if none does)
+     */
+    static std::size_t chooseAlternative(const std::vector<double>& probabilities, double draw);
+
+    /**
+     * Chooses a path, drawing the next random number
+     * @param attributes the attributes of the alternatives (at least one)
+     * @return the index of the chosen alternative
+     */
+    std::size_t choosePath(const PathChoiceAttributes& attributes);
+
+    /**
+     * Draws the next number of the generator of the logit script
+     * @return uniform random number in [0, 1)
+     */
+    double nextRandom();
+
+private:
+    RouteChoiceCoefficients coefficients;
+
+    /** state of the random number generator */
+    double randomX1;
+    double randomX2;
+
+    /** reused between choices */
+    std::vector<double> utilities;
+    std::vector<double> probabilities;
+};
+
+}
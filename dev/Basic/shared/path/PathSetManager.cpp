@@ -7,6 +7,7 @@
 #include <boost/foreach.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/mem_fn.hpp>
 #include <boost/regex.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
@@ -82,6 +83,7 @@ void ensureContext()
             modelCtx->pvtRouteChoiceModel->loadFile(scriptsPath + extScripts.getScriptFileName("logit"));
             modelCtx->pvtRouteChoiceModel->loadFile(scriptsPath + extScripts.getScriptFileName("pvtrc"));
             modelCtx->pvtRouteChoiceModel->initialize();
+            modelCtx->pvtRouteChoiceModel->loadRouteChoiceCoefficients();
             threadContext.reset(modelCtx);
         }
         catch (const std::runtime_error& ex)
@@ -273,6 +275,11 @@ public:
 
 double getPathTravelCost(sim_mob::SinglePath *sp, const sim_mob::DailyTime & startTime_, bool useInSimulationTT = false)
 {
+    const std::shared_ptr<const TravelTimeTable> ttTable = sim_mob::TravelTimeManager::getInstance()->getTravelTimeTable();
+    if (!ttTable)
+    {
+        throw std::runtime_error("travel times are not loaded");
+    }
     sim_mob::DailyTime tripStartTime(startTime_);
     double res = 0.0;
     for (std::vector<WayPoint>::iterator pathIt = sp->path.begin(); pathIt != sp->path.end(); pathIt++)
@@ -286,7 +293,7 @@ double getPathTravelCost(sim_mob::SinglePath *sp, const sim_mob::DailyTime & sta
         }
 
         //get travel time for this link
-        double lnkTT = sim_mob::TravelTimeManager::getInstance()->getLinkTT((pathIt)->link, tripStartTime, nextLink, useInSimulationTT);
+        double lnkTT = ttTable->getLinkTT((pathIt)->link, tripStartTime, nextLink, useInSimulationTT);
         tripStartTime = tripStartTime + sim_mob::DailyTime(lnkTT * 1000);
 
         std::map<int, sim_mob::ERP_Section*>::iterator erpSectionIt = sim_mob::PathSetParam::getInstance()->ERP_SectionPool.find(lnkId);
@@ -366,17 +373,56 @@ void sim_mob::PathSetManager::clearPathSet(boost::shared_ptr<sim_mob::PathSet>&
     ps->pathChoices.clear();
 }
 
-void sim_mob::PrivateTrafficRouteChoice::cachePathSet(boost::shared_ptr<sim_mob::PathSet>& ps)
+void sim_mob::PrivateTrafficRouteChoice::cachePathSet(const std::string& key, boost::shared_ptr<sim_mob::PathSet>& ps)
 {
-    return;
-    cacheLRU.insert(ps->id, ps);
+    if (!ConfigManager::GetInstance().PathSetConfig().cacheEnabled)
+    {
+        return;
+    }
+    cacheLRU.insert(key, ps);
 }
 
-bool sim_mob::PrivateTrafficRouteChoice::findCachedPathSet(std::string key, boost::shared_ptr<sim_mob::PathSet> &value)
+bool sim_mob::PrivateTrafficRouteChoice::findCachedPathSet(const std::string& key, boost::shared_ptr<sim_mob::PathSet> &value)
 {
     return cacheLRU.find(key, value);
 }
 
+std::string sim_mob::PrivateTrafficRouteChoice::getPathSetCacheKey(const std::string& fromToID, const std::string& retrieval,
+        const std::set<const sim_mob::Link*>& blackListedLinks, const sim_mob::Link* lastLink) const
+{
+    std::stringstream key;
+    key << fromToID << "|" << retrieval << "|";
+    if (lastLink)
+    {
+        key << lastLink->getLinkId();
+    }
+
+    //the links are ordered by address; their ids are sorted so that the key does not depend on the allocation
+    std::vector<unsigned int> blackListedIds;
+    blackListedIds.reserve(blackListedLinks.size());
+    for (const sim_mob::Link* link : blackListedLinks)
+    {
+        blackListedIds.push_back(link->getLinkId());
+    }
+    std::sort(blackListedIds.begin(), blackListedIds.end());
+    for (unsigned int id : blackListedIds)
+    {
+        key << "|" << id;
+    }
+    return key.str();
+}
+
+const std::string& sim_mob::PrivateTrafficRouteChoice::getStudyAreaRetrieval() const
+{
+    const std::map<std::string, std::string>& procedures = ConfigManager::GetInstance().FullConfig().getDatabaseProcMappings().procedureMappings;
+    std::map<std::string, std::string>::const_iterator it = procedures.find("studyArea_pvt_pathset");
+    if (it == procedures.end())
+    {
+        throw std::runtime_error("Study Area Pathset Procedure Not present in configuration file");
+    }
+    return it->second;
+}
+
 void sim_mob::PrivatePathsetGenerator::setPathSetTags(boost::shared_ptr<sim_mob::PathSet>& ps) const
 {
     double minDistance = std::numeric_limits<double>::max();
@@ -636,7 +682,7 @@ double sim_mob::PrivateTrafficRouteChoice::getOD_TravelTime(unsigned int origin,
 
     sim_mob::SinglePath* shortestPath = nullptr;
     boost::shared_ptr<sim_mob::PathSet> pathset;
-    bool pathsetFound = findCachedPathSet(fromToID, pathset);
+    bool pathsetFound = findCachedPathSet(getPathSetCacheKey(fromToID, psRetrieval), pathset);
     if(pathsetFound)
     {
         shortestPath = pathset->oriPath;
@@ -686,9 +732,15 @@ double sim_mob::PrivateTrafficRouteChoice::getOD_TravelTime_StudyArea(unsigned i
     std::string fromToID = getFromToString(origin, destination);
     if (noPathODs.find(fromToID)) { return 0.0; }
 
+    if(!rdnw->IsMovementInStudyArea(origin,destination))
+    {
+        throw std::runtime_error("Both origin/destination should be in study Area for OD_StudyArea travelTime Estimation");
+    }
+    const std::string& psRetrievalForStudyArea = getStudyAreaRetrieval();
+
     sim_mob::SinglePath* shortestPath = nullptr;
     boost::shared_ptr<sim_mob::PathSet> pathset;
-    bool pathsetFound = findCachedPathSet(fromToID, pathset);
+    bool pathsetFound = findCachedPathSet(getPathSetCacheKey(fromToID, psRetrievalForStudyArea), pathset);
     if(pathsetFound)
     {
         shortestPath = pathset->oriPath;
@@ -699,24 +751,7 @@ double sim_mob::PrivateTrafficRouteChoice::getOD_TravelTime_StudyArea(unsigned i
         sim_mob::PathSet* tmpPathset = new sim_mob::PathSet();
         pathset.reset(tmpPathset);
         pathset->id = fromToID;
-        if(rdnw->IsMovementInStudyArea(origin,destination))
-        {
-
-            int count = config.getDatabaseProcMappings().procedureMappings.count("studyArea_pvt_pathset");
-            if(count)
-            {
-                std::string psRetrievalForStudyArea = config.getDatabaseProcMappings().procedureMappings.find("studyArea_pvt_pathset")->second;
-                pathsetRetrievalStatus = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, psRetrievalForStudyArea);
-            }
-            else
-            {
-                throw std::runtime_error("Study Area Pathset Procedure Not present in configuration file");
-            }
-        }
-        else
-        {
-            throw std::runtime_error("Both origin/destination should be in study Area for OD_StudyArea travelTime Estimation");
-        }
+        pathsetRetrievalStatus = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, psRetrievalForStudyArea);
         if(pathsetRetrievalStatus == PSM_HASPATH)
         {
             for (sim_mob::SinglePath* sp : pathset->pathChoices)
@@ -756,7 +791,7 @@ double sim_mob::PrivateTrafficRouteChoice::getShortestPathTravelTime(const Node*
 
     sim_mob::SinglePath* shortestPath = nullptr;
     boost::shared_ptr<sim_mob::PathSet> pathset;
-    bool pathsetFound = findCachedPathSet(fromToID, pathset);
+    bool pathsetFound = findCachedPathSet(getPathSetCacheKey(fromToID, psRetrieval), pathset);
     if(pathsetFound)
     {
         shortestPath = pathset->oriPath;
@@ -822,13 +857,18 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPath(std::vector<sim_mob::WayPoi
 
     boost::shared_ptr<sim_mob::PathSet> pathset;
 
+    //the loaded pathset depends on the retrieval procedure and the black list, so all of them
+    //are part of its cache key
+    const std::string& retrieval = (nonCBD_OD ? psRetrievalWithoutRestrictedRegion : psRetrieval);
+    const std::string cacheKey = getPathSetCacheKey(fromToID, retrieval, blackListedLinks);
+
     //Step-1 Check Cache
     /*
      * supply only the temporary blacklist, because with the current implementation,
      * cache should never be filled with paths containing permanent black listed segments
      */
     std::set<const sim_mob::Link*> emptyBlkLst = std::set<const sim_mob::Link*>(); //sometimes you don't need a black list at all!
-    if (useCache && findCachedPathSet(fromToID, pathset))
+    if (useCache && findCachedPathSet(cacheKey, pathset))
     {
         pathset->subTrip = st; //at least for the travel start time, subtrip is needed
         onPathSetRetrieval(pathset, enRoute, useInSimulationTT);
@@ -848,14 +888,7 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPath(std::vector<sim_mob::WayPoi
     pathset->id = fromToID;
     pathset->scenario = scenarioName;
     pathset->nonCDB_OD = nonCBD_OD;
-    if (nonCBD_OD)
-    {
-        hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, psRetrievalWithoutRestrictedRegion, blackListedLinks);
-    }
-    else
-    {
-        hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, psRetrieval, blackListedLinks);
-    }
+    hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, retrieval, blackListedLinks);
     switch (hasPath)
     {
     case PSM_HASPATH:
@@ -878,7 +911,7 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPath(std::vector<sim_mob::WayPoi
             //cache
             if (useCache)
             {
-                cachePathSet(pathset);
+                cachePathSet(cacheKey, pathset);
             }
             return true;
         }
@@ -922,13 +955,26 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPath(std::vector<sim_mob::WayPoi
 
     boost::shared_ptr<sim_mob::PathSet> pathset;
 
+    if (!nonCBD_OD && !(driverControllerStudyAreaEnabled && rdnw->IsMovementInStudyArea(fromNode->getNodeId(), toNode->getNodeId())))
+    {
+        std::stringstream msg;
+        msg << "driver Controller is restricted to study area but schedule for outside Area: from node "<< fromNode->getNodeId()<< fromNode->printIfNodeIsInStudyArea()<<
+                "To Node "<<toNode->getNodeId()<<toNode->printIfNodeIsInStudyArea();
+        throw std::runtime_error(msg.str());
+    }
+
+    //the loaded pathset depends on the retrieval procedure and the black list, so all of them
+    //are part of its cache key
+    const std::string& retrieval = (nonCBD_OD ? psRetrievalWithoutRestrictedRegion : getStudyAreaRetrieval());
+    const std::string cacheKey = getPathSetCacheKey(fromToID, retrieval, blackListedLinks);
+
     //Step-1 Check Cache
     /*
      * supply only the temporary blacklist, because with the current implementation,
      * cache should never be filled with paths containing permanent black listed segments
      */
     std::set<const sim_mob::Link*> emptyBlkLst = std::set<const sim_mob::Link*>(); //sometimes you don't need a black list at all!
-    if (useCache && findCachedPathSet(fromToID, pathset))
+    if (useCache && findCachedPathSet(cacheKey, pathset))
     {
         pathset->subTrip = st; //at least for the travel start time, subtrip is needed
         onPathSetRetrieval(pathset, enRoute, useInSimulationTT);
@@ -948,33 +994,7 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPath(std::vector<sim_mob::WayPoi
     pathset->id = fromToID;
     pathset->scenario = scenarioName;
     pathset->nonCDB_OD = nonCBD_OD;
-    if (nonCBD_OD)
-    {
-        hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, psRetrievalWithoutRestrictedRegion, blackListedLinks);
-    }
-    else
-    {
-        if(driverControllerStudyAreaEnabled && rdnw->IsMovementInStudyArea(fromNode->getNodeId(), toNode->getNodeId()))
-        {
-            int count = config.getDatabaseProcMappings().procedureMappings.count("studyArea_pvt_pathset");
-            if(count)
-            {
-                std::string psRetrievalForStudyArea = config.getDatabaseProcMappings().procedureMappings.find("studyArea_pvt_pathset")->second;
-                hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, psRetrievalForStudyArea, blackListedLinks);
-            }
-            else
-            {
-                throw std::runtime_error("Study Area Pathset Procedure Not present in configuration file");
-            }
-        }
-        else
-        {
-            std::stringstream msg;
-            msg << "driver Controller is restricted to study area but schedule for outside Area: from node "<< fromNode->getNodeId()<< fromNode->printIfNodeIsInStudyArea()<<
-                    "To Node "<<toNode->getNodeId()<<toNode->printIfNodeIsInStudyArea();
-            throw std::runtime_error(msg.str());
-        }
-    }
+    hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, retrieval, blackListedLinks);
     switch (hasPath)
     {
         case PSM_HASPATH:
@@ -997,7 +1017,7 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPath(std::vector<sim_mob::WayPoi
                 //cache
                 if (useCache)
                 {
-                    cachePathSet(pathset);
+                    cachePathSet(cacheKey, pathset);
                 }
                 return true;
             }
@@ -1067,13 +1087,18 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPathToLink(std::vector<sim_mob::
 
     //boost::shared_ptr<sim_mob::PathSet> pathset;
 
+    //the loaded pathset depends on the retrieval procedure and the black list (and is filtered by the last link), so all of
+    //them are part of its cache key
+    const std::string& retrieval = (nonCBD_OD ? psRetrievalWithoutRestrictedRegion : psRetrieval);
+    const std::string cacheKey = getPathSetCacheKey(fromToID, retrieval, blackListedLinks, last);
+
     //Step-1 Check Cache
     /*
      * supply only the temporary blacklist, because with the current implementation,
      * cache should never be filled with paths containing permanent black listed segments
      */
     std::set<const sim_mob::Link*> emptyBlkLst = std::set<const sim_mob::Link*>(); //sometimes you don't need a black list at all!
-    if (useCache && findCachedPathSet(fromToID, pathset))
+    if (useCache && findCachedPathSet(cacheKey, pathset))
     {
         pathset->subTrip = st; //at least for the travel start time, subtrip is needed
         onPathSetRetrieval(pathset, enRoute, useInSimulationTT);
@@ -1094,14 +1119,7 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPathToLink(std::vector<sim_mob::
     pathset->id = fromToID;
     pathset->scenario = scenarioName;
     pathset->nonCDB_OD = nonCBD_OD;
-    if (nonCBD_OD)
-    {
-        hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, psRetrievalWithoutRestrictedRegion, blackListedLinks);
-    }
-    else
-    {
-        hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, psRetrieval, blackListedLinks);
-    }
+    hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, retrieval, blackListedLinks);
     switch (hasPath)
     {
     case PSM_HASPATH:
@@ -1125,7 +1143,7 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPathToLink(std::vector<sim_mob::
             //cache
             if (useCache)
             {
-                cachePathSet(pathset);
+                cachePathSet(cacheKey, pathset);
             }
             return true;
         }
@@ -1177,13 +1195,23 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPathToLink(std::vector<sim_mob::
 
     //boost::shared_ptr<sim_mob::PathSet> pathset;
 
+    if (!nonCBD_OD && !(driverControllerStudyAreaEnabled && rdnw->IsMovementInStudyArea(fromNode->getNodeId(), toNode->getNodeId())))
+    {
+        throw std::runtime_error("driver Controller is restricted to study area but it tries to move outside");
+    }
+
+    //the loaded pathset depends on the retrieval procedure and the black list (and is filtered by the last link), so all of
+    //them are part of its cache key
+    const std::string& retrieval = (nonCBD_OD ? psRetrievalWithoutRestrictedRegion : getStudyAreaRetrieval());
+    const std::string cacheKey = getPathSetCacheKey(fromToID, retrieval, blackListedLinks, last);
+
     //Step-1 Check Cache
     /*
      * supply only the temporary blacklist, because with the current implementation,
      * cache should never be filled with paths containing permanent black listed segments
      */
     std::set<const sim_mob::Link*> emptyBlkLst = std::set<const sim_mob::Link*>(); //sometimes you don't need a black list at all!
-    if (useCache && findCachedPathSet(fromToID, pathset))
+    if (useCache && findCachedPathSet(cacheKey, pathset))
     {
         pathset->subTrip = st; //at least for the travel start time, subtrip is needed
         onPathSetRetrieval(pathset, enRoute, useInSimulationTT);
@@ -1204,31 +1232,7 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPathToLink(std::vector<sim_mob::
     pathset->id = fromToID;
     pathset->scenario = scenarioName;
     pathset->nonCDB_OD = nonCBD_OD;
-    if (nonCBD_OD)
-    {
-        hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, psRetrievalWithoutRestrictedRegion, blackListedLinks);
-    }
-    else
-    {
-        if(driverControllerStudyAreaEnabled && rdnw->IsMovementInStudyArea(fromNode->getNodeId(), toNode->getNodeId()))
-        {
-            int count = config.getDatabaseProcMappings().procedureMappings.count("studyArea_pvt_pathset");
-            if(count)
-            {
-                std::string psRetrievalForStudyArea = config.getDatabaseProcMappings().procedureMappings.find("studyArea_pvt_pathset")->second;
-                hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, psRetrievalForStudyArea, blackListedLinks);
-            }
-            else
-            {
-                throw std::runtime_error("Study Area Pathset Procedure Not present in configuration file");
-            }
-        }
-        else
-        {
-            throw std::runtime_error("driver Controller is restricted to study area but it tries to move outside");
-            //hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, psRetrieval, blackListedLinks);
-        }
-    }
+    hasPath = loadPathsetFromDB(*getSession(), fromToID, pathset->pathChoices, retrieval, blackListedLinks);
     switch (hasPath)
     {
         case PSM_HASPATH:
@@ -1252,7 +1256,7 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPathToLink(std::vector<sim_mob::
                 //cache
                 if (useCache)
                 {
-                    cachePathSet(pathset);
+                    cachePathSet(cacheKey, pathset);
                 }
                 return true;
             }
@@ -1970,21 +1974,36 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPathChoiceFromPathSet(boost::sha
     unsigned int sizeOfChoiceSet = pvtpathset.size();
     if (sizeOfChoiceSet > 0)
     {
-        // Call to the Lua function
-        LuaRef funcRef = getGlobal(state.get(), "choose_PVT_path");
-        LuaRef retVal = funcRef(this, sizeOfChoiceSet);
         int index = -1;
-        if (retVal.isNumber())
+        if (routeChoiceEvaluation == PathSetConf::ROUTE_CHOICE_LUA)
         {
-            index = retVal.cast<int>();
+            index = choosePathByScript();
         }
-        if (index > sizeOfChoiceSet || index <= 0)
+        else
         {
-            std::stringstream errStrm;
-            errStrm << "invalid path index (" << index << ") returned from PT route choice for OD with " << sizeOfChoiceSet << "path choices" << std::endl;
-            throw std::runtime_error(errStrm.str());
+            //The attributes of all paths are evaluated in one pass, without calling back from the script
+            pvtPathAttributes.clear();
+            for (const sim_mob::SinglePath* sp : pvtpathset)
+            {
+                pvtPathAttributes.addPath(*sp);
+            }
+            index = pvtChoiceEvaluator.choosePath(pvtPathAttributes) + 1;
+
+            if (routeChoiceEvaluation == PathSetConf::ROUTE_CHOICE_VALIDATE)
+            {
+                const int scriptIndex = choosePathByScript();
+                ++validatedChoices;
+                if (scriptIndex != index)
+                {
+                    ++mismatchedChoices;
+                    Warn() << "Private route choice validation: pathset " << ps->id << " with " << sizeOfChoiceSet
+                           << " paths, script chose path " << scriptIndex << ", native evaluation chose path " << index
+                           << std::endl;
+                }
+                index = scriptIndex;
+            }
         }
-        //Assigning the best path based on the index received from pvtrc lua
+        //Assigning the best path based on the index received from the route choice model
         ps->bestPath = &(pvtpathset[index - 1]->path);
         return true;
     }
@@ -1994,6 +2013,26 @@ bool sim_mob::PrivateTrafficRouteChoice::getBestPathChoiceFromPathSet(boost::sha
     }
 }
 
+int sim_mob::PrivateTrafficRouteChoice::choosePathByScript()
+{
+    unsigned int sizeOfChoiceSet = pvtpathset.size();
+    // Call to the Lua function
+    LuaRef funcRef = getGlobal(state.get(), "choose_PVT_path");
+    LuaRef retVal = funcRef(this, sizeOfChoiceSet);
+    int index = -1;
+    if (retVal.isNumber())
+    {
+        index = retVal.cast<int>();
+    }
+    if (index > sizeOfChoiceSet || index <= 0)
+    {
+        std::stringstream errStrm;
+        errStrm << "invalid path index (" << index << ") returned from PT route choice for OD with " << sizeOfChoiceSet << "path choices" << std::endl;
+        throw std::runtime_error(errStrm.str());
+    }
+    return index;
+}
+
 sim_mob::SinglePath * sim_mob::PrivatePathsetGenerator::findShortestDrivingPath(const sim_mob::Node *fromNode, const sim_mob::Node *toNode, const std::set<const sim_mob::Link*> & excludedLinks)
 {
     std::vector<const sim_mob::Link*> blacklist;
@@ -2045,6 +2084,11 @@ sim_mob::SinglePath* sim_mob::PrivatePathsetGenerator::generateShortestTravelTim
 
 double sim_mob::PrivateTrafficRouteChoice::getPathTravelTime(sim_mob::SinglePath *sp, const sim_mob::DailyTime & startTime_, bool enRoute, bool useInSimulationTT)
 {
+    const std::shared_ptr<const TravelTimeTable> ttTable = sim_mob::TravelTimeManager::getInstance()->getTravelTimeTable();
+    if (!ttTable)
+    {
+        throw std::runtime_error("travel times are not loaded");
+    }
     sim_mob::DailyTime startTime = startTime_;
     double timeSum = 0.0;
     for (int i = 0; i < sp->path.size(); ++i)
@@ -2064,7 +2108,7 @@ double sim_mob::PrivateTrafficRouteChoice::getPathTravelTime(sim_mob::SinglePath
 //      }
 //      else
         {
-            time = sim_mob::TravelTimeManager::getInstance()->getLinkTT(lnk, startTime, nextLink, useInSimulationTT);
+            time = ttTable->getLinkTT(lnk, startTime, nextLink, useInSimulationTT);
         }
         if (time == 0.0)
         {
@@ -2120,12 +2164,69 @@ sim_mob::PrivateTrafficRouteChoice::PrivateTrafficRouteChoice()
         : PathSetManager(),
           psRetrieval(sim_mob::ConfigManager::GetInstance().FullConfig().getDatabaseProcMappings().procedureMappings.find("pvt_pathset")->second),
           psRetrievalWithoutRestrictedRegion(sim_mob::ConfigManager::GetInstance().FullConfig().getPathSetConf().psRetrievalWithoutBannedRegion),
-          cacheLRU(2500), ttMgr(*(sim_mob::TravelTimeManager::getInstance())), regionRestrictonEnabled(false)
+          cacheLRU(sim_mob::ConfigManager::GetInstance().PathSetConfig().cacheCapacity, boost::mem_fn(&sim_mob::PathSet::getMemoryFootprint)),
+          ttMgr(*(sim_mob::TravelTimeManager::getInstance())), regionRestrictonEnabled(false),
+          routeChoiceEvaluation(sim_mob::ConfigManager::GetInstance().PathSetConfig().routeChoiceEvaluation),
+          validatedChoices(0), mismatchedChoices(0)
 {
 }
 
 sim_mob::PrivateTrafficRouteChoice::~PrivateTrafficRouteChoice()
 {
+    if (sim_mob::ConfigManager::GetInstance().PathSetConfig().cacheEnabled)
+    {
+        const LRU_Cache<std::string, boost::shared_ptr<PathSet> >::Statistics& stats = cacheLRU.getStatistics();
+        Print() << "Pathset cache: " << stats.hits << " hits, " << stats.misses << " misses, " << stats.insertions << " insertions, "
+                << stats.evictions << " evictions, " << stats.rejections << " rejected; " << stats.entries << " pathsets ("
+                << stats.bytes / 1024 << " of " << cacheLRU.getCapacity() / 1024 << " KB) cached" << std::endl;
+    }
+    if (routeChoiceEvaluation == PathSetConf::ROUTE_CHOICE_VALIDATE)
+    {
+        Print() << "Private route choice validation: " << mismatchedChoices << " of " << validatedChoices
+                << " choices differed between the script and the native evaluation" << std::endl;
+    }
+}
+
+void sim_mob::PrivateTrafficRouteChoice::loadRouteChoiceCoefficients()
+{
+    if (routeChoiceEvaluation == PathSetConf::ROUTE_CHOICE_LUA)
+    {
+        return;
+    }
+
+    LuaRef table = getGlobal(state.get(), "pvtrc_coefficients");
+    if (!table.isTable())
+    {
+        throw std::runtime_error("pvtrc_coefficients table not defined by the route choice script, as required by "
+                                 "<route_choice evaluation=\"native\"/> and <route_choice evaluation=\"validate\"/>");
+    }
+
+    RouteChoiceCoefficients coefficients;
+    const std::pair<const char*, double*> fields[] = {
+        std::make_pair("travel_time", &coefficients.travelTime),
+        std::make_pair("travel_cost", &coefficients.travelCost),
+        std::make_pair("common_factor", &coefficients.commonFactor),
+        std::make_pair("length", &coefficients.length),
+        std::make_pair("highway_distance", &coefficients.highwayDistance),
+        std::make_pair("highway_bias", &coefficients.highwayBias),
+        std::make_pair("signal_number", &coefficients.signalNumber),
+        std::make_pair("right_turn_number", &coefficients.rightTurnNumber),
+        std::make_pair("min_distance", &coefficients.minDistance),
+        std::make_pair("min_signal", &coefficients.minSignal),
+        std::make_pair("max_highway_usage", &coefficients.maxHighwayUsage),
+        std::make_pair("work", &coefficients.work),
+        std::make_pair("leisure", &coefficients.leisure)
+    };
+    for (const std::pair<const char*, double*>& field : fields)
+    {
+        LuaRef value = table[field.first];
+        if (!value.isNumber())
+        {
+            throw std::runtime_error(std::string("pvtrc_coefficients.") + field.first + " is not a number");
+        }
+        *field.second = value.cast<double>();
+    }
+    pvtChoiceEvaluator.setCoefficients(coefficients);
 }
 
 PrivateTrafficRouteChoice* sim_mob::PrivateTrafficRouteChoice::getInstance()
@@ -2169,6 +2270,13 @@ void sim_mob::PrivateTrafficRouteChoice::addPartialExclusion(const sim_mob::Road
 sim_mob::HasPath PrivateTrafficRouteChoice::loadPathsetFromDB(soci::session& sql, std::string& pathsetId, std::set<sim_mob::SinglePath*, sim_mob::SinglePath>& spPool, const std::string functionName,
         const std::set<const sim_mob::Link*>& excludedLinks) const
 {
+    //the paths of the main retrieval function are pre-loaded
+    const PathSetStore* store = pathSetParam->getPathSetStore();
+    if (store && functionName == psRetrieval)
+    {
+        return loadPathsetFromStore(*store, pathsetId, spPool, excludedLinks);
+    }
+
     //prepare statement and execute query
     std::stringstream query;
     query << "select * from " << functionName << "(" << pathsetId << ")"; //pathset_id is a string of "<origin_node_id>,<destination_node_id>" format
@@ -2264,6 +2372,90 @@ sim_mob::HasPath PrivateTrafficRouteChoice::loadPathsetFromDB(soci::session& sql
     return sim_mob::PSM_HASPATH;
 }
 
+sim_mob::HasPath PrivateTrafficRouteChoice::loadPathsetFromStore(const PathSetStore& store, const std::string& pathsetId,
+        std::set<sim_mob::SinglePath*, sim_mob::SinglePath>& spPool, const std::set<const sim_mob::Link*>& excludedLinks) const
+{
+    unsigned int origin = 0, destination = 0;
+    if (sscanf(pathsetId.c_str(), "%u,%u", &origin, &destination) != 2)
+    {
+        throw std::runtime_error("Invalid pathset id " + pathsetId);
+    }
+
+    std::size_t numPaths = 0;
+    const PathSetStorePath* paths = store.findPaths(origin, destination, numPaths);
+    if (!paths)
+    {
+        return sim_mob::PSM_NOTFOUND;
+    }
+
+    int cnt = 0;
+    for (std::size_t p = 0; p < numPaths; ++p)
+    {
+        const PathSetStorePath& storedPath = paths[p];
+        if (storedPath.numLinks == 0)
+        {
+            throw std::runtime_error("Empty Path");
+        }
+
+        //the links were resolved when the store was loaded
+        bool proceed = true;
+        std::vector<sim_mob::WayPoint> path;
+        std::stringstream id;
+        path.reserve(storedPath.numLinks);
+        const uint32_t* linkIndices = store.getLinkIndices(storedPath);
+        for (uint32_t i = 0; i < storedPath.numLinks; ++i)
+        {
+            const Link* lnk = store.getLink(linkIndices[i]);
+            if (!lnk)
+            {
+                throw std::runtime_error("SinglePath: link not find " + std::to_string(store.getLinkId(linkIndices[i])));
+            }
+            if (excludedLinks.find(lnk) != excludedLinks.end())
+            {
+                proceed = false;
+                break;
+            }
+            path.push_back(sim_mob::WayPoint(lnk));
+            id << lnk->getLinkId() << ",";
+        }
+
+        if (!proceed)
+        {
+            continue;
+        }
+
+        //create path object, as the SinglePath converter does for a row of the pathset tables
+        sim_mob::SinglePath *singlePath = new sim_mob::SinglePath();
+        singlePath->pathSetId = pathsetId;
+        singlePath->scenario = store.getScenario(storedPath);
+        singlePath->id = id.str();
+        singlePath->partialUtility = storedPath.partialUtility;
+        singlePath->pathSize = storedPath.pathSize;
+        singlePath->signalNumber = storedPath.signalNumber;
+        singlePath->rightTurnNumber = storedPath.rightTurnNumber;
+        singlePath->length = storedPath.length;
+        singlePath->highWayDistance = storedPath.highWayDistance;
+        singlePath->minDistance = storedPath.flags & PathSetStorePath::MIN_DISTANCE;
+        singlePath->minSignals = storedPath.flags & PathSetStorePath::MIN_SIGNALS;
+        singlePath->minRightTurns = storedPath.flags & PathSetStorePath::MIN_RIGHT_TURNS;
+        singlePath->maxHighWayUsage = storedPath.flags & PathSetStorePath::MAX_HIGHWAY_USAGE;
+        singlePath->validPath = storedPath.flags & PathSetStorePath::VALID_PATH;
+        singlePath->shortestPath = storedPath.flags & PathSetStorePath::SHORTEST_PATH;
+        singlePath->path = boost::move(path);
+        if (!spPool.insert(singlePath).second)
+        {
+            delete singlePath;
+        }
+        cnt++;
+    }
+
+    if (cnt == 0)
+    {
+        return sim_mob::PSM_NOGOODPATH;
+    }
+    return sim_mob::PSM_HASPATH;
+}
+
 boost::shared_ptr<sim_mob::RestrictedRegion> sim_mob::RestrictedRegion::instance;
 sim_mob::RestrictedRegion::RestrictedRegion()
 {
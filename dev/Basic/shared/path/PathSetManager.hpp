@@ -11,6 +11,7 @@
 #include "util/Cache.hpp"
 #include "lua/LuaModel.hpp"
 #include "Path.hpp"
+#include "PathChoiceEvaluator.hpp"
 #include "util/OneTimeFlag.hpp"
 
 
@@ -315,7 +316,7 @@ public:
 class PrivateTrafficRouteChoice : public sim_mob::PathSetManager , public lua::LuaModel
 {
 private:
-    /** the pathset cache */
+    /** the pathset cache, keyed by getPathSetCacheKey(); owned by the thread of this route choice context */
     sim_mob::LRU_Cache<std::string, boost::shared_ptr<PathSet> > cacheLRU;
 
     /**
@@ -341,19 +342,57 @@ private:
 
     std::vector<sim_mob::SinglePath*> pvtpathset;
 
+    /** how the route choice model is evaluated */
+    const PathSetConf::RouteChoiceEvaluation routeChoiceEvaluation;
+
+    /** attributes of the paths in pvtpathset, for the evaluation of the route choice model in C++ */
+    PathChoiceAttributes pvtPathAttributes;
+
+    /** evaluates the route choice model in C++ */
+    PathChoiceEvaluator pvtChoiceEvaluator;
+
+    /** number of choices compared in validation mode, and the number of them which differed */
+    unsigned int validatedChoices;
+    unsigned int mismatchedChoices;
+
+    /**
+     * chooses a path from pvtpathset with the choose_PVT_path function of the route choice script
+     * @return the index of the chosen path, starting with 1
+     */
+    int choosePathByScript();
+
     /**
      * cache the generated pathset
+     * @param key key of the pathset (see getPathSetCacheKey())
      * @param ps pathset general information
      */
-    void cachePathSet(boost::shared_ptr<sim_mob::PathSet> &ps);
+    void cachePathSet(const std::string& key, boost::shared_ptr<sim_mob::PathSet> &ps);
 
     /**
      * searches for a pathset in the cache.
-     * @param key indicates the input key
+     * @param key indicates the input key (see getPathSetCacheKey())
      * @param value the result of the search
      * returns true/false to indicate if the search has been successful
      */
-    bool findCachedPathSet(std::string key, boost::shared_ptr<sim_mob::PathSet> &value);
+    bool findCachedPathSet(const std::string& key, boost::shared_ptr<sim_mob::PathSet> &value);
+
+    /**
+     * builds the cache key of a pathset from every input its paths depend on
+     * @param fromToID origin and destination of the pathset
+     * @param retrieval stored procedure the pathset is loaded with
+     * @param blackListedLinks links excluded from the loaded paths
+     * @param lastLink link the paths are filtered to end on (if any)
+     * @return the key
+     */
+    std::string getPathSetCacheKey(const std::string& fromToID, const std::string& retrieval,
+            const std::set<const sim_mob::Link*>& blackListedLinks = std::set<const sim_mob::Link*>(),
+            const sim_mob::Link* lastLink = nullptr) const;
+
+    /**
+     * @return the stored procedure retrieving the pathsets of the study area
+     * @throws std::runtime_error if the procedure is not configured
+     */
+    const std::string& getStudyAreaRetrieval() const;
 
     /**
      * calculates the travel time of a path
@@ -400,7 +439,8 @@ private:
     void mapClasses();
 
     /**
-     * loads set of paths pre-generated for an OD
+     * loads set of paths pre-generated for an OD.
+     * If a path-set store is loaded, the paths of the main retrieval function are read from it instead of the DB
      *
      * @param sql soci session to use for querying DB
      * @param pathsetId <origin_node>,<destination_node> in string format
@@ -416,10 +456,31 @@ private:
             const std::string functionName,
             const std::set<const sim_mob::Link*>& excludedRS = std::set<const sim_mob::Link*>()) const;
 
+    /**
+     * loads set of paths pre-generated for an OD from the path-set store
+     *
+     * @param store the loaded path-set store
+     * @param pathsetId <origin_node>,<destination_node> in string format
+     * @param spPool output set of SinglePaths
+     * @param excludedLinks set of black listed links (if any)
+     *
+     * @return status of pathset retrieval as an enumerated value from sim_mob::HasPath
+     */
+    sim_mob::HasPath loadPathsetFromStore(const PathSetStore& store,
+            const std::string& pathsetId,
+            std::set<sim_mob::SinglePath*, sim_mob::SinglePath>& spPool,
+            const std::set<const sim_mob::Link*>& excludedLinks) const;
+
 public:
     PrivateTrafficRouteChoice();
     virtual ~PrivateTrafficRouteChoice();
 
+    /**
+     * reads the coefficients of the route choice model from the global pvtrc_coefficients table of the loaded
+     * scripts, unless the model is evaluated by the script alone
+     */
+    void loadRouteChoiceCoefficients();
+
     double getTravelCost(unsigned int index);
     double getTravelTime(unsigned int index);
     double getPathSize(unsigned int index);
@@ -1,6 +1,8 @@
 #include "PathSetParam.hpp"
 
+#include <boost/algorithm/string.hpp>
 #include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
 #include "conf/ConfigManager.hpp"
 #include "conf/ConfigParams.hpp"
 #include "geospatial/network/RoadNetwork.hpp"
@@ -43,6 +45,12 @@ void sim_mob::PathSetParam::getDataFromDB()
     loadERP_Surcharge(dbSession);
     loadERP_Section(dbSession);
     loadERP_GantryZone(dbSession);
+
+    const PathSetConf& psCfg = cfg.getPathSetConf();
+    if (!psCfg.storeFile.empty() && psCfg.privatePathSetMode == "normal")
+    {
+        loadPathSetStore(dbSession);
+    }
 }
 
 void sim_mob::PathSetParam::storeSinglePath(std::set<sim_mob::SinglePath*, sim_mob::SinglePath>& spPool)
@@ -190,3 +198,76 @@ void sim_mob::PathSetParam::loadERP_GantryZone(soci::session& sql)
         ERP_Gantry_ZonePool.insert(std::make_pair(s->gantryNo, s));
     }
 }
+
+void sim_mob::PathSetParam::loadPathSetStore(soci::session& sql)
+{
+    const PathSetConf& psCfg = sim_mob::ConfigManager::GetInstance().FullConfig().getPathSetConf();
+    const std::map<unsigned int, Link *>& links = roadNetwork.getMapOfIdVsLinks();
+
+    //The source is rewritten under the same name when the pathsets are regenerated, so the store is keyed on the
+    //configured version of the source too
+    pathSetStore.reset(new PathSetStore(psCfg.storeSource, psCfg.storeSourceVersion));
+
+    try
+    {
+        pathSetStore->load(psCfg.storeFile, links);
+        Print() << "Path-set store: " << pathSetStore->getNumPaths() << " paths of " << pathSetStore->getNumPathSets()
+                << " ODs loaded from " << psCfg.storeFile << std::endl;
+        return;
+    }
+    catch (std::runtime_error& ex)
+    {
+        Warn() << ex.what() << std::endl;
+    }
+
+    if (psCfg.storeSource.empty())
+    {
+        Warn() << "Path-set store: no source configured to build " << psCfg.storeFile
+               << "; private pathsets are read from the database" << std::endl;
+        pathSetStore.reset();
+        return;
+    }
+
+    Print() << "Path-set store: building " << psCfg.storeFile << " from " << psCfg.storeSource << std::endl;
+    PathSetStore builder(psCfg.storeSource, psCfg.storeSourceVersion);
+    soci::rowset<sim_mob::SinglePath> rs = (sql.prepare << "select * from " << psCfg.storeSource);
+    for (soci::rowset<sim_mob::SinglePath>::const_iterator it = rs.begin(); it != rs.end(); ++it)
+    {
+        unsigned int origin = 0, destination = 0;
+        if (sscanf(it->pathSetId.c_str(), "%u,%u", &origin, &destination) != 2)
+        {
+            throw std::runtime_error("Path-set store: invalid pathset id " + it->pathSetId);
+        }
+
+        std::vector<unsigned int> linkIds;
+        std::vector<std::string> ids;
+        boost::split(ids, it->id, boost::is_any_of(","));
+        for (std::vector<std::string>::const_iterator idIt = ids.begin(); idIt != ids.end(); ++idIt)
+        {
+            if (!idIt->empty())
+            {
+                linkIds.push_back(boost::lexical_cast<unsigned int>(*idIt));
+            }
+        }
+
+        PathSetStorePath attributes = PathSetStorePath();
+        attributes.partialUtility = it->partialUtility;
+        attributes.pathSize = it->pathSize;
+        attributes.length = it->length;
+        attributes.highWayDistance = it->highWayDistance;
+        attributes.signalNumber = it->signalNumber;
+        attributes.rightTurnNumber = it->rightTurnNumber;
+        attributes.flags = (it->minDistance ? PathSetStorePath::MIN_DISTANCE : 0)
+                | (it->minSignals ? PathSetStorePath::MIN_SIGNALS : 0)
+                | (it->minRightTurns ? PathSetStorePath::MIN_RIGHT_TURNS : 0)
+                | (it->maxHighWayUsage ? PathSetStorePath::MAX_HIGHWAY_USAGE : 0)
+                | (it->validPath ? PathSetStorePath::VALID_PATH : 0)
+                | (it->shortestPath ? PathSetStorePath::SHORTEST_PATH : 0);
+        builder.addPath(origin, destination, linkIds, attributes, it->scenario);
+    }
+    builder.save(psCfg.storeFile);
+
+    pathSetStore->load(psCfg.storeFile, links);
+    Print() << "Path-set store: " << pathSetStore->getNumPaths() << " paths of " << pathSetStore->getNumPathSets()
+            << " ODs, " << pathSetStore->getNumLinkIndices() << " link indices" << std::endl;
+}
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <map>
+#include <boost/scoped_ptr.hpp>
 #include <soci/soci.h>
 #include <soci/postgresql/soci-postgresql.h>
 #include "Common.hpp"
 #include "entities/TravelTimeManager.hpp"
 #include "Path.hpp"
+#include "PathSetStore.hpp"
 
 namespace sim_mob
 {
@@ -82,6 +84,15 @@ private:
      */
     void loadERP_GantryZone(soci::session& sql);
 
+    /**
+     * loads the path-set store, building it from the configured source table if the file is missing or stale
+     * @param sql db session object
+     */
+    void loadPathSetStore(soci::session& sql);
+
+    /// pre-generated private pathsets, if a path-set store is configured
+    boost::scoped_ptr<PathSetStore> pathSetStore;
+
 public:
     static PathSetParam* getInstance();
 
@@ -101,6 +112,14 @@ public:
         return highwayBias;
     }
 
+    /**
+     * @return the path-set store; null if none is configured
+     */
+    const PathSetStore* getPathSetStore() const
+    {
+        return pathSetStore.get();
+    }
+
     /// pathset parameters
     double highwayBias;
 
@@ -0,0 +1,195 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "PathSetStore.hpp"
+
+#include <algorithm>
+#include <boost/lexical_cast.hpp>
+
+using namespace sim_mob;
+
+namespace
+{
+/** Tables of a path-set store */
+enum PathSetStoreTable
+{
+    STORE_ODS = 1,
+    STORE_PATHS = 2,
+    STORE_LINK_SEQUENCES = 3,
+    STORE_LINK_IDS = 4
+};
+
+std::string getStoreKey(const std::string& source, const std::string& sourceVersion)
+{
+    return "pathset_store_v" + boost::lexical_cast<std::string>(PathSetStore::VERSION) + ";source=" + source
+            + ";source_version=" + sourceVersion;
+}
+
+uint64_t getODKey(unsigned int origin, unsigned int destination)
+{
+    return (uint64_t(origin) << 32) | destination;
+}
+
+bool compareODKeys(const std::pair<uint64_t, PathSetStorePath>& first, const std::pair<uint64_t, PathSetStorePath>& second)
+{
+    return first.first < second.first;
+}
+
+bool lessThanOD(const PathSetStoreOD& od, uint64_t key)
+{
+    return getODKey(od.origin, od.destination) < key;
+}
+}
+
+const uint32_t PathSetStore::VERSION;
+
+PathSetStore::PathSetStore(const std::string& source, const std::string& sourceVersion) :
+        tables(getStoreKey(source, sourceVersion)), ods(nullptr), numODs(0), paths(nullptr), numPaths(0), linkSequences(nullptr),
+        numLinkIndices(0), linkIds(nullptr)
+{
+}
+
+void PathSetStore::addPath(unsigned int origin, unsigned int destination, const std::vector<unsigned int>& linkIds,
+                           const PathSetStorePath& attributes, const std::string& scenario)
+{
+    std::vector<uint32_t> sequence;
+    sequence.reserve(linkIds.size());
+    for (std::vector<unsigned int>::const_iterator it = linkIds.begin(); it != linkIds.end(); ++it)
+    {
+        std::map<uint32_t, uint32_t>::iterator idx = linkIndexOfId.find(*it);
+        if (idx == linkIndexOfId.end())
+        {
+            idx = linkIndexOfId.insert(std::make_pair(*it, uint32_t(addedLinkIds.size()))).first;
+            addedLinkIds.push_back(*it);
+        }
+        sequence.push_back(idx->second);
+    }
+
+    PathSetStorePath path = attributes;
+    path.numLinks = sequence.size();
+
+    //Paths of different ODs or scenarios often have the same links; their sequence is stored once
+    std::map<std::vector<uint32_t>, uint32_t>::iterator seqIt = sequencePositions.find(sequence);
+    if (seqIt == sequencePositions.end())
+    {
+        seqIt = sequencePositions.insert(std::make_pair(sequence, uint32_t(addedLinkSequences.size()))).first;
+        addedLinkSequences.insert(addedLinkSequences.end(), sequence.begin(), sequence.end());
+    }
+    path.firstLink = seqIt->second;
+
+    std::map<std::string, SnapshotString>::iterator scenarioIt = scenarios.find(scenario);
+    if (scenarioIt == scenarios.end())
+    {
+        scenarioIt = scenarios.insert(std::make_pair(scenario, tables.addString(scenario))).first;
+    }
+    path.scenario = scenarioIt->second;
+
+    addedPaths.push_back(std::make_pair(getODKey(origin, destination), path));
+}
+
+void PathSetStore::save(const std::string& fileName)
+{
+    //Keep the order of the paths of an OD, as returned by the source
+    std::stable_sort(addedPaths.begin(), addedPaths.end(), compareODKeys);
+
+    std::vector<PathSetStoreOD> odRecords;
+    std::vector<PathSetStorePath> pathRecords;
+    pathRecords.reserve(addedPaths.size());
+    for (std::vector<std::pair<uint64_t, PathSetStorePath> >::const_iterator it = addedPaths.begin();
+            it != addedPaths.end(); ++it)
+    {
+        if (odRecords.empty() || getODKey(odRecords.back().origin, odRecords.back().destination) != it->first)
+        {
+            PathSetStoreOD od;
+            od.origin = it->first >> 32;
+            od.destination = it->first & 0xffffffff;
+            od.firstPath = pathRecords.size();
+            od.numPaths = 0;
+            odRecords.push_back(od);
+        }
+        ++odRecords.back().numPaths;
+        pathRecords.push_back(it->second);
+    }
+
+    tables.setRecords(STORE_ODS, odRecords);
+    tables.setRecords(STORE_PATHS, pathRecords);
+    tables.setRecords(STORE_LINK_SEQUENCES, addedLinkSequences);
+    tables.setRecords(STORE_LINK_IDS, addedLinkIds);
+    tables.save(fileName);
+}
+
+void PathSetStore::load(const std::string& fileName, const std::map<unsigned int, Link*>& networkLinks)
+{
+    addedPaths.clear();
+    addedLinkSequences.clear();
+    addedLinkIds.clear();
+    linkIndexOfId.clear();
+    sequencePositions.clear();
+    scenarios.clear();
+    links.clear();
+    numODs = numPaths = numLinkIndices = 0;
+
+    tables.load(fileName);
+
+    std::size_t numLinkIds = 0;
+    try
+    {
+        ods = tables.getRecords<PathSetStoreOD>(STORE_ODS, numODs);
+        paths = tables.getRecords<PathSetStorePath>(STORE_PATHS, numPaths);
+        linkSequences = tables.getRecords<uint32_t>(STORE_LINK_SEQUENCES, numLinkIndices);
+        linkIds = tables.getRecords<uint32_t>(STORE_LINK_IDS, numLinkIds);
+    }
+    catch (std::runtime_error&)
+    {
+        numODs = numPaths = numLinkIndices = 0;
+        throw std::runtime_error("Path-set store: unexpected records in " + fileName);
+    }
+
+    //The file passed its checksum; the references are still checked here once, so that the lookups need not check them
+    for (std::size_t i = 0; i < numODs; ++i)
+    {
+        if (ods[i].firstPath > numPaths || ods[i].numPaths > numPaths - ods[i].firstPath
+                || (i > 0 && !lessThanOD(ods[i - 1], getODKey(ods[i].origin, ods[i].destination))))
+        {
+            numODs = 0;
+            throw std::runtime_error("Path-set store: invalid OD in " + fileName);
+        }
+    }
+    for (std::size_t i = 0; i < numPaths; ++i)
+    {
+        bool valid = paths[i].firstLink <= numLinkIndices && paths[i].numLinks <= numLinkIndices - paths[i].firstLink;
+        for (uint32_t j = 0; valid && j < paths[i].numLinks; ++j)
+        {
+            valid = linkSequences[paths[i].firstLink + j] < numLinkIds;
+        }
+        if (!valid)
+        {
+            numODs = 0;
+            throw std::runtime_error("Path-set store: invalid path in " + fileName);
+        }
+    }
+
+    links.resize(numLinkIds, nullptr);
+    for (std::size_t i = 0; i < numLinkIds; ++i)
+    {
+        std::map<unsigned int, Link*>::const_iterator it = networkLinks.find(linkIds[i]);
+        if (it != networkLinks.end())
+        {
+            links[i] = it->second;
+        }
+    }
+}
+
+const PathSetStorePath* PathSetStore::findPaths(unsigned int origin, unsigned int destination, std::size_t& numODPaths) const
+{
+    const uint64_t key = getODKey(origin, destination);
+    const PathSetStoreOD* od = std::lower_bound(ods, ods + numODs, key, lessThanOD);
+    if (od == ods + numODs || od->origin != origin || od->destination != destination)
+    {
+        numODPaths = 0;
+        return nullptr;
+    }
+    numODPaths = od->numPaths;
+    return paths + od->firstPath;
+}
@@ -0,0 +1,198 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include "geospatial/network/NetworkSnapshot.hpp"
+
+namespace sim_mob
+{
+
+class Link;
+
+/** The paths of an OD in a path-set store */
+struct PathSetStoreOD
+{
+    uint32_t origin;
+    uint32_t destination;
+
+    /** position of the first path in the paths table */
+    uint32_t firstPath;
+    uint32_t numPaths;
+};
+
+/** A path of a path-set store, with the time independent attributes of the pathset tables */
+struct PathSetStorePath
+{
+    enum Flags
+    {
+        MIN_DISTANCE = 1,
+        MIN_SIGNALS = 2,
+        MIN_RIGHT_TURNS = 4,
+        MAX_HIGHWAY_USAGE = 8,
+        VALID_PATH = 16,
+        SHORTEST_PATH = 32
+    };
+
+    double partialUtility;
+    double pathSize;
+    double length;
+    double highWayDistance;
+
+    /** position of the links of the path in the link sequences table (shared by paths with the same links) */
+    uint32_t firstLink;
+    uint32_t numLinks;
+
+    int32_t signalNumber;
+    int32_t rightTurnNumber;
+    uint32_t flags;
+    uint32_t unused;
+    SnapshotString scenario;
+};
+
+/**
+ * Read-only store of the pre-generated private traffic path sets, to find the paths of an OD without querying the
+ * database.
+ *
+ * A path is an array of indices into a table of the distinct links of all paths; paths with the same links share the
+ * array. The ODs are sorted, so that the paths of an OD are found by binary search. The store is kept in the
+ * NetworkSnapshot file format and mapped into memory as is; once loaded it is never modified, so it is queried from
+ * any number of threads without locking.
+ */
+class PathSetStore : private boost::noncopyable
+{
+public:
+    /** Version of the tables; stores of other versions are rebuilt */
+    static const uint32_t VERSION = 1;
+
+    /**
+     * Creates an empty store
+     * @param source the table (or function) the paths are read from; a file is only loaded if it was built from it
+     * @param sourceVersion version stamp of the source; a file is only loaded if it was built from the same version, so
+     *        that a store is rebuilt when its source is regenerated under the same name
+     */
+    PathSetStore(const std::string& source, const std::string& sourceVersion);
+
+    /**
+     * Adds a path, while building the store
+     * @param origin origin node of the path set
+     * @param destination destination node of the path set
+     * @param linkIds the links of the path, in order
+     * @param attributes the attributes of the path (the link sequence is set by the store)
+     * @param scenario the scenario the path was generated for
+     */
+    void addPath(unsigned int origin, unsigned int destination, const std::vector<unsigned int>& linkIds,
+                 const PathSetStorePath& attributes, const std::string& scenario);
+
+    /**
+     * Writes the paths added so far to a file
+     * @param fileName the store file; overwritten
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& fileName);
+
+    /**
+     * Maps a store file into memory
+     * @param fileName the store file
+     * @param links the links of the road network, by id
+     * @throws std::runtime_error if the file cannot be read, is corrupt, or was built from another source or version
+     */
+    void load(const std::string& fileName, const std::map<unsigned int, Link*>& links);
+
+    /**
+     * Finds the paths of an OD in a loaded store
+     * @param origin origin node
+     * @param destination destination node
+     * @param numPaths output: the number of paths
+     * @return the paths; null if the OD has none
+     */
+    const PathSetStorePath* findPaths(unsigned int origin, unsigned int destination, std::size_t& numPaths) const;
+
+    /**
+     * @param path a path of the store
+     * @return the indices of the links of the path (path.numLinks of them)
+     */
+    const uint32_t* getLinkIndices(const PathSetStorePath& path) const
+    {
+        return linkSequences + path.firstLink;
+    }
+
+    /**
+     * @param index a link index of a path
+     * @return the link; null if the link is not in the road network
+     */
+    const Link* getLink(uint32_t index) const
+    {
+        return links[index];
+    }
+
+    /**
+     * @param index a link index of a path
+     * @return the id of the link
+     */
+    uint32_t getLinkId(uint32_t index) const
+    {
+        return linkIds[index];
+    }
+
+    std::string getScenario(const PathSetStorePath& path) const
+    {
+        return tables.getString(path.scenario);
+    }
+
+    std::size_t getNumPathSets() const
+    {
+        return numODs;
+    }
+
+    std::size_t getNumPaths() const
+    {
+        return numPaths;
+    }
+
+    /** @return the size of the link sequences table, after the sequences shared by several paths were merged */
+    std::size_t getNumLinkIndices() const
+    {
+        return numLinkIndices;
+    }
+
+private:
+    /** the tables, built or mapped */
+    NetworkSnapshot tables;
+
+    /** while building: the paths, by OD (origin in the high bits) */
+    std::vector<std::pair<uint64_t, PathSetStorePath> > addedPaths;
+
+    /** while building: the link sequences */
+    std::vector<uint32_t> addedLinkSequences;
+
+    /** while building: the distinct links, and their index */
+    std::vector<uint32_t> addedLinkIds;
+    std::map<uint32_t, uint32_t> linkIndexOfId;
+
+    /** while building: the position of each distinct link sequence */
+    std::map<std::vector<uint32_t>, uint32_t> sequencePositions;
+
+    /** while building: the scenario names */
+    std::map<std::string, SnapshotString> scenarios;
+
+    /** once loaded: the mapped tables */
+    const PathSetStoreOD* ods;
+    std::size_t numODs;
+    const PathSetStorePath* paths;
+    std::size_t numPaths;
+    const uint32_t* linkSequences;
+    std::size_t numLinkIndices;
+    const uint32_t* linkIds;
+
+    /** once loaded: the links of the road network, by link index */
+    std::vector<const Link*> links;
+};
+
+}
@@ -0,0 +1,198 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sim_mob
+{
+
+/**
+ * Index of objects (e.g. vehicles) by lane and by their offset along the lane.
+ *
+ * The objects of each lane are kept sorted by offset, so that the objects ahead of or behind a position on a lane are
+ * found with a binary search, and the first and last objects of a lane in constant time, without a spatial search.
+ * Like the spatial trees, the index is rebuilt from scratch by build() once the positions of a time tick are published.
+ *
+ * Queries are read only and may run concurrently with each other, but not with build().
+ *
+ * @tparam Lane type of the lanes; only their addresses are used
+ * @tparam T type of the objects
+ */
+template<typename Lane, typename T>
+class LaneOrderedIndex
+{
+public:
+    /** an object and its position */
+    struct Entry
+    {
+        Entry() : lane(nullptr), offset(0), object(nullptr)
+        {
+        }
+
+        Entry(const Lane* lane, double offset, const T* object) : lane(lane), offset(offset), object(object)
+        {
+        }
+
+        const Lane* lane;
+        double offset;
+        const T* object;
+    };
+
+    typedef typename std::vector<Entry>::const_iterator const_iterator;
+
+    /**
+     * Rebuilds the index
+     * @param newEntries objects to index; swapped into the index, so that the vector holds the previous entries
+     *        (in no particular order) on return and its storage can be reused by the caller
+     */
+    void build(std::vector<Entry>& newEntries)
+    {
+        entries.swap(newEntries);
+        laneRanges.clear();
+        std::sort(entries.begin(), entries.end(), [](const Entry& first, const Entry& second)
+        {
+            return first.lane != second.lane ? std::less<const Lane*>()(first.lane, second.lane) : first.offset < second.offset;
+        });
+
+        std::size_t first = 0;
+        for (std::size_t i = 1; i <= entries.size(); i++)
+        {
+            if (i == entries.size() || entries[i].lane != entries[first].lane)
+            {
+                laneRanges[entries[first].lane] = std::make_pair(first, i);
+                first = i;
+            }
+        }
+    }
+
+    void clear()
+    {
+        entries.clear();
+        laneRanges.clear();
+    }
+
+    std::size_t size() const
+    {
+        return entries.size();
+    }
+
+    bool empty() const
+    {
+        return entries.empty();
+    }
+
+    /**
+     * @param lane the lane
+     * @return the entries of the lane, by increasing offset
+     */
+    std::pair<const_iterator, const_iterator> onLane(const Lane* lane) const
+    {
+        auto itRange = laneRanges.find(lane);
+        if (itRange == laneRanges.end())
+        {
+            return std::make_pair(entries.end(), entries.end());
+        }
+        return std::make_pair(entries.begin() + itRange->second.first, entries.begin() + itRange->second.second);
+    }
+
+    /**
+     * @param lane the lane
+     * @param minOffset lower bound of the offset (included)
+     * @param maxOffset upper bound of the offset (included)
+     * @return the entries of the lane with an offset within the bounds, by increasing offset
+     */
+    std::pair<const_iterator, const_iterator> onLane(const Lane* lane, double minOffset, double maxOffset) const
+    {
+        std::pair<const_iterator, const_iterator> range = onLane(lane);
+        const_iterator first = std::lower_bound(range.first, range.second, minOffset, entryLessOffset);
+        const_iterator last = std::upper_bound(first, range.second, maxOffset, offsetLessEntry);
+        return std::make_pair(first, last);
+    }
+
+    /**
+     * Finds the object directly ahead of a position
+     * @param lane the lane
+     * @param offset offset of the position on the lane
+     * @param self object at the position, if any; never returned
+     * @return the entry of the object with the smallest offset greater than the given one; nullptr if there is none
+     */
+    const Entry* leader(const Lane* lane, double offset, const T* self = nullptr) const
+    {
+        std::pair<const_iterator, const_iterator> range = onLane(lane);
+        for (const_iterator it = std::upper_bound(range.first, range.second, offset, offsetLessEntry); it != range.second; ++it)
+        {
+            if (it->object != self)
+            {
+                return &*it;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Finds the object directly behind a position
+     * @param lane the lane
+     * @param offset offset of the position on the lane
+     * @param self object at the position, if any; never returned
+     * @return the entry of the object with the greatest offset not greater than the given one; nullptr if there is none
+     */
+    const Entry* follower(const Lane* lane, double offset, const T* self = nullptr) const
+    {
+        std::pair<const_iterator, const_iterator> range = onLane(lane);
+        for (const_iterator it = std::upper_bound(range.first, range.second, offset, offsetLessEntry); it != range.first;)
+        {
+            --it;
+            if (it->object != self)
+            {
+                return &*it;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @param lane the lane
+     * @return the entry with the smallest offset on the lane; nullptr if the lane is empty
+     */
+    const Entry* first(const Lane* lane) const
+    {
+        std::pair<const_iterator, const_iterator> range = onLane(lane);
+        return range.first != range.second ? &*range.first : nullptr;
+    }
+
+    /**
+     * @param lane the lane
+     * @return the entry with the greatest offset on the lane; nullptr if the lane is empty
+     */
+    const Entry* last(const Lane* lane) const
+    {
+        std::pair<const_iterator, const_iterator> range = onLane(lane);
+        return range.first != range.second ? &*(range.second - 1) : nullptr;
+    }
+
+private:
+    static bool entryLessOffset(const Entry& entry, double offset)
+    {
+        return entry.offset < offset;
+    }
+
+    static bool offsetLessEntry(double offset, const Entry& entry)
+    {
+        return offset < entry.offset;
+    }
+
+    /** indexed objects, sorted by lane and by offset */
+    std::vector<Entry> entries;
+
+    /** range [first, last) of the entries of each lane */
+    std::unordered_map<const Lane*, std::pair<std::size_t, std::size_t> > laneRanges;
+};
+
+}
@@ -0,0 +1,175 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace sim_mob
+{
+
+/**
+ * R-tree over the locations of a changing set of objects.
+ *
+ * Unlike GeneralR_TreeManager, which bulk loads a fixed set of objects, objects are inserted, moved and removed one
+ * at a time, so the tree can be kept up to date with a set that changes during the simulation (e.g. the drivers
+ * available to a controller). Query results are sorted by increasing distance (ties in no particular order).
+ *
+ * Not thread safe.
+ */
+template<typename T>
+class PointR_Tree
+{
+public:
+    /**
+     * Inserts an object, or moves it if it is already in the tree
+     * @param object the object
+     * @param x x coordinate of its location
+     * @param y y coordinate of its location
+     */
+    void insert(const T* object, double x, double y)
+    {
+        const Point location(x, y);
+        auto itr = locations.find(object);
+        if (itr != locations.end())
+        {
+            if (bg::equals(itr->second, location))
+            {
+                return;
+            }
+            rTree.remove(Value(itr->second, object));
+            itr->second = location;
+        }
+        else
+        {
+            locations.emplace(object, location);
+        }
+        rTree.insert(Value(location, object));
+    }
+
+    /**
+     * Removes an object; does nothing if it is not in the tree
+     * @param object the object
+     */
+    void erase(const T* object)
+    {
+        auto itr = locations.find(object);
+        if (itr != locations.end())
+        {
+            rTree.remove(Value(itr->second, object));
+            locations.erase(itr);
+        }
+    }
+
+    bool contains(const T* object) const
+    {
+        return locations.find(object) != locations.end();
+    }
+
+    std::size_t size() const
+    {
+        return locations.size();
+    }
+
+    bool empty() const
+    {
+        return locations.empty();
+    }
+
+    void clear()
+    {
+        rTree.clear();
+        locations.clear();
+    }
+
+    /**
+     * Finds the objects closest to a location which satisfy a predicate
+     * @param x x coordinate of the location
+     * @param y y coordinate of the location
+     * @param k maximum number of objects to find
+     * @param predicate unary predicate on const T*; objects for which it is false are skipped
+     * @param result output objects, closest first
+     */
+    template<typename Predicate>
+    void nearest(double x, double y, unsigned int k, Predicate predicate, std::vector<const T*>& result) const
+    {
+        result.clear();
+        if (k == 0)
+        {
+            return;
+        }
+        const Point location(x, y);
+        std::vector<Value> values;
+        rTree.query(bgi::nearest(location, k) && bgi::satisfies([&predicate](const Value& value)
+                { return predicate(value.second); }), std::back_inserter(values));
+        sortByDistance(location, values, result);
+    }
+
+    /**
+     * Finds the objects closest to a location
+     * @param x x coordinate of the location
+     * @param y y coordinate of the location
+     * @param k maximum number of objects to find
+     * @param result output objects, closest first
+     */
+    void nearest(double x, double y, unsigned int k, std::vector<const T*>& result) const
+    {
+        nearest(x, y, k, [](const T*) { return true; }, result);
+    }
+
+    /**
+     * Finds the objects within a distance of a location
+     * @param x x coordinate of the location
+     * @param y y coordinate of the location
+     * @param radius maximum (Euclidean) distance
+     * @param result output objects, closest first
+     */
+    void withinRadius(double x, double y, double radius, std::vector<const T*>& result) const
+    {
+        result.clear();
+        const Point location(x, y);
+        const Box box(Point(x - radius, y - radius), Point(x + radius, y + radius));
+        std::vector<Value> values;
+        rTree.query(bgi::intersects(box) && bgi::satisfies([&location, radius](const Value& value)
+                { return bg::comparable_distance(location, value.first) <= radius * radius; }),
+                std::back_inserter(values));
+        sortByDistance(location, values, result);
+    }
+
+private:
+    typedef bg::model::point<double, 2, bg::cs::cartesian> Point;
+    typedef bg::model::box<Point> Box;
+    typedef std::pair<Point, const T*> Value;
+
+    static void sortByDistance(const Point& location, std::vector<Value>& values, std::vector<const T*>& result)
+    {
+        std::sort(values.begin(), values.end(), [&location](const Value& first, const Value& second)
+        {
+            return bg::comparable_distance(location, first.first) < bg::comparable_distance(location, second.first);
+        });
+        result.reserve(values.size());
+        for (const Value& value : values)
+        {
+            result.push_back(value.second);
+        }
+    }
+
+    /** rtree of the object locations */
+    bgi::rtree<Value, bgi::rstar<16> > rTree;
+
+    /** current location of each object, needed to remove it from the tree */
+    std::unordered_map<const T*, Point> locations;
+};
+
+}
@@ -0,0 +1,136 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "STR_AuraManager.hpp"
+
+#include <algorithm>
+#include <boost/thread.hpp>
+
+#include "spatial_trees/shared_funcs.hpp"
+
+using namespace sim_mob;
+using namespace sim_mob::spatial;
+
+namespace
+{
+/**Below this number of agents, the update is done by a single thread*/
+const std::size_t MIN_AGENTS_PER_THREAD = 10000;
+}
+
+STR_AuraManager::STR_AuraManager() : numThreads(std::max(1u, boost::thread::hardware_concurrency()))
+{
+}
+
+STR_AuraManager::~STR_AuraManager()
+{
+}
+
+void STR_AuraManager::collectAgents(std::size_t first, std::size_t last, const std::set<sim_mob::Entity *> &removedAgentPointers,
+                                    std::vector<Entry> &result) const
+{
+    result.clear();
+    for (std::size_t i = first; i < last; i++)
+    {
+        Agent *agent = dynamic_cast<Agent *> (agents[i]);
+        if ((!agent) || agent->isNonspatial())
+        {
+            continue;
+        }
+
+        if (removedAgentPointers.find(agent) == removedAgentPointers.end())
+        {
+            result.push_back(Entry(agent->xPos.get(), agent->yPos.get(), agent));
+        }
+    }
+}
+
+void STR_AuraManager::update(int time_step, const std::set<sim_mob::Entity *> &removedAgentPointers)
+{
+    agents.assign(Agent::all_agents.begin(), Agent::all_agents.end());
+    const unsigned int threadsUsed = std::max<std::size_t>(1, std::min<std::size_t>(numThreads, agents.size() / MIN_AGENTS_PER_THREAD));
+
+    collectedEntries.resize(threadsUsed);
+    if (threadsUsed == 1)
+    {
+        collectAgents(0, agents.size(), removedAgentPointers, collectedEntries[0]);
+    }
+    else
+    {
+        boost::thread_group collectors;
+        for (unsigned int i = 0; i < threadsUsed; i++)
+        {
+            const std::size_t first = (agents.size() * i) / threadsUsed;
+            const std::size_t last = (agents.size() * (i + 1)) / threadsUsed;
+            std::vector<Entry> &result = collectedEntries[i];
+            collectors.create_thread([this, first, last, &removedAgentPointers, &result]()
+            {
+                collectAgents(first, last, removedAgentPointers, result);
+            });
+        }
+        collectors.join_all();
+    }
+
+    entries.clear();
+    for (const std::vector<Entry> &collected : collectedEntries)
+    {
+        entries.insert(entries.end(), collected.begin(), collected.end());
+    }
+    tree.build(entries, threadsUsed);
+}
+
+std::vector<Agent const *> STR_AuraManager::agentsInRect(const Point &lowerLeft, const Point &upperRight, const sim_mob::Agent *refAgent) const
+{
+    std::vector<Agent const *> agentsInRectangle;
+    tree.query(lowerLeft.getX(), lowerLeft.getY(), upperRight.getX(), upperRight.getY(), agentsInRectangle);
+    return agentsInRectangle;
+}
+
+std::vector<Agent const *> STR_AuraManager::nearbyAgents(const Point &position, const WayPoint &wayPoint, double distanceInFront, double distanceBehind,
+                                                         const sim_mob::Agent *refAgent) const
+{
+    // Find the stretch of the poly-line that <position> is in.
+    std::vector<PolyPoint> points;
+
+    if(wayPoint.type == WayPoint::LANE)
+    {
+        points = wayPoint.lane->getPolyLine()->getPoints();
+    }
+    else
+    {
+        points = wayPoint.turningPath->getPolyLine()->getPoints();
+    }
+
+    Point p1, p2;
+    for (size_t index = 0; index < points.size() - 1; index++)
+    {
+        p1 = points[index];
+        p2 = points[index + 1];
+        if (isInBetween(position, p1, p2))
+        {
+            break;
+        }
+    }
+
+    // Adjust <p1> and <p2>.  The current approach is simplistic.  <distanceInFront> and
+    // <distanceBehind> may extend beyond the stretch marked out by <p1> and <p2>.
+    adjust(p1, p2, position, distanceInFront, distanceBehind);
+
+    // Calculate the search rectangle.  We use a quick and accurate method.  However the
+    // inaccuracy only makes the search rectangle bigger.
+    double left = std::min(p1.getX(), p2.getX());
+    double right = std::max(p1.getX(), p2.getX());
+    double bottom = std::min(p1.getY(), p2.getY());
+    double top = std::max(p1.getY(), p2.getY());
+
+    double halfWidth = getAdjacentPathWidth(wayPoint) / 2;
+    left -= halfWidth;
+    right += halfWidth;
+    top += halfWidth;
+    bottom -= halfWidth;
+
+    Point lowerLeft(left, bottom);
+    Point upperRight(right, top);
+
+    return agentsInRect(lowerLeft, upperRight, nullptr);
+}
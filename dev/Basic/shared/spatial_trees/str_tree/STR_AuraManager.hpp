@@ -0,0 +1,92 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include "entities/Agent.hpp"
+#include "spatial_trees/TreeImpl.hpp"
+#include "STR_Tree.hpp"
+
+namespace sim_mob
+{
+
+/**
+ * Aura manager which rebuilds a packed r-tree (STR_Tree) of all agents every tick, using several threads.
+ *
+ * Like PackingTreeAuraManager, the tree is bulk loaded instead of being built by inserting the agents one at a time.
+ * In addition, the agents are filtered (non-spatial and removed agents) and the tree is packed in parallel, so that
+ * the workers waiting at the aura manager barrier do not wait on a single thread.
+ */
+class STR_AuraManager : public TreeImpl
+{
+public:
+    STR_AuraManager();
+    virtual ~STR_AuraManager();
+
+    /**
+     * Rebuilds the tree from the positions of all agents in the simulation.
+     *
+     * @param time_step simulation time_step
+     * @param removedAgentPointers agents to leave out
+     *
+     * The pointers in removedAgentPointers will be deleted after this time tick; do *not* save them anywhere.
+     */
+    virtual void update(int time_step, const std::set<sim_mob::Entity *> &removedAgentPointers);
+
+    /**
+     * Return a collection of agents that are located in the axially-aligned rectangle.
+     *
+     * @param lowerLeft The lower left corner of the axially-aligned search rectangle.
+     * @param upperRight The upper right corner of the axially-aligned search rectangle.
+     * @param refAgent Not used by this implementation.
+     *
+     * @return a collection of agents
+     * The caller is responsible to determine the "type" of each agent in the returned array.
+     */
+    virtual std::vector<Agent const *> agentsInRect(const Point &lowerLeft, const Point &upperRight, const sim_mob::Agent *refAgent) const;
+
+    /**
+     * Return a collection of agents that are on the left, right, front, and back of the specified
+     * position.
+     *
+     * @param position The center of the search rectangle.
+     * @param wayPoint The wapypoint (lane or turning path)
+     * @param distanceInFront The forward distance of the search rectangle.
+     * @param distanceBehind The backward distance of the search rectangle
+     * @param refAgent Not used by this implementation.
+     *
+     * @return a collection of agents
+     */
+    virtual std::vector<Agent const *> nearbyAgents(const Point &position, const WayPoint &wayPoint, double distanceInFront, double distanceBehind,
+                                                    const sim_mob::Agent *refAgent) const;
+
+private:
+    typedef STR_Tree<Agent>::Entry Entry;
+
+    /**
+     * collects the spatial agents of agents[first, last) which are not about to be removed
+     * @param first index of the first agent
+     * @param last index past the last agent
+     * @param removedAgentPointers agents to leave out
+     * @param result output entries
+     */
+    void collectAgents(std::size_t first, std::size_t last, const std::set<sim_mob::Entity *> &removedAgentPointers,
+                       std::vector<Entry> &result) const;
+
+    /**The packed r-tree*/
+    STR_Tree<Agent> tree;
+
+    /**Number of threads used to rebuild the tree*/
+    unsigned int numThreads;
+
+    /**Scratch space for the update, kept to avoid reallocating every tick*/
+    std::vector<Entity *> agents;
+    std::vector<std::vector<Entry> > collectedEntries;
+    std::vector<Entry> entries;
+};
+
+}
@@ -0,0 +1,383 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <boost/thread.hpp>
+
+namespace sim_mob
+{
+
+/**
+ * Static R-tree over point objects, bulk loaded with the Sort-Tile-Recursive (STR) packing algorithm.
+ *
+ * The tree is rebuilt from scratch by build(); it is not updated incrementally. Building the leaf level, which holds
+ * almost all of the work, is split across threads: the points are sorted by x in parallel, cut into vertical slabs
+ * and each slab is sorted by y and packed into leaves by one thread. The (much smaller) upper levels are packed
+ * serially the same way.
+ *
+ * Queries are read only and may run concurrently with each other, but not with build().
+ */
+template<typename T>
+class STR_Tree
+{
+public:
+    /** an object and its location */
+    struct Entry
+    {
+        Entry() : x(0), y(0), object(nullptr)
+        {
+        }
+
+        Entry(double x, double y, const T* object) : x(x), y(y), object(object)
+        {
+        }
+
+        double x;
+        double y;
+        const T* object;
+    };
+
+    /**
+     * @param nodeCapacity maximum number of children of a node; values below 2 are treated as 2
+     */
+    explicit STR_Tree(std::size_t nodeCapacity = 16) : nodeCapacity(std::max<std::size_t>(nodeCapacity, 2)), numLeaves(0)
+    {
+    }
+
+    /**
+     * Rebuilds the tree
+     * @param newEntries objects to index; swapped into the tree, so that the vector holds the previous entries
+     *        (in no particular order) on return and its storage can be reused by the caller
+     * @param numThreads number of threads used to build the leaf level
+     */
+    void build(std::vector<Entry>& newEntries, unsigned int numThreads)
+    {
+        entries.swap(newEntries);
+        nodes.clear();
+        numLeaves = 0;
+        if (entries.empty())
+        {
+            return;
+        }
+
+        numThreads = std::max(1u, numThreads);
+        numLeaves = packEntries(numThreads);
+
+        std::size_t levelStart = 0;
+        std::size_t levelEnd = nodes.size();
+        while (levelEnd - levelStart > 1)
+        {
+            packNodes(levelStart, levelEnd);
+            levelStart = levelEnd;
+            levelEnd = nodes.size();
+        }
+    }
+
+    void clear()
+    {
+        entries.clear();
+        nodes.clear();
+        numLeaves = 0;
+    }
+
+    std::size_t size() const
+    {
+        return entries.size();
+    }
+
+    bool empty() const
+    {
+        return entries.empty();
+    }
+
+    /**
+     * Finds the objects within an axis aligned rectangle (bounds included)
+     * @param minX lower bound of x
+     * @param minY lower bound of y
+     * @param maxX upper bound of x
+     * @param maxY upper bound of y
+     * @param result output objects, in no particular order; appended to
+     */
+    void query(double minX, double minY, double maxX, double maxY, std::vector<const T*>& result) const
+    {
+        if (nodes.empty())
+        {
+            return;
+        }
+        const Box queryBox(minX, minY, maxX, maxY);
+        std::vector<std::size_t> pending(1, nodes.size() - 1);
+        while (!pending.empty())
+        {
+            const Node& node = nodes[pending.back()];
+            const bool isLeaf = pending.back() < numLeaves;
+            pending.pop_back();
+            if (!node.box.intersects(queryBox))
+            {
+                continue;
+            }
+            if (isLeaf)
+            {
+                for (std::size_t i = node.first; i < node.last; i++)
+                {
+                    if (queryBox.contains(entries[i].x, entries[i].y))
+                    {
+                        result.push_back(entries[i].object);
+                    }
+                }
+            }
+            else
+            {
+                for (std::size_t i = node.first; i < node.last; i++)
+                {
+                    pending.push_back(i);
+                }
+            }
+        }
+    }
+
+private:
+    struct Box
+    {
+        Box() : minX(std::numeric_limits<double>::max()), minY(std::numeric_limits<double>::max()),
+                maxX(-std::numeric_limits<double>::max()), maxY(-std::numeric_limits<double>::max())
+        {
+        }
+
+        Box(double minX, double minY, double maxX, double maxY) : minX(minX), minY(minY), maxX(maxX), maxY(maxY)
+        {
+        }
+
+        void expand(double x, double y)
+        {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+        }
+
+        void expand(const Box& other)
+        {
+            minX = std::min(minX, other.minX);
+            minY = std::min(minY, other.minY);
+            maxX = std::max(maxX, other.maxX);
+            maxY = std::max(maxY, other.maxY);
+        }
+
+        bool intersects(const Box& other) const
+        {
+            return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+        }
+
+        bool contains(double x, double y) const
+        {
+            return minX <= x && x <= maxX && minY <= y && y <= maxY;
+        }
+
+        double centreX() const
+        {
+            return (minX + maxX) / 2;
+        }
+
+        double centreY() const
+        {
+            return (minY + maxY) / 2;
+        }
+
+        double minX;
+        double minY;
+        double maxX;
+        double maxY;
+    };
+
+    /** node of the tree; children are entries (leaves) or nodes of the level below, indexed [first, last) */
+    struct Node
+    {
+        Box box;
+        std::size_t first;
+        std::size_t last;
+    };
+
+    static bool entryLessX(const Entry& first, const Entry& second)
+    {
+        return first.x < second.x;
+    }
+
+    static bool entryLessY(const Entry& first, const Entry& second)
+    {
+        return first.y < second.y;
+    }
+
+    static bool nodeLessX(const Node& first, const Node& second)
+    {
+        return first.box.centreX() < second.box.centreX();
+    }
+
+    static bool nodeLessY(const Node& first, const Node& second)
+    {
+        return first.box.centreY() < second.box.centreY();
+    }
+
+    /**
+     * @param numItems number of items to pack
+     * @return number of items per vertical slab; a multiple of the node capacity
+     */
+    std::size_t getSlabSize(std::size_t numItems) const
+    {
+        const std::size_t numParents = (numItems + nodeCapacity - 1) / nodeCapacity;
+        const std::size_t numSlabs = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(numParents))));
+        return ((numParents + numSlabs - 1) / numSlabs) * nodeCapacity;
+    }
+
+    /**
+     * sorts a range with several threads: the sub-ranges of the threads are sorted, then merged pairwise
+     */
+    template<typename Iterator, typename Compare>
+    static void parallelSort(Iterator begin, Iterator end, Compare compare, unsigned int numThreads)
+    {
+        const std::size_t size = end - begin;
+        if (numThreads <= 1 || size < 2 * numThreads)
+        {
+            std::sort(begin, end, compare);
+            return;
+        }
+
+        std::vector<Iterator> bounds;
+        for (unsigned int i = 0; i <= numThreads; i++)
+        {
+            bounds.push_back(begin + (size * i) / numThreads);
+        }
+
+        boost::thread_group sorters;
+        for (unsigned int i = 0; i < numThreads; i++)
+        {
+            const Iterator first = bounds[i];
+            const Iterator last = bounds[i + 1];
+            sorters.create_thread([first, last, compare]() { std::sort(first, last, compare); });
+        }
+        sorters.join_all();
+
+        while (bounds.size() > 2)
+        {
+            std::vector<Iterator> merged;
+            boost::thread_group mergers;
+            std::size_t i = 0;
+            for (; i + 2 < bounds.size(); i += 2)
+            {
+                const Iterator first = bounds[i];
+                const Iterator middle = bounds[i + 1];
+                const Iterator last = bounds[i + 2];
+                mergers.create_thread([first, middle, last, compare]() { std::inplace_merge(first, middle, last, compare); });
+                merged.push_back(bounds[i]);
+            }
+            mergers.join_all();
+            for (; i < bounds.size(); i++)
+            {
+                merged.push_back(bounds[i]);
+            }
+            bounds.swap(merged);
+        }
+    }
+
+    /**
+     * sorts the entries of the slabs numbered threadIndex, threadIndex + numThreads, ... by y and packs them into leaves
+     */
+    void packSlabs(std::size_t slabSize, unsigned int threadIndex, unsigned int numThreads)
+    {
+        const std::size_t numSlabs = (entries.size() + slabSize - 1) / slabSize;
+        for (std::size_t slab = threadIndex; slab < numSlabs; slab += numThreads)
+        {
+            const std::size_t slabStart = slab * slabSize;
+            const std::size_t slabEnd = std::min(entries.size(), slabStart + slabSize);
+            std::sort(entries.begin() + slabStart, entries.begin() + slabEnd, entryLessY);
+
+            std::size_t leafIndex = slabStart / nodeCapacity;
+            for (std::size_t first = slabStart; first < slabEnd; first += nodeCapacity, leafIndex++)
+            {
+                Node& leaf = nodes[leafIndex];
+                leaf.box = Box();
+                leaf.first = first;
+                leaf.last = std::min(slabEnd, first + nodeCapacity);
+                for (std::size_t i = leaf.first; i < leaf.last; i++)
+                {
+                    leaf.box.expand(entries[i].x, entries[i].y);
+                }
+            }
+        }
+    }
+
+    /**
+     * packs all entries into the leaf level
+     * @return number of leaves
+     */
+    std::size_t packEntries(unsigned int numThreads)
+    {
+        parallelSort(entries.begin(), entries.end(), entryLessX, numThreads);
+
+        // slabs hold a multiple of the node capacity, so every slab fills its own, contiguous range of leaves
+        const std::size_t slabSize = getSlabSize(entries.size());
+        const std::size_t leafCount = (entries.size() + nodeCapacity - 1) / nodeCapacity;
+        nodes.resize(leafCount);
+        if (numThreads <= 1)
+        {
+            packSlabs(slabSize, 0, 1);
+        }
+        else
+        {
+            boost::thread_group packers;
+            for (unsigned int i = 0; i < numThreads; i++)
+            {
+                packers.create_thread([this, slabSize, i, numThreads]() { packSlabs(slabSize, i, numThreads); });
+            }
+            packers.join_all();
+        }
+        return leafCount;
+    }
+
+    /**
+     * packs the nodes [levelStart, levelEnd) into parent nodes appended to the node list; reorders the packed nodes
+     */
+    void packNodes(std::size_t levelStart, std::size_t levelEnd)
+    {
+        std::sort(nodes.begin() + levelStart, nodes.begin() + levelEnd, nodeLessX);
+
+        const std::size_t slabSize = getSlabSize(levelEnd - levelStart);
+        std::vector<Node> parents;
+        for (std::size_t slabStart = levelStart; slabStart < levelEnd; slabStart += slabSize)
+        {
+            const std::size_t slabEnd = std::min(levelEnd, slabStart + slabSize);
+            std::sort(nodes.begin() + slabStart, nodes.begin() + slabEnd, nodeLessY);
+            for (std::size_t first = slabStart; first < slabEnd; first += nodeCapacity)
+            {
+                Node parent;
+                parent.first = first;
+                parent.last = std::min(slabEnd, first + nodeCapacity);
+                for (std::size_t i = parent.first; i < parent.last; i++)
+                {
+                    parent.box.expand(nodes[i].box);
+                }
+                parents.push_back(parent);
+            }
+        }
+        nodes.insert(nodes.end(), parents.begin(), parents.end());
+    }
+
+    /** maximum number of children of a node */
+    const std::size_t nodeCapacity;
+
+    /** indexed objects; the entries of each leaf are contiguous */
+    std::vector<Entry> entries;
+
+    /** nodes, level by level from the leaves up; the last node is the root */
+    std::vector<Node> nodes;
+
+    /** number of leaves, which are the first nodes */
+    std::size_t numLeaves;
+};
+
+}
@@ -0,0 +1,143 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "behavioral/TimeDependentTT_Matrix.hpp"
+
+#include "TimeDependentTT_MatrixUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::TimeDependentTT_MatrixUnitTests);
+
+namespace
+{
+
+///Zone codes are deliberately unsorted and sparse.
+std::vector<int> makeZoneCodes()
+{
+    std::vector<int> zoneCodes;
+    zoneCodes.push_back(12);
+    zoneCodes.push_back(3);
+    zoneCodes.push_back(40);
+    zoneCodes.push_back(7);
+    return zoneCodes;
+}
+
+///Travel times which identify the mode, OD and time window.
+TimeDependentTT_Params makeTT(int mode, int origin, int destination)
+{
+    TimeDependentTT_Params ttParams;
+    ttParams.setOriginZone(origin);
+    ttParams.setDestinationZone(destination);
+    ttParams.setInfoUnavailable(origin == 40);
+    for (int i = 0; i < (int) NUM_30MIN_TIME_WINDOWS_IN_DAY; i++)
+    {
+        ttParams.getArrivalBasedTT()[i] = mode * 10000 + origin * 100 + destination + i / 100.0;
+        ttParams.getDepartureBasedTT()[i] = -(mode * 10000 + origin * 100 + destination + i / 100.0);
+    }
+    return ttParams;
+}
+
+void fillMatrix(TimeDependentTT_Matrix& matrix, const std::vector<int>& zoneCodes)
+{
+    for (size_t o = 0; o < zoneCodes.size(); o++)
+    {
+        for (size_t d = 0; d < zoneCodes.size(); d++)
+        {
+            if (o != d)
+            {
+                matrix.setTT(TravelTimeMode::TT_PRIVATE, makeTT(0, zoneCodes[o], zoneCodes[d]));
+                //leave out one OD pair of the public transit mode
+                if (!(zoneCodes[o] == 3 && zoneCodes[d] == 7))
+                {
+                    matrix.setTT(TravelTimeMode::TT_PUBLIC, makeTT(1, zoneCodes[o], zoneCodes[d]));
+                }
+            }
+        }
+    }
+}
+
+///Checks the contents of a matrix filled by fillMatrix.
+void checkMatrix(const TimeDependentTT_Matrix& matrix, const std::vector<int>& zoneCodes)
+{
+    for (size_t o = 0; o < zoneCodes.size(); o++)
+    {
+        for (size_t d = 0; d < zoneCodes.size(); d++)
+        {
+            for (int mode = 0; mode < 2; mode++)
+            {
+                TravelTimeMode ttMode = (mode == 0) ? TravelTimeMode::TT_PRIVATE : TravelTimeMode::TT_PUBLIC;
+                bool expected = (o != d) && !(mode == 1 && zoneCodes[o] == 3 && zoneCodes[d] == 7);
+                TimeDependentTT_Params ttParams;
+                CPPUNIT_ASSERT_EQUAL(expected, matrix.getTT_ByOD(ttMode, zoneCodes[o], zoneCodes[d], ttParams));
+                if (!expected)
+                {
+                    continue;
+                }
+
+                TimeDependentTT_Params expectedTT = makeTT(mode, zoneCodes[o], zoneCodes[d]);
+                CPPUNIT_ASSERT_EQUAL(zoneCodes[o], ttParams.getOriginZone());
+                CPPUNIT_ASSERT_EQUAL(zoneCodes[d], ttParams.getDestinationZone());
+                CPPUNIT_ASSERT_EQUAL(expectedTT.isInfoUnavailable(), ttParams.isInfoUnavailable());
+                for (int i = 0; i < (int) NUM_30MIN_TIME_WINDOWS_IN_DAY; i++)
+                {
+                    CPPUNIT_ASSERT_EQUAL(expectedTT.getArrivalBasedTT_at(i), ttParams.getArrivalBasedTT_at(i));
+                    CPPUNIT_ASSERT_EQUAL(expectedTT.getDepartureBasedTT_at(i), ttParams.getDepartureBasedTT_at(i));
+                }
+            }
+        }
+    }
+}
+
+}
+
+void unit_tests::TimeDependentTT_MatrixUnitTests::test_SetAndGet()
+{
+    std::vector<int> zoneCodes = makeZoneCodes();
+    TimeDependentTT_Matrix matrix;
+    CPPUNIT_ASSERT_MESSAGE("Matrix loaded before initialization.", !matrix.isLoaded());
+
+    matrix.initialize(zoneCodes, 1);
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, matrix.getNumZones());
+    fillMatrix(matrix, zoneCodes);
+    checkMatrix(matrix, zoneCodes);
+
+    TimeDependentTT_Params ttParams;
+    CPPUNIT_ASSERT_MESSAGE("Travel times stored for an unknown zone.", !matrix.setTT(TravelTimeMode::TT_PRIVATE, makeTT(0, 5, 3)));
+    CPPUNIT_ASSERT_MESSAGE("Travel times found for an unknown zone.", !matrix.getTT_ByOD(TravelTimeMode::TT_PRIVATE, 3, 41, ttParams));
+    CPPUNIT_ASSERT_MESSAGE("Travel times found for a negative zone.", !matrix.getTT_ByOD(TravelTimeMode::TT_PRIVATE, -1, 3, ttParams));
+}
+
+void unit_tests::TimeDependentTT_MatrixUnitTests::test_SaveAndLoad()
+{
+    std::vector<int> zoneCodes = makeZoneCodes();
+    const std::string fileName = "tt_matrix_unit_test.bin";
+
+    TimeDependentTT_Matrix built;
+    built.initialize(zoneCodes, 1);
+    fillMatrix(built, zoneCodes);
+    CPPUNIT_ASSERT_MESSAGE("Saving the matrix failed.", built.save(fileName));
+
+    //zones may be given in any order
+    std::vector<int> reordered(zoneCodes.rbegin(), zoneCodes.rend());
+    TimeDependentTT_Matrix loaded;
+    CPPUNIT_ASSERT_MESSAGE("Loading the matrix failed.", loaded.load(fileName, reordered, 1));
+    CPPUNIT_ASSERT_MESSAGE("Loaded matrix is not mapped.", loaded.isMapped());
+    CPPUNIT_ASSERT_EQUAL(built.getStorageSize(), loaded.getStorageSize());
+    checkMatrix(loaded, zoneCodes);
+
+    TimeDependentTT_Matrix stale;
+    CPPUNIT_ASSERT_MESSAGE("Matrix loaded for another data source.", !stale.load(fileName, zoneCodes, 2));
+    CPPUNIT_ASSERT_MESSAGE("Rejected matrix is loaded.", !stale.isLoaded());
+    std::vector<int> otherZones(zoneCodes);
+    otherZones[0] = 13;
+    CPPUNIT_ASSERT_MESSAGE("Matrix loaded for other zones.", !stale.load(fileName, otherZones, 1));
+
+    loaded.clear();
+    std::remove(fileName.c_str());
+}
@@ -0,0 +1,32 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the in-memory time dependent travel time matrix.
+ */
+class TimeDependentTT_MatrixUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that stored travel times are returned per mode and OD, and unknown ODs are reported.
+    void test_SetAndGet();
+
+    ///Test that a saved matrix is memory-mapped with identical contents, and rejected for other zones or sources.
+    void test_SaveAndLoad();
+
+private:
+    CPPUNIT_TEST_SUITE(TimeDependentTT_MatrixUnitTests);
+        CPPUNIT_TEST(test_SetAndGet);
+        CPPUNIT_TEST(test_SaveAndLoad);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
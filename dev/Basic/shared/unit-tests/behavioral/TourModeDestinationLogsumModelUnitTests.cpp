@@ -0,0 +1,148 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "behavioral/TourModeDestinationLogsumModel.hpp"
+
+#include "TourModeDestinationLogsumModelUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::TourModeDestinationLogsumModelUnitTests);
+
+namespace
+{
+const int NUM_ZONES = 3;
+
+///Script declaring all coefficients of a model as 0, except the given ones; one coefficient may be left out.
+std::string makeScript(const std::string& modelName, const std::map<std::string, double>& values,
+        const std::string& leftOut = std::string())
+{
+    std::vector<std::string> names;
+    TourModeDestinationLogsumModel::getCoefficientNames(modelName, names);
+    std::ostringstream script;
+    script << "--header comment\n";
+    for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); it++)
+    {
+        if (*it == leftOut)
+        {
+            continue;
+        }
+        std::map<std::string, double>::const_iterator value = values.find(*it);
+        script << "local " << *it << " = " << (value == values.end() ? 0 : value->second) << "\n";
+    }
+    return script.str();
+}
+
+///All choices available; distances and sizes which keep every utility finite.
+void makeInputs(TourModeDestinationInputs& inputs)
+{
+    inputs.resize(NUM_ZONES, TourModeDestinationLogsumModel::NUM_MODES);
+    for (int z = 0; z < NUM_ZONES; z++)
+    {
+        inputs.walkDistanceFirst[z] = inputs.walkDistanceSecond[z] = 1 + z;
+        inputs.area[z] = inputs.population[z] = inputs.shop[z] = 1;
+    }
+    inputs.availability.assign(inputs.availability.size(), 1);
+    inputs.prepare();
+}
+}
+
+void unit_tests::TourModeDestinationLogsumModelUnitTests::test_ParseCoefficients()
+{
+    std::istringstream script("local beta_a = -1.5\n"
+            "  local beta_b = - 1.7 -- signed with a blank\n"
+            "local beta_c = beta_a * 2\n"
+            "local beta_d=3\n"
+            "local scale = 1\n"
+            "beta_e = 4\n"
+            "local beta_a = 2.5\n");
+    std::map<std::string, double> coefficients;
+    TourModeDestinationLogsumModel::parseCoefficients(script, coefficients);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), coefficients.size());
+    CPPUNIT_ASSERT_EQUAL(2.5, coefficients["beta_a"]);
+    CPPUNIT_ASSERT_EQUAL(-1.7, coefficients["beta_b"]);
+    CPPUNIT_ASSERT_EQUAL(3.0, coefficients["beta_d"]);
+}
+
+void unit_tests::TourModeDestinationLogsumModelUnitTests::test_Load()
+{
+    CPPUNIT_ASSERT(TourModeDestinationLogsumModel::isSupported("tmds"));
+    CPPUNIT_ASSERT(TourModeDestinationLogsumModel::isSupported("tmdo"));
+    CPPUNIT_ASSERT(!TourModeDestinationLogsumModel::isSupported("tmdw"));
+
+    TourModeDestinationLogsumModel model;
+    CPPUNIT_ASSERT(!model.isEnabled());
+
+    std::istringstream unsupported(makeScript("tmds", std::map<std::string, double>()));
+    CPPUNIT_ASSERT(!model.load("tmdw", unsupported, 0, 1e-6));
+
+    std::istringstream incomplete(makeScript("tmds", std::map<std::string, double>(), "beta_tt_walk"));
+    CPPUNIT_ASSERT(!model.load("tmds", incomplete, 0, 1e-6));
+    CPPUNIT_ASSERT(!model.isEnabled());
+
+    std::istringstream complete(makeScript("tmds", std::map<std::string, double>()));
+    CPPUNIT_ASSERT(model.load("tmds", complete, 0, 1e-6));
+    CPPUNIT_ASSERT(model.isEnabled());
+    CPPUNIT_ASSERT_EQUAL(std::string("tmds"), model.getModelName());
+}
+
+void unit_tests::TourModeDestinationLogsumModelUnitTests::test_ComputeLogsum()
+{
+    const int numChoices = NUM_ZONES * TourModeDestinationLogsumModel::NUM_MODES;
+    std::map<std::string, double> values;
+    values["beta_cons_walk"] = 1;
+    values["beta_female_walk"] = 0.5;
+    values["beta_zero_bus"] = -1;
+    std::istringstream script(makeScript("tmds", values));
+    TourModeDestinationLogsumModel model;
+    CPPUNIT_ASSERT(model.load("tmds", script, 0, 1e-6));
+
+    TourModeDestinationInputs inputs;
+    makeInputs(inputs);
+    double logsum = 0;
+
+    //male with a car: walk utilities are 1, all others 0
+    CPPUNIT_ASSERT(model.computeLogsum(1, 0, 3, inputs, logsum));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::log((numChoices - NUM_ZONES) + NUM_ZONES * std::exp(1.0)), logsum, 1e-12);
+
+    //female without a car: walk utilities are 1.5 and bus utilities -1
+    CPPUNIT_ASSERT(model.computeLogsum(1, 1, 0, inputs, logsum));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::log((numChoices - 2 * NUM_ZONES) + NUM_ZONES * std::exp(1.5)
+            + NUM_ZONES * std::exp(-1.0)), logsum, 1e-12);
+
+    //unavailable choices (walk to zone 1) and undefined utilities (all modes to zone 2) do not count
+    inputs.availability[7 * NUM_ZONES + 0] = 0;
+    inputs.area[1] = std::numeric_limits<double>::quiet_NaN();
+    inputs.prepare();
+    CPPUNIT_ASSERT(model.computeLogsum(1, 0, 3, inputs, logsum));
+    const int numChoicesLeft = numChoices - TourModeDestinationLogsumModel::NUM_MODES - 1;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::log((numChoicesLeft - 1) + std::exp(1.0)), logsum, 1e-12);
+
+    //income ids outside the income categories of the script are left to the script
+    CPPUNIT_ASSERT(!model.computeLogsum(15, 0, 3, inputs, logsum));
+}
+
+void unit_tests::TourModeDestinationLogsumModelUnitTests::test_Validate()
+{
+    std::istringstream script(makeScript("tmdo", std::map<std::string, double>()));
+    TourModeDestinationLogsumModel model;
+    CPPUNIT_ASSERT(model.load("tmdo", script, 2, 1e-6));
+
+    CPPUNIT_ASSERT(model.claimValidationSample());
+    CPPUNIT_ASSERT(model.validate(1.0, 1.0 + 1e-9, 1, 1));
+    CPPUNIT_ASSERT(model.claimValidationSample());
+    CPPUNIT_ASSERT(!model.claimValidationSample());
+    CPPUNIT_ASSERT(model.isEnabled());
+
+    CPPUNIT_ASSERT(!model.validate(1.0, 1.1, 1, 1));
+    CPPUNIT_ASSERT(!model.isEnabled());
+}
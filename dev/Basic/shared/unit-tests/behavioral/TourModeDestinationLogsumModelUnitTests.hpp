@@ -0,0 +1,40 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the compiled tour mode/destination logsum model.
+ */
+class TourModeDestinationLogsumModelUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that numeric beta declarations are read from a script and other declarations are ignored.
+    void test_ParseCoefficients();
+
+    ///Test that a model is only loaded if it is supported and all of its coefficients are in the script.
+    void test_Load();
+
+    ///Test the logsum against values computed by hand, including unavailable and undefined choices.
+    void test_ComputeLogsum();
+
+    ///Test that a mismatch with the reference logsum disables the model.
+    void test_Validate();
+
+private:
+    CPPUNIT_TEST_SUITE(TourModeDestinationLogsumModelUnitTests);
+        CPPUNIT_TEST(test_ParseCoefficients);
+        CPPUNIT_TEST(test_Load);
+        CPPUNIT_TEST(test_ComputeLogsum);
+        CPPUNIT_TEST(test_Validate);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,210 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+#include <boost/random.hpp>
+
+#include "geospatial/streetdir/ContractionHierarchy.hpp"
+
+#include "ContractionHierarchyUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::ContractionHierarchyUnitTests);
+
+namespace
+{
+
+typedef std::vector<ContractionHierarchy::InputArc> ArcList;
+
+const double INF = std::numeric_limits<double>::infinity();
+
+///Plain Dijkstra search, skipping the blocked arcs.
+double dijkstra(unsigned int numVertices, const ArcList& arcs, const std::set<unsigned int>& blocked, unsigned int source,
+        unsigned int target)
+{
+    std::vector< std::vector<unsigned int> > outArcs(numVertices);
+    for (unsigned int id = 0; id < arcs.size(); id++)
+    {
+        if (blocked.find(id) == blocked.end())
+        {
+            outArcs[arcs[id].source].push_back(id);
+        }
+    }
+
+    typedef std::pair<double, unsigned int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+    std::vector<double> dist(numVertices, INF);
+    dist[source] = 0;
+    queue.push(Entry(0, source));
+    while (!queue.empty())
+    {
+        Entry top = queue.top();
+        queue.pop();
+        if (top.first > dist[top.second])
+        {
+            continue;
+        }
+        for (std::vector<unsigned int>::const_iterator it = outArcs[top.second].begin(); it != outArcs[top.second].end(); it++)
+        {
+            const ContractionHierarchy::InputArc& arc = arcs[*it];
+            if (top.first + arc.weight < dist[arc.target])
+            {
+                dist[arc.target] = top.first + arc.weight;
+                queue.push(Entry(dist[arc.target], arc.target));
+            }
+        }
+    }
+    return dist[target];
+}
+
+///Checks that a path leads from source to target, avoids the blocked arcs, and has the given length.
+bool isValidPath(const ArcList& arcs, const std::vector<unsigned int>& path, const std::set<unsigned int>& blocked,
+        unsigned int source, unsigned int target, double length)
+{
+    unsigned int vertex = source;
+    double sum = 0;
+    for (std::vector<unsigned int>::const_iterator it = path.begin(); it != path.end(); it++)
+    {
+        if (*it >= arcs.size() || arcs[*it].source != vertex || blocked.find(*it) != blocked.end())
+        {
+            return false;
+        }
+        vertex = arcs[*it].target;
+        sum += arcs[*it].weight;
+    }
+    return vertex == target && std::fabs(sum - length) < 1e-9;
+}
+
+///Compares all (or a sample of) the queries against Dijkstra.
+void checkQueries(unsigned int numVertices, const ArcList& arcs, const ContractionHierarchy& ch, const std::set<unsigned int>& blocked)
+{
+    std::vector<unsigned int> blockedList(blocked.begin(), blocked.end());
+    std::vector<unsigned int> path;
+    for (unsigned int source = 0; source < numVertices; source++)
+    {
+        for (unsigned int target = 0; target < numVertices; target += 3)
+        {
+            double expected = dijkstra(numVertices, arcs, blocked, source, target);
+            double length = blocked.empty() ? ch.query(source, target, path) : ch.query(source, target, blockedList, path);
+            if (expected == INF)
+            {
+                CPPUNIT_ASSERT_MESSAGE("Unreachable target reported as reachable.", length == INF && path.empty());
+            }
+            else
+            {
+                CPPUNIT_ASSERT_MESSAGE("Shortest path length differs from Dijkstra.", std::fabs(length - expected) < 1e-9);
+                CPPUNIT_ASSERT_MESSAGE("Unpacked path is not a valid path.", isValidPath(arcs, path, blocked, source, target, length));
+            }
+        }
+    }
+}
+
+///Grid with arcs in both directions between horizontally and vertically adjacent vertices.
+ArcList makeGrid(unsigned int width, unsigned int height, boost::mt19937& gen)
+{
+    boost::uniform_int<> weightDist(1, 20);
+    ArcList arcs;
+    for (unsigned int y = 0; y < height; y++)
+    {
+        for (unsigned int x = 0; x < width; x++)
+        {
+            unsigned int vertex = y * width + x;
+            if (x + 1 < width)
+            {
+                arcs.push_back(ContractionHierarchy::InputArc(vertex, vertex + 1, weightDist(gen)));
+                arcs.push_back(ContractionHierarchy::InputArc(vertex + 1, vertex, weightDist(gen)));
+            }
+            if (y + 1 < height)
+            {
+                arcs.push_back(ContractionHierarchy::InputArc(vertex, vertex + width, weightDist(gen)));
+                arcs.push_back(ContractionHierarchy::InputArc(vertex + width, vertex, weightDist(gen)));
+            }
+        }
+    }
+    return arcs;
+}
+
+}
+
+void unit_tests::ContractionHierarchyUnitTests::test_GridShortestPaths()
+{
+    boost::mt19937 gen(42);
+    ArcList arcs = makeGrid(12, 10, gen);
+
+    ContractionHierarchy ch;
+    ch.build(120, arcs);
+    checkQueries(120, arcs, ch, std::set<unsigned int>());
+}
+
+void unit_tests::ContractionHierarchyUnitTests::test_RandomGraphShortestPaths()
+{
+    boost::mt19937 gen(7);
+    boost::uniform_int<> vertexDist(0, 89);
+    boost::uniform_real<> weightDist(0.0, 10.0);
+
+    //vertices 90-99 have no arcs
+    ArcList arcs;
+    for (unsigned int i = 0; i < 300; i++)
+    {
+        arcs.push_back(ContractionHierarchy::InputArc(vertexDist(gen), vertexDist(gen), weightDist(gen)));
+    }
+    arcs.push_back(ContractionHierarchy::InputArc(arcs[5].source, arcs[5].target, arcs[5].weight / 2));
+    arcs.push_back(ContractionHierarchy::InputArc(3, 3, 1.0));
+    arcs.push_back(ContractionHierarchy::InputArc(4, 8, 0.0));
+
+    ContractionHierarchy ch;
+    ch.build(100, arcs);
+    checkQueries(100, arcs, ch, std::set<unsigned int>());
+}
+
+void unit_tests::ContractionHierarchyUnitTests::test_BlockedArcs()
+{
+    boost::mt19937 gen(1234);
+    ArcList arcs = makeGrid(8, 8, gen);
+
+    ContractionHierarchy ch;
+    ch.build(64, arcs);
+
+    boost::uniform_int<> arcDist(0, arcs.size() - 1);
+    for (unsigned int round = 0; round < 5; round++)
+    {
+        std::set<unsigned int> blocked;
+        for (unsigned int i = 0; i < 10 * (round + 1); i++)
+        {
+            blocked.insert(arcDist(gen));
+        }
+        checkQueries(64, arcs, ch, blocked);
+    }
+}
+
+void unit_tests::ContractionHierarchyUnitTests::test_SaveAndLoad()
+{
+    boost::mt19937 gen(99);
+    ArcList arcs = makeGrid(6, 7, gen);
+    const std::string fileName = "ch_unit_test.bin";
+
+    ContractionHierarchy built;
+    built.build(42, arcs);
+    CPPUNIT_ASSERT_MESSAGE("Saving the hierarchy failed.", built.save(fileName));
+
+    ContractionHierarchy loaded;
+    CPPUNIT_ASSERT_MESSAGE("Loading the hierarchy failed.", loaded.load(fileName, 42, arcs));
+    CPPUNIT_ASSERT_EQUAL(built.getNumShortcuts(), loaded.getNumShortcuts());
+    checkQueries(42, arcs, loaded, std::set<unsigned int>());
+
+    ArcList changed(arcs);
+    changed[10].weight += 1;
+    ContractionHierarchy stale;
+    CPPUNIT_ASSERT_MESSAGE("Hierarchy loaded for a different graph.", !stale.load(fileName, 42, changed));
+
+    std::remove(fileName.c_str());
+}
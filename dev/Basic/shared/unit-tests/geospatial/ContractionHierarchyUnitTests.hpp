@@ -0,0 +1,41 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the contraction hierarchy used by the shortest path engine.
+ * Paths are compared against a plain Dijkstra search on the input graph.
+ */
+class ContractionHierarchyUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test shortest path lengths, and that the unpacked paths are connected, on a grid with random weights.
+    void test_GridShortestPaths();
+
+    ///Test a sparse random graph with parallel arcs, loops and unreachable vertices.
+    void test_RandomGraphShortestPaths();
+
+    ///Test that paths avoid blocked arcs.
+    void test_BlockedArcs();
+
+    ///Test that a saved hierarchy is only loaded for the graph it was built for.
+    void test_SaveAndLoad();
+
+private:
+    CPPUNIT_TEST_SUITE(ContractionHierarchyUnitTests);
+        CPPUNIT_TEST(test_GridShortestPaths);
+        CPPUNIT_TEST(test_RandomGraphShortestPaths);
+        CPPUNIT_TEST(test_BlockedArcs);
+        CPPUNIT_TEST(test_SaveAndLoad);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
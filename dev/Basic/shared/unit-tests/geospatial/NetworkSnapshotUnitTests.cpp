@@ -0,0 +1,175 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "geospatial/network/NetworkSnapshot.hpp"
+
+#include "NetworkSnapshotUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::NetworkSnapshotUnitTests);
+
+namespace
+{
+
+const std::string FILE_NAME = "network_snapshot_unit_test.bin";
+
+const std::string KEY = "nodes=get_nodes;links=get_links;";
+
+///Saves a snapshot with a few nodes, links and poly-line points.
+void saveSnapshot()
+{
+    NetworkSnapshot snapshot(KEY);
+
+    std::vector<NodeRecord> nodes;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        NodeRecord node = NodeRecord();
+        node.id = 100 + i;
+        node.nodeType = i % 3;
+        node.x = i * 1.5;
+        node.y = -2.25 * i;
+        nodes.push_back(node);
+    }
+    snapshot.setRecords(SNAPSHOT_NODES, nodes);
+
+    std::vector<LinkRecord> links;
+    for (uint32_t i = 0; i < 9; i++)
+    {
+        LinkRecord link = LinkRecord();
+        link.id = i + 1;
+        link.fromNode = 100 + i;
+        link.toNode = 101 + i;
+        link.roadName = snapshot.addString(i % 2 ? "Orchard Road" : "");
+        links.push_back(link);
+    }
+    snapshot.setRecords(SNAPSHOT_LINKS, links);
+
+    //Poly-line tables share a record type
+    std::vector<PolyPointRecord> points(3, PolyPointRecord());
+    points[2].sequenceNumber = 2;
+    snapshot.setRecords(SNAPSHOT_SEGMENT_POLYLINES, points);
+    points.resize(1);
+    snapshot.setRecords(SNAPSHOT_LANE_POLYLINES, points);
+
+    snapshot.save(FILE_NAME);
+}
+
+///@return true if loading the file with the given key fails
+bool loadFails(const std::string& key)
+{
+    NetworkSnapshot snapshot(key);
+    try
+    {
+        snapshot.load(FILE_NAME);
+    }
+    catch (std::runtime_error&)
+    {
+        return !snapshot.isMapped();
+    }
+    return false;
+}
+
+///Overwrites a byte of the file
+void corruptByte(std::streamoff offset)
+{
+    std::fstream file(FILE_NAME.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(offset);
+    char byte = file.get();
+    file.seekp(offset);
+    file.put(byte ^ 0x5a);
+}
+
+}
+
+void unit_tests::NetworkSnapshotUnitTests::test_SaveAndLoad()
+{
+    saveSnapshot();
+
+    NetworkSnapshot snapshot(KEY);
+    snapshot.load(FILE_NAME);
+    CPPUNIT_ASSERT_MESSAGE("Snapshot not mapped.", snapshot.isMapped());
+
+    size_t numNodes = 0;
+    const NodeRecord* nodes = snapshot.getRecords<NodeRecord>(SNAPSHOT_NODES, numNodes);
+    CPPUNIT_ASSERT_EQUAL(size_t(10), numNodes);
+    for (uint32_t i = 0; i < numNodes; i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(100 + i, nodes[i].id);
+        CPPUNIT_ASSERT_EQUAL(i % 3, nodes[i].nodeType);
+        CPPUNIT_ASSERT_EQUAL(i * 1.5, nodes[i].x);
+        CPPUNIT_ASSERT_EQUAL(-2.25 * i, nodes[i].y);
+    }
+
+    size_t numLinks = 0;
+    const LinkRecord* links = snapshot.getRecords<LinkRecord>(SNAPSHOT_LINKS, numLinks);
+    CPPUNIT_ASSERT_EQUAL(size_t(9), numLinks);
+    for (uint32_t i = 0; i < numLinks; i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(101 + i, links[i].toNode);
+        CPPUNIT_ASSERT_EQUAL(std::string(i % 2 ? "Orchard Road" : ""), snapshot.getString(links[i].roadName));
+    }
+
+    size_t numPoints = 0;
+    const PolyPointRecord* points = snapshot.getRecords<PolyPointRecord>(SNAPSHOT_SEGMENT_POLYLINES, numPoints);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), numPoints);
+    CPPUNIT_ASSERT_EQUAL(uint32_t(2), points[2].sequenceNumber);
+    snapshot.getRecords<PolyPointRecord>(SNAPSHOT_LANE_POLYLINES, numPoints);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), numPoints);
+
+    //Missing tables are empty, and records of another size are rejected
+    CPPUNIT_ASSERT(!snapshot.getRecords<LaneRecord>(SNAPSHOT_LANES, numPoints));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), numPoints);
+    CPPUNIT_ASSERT_THROW(snapshot.getRecords<TurningPathRecord>(SNAPSHOT_NODES, numPoints), std::runtime_error);
+
+    std::remove(FILE_NAME.c_str());
+}
+
+void unit_tests::NetworkSnapshotUnitTests::test_KeyMismatch()
+{
+    saveSnapshot();
+
+    CPPUNIT_ASSERT_MESSAGE("Snapshot loaded with another key.", loadFails("nodes=get_nodes;links=get_links_v2;"));
+    CPPUNIT_ASSERT_MESSAGE("Snapshot loaded with an empty key.", loadFails(""));
+    CPPUNIT_ASSERT_MESSAGE("Snapshot not loaded with its key.", !loadFails(KEY));
+
+    std::remove(FILE_NAME.c_str());
+    CPPUNIT_ASSERT_MESSAGE("Missing snapshot loaded.", loadFails(KEY));
+}
+
+void unit_tests::NetworkSnapshotUnitTests::test_CorruptFile()
+{
+    saveSnapshot();
+    std::ifstream file(FILE_NAME.c_str(), std::ios::binary | std::ios::ate);
+    const std::streamoff size = file.tellg();
+    file.close();
+
+    //A byte of the header, of the key, and of the last table
+    const std::streamoff offsets[] = { 0, 8, 40, size - 1 };
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++)
+    {
+        corruptByte(offsets[i]);
+        CPPUNIT_ASSERT_MESSAGE("Corrupt snapshot loaded.", loadFails(KEY));
+        corruptByte(offsets[i]);
+        CPPUNIT_ASSERT_MESSAGE("Restored snapshot not loaded.", !loadFails(KEY));
+    }
+
+    //Truncated file
+    std::vector<char> data(size);
+    std::ifstream in(FILE_NAME.c_str(), std::ios::binary);
+    in.read(data.data(), size);
+    in.close();
+    std::ofstream out(FILE_NAME.c_str(), std::ios::binary | std::ios::trunc);
+    out.write(data.data(), size - 8);
+    out.close();
+    CPPUNIT_ASSERT_MESSAGE("Truncated snapshot loaded.", loadFails(KEY));
+
+    std::remove(FILE_NAME.c_str());
+}
@@ -0,0 +1,36 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the snapshot file of the road network tables.
+ */
+class NetworkSnapshotUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that the records and strings of a saved snapshot are found unchanged once it is mapped.
+    void test_SaveAndLoad();
+
+    ///Test that a snapshot is only loaded with the key it was saved with.
+    void test_KeyMismatch();
+
+    ///Test that truncated and corrupted files are rejected.
+    void test_CorruptFile();
+
+private:
+    CPPUNIT_TEST_SUITE(NetworkSnapshotUnitTests);
+        CPPUNIT_TEST(test_SaveAndLoad);
+        CPPUNIT_TEST(test_KeyMismatch);
+        CPPUNIT_TEST(test_CorruptFile);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,170 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include "logging/AsyncLogSink.hpp"
+
+#include "AsyncLogSinkUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::AsyncLogSinkUnitTests);
+
+namespace
+{
+const int NUM_THREADS = 4;
+const int MESSAGES_PER_THREAD = 20000;
+
+void logMessages(AsyncLogSink* sink, int threadIndex)
+{
+    for (int i = 0; i < MESSAGES_PER_THREAD; i++)
+    {
+        AsyncLogMessage message;
+        *message.begin(sink) << threadIndex << " " << i << "\n";
+    }
+}
+
+/** stream buffer that holds up writes until it is opened, to keep messages pending */
+class GateBuffer : public std::stringbuf
+{
+public:
+    GateBuffer() : isOpen(false)
+    {
+    }
+
+    void open()
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        isOpen = true;
+        opened.notify_all();
+    }
+
+protected:
+    virtual std::streamsize xsputn(const char* s, std::streamsize n)
+    {
+        boost::unique_lock<boost::mutex> lock(mutex);
+        while (!isOpen)
+        {
+            opened.wait(lock);
+        }
+        return std::stringbuf::xsputn(s, n);
+    }
+
+private:
+    boost::mutex mutex;
+    boost::condition_variable opened;
+    bool isOpen;
+};
+}
+
+void unit_tests::AsyncLogSinkUnitTests::test_ThreadOrder()
+{
+    std::ostringstream output;
+    {
+        //a small limit, so that the threads also wait for the background thread
+        AsyncLogSink sink(output, 4096);
+        boost::thread_group threads;
+        for (int i = 0; i < NUM_THREADS; i++)
+        {
+            threads.create_thread(boost::bind(logMessages, &sink, i));
+        }
+        threads.join_all();
+    }
+
+    std::vector<int> nextMessage(NUM_THREADS, 0);
+    std::istringstream input(output.str());
+    std::string line;
+    while (std::getline(input, line))
+    {
+        std::istringstream fields(line);
+        int threadIndex = -1;
+        int message = -1;
+        fields >> threadIndex >> message;
+        CPPUNIT_ASSERT(threadIndex >= 0 && threadIndex < NUM_THREADS);
+        CPPUNIT_ASSERT_EQUAL(nextMessage[threadIndex], message);
+        nextMessage[threadIndex]++;
+    }
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(MESSAGES_PER_THREAD, nextMessage[i]);
+    }
+}
+
+void unit_tests::AsyncLogSinkUnitTests::test_Flush()
+{
+    std::ostringstream output;
+    AsyncLogSink sink(output);
+    std::string expected;
+    for (int i = 0; i < 100; i++)
+    {
+        std::ostringstream text;
+        text << "line " << i << "\n";
+        expected += text.str();
+        std::string message = text.str();
+        CPPUNIT_ASSERT(sink.submit(message));
+    }
+    sink.flush();
+    CPPUNIT_ASSERT_EQUAL(expected, output.str());
+}
+
+void unit_tests::AsyncLogSinkUnitTests::test_DropOnOverflow()
+{
+    GateBuffer buffer;
+    std::ostream output(&buffer);
+    {
+        AsyncLogSink sink(output, 10, AsyncLogSink::DROP_ON_OVERFLOW);
+
+        //the first message fills the limit and stays pending until the gate is opened
+        std::string message("0123456789");
+        CPPUNIT_ASSERT(sink.submit(message));
+        message = "x";
+        CPPUNIT_ASSERT(!sink.submit(message));
+        message = "y";
+        CPPUNIT_ASSERT(!sink.submit(message));
+        CPPUNIT_ASSERT_EQUAL(uint64_t(2), sink.getNumDropped());
+
+        buffer.open();
+        sink.flush();
+
+        //once written, there is room again
+        message = "z";
+        CPPUNIT_ASSERT(sink.submit(message));
+    }
+    CPPUNIT_ASSERT_EQUAL(std::string("0123456789z"), buffer.str());
+}
+
+void unit_tests::AsyncLogSinkUnitTests::test_MessageFormat()
+{
+    std::ostringstream output;
+    {
+        AsyncLogSink sink(output);
+        {
+            AsyncLogMessage message;
+            std::ostream& out = *message.begin(&sink);
+            out << std::hex << std::showbase << 255 << " ";
+            {
+                //a message started while another is being formatted gets its own stream
+                AsyncLogMessage nested;
+                *nested.begin(&sink) << "nested ";
+            }
+            out << 16 << "\n";
+        }
+        {
+            AsyncLogMessage message;
+            *message.begin(&sink) << 255 << "\n";
+        }
+        {
+            //a message without text is not written
+            AsyncLogMessage message;
+            message.begin(&sink);
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(std::string("nested 0xff 0x10\n255\n"), output.str());
+}
@@ -0,0 +1,40 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the asynchronous logging backend.
+ */
+class AsyncLogSinkUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that the messages of several threads are all written, whole and in the order of each thread.
+    void test_ThreadOrder();
+
+    ///Test that flush() waits until the submitted messages have been written.
+    void test_Flush();
+
+    ///Test that messages are dropped and counted once the pending limit is reached.
+    void test_DropOnOverflow();
+
+    ///Test that reused message streams start with default formatting, and that messages may be nested.
+    void test_MessageFormat();
+
+private:
+    CPPUNIT_TEST_SUITE(AsyncLogSinkUnitTests);
+        CPPUNIT_TEST(test_ThreadOrder);
+        CPPUNIT_TEST(test_Flush);
+        CPPUNIT_TEST(test_DropOnOverflow);
+        CPPUNIT_TEST(test_MessageFormat);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,199 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
+
+#include "logging/ColumnarOutput.hpp"
+
+#include "ColumnarOutputUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::ColumnarOutputUnitTests);
+
+namespace
+{
+const int NUM_THREADS = 4;
+const int ROWS_PER_THREAD = 5000;
+
+/** output file of a test, removed at the end of the test */
+struct TempFile
+{
+    TempFile() : path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("columnar-%%%%-%%%%.bin"))
+    {
+    }
+
+    ~TempFile()
+    {
+        boost::system::error_code error;
+        boost::filesystem::remove(path, error);
+    }
+
+    std::string name() const
+    {
+        return path.string();
+    }
+
+    boost::filesystem::path path;
+};
+
+std::vector<ColumnSchema> getColumns()
+{
+    std::vector<ColumnSchema> columns;
+    columns.push_back(ColumnSchema("interval", ColumnSchema::INTEGER));
+    columns.push_back(ColumnSchema("id", ColumnSchema::INTEGER));
+    columns.push_back(ColumnSchema("density", ColumnSchema::REAL, 2));
+    return columns;
+}
+
+void record(ColumnarWriter* writer, int threadIndex)
+{
+    ColumnarBuffer& buffer = writer->getThreadBuffer();
+    for (int i = 0; i < ROWS_PER_THREAD; i++)
+    {
+        buffer << threadIndex << i << i * 0.5;
+        buffer.endRow();
+    }
+}
+
+/** reads all chunks of a file into a single chunk */
+void readAll(const std::string& fileName, ColumnarChunk& result, std::string& tableName)
+{
+    std::ifstream input(fileName.c_str(), std::ios::in | std::ios::binary);
+    ColumnarReader reader(input);
+    tableName = reader.getTableName();
+    result = ColumnarChunk();
+    result.columns.resize(reader.getColumns().size());
+    ColumnarChunk chunk;
+    while (reader.readChunk(chunk))
+    {
+        result.numRows += chunk.numRows;
+        for (std::size_t i = 0; i < chunk.columns.size(); i++)
+        {
+            result.columns[i].integers.insert(result.columns[i].integers.end(), chunk.columns[i].integers.begin(),
+                                              chunk.columns[i].integers.end());
+            result.columns[i].reals.insert(result.columns[i].reals.end(), chunk.columns[i].reals.begin(),
+                                           chunk.columns[i].reals.end());
+        }
+    }
+}
+}
+
+void unit_tests::ColumnarOutputUnitTests::test_RoundTrip()
+{
+    TempFile file;
+    const int64_t integers[] = { 0, 5, -3, std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), 7, 7 };
+    const double reals[] = { 0, 0, 1.25, -1e300, 3.14159, 3.14159, std::numeric_limits<double>::denorm_min() };
+    const std::size_t numRows = sizeof(integers) / sizeof(integers[0]);
+    {
+        //3 rows per chunk, so that the last chunk is partial
+        ColumnarWriter writer(file.name(), "seg", getColumns(), 3);
+        ColumnarBuffer& buffer = writer.getThreadBuffer();
+        for (std::size_t i = 0; i < numRows; i++)
+        {
+            buffer << integers[i] << i << reals[i];
+            buffer.endRow();
+        }
+        writer.close();
+    }
+
+    ColumnarChunk result;
+    std::string tableName;
+    readAll(file.name(), result, tableName);
+    CPPUNIT_ASSERT_EQUAL(std::string("seg"), tableName);
+    CPPUNIT_ASSERT_EQUAL(numRows, result.numRows);
+    for (std::size_t i = 0; i < numRows; i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(integers[i], result.columns[0].integers[i]);
+        CPPUNIT_ASSERT_EQUAL(int64_t(i), result.columns[1].integers[i]);
+        CPPUNIT_ASSERT_EQUAL(reals[i], result.columns[2].reals[i]);
+    }
+}
+
+void unit_tests::ColumnarOutputUnitTests::test_ThreadBuffers()
+{
+    TempFile file;
+    {
+        ColumnarWriter writer(file.name(), "lnk", getColumns(), 64, 2);
+        boost::thread_group threads;
+        for (int i = 0; i < NUM_THREADS; i++)
+        {
+            threads.create_thread(boost::bind(record, &writer, i));
+        }
+        threads.join_all();
+
+        //the threads have finished, but their last rows are still buffered
+        writer.close();
+    }
+
+    ColumnarChunk result;
+    std::string tableName;
+    readAll(file.name(), result, tableName);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(NUM_THREADS * ROWS_PER_THREAD), result.numRows);
+
+    std::vector<int> counts(NUM_THREADS * ROWS_PER_THREAD, 0);
+    for (std::size_t i = 0; i < result.numRows; i++)
+    {
+        const int64_t row = result.columns[1].integers[i];
+        CPPUNIT_ASSERT_EQUAL(row * 0.5, result.columns[2].reals[i]);
+        counts[result.columns[0].integers[i] * ROWS_PER_THREAD + row]++;
+    }
+    for (std::size_t i = 0; i < counts.size(); i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(1, counts[i]);
+    }
+}
+
+void unit_tests::ColumnarOutputUnitTests::test_Csv()
+{
+    TempFile file;
+    {
+        std::vector<ColumnSchema> columns = getColumns();
+        columns.push_back(ColumnSchema("length", ColumnSchema::REAL));
+        ColumnarWriter writer(file.name(), "seg", columns);
+        ColumnarBuffer& buffer = writer.getThreadBuffer();
+        buffer << 1u << 42 << 0.125 << 2.5;
+        buffer.endRow();
+        buffer << 2u << -1 << 10 << 0.1;
+        buffer.endRow();
+    }
+
+    std::ifstream input(file.name().c_str(), std::ios::in | std::ios::binary);
+    ColumnarReader reader(input);
+    std::ostringstream csv;
+    reader.writeCsv(csv);
+    CPPUNIT_ASSERT_EQUAL(std::string("seg,1,42,0.12,2.5\nseg,2,-1,10.00,0.10000000000000001\n"), csv.str());
+}
+
+void unit_tests::ColumnarOutputUnitTests::test_InvalidRows()
+{
+    TempFile file;
+    {
+        ColumnarWriter writer(file.name(), "seg", getColumns());
+        ColumnarBuffer& buffer = writer.getThreadBuffer();
+        CPPUNIT_ASSERT_THROW(buffer << 0.5, std::runtime_error);
+
+        buffer << 1 << 2;
+        CPPUNIT_ASSERT_THROW(buffer.endRow(), std::runtime_error);
+        buffer << 3.5;
+        CPPUNIT_ASSERT_THROW(buffer << 4, std::runtime_error);
+        buffer.endRow();
+
+        buffer << 5 << 6;
+    }
+
+    ColumnarChunk result;
+    std::string tableName;
+    readAll(file.name(), result, tableName);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), result.numRows);
+    CPPUNIT_ASSERT_EQUAL(int64_t(2), result.columns[1].integers[0]);
+    CPPUNIT_ASSERT_EQUAL(3.5, result.columns[2].reals[0]);
+}
@@ -0,0 +1,40 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the binary columnar output of statistics.
+ */
+class ColumnarOutputUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that the values read back are exactly the values written, over several chunks.
+    void test_RoundTrip();
+
+    ///Test that the rows recorded by several threads are all written exactly once.
+    void test_ThreadBuffers();
+
+    ///Test the conversion to csv, in the format of the text output.
+    void test_Csv();
+
+    ///Test that malformed rows are rejected, and that an unfinished row is dropped.
+    void test_InvalidRows();
+
+private:
+    CPPUNIT_TEST_SUITE(ColumnarOutputUnitTests);
+        CPPUNIT_TEST(test_RoundTrip);
+        CPPUNIT_TEST(test_ThreadBuffers);
+        CPPUNIT_TEST(test_Csv);
+        CPPUNIT_TEST(test_InvalidRows);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -52,8 +52,16 @@ int main(int argc, char *argv[])
     CppUnit::BriefTestProgressListener progress;
     controller.addListener(&progress);
 
+    //The tests of the default registry are run, unless another registry (e.g. "benchmarks") is named.
     CppUnit::TestRunner runner;
-    runner.addTest(CppUnit::TestFactoryRegistry::getRegistry().makeTest());
+    if (argc > 1)
+    {
+        runner.addTest(CppUnit::TestFactoryRegistry::getRegistry(argv[1]).makeTest());
+    }
+    else
+    {
+        runner.addTest(CppUnit::TestFactoryRegistry::getRegistry().makeTest());
+    }
     runner.run(controller);
 
     CppUnit::CompilerOutputter outputter(&result, CppUnit::stdCOut());
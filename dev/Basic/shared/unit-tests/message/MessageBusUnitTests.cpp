@@ -0,0 +1,201 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/thread.hpp>
+
+#include "conf/ConfigManager.hpp"
+#include "conf/ConfigParams.hpp"
+#include "message/MessageBus.hpp"
+#include "message/MessagePool.hpp"
+
+#include "MessageBusUnitTests.hpp"
+
+using namespace sim_mob;
+using namespace sim_mob::messaging;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::MessageBusUnitTests);
+
+namespace
+{
+
+const Message::MessageType MSG_TAGGED = MessageBus::MB_MSG_START + 1;
+
+const int LOW_PRIORITY = 10;
+
+const int HIGH_PRIORITY = 20;
+
+///(sender tag, sequence) of each handled message
+typedef std::vector<std::pair<int, int> > TagList;
+
+///A message tagged with its sender and its position among the messages of that sender
+class TaggedMessage : public Message
+{
+public:
+    TaggedMessage(int senderTag, int sequence, int msgPriority) : senderTag(senderTag), sequence(sequence)
+    {
+        priority = msgPriority;
+    }
+
+    int senderTag;
+    int sequence;
+};
+
+///Records the tags of the messages it handles, in handling order
+class RecordingHandler : public MessageHandler
+{
+public:
+    RecordingHandler() : MessageHandler(0)
+    {
+    }
+
+    virtual void HandleMessage(Message::MessageType type, const Message& message)
+    {
+        const TaggedMessage& tagged = MSG_CAST(TaggedMessage, message);
+        handled.push_back(std::make_pair(tagged.senderTag, tagged.sequence));
+    }
+
+    TagList handled;
+};
+
+///Posts a low, a high and another low priority message from the calling thread
+void postTagged(RecordingHandler* handler, int senderTag)
+{
+    MessageBus::PostMessage(handler, MSG_TAGGED, MessageBus::MakeMessage<TaggedMessage>(senderTag, 0, LOW_PRIORITY));
+    MessageBus::PostMessage(handler, MSG_TAGGED, MessageBus::MakeMessage<TaggedMessage>(senderTag, 1, HIGH_PRIORITY));
+    MessageBus::PostMessage(handler, MSG_TAGGED, MessageBus::MakeMessage<TaggedMessage>(senderTag, 2, LOW_PRIORITY));
+}
+
+///Registers the calling thread, then posts once released (if a gate is given)
+void runSender(RecordingHandler* handler, int senderTag, boost::barrier* registered, boost::barrier* release)
+{
+    MessageBus::RegisterThread();
+    if (registered)
+    {
+        registered->wait();
+        release->wait();
+    }
+    postTagged(handler, senderTag);
+}
+
+/**
+ * Runs a bus session with two sender threads, the first registered sender posting last.
+ * The session runs on its own thread, which registers as the main thread; the test runner's
+ * thread may already have been registered by other tests.
+ */
+void runSession(TagList* beforeHandOver, TagList* received, std::string* error)
+{
+    try
+    {
+        MessageBus::RegisterMainThread();
+        RecordingHandler handler;
+        MessageBus::RegisterHandler(&handler);
+
+        boost::barrier registered(2);
+        boost::barrier release(2);
+        boost::thread first(runSender, &handler, 1, &registered, &release);
+        registered.wait();
+        boost::thread second(runSender, &handler, 2, nullptr, nullptr);
+        second.join();
+        release.wait();
+        first.join();
+        postTagged(&handler, 0);
+
+        MessageBus::ThreadDispatchMessages();
+        *beforeHandOver = handler.handled;
+        MessageBus::DistributeMessages();
+        *received = handler.handled;
+
+        MessageBus::UnRegisterHandler(&handler);
+        MessageBus::UnRegisterMainThread();
+    }
+    catch (std::exception& ex)
+    {
+        *error = ex.what();
+    }
+}
+
+///Releases a block on the calling thread and allocates the same size again
+void reallocate(void* block, std::size_t size, void** reused)
+{
+    MessagePool::Deallocate(block, size);
+    *reused = MessagePool::Allocate(size);
+    MessagePool::Deallocate(*reused, size);
+}
+
+}
+
+void unit_tests::MessageBusUnitTests::test_BatchedDeliveryOrder()
+{
+    bool& batched = ConfigManager::GetInstanceRW().FullConfig().simulation.batchedMessageDistribution;
+    const bool wasBatched = batched;
+    batched = true;
+
+    TagList beforeHandOver;
+    TagList received;
+    std::string error;
+    boost::thread session(runSession, &beforeHandOver, &received, &error);
+    session.join();
+    batched = wasBatched;
+
+    CPPUNIT_ASSERT_EQUAL(std::string(), error);
+    CPPUNIT_ASSERT(beforeHandOver.empty());
+
+    //the main thread registers first, then sender 1, then sender 2
+    TagList expected;
+    expected.push_back(std::make_pair(0, 1));
+    expected.push_back(std::make_pair(1, 1));
+    expected.push_back(std::make_pair(2, 1));
+    expected.push_back(std::make_pair(0, 0));
+    expected.push_back(std::make_pair(0, 2));
+    expected.push_back(std::make_pair(1, 0));
+    expected.push_back(std::make_pair(1, 2));
+    expected.push_back(std::make_pair(2, 0));
+    expected.push_back(std::make_pair(2, 2));
+    CPPUNIT_ASSERT(received == expected);
+}
+
+void unit_tests::MessageBusUnitTests::test_PoolReusesBlocks()
+{
+    //40 and 33 bytes are in the same size class
+    void* block = MessagePool::Allocate(40);
+    MessagePool::Deallocate(block, 40);
+    void* reused = MessagePool::Allocate(33);
+    CPPUNIT_ASSERT(reused == block);
+
+    //the free list is empty again
+    void* fresh = MessagePool::Allocate(40);
+    CPPUNIT_ASSERT(fresh != reused);
+
+    //blocks beyond the pooled sizes are not cached, but must still work
+    void* large = MessagePool::Allocate(MessagePool::MAX_POOLED_SIZE + 1);
+    CPPUNIT_ASSERT(large != nullptr);
+    MessagePool::Deallocate(large, MessagePool::MAX_POOLED_SIZE + 1);
+
+    MessagePool::Deallocate(fresh, 40);
+    MessagePool::Deallocate(reused, 33);
+}
+
+void unit_tests::MessageBusUnitTests::test_PoolReusesBlocksOfReleasingThread()
+{
+    void* block = MessagePool::Allocate(64);
+    void* reused = nullptr;
+    boost::thread releaser(reallocate, block, 64, &reused);
+    releaser.join();
+    CPPUNIT_ASSERT(reused == block);
+}
+
+void unit_tests::MessageBusUnitTests::test_PooledMessagesReuseBlocks()
+{
+    MessageBus::MessagePtr message = MessageBus::MakeMessage<TaggedMessage>(1, 0, LOW_PRIORITY);
+    const Message* released = message.get();
+    message.reset();
+
+    message = MessageBus::MakeMessage<TaggedMessage>(2, 0, LOW_PRIORITY);
+    CPPUNIT_ASSERT(message.get() == released);
+    CPPUNIT_ASSERT_EQUAL(2, MSG_CAST(TaggedMessage, *message).senderTag);
+}
@@ -0,0 +1,40 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the batched message distribution of the MessageBus and for the MessagePool.
+ */
+class MessageBusUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that batched messages are only delivered once handed over, by priority, then by sender registration, then in posting order.
+    void test_BatchedDeliveryOrder();
+
+    ///Test that a released block is returned by the next allocation of the same size class.
+    void test_PoolReusesBlocks();
+
+    ///Test that a block released by another thread is reused by that thread.
+    void test_PoolReusesBlocksOfReleasingThread();
+
+    ///Test that the memory of a released message is reused for the next message of the same type.
+    void test_PooledMessagesReuseBlocks();
+
+private:
+    CPPUNIT_TEST_SUITE(MessageBusUnitTests);
+        CPPUNIT_TEST(test_BatchedDeliveryOrder);
+        CPPUNIT_TEST(test_PoolReusesBlocks);
+        CPPUNIT_TEST(test_PoolReusesBlocksOfReleasingThread);
+        CPPUNIT_TEST(test_PooledMessagesReuseBlocks);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,144 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "path/PathChoiceEvaluator.hpp"
+
+#include "PathChoiceEvaluatorUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::PathChoiceEvaluatorUnitTests);
+
+namespace
+{
+
+///Coefficients which are powers of 2, so that the utilities are exact
+RouteChoiceCoefficients makeCoefficients()
+{
+    RouteChoiceCoefficients coefficients;
+    coefficients.travelTime = -1;
+    coefficients.travelCost = -2;
+    coefficients.commonFactor = 4;
+    coefficients.length = -0.5;
+    coefficients.highwayDistance = 0.25;
+    coefficients.highwayBias = 8;
+    coefficients.signalNumber = -16;
+    coefficients.rightTurnNumber = -32;
+    coefficients.minDistance = 64;
+    coefficients.minSignal = 128;
+    coefficients.maxHighwayUsage = 256;
+    coefficients.work = 512;
+    coefficients.leisure = 1024;
+    return coefficients;
+}
+
+///Adds a path with the given attributes, and the flags of none
+void addPath(PathChoiceAttributes& attributes, double travelTime, double travelCost, double partialUtility,
+             double pathSize, double length, double highwayDistance, double signalNumber, double rightTurnNumber)
+{
+    attributes.travelTime.push_back(travelTime);
+    attributes.travelCost.push_back(travelCost);
+    attributes.partialUtility.push_back(partialUtility);
+    attributes.pathSize.push_back(pathSize);
+    attributes.length.push_back(length);
+    attributes.highwayDistance.push_back(highwayDistance);
+    attributes.signalNumber.push_back(signalNumber);
+    attributes.rightTurnNumber.push_back(rightTurnNumber);
+    attributes.isMinDistance.push_back(0);
+    attributes.isMinSignal.push_back(0);
+    attributes.isMaxHighwayUsage.push_back(0);
+    attributes.isWork.push_back(0);
+    attributes.leisure.push_back(0);
+}
+
+}
+
+void unit_tests::PathChoiceEvaluatorUnitTests::test_Utilities()
+{
+    PathChoiceEvaluator evaluator;
+    evaluator.setCoefficients(makeCoefficients());
+
+    PathChoiceAttributes attributes;
+    addPath(attributes, 2, 1, 0, 1, 10, 4, 1, 1);
+    attributes.isMinDistance.back() = 1;
+    attributes.isWork.back() = 1;
+    addPath(attributes, 1, 0, 0, 0.5, 0, 0, 0, 0);
+    attributes.isMinSignal.back() = 1;
+    attributes.isMaxHighwayUsage.back() = 1;
+    attributes.leisure.back() = 2;
+
+    std::vector<double> utilities;
+    evaluator.computeUtilities(attributes, utilities);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), utilities.size());
+
+    //4 - 5 + 1 + 8 (highway bias) - 16 - 32 + 64 + 512, then - 2 (time) - 2 (cost)
+    CPPUNIT_ASSERT_EQUAL(532.0, utilities[0]);
+
+    //2 + 128 + 256 + 2 * 1024, then - 1 (time); no highway bias without highway distance
+    CPPUNIT_ASSERT_EQUAL(2433.0, utilities[1]);
+}
+
+void unit_tests::PathChoiceEvaluatorUnitTests::test_PartialUtility()
+{
+    PathChoiceEvaluator evaluator;
+    evaluator.setCoefficients(makeCoefficients());
+
+    PathChoiceAttributes attributes;
+    addPath(attributes, 1, 1, 3, 1, 10, 4, 1, 1);
+    addPath(attributes, 1, 1, -3, 1, 10, 4, 1, 1);
+
+    std::vector<double> utilities;
+    evaluator.computeUtilities(attributes, utilities);
+    CPPUNIT_ASSERT_EQUAL(0.0, utilities[0]);
+
+    //partial utilities which are not positive are not used, as in the script
+    CPPUNIT_ASSERT_EQUAL(-43.0, utilities[1]);
+}
+
+void unit_tests::PathChoiceEvaluatorUnitTests::test_Probabilities()
+{
+    std::vector<double> utilities;
+    utilities.push_back(0);
+    utilities.push_back(std::log(3.0));
+    utilities.push_back(std::numeric_limits<double>::quiet_NaN());
+    utilities.push_back(-std::numeric_limits<double>::max());
+
+    std::vector<double> probabilities;
+    PathChoiceEvaluator::computeProbabilities(utilities, probabilities);
+    CPPUNIT_ASSERT_EQUAL(size_t(4), probabilities.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25, probabilities[0], 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.75, probabilities[1], 1e-12);
+    CPPUNIT_ASSERT_EQUAL(0.0, probabilities[2]);
+    CPPUNIT_ASSERT_EQUAL(0.0, probabilities[3]);
+}
+
+void unit_tests::PathChoiceEvaluatorUnitTests::test_ChooseAlternative()
+{
+    std::vector<double> probabilities;
+    probabilities.push_back(0.25);
+    probabilities.push_back(0);
+    probabilities.push_back(0.75);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(0), PathChoiceEvaluator::chooseAlternative(probabilities, 0.1));
+    CPPUNIT_ASSERT_EQUAL(size_t(2), PathChoiceEvaluator::chooseAlternative(probabilities, 0.25));
+    CPPUNIT_ASSERT_EQUAL(size_t(2), PathChoiceEvaluator::chooseAlternative(probabilities, 0.9));
+
+    //without any available path, the last one is chosen
+    std::vector<double> unavailable(2, 0.0);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), PathChoiceEvaluator::chooseAlternative(unavailable, 0.5));
+    CPPUNIT_ASSERT_THROW(PathChoiceEvaluator::chooseAlternative(std::vector<double>(), 0.5), std::runtime_error);
+}
+
+void unit_tests::PathChoiceEvaluatorUnitTests::test_RandomSequence()
+{
+    PathChoiceEvaluator evaluator;
+    CPPUNIT_ASSERT_EQUAL(1396453061.0 / 1099511627776.0, evaluator.nextRandom());
+    CPPUNIT_ASSERT_EQUAL(522692289433.0 / 1099511627776.0, evaluator.nextRandom());
+    CPPUNIT_ASSERT_EQUAL(418620711613.0 / 1099511627776.0, evaluator.nextRandom());
+}
@@ -0,0 +1,44 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the evaluation of the private traffic route choice model in C++.
+ */
+class PathChoiceEvaluatorUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that each attribute of a path enters its utility with its coefficient.
+    void test_Utilities();
+
+    ///Test that a partial utility pre-computed for a path replaces its time independent terms.
+    void test_PartialUtility();
+
+    ///Test that the probabilities follow the logit model, and that paths without a valid utility are not chosen.
+    void test_Probabilities();
+
+    ///Test that the path is chosen by the cumulative probabilities.
+    void test_ChooseAlternative();
+
+    ///Test that the random numbers are those of the generator of the logit script.
+    void test_RandomSequence();
+
+private:
+    CPPUNIT_TEST_SUITE(PathChoiceEvaluatorUnitTests);
+        CPPUNIT_TEST(test_Utilities);
+        CPPUNIT_TEST(test_PartialUtility);
+        CPPUNIT_TEST(test_Probabilities);
+        CPPUNIT_TEST(test_ChooseAlternative);
+        CPPUNIT_TEST(test_RandomSequence);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,163 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "path/PathSetStore.hpp"
+
+#include "PathSetStoreUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::PathSetStoreUnitTests);
+
+namespace
+{
+
+const std::string FILE_NAME = "pathset_store_unit_test.bin";
+
+const std::string SOURCE = "pathsets_2016";
+
+const std::string SOURCE_VERSION = "2016-03-01";
+
+///The store is tested without a road network: the links are not resolved, only their ids are kept
+const std::map<unsigned int, Link*> NO_LINKS;
+
+PathSetStorePath makeAttributes(double length, uint32_t flags)
+{
+    PathSetStorePath attributes = PathSetStorePath();
+    attributes.length = length;
+    attributes.partialUtility = -length / 1000;
+    attributes.signalNumber = 3;
+    attributes.flags = flags;
+    return attributes;
+}
+
+std::vector<unsigned int> makeLinks(unsigned int first, unsigned int count)
+{
+    std::vector<unsigned int> links;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        links.push_back(first + i);
+    }
+    return links;
+}
+
+///Saves a store with two paths from 20 to 10, one from 10 to 20 and one from 10 to 30, added out of order.
+void saveStore()
+{
+    PathSetStore store(SOURCE, SOURCE_VERSION);
+    store.addPath(20, 10, makeLinks(7, 3), makeAttributes(300, PathSetStorePath::MIN_DISTANCE), "SP");
+    store.addPath(10, 30, makeLinks(1, 5), makeAttributes(500, PathSetStorePath::VALID_PATH), "KSHP");
+    store.addPath(20, 10, makeLinks(4, 4), makeAttributes(400, PathSetStorePath::VALID_PATH), "LE");
+    store.addPath(10, 20, makeLinks(1, 2), makeAttributes(200, PathSetStorePath::SHORTEST_PATH), "SP");
+    store.save(FILE_NAME);
+}
+
+///@return the link ids of a path of a store
+std::vector<unsigned int> getLinkIds(const PathSetStore& store, const PathSetStorePath& path)
+{
+    std::vector<unsigned int> ids;
+    const uint32_t* indices = store.getLinkIndices(path);
+    for (uint32_t i = 0; i < path.numLinks; i++)
+    {
+        ids.push_back(store.getLinkId(indices[i]));
+        CPPUNIT_ASSERT(!store.getLink(indices[i]));
+    }
+    return ids;
+}
+
+}
+
+void unit_tests::PathSetStoreUnitTests::test_SaveAndLoad()
+{
+    saveStore();
+
+    PathSetStore store(SOURCE, SOURCE_VERSION);
+    store.load(FILE_NAME, NO_LINKS);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), store.getNumPathSets());
+    CPPUNIT_ASSERT_EQUAL(size_t(4), store.getNumPaths());
+
+    size_t numPaths = 0;
+    const PathSetStorePath* paths = store.findPaths(20, 10, numPaths);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), numPaths);
+    CPPUNIT_ASSERT(getLinkIds(store, paths[0]) == makeLinks(7, 3));
+    CPPUNIT_ASSERT(getLinkIds(store, paths[1]) == makeLinks(4, 4));
+    CPPUNIT_ASSERT_EQUAL(300.0, paths[0].length);
+    CPPUNIT_ASSERT_EQUAL(-0.3, paths[0].partialUtility);
+    CPPUNIT_ASSERT_EQUAL(int32_t(3), paths[0].signalNumber);
+    CPPUNIT_ASSERT_EQUAL(uint32_t(PathSetStorePath::MIN_DISTANCE), paths[0].flags);
+    CPPUNIT_ASSERT_EQUAL(std::string("SP"), store.getScenario(paths[0]));
+    CPPUNIT_ASSERT_EQUAL(std::string("LE"), store.getScenario(paths[1]));
+
+    paths = store.findPaths(10, 30, numPaths);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), numPaths);
+    CPPUNIT_ASSERT(getLinkIds(store, paths[0]) == makeLinks(1, 5));
+    CPPUNIT_ASSERT_EQUAL(std::string("KSHP"), store.getScenario(paths[0]));
+
+    std::remove(FILE_NAME.c_str());
+}
+
+void unit_tests::PathSetStoreUnitTests::test_MissingOD()
+{
+    saveStore();
+
+    PathSetStore store(SOURCE, SOURCE_VERSION);
+    store.load(FILE_NAME, NO_LINKS);
+
+    //Before the first OD, between ODs, reversed, and after the last OD
+    const unsigned int missing[][2] = { { 1, 10 }, { 10, 25 }, { 30, 10 }, { 20, 11 } };
+    for (size_t i = 0; i < sizeof(missing) / sizeof(missing[0]); i++)
+    {
+        size_t numPaths = 1;
+        CPPUNIT_ASSERT(!store.findPaths(missing[i][0], missing[i][1], numPaths));
+        CPPUNIT_ASSERT_EQUAL(size_t(0), numPaths);
+    }
+
+    std::remove(FILE_NAME.c_str());
+}
+
+void unit_tests::PathSetStoreUnitTests::test_SharedLinkSequences()
+{
+    PathSetStore builder(SOURCE, SOURCE_VERSION);
+    builder.addPath(1, 2, makeLinks(100, 10), makeAttributes(1000, 0), "SP");
+    builder.addPath(1, 2, makeLinks(100, 10), makeAttributes(1000, 0), "KSHP");
+    builder.addPath(3, 2, makeLinks(100, 10), makeAttributes(1000, 0), "SP");
+    builder.addPath(3, 2, makeLinks(100, 5), makeAttributes(500, 0), "SP");
+    builder.save(FILE_NAME);
+
+    PathSetStore store(SOURCE, SOURCE_VERSION);
+    store.load(FILE_NAME, NO_LINKS);
+    CPPUNIT_ASSERT_EQUAL(size_t(4), store.getNumPaths());
+    CPPUNIT_ASSERT_EQUAL(size_t(15), store.getNumLinkIndices());
+
+    size_t numPaths = 0;
+    const PathSetStorePath* paths = store.findPaths(3, 2, numPaths);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), numPaths);
+    CPPUNIT_ASSERT(getLinkIds(store, paths[1]) == makeLinks(100, 5));
+
+    std::remove(FILE_NAME.c_str());
+}
+
+void unit_tests::PathSetStoreUnitTests::test_SourceMismatch()
+{
+    saveStore();
+
+    PathSetStore store("pathsets_2017", SOURCE_VERSION);
+    CPPUNIT_ASSERT_THROW(store.load(FILE_NAME, NO_LINKS), std::runtime_error);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), store.getNumPathSets());
+
+    //The source table was regenerated since the store was built
+    PathSetStore rewritten(SOURCE, "2016-04-01");
+    CPPUNIT_ASSERT_THROW(rewritten.load(FILE_NAME, NO_LINKS), std::runtime_error);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), rewritten.getNumPathSets());
+
+    std::remove(FILE_NAME.c_str());
+    PathSetStore missing(SOURCE, SOURCE_VERSION);
+    CPPUNIT_ASSERT_THROW(missing.load(FILE_NAME, NO_LINKS), std::runtime_error);
+}
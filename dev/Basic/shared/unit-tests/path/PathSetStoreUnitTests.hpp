@@ -0,0 +1,40 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the store of pre-generated private traffic path sets.
+ */
+class PathSetStoreUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that the paths of each OD are found unchanged, in the order they were added, once the store is mapped.
+    void test_SaveAndLoad();
+
+    ///Test that ODs without paths are not found.
+    void test_MissingOD();
+
+    ///Test that paths with the same links share their link sequence.
+    void test_SharedLinkSequences();
+
+    ///Test that a store is only loaded if it was built from the same source, of the same version.
+    void test_SourceMismatch();
+
+private:
+    CPPUNIT_TEST_SUITE(PathSetStoreUnitTests);
+        CPPUNIT_TEST(test_SaveAndLoad);
+        CPPUNIT_TEST(test_MissingOD);
+        CPPUNIT_TEST(test_SharedLinkSequences);
+        CPPUNIT_TEST(test_SourceMismatch);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,180 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "conf/ConfigManager.hpp"
+#include "conf/ConfigParams.hpp"
+#include "entities/TravelTimeManager.hpp"
+#include "entities/TravelTimeTable.hpp"
+#include "geospatial/network/Link.hpp"
+#include "geospatial/network/Node.hpp"
+#include "geospatial/network/TurningGroup.hpp"
+#include "util/DailyTime.hpp"
+
+#include "TravelTimeTableUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::TravelTimeTableUnitTests);
+
+namespace
+{
+
+const int INTERVAL_SECONDS = 300;
+
+/**
+ * Link 1 (node 1 -> 2) turns into links 2 (2 -> 3) and 3 (2 -> 4); link 2 turns into link 4 (3 -> 4).
+ * Links 3 and 4 have no downstream links.
+ */
+class TestNetwork
+{
+public:
+    TestNetwork()
+    {
+        for (unsigned int i = 1; i <= 4; i++)
+        {
+            Node* node = new Node();
+            node->setNodeId(i);
+            nodes[i] = node;
+        }
+        addLink(1, 1, 2);
+        addLink(2, 2, 3);
+        addLink(3, 2, 4);
+        addLink(4, 3, 4);
+        addTurningGroup(2, 1, 2);
+        addTurningGroup(2, 1, 3);
+        addTurningGroup(3, 2, 4);
+    }
+
+    ~TestNetwork()
+    {
+        for (std::map<unsigned int, Link *>::iterator it = links.begin(); it != links.end(); ++it)
+        {
+            delete it->second;
+        }
+        for (std::map<unsigned int, Node *>::iterator it = nodes.begin(); it != nodes.end(); ++it)
+        {
+            delete it->second;
+        }
+    }
+
+    std::map<unsigned int, Node *> nodes;
+    std::map<unsigned int, Link *> links;
+
+private:
+    void addLink(unsigned int id, unsigned int fromNode, unsigned int toNode)
+    {
+        Link* link = new Link();
+        link->setLinkId(id);
+        link->setLinkIndex(links.size());
+        link->setFromNodeId(fromNode);
+        link->setFromNode(nodes[fromNode]);
+        link->setToNodeId(toNode);
+        link->setToNode(nodes[toNode]);
+        links[id] = link;
+    }
+
+    void addTurningGroup(unsigned int node, unsigned int fromLink, unsigned int toLink)
+    {
+        TurningGroup* turningGroup = new TurningGroup();
+        turningGroup->setTurningGroupId(fromLink * 10 + toLink);
+        turningGroup->setNodeId(node);
+        turningGroup->setFromLinkId(fromLink);
+        turningGroup->setToLinkId(toLink);
+        nodes[node]->addTurningGroup(turningGroup);
+    }
+};
+
+///Records a travel time experienced in the simulation
+void addInSimulationTT(const Link* link, const Link* downstreamLink, const std::string& entryTime, double travelTime)
+{
+    LinkTravelStats stats(link);
+    stats.downstreamLink = downstreamLink;
+    stats.entryTime = DailyTime(entryTime).getValue() / 1000.0;
+    stats.travelTime = travelTime;
+    TravelTimeManager::getInstance()->addTravelTime(stats);
+}
+
+///Checks the travel times of all links (towards each link or none) at times around the ones with data, every 30 seconds
+void checkAllLinkTTs(const TestNetwork& network, const TravelTimeTable& table)
+{
+    const TravelTimeManager* manager = TravelTimeManager::getInstance();
+    std::vector<const Link*> downstreamLinks(1, nullptr);
+    for (std::map<unsigned int, Link *>::const_iterator it = network.links.begin(); it != network.links.end(); ++it)
+    {
+        downstreamLinks.push_back(it->second);
+    }
+
+    std::vector<DailyTime> times;
+    for (unsigned int time = DailyTime("07:50:00").getValue(); time <= DailyTime("08:20:00").getValue(); time += 30000)
+    {
+        times.push_back(DailyTime(time));
+    }
+    times.push_back(DailyTime("00:00:00"));
+    times.push_back(DailyTime("23:59:59"));
+
+    for (std::map<unsigned int, Link *>::const_iterator it = network.links.begin(); it != network.links.end(); ++it)
+    {
+        for (std::vector<const Link*>::const_iterator dsIt = downstreamLinks.begin(); dsIt != downstreamLinks.end(); ++dsIt)
+        {
+            for (std::vector<DailyTime>::const_iterator timeIt = times.begin(); timeIt != times.end(); ++timeIt)
+            {
+                for (int inSimulation = 0; inSimulation < 2; inSimulation++)
+                {
+                    CPPUNIT_ASSERT_EQUAL(manager->getLinkTT(it->second, *timeIt, *dsIt, inSimulation),
+                                         table.getLinkTT(it->second, *timeIt, *dsIt, inSimulation));
+                }
+            }
+        }
+    }
+}
+
+}
+
+void unit_tests::TravelTimeTableUnitTests::test_MatchesTravelTimeManager()
+{
+    //The interval is read when the manager is created
+    ConfigManager::GetInstanceRW().FullConfig().getPathSetConf().interval = INTERVAL_SECONDS;
+    TravelTimeManager* manager = TravelTimeManager::getInstance();
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(INTERVAL_SECONDS * 1000), manager->intervalMS);
+
+    TestNetwork network;
+    const std::map<unsigned int, Link *>& links = network.links;
+    for (unsigned int i = 1; i <= 4; i++)
+    {
+        manager->setDefaultLinkTT(i, 10.0 * i);
+    }
+    manager->addHistoricalLinkTT(1, 2, DailyTime("08:00:00"), 50);
+    manager->addHistoricalLinkTT(1, 3, DailyTime("08:00:00"), 70);
+    manager->addHistoricalLinkTT(1, 2, DailyTime("08:05:00"), 55);
+    manager->addHistoricalLinkTT(2, 4, DailyTime("07:55:00"), 30);
+    manager->initTravelTimeTable(links);
+
+    std::shared_ptr<const TravelTimeTable> table = manager->getTravelTimeTable();
+    CPPUNIT_ASSERT(table);
+    CPPUNIT_ASSERT_EQUAL(50.0, table->getLinkTT(links.at(1), DailyTime("08:02:00"), links.at(2), false));
+    CPPUNIT_ASSERT_EQUAL(60.0, table->getLinkTT(links.at(1), DailyTime("08:02:00"), nullptr, false));
+    CPPUNIT_ASSERT_EQUAL(10.0, table->getLinkTT(links.at(1), DailyTime("08:12:00"), links.at(2), false));
+    checkAllLinkTTs(network, *table);
+
+    //In-simulation times: one towards a downstream link, one spread over all downstream links
+    addInSimulationTT(links.at(1), links.at(2), "08:01:00", 80);
+    addInSimulationTT(links.at(1), links.at(2), "08:03:00", 100);
+    addInSimulationTT(links.at(2), nullptr, "08:06:00", 45);
+
+    //Not seen until the next table is published
+    CPPUNIT_ASSERT_EQUAL(55.0, table->getLinkTT(links.at(1), DailyTime("08:06:00"), links.at(2), true));
+
+    const uint64_t version = table->getVersion();
+    manager->publishTravelTimeTable();
+    table = manager->getTravelTimeTable();
+    CPPUNIT_ASSERT(table->getVersion() > version);
+    CPPUNIT_ASSERT_EQUAL(90.0, table->getLinkTT(links.at(1), DailyTime("08:06:00"), links.at(2), true));
+    CPPUNIT_ASSERT_EQUAL(55.0, table->getLinkTT(links.at(1), DailyTime("08:06:00"), links.at(2), false));
+    CPPUNIT_ASSERT_EQUAL(45.0, table->getLinkTT(links.at(2), DailyTime("08:10:00"), links.at(4), true));
+    checkAllLinkTTs(network, *table);
+}
@@ -0,0 +1,28 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the travel time table used in path evaluation.
+ */
+class TravelTimeTableUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that the table gives the travel times of TravelTimeManager::getLinkTT, for historical and in-simulation times.
+    void test_MatchesTravelTimeManager();
+
+private:
+    CPPUNIT_TEST_SUITE(TravelTimeTableUnitTests);
+        CPPUNIT_TEST(test_MatchesTravelTimeManager);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,188 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include "entities/Agent.hpp"
+#include "entities/AuraManager.hpp"
+#include "geospatial/network/Point.hpp"
+
+#include "AuraManagerBenchmarks.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(unit_tests::AuraManagerBenchmarks, "benchmarks");
+
+namespace
+{
+//Distances are in the (integer) units of the agent positions. The area is kept small enough for the positions, and the
+//query bounds half way between them, to be exact in single precision (used by the packing tree).
+
+/**side of the square area the agents are spread over*/
+const int AREA_SIZE = 4000000;
+
+/**side of the query rectangles*/
+const double QUERY_SIZE = 5001;
+
+/**maximum distance moved by an agent between updates*/
+const int MAX_MOVE = 1500;
+
+const int NUM_UPDATES = 5;
+const int NUM_QUERIES = 20000;
+
+/**An agent which only has a position*/
+class BenchmarkAgent : public Agent
+{
+public:
+    BenchmarkAgent() : Agent(MtxStrat_Buffered)
+    {
+    }
+
+    void moveTo(int x, int y)
+    {
+        xPos.force(x);
+        yPos.force(y);
+    }
+
+    virtual bool isNonspatial()
+    {
+        return false;
+    }
+
+protected:
+    virtual Entity::UpdateStatus frame_init(timeslice now)
+    {
+        return Entity::UpdateStatus::Continue;
+    }
+
+    virtual Entity::UpdateStatus frame_tick(timeslice now)
+    {
+        return Entity::UpdateStatus::Continue;
+    }
+
+    virtual void frame_output(timeslice now)
+    {
+    }
+};
+
+struct Implementation
+{
+    AuraManager::AuraManagerImplementation type;
+    const char* name;
+};
+
+//The sim-tree is left out: it is built on the road network, which is not loaded here.
+const Implementation IMPLEMENTATIONS[] =
+{
+    { AuraManager::IMPL_RSTAR, "rstar" },
+    { AuraManager::IMPL_RDU, "rdu" },
+    { AuraManager::IMPL_PACKING, "packing-tree" },
+    { AuraManager::IMPL_STR, "str-tree" }
+};
+
+double secondsSince(const boost::posix_time::ptime& start)
+{
+    return (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() / 1e6;
+}
+
+/** moves every agent by a random offset of at most MAX_MOVE in each direction */
+void moveAgents(std::vector<BenchmarkAgent*>& agents)
+{
+    for (BenchmarkAgent* agent : agents)
+    {
+        agent->moveTo(agent->xPos.get() + std::rand() % (2 * MAX_MOVE + 1) - MAX_MOVE,
+                      agent->yPos.get() + std::rand() % (2 * MAX_MOVE + 1) - MAX_MOVE);
+    }
+}
+}
+
+void unit_tests::AuraManagerBenchmarks::benchmark_UpdateAndQuery()
+{
+    const std::size_t numAgentsList[] = { 50000, 100000, 200000, 500000 };
+    const std::set<Entity*> removedAgents;
+
+    std::cout << "\n" << std::setw(10) << "agents" << std::setw(15) << "impl" << std::setw(15) << "first update"
+              << std::setw(15) << "update" << std::setw(15) << "query (us)" << std::setw(15) << "found" << "\n";
+    for (std::size_t numAgents : numAgentsList)
+    {
+        std::vector<BenchmarkAgent*> agents;
+        for (std::size_t i = 0; i < numAgents; i++)
+        {
+            agents.push_back(new BenchmarkAgent());
+            agents.back()->moveTo(std::rand() % AREA_SIZE, std::rand() % AREA_SIZE);
+            Agent::all_agents.insert(agents.back());
+        }
+
+        //every implementation sees the same moves and the same queries
+        const unsigned int seed = std::rand();
+        std::size_t expectedFound = 0;
+        for (const Implementation& impl : IMPLEMENTATIONS)
+        {
+            std::srand(seed);
+            std::vector<std::pair<int, int> > initialPositions;
+            for (BenchmarkAgent* agent : agents)
+            {
+                initialPositions.push_back(std::make_pair(agent->xPos.get(), agent->yPos.get()));
+            }
+
+            AuraManager& auraManager = AuraManager::instance();
+            auraManager.init(impl.type);
+
+            boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+            auraManager.update(removedAgents);
+            const double firstUpdate = secondsSince(start);
+
+            double updates = 0;
+            for (int i = 0; i < NUM_UPDATES; i++)
+            {
+                moveAgents(agents);
+                start = boost::posix_time::microsec_clock::local_time();
+                auraManager.update(removedAgents);
+                updates += secondsSince(start);
+            }
+
+            std::vector<Point> corners;
+            for (int i = 0; i < NUM_QUERIES; i++)
+            {
+                const BenchmarkAgent* agent = agents[std::rand() % agents.size()];
+                corners.push_back(Point(agent->xPos.get() - QUERY_SIZE / 2, agent->yPos.get() - QUERY_SIZE / 2));
+            }
+            std::size_t found = 0;
+            start = boost::posix_time::microsec_clock::local_time();
+            for (const Point& corner : corners)
+            {
+                Point upperRight(corner.getX() + QUERY_SIZE, corner.getY() + QUERY_SIZE);
+                found += auraManager.agentsInRect(corner, upperRight, nullptr).size();
+            }
+            const double queries = secondsSince(start);
+            auraManager.destroy();
+
+            std::cout << std::setw(10) << numAgents << std::setw(15) << impl.name << std::setw(15) << firstUpdate
+                      << std::setw(15) << updates / NUM_UPDATES << std::setw(15) << queries * 1e6 / NUM_QUERIES
+                      << std::setw(15) << found << std::endl;
+            if (&impl == IMPLEMENTATIONS)
+            {
+                expectedFound = found;
+            }
+            CPPUNIT_ASSERT_EQUAL(expectedFound, found);
+
+            //restore the positions for the next implementation
+            for (std::size_t i = 0; i < agents.size(); i++)
+            {
+                agents[i]->moveTo(initialPositions[i].first, initialPositions[i].second);
+            }
+        }
+
+        Agent::all_agents.clear();
+        for (BenchmarkAgent* agent : agents)
+        {
+            delete agent;
+        }
+    }
+}
@@ -0,0 +1,32 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Micro-benchmark of the aura manager implementations.
+ *
+ * Registered in the "benchmarks" registry, so it is not run with the unit tests; run it with
+ * "SM_UnitTests benchmarks".
+ */
+class AuraManagerBenchmarks : public CppUnit::TestFixture
+{
+public:
+    ///Time the update and the rectangle queries of each implementation for 50k to 500k agents,
+    ///and check that all implementations find the same agents.
+    void benchmark_UpdateAndQuery();
+
+private:
+    CPPUNIT_TEST_SUITE(AuraManagerBenchmarks);
+        CPPUNIT_TEST(benchmark_UpdateAndQuery);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,185 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "spatial_trees/LaneOrderedIndex.hpp"
+
+#include "LaneOrderedIndexUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::LaneOrderedIndexUnitTests);
+
+namespace
+{
+struct Lane
+{
+};
+
+struct Vehicle
+{
+    const Lane* lane;
+    double offset;
+};
+
+typedef LaneOrderedIndex<Lane, Vehicle> Index;
+
+/** vehicles at pseudo-random integer offsets (so that some share an offset) on the given lanes */
+void makeVehicles(std::size_t numVehicles, const std::vector<Lane>& lanes, std::vector<Vehicle>& vehicles, Index& index)
+{
+    vehicles.resize(numVehicles);
+    std::vector<Index::Entry> entries;
+    for (Vehicle& vehicle : vehicles)
+    {
+        vehicle.lane = &lanes[std::rand() % lanes.size()];
+        vehicle.offset = std::rand() % 200;
+        entries.push_back(Index::Entry(vehicle.lane, vehicle.offset, &vehicle));
+    }
+    index.build(entries);
+}
+
+/** offset of an entry; -1 if there is none */
+double getOffset(const Index::Entry* entry)
+{
+    return entry ? entry->offset : -1;
+}
+}
+
+void unit_tests::LaneOrderedIndexUnitTests::test_Empty()
+{
+    Lane lane;
+    Index index;
+    CPPUNIT_ASSERT(index.empty());
+    CPPUNIT_ASSERT(!index.leader(&lane, 0));
+    CPPUNIT_ASSERT(!index.follower(&lane, 0));
+    CPPUNIT_ASSERT(!index.first(&lane));
+    CPPUNIT_ASSERT(!index.last(&lane));
+
+    Lane otherLane;
+    Vehicle vehicle = { &otherLane, 10 };
+    std::vector<Index::Entry> entries(1, Index::Entry(vehicle.lane, vehicle.offset, &vehicle));
+    index.build(entries);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), index.size());
+    CPPUNIT_ASSERT(!index.leader(&lane, 0));
+    CPPUNIT_ASSERT(index.onLane(&lane).first == index.onLane(&lane).second);
+    CPPUNIT_ASSERT(index.leader(&otherLane, 0)->object == &vehicle);
+    CPPUNIT_ASSERT(!index.leader(&otherLane, 10));
+    CPPUNIT_ASSERT(index.follower(&otherLane, 10)->object == &vehicle);
+    CPPUNIT_ASSERT(!index.follower(&otherLane, 10, &vehicle));
+
+    index.clear();
+    CPPUNIT_ASSERT(index.empty());
+    CPPUNIT_ASSERT(!index.first(&otherLane));
+}
+
+void unit_tests::LaneOrderedIndexUnitTests::test_LeaderAndFollower()
+{
+    std::srand(16);
+    const std::vector<Lane> lanes(5);
+    std::vector<Vehicle> vehicles;
+    Index index;
+    makeVehicles(500, lanes, vehicles, index);
+    CPPUNIT_ASSERT_EQUAL(vehicles.size(), index.size());
+
+    for (const Lane& lane : lanes)
+    {
+        for (double offset = -1.5; offset < 202; offset += 0.5)
+        {
+            double leaderOffset = -1;
+            double followerOffset = -1;
+            double firstOffset = -1;
+            double lastOffset = -1;
+            for (const Vehicle& vehicle : vehicles)
+            {
+                if (vehicle.lane != &lane)
+                {
+                    continue;
+                }
+                if (vehicle.offset > offset && (leaderOffset < 0 || vehicle.offset < leaderOffset))
+                {
+                    leaderOffset = vehicle.offset;
+                }
+                if (vehicle.offset <= offset && vehicle.offset > followerOffset)
+                {
+                    followerOffset = vehicle.offset;
+                }
+                if (firstOffset < 0 || vehicle.offset < firstOffset)
+                {
+                    firstOffset = vehicle.offset;
+                }
+                lastOffset = std::max(lastOffset, vehicle.offset);
+            }
+
+            CPPUNIT_ASSERT_EQUAL(leaderOffset, getOffset(index.leader(&lane, offset)));
+            CPPUNIT_ASSERT_EQUAL(followerOffset, getOffset(index.follower(&lane, offset)));
+            CPPUNIT_ASSERT_EQUAL(firstOffset, getOffset(index.first(&lane)));
+            CPPUNIT_ASSERT_EQUAL(lastOffset, getOffset(index.last(&lane)));
+        }
+    }
+}
+
+void unit_tests::LaneOrderedIndexUnitTests::test_SharedOffset()
+{
+    Lane lane;
+    std::vector<Vehicle> vehicles(3);
+    vehicles[0].offset = 5;
+    vehicles[1].offset = 5;
+    vehicles[2].offset = 8;
+    std::vector<Index::Entry> entries;
+    for (Vehicle& vehicle : vehicles)
+    {
+        vehicle.lane = &lane;
+        entries.push_back(Index::Entry(&lane, vehicle.offset, &vehicle));
+    }
+    Index index;
+    index.build(entries);
+
+    //a vehicle level with us is behind us, as for the other direction
+    for (std::size_t i = 0; i < 2; i++)
+    {
+        const Vehicle* self = &vehicles[i];
+        const Vehicle* other = &vehicles[1 - i];
+        CPPUNIT_ASSERT(index.follower(&lane, 5, self)->object == other);
+        CPPUNIT_ASSERT(index.leader(&lane, 5, self)->object == &vehicles[2]);
+    }
+    CPPUNIT_ASSERT_EQUAL(5.0, index.follower(&lane, 8, &vehicles[2])->offset);
+    CPPUNIT_ASSERT(!index.leader(&lane, 8, &vehicles[2]));
+}
+
+void unit_tests::LaneOrderedIndexUnitTests::test_Range()
+{
+    std::srand(61);
+    const std::vector<Lane> lanes(3);
+    std::vector<Vehicle> vehicles;
+    Index index;
+    makeVehicles(300, lanes, vehicles, index);
+
+    for (const Lane& lane : lanes)
+    {
+        for (double minOffset = -10; minOffset < 210; minOffset += 7.5)
+        {
+            const double maxOffset = minOffset + 25;
+            std::size_t expected = 0;
+            for (const Vehicle& vehicle : vehicles)
+            {
+                if (vehicle.lane == &lane && minOffset <= vehicle.offset && vehicle.offset <= maxOffset)
+                {
+                    expected++;
+                }
+            }
+
+            std::pair<Index::const_iterator, Index::const_iterator> range = index.onLane(&lane, minOffset, maxOffset);
+            CPPUNIT_ASSERT_EQUAL(expected, std::size_t(range.second - range.first));
+            for (Index::const_iterator it = range.first; it != range.second; ++it)
+            {
+                CPPUNIT_ASSERT(it->lane == &lane && it->object->lane == &lane);
+                CPPUNIT_ASSERT(minOffset <= it->offset && it->offset <= maxOffset);
+                CPPUNIT_ASSERT(it == range.first || (it - 1)->offset <= it->offset);
+            }
+        }
+    }
+}
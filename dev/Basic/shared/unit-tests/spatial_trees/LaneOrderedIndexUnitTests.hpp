@@ -0,0 +1,40 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the index of objects by lane and offset.
+ */
+class LaneOrderedIndexUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test queries on an empty index and on lanes without objects.
+    void test_Empty();
+
+    ///Test leader, follower, first and last queries against a linear scan.
+    void test_LeaderAndFollower();
+
+    ///Test that objects sharing an offset are not taken for their own leader or follower.
+    void test_SharedOffset();
+
+    ///Test the entries found within offset bounds.
+    void test_Range();
+
+private:
+    CPPUNIT_TEST_SUITE(LaneOrderedIndexUnitTests);
+        CPPUNIT_TEST(test_Empty);
+        CPPUNIT_TEST(test_LeaderAndFollower);
+        CPPUNIT_TEST(test_SharedOffset);
+        CPPUNIT_TEST(test_Range);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,169 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "spatial_trees/PointR_Tree.hpp"
+
+#include "PointR_TreeUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::PointR_TreeUnitTests);
+
+namespace
+{
+struct Object
+{
+    double x;
+    double y;
+    bool flag;
+};
+
+double squaredDistance(const Object& object, double x, double y)
+{
+    return (object.x - x) * (object.x - x) + (object.y - y) * (object.y - y);
+}
+
+/** objects at pseudo-random integer coordinates in a 1000 x 1000 square, indexed by a tree */
+void makeObjects(std::vector<Object>& objects, PointR_Tree<Object>& tree)
+{
+    std::srand(42);
+    objects.resize(500);
+    for (Object& object : objects)
+    {
+        object.x = std::rand() % 1000;
+        object.y = std::rand() % 1000;
+        object.flag = (std::rand() % 3 == 0);
+    }
+    for (const Object& object : objects)
+    {
+        tree.insert(&object, object.x, object.y);
+    }
+}
+
+/** checks that the result is sorted by distance and holds the closest expected objects */
+void checkResult(const std::vector<const Object*>& result, std::vector<const Object*> expected, double x, double y)
+{
+    CPPUNIT_ASSERT_EQUAL(expected.size(), result.size());
+    for (std::size_t i = 1; i < result.size(); i++)
+    {
+        CPPUNIT_ASSERT(squaredDistance(*result[i - 1], x, y) <= squaredDistance(*result[i], x, y));
+    }
+    //ties make the order of the objects ambiguous, but not their distances
+    for (std::size_t i = 0; i < result.size(); i++)
+    {
+        CPPUNIT_ASSERT_EQUAL(squaredDistance(*expected[i], x, y), squaredDistance(*result[i], x, y));
+    }
+}
+
+/** linear scan returning the objects sorted by distance */
+std::vector<const Object*> sortedByDistance(const std::vector<Object>& objects, double x, double y)
+{
+    std::vector<const Object*> sorted;
+    for (const Object& object : objects)
+    {
+        sorted.push_back(&object);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [x, y](const Object* first, const Object* second)
+    {
+        return squaredDistance(*first, x, y) < squaredDistance(*second, x, y);
+    });
+    return sorted;
+}
+}
+
+void unit_tests::PointR_TreeUnitTests::test_InsertMoveErase()
+{
+    Object first = { 0, 0, false };
+    Object second = { 10, 0, false };
+    PointR_Tree<Object> tree;
+    CPPUNIT_ASSERT(tree.empty());
+
+    tree.insert(&first, 0, 0);
+    tree.insert(&second, 10, 0);
+    tree.insert(&second, 10, 0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), tree.size());
+    CPPUNIT_ASSERT(tree.contains(&first));
+
+    std::vector<const Object*> result;
+    tree.nearest(8, 0, 1, result);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), result.size());
+    CPPUNIT_ASSERT(result[0] == &second);
+
+    //moving replaces the old location
+    tree.insert(&second, -10, 0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), tree.size());
+    tree.nearest(8, 0, 1, result);
+    CPPUNIT_ASSERT(result[0] == &first);
+    tree.withinRadius(10, 0, 1, result);
+    CPPUNIT_ASSERT(result.empty());
+
+    tree.erase(&first);
+    tree.erase(&first);
+    CPPUNIT_ASSERT(!tree.contains(&first));
+    tree.nearest(8, 0, 5, result);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), result.size());
+    CPPUNIT_ASSERT(result[0] == &second);
+
+    tree.clear();
+    CPPUNIT_ASSERT(tree.empty());
+    tree.nearest(8, 0, 5, result);
+    CPPUNIT_ASSERT(result.empty());
+}
+
+void unit_tests::PointR_TreeUnitTests::test_Nearest()
+{
+    std::vector<Object> objects;
+    PointR_Tree<Object> tree;
+    makeObjects(objects, tree);
+
+    const double queries[][2] = { { 500, 500 }, { 0, 0 }, { 999, 3 }, { -200, 1500 } };
+    std::vector<const Object*> result;
+    for (const double* query : queries)
+    {
+        std::vector<const Object*> sorted = sortedByDistance(objects, query[0], query[1]);
+
+        tree.nearest(query[0], query[1], 7, result);
+        checkResult(result, std::vector<const Object*>(sorted.begin(), sorted.begin() + 7), query[0], query[1]);
+
+        std::vector<const Object*> flagged;
+        std::copy_if(sorted.begin(), sorted.end(), std::back_inserter(flagged), [](const Object* object)
+        {
+            return object->flag;
+        });
+        tree.nearest(query[0], query[1], 7, [](const Object* object) { return object->flag; }, result);
+        checkResult(result, std::vector<const Object*>(flagged.begin(), flagged.begin() + 7), query[0], query[1]);
+    }
+
+    tree.nearest(500, 500, 0, result);
+    CPPUNIT_ASSERT(result.empty());
+    tree.nearest(500, 500, 1000, result);
+    CPPUNIT_ASSERT_EQUAL(objects.size(), result.size());
+}
+
+void unit_tests::PointR_TreeUnitTests::test_WithinRadius()
+{
+    std::vector<Object> objects;
+    PointR_Tree<Object> tree;
+    makeObjects(objects, tree);
+
+    const double queries[][3] = { { 500, 500, 100 }, { 0, 0, 250 }, { 300, 700, 0 }, { -200, 1500, 50 } };
+    std::vector<const Object*> result;
+    for (const double* query : queries)
+    {
+        std::vector<const Object*> expected;
+        for (const Object* object : sortedByDistance(objects, query[0], query[1]))
+        {
+            if (squaredDistance(*object, query[0], query[1]) <= query[2] * query[2])
+            {
+                expected.push_back(object);
+            }
+        }
+        tree.withinRadius(query[0], query[1], query[2], result);
+        checkResult(result, expected, query[0], query[1]);
+    }
+}
@@ -0,0 +1,36 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the r-tree of moving points.
+ */
+class PointR_TreeUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test inserting, moving and removing objects.
+    void test_InsertMoveErase();
+
+    ///Test k-nearest queries, with and without a predicate, against a linear scan.
+    void test_Nearest();
+
+    ///Test radius queries against a linear scan.
+    void test_WithinRadius();
+
+private:
+    CPPUNIT_TEST_SUITE(PointR_TreeUnitTests);
+        CPPUNIT_TEST(test_InsertMoveErase);
+        CPPUNIT_TEST(test_Nearest);
+        CPPUNIT_TEST(test_WithinRadius);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,141 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "spatial_trees/str_tree/STR_Tree.hpp"
+
+#include "STR_TreeUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::STR_TreeUnitTests);
+
+namespace
+{
+struct Object
+{
+    double x;
+    double y;
+};
+
+typedef STR_Tree<Object>::Entry Entry;
+
+/** objects at pseudo-random integer coordinates in a 1000 x 1000 square (so that some share a location) */
+void makeObjects(std::size_t numObjects, std::vector<Object>& objects, std::vector<Entry>& entries)
+{
+    objects.resize(numObjects);
+    entries.clear();
+    for (Object& object : objects)
+    {
+        object.x = std::rand() % 1000;
+        object.y = std::rand() % 1000;
+        entries.push_back(Entry(object.x, object.y, &object));
+    }
+}
+
+/** queries the tree and a linear scan of the objects, and compares the results */
+bool queryMatchesScan(const STR_Tree<Object>& tree, const std::vector<Object>& objects, double minX, double minY,
+                      double maxX, double maxY)
+{
+    std::vector<const Object*> found;
+    tree.query(minX, minY, maxX, maxY, found);
+    std::vector<const Object*> expected;
+    for (const Object& object : objects)
+    {
+        if (minX <= object.x && object.x <= maxX && minY <= object.y && object.y <= maxY)
+        {
+            expected.push_back(&object);
+        }
+    }
+    std::sort(found.begin(), found.end());
+    std::sort(expected.begin(), expected.end());
+    return found == expected;
+}
+}
+
+void unit_tests::STR_TreeUnitTests::test_EmptyAndSingle()
+{
+    STR_Tree<Object> tree;
+    std::vector<const Object*> found;
+    tree.query(-1e9, -1e9, 1e9, 1e9, found);
+    CPPUNIT_ASSERT(tree.empty());
+    CPPUNIT_ASSERT(found.empty());
+
+    std::vector<Entry> entries;
+    tree.build(entries, 4);
+    CPPUNIT_ASSERT(tree.empty());
+
+    Object object = { 5, 7 };
+    entries.push_back(Entry(object.x, object.y, &object));
+    tree.build(entries, 4);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), tree.size());
+
+    tree.query(5, 7, 5, 7, found);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), found.size());
+    CPPUNIT_ASSERT(found[0] == &object);
+
+    found.clear();
+    tree.query(5.5, 0, 10, 10, found);
+    CPPUNIT_ASSERT(found.empty());
+
+    tree.clear();
+    tree.query(-1e9, -1e9, 1e9, 1e9, found);
+    CPPUNIT_ASSERT(tree.empty());
+    CPPUNIT_ASSERT(found.empty());
+}
+
+void unit_tests::STR_TreeUnitTests::test_QueryMatchesScan()
+{
+    std::srand(42);
+    const std::size_t sizes[] = { 2, 15, 16, 17, 255, 256, 257, 5000, 20011 };
+    const unsigned int threadCounts[] = { 1, 3, 8 };
+    for (std::size_t numObjects : sizes)
+    {
+        for (unsigned int numThreads : threadCounts)
+        {
+            std::vector<Object> objects;
+            std::vector<Entry> entries;
+            makeObjects(numObjects, objects, entries);
+            STR_Tree<Object> tree(8);
+            tree.build(entries, numThreads);
+            CPPUNIT_ASSERT_EQUAL(numObjects, tree.size());
+
+            //the whole area, single points, lines and random rectangles
+            CPPUNIT_ASSERT(queryMatchesScan(tree, objects, 0, 0, 999, 999));
+            for (int i = 0; i < 50; i++)
+            {
+                const Object& object = objects[std::rand() % numObjects];
+                CPPUNIT_ASSERT(queryMatchesScan(tree, objects, object.x, object.y, object.x, object.y));
+                CPPUNIT_ASSERT(queryMatchesScan(tree, objects, object.x, 0, object.x, 999));
+
+                double minX = std::rand() % 1000, minY = std::rand() % 1000;
+                double maxX = minX + std::rand() % 200, maxY = minY + std::rand() % 200;
+                CPPUNIT_ASSERT(queryMatchesScan(tree, objects, minX, minY, maxX, maxY));
+                CPPUNIT_ASSERT(queryMatchesScan(tree, objects, minX - 0.5, minY - 0.5, maxX + 0.5, maxY + 0.5));
+            }
+        }
+    }
+}
+
+void unit_tests::STR_TreeUnitTests::test_Rebuild()
+{
+    std::srand(7);
+    std::vector<Object> first, second;
+    std::vector<Entry> entries;
+    STR_Tree<Object> tree;
+
+    makeObjects(1000, first, entries);
+    tree.build(entries, 2);
+    CPPUNIT_ASSERT(entries.empty());
+
+    makeObjects(300, second, entries);
+    tree.build(entries, 2);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1000), entries.size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(300), tree.size());
+    CPPUNIT_ASSERT(queryMatchesScan(tree, second, 0, 0, 999, 999));
+    CPPUNIT_ASSERT(queryMatchesScan(tree, second, 100, 200, 400, 500));
+}
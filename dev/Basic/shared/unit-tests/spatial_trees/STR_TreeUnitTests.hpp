@@ -0,0 +1,36 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the STR bulk loaded r-tree.
+ */
+class STR_TreeUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test empty trees and trees of a single point.
+    void test_EmptyAndSingle();
+
+    ///Test rectangle queries against a linear scan, for trees of several sizes built with one or more threads.
+    void test_QueryMatchesScan();
+
+    ///Test that rebuilding replaces the indexed points and hands back the previous entries.
+    void test_Rebuild();
+
+private:
+    CPPUNIT_TEST_SUITE(STR_TreeUnitTests);
+        CPPUNIT_TEST(test_EmptyAndSingle);
+        CPPUNIT_TEST(test_QueryMatchesScan);
+        CPPUNIT_TEST(test_Rebuild);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
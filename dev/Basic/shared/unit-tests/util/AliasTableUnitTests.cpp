@@ -0,0 +1,101 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "util/AliasTable.hpp"
+
+#include "AliasTableUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::AliasTableUnitTests);
+
+namespace
+{
+const int NUM_DRAWS = 1000000;
+
+/** draws with random numbers evenly spread over [0, 1) and counts the outcomes */
+std::vector<int> countDraws(const AliasTable& table)
+{
+    std::vector<int> counts(table.size(), 0);
+    for (int n = 0; n < NUM_DRAWS; n++)
+    {
+        counts[table.sample((n + 0.5) / NUM_DRAWS)]++;
+    }
+    return counts;
+}
+}
+
+void unit_tests::AliasTableUnitTests::test_Empty()
+{
+    AliasTable table;
+    CPPUNIT_ASSERT(table.empty());
+
+    table.build(std::vector<double>());
+    CPPUNIT_ASSERT(table.empty());
+
+    table.build(std::vector<double>(5, 0.0));
+    CPPUNIT_ASSERT(table.empty());
+
+    std::vector<double> weights(3, -1.0);
+    weights[1] = std::numeric_limits<double>::quiet_NaN();
+    table.build(weights);
+    CPPUNIT_ASSERT(table.empty());
+
+    table.build(std::vector<double>(1, 2.0));
+    CPPUNIT_ASSERT(!table.empty());
+    table.clear();
+    CPPUNIT_ASSERT(table.empty());
+}
+
+void unit_tests::AliasTableUnitTests::test_Distribution()
+{
+    const double rawWeights[] = { 0.1, 0, 3, 0.25, 0, 7, 1e-3, -2, 1.5, 0 };
+    const std::vector<double> weights(rawWeights, rawWeights + sizeof(rawWeights) / sizeof(rawWeights[0]));
+    double total = 0;
+    for (double weight : weights)
+    {
+        total += (weight > 0) ? weight : 0;
+    }
+
+    AliasTable table;
+    table.build(weights);
+    CPPUNIT_ASSERT_EQUAL(weights.size(), table.size());
+
+    std::vector<int> counts = countDraws(table);
+    for (std::size_t i = 0; i < weights.size(); i++)
+    {
+        if (weights[i] > 0)
+        {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(weights[i] / total, (double) counts[i] / NUM_DRAWS, 1e-5);
+        }
+        else
+        {
+            CPPUNIT_ASSERT_EQUAL(0, counts[i]);
+        }
+    }
+
+    //uniform weights need no aliases
+    table.build(std::vector<double>(4, 0.5));
+    counts = countDraws(table);
+    for (int count : counts)
+    {
+        CPPUNIT_ASSERT_EQUAL(NUM_DRAWS / 4, count);
+    }
+}
+
+void unit_tests::AliasTableUnitTests::test_Bounds()
+{
+    std::vector<double> weights(3, 0.0);
+    weights[2] = 1;
+    AliasTable table;
+    table.build(weights);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), table.sample(0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), table.sample(std::nextafter(1.0, 0.0)));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), table.sample(1.0));
+}
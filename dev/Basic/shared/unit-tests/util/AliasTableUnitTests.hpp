@@ -0,0 +1,36 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the alias table sampler.
+ */
+class AliasTableUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that tables without a positive weight are empty.
+    void test_Empty();
+
+    ///Test that outcomes are drawn in proportion to their weights and outcomes of weight 0 are never drawn.
+    void test_Distribution();
+
+    ///Test draws at the bounds of the random number.
+    void test_Bounds();
+
+private:
+    CPPUNIT_TEST_SUITE(AliasTableUnitTests);
+        CPPUNIT_TEST(test_Empty);
+        CPPUNIT_TEST(test_Distribution);
+        CPPUNIT_TEST(test_Bounds);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,90 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include "util/BoundedQueue.hpp"
+
+#include "BoundedQueueUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::BoundedQueueUnitTests);
+
+namespace
+{
+const int NUM_ITEMS = 10000;
+const int NUM_CONSUMERS = 4;
+
+void produce(BoundedQueue<int>* queue)
+{
+    for (int i = 0; i < NUM_ITEMS; i++)
+    {
+        int item = i;
+        queue->push(item);
+    }
+    queue->close();
+}
+
+void consume(BoundedQueue<int>* queue, std::vector<int>* counts)
+{
+    int item;
+    while (queue->pop(item))
+    {
+        (*counts)[item]++;
+    }
+}
+}
+
+void unit_tests::BoundedQueueUnitTests::test_OrderAndClose()
+{
+    BoundedQueue<std::vector<int> > queue(3);
+    for (int i = 0; i < 3; i++)
+    {
+        std::vector<int> item(1, i);
+        CPPUNIT_ASSERT(queue.push(item));
+    }
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), queue.size());
+
+    std::vector<int> item;
+    CPPUNIT_ASSERT(queue.pop(item));
+    CPPUNIT_ASSERT_EQUAL(0, item.front());
+
+    queue.close();
+    std::vector<int> rejected(1, 3);
+    CPPUNIT_ASSERT(!queue.push(rejected));
+
+    //items pushed before closing are still delivered
+    CPPUNIT_ASSERT(queue.pop(item));
+    CPPUNIT_ASSERT_EQUAL(1, item.front());
+    CPPUNIT_ASSERT(queue.pop(item));
+    CPPUNIT_ASSERT_EQUAL(2, item.front());
+    CPPUNIT_ASSERT(!queue.pop(item));
+}
+
+void unit_tests::BoundedQueueUnitTests::test_ProducerConsumers()
+{
+    BoundedQueue<int> queue(8);
+    std::vector<std::vector<int> > counts(NUM_CONSUMERS, std::vector<int>(NUM_ITEMS, 0));
+
+    boost::thread_group threads;
+    for (int i = 0; i < NUM_CONSUMERS; i++)
+    {
+        threads.create_thread(boost::bind(&consume, &queue, &counts[i]));
+    }
+    threads.create_thread(boost::bind(&produce, &queue));
+    threads.join_all();
+
+    for (int item = 0; item < NUM_ITEMS; item++)
+    {
+        int count = 0;
+        for (int i = 0; i < NUM_CONSUMERS; i++)
+        {
+            count += counts[i][item];
+        }
+        CPPUNIT_ASSERT_EQUAL(1, count);
+    }
+}
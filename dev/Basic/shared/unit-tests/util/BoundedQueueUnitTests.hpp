@@ -0,0 +1,32 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the bounded producer/consumer queue.
+ */
+class BoundedQueueUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that items are popped in the order they were pushed, and that pop fails once the queue is closed and empty.
+    void test_OrderAndClose();
+
+    ///Test that a producer thread and several consumer threads exchange every item exactly once.
+    void test_ProducerConsumers();
+
+private:
+    CPPUNIT_TEST_SUITE(BoundedQueueUnitTests);
+        CPPUNIT_TEST(test_OrderAndClose);
+        CPPUNIT_TEST(test_ProducerConsumers);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,86 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+
+#include "util/Cache.hpp"
+
+#include "CacheUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::CacheUnitTests);
+
+namespace
+{
+
+typedef LRU_Cache<std::string, boost::shared_ptr<std::vector<int> > > VectorCache;
+
+///Every test record has the same size.
+size_t recordSize(const std::vector<int>& value)
+{
+    return value.size() * sizeof(int);
+}
+
+boost::shared_ptr<std::vector<int> > makeValue(int value)
+{
+    return boost::make_shared<std::vector<int> >(100, value);
+}
+
+}
+
+void unit_tests::CacheUnitTests::test_FindAndInsert()
+{
+    VectorCache cache(1024 * 1024, recordSize);
+    boost::shared_ptr<std::vector<int> > value;
+
+    CPPUNIT_ASSERT_MESSAGE("Found a record in an empty cache.", !cache.find("a", value));
+    cache.insert("a", makeValue(1));
+    cache.insert("b", makeValue(2));
+    CPPUNIT_ASSERT_MESSAGE("Inserted record not found.", cache.find("a", value) && (*value)[0] == 1);
+
+    cache.insert("a", makeValue(3));
+    CPPUNIT_ASSERT_MESSAGE("Replaced record not found.", cache.find("a", value) && (*value)[0] == 3);
+    CPPUNIT_ASSERT_EQUAL(2, cache.size());
+
+    const VectorCache::Statistics& stats = cache.getStatistics();
+    CPPUNIT_ASSERT_EQUAL((uint64_t) 2, stats.hits);
+    CPPUNIT_ASSERT_EQUAL((uint64_t) 1, stats.misses);
+    CPPUNIT_ASSERT_EQUAL((uint64_t) 3, stats.insertions);
+    CPPUNIT_ASSERT_EQUAL((uint64_t) 0, stats.evictions);
+}
+
+void unit_tests::CacheUnitTests::test_Eviction()
+{
+    //room for about 10 records
+    VectorCache cache(10 * 500, recordSize);
+    boost::shared_ptr<std::vector<int> > value;
+
+    for (int i = 0; i < 10; i++)
+    {
+        cache.insert(boost::lexical_cast<std::string>(i), makeValue(i));
+        CPPUNIT_ASSERT_MESSAGE("Byte budget exceeded.", cache.getStatistics().bytes <= cache.getCapacity());
+    }
+    CPPUNIT_ASSERT_MESSAGE("Record 0 missing.", cache.find("0", value));
+
+    for (int i = 10; i < 20; i++)
+    {
+        cache.insert(boost::lexical_cast<std::string>(i), makeValue(i));
+        CPPUNIT_ASSERT_MESSAGE("Byte budget exceeded.", cache.getStatistics().bytes <= cache.getCapacity());
+        //keep record 0 in use
+        cache.find("0", value);
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Recently used record evicted.", cache.find("0", value) && (*value)[0] == 0);
+    CPPUNIT_ASSERT_MESSAGE("Least recently used record not evicted.", !cache.find("1", value));
+    CPPUNIT_ASSERT_MESSAGE("No evictions counted.", cache.getStatistics().evictions >= 10);
+
+    VectorCache tiny(100, recordSize);
+    tiny.insert("big", makeValue(0));
+    CPPUNIT_ASSERT_MESSAGE("Oversized record cached.", !tiny.find("big", value));
+    CPPUNIT_ASSERT_EQUAL((uint64_t) 1, tiny.getStatistics().rejections);
+}
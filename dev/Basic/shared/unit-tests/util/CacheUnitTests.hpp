@@ -0,0 +1,32 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the sharded LRU cache.
+ */
+class CacheUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test lookups, replacement and the hit/miss counters.
+    void test_FindAndInsert();
+
+    ///Test that the byte budget is respected and recently used records survive eviction.
+    void test_Eviction();
+
+private:
+    CPPUNIT_TEST_SUITE(CacheUnitTests);
+        CPPUNIT_TEST(test_FindAndInsert);
+        CPPUNIT_TEST(test_Eviction);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,102 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "util/ChunkScheduler.hpp"
+
+#include "ChunkSchedulerUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::ChunkSchedulerUnitTests);
+
+namespace
+{
+const std::size_t NUM_ITEMS = 10007;
+
+/** runs the scheduler over NUM_ITEMS items and counts how many times each item was processed */
+std::vector<int> countClaims(ChunkScheduler& scheduler)
+{
+    std::vector<std::atomic<int> > counts(NUM_ITEMS);
+    for (std::size_t i = 0; i < NUM_ITEMS; i++)
+    {
+        counts[i] = 0;
+    }
+    scheduler.run(NUM_ITEMS, [&counts](ChunkScheduler::Worker& worker)
+    {
+        std::size_t first, last;
+        while (worker.claim(first, last))
+        {
+            for (std::size_t i = first; i < last; i++)
+            {
+                counts[i]++;
+            }
+        }
+    });
+    return std::vector<int>(counts.begin(), counts.end());
+}
+}
+
+void unit_tests::ChunkSchedulerUnitTests::test_AllItemsClaimedOnce()
+{
+    ChunkScheduler singleThreaded(1, 100);
+    std::vector<int> counts = countClaims(singleThreaded);
+    CPPUNIT_ASSERT(counts == std::vector<int>(NUM_ITEMS, 1));
+
+    ChunkScheduler multiThreaded(4, 7);
+    counts = countClaims(multiThreaded);
+    CPPUNIT_ASSERT(counts == std::vector<int>(NUM_ITEMS, 1));
+
+    //the scheduler can be run again
+    counts = countClaims(multiThreaded);
+    CPPUNIT_ASSERT(counts == std::vector<int>(NUM_ITEMS, 1));
+}
+
+void unit_tests::ChunkSchedulerUnitTests::test_Statistics()
+{
+    ChunkScheduler scheduler(3, 10);
+    countClaims(scheduler);
+
+    const std::vector<ChunkScheduler::ThreadStatistics>& statistics = scheduler.getStatistics();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), statistics.size());
+    std::size_t chunks = 0;
+    std::size_t items = 0;
+    for (std::size_t i = 0; i < statistics.size(); i++)
+    {
+        CPPUNIT_ASSERT(statistics[i].busySeconds >= 0);
+        CPPUNIT_ASSERT(statistics[i].idleSeconds >= 0);
+        chunks += statistics[i].chunks;
+        items += statistics[i].items;
+    }
+    CPPUNIT_ASSERT_EQUAL((NUM_ITEMS + 9) / 10, chunks);
+    CPPUNIT_ASSERT_EQUAL(NUM_ITEMS, items);
+}
+
+void unit_tests::ChunkSchedulerUnitTests::test_WorkerException()
+{
+    ChunkScheduler scheduler(4, 10);
+    bool thrown = false;
+    try
+    {
+        scheduler.run(NUM_ITEMS, [](ChunkScheduler::Worker& worker)
+        {
+            if (worker.getThreadNum() == 2)
+            {
+                throw std::runtime_error("worker failure");
+            }
+            std::size_t first, last;
+            while (worker.claim(first, last))
+            {
+            }
+        });
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CPPUNIT_ASSERT(thrown);
+}
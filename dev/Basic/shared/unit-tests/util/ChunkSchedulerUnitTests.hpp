@@ -0,0 +1,36 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the chunked work scheduler.
+ */
+class ChunkSchedulerUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test that every item is claimed exactly once, with one and with several threads.
+    void test_AllItemsClaimedOnce();
+
+    ///Test the per-thread statistics of a run.
+    void test_Statistics();
+
+    ///Test that an exception thrown by a worker is rethrown by run().
+    void test_WorkerException();
+
+private:
+    CPPUNIT_TEST_SUITE(ChunkSchedulerUnitTests);
+        CPPUNIT_TEST(test_AllItemsClaimedOnce);
+        CPPUNIT_TEST(test_Statistics);
+        CPPUNIT_TEST(test_WorkerException);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -0,0 +1,161 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include <cmath>
+#include <vector>
+
+#include "util/CounterRandom.hpp"
+
+#include "CounterRandomUnitTests.hpp"
+
+using namespace sim_mob;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(unit_tests::CounterRandomUnitTests);
+
+namespace
+{
+const int NUM_DRAWS = 200000;
+
+void checkPhilox(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3, uint32_t k0, uint32_t k1,
+                 uint32_t r0, uint32_t r1, uint32_t r2, uint32_t r3)
+{
+    const uint32_t counter[4] = { c0, c1, c2, c3 };
+    const uint32_t key[2] = { k0, k1 };
+    uint32_t result[4];
+    Philox4x32::generate(counter, key, result);
+    CPPUNIT_ASSERT_EQUAL(r0, result[0]);
+    CPPUNIT_ASSERT_EQUAL(r1, result[1]);
+    CPPUNIT_ASSERT_EQUAL(r2, result[2]);
+    CPPUNIT_ASSERT_EQUAL(r3, result[3]);
+}
+}
+
+void unit_tests::CounterRandomUnitTests::test_KnownAnswers()
+{
+    checkPhilox(0, 0, 0, 0, 0, 0, 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8);
+    checkPhilox(0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+                0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd);
+    checkPhilox(0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+                0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1);
+}
+
+void unit_tests::CounterRandomUnitTests::test_Reproducible()
+{
+    CounterRandom first(7, 1001, 30);
+    std::vector<uint32_t> words;
+    for (int i = 0; i < 10; i++)
+    {
+        words.push_back(first.nextUInt32());
+    }
+
+    //the same identifiers give the same words, whatever was drawn from other streams in between
+    CounterRandom second(7, 1001, 30);
+    CounterRandom other(7, 1002, 30);
+    for (int i = 0; i < 10; i++)
+    {
+        other.nextUniform();
+        CPPUNIT_ASSERT_EQUAL(words[i], second.nextUInt32());
+    }
+
+    first.reset(7, 1001, 30);
+    CPPUNIT_ASSERT_EQUAL(words[0], first.nextUInt32());
+
+    //changing any identifier changes the words
+    const uint32_t identifiers[][4] = { { 8, 1001, 30, 0 }, { 7, 1002, 30, 0 }, { 7, 1001, 31, 0 }, { 7, 1001, 30, 1 } };
+    for (const uint32_t* ids : identifiers)
+    {
+        CounterRandom changed(ids[0], ids[1], ids[2], ids[3]);
+        int numEqual = 0;
+        for (int i = 0; i < 10; i++)
+        {
+            numEqual += (changed.nextUInt32() == words[i]) ? 1 : 0;
+        }
+        CPPUNIT_ASSERT(numEqual < 2);
+    }
+}
+
+void unit_tests::CounterRandomUnitTests::test_Distributions()
+{
+    CounterRandom random(1, 2, 3);
+
+    double sum = 0;
+    double sumOfSquares = 0;
+    for (int i = 0; i < NUM_DRAWS; i++)
+    {
+        const double value = random.nextUniform();
+        CPPUNIT_ASSERT(value >= 0 && value < 1);
+        sum += value;
+        sumOfSquares += value * value;
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, sum / NUM_DRAWS, 0.005);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 / 3, sumOfSquares / NUM_DRAWS, 0.005);
+
+    std::vector<int> counts(5, 0);
+    for (int i = 0; i < NUM_DRAWS; i++)
+    {
+        const int value = random.nextInt(-2, 2);
+        CPPUNIT_ASSERT(value >= -2 && value <= 2);
+        counts[value + 2]++;
+    }
+    for (int count : counts)
+    {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, (double) count / NUM_DRAWS, 0.005);
+    }
+    CPPUNIT_ASSERT_EQUAL(4, random.nextInt(4, 4));
+    CPPUNIT_ASSERT_EQUAL(4, random.nextInt(4, 3));
+
+    sum = 0;
+    sumOfSquares = 0;
+    for (int i = 0; i < NUM_DRAWS; i++)
+    {
+        const double value = random.nextNormal(10, 2);
+        sum += value;
+        sumOfSquares += (value - 10) * (value - 10);
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10, sum / NUM_DRAWS, 0.02);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2, std::sqrt(sumOfSquares / NUM_DRAWS), 0.02);
+}
+
+void unit_tests::CounterRandomUnitTests::test_Lognormal()
+{
+    //the reaction time distribution of the driver parameters: mean 0.537, standard deviation 0.20, clamped to [0.25, 1.05]
+    CounterRandom random(4, 5, 6);
+
+    double sum = 0;
+    double sumOfSquares = 0;
+    int numAboveUpper = 0;
+    for (int i = 0; i < NUM_DRAWS; i++)
+    {
+        const double value = random.nextLognormal(0.537, 0.20);
+        CPPUNIT_ASSERT(value > 0);
+        sum += value;
+        sumOfSquares += (value - 0.537) * (value - 0.537);
+        numAboveUpper += (value > 1.05) ? 1 : 0;
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.537, sum / NUM_DRAWS, 0.005);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.20, std::sqrt(sumOfSquares / NUM_DRAWS), 0.005);
+    CPPUNIT_ASSERT((double) numAboveUpper / NUM_DRAWS < 0.03);
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, random.nextLognormal(2.5, 0), 1e-12);
+}
+
+void unit_tests::CounterRandomUnitTests::test_Fill()
+{
+    CounterRandom filled(3, 4, 5);
+    CounterRandom repeated(3, 4, 5);
+
+    std::vector<double> values(7);
+    filled.fillUniform(values.begin(), values.size());
+    for (double value : values)
+    {
+        CPPUNIT_ASSERT_EQUAL(repeated.nextUniform(), value);
+    }
+
+    filled.fillNormal(values.begin(), values.size(), 1, 3);
+    for (double value : values)
+    {
+        CPPUNIT_ASSERT_EQUAL(repeated.nextNormal(1, 3), value);
+    }
+    CPPUNIT_ASSERT_EQUAL(repeated.nextUInt32(), filled.nextUInt32());
+}
@@ -0,0 +1,44 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace unit_tests
+{
+
+/**
+ * Unit Tests for the counter based random number streams.
+ */
+class CounterRandomUnitTests : public CppUnit::TestFixture
+{
+public:
+    ///Test the Philox4x32-10 generator against the known answers of its reference implementation.
+    void test_KnownAnswers();
+
+    ///Test that a stream depends only on its identifiers and draw index.
+    void test_Reproducible();
+
+    ///Test the range and the moments of the uniform, integer and normal draws.
+    void test_Distributions();
+
+    ///Test that the log-normal draws have the mean and standard deviation they are given.
+    void test_Lognormal();
+
+    ///Test that filling draws the same numbers as repeated calls.
+    void test_Fill();
+
+private:
+    CPPUNIT_TEST_SUITE(CounterRandomUnitTests);
+        CPPUNIT_TEST(test_KnownAnswers);
+        CPPUNIT_TEST(test_Reproducible);
+        CPPUNIT_TEST(test_Distributions);
+        CPPUNIT_TEST(test_Lognormal);
+        CPPUNIT_TEST(test_Fill);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+}
@@ -661,6 +661,42 @@ void unit_tests::WorkerUnitTests::test_MultiGroupInteraction()
 }
 
 
+void unit_tests::WorkerUnitTests::test_WorkStealing()
+{
+    //The scheduler is created in initWorkers(), based on the configured strategy.
+    WorkGroup::ASSIGNMENT_STRATEGY& strategy = ConfigManager::GetInstanceRW().FullConfig().defaultWrkGrpAssignment();
+    WorkGroup::ASSIGNMENT_STRATEGY oldStrategy = strategy;
+    strategy = WorkGroup::ASSIGN_WORKSTEALING;
+
+    WorkGroupManager wgm;
+    WorkGroup* agentWG = wgm.newWorkGroup(4, 6);
+    wgm.initAllGroups();
+    agentWG->initWorkers(nullptr);
+
+    //Pin every Agent on the first Worker; the remaining Workers can only get work by stealing.
+    vector<AddTickDivisibleAgent*> agents;
+    for (int i=0; i<50; i++) {
+        AddTickDivisibleAgent* ag = new AddTickDivisibleAgent(1);
+        ag->setStartTime(0);
+        agentWG->assignWorker(ag, 0);
+        agents.push_back(ag);
+    }
+
+    wgm.startAllWorkGroups();
+    for (int i=0; i<6; i++) {
+        wgm.waitAllGroups();
+    }
+    strategy = oldStrategy;
+
+    //Each Agent must have been updated (and flipped) exactly once per tick: 0+1+2+3+4+5
+    bool error = false;
+    for (vector<AddTickDivisibleAgent*>::iterator it=agents.begin(); it!=agents.end(); it++) {
+        if ((*it)->value.get() != 15) { error = true; break; }
+    }
+    CPPUNIT_ASSERT_MESSAGE("Work stealing updated an Agent more or less than once per tick.", !error);
+}
+
+
 //Magic
 #undef IGNORE_AGENT_FRAME_FUNCTIONS
 
@@ -38,6 +38,10 @@ public:
     // (to avoid accidentally correct answers).
     void test_MultiGroupInteraction();
 
+    ///Test that Agents all owned by one Worker are updated exactly once per tick when the other
+    /// Workers steal their updates.
+    void test_WorkStealing();
+
 
 private:
     CPPUNIT_TEST_SUITE(WorkerUnitTests);
@@ -47,6 +51,7 @@ private:
         CPPUNIT_TEST(test_AgentStartTimes);
         CPPUNIT_TEST(test_UpdatePhases);
         CPPUNIT_TEST(test_MultiGroupInteraction);
+        CPPUNIT_TEST(test_WorkStealing);
     CPPUNIT_TEST_SUITE_END();
 };
 
@@ -0,0 +1,88 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "AliasTable.hpp"
+
+using namespace sim_mob;
+
+AliasTable::AliasTable()
+{
+}
+
+void AliasTable::build(const std::vector<double>& weights)
+{
+    clear();
+
+    const std::size_t numOutcomes = weights.size();
+    double total = 0;
+    std::size_t firstPositive = numOutcomes;
+    for (std::size_t i = 0; i < numOutcomes; i++)
+    {
+        if (weights[i] > 0)
+        {
+            total += weights[i];
+            if (firstPositive == numOutcomes)
+            {
+                firstPositive = i;
+            }
+        }
+    }
+    if (!(total > 0))
+    {
+        return;
+    }
+
+    //scale the weights so that their average is 1 and split them into columns under and over the average
+    std::vector<double> scaled(numOutcomes);
+    std::vector<uint32_t> small, large;
+    small.reserve(numOutcomes);
+    large.reserve(numOutcomes);
+    for (std::size_t i = 0; i < numOutcomes; i++)
+    {
+        scaled[i] = (weights[i] > 0) ? weights[i] * numOutcomes / total : 0;
+        if (scaled[i] < 1)
+        {
+            small.push_back(i);
+        }
+        else
+        {
+            large.push_back(i);
+        }
+    }
+
+    //fill each small column up to 1 with the excess of a large column
+    threshold.resize(numOutcomes);
+    alias.resize(numOutcomes);
+    while (!small.empty() && !large.empty())
+    {
+        const uint32_t lessProbable = small.back();
+        small.pop_back();
+        const uint32_t moreProbable = large.back();
+
+        threshold[lessProbable] = scaled[lessProbable];
+        alias[lessProbable] = moreProbable;
+
+        scaled[moreProbable] = (scaled[moreProbable] + scaled[lessProbable]) - 1;
+        if (scaled[moreProbable] < 1)
+        {
+            large.pop_back();
+            small.push_back(moreProbable);
+        }
+    }
+
+    //the remaining columns are full up to rounding errors; outcomes of weight 0 must still never be drawn
+    small.insert(small.end(), large.begin(), large.end());
+    for (uint32_t column : small)
+    {
+        const bool possible = weights[column] > 0;
+        threshold[column] = possible ? 1 : 0;
+        alias[column] = possible ? column : firstPositive;
+    }
+}
+
+void AliasTable::clear()
+{
+    threshold.clear();
+    alias.clear();
+}
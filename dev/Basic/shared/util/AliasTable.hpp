@@ -0,0 +1,83 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+namespace sim_mob
+{
+
+/**
+ * Walker's alias table for drawing from a fixed discrete distribution in constant time.
+ *
+ * The table is built once from (not necessarily normalised) weights in O(n) (Vose's method). Each draw then takes a
+ * single uniform random number: its integer part selects a column, its fractional part selects either the column
+ * itself or the column's alias. Thresholds are stored as float, i.e. the table takes 8 bytes per outcome.
+ *
+ * A built table is read-only, so it may be sampled concurrently; the random number is supplied by the caller.
+ */
+class AliasTable
+{
+public:
+    AliasTable();
+
+    /**
+     * Builds the table
+     *
+     * @param weights weights of the outcomes; negative and NaN weights are treated as 0.
+     *          If no weight is positive, the table is left empty.
+     */
+    void build(const std::vector<double>& weights);
+
+    /**
+     * Draws an outcome
+     *
+     * @param uniform random number uniformly distributed in [0, 1)
+     *
+     * @return index of the outcome; must not be called on an empty table
+     */
+    std::size_t sample(double uniform) const
+    {
+        const double scaled = uniform * threshold.size();
+        std::size_t column = static_cast<std::size_t>(scaled);
+        if (column >= threshold.size())
+        {
+            column = threshold.size() - 1;
+        }
+        return (scaled - column < threshold[column]) ? column : alias[column];
+    }
+
+    /**
+     * Empties the table
+     */
+    void clear();
+
+    /**
+     * @return true if the table has no outcome to draw
+     */
+    bool empty() const
+    {
+        return threshold.empty();
+    }
+
+    /**
+     * @return number of outcomes (including outcomes of weight 0)
+     */
+    std::size_t size() const
+    {
+        return threshold.size();
+    }
+
+private:
+    /** probability of keeping the column rather than taking its alias */
+    std::vector<float> threshold;
+
+    /** alias of each column */
+    std::vector<uint32_t> alias;
+};
+
+}
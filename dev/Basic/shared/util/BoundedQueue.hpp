@@ -0,0 +1,107 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <deque>
+#include <boost/thread.hpp>
+#include <boost/utility.hpp>
+
+namespace sim_mob
+{
+
+/**
+ * FIFO queue of bounded capacity to hand items from producer threads to consumer threads.
+ *
+ * push() blocks while the queue is full and pop() blocks while it is empty, so that producers cannot run arbitrarily
+ * far ahead of the consumers. Once close() is called, pushes are ignored and pop() returns false as soon as the
+ * remaining items have been consumed.
+ */
+template<typename T>
+class BoundedQueue : private boost::noncopyable
+{
+public:
+    /**
+     * @param capacity maximum number of items in the queue; a capacity of 0 is treated as 1
+     */
+    explicit BoundedQueue(std::size_t capacity) : capacity(capacity > 0 ? capacity : 1), closed(false)
+    {
+    }
+
+    /**
+     * Adds an item at the back of the queue, waiting while the queue is full
+     * @param item the item; moved into the queue
+     * @return true if added; false if the queue was closed
+     */
+    bool push(T& item)
+    {
+        boost::unique_lock<boost::mutex> lock(mutex);
+        while (items.size() >= capacity && !closed)
+        {
+            notFull.wait(lock);
+        }
+        if (closed)
+        {
+            return false;
+        }
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * Removes the item at the front of the queue, waiting while the queue is empty and open
+     * @param item output item
+     * @return true if an item was removed; false if the queue is closed and empty
+     */
+    bool pop(T& item)
+    {
+        boost::unique_lock<boost::mutex> lock(mutex);
+        while (items.empty() && !closed)
+        {
+            notEmpty.wait(lock);
+        }
+        if (items.empty())
+        {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    /**
+     * Closes the queue and wakes up all waiting threads
+     */
+    void close()
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    bool isClosed() const
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        return closed;
+    }
+
+    std::size_t size() const
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        return items.size();
+    }
+
+private:
+    const std::size_t capacity;
+    bool closed;
+    std::deque<T> items;
+    mutable boost::mutex mutex;
+    boost::condition_variable notEmpty;
+    boost::condition_variable notFull;
+};
+
+}
@@ -1,7 +1,13 @@
+#pragma once
+
 #include <cassert>
 #include <list>
-#include <map>
+#include <utility>
+#include <stdint.h>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
 
 namespace sim_mob
 {
@@ -11,22 +17,71 @@ template <typename KEY, typename VAL> class Cache;
 /// Template class for Least Recently Used Caching Policy(LRU)
 template <typename KEY, typename VAL> class LRU_Cache : public Cache<KEY,VAL>{};
 
-/// Specialization of LRU template class for the VAL type to accept shared_ptr only
+/// Default estimate of the memory held by a cached value; values owning heap memory should supply their own estimate
+template <typename VAL>
+struct CacheEntrySize
+{
+    size_t operator()(const VAL&) const
+    {
+        return sizeof(VAL);
+    }
+};
+
+/**
+ * Specialization of LRU template class for the VAL type to accept shared_ptr only
+ *
+ * The capacity is a budget in bytes, as estimated by a size function for each value; the least recently used records
+ * are evicted until a new record fits.
+ *
+ * The cache is not thread safe. It is meant to be owned by a single thread (e.g. by a per-thread route choice context),
+ * so its budget applies to each owner separately.
+ */
 template <typename K, typename VAL>
-class LRU_Cache<K, boost::shared_ptr<VAL> >
+class LRU_Cache<K, boost::shared_ptr<VAL> > : private boost::noncopyable
 {
 public:
     typedef K KeyType;
     typedef boost::shared_ptr<VAL> ValueType;
 
-    // Key access history, most recent at back
-    typedef std::list<KeyType> KeyTrackerType;
+    /// Estimates the memory held by a value, in bytes
+    typedef boost::function<size_t (const VAL&)> SizeFunction;
+
+    /// Cache usage counters
+    struct Statistics
+    {
+        Statistics() : hits(0), misses(0), insertions(0), evictions(0), rejections(0), entries(0), bytes(0)
+        {
+        }
+
+        /// Number of successful lookups
+        uint64_t hits;
 
-    // Key to value and key history iterator
-    typedef std::map<KeyType, std::pair<ValueType, typename KeyTrackerType::iterator> > KeyToValueType;
+        /// Number of failed lookups
+        uint64_t misses;
 
-    /// Constuctor specifies the cached function and the maximum number of records to be stored
-    LRU_Cache(size_t c) : capacity(c)
+        /// Number of records inserted
+        uint64_t insertions;
+
+        /// Number of records evicted to make space
+        uint64_t evictions;
+
+        /// Number of records not cached because they are larger than the cache
+        uint64_t rejections;
+
+        /// Number of records currently cached
+        size_t entries;
+
+        /// Estimated memory held by the cached records
+        size_t bytes;
+    };
+
+    /**
+     * Constructor
+     *
+     * @param capacityBytes maximum memory to be held by the cached records, in bytes
+     * @param sizeOf estimates the memory held by a value
+     */
+    LRU_Cache(size_t capacityBytes, const SizeFunction& sizeOf = CacheEntrySize<VAL>()) : capacity(capacityBytes), sizeOf(sizeOf)
     {
         assert(capacity!=0);
     }
@@ -34,77 +89,132 @@ public:
     /// Obtain value of the cached function for k
     bool find(const KeyType& key, ValueType & value)
     {
-        boost::shared_lock<boost::shared_mutex> lock(mutex_);
-
         // Attempt to find existing record
-        const typename KeyToValueType::iterator it = keyToValue.find(key);
+        const typename KeyToRecordType::iterator it = keyToRecord.find(key);
 
-        if (it==keyToValue.end())
+        if (it==keyToRecord.end())
         {
+            stats.misses++;
             return false;
         }
         else
         {
-            // Update access record by moving accessed key to back of list
-            keyTracker.splice(keyTracker.end(), keyTracker, (*it).second.second);
+            // Update access record by moving accessed record to back of list
+            records.splice(records.end(), records, it->second);
 
             // Return the retrieved value
-            value = (*it).second.first;
+            value = it->second->value;
+            stats.hits++;
             return true;
         }
     }
 
-    /// Record a fresh key-value pair in the cache
+    /// Record a fresh key-value pair in the cache, replacing any existing record for the key
     void insert(const KeyType& k,const ValueType& v)
     {
-        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        const size_t bytes = sizeof(Record) + k.size() + (v ? sizeOf(*v) : 0);
+
+        typename KeyToRecordType::iterator it = keyToRecord.find(k);
+        if (it != keyToRecord.end())
+        {
+            erase(it);
+        }
+
+        if (bytes > capacity)
+        {
+            stats.rejections++;
+            return;
+        }
 
         // Make space if necessary
-        if (keyToValue.size()==capacity)
+        while (stats.bytes + bytes > capacity)
         {
             evict();
         }
 
         // Record k as most-recently-used key
-        typename KeyTrackerType::iterator it = keyTracker.insert(keyTracker.end(),k);
+        records.push_back(Record(k, v, bytes));
+        typename RecordListType::iterator record = records.end();
+        --record;
+        keyToRecord.insert(std::make_pair(k, record));
+        stats.bytes += bytes;
+        stats.entries++;
+        stats.insertions++;
+    }
+
+    /// Number of records currently cached
+    int size() const
+    {
+        return stats.entries;
+    }
 
-        // Create the key-value entry,
-        // linked to the usage record.
-        keyToValue.insert( std::make_pair(k, std::make_pair(v,it)) );
-        // No need to check return,
-        // given previous assert.
+    /// Maximum memory to be held by the cached records, in bytes
+    size_t getCapacity() const
+    {
+        return capacity;
     }
 
-    int size()
+    /// Usage counters
+    const Statistics& getStatistics() const
     {
-        return keyToValue.size();
+        return stats;
     }
 
 private:
-    /// Purge the least-recently-used element in the cache
+    /// A cached record
+    struct Record
+    {
+        Record(const KeyType& key, const ValueType& value, size_t bytes) : key(key), value(value), bytes(bytes)
+        {
+        }
+
+        KeyType key;
+        ValueType value;
+
+        /// Estimated memory held by the record
+        size_t bytes;
+    };
+
+    // Records in access order, most recent at back
+    typedef std::list<Record> RecordListType;
+
+    // Key to record lookup
+    typedef boost::unordered_map<KeyType, typename RecordListType::iterator> KeyToRecordType;
+
+    /// Purge a record
+    void erase(typename KeyToRecordType::iterator it)
+    {
+        stats.bytes -= it->second->bytes;
+        stats.entries--;
+        records.erase(it->second);
+        keyToRecord.erase(it);
+    }
+
+    /// Purge the least-recently-used record in the cache
     void evict()
     {
         // Assert method is never called when cache is empty
-        assert(!keyTracker.empty());
-
-        // Identify least recently used key
-        const typename KeyToValueType::iterator it = keyToValue.find(keyTracker.front());
-        assert(it!=keyToValue.end());
-        // Erase both elements to completely purge record
-        keyToValue.erase(it);
-        keyTracker.pop_front();
+        assert(!records.empty());
+
+        const typename KeyToRecordType::iterator it = keyToRecord.find(records.front().key);
+        assert(it!=keyToRecord.end());
+        erase(it);
+        stats.evictions++;
     }
 
-    /// Maximum number of key-value pairs to be retained
+    /// Maximum memory to be held by the cached records
     const size_t capacity;
 
-    /// Key access history
-    KeyTrackerType keyTracker;
+    /// Estimates the memory held by a value
+    SizeFunction sizeOf;
+
+    /// Records in access order
+    RecordListType records;
 
-    /// Key-to-value lookup
-    KeyToValueType keyToValue;
+    /// Key-to-record lookup
+    KeyToRecordType keyToRecord;
 
-    /// protector
-    boost::shared_mutex mutex_;
+    /// Usage counters
+    Statistics stats;
 };
 }//namespace
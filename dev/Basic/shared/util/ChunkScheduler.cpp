@@ -0,0 +1,128 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "ChunkScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <boost/thread.hpp>
+
+using namespace sim_mob;
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+double secondsBetween(const Clock::time_point& start, const Clock::time_point& end)
+{
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/** state of one thread of a run */
+struct WorkerRun
+{
+    WorkerRun() : finished()
+    {
+    }
+
+    Clock::time_point finished;
+    std::exception_ptr error;
+};
+
+void runWorker(const ChunkScheduler::WorkerFunction& workerFunction, ChunkScheduler::Worker& worker, WorkerRun& workerRun,
+        std::atomic<bool>& failed)
+{
+    try
+    {
+        workerFunction(worker);
+    }
+    catch (...)
+    {
+        workerRun.error = std::current_exception();
+        failed = true;
+    }
+    workerRun.finished = Clock::now();
+}
+}
+
+ChunkScheduler::Worker::Worker(ChunkScheduler& scheduler, std::size_t threadNum) :
+        scheduler(scheduler), threadNum(threadNum), chunks(0), items(0)
+{
+}
+
+bool ChunkScheduler::Worker::claim(std::size_t& first, std::size_t& last)
+{
+    first = scheduler.nextItem.fetch_add(scheduler.chunkSize);
+    if (first >= scheduler.numItems)
+    {
+        return false;
+    }
+    last = std::min(first + scheduler.chunkSize, scheduler.numItems);
+    chunks++;
+    items += last - first;
+    return true;
+}
+
+ChunkScheduler::ChunkScheduler(std::size_t numThreads, std::size_t chunkSize) :
+        numThreads(std::max<std::size_t>(numThreads, 1)), chunkSize(std::max<std::size_t>(chunkSize, 1)), numItems(0),
+        nextItem(0)
+{
+}
+
+void ChunkScheduler::run(std::size_t numItems, const WorkerFunction& workerFunction)
+{
+    this->numItems = numItems;
+    nextItem = 0;
+
+    std::vector<std::unique_ptr<Worker> > workers;
+    std::vector<WorkerRun> workerRuns(numThreads);
+    std::atomic<bool> failed(false);
+    for (std::size_t i = 0; i < numThreads; i++)
+    {
+        workers.push_back(std::unique_ptr<Worker>(new Worker(*this, i)));
+    }
+
+    const Clock::time_point started = Clock::now();
+    if (numThreads == 1)
+    {
+        runWorker(workerFunction, *workers[0], workerRuns[0], failed);
+    }
+    else
+    {
+        boost::thread_group threadGroup;
+        for (std::size_t i = 0; i < numThreads; i++)
+        {
+            threadGroup.create_thread([&, i]()
+            {
+                runWorker(workerFunction, *workers[i], workerRuns[i], failed);
+                if (failed)
+                {
+                    // stop handing out items so that the other threads finish early
+                    nextItem = this->numItems;
+                }
+            });
+        }
+        threadGroup.join_all();
+    }
+    const Clock::time_point ended = Clock::now();
+
+    statistics.assign(numThreads, ThreadStatistics());
+    for (std::size_t i = 0; i < numThreads; i++)
+    {
+        statistics[i].busySeconds = secondsBetween(started, workerRuns[i].finished);
+        statistics[i].idleSeconds = secondsBetween(workerRuns[i].finished, ended);
+        statistics[i].chunks = workers[i]->chunks;
+        statistics[i].items = workers[i]->items;
+    }
+
+    for (std::size_t i = 0; i < numThreads; i++)
+    {
+        if (workerRuns[i].error)
+        {
+            std::rethrow_exception(workerRuns[i].error);
+        }
+    }
+}
@@ -0,0 +1,144 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <boost/function.hpp>
+#include <boost/utility.hpp>
+
+namespace sim_mob
+{
+
+/**
+ * Distributes the items of a list, identified by their index, to a group of threads in small chunks claimed on
+ * demand, so that threads which get cheaper items simply process more of them instead of waiting for the others.
+ *
+ * Each thread runs the worker function once; the function does its own set up (e.g. database connections) and then
+ * claims chunks until none are left:
+ *
+ *     scheduler.run(numItems, [&](ChunkScheduler::Worker& worker)
+ *     {
+ *         std::size_t first, last;
+ *         while (worker.claim(first, last))
+ *         {
+ *             for (std::size_t i = first; i < last; i++) { ... }
+ *         }
+ *     });
+ *
+ * After each run, the time each thread spent in the worker function (busy) and waiting for the other threads to
+ * finish (idle) is available from getStatistics(), to tune the chunk size.
+ */
+class ChunkScheduler : private boost::noncopyable
+{
+public:
+    /**
+     * Handle of one thread of a run, to claim chunks of items
+     */
+    class Worker
+    {
+    public:
+        /**
+         * Claims the next chunk of items. Thread safe, so that the thread may hand the claims over to a helper thread
+         * (e.g. a loader thread fetching the items).
+         *
+         * @param first output index of the first item of the chunk
+         * @param last output index past the last item of the chunk
+         * @return true if a chunk was claimed; false if all items have been claimed
+         */
+        bool claim(std::size_t& first, std::size_t& last);
+
+        /**
+         * @return index of the thread within the run, in [0, number of threads)
+         */
+        std::size_t getThreadNum() const
+        {
+            return threadNum;
+        }
+
+    private:
+        friend class ChunkScheduler;
+
+        Worker(ChunkScheduler& scheduler, std::size_t threadNum);
+
+        ChunkScheduler& scheduler;
+        std::size_t threadNum;
+        std::atomic<std::size_t> chunks;
+        std::atomic<std::size_t> items;
+    };
+
+    /** statistics of one thread in the last run */
+    struct ThreadStatistics
+    {
+        ThreadStatistics() : busySeconds(0), idleSeconds(0), chunks(0), items(0)
+        {
+        }
+
+        /// time spent in the worker function
+        double busySeconds;
+
+        /// time between the end of the worker function and the end of the run
+        double idleSeconds;
+
+        /// number of chunks claimed
+        std::size_t chunks;
+
+        /// number of items claimed
+        std::size_t items;
+    };
+
+    typedef boost::function<void (Worker& worker)> WorkerFunction;
+
+    /**
+     * @param numThreads number of threads processing the items; 0 is treated as 1
+     * @param chunkSize number of items claimed at a time; 0 is treated as 1
+     */
+    ChunkScheduler(std::size_t numThreads, std::size_t chunkSize);
+
+    /**
+     * Runs the worker function on each thread and waits until all threads have finished. With a single thread, the
+     * worker function runs on the calling thread.
+     *
+     * If a worker function throws, the remaining items are no longer handed out and the first exception is rethrown
+     * once all threads have finished.
+     *
+     * @param numItems number of items to distribute
+     * @param workerFunction function run by each thread
+     */
+    void run(std::size_t numItems, const WorkerFunction& workerFunction);
+
+    std::size_t getNumThreads() const
+    {
+        return numThreads;
+    }
+
+    std::size_t getChunkSize() const
+    {
+        return chunkSize;
+    }
+
+    /**
+     * @return statistics of each thread in the last run, indexed by thread number
+     */
+    const std::vector<ThreadStatistics>& getStatistics() const
+    {
+        return statistics;
+    }
+
+private:
+    const std::size_t numThreads;
+    const std::size_t chunkSize;
+
+    /// number of items of the current run
+    std::size_t numItems;
+
+    /// index of the next item to hand out
+    std::atomic<std::size_t> nextItem;
+
+    std::vector<ThreadStatistics> statistics;
+};
+
+}
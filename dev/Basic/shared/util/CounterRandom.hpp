@@ -0,0 +1,243 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <stdint.h>
+
+namespace sim_mob
+{
+
+/**
+ * The Philox4x32-10 counter based random number generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+ *
+ * Maps a 128 bit counter and a 64 bit key to 128 random bits with no state, so that any draw of any stream can be
+ * computed directly from its key and position.
+ */
+struct Philox4x32
+{
+    /**
+     * @param counter the counter
+     * @param key the key
+     * @param result output random words
+     */
+    static void generate(const uint32_t counter[4], const uint32_t key[2], uint32_t result[4])
+    {
+        uint32_t ctr[4] = { counter[0], counter[1], counter[2], counter[3] };
+        uint32_t k[2] = { key[0], key[1] };
+        for (int round = 0; round < 10; round++)
+        {
+            if (round > 0)
+            {
+                k[0] += 0x9E3779B9;
+                k[1] += 0xBB67AE85;
+            }
+            const uint64_t product0 = (uint64_t) 0xD2511F53 * ctr[0];
+            const uint64_t product1 = (uint64_t) 0xCD9E8D57 * ctr[2];
+            const uint32_t next[4] = { (uint32_t) (product1 >> 32) ^ ctr[1] ^ k[0], (uint32_t) product1,
+                                       (uint32_t) (product0 >> 32) ^ ctr[3] ^ k[1], (uint32_t) product0 };
+            ctr[0] = next[0];
+            ctr[1] = next[1];
+            ctr[2] = next[2];
+            ctr[3] = next[3];
+        }
+        result[0] = ctr[0];
+        result[1] = ctr[1];
+        result[2] = ctr[2];
+        result[3] = ctr[3];
+    }
+};
+
+/**
+ * Stream of random numbers identified by (seed, id, tick, stream) rather than by a generator state.
+ *
+ * The n-th number of a stream depends only on the identifiers and n, so an agent that resets its stream with its id
+ * and the current tick draws the same numbers whichever thread updates it and whatever the other agents draw.
+ * Creating or resetting a stream is cheap (no state is seeded), and there is no shared or thread local state.
+ *
+ * The draws of a stream must be made in a fixed order for the results to be reproducible; the number of words each
+ * method consumes is fixed, except for nextInt(), which may reject a few draws to remain unbiased.
+ */
+class CounterRandom
+{
+public:
+    CounterRandom()
+    {
+        reset(0, 0, 0);
+    }
+
+    /**
+     * @param seed seed of the simulation
+     * @param id id of the owner (e.g. the agent id)
+     * @param tick time tick of the draws
+     * @param stream distinguishes several streams of the same owner and tick
+     */
+    CounterRandom(uint32_t seed, uint32_t id, uint32_t tick, uint32_t stream = 0)
+    {
+        reset(seed, id, tick, stream);
+    }
+
+    /**
+     * Restarts the stream at its first draw
+     *
+     * @param seed seed of the simulation
+     * @param id id of the owner (e.g. the agent id)
+     * @param tick time tick of the draws
+     * @param stream distinguishes several streams of the same owner and tick
+     */
+    void reset(uint32_t seed, uint32_t id, uint32_t tick, uint32_t stream = 0)
+    {
+        key[0] = seed;
+        key[1] = id;
+        counter[0] = 0;
+        counter[1] = 0;
+        counter[2] = tick;
+        counter[3] = stream;
+        numBuffered = 0;
+    }
+
+    /**
+     * @return a random 32 bit word
+     */
+    uint32_t nextUInt32()
+    {
+        if (numBuffered == 0)
+        {
+            Philox4x32::generate(counter, key, buffer);
+            if (++counter[0] == 0)
+            {
+                ++counter[1];
+            }
+            numBuffered = 4;
+        }
+        return buffer[4 - numBuffered--];
+    }
+
+    /**
+     * @return a double uniformly distributed in [0, 1), with 53 random bits; consumes 2 words
+     */
+    double nextUniform()
+    {
+        const uint32_t high = nextUInt32() >> 5;
+        const uint32_t low = nextUInt32() >> 6;
+        return (high * 67108864.0 + low) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @param min lower bound
+     * @param max upper bound
+     * @return a double uniformly distributed in [min, max); consumes 2 words
+     */
+    double nextUniform(double min, double max)
+    {
+        return min + (max - min) * nextUniform();
+    }
+
+    /**
+     * @param min lower bound (included)
+     * @param max upper bound (included)
+     * @return an integer uniformly distributed in [min, max]; min if max < min
+     */
+    int nextInt(int min, int max)
+    {
+        if (max <= min)
+        {
+            return min;
+        }
+        const uint64_t range = (uint64_t) ((int64_t) max - min) + 1;
+        if (range > 0xFFFFFFFFull)
+        {
+            return (int) ((int64_t) min + nextUInt32());
+        }
+
+        //reject the lowest words, so that every value has as many words mapped to it
+        const uint32_t threshold = (uint32_t) ((0x100000000ull - range) % range);
+        uint32_t word = nextUInt32();
+        while (word < threshold)
+        {
+            word = nextUInt32();
+        }
+        return (int) ((int64_t) min + word % range);
+    }
+
+    /**
+     * @param mean mean of the distribution
+     * @param stddev standard deviation of the distribution
+     * @return a normally distributed double (Box-Muller transform); consumes 4 words
+     */
+    double nextNormal(double mean, double stddev)
+    {
+        const double u1 = 1.0 - nextUniform();
+        const double u2 = nextUniform();
+        return mean + stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+    /**
+     * The parameters are the moments of the distribution itself, as for boost::lognormal_distribution, and are
+     * converted to the moments of its logarithm
+     * @param mean mean of the distribution (positive)
+     * @param stddev standard deviation of the distribution
+     * @return a log-normally distributed double; consumes 4 words
+     */
+    double nextLognormal(double mean, double stddev)
+    {
+        const double sigma = std::sqrt(std::log(1.0 + (stddev * stddev) / (mean * mean)));
+        const double mu = std::log(mean) - sigma * sigma / 2.0;
+        return std::exp(nextNormal(mu, sigma));
+    }
+
+    /**
+     * @param probability probability of true
+     * @return true with the given probability; consumes 2 words
+     */
+    bool nextBernoulli(double probability)
+    {
+        return nextUniform() < probability;
+    }
+
+    /**
+     * Draws several doubles uniformly distributed in [0, 1), as repeated calls to nextUniform() would
+     * @param result output doubles
+     * @param count number of doubles
+     */
+    template<typename OutputIterator>
+    void fillUniform(OutputIterator result, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++, ++result)
+        {
+            *result = nextUniform();
+        }
+    }
+
+    /**
+     * Draws several normally distributed doubles, as repeated calls to nextNormal() would
+     * @param result output doubles
+     * @param count number of doubles
+     * @param mean mean of the distribution
+     * @param stddev standard deviation of the distribution
+     */
+    template<typename OutputIterator>
+    void fillNormal(OutputIterator result, std::size_t count, double mean, double stddev)
+    {
+        for (std::size_t i = 0; i < count; i++, ++result)
+        {
+            *result = nextNormal(mean, stddev);
+        }
+    }
+
+private:
+    /**seed and owner id*/
+    uint32_t key[2];
+
+    /**index of the next block of 4 words (over the first 2 words), tick and stream*/
+    uint32_t counter[4];
+
+    /**words of the current block; the last numBuffered of them are yet to be drawn*/
+    uint32_t buffer[4];
+    unsigned int numBuffered;
+};
+
+}
@@ -138,6 +138,7 @@ sim_mob::BasicLogger::~BasicLogger(){
         std::cout << "~BasicLogger() " << id << std::endl;
     }
     flush();
+    logSink.reset();
     if (logFile.is_open()) {
         logFile.close();
     }
@@ -145,12 +146,21 @@ sim_mob::BasicLogger::~BasicLogger(){
 }
 
 std::stringstream * sim_mob::BasicLogger::getOut(bool renew){
-    boost::upgrade_lock<boost::shared_mutex> lock(mutexOutput);
     std::stringstream *res = nullptr;
     outIt it;
     boost::thread::id id = boost::this_thread::get_id();
+    if (!renew)
+    {
+        //buffers are only added (or replaced by their own thread), so finding an existing one only needs a shared lock
+        boost::shared_lock<boost::shared_mutex> lock(mutexOutput);
+        if ((it = out.find(id)) != out.end())
+        {
+            return it->second;
+        }
+    }
+
+    boost::unique_lock<boost::shared_mutex> lock(mutexOutput);
     if((it = out.find(id)) == out.end()){
-        boost::upgrade_to_unique_lock<boost::shared_mutex> lock2(lock);
         res = new std::stringstream();
         out.insert(std::make_pair(id, res));
         if(this->id == std::string("realtime_travel_time"))
@@ -160,7 +170,6 @@ std::stringstream * sim_mob::BasicLogger::getOut(bool renew){
     }
     else
     {
-        boost::upgrade_to_unique_lock<boost::shared_mutex> lock2(lock);
         res = it->second;
         if (renew)
         {
@@ -192,18 +201,19 @@ sim_mob::Profiler & sim_mob::BasicLogger::prof(const std::string id, bool timer)
 void  sim_mob::BasicLogger::initLogFile(const std::string& path)
 {
     logFile.open(path.c_str());
+    if (logFile.is_open())
+    {
+        logSink.reset(new AsyncLogSink(logFile));
+    }
 }
 
 void sim_mob::BasicLogger::flushLog(std::stringstream &out)
 {
-    if ((logFile.is_open() && logFile.good()))
+    if (logSink)
     {
-        {
-            boost::unique_lock<boost::mutex> lock(flushMutex);
-            logFile << out.str();
-            logFile.flush();
-        }
-            out.str(std::string());
+        std::string text = out.str();
+        out.str(std::string());
+        logSink->submit(text);
     }
     else
     {
@@ -272,6 +282,10 @@ void sim_mob::BasicLogger::flush()
             flushLog(*(it->second));
         }
     }
+    if (logSink)
+    {
+        logSink->flush();
+    }
 }
 
 /* ****************************************
@@ -4,6 +4,8 @@
 #include <boost/thread.hpp>
 #include <boost/lockfree/queue.hpp>
 #include <boost/atomic.hpp>
+#include <boost/scoped_ptr.hpp>
+#include "logging/AsyncLogSink.hpp"
 namespace sim_mob {
 /**
  * Authore: Vahid
@@ -134,9 +136,6 @@ private:
 //  ///total time measured by all profilers
 //  uint64_t totalTime;
 
-    /// used for index
-    boost::mutex flushMutex;
-
     /// used for output stream
     boost::shared_mutex mutexOutput;
 
@@ -169,6 +168,9 @@ protected:
     ///logger
     std::ofstream logFile;
 
+    /// writes the flushed buffers to logFile in the background; declared after logFile so that it is destroyed first
+    boost::scoped_ptr<AsyncLogSink> logSink;
+
     /// flush the the given log buffer into the output buffer-Default version
     virtual void flushLog(std::stringstream &out);
 
@@ -181,7 +183,7 @@ public:
     /// copy constructor
     BasicLogger(const sim_mob::BasicLogger& value);
 
-    /// flush all buffers to the corresponding file
+    /// flush all buffers to the corresponding file, and wait until they have been written
     virtual void flush();
 
     /// destructor
@@ -0,0 +1,35 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+namespace sim_mob
+{
+
+class WorkGroup;
+
+/**
+ * Re-distributes the entities of a WorkGroup among its Workers while the simulation is running.
+ * Used by the ASSIGN_TIMEBASED strategy; the concrete rebalancer knows which entities are worth moving
+ * (e.g. Confluxes in mid-term) and how to measure their cost.
+ *
+ * rebalance() is invoked on the main thread during the message distribution phase, when none of the
+ * Workers is updating its entities. Entities must be moved with WorkGroup::migrateEntity().
+ */
+class EntityRebalancer
+{
+public:
+    virtual ~EntityRebalancer()
+    {
+    }
+
+    /**
+     * Re-distributes entities among the workers of workGroup
+     *
+     * @param workGroup the work group to rebalance
+     */
+    virtual void rebalance(WorkGroup& workGroup) = 0;
+};
+
+}
@@ -23,7 +23,9 @@
 #include "message/MessageBus.hpp"
 #include "partitions/PartitionManager.hpp"
 #include "path/PathSetManager.hpp"
+#include "workers/EntityRebalancer.hpp"
 #include "workers/Worker.hpp"
+#include "workers/WorkStealingScheduler.hpp"
 
 using std::vector;
 
@@ -33,7 +35,7 @@ sim_mob::WorkGroup::WorkGroup(unsigned int wgNum, unsigned int numWorkers, unsig
         PartitionManager* partitionMgr, PeriodicPersonLoader* periodicLoader, uint32_t simulationStart) :
         wgNum(wgNum), numWorkers(numWorkers), numSimTicks(numSimTicks), tickStep(tickStep), auraMgr(auraMgr), partitionMgr(partitionMgr), tickOffset(0), started(
                 false), currTimeTick(0), nextTimeTick(0), loader(nullptr), nextWorkerID(0), frame_tick_barr(nullptr), buff_flip_barr(nullptr), msg_bus_barr(
-                nullptr), macro_tick_barr(nullptr), profile(nullptr), periodicPersonLoader(periodicLoader), nextLoaderIdx(0), simulationStart(simulationStart)
+                nullptr), macro_tick_barr(nullptr), profile(nullptr), scheduler(nullptr), rebalancer(nullptr), rebalanceInterval(0), periodicPersonLoader(periodicLoader), nextLoaderIdx(0), simulationStart(simulationStart)
 {
     if (ConfigManager::GetInstance().CMakeConfig().ProfileAuraMgrUpdates())
     {
@@ -69,6 +71,9 @@ sim_mob::WorkGroup::~WorkGroup()  //Be aware that this will hang if Workers are
 
     //Clear the ProfileBuilder.
     safe_delete_item(profile);
+
+    safe_delete_item(scheduler);
+    safe_delete_item(rebalancer);
 }
 
 void WorkGroup::addOutputFileNames(std::list<std::string>& res) const
@@ -132,6 +137,12 @@ void sim_mob::WorkGroup::initWorkers(EntityLoadParams* loader)
     prefixS << "out_" << wgNum << "_";
     std::string prefix = prefixS.str();
 
+    //Work stealing needs a shared scheduler. With a single worker there is no one to steal from.
+    if (ConfigManager::GetInstance().FullConfig().defaultWrkGrpAssignment() == ASSIGN_WORKSTEALING && numWorkers > 1)
+    {
+        scheduler = new WorkStealingScheduler(numWorkers);
+    }
+
     //Init the workers themselves.
     for (size_t i = 0; i < numWorkers; i++)
     {
@@ -152,7 +163,10 @@ void sim_mob::WorkGroup::initWorkers(EntityLoadParams* loader)
         std::vector<Entity*>* entWorker = &entToBeRemovedPerWorker.at(i);
         std::vector<Entity*>* entBredPerWorker = &entToBeBredPerWorker.at(i);
 
-        workers.push_back(new Worker(this, logFile, frame_tick_barr, buff_flip_barr, msg_bus_barr, macro_tick_barr, entWorker, entBredPerWorker, numSimTicks, tickStep,simulationStart));
+        Worker* worker = new Worker(this, logFile, frame_tick_barr, buff_flip_barr, msg_bus_barr, macro_tick_barr, entWorker, entBredPerWorker, numSimTicks, tickStep,simulationStart);
+        worker->scheduler = scheduler;
+        worker->workerIdx = i;
+        workers.push_back(worker);
     }
 }
 
@@ -310,8 +324,9 @@ void sim_mob::WorkGroup::assignAWorker(Entity* ag)
     }
 
     //For now, just rely on static access to ConfigParams. (We can allow per-workgroup configuration later).
+    //Under work stealing, the owning Worker only matters for book-keeping; the load is balanced every tick.
     ASSIGNMENT_STRATEGY strat = ConfigManager::GetInstance().FullConfig().defaultWrkGrpAssignment();
-    if (strat == ASSIGN_ROUNDROBIN)
+    if (strat == ASSIGN_ROUNDROBIN || strat == ASSIGN_WORKSTEALING)
     {
         workers.at(nextWorkerID)->scheduleForAddition(ag);
     }
@@ -546,3 +561,67 @@ void sim_mob::WorkGroup::loadPerson(Entity* person)
         nextLoaderIdx = (nextLoaderIdx + 1) % loaderEntities.size();
     }
 }
+
+void sim_mob::WorkGroup::setRebalancer(EntityRebalancer* entityRebalancer)
+{
+    safe_delete_item(rebalancer);
+    rebalancer = entityRebalancer;
+
+    const ConfigParams& config = ConfigManager::GetInstance().FullConfig();
+    unsigned int msPerTick = config.baseGranMS() * tickStep;
+    rebalanceInterval = (msPerTick > 0) ? (config.workGroupRebalanceInterval() * 1000) / msPerTick : 0;
+}
+
+void sim_mob::WorkGroup::rebalanceEntities()
+{
+    if (!rebalancer || rebalanceInterval == 0 || currTimeTick == 0 || (currTimeTick % rebalanceInterval) != 0)
+    {
+        return;
+    }
+
+    //Entities can only be moved between running worker threads.
+    for (vector<Worker*>::const_iterator it = workers.begin(); it != workers.end(); it++)
+    {
+        if (!(*it)->messageContext)
+        {
+            return;
+        }
+    }
+    rebalancer->rebalance(*this);
+}
+
+void sim_mob::WorkGroup::migrateEntity(Entity* ent, unsigned int workerId)
+{
+    Worker* dest = workers.at(workerId);
+    int srcId = getWorkerIndex(ent->currWorkerProvider);
+    if (srcId < 0)
+    {
+        std::stringstream msg;
+        msg << "Entity (" << ent->getId() << ") cannot be migrated; it is not managed by this work group";
+        throw std::runtime_error(msg.str());
+    }
+
+    Worker* src = workers[srcId];
+    if (src != dest)
+    {
+        src->migrateOut(*ent);
+        dest->migrateIn(*ent);
+    }
+}
+
+int sim_mob::WorkGroup::getWorkerIndex(const WorkerProvider* wp) const
+{
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+        if (workers[i] == wp)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void* sim_mob::WorkGroup::getWorkerMessageContext(unsigned int workerId) const
+{
+    return workers.at(workerId)->messageContext;
+}
@@ -22,12 +22,15 @@ namespace sim_mob
 
 class AuraManager; //TODO: to be removed
 class Entity;
+class EntityRebalancer;
 class PartitionManager;
 class ProfileBuilder;
 class RoadSegment;
 class StartTimePriorityQueue;
 class Worker;
+class WorkerProvider;
 class WorkGroupManager;
+class WorkStealingScheduler;
 
 /**
  * A Worker wrapper which uses barriers to synchronize between all Workers of the same group.
@@ -65,7 +68,8 @@ public:
     {
         ASSIGN_ROUNDROBIN,  ///< Assign an Agent to Worker 1, then Worker 2, etc.
         ASSIGN_SMALLEST,    ///< Assign an Agent to the Worker with the smallest number of Agents.
-    //TODO: Something like "ASSIGN_TIMEBASED", based on actual time tick length.
+        ASSIGN_WORKSTEALING,///< Assign round-robin, but let idle Workers steal Agent updates from busy ones every tick.
+        ASSIGN_TIMEBASED,   ///< Assign like ASSIGN_SMALLEST, then periodically re-distribute Entities based on their measured update time.
     };
 
     /** Entity load/migration parameters */
@@ -131,6 +135,41 @@ public:
      */
     void loadPerson(Entity* personEntity);
 
+    /**
+     * sets the rebalancer which periodically re-distributes entities among the workers (ASSIGN_TIMEBASED only).
+     * The work group takes ownership of the rebalancer.
+     *
+     * @param entityRebalancer the rebalancer
+     */
+    void setRebalancer(EntityRebalancer* entityRebalancer);
+
+    /**
+     * moves an entity from its current worker to another worker of this group.
+     * Must only be called while the workers are blocked (i.e. from an EntityRebalancer).
+     *
+     * @param ent the entity to move
+     * @param workerId index of the destination worker in workers list
+     */
+    void migrateEntity(Entity* ent, unsigned int workerId);
+
+    /**
+     * finds the index of a worker in this group
+     *
+     * @param wp the worker (typically the currWorkerProvider of an entity)
+     *
+     * @return index of the worker in workers list; -1 if the worker does not belong to this group
+     */
+    int getWorkerIndex(const WorkerProvider* wp) const;
+
+    /**
+     * retrieves the message bus context of a worker's thread
+     *
+     * @param workerId index of worker in workers list
+     *
+     * @return the thread context; nullptr if the worker's thread has not started
+     */
+    void* getWorkerMessageContext(unsigned int workerId) const;
+
 #ifndef SIMMOB_DISABLE_MPI
     void removeAgentFromWorker(Entity * ag);
     void addAgentInWorker(Entity * ag);
@@ -238,6 +277,11 @@ private:
      */
     void waitMacroTimeTick();
 
+    /**
+     * lets the rebalancer (if any) re-distribute entities, once every rebalanceInterval ticks
+     */
+    void rebalanceEntities();
+
     /**
      * Initialize our shared (static) barriers. These barriers don't technically need to be copied
      * locally, but we'd rather avoid relying on static variables in case we ever make a WorkGroupGroup (or whatever) class.
@@ -335,6 +379,15 @@ private:
     /** Profiler */
     sim_mob::ProfileBuilder* profile;
 
+    /** Shares the per-tick entity updates among the workers. Only created for the ASSIGN_WORKSTEALING strategy */
+    sim_mob::WorkStealingScheduler* scheduler;
+
+    /** Re-distributes entities among the workers. Only set for the ASSIGN_TIMEBASED strategy */
+    sim_mob::EntityRebalancer* rebalancer;
+
+    /** number of ticks between two invocations of the rebalancer */
+    unsigned int rebalanceInterval;
+
     /** entity loader to load person entities periodically */
     PeriodicPersonLoader* periodicPersonLoader;
 
@@ -268,6 +268,7 @@ void sim_mob::WorkGroupManager::waitAllGroups_DistributeMessages(std::set<Entity
             {
                 (*it)->waitAuraManager(removedEntities);
             }
+            (*it)->rebalanceEntities();
         }
         PathSetManager::updateCurrTimeInterval();
     }
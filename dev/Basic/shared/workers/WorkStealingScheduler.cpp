@@ -0,0 +1,196 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "WorkStealingScheduler.hpp"
+
+#include <algorithm>
+#include <boost/chrono.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "message/MessageBus.hpp"
+#include "util/LangHelpers.hpp"
+
+using namespace sim_mob;
+
+namespace
+{
+
+/** orders tasks by decreasing expected cost */
+struct TaskCostGreater
+{
+    bool operator()(const EntityUpdateTask* lhs, const EntityUpdateTask* rhs) const
+    {
+        return lhs->cost > rhs->cost;
+    }
+};
+
+/** subtracts without wrapping around; remainingCost is only an estimate */
+void subtractCost(boost::atomic<uint64_t>& total, uint64_t cost)
+{
+    uint64_t current = total.load(boost::memory_order_relaxed);
+    while (!total.compare_exchange_weak(current, (current > cost ? current - cost : 0), boost::memory_order_relaxed))
+    {
+    }
+}
+
+}
+
+WorkStealingScheduler::WorkStealingScheduler(unsigned int numWorkers)
+{
+    for (unsigned int i = 0; i < numWorkers; i++)
+    {
+        queues.push_back(new WorkerQueue());
+    }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler()
+{
+    for (std::vector<WorkerQueue*>::iterator it = queues.begin(); it != queues.end(); it++)
+    {
+        safe_delete_item(*it);
+    }
+    queues.clear();
+}
+
+void WorkStealingScheduler::publishTasks(unsigned int workerIdx, std::vector<EntityUpdateTask>& tasks)
+{
+    WorkerQueue& queue = *queues.at(workerIdx);
+
+    std::vector<EntityUpdateTask*> ordered;
+    ordered.reserve(tasks.size());
+    uint64_t totalCost = 0;
+    for (std::vector<EntityUpdateTask>::iterator it = tasks.begin(); it != tasks.end(); it++)
+    {
+        ordered.push_back(&(*it));
+        totalCost += it->cost;
+    }
+    std::stable_sort(ordered.begin(), ordered.end(), TaskCostGreater());
+
+    queue.outstandingTasks.store(tasks.size());
+    queue.remainingCost.store(totalCost);
+
+    boost::mutex::scoped_lock lock(queue.mutex);
+    queue.tasks.assign(ordered.begin(), ordered.end());
+}
+
+EntityUpdateTask* WorkStealingScheduler::popOwn(unsigned int workerIdx)
+{
+    WorkerQueue& queue = *queues[workerIdx];
+    boost::mutex::scoped_lock lock(queue.mutex);
+    if (queue.tasks.empty())
+    {
+        return nullptr;
+    }
+    EntityUpdateTask* task = queue.tasks.front();
+    queue.tasks.pop_front();
+    subtractCost(queue.remainingCost, task->cost);
+    return task;
+}
+
+EntityUpdateTask* WorkStealingScheduler::steal(unsigned int thiefIdx, unsigned int& ownerIdx)
+{
+    //Try victims in order of decreasing remaining work. The costs may change while we look at them; that is fine,
+    //since the victim's mutex is what guarantees each task is handed out only once.
+    std::vector<std::pair<uint64_t, unsigned int> > victims;
+    for (unsigned int i = 0; i < queues.size(); i++)
+    {
+        if (i != thiefIdx)
+        {
+            uint64_t remaining = queues[i]->remainingCost.load(boost::memory_order_relaxed);
+            if (remaining > 0)
+            {
+                victims.push_back(std::make_pair(remaining, i));
+            }
+        }
+    }
+    std::sort(victims.rbegin(), victims.rend());
+
+    for (std::vector<std::pair<uint64_t, unsigned int> >::const_iterator it = victims.begin(); it != victims.end(); it++)
+    {
+        WorkerQueue& victim = *queues[it->second];
+        boost::mutex::scoped_lock lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            //The owner works from the expensive end; take the cheap end to avoid contending with it.
+            EntityUpdateTask* task = victim.tasks.back();
+            victim.tasks.pop_back();
+            subtractCost(victim.remainingCost, task->cost);
+            ownerIdx = it->second;
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void WorkStealingScheduler::execute(EntityUpdateTask* task, unsigned int ownerIdx, timeslice currTime)
+{
+    boost::chrono::high_resolution_clock::time_point start = boost::chrono::high_resolution_clock::now();
+    task->result = task->entity->update(currTime);
+    boost::chrono::microseconds elapsed = boost::chrono::duration_cast<boost::chrono::microseconds>(boost::chrono::high_resolution_clock::now() - start);
+
+    //Never record a zero cost; an entity which was never timed costs 1.
+    task->cost = std::max<uint64_t>(elapsed.count(), 1);
+
+    //Release: makes the task's result visible to the owner once it sees the decremented count.
+    queues[ownerIdx]->outstandingTasks.fetch_sub(1, boost::memory_order_release);
+}
+
+void WorkStealingScheduler::runTasks(unsigned int workerIdx, timeslice currTime)
+{
+    WorkerQueue& own = *queues.at(workerIdx);
+    while (true)
+    {
+        EntityUpdateTask* task = popOwn(workerIdx);
+        if (task)
+        {
+            execute(task, workerIdx, currTime);
+            continue;
+        }
+
+        unsigned int ownerIdx = workerIdx;
+        task = steal(workerIdx, ownerIdx);
+        if (task)
+        {
+            own.numStolen++;
+            messaging::MessageBus::AdoptHandlerContext(queues[ownerIdx]->messageContext);
+            execute(task, ownerIdx, currTime);
+            messaging::MessageBus::AdoptHandlerContext(nullptr);
+            continue;
+        }
+
+        //Nothing left to run. We are done once the tasks that were stolen from us have completed.
+        if (own.outstandingTasks.load(boost::memory_order_acquire) == 0)
+        {
+            break;
+        }
+        boost::this_thread::yield();
+    }
+}
+
+uint64_t WorkStealingScheduler::getExpectedCost(unsigned int workerIdx, const Entity* entity) const
+{
+    const boost::unordered_map<const Entity*, uint64_t>& lastCost = queues.at(workerIdx)->lastCost;
+    boost::unordered_map<const Entity*, uint64_t>::const_iterator it = lastCost.find(entity);
+    return (it != lastCost.end()) ? it->second : 1;
+}
+
+void WorkStealingScheduler::recordCost(unsigned int workerIdx, const Entity* entity, uint64_t cost)
+{
+    queues.at(workerIdx)->lastCost[entity] = cost;
+}
+
+void WorkStealingScheduler::forgetEntity(unsigned int workerIdx, const Entity* entity)
+{
+    queues.at(workerIdx)->lastCost.erase(entity);
+}
+
+void WorkStealingScheduler::setWorkerContext(unsigned int workerIdx, void* context)
+{
+    queues.at(workerIdx)->messageContext = context;
+}
+
+unsigned long WorkStealingScheduler::getNumStolenTasks(unsigned int workerIdx) const
+{
+    return queues.at(workerIdx)->numStolen;
+}
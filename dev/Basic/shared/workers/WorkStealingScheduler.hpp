@@ -0,0 +1,167 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <deque>
+#include <stdint.h>
+#include <vector>
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "entities/Entity.hpp"
+#include "metrics/Frame.hpp"
+
+namespace sim_mob
+{
+
+class Worker;
+
+/**
+ * A single Entity update within one frame tick.
+ * The task is owned (and its result consumed) by the Worker which manages the Entity, but it
+ * may be executed by any Worker of the same WorkGroup.
+ */
+struct EntityUpdateTask
+{
+    EntityUpdateTask(Entity* entity, uint64_t cost) : entity(entity), cost(cost), result(Entity::UpdateStatus::Continue)
+    {
+    }
+
+    /** The entity to be updated */
+    Entity* entity;
+
+    /**
+     * Cost of this update in microseconds.
+     * Holds the expected cost (taken by the previous update of this entity) until the task is executed,
+     * and the measured cost afterwards.
+     */
+    uint64_t cost;
+
+    /** Status returned by entity->update(); filled in by whichever Worker executed the task */
+    Entity::UpdateStatus result;
+};
+
+/**
+ * Per-WorkGroup scheduler for the ASSIGN_WORKSTEALING strategy.
+ *
+ * Entities remain statically owned by one Worker (their Buffered<> properties, removal and breeding are still
+ * handled by that Worker, so the flip semantics are unchanged), but the update() calls of one frame tick are
+ * published as tasks on a per-worker deque. Each Worker pops its own tasks from the front (most expensive first);
+ * once it runs dry, it steals the cheapest tasks from the back of the Worker with the most remaining work.
+ *
+ * Each Worker only returns from runTasks() after all of its own tasks have been executed, and then consumes
+ * the results in the order it published them, so the bookkeeping done after update() is identical to the
+ * statically-assigned mode. The cost of each task is the measured wall-clock time of the entity's previous update.
+ */
+class WorkStealingScheduler
+{
+public:
+    explicit WorkStealingScheduler(unsigned int numWorkers);
+    ~WorkStealingScheduler();
+
+    /**
+     * Publishes the tasks of a worker for the current tick. The tasks are queued by decreasing cost, but the
+     * vector itself is not re-ordered. It must remain untouched until runTasks() returns for this worker.
+     *
+     * @param workerIdx index of the owning worker within the work group
+     * @param tasks tasks to be published
+     */
+    void publishTasks(unsigned int workerIdx, std::vector<EntityUpdateTask>& tasks);
+
+    /**
+     * Executes tasks (own or stolen) until no task of the work group is left and all tasks published by
+     * workerIdx are complete.
+     *
+     * @param workerIdx index of the calling worker within the work group
+     * @param currTime the current time slice
+     */
+    void runTasks(unsigned int workerIdx, timeslice currTime);
+
+    /**
+     * Retrieves the expected cost of updating an entity, based on its last update.
+     * Must only be called by the owning worker.
+     *
+     * @param workerIdx index of the owning worker
+     * @param entity the entity
+     *
+     * @return cost of the last update in microseconds (1 if the entity was never timed)
+     */
+    uint64_t getExpectedCost(unsigned int workerIdx, const Entity* entity) const;
+
+    /**
+     * Records the measured cost of an entity's update. Must only be called by the owning worker.
+     *
+     * @param workerIdx index of the owning worker
+     * @param entity the entity
+     * @param cost measured cost in microseconds
+     */
+    void recordCost(unsigned int workerIdx, const Entity* entity, uint64_t cost);
+
+    /**
+     * Drops the cost history of an entity (e.g. when it is removed from the simulation).
+     * Must only be called by the owning worker.
+     *
+     * @param workerIdx index of the owning worker
+     * @param entity the entity
+     */
+    void forgetEntity(unsigned int workerIdx, const Entity* entity);
+
+    /**
+     * Sets the message bus context of a worker's thread. Stolen tasks are executed on behalf of this context,
+     * so that handlers registered or messaged during the update behave as they would on the owning worker.
+     *
+     * @param workerIdx index of the worker
+     * @param context the worker thread's message bus context
+     */
+    void setWorkerContext(unsigned int workerIdx, void* context);
+
+    /** @return number of tasks executed by a worker on behalf of other workers since the start of the simulation */
+    unsigned long getNumStolenTasks(unsigned int workerIdx) const;
+
+private:
+    /** Task deque of one worker, along with its book-keeping */
+    struct WorkerQueue
+    {
+        WorkerQueue() : remainingCost(0), outstandingTasks(0), numStolen(0), messageContext(nullptr)
+        {
+        }
+
+        /** guards tasks */
+        boost::mutex mutex;
+
+        /** tasks published and not yet started */
+        std::deque<EntityUpdateTask*> tasks;
+
+        /** sum of the costs of tasks (in microseconds). Only an estimate used for victim selection */
+        boost::atomic<uint64_t> remainingCost;
+
+        /** number of published tasks which are not complete yet */
+        boost::atomic<unsigned int> outstandingTasks;
+
+        /** number of tasks this worker stole from others */
+        unsigned long numStolen;
+
+        /** message bus context of the worker's thread */
+        void* messageContext;
+
+        /** last measured cost per entity owned by this worker. Accessed by the owner only */
+        boost::unordered_map<const Entity*, uint64_t> lastCost;
+    };
+
+    /** pops a task from the front of the worker's own queue */
+    EntityUpdateTask* popOwn(unsigned int workerIdx);
+
+    /** steals a task from the back of the most loaded victim; also returns the owner of the stolen task */
+    EntityUpdateTask* steal(unsigned int thiefIdx, unsigned int& ownerIdx);
+
+    /** executes a task and stores the measured cost in the task */
+    void execute(EntityUpdateTask* task, unsigned int ownerIdx, timeslice currTime);
+
+    /** one queue per worker of the work group */
+    std::vector<WorkerQueue*> queues;
+};
+
+}
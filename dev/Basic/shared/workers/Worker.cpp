@@ -26,6 +26,7 @@
 #include "network/ControlManager.hpp"
 #include "logging/Log.hpp"
 #include "workers/WorkGroup.hpp"
+#include "workers/WorkStealingScheduler.hpp"
 #include "util/FlexiBarrier.hpp"
 #include "util/LangHelpers.hpp"
 #include "message/MessageBus.hpp"
@@ -49,6 +50,16 @@ UpdateEventArgs::~UpdateEventArgs(){};
 
 UpdatePublisher  Worker::updatePublisher;
 
+namespace
+{
+///Workers are owned by their WorkGroups; the thread specific pointer must never delete them.
+void doNotDeleteProvider(WorkerProvider*)
+{
+}
+}
+
+boost::thread_specific_ptr<WorkerProvider> WorkerProvider::executingProvider(doNotDeleteProvider);
+
 sim_mob::Worker::MgmtParams::MgmtParams() :
     msPerFrame(ConfigManager::GetInstance().FullConfig().baseGranMS()),
     ctrlMgr(ConfigManager::GetInstance().CMakeConfig().InteractiveMode()?ConfigManager::GetInstance().FullConfig().getControlMgr():nullptr),
@@ -68,7 +79,7 @@ sim_mob::Worker::Worker(WorkGroup* parent, std::ostream* logFile,  FlexiBarrier*
                         std::vector<Entity*>* entityRemovalList, std::vector<Entity*>* entityBredList, uint32_t endTick, uint32_t tickStep, uint32_t _simulationStartDay)
                        :logFile(logFile), frame_tick_barr(frame_tick), buff_flip_barr(buff_flip), aura_mgr_barr(aura_mgr), macro_tick_barr(macro_tick),
                         endTick(endTick), tickStep(tickStep), parent(parent), entityRemovalList(entityRemovalList), entityBredList(entityBredList),
-                        profile(nullptr),pathSetMgr(nullptr), simulationStartDay(_simulationStartDay)
+                        profile(nullptr),pathSetMgr(nullptr), simulationStartDay(_simulationStartDay), scheduler(nullptr), workerIdx(0), messageContext(nullptr)
 {
     //Initialize our profile builder, if applicable.
     if (ConfigManager::GetInstance().CMakeConfig().ProfileWorkerUpdates()) {
@@ -181,6 +192,7 @@ void sim_mob::Worker::scheduleForBred(Entity* entity)
         //Nothing to be done.
     } else {*/
         //Save for later
+        boost::mutex::scoped_lock lock(bredMutex);
         toBeBred.push_back(entity);
     /*}*/
 }
@@ -336,7 +348,16 @@ void sim_mob::Worker::threaded_function_loop()
 {
     // Register thread on MessageBus.
     messaging::MessageBus::RegisterThread();
-    
+    messageContext = messaging::MessageBus::GetCurrentContext();
+
+    //Entities updated on this thread log to this Worker's stream (see WorkerProvider::getExecutingLogFile()).
+    //Stolen updates of our own Entities are run on behalf of this thread's message context.
+    if (scheduler)
+    {
+        executingProvider.reset(this);
+        scheduler->setWorkerContext(workerIdx, messageContext);
+    }
+
     ///NOTE: Please keep this function simple. In fact, you should not have to add anything to it.
     ///      Instead, add functionality into the sub-functions (perform_frame_tick(), etc.).
     ///      This is needed so that singleThreaded mode can be implemented easily. ~Seth
@@ -400,6 +421,8 @@ void sim_mob::Worker::threaded_function_loop()
 #endif
     }
 
+    executingProvider.reset();
+
     // Register thread from MessageBus.
     messaging::MessageBus::UnRegisterThread();
 }
@@ -423,7 +446,12 @@ struct EntityUpdater
     virtual void operator()(sim_mob::Entity* entity)
     {
         UpdateStatus res = entity->update(currTime);
+        handleUpdateStatus(wrk, entity, res);
+    }
 
+    ///Performs the Worker's book-keeping for the status returned by an Entity's update().
+    static void handleUpdateStatus(Worker& wrk, sim_mob::Entity* entity, const UpdateStatus& res)
+    {
         if (ConfigManager::GetInstance().FullConfig().isWorkerPublisherEnabled())
         {
             Worker::GetUpdatePublisher().publish(event::EVT_CORE_AGENT_UPDATED, (void*) event::CXT_CORE_AGENT_UPDATE, UpdateEventArgs(entity));
@@ -439,11 +467,11 @@ struct EntityUpdater
             case UpdateStatus::RS_CONTINUE:
             {
                 //Still going, but we may have properties to start/stop managing
-                for (set<BufferedBase*>::iterator it = res.toRemove.begin(); it != res.toRemove.end(); it++)
+                for (set<BufferedBase*>::const_iterator it = res.toRemove.begin(); it != res.toRemove.end(); it++)
                 {
                     wrk.stopManaging(*it);
                 }
-                for (set<BufferedBase*>::iterator it = res.toAdd.begin(); it != res.toAdd.end(); it++)
+                for (set<BufferedBase*>::const_iterator it = res.toAdd.begin(); it != res.toAdd.end(); it++)
                 {
                     wrk.beginManaging(*it);
                 }
@@ -513,6 +541,10 @@ void sim_mob::Worker::migrateOut(Entity& ag)
 
     //Simple migration
     remEntity(&ag);
+    if (scheduler)
+    {
+        scheduler->forgetEntity(workerIdx, &ag);
+    }
 
     //Update our Entity's pointer.
     ag.currWorkerProvider = nullptr;
@@ -554,9 +586,42 @@ void sim_mob::Worker::migrateIn(Entity& ag)
 //      May want to dig into this a bit more. ~Seth
 void sim_mob::Worker::update_entities(timeslice currTime)
 {
+    if (scheduler)
+    {
+        update_entities_stealing(currTime);
+        return;
+    }
     std::for_each(managedEntities.begin(), managedEntities.end(), EntityUpdater(*this, currTime));
 }
 
+void sim_mob::Worker::update_entities_stealing(timeslice currTime)
+{
+    std::vector<EntityUpdateTask> tasks;
+    tasks.reserve(managedEntities.size());
+    for (std::set<Entity*>::const_iterator it = managedEntities.begin(); it != managedEntities.end(); it++)
+    {
+        tasks.push_back(EntityUpdateTask(*it, scheduler->getExpectedCost(workerIdx, *it)));
+    }
+
+    //Updates may run on any Worker of the group; we return only once all of ours are complete.
+    scheduler->publishTasks(workerIdx, tasks);
+    scheduler->runTasks(workerIdx, currTime);
+
+    //Consume the results in the same order as the single-worker loop does.
+    for (std::vector<EntityUpdateTask>::const_iterator it = tasks.begin(); it != tasks.end(); it++)
+    {
+        if (it->result.status == UpdateStatus::RS_DONE)
+        {
+            scheduler->forgetEntity(workerIdx, it->entity);
+        }
+        else
+        {
+            scheduler->recordCost(workerIdx, it->entity, it->cost);
+        }
+        EntityUpdater::handleUpdateStatus(*this, it->entity, it->result);
+    }
+}
+
 void sim_mob::Worker::processMultiUpdateEntities(uint32_t currTick)
 {
     const unsigned int msPerFrame = ConfigManager::GetInstance().FullConfig().baseGranMS();
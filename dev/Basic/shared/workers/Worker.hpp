@@ -22,6 +22,7 @@ class FlexiBarrier;
 class ProfileBuilder;
 class ControlManager;
 class WorkGroup;
+class WorkStealingScheduler;
 class Entity;
 class PathSetManager;
 
@@ -59,6 +60,12 @@ protected:
     /**Worker specific random number generator*/
     boost::mt19937 gen;
 
+    /**
+     * The provider whose thread is currently running (if any).
+     * Under work stealing, an Entity may be updated on a thread other than the one of its own WorkerProvider.
+     */
+    static boost::thread_specific_ptr<WorkerProvider> executingProvider;
+
 public:
     //NOTE: Allowing access to the BufferedDataManager is somewhat risky; we need it for Roles, but we might
     //      want to organize this differently.
@@ -72,8 +79,20 @@ public:
 
     virtual ProfileBuilder* getProfileBuilder() const = 0;
 
+    /**
+     * Returns the log file of the Worker whose thread is running, falling back to this provider's own.
+     * Under work stealing an Entity owned by this provider may be updated on another Worker's thread; logging from such
+     * an update must go to the executing Worker's stream, which only that thread writes to.
+     */
+    std::ostream* getExecutingLogFile() const
+    {
+        const WorkerProvider* executing = executingProvider.get();
+        return (executing ? executing : this)->getLogFile();
+    }
+
     /**
      * Note: Calling this function from another worker is extremely dangerous if you don't know what you're doing
+     * Entities which may be updated by a work-stealing Worker must not draw from this generator (see Person::getGenerator()).
      */
     boost::mt19937& getGenerator()
     {
@@ -174,6 +193,9 @@ private:
     //Helper functions for various update functionality.
     virtual void update_entities(timeslice currTime);
 
+    ///Updates the managed entities through the work group's work-stealing scheduler.
+    void update_entities_stealing(timeslice currTime);
+
     void migrateOut(Entity& ent);
     void migrateIn(Entity& ent);
 
@@ -214,6 +236,18 @@ protected:
     std::vector<Entity*> toBeRemoved;
     std::vector<Entity*> toBeBred;
 
+    ///Guards toBeBred; Entities of this Worker may be updated on another Worker's thread under work stealing.
+    boost::mutex bredMutex;
+
+    ///Work-stealing scheduler of the parent WorkGroup (null unless the work-stealing strategy is in use).
+    sim_mob::WorkStealingScheduler* scheduler;
+
+    ///Index of this Worker within its parent WorkGroup.
+    unsigned int workerIdx;
+
+    ///Message bus context of this Worker's thread. Null until the thread has started (and in single-threaded mode).
+    void* messageContext;
+
 
 private:
     ///Logging
@@ -750,6 +750,12 @@ void ExpandShortTermConfigFile::printSettings()
     case WorkGroup::ASSIGN_SMALLEST:
         std::cout << "smallest" << std::endl;
         break;
+    case WorkGroup::ASSIGN_WORKSTEALING:
+        std::cout << "workstealing" << std::endl;
+        break;
+    case WorkGroup::ASSIGN_TIMEBASED:
+        std::cout << "timebased (rebalanced every " << cfg.workGroupRebalanceInterval() << "s)" << std::endl;
+        break;
     default:
         std::cout << "<unknown>" << std::endl;
         break;
@@ -762,6 +768,7 @@ void ExpandShortTermConfigFile::printSettings()
     std::cout << "  Total Warmup: " << cfg.totalWarmupTicks << " " << "ticks" << "\n";
     std::cout << "  Person Granularity: " << stConfig.granPersonTicks << " " << "ticks" << "\n";
     std::cout << "  Mutex strategy: " << (cfg.mutexStategy() == MtxStrat_Locked ? "Locked" : cfg.mutexStategy() == MtxStrat_Buffered ? "Buffered" : "Unknown") << "\n";
+    std::cout << "  Message distribution: " << (cfg.simulation.batchedMessageDistribution ? "batched" : "centralized") << "\n";
 
     //Print the network (this will go to a different output file...)
     std::cout << "------------------\n\n";
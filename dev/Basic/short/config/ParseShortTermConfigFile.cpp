@@ -383,11 +383,15 @@ void ParseShortTermConfigFile::processAuraManagerImpNode(DOMElement *node)
         {
             stCfg.auraManagerImplementation = AuraManager::IMPL_SIMTREE;
         }
+        else if(value == "str-tree")
+        {
+            stCfg.auraManagerImplementation = AuraManager::IMPL_STR;
+        }
         else
         {
             stringstream msg;
             msg << "Invalid value for <aura_manager_impl value=\""
-                << value << "\">. Expected: \"packing-tree\" or \"rstar\" or \"rdu\" or \"simtree\"";
+                << value << "\">. Expected: \"packing-tree\" or \"rstar\" or \"rdu\" or \"simtree\" or \"str-tree\"";
             throw runtime_error(msg.str());
         }
     }
@@ -788,7 +788,7 @@ void Person_ST::assignPersonToBusStopAgent()
     
     if (busStopAgent)
     {
-        messaging::MessageBus::SendMessage(busStopAgent, MSG_WAITING_PERSON_ARRIVAL, messaging::MessageBus::MessagePtr(new ArrivalAtStopMessage(this)));
+        messaging::MessageBus::SendMessage(busStopAgent, MSG_WAITING_PERSON_ARRIVAL, messaging::MessageBus::MakeMessage<ArrivalAtStopMessage>(this));
     }
 }
 
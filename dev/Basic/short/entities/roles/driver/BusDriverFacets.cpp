@@ -15,7 +15,6 @@
 #include "logging/Log.hpp"
 #include "message/MessageBus.hpp"
 #include "path/PathSetManager.hpp"
-#include "util/Utils.hpp"
 #include "config/ST_Config.hpp"
 #include "message/ST_Message.hpp"
 
@@ -195,7 +194,7 @@ void BusDriverMovement::frame_tick()
                     messaging::MessageBus::MessagePtr(new BusDriverMessage(parentBusDriver)));
 
             //Set default random dwell time and reset the current boarding & alighting times
-            params.currentStopPoint.dwellTime = Utils::nRandom(10, 2);
+            params.currentStopPoint.dwellTime = params.random.nextNormal(10, 2);
             parentBusDriver->currBoardingTime = 0;
             parentBusDriver->currAlightingTime = 0;
 
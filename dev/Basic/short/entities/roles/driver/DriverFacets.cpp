@@ -7,9 +7,11 @@
 #include <limits>
 #include <algorithm>
 #include <stdexcept>
+#include <tuple>
 
 #include "boost/bind.hpp"
 #include "BusDriver.hpp"
+#include "DriverLaneIndex.hpp"
 #include "conf/ConfigManager.hpp"
 #include "conf/ConfigParams.hpp"
 #include "config/ST_Config.hpp"
@@ -88,6 +90,11 @@ void DriverMovement::init()
     DriverUpdateParams &params = parentDriver->getParams();
     params.parentId = parentDriver->getParent()->getId();
 
+    //The draws made while creating the driving models get a stream of their own, apart from those of the ticks
+    params.random.reset(ConfigManager::GetInstance().FullConfig().simulation.seedValue, params.parentId,
+                        parentDriver->getParent()->currTick.frame(), 1);
+    fwdDriverMovement.setRandom(&params.random);
+
     //Create the driving models
     lcModel = new MITSIM_LC_Model(params, &fwdDriverMovement);
     cfModel = new MITSIM_CF_Model(params, &fwdDriverMovement);
@@ -2106,6 +2113,29 @@ double DriverMovement::getAngle() const
 void DriverMovement::updateNearbyAgents()
 {
     DriverUpdateParams& params = parentDriver->getParams();
+
+    //Clear the nearest vehicles found previously
+    params.nvFwd.reset();
+    params.nvLeftFwd.reset();
+    params.nvRightFwd.reset();
+    params.nvBack.reset();
+    params.nvLeftBack.reset();
+    params.nvRightBack.reset();
+    params.nvLeftFwd2.reset();
+    params.nvLeftBack2.reset();
+    params.nvRightFwd2.reset();
+    params.nvRightBack2.reset();
+    params.nvFwdNextLink.reset();
+    params.nvLagFreeway.reset();
+    params.nvLeadFreeway.reset();
+
+    //Away from intersections, the leaders and followers are all on the lanes around us
+    if (canUseLaneIndex())
+    {
+        updateNearbyDriversFromLaneIndex(params);
+        return;
+    }
+
     vector<const Agent *> nearbyAgentsList;
 
     if (parentDriver->getCurrPosition().getX() > 0 && parentDriver->getCurrPosition().getY() > 0)
@@ -2133,20 +2163,6 @@ void DriverMovement::updateNearbyAgents()
     }
 
     //Update each nearby Pedestrian/Driver
-    params.nvFwd.reset();
-    params.nvLeftFwd.reset();
-    params.nvRightFwd.reset();
-    params.nvBack.reset();
-    params.nvLeftBack.reset();
-    params.nvRightBack.reset();
-    params.nvLeftFwd2.reset();
-    params.nvLeftBack2.reset();
-    params.nvRightFwd2.reset();
-    params.nvRightBack2.reset();
-    params.nvFwdNextLink.reset();
-    params.nvLagFreeway.reset();
-    params.nvLeadFreeway.reset();
-
     for (vector<const Agent *>::iterator it = nearbyAgentsList.begin(); it != nearbyAgentsList.end(); ++it)
     {
         //Perform no action on non-Persons
@@ -2171,6 +2187,143 @@ void DriverMovement::updateNearbyAgents()
     }
 }
 
+bool DriverMovement::canUseLaneIndex()
+{
+    if (fwdDriverMovement.isInIntersection() || !fwdDriverMovement.getCurrLane() || parentDriver->expectedTurning_.get())
+    {
+        return false;
+    }
+
+    //On the first segment of a link, drivers still on the turning paths into it may be behind us
+    return fwdDriverMovement.getCurrLink()->getRoadSegmentIndex(fwdDriverMovement.getCurrSegment()) > 0;
+}
+
+void DriverMovement::updateNearbyDriversFromLaneIndex(DriverUpdateParams &params)
+{
+    const DriverLaneIndex::Index &laneIndex = DriverLaneIndex::instance().getIndex();
+    const Link *currLink = fwdDriverMovement.getCurrLink();
+    const Lane *currLane = fwdDriverMovement.getCurrLane();
+    const double distCovered = fwdDriverMovement.getDistCoveredOnCurrWayPt();
+
+    //1.0 Vehicles on the current segment, in our lane and the lanes beside it
+
+    const Lane *lanes[] = { params.currLane, params.leftLane, params.rightLane, params.leftLane2, params.rightLane2 };
+    NearestVehicle *fwdVehicles[] = { &params.nvFwd, &params.nvLeftFwd, &params.nvRightFwd, &params.nvLeftFwd2, &params.nvRightFwd2 };
+    NearestVehicle *backVehicles[] = { &params.nvBack, &params.nvLeftBack, &params.nvRightBack, &params.nvLeftBack2, &params.nvRightBack2 };
+
+    for (unsigned int i = 0; i < sizeof(lanes) / sizeof(lanes[0]); ++i)
+    {
+        if (!lanes[i])
+        {
+            continue;
+        }
+
+        const DriverLaneIndex::Index::Entry *leader = laneIndex.leader(lanes[i], distCovered, parentDriver);
+
+        if (leader && leader->offset - distCovered <= distanceInFront)
+        {
+            setNearestVehicle(*fwdVehicles[i], leader->offset - distCovered, leader->object);
+        }
+
+        const DriverLaneIndex::Index::Entry *follower = laneIndex.follower(lanes[i], distCovered, parentDriver);
+
+        if (follower && distCovered - follower->offset <= distanceBehind)
+        {
+            setNearestVehicle(*backVehicles[i], follower->offset - distCovered, follower->object);
+        }
+    }
+
+    //Increment the lane level density for every other car in the same lane
+    DriverLaneIndex::Index::const_iterator itBegin, itEnd;
+    std::tie(itBegin, itEnd) = laneIndex.onLane(params.currLane, distCovered - distanceBehind, distCovered + distanceInFront);
+
+    for (DriverLaneIndex::Index::const_iterator it = itBegin; it != itEnd; ++it)
+    {
+        if (it->object != parentDriver)
+        {
+            params.density = params.density + (1.0f / currLink->getLength());
+        }
+    }
+
+    const int currSegIndex = currLink->getRoadSegmentIndex(fwdDriverMovement.getCurrSegment());
+    const double distToEndOfSeg = currLane->getLength() - distCovered;
+
+    //2.0 Vehicles on the next segment, at the start of the lane we will move into and the lanes beside it
+
+    if (currSegIndex + 1 < (int) currLink->getRoadSegments().size() && distToEndOfSeg <= distanceInFront)
+    {
+        const RoadSegment *nextSegment = currLink->getRoadSegment(currSegIndex + 1);
+        const Lane *nextLane = fwdDriverMovement.getNextLane();
+
+        if (nextLane && nextLane->getParentSegment() == nextSegment)
+        {
+            unsigned int nextLaneIndex = nextLane->getLaneIndex();
+            unsigned int noOfLanes = nextSegment->getNoOfLanes();
+
+            const Lane *nextLanes[] = {
+                nextLane,
+                nextLaneIndex > 0 ? nextSegment->getLane(nextLaneIndex - 1) : NULL,
+                nextLaneIndex + 1 < noOfLanes ? nextSegment->getLane(nextLaneIndex + 1) : NULL,
+                nextLaneIndex > 1 ? nextSegment->getLane(nextLaneIndex - 2) : NULL,
+                nextLaneIndex + 2 < noOfLanes ? nextSegment->getLane(nextLaneIndex + 2) : NULL
+            };
+
+            for (unsigned int i = 0; i < sizeof(nextLanes) / sizeof(nextLanes[0]); ++i)
+            {
+                const DriverLaneIndex::Index::Entry *first = nextLanes[i] ? laneIndex.first(nextLanes[i]) : NULL;
+
+                //Distance between the drivers
+                if (first && distToEndOfSeg + first->offset <= distanceInFront)
+                {
+                    int distance = distToEndOfSeg + first->offset;
+                    setNearestVehicle(*fwdVehicles[i], distance, first->object);
+                }
+            }
+
+            //Increment the lane level density for every car in the lane we want to get into
+            std::tie(itBegin, itEnd) = laneIndex.onLane(nextLane, 0, distanceInFront - distToEndOfSeg);
+            params.density = params.density + (itEnd - itBegin) * (1.0f / currLink->getLength());
+        }
+    }
+
+    //3.0 Vehicles on the previous segment, at the end of the lane leading into ours and the lanes beside it
+
+    if (currSegIndex > 0 && distCovered <= distanceBehind)
+    {
+        const RoadSegment *prevSegment = currLink->getRoadSegment(currSegIndex - 1);
+        unsigned int currLaneIndex = currLane->getLaneIndex();
+        unsigned int noOfLanes = prevSegment->getNoOfLanes();
+
+        const Lane *prevLanes[] = { NULL, NULL, NULL, NULL, NULL };
+
+        //If the current lane index is less than the number of lanes in the previous segment, then the previous lane had the same index
+        if (currLaneIndex < noOfLanes)
+        {
+            prevLanes[0] = prevSegment->getLane(currLaneIndex);
+            prevLanes[2] = currLaneIndex + 1 < noOfLanes ? prevSegment->getLane(currLaneIndex + 1) : NULL;
+            prevLanes[4] = currLaneIndex + 2 < noOfLanes ? prevSegment->getLane(currLaneIndex + 2) : NULL;
+        }
+        else if (fwdDriverMovement.getCurrSegment()->getNoOfLanes() > noOfLanes)
+        {
+            //Since the currLaneIndex is >= the number of lanes of the other segment, these lanes are to our left
+            prevLanes[1] = currLaneIndex >= 1 && currLaneIndex - 1 < noOfLanes ? prevSegment->getLane(currLaneIndex - 1) : NULL;
+            prevLanes[3] = currLaneIndex >= 2 && currLaneIndex - 2 < noOfLanes ? prevSegment->getLane(currLaneIndex - 2) : NULL;
+        }
+
+        for (unsigned int i = 0; i < sizeof(prevLanes) / sizeof(prevLanes[0]); ++i)
+        {
+            const DriverLaneIndex::Index::Entry *last = prevLanes[i] ? laneIndex.last(prevLanes[i]) : NULL;
+
+            //Distance between the drivers
+            if (last && (prevLanes[i]->getLength() - last->offset) + distCovered <= distanceBehind)
+            {
+                int distance = (prevLanes[i]->getLength() - last->offset) + distCovered;
+                setNearestVehicle(*backVehicles[i], distance, last->object);
+            }
+        }
+    }
+}
+
 void DriverMovement::perceivedDataProcess(NearestVehicle &nearestVehicle, DriverUpdateParams &params)
 {
     //Update your perceptions for leading vehicle and gap
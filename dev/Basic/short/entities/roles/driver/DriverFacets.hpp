@@ -165,6 +165,22 @@ private:
      */
     bool updateNearbyAgent(const Agent *nearbyAgent, const Driver *nearbyDriver);
 
+    /**
+     * Checks whether the nearby drivers can be found from the order of the drivers on the lanes alone. This is the case
+     * on a lane that is neither approaching nor leaving an intersection, where no driver on a turning path is nearby
+     *
+     * @return true if the lane index is sufficient, false if the nearby agents must be found by the aura manager
+     */
+    bool canUseLaneIndex();
+
+    /**
+     * Finds the nearest drivers ahead of and behind us on the current, adjacent, next and previous lanes from the
+     * order of the drivers on the lanes, and updates the lane density
+     *
+     * @param params the driver update parameters
+     */
+    void updateNearbyDriversFromLaneIndex(DriverUpdateParams &params);
+
     /**
      * Sets the current traffic signal based on the end node of the current link.
      */
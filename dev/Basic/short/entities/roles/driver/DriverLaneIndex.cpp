@@ -0,0 +1,42 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#include "DriverLaneIndex.hpp"
+
+#include "Driver.hpp"
+#include "entities/Agent.hpp"
+#include "entities/Person_ST.hpp"
+
+using namespace sim_mob;
+
+DriverLaneIndex DriverLaneIndex::instance_;
+
+void DriverLaneIndex::update(const std::set<Entity *> &removedAgents)
+{
+    entries.clear();
+    for (std::set<Entity *>::const_iterator it = Agent::all_agents.begin(); it != Agent::all_agents.end(); ++it)
+    {
+        if (removedAgents.find(*it) != removedAgents.end())
+        {
+            continue;
+        }
+
+        const Person_ST *person = dynamic_cast<const Person_ST *> (*it);
+
+        if (!person || !person->getRole())
+        {
+            continue;
+        }
+
+        const Driver *driver = dynamic_cast<const Driver *> (person->getRole());
+
+        if (!driver || driver->IsVehicleInLoadingQueue() || driver->IsInIntersection() || !driver->getCurrLane())
+        {
+            continue;
+        }
+
+        entries.push_back(Index::Entry(driver->getCurrLane(), driver->getDistCoveredOnCurrWayPt(), driver));
+    }
+    index.build(entries);
+}
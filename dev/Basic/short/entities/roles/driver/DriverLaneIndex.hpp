@@ -0,0 +1,65 @@
+//Copyright (c) 2013 Singapore-MIT Alliance for Research and Technology
+//Licensed under the terms of the MIT License, as described in the file:
+//   license.txt   (http://opensource.org/licenses/MIT)
+
+#pragma once
+
+#include <set>
+#include <vector>
+#include <boost/utility.hpp>
+
+#include "spatial_trees/LaneOrderedIndex.hpp"
+
+namespace sim_mob
+{
+class Driver;
+class Entity;
+class Lane;
+
+/**
+ * A singleton holding the order of the drivers on each lane.
+ *
+ * It is rebuilt after the positions of every time tick are published (along with the AuraManager), from the buffered
+ * lane and distance covered of each driver, so it shows every driver the same snapshot as the buffered values.
+ * The drivers in an intersection or in a loading queue are not indexed.
+ *
+ * It answers the leader and follower queries of car following and lane changing by a binary search on a lane,
+ * rather than by a spatial search of the AuraManager, which remains for the area queries.
+ */
+class DriverLaneIndex : private boost::noncopyable
+{
+public:
+    typedef LaneOrderedIndex<Lane, Driver> Index;
+
+    static DriverLaneIndex& instance()
+    {
+        return instance_;
+    }
+
+    /**
+     * Rebuilds the index from the drivers of all agents
+     *
+     * @param removedAgents agents removed in this time tick; their drivers are not indexed
+     */
+    void update(const std::set<Entity *> &removedAgents);
+
+    const Index& getIndex() const
+    {
+        return index;
+    }
+
+private:
+    DriverLaneIndex()
+    {
+    }
+
+    static DriverLaneIndex instance_;
+
+    /**The drivers on each lane, ordered by distance covered on the lane*/
+    Index index;
+
+    /**Entries collected by the last update, kept to reuse their storage*/
+    std::vector<Index::Entry> entries;
+};
+
+}
@@ -18,6 +18,7 @@
 #include "geospatial/network/Node.hpp"
 #include "geospatial/network/RoadSegment.hpp"
 #include "logging/Log.hpp"
+#include "util/CounterRandom.hpp"
 #include "util/GeomHelpers.hpp"
 #include "util/Utils.hpp"
 
@@ -36,14 +37,15 @@ const std::string DriverPathMover::ErrorEntireRouteDone("Entire route is done!")
 
 DriverPathMover::DriverPathMover() :
 currLane(NULL), currTurning(NULL), nextLane(NULL), nextTurning(NULL), currPolyLine(NULL), inIntersection(false), distCoveredFromCurrPtToNextPt(0.0),
-distCoveredOnCurrWayPt(0.0)
+distCoveredOnCurrWayPt(0.0), random(NULL)
 {
 }
 
 DriverPathMover::DriverPathMover(const DriverPathMover &pathMover) :
 currLane(pathMover.currLane), currTurning(pathMover.currTurning), nextLane(pathMover.nextLane), nextTurning(pathMover.nextTurning),
 currPolyLine(pathMover.currPolyLine), inIntersection(pathMover.inIntersection),
-distCoveredFromCurrPtToNextPt(pathMover.distCoveredFromCurrPtToNextPt), distCoveredOnCurrWayPt(pathMover.distCoveredOnCurrWayPt)
+distCoveredFromCurrPtToNextPt(pathMover.distCoveredFromCurrPtToNextPt), distCoveredOnCurrWayPt(pathMover.distCoveredOnCurrWayPt),
+random(pathMover.random)
 {
     //Align the iterators
     currWayPointIt = drivingPath.begin() + (pathMover.currWayPointIt - pathMover.drivingPath.begin());
@@ -53,6 +55,20 @@ distCoveredFromCurrPtToNextPt(pathMover.distCoveredFromCurrPtToNextPt), distCove
     nextPolyPoint = polyPoints.begin() + (pathMover.nextPolyPoint - pathMover.currPolyLine->getPoints().begin());
 }
 
+void DriverPathMover::setRandom(CounterRandom *random)
+{
+    this->random = random;
+}
+
+unsigned int DriverPathMover::chooseRandomly(std::size_t noOfOptions)
+{
+    if (random)
+    {
+        return random->nextInt(0, noOfOptions - 1);
+    }
+    return Utils::generateInt(0, noOfOptions - 1);
+}
+
 const Lane* DriverPathMover::getCurrLane() const
 {
     return currLane;
@@ -259,7 +275,7 @@ const Lane* DriverPathMover::getNextLane()
             if (!trueConnections.empty())
             {
                 //Choose the a connection randomly
-                unsigned int randomInt = Utils::generateInt(0, trueConnections.size() - 1);
+                unsigned int randomInt = chooseRandomly(trueConnections.size());
                 nextLane = trueConnections.at(randomInt)->getToLane();
             }
         }
@@ -289,7 +305,7 @@ const TurningPath* DriverPathMover::getNextTurning()
                     if(turnings->size() > 1)
                     {
                         //Select a random turning path
-                        unsigned int randomInt = Utils::generateInt(0, turnings->size() - 1);
+                        unsigned int randomInt = chooseRandomly(turnings->size());
                         std::map<unsigned int, TurningPath *>::const_iterator it = turnings->begin();
                         std::advance(it, randomInt);
                         nextTurning = it->second;
@@ -390,7 +406,7 @@ void DriverPathMover::setPathStartingWithTurningGroup(const std::vector<WayPoint
             if (turnings->size() > 1)
             {
                 //Select a random turning path
-                unsigned int randomInt = Utils::generateInt(0, turnings->size() - 1);
+                unsigned int randomInt = chooseRandomly(turnings->size());
                 std::map<unsigned int, TurningPath *>::const_iterator it = turnings->begin();
                 std::advance(it, randomInt);
                 currTurning = it->second;
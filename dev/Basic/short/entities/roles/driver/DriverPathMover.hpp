@@ -17,6 +17,7 @@
 namespace sim_mob
 {
 class RoadSegment;
+class CounterRandom;
 class Link;
 class Lane;
 class PackageUtils;
@@ -66,6 +67,19 @@ private:
 
     /**Stores the distance covered by the driver on the current way-point*/
     double distCoveredOnCurrWayPt;
+
+    /**The random numbers of the driver, used to choose between lanes and turning paths. May be null*/
+    CounterRandom *random;
+
+    /**
+     * Chooses one of several options at random
+     *
+     * @param noOfOptions the number of options
+     *
+     * @return index of the chosen option, in [0, noOfOptions)
+     */
+    unsigned int chooseRandomly(std::size_t noOfOptions);
+
     /**
      * Calculates the distance between the current poly-point and the next poly-point
      *
@@ -107,6 +121,14 @@ public:
     DriverPathMover();
     DriverPathMover(const DriverPathMover &pathMover);
 
+    /**
+     * Sets the random numbers to be used to choose between lanes and turning paths. Without them, the thread local
+     * generator of Utils is used
+     *
+     * @param random the random numbers of the driver
+     */
+    void setRandom(CounterRandom *random);
+
     const Lane* getCurrLane() const;
     const TurningPath* getCurrTurning() const;
     
@@ -52,6 +52,9 @@ void DriverUpdateParams::reset(timeslice now, const Driver &owner)
 {
     UpdateParams::reset(now);
 
+    //The draws of this tick depend only on the seed, the person and the tick
+    random.reset(ConfigManager::GetInstance().FullConfig().simulation.seedValue, parentId, now.frame());
+
     //Set to the previous known buffered values
     currLane = owner.getCurrLane();
 
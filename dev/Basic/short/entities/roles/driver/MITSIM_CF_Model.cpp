@@ -111,7 +111,7 @@ void MITSIM_CF_Model::readDriverParameters(DriverUpdateParams &params)
     parameterMgr->param(modelName, "hbuffer_lower", hBufferLower, 0.8);
     parameterMgr->param(modelName, "hbuffer_Upper", hBufferUpperStr, string("1.7498 2.2737 2.5871 2.8379 3.0633 3.2814 3.5068 3.7578 4.0718 4.5979"));
     createScaleIndices(hBufferUpperStr, hBufferUpperScale);
-    hBufferUpper = getH_BufferUpperBound();
+    hBufferUpper = getH_BufferUpperBound(params);
 
     string cfParamStr;
     parameterMgr->param(modelName, "CF_parameters_1", cfParamStr, string("0.0400, 0.7220, 0.2420, 0.6820, 0.6000, 0.8250"));
@@ -145,11 +145,7 @@ void MITSIM_CF_Model::readDriverParameters(DriverUpdateParams &params)
 
     parameterMgr->param(modelName, "driver_signal_perception_distance", signalVisibilityDist, 75.0);
 
-    boost::random_device seed_gen;
-    long int seed = seed_gen();
-    updateSizeRNG = boost::mt19937(seed);
-
-    calcUpdateStepSizes();
+    calcUpdateStepSizes(params);
 
     //Initialise step size, i = 3 is for stopped vehicle
     params.nextStepSize = updateStepSize[3];
@@ -350,7 +346,7 @@ double MITSIM_CF_Model::getMaxAcceleration(DriverUpdateParams &params, VehicleBa
 
     double maxTableAcc = maxAccelerationIndex[vhType][speed];
 
-    double maxAcc = (maxTableAcc - allGrades * accGradeFactor) * getMaxAccScalar();
+    double maxAcc = (maxTableAcc - allGrades * accGradeFactor) * getMaxAccScalar(params);
 
     return maxAcc;
 }
@@ -371,7 +367,7 @@ double MITSIM_CF_Model::getNormalDeceleration(DriverUpdateParams &params, Vehicl
 
     double normalDec = normalDecelerationIndex[vhType][speed];
 
-    double dec = (normalDec - allGrades * accGradeFactor) * getNormalDecScalar();
+    double dec = (normalDec - allGrades * accGradeFactor) * getNormalDecScalar(params);
 
     return dec;
 }
@@ -392,70 +388,70 @@ double MITSIM_CF_Model::getMaxDeceleration(DriverUpdateParams &params, VehicleBa
 
     double maxDec = maxDecelerationIndex[vhType][speed];
 
-    double dec = (maxDec - allGrades * accGradeFactor) * getMaxDecScalar();
+    double dec = (maxDec - allGrades * accGradeFactor) * getMaxDecScalar(params);
 
     return dec;
 }
 
-double MITSIM_CF_Model::getMaxAccScalar()
+double MITSIM_CF_Model::getMaxAccScalar(DriverUpdateParams &params)
 {
-    int scaleNo = Utils::generateInt(1, maxAccelerationScale.size() - 1);
-    double res = Utils::generateFloat(maxAccelerationScale[scaleNo - 1], maxAccelerationScale[scaleNo]);
+    int scaleNo = params.random.nextInt(1, maxAccelerationScale.size() - 1);
+    double res = params.random.nextUniform(maxAccelerationScale[scaleNo - 1], maxAccelerationScale[scaleNo]);
 
     return res;
 }
 
-double MITSIM_CF_Model::getNormalDecScalar()
+double MITSIM_CF_Model::getNormalDecScalar(DriverUpdateParams &params)
 {
-    int scaleNo = Utils::generateInt(1, normalDecelerationScale.size() - 1);
-    double res = Utils::generateFloat(normalDecelerationScale[scaleNo - 1], normalDecelerationScale[scaleNo]);
+    int scaleNo = params.random.nextInt(1, normalDecelerationScale.size() - 1);
+    double res = params.random.nextUniform(normalDecelerationScale[scaleNo - 1], normalDecelerationScale[scaleNo]);
 
     return res;
 }
 
-double MITSIM_CF_Model::getMaxDecScalar()
+double MITSIM_CF_Model::getMaxDecScalar(DriverUpdateParams &params)
 {
-    int scaleNo = Utils::generateInt(1, maxDecelerationScale.size() - 1);
-    double res = Utils::generateFloat(normalDecelerationScale[scaleNo - 1], normalDecelerationScale[scaleNo]);
+    int scaleNo = params.random.nextInt(1, maxDecelerationScale.size() - 1);
+    double res = params.random.nextUniform(normalDecelerationScale[scaleNo - 1], normalDecelerationScale[scaleNo]);
 
     return res;
 }
 
-double MITSIM_CF_Model::getSpeedLimitAddon()
+double MITSIM_CF_Model::getSpeedLimitAddon(DriverUpdateParams &params)
 {
-    int scaleNo = Utils::generateInt(1, speedLimitAddon.size() - 1);
-    double res = Utils::generateFloat(speedLimitAddon[scaleNo - 1], speedLimitAddon[scaleNo]);
+    int scaleNo = params.random.nextInt(1, speedLimitAddon.size() - 1);
+    double res = params.random.nextUniform(speedLimitAddon[scaleNo - 1], speedLimitAddon[scaleNo]);
 
     return res;
 }
 
-double MITSIM_CF_Model::getAccelerationAddon()
+double MITSIM_CF_Model::getAccelerationAddon(DriverUpdateParams &params)
 {
-    int scaleNo = Utils::generateInt(1, accelerationAddon.size() - 1);
-    double res = Utils::generateFloat(accelerationAddon[scaleNo - 1], accelerationAddon[scaleNo]);
+    int scaleNo = params.random.nextInt(1, accelerationAddon.size() - 1);
+    double res = params.random.nextUniform(accelerationAddon[scaleNo - 1], accelerationAddon[scaleNo]);
 
     return res;
 }
 
-double MITSIM_CF_Model::getDecelerationAddon()
+double MITSIM_CF_Model::getDecelerationAddon(DriverUpdateParams &params)
 {
-    int scaleNo = Utils::generateInt(1, decelerationAddon.size() - 1);
-    double res = Utils::generateFloat(decelerationAddon[scaleNo - 1], decelerationAddon[scaleNo]);
+    int scaleNo = params.random.nextInt(1, decelerationAddon.size() - 1);
+    double res = params.random.nextUniform(decelerationAddon[scaleNo - 1], decelerationAddon[scaleNo]);
 
     return res;
 }
 
-double MITSIM_CF_Model::getH_BufferUpperBound()
+double MITSIM_CF_Model::getH_BufferUpperBound(DriverUpdateParams &params)
 {
-    int scaleNo = Utils::generateInt(1, hBufferUpperScale.size() - 1);
-    double res = Utils::generateFloat(hBufferUpperScale[scaleNo - 1], hBufferUpperScale[scaleNo]);
+    int scaleNo = params.random.nextInt(1, hBufferUpperScale.size() - 1);
+    double res = params.random.nextUniform(hBufferUpperScale[scaleNo - 1], hBufferUpperScale[scaleNo]);
 
     return res;
 }
 
-double MITSIM_CF_Model::getHeadwayBuffer()
+double MITSIM_CF_Model::getHeadwayBuffer(DriverUpdateParams &params)
 {
-    return Utils::generateFloat(hBufferLower, hBufferUpper);
+    return params.random.nextUniform(hBufferLower, hBufferUpper);
 }
 
 double MITSIM_CF_Model::makeAcceleratingDecision(DriverUpdateParams &params)
@@ -664,7 +660,7 @@ double MITSIM_CF_Model::calcCarFollowingAcc(DriverUpdateParams &params, NearestV
             debugStr << "LO;";
         }
 
-        hBufferUpper = getH_BufferUpperBound();
+        hBufferUpper = getH_BufferUpperBound(params);
 
         if (headway > hBufferUpper)
         {
@@ -707,7 +703,7 @@ double MITSIM_CF_Model::calcMergingAcc(DriverUpdateParams &params)
         {
             if (params.nvLeadFreeway.exists())
             {
-                double headway = getHeadwayBuffer();
+                double headway = getHeadwayBuffer(params);
 
                 if (params.nvLeadFreeway.distance < headway)
                 {
@@ -777,7 +773,7 @@ bool MITSIM_CF_Model::isGapAcceptable(DriverUpdateParams &params, NearestVehicle
     // Speed at the predicted position
     speedOfOtherVehicle += maxAcc * dt;
 
-    float sd = (speedOfOtherVehicle - speed) * getHeadwayBuffer();
+    float sd = (speedOfOtherVehicle - speed) * getHeadwayBuffer(params);
     float threshold = (sd > 0.0) ? sd : 0.0;
 
     //Check if the gap is acceptable
@@ -1112,7 +1108,7 @@ double MITSIM_CF_Model::calcDesiredSpeed(DriverUpdateParams &params)
 
     float desired = speedFactor * speedOnSign;
 
-    desired = desired * (1 + getSpeedLimitAddon());
+    desired = desired * (1 + getSpeedLimitAddon(params));
 
     if(params.currLane)
     {
@@ -1172,7 +1168,7 @@ double MITSIM_CF_Model::calcForwardGapAcc(DriverUpdateParams &params)
         acc *= pow(-dv, gapAcceptanceParams[4]);
     }
 
-    acc += getAccelerationAddon() * gapAcceptanceParams[5] / 0.824;
+    acc += getAccelerationAddon(params) * gapAcceptanceParams[5] / 0.824;
     return acc;
 }
 
@@ -1224,7 +1220,7 @@ double MITSIM_CF_Model::calcBackwardGapAcc(DriverUpdateParams &params)
         acc *= pow(-dv, gapAcceptanceParams[9]);
     }
 
-    acc += getAccelerationAddon() * gapAcceptanceParams[10] / 0.824;
+    acc += getAccelerationAddon(params) * gapAcceptanceParams[10] / 0.824;
     return acc;
 }
 
@@ -1271,7 +1267,7 @@ double MITSIM_CF_Model::calcAdjacentGapRate(DriverUpdateParams& p)
     float position = adjRearDriver->gapDistance(p.driver) + p.driver->getVehicleLength();
     float acc = gapAcceptanceParams[11] * (gapAcceptanceParams[0] * gap - position);
 
-    acc += getAccelerationAddon() * gapAcceptanceParams[12] / 0.824;
+    acc += getAccelerationAddon(p) * gapAcceptanceParams[12] / 0.824;
     p.lcDebugStr << "+++acc+++" << acc;
 
     return acc;
@@ -1451,7 +1447,7 @@ double MITSIM_CF_Model::calcAccOfCarFollowing(DriverUpdateParams &params)
 
     double res = CF_parameters[i].alpha * pow(velocity, CF_parameters[i].beta) / pow(params.nvFwd.distance, CF_parameters[i].gama);
     res *= pow(dv, CF_parameters[i].lambda) * pow(density, CF_parameters[i].rho);
-    res += feet2Unit(Utils::nRandom(0, CF_parameters[i].stddev));
+    res += feet2Unit(params.random.nextNormal(0, CF_parameters[i].stddev));
 
     return res;
 }
@@ -1524,10 +1520,10 @@ void MITSIM_CF_Model::calcStateBasedVariables(DriverUpdateParams &params)
     params.unsetStatus(STATUS_REGIME);
 }
 
-void MITSIM_CF_Model::calcUpdateStepSizes()
+void MITSIM_CF_Model::calcUpdateStepSizes(DriverUpdateParams &params)
 {
     //Deceleration
-    double totalReactionTime = sampleFromNormalDistribution(decUpdateStepSize);
+    double totalReactionTime = sampleFromNormalDistribution(params, decUpdateStepSize);
 
     //Perception time  = reaction time * perception percentage
     double perceptionTime = totalReactionTime * decUpdateStepSize.perception;
@@ -1536,7 +1532,7 @@ void MITSIM_CF_Model::calcUpdateStepSizes()
     perceptionSize.push_back(perceptionTime);
 
     //Acceleration
-    totalReactionTime = sampleFromNormalDistribution(accUpdateStepSize);
+    totalReactionTime = sampleFromNormalDistribution(params, accUpdateStepSize);
 
     //Perception time  = reaction time * perception percentage
     perceptionTime = totalReactionTime * accUpdateStepSize.perception;
@@ -1545,7 +1541,7 @@ void MITSIM_CF_Model::calcUpdateStepSizes()
     perceptionSize.push_back(perceptionTime);
 
     //Uniform Speed
-    totalReactionTime = sampleFromNormalDistribution(uniformSpeedUpdateStepSize);
+    totalReactionTime = sampleFromNormalDistribution(params, uniformSpeedUpdateStepSize);
 
     //Perception time  = reaction time * perception percentage
     perceptionTime = totalReactionTime * uniformSpeedUpdateStepSize.perception;
@@ -1554,7 +1550,7 @@ void MITSIM_CF_Model::calcUpdateStepSizes()
     perceptionSize.push_back(perceptionTime);
 
     //Stopped vehicle
-    totalReactionTime = sampleFromNormalDistribution(stoppedUpdateStepSize);
+    totalReactionTime = sampleFromNormalDistribution(params, stoppedUpdateStepSize);
 
     //Perception time  = reaction time * perception percentage
     perceptionTime = totalReactionTime * stoppedUpdateStepSize.perception;
@@ -1563,7 +1559,7 @@ void MITSIM_CF_Model::calcUpdateStepSizes()
     perceptionSize.push_back(perceptionTime);
 }
 
-double MITSIM_CF_Model::sampleFromNormalDistribution(UpdateStepSizeParam &stepSizeParams)
+double MITSIM_CF_Model::sampleFromNormalDistribution(DriverUpdateParams &params, UpdateStepSizeParam &stepSizeParams)
 {
 
     if (stepSizeParams.mean == 0)
@@ -1571,9 +1567,7 @@ double MITSIM_CF_Model::sampleFromNormalDistribution(UpdateStepSizeParam &stepSi
         return 0;
     }
 
-    boost::lognormal_distribution<double> nor(stepSizeParams.mean, stepSizeParams.stdev);
-    boost::variate_generator<boost::mt19937, boost::lognormal_distribution<double> > dice(updateSizeRNG, nor);
-    double v = dice();
+    double v = params.random.nextLognormal(stepSizeParams.mean, stepSizeParams.stdev);
 
     if (v < stepSizeParams.lower)
     {
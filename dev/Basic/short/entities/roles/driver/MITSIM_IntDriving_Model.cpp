@@ -229,7 +229,7 @@ double MITSIM_IntDriving_Model::makeAcceleratingDecision(DriverUpdateParams &par
     const TurningGroup *currTurningGroup = currTurning->getTurningGroup();
 
     //Reduce the reaction time in intersection          
-    params.reactionTimeCounter = params.reactionTimeCounter * Utils::generateFloat(intersectionAttentivenessFactorMin, intersectionAttentivenessFactorMax);
+    params.reactionTimeCounter = params.reactionTimeCounter * params.random.nextUniform(intersectionAttentivenessFactorMin, intersectionAttentivenessFactorMax);
 
     //Safety margin distance in front of the vehicle (half a vehicle length seems a reasonable margin)
     const double safeDist = 1.5 * vehicleLength;
@@ -372,7 +372,7 @@ double MITSIM_IntDriving_Model::makeAcceleratingDecision(DriverUpdateParams &par
             double criticalGap = conflict->getCriticalGap();
 
             //Add a random add-on value
-            criticalGap += Utils::nRandom(criticalGapAddOn[0], criticalGapAddOn[1]);
+            criticalGap += params.random.nextNormal(criticalGapAddOn[0], criticalGapAddOn[1]);
 
             //Reduce by impatience on if equal priority
             if (priority == 0)
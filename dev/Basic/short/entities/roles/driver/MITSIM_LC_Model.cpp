@@ -92,7 +92,7 @@ void MITSIM_LC_Model::readDriverParameters(DriverUpdateParams &params)
     parameterMgr->param(modelName, "min_speed", minSpeed, 0.1);
 
     //Driver look ahead distance
-    lookAheadDistance = mlcDistance();
+    lookAheadDistance = mlcDistance(params);
 
     //Lane Utility parameters
     parameterMgr->param(modelName, "lane_utility_model", str, string("3.9443 -0.3213  -1.1683  -1.1683 0.0 0.0633 -1.0 0.0058 -0.2664 -0.0088 -3.3754 10 19 -2.3400 -4.5084 -2.8257 -1.2597 -0.7239 -0.3269"));
@@ -143,9 +143,7 @@ double MITSIM_LC_Model::calcCriticalGapKaziModel(DriverUpdateParams &params, int
     double dvPositive = (diffInSpeed > 0) ? diffInSpeed : 0.0;
     double gap = b[0] + b[1] * rem_dist_impact + b[2] * diffInSpeed + b[3] * dvNegative + b[4] * dvPositive;
 
-    boost::normal_distribution<> nrand(0, b[4]);
-    boost::variate_generator< boost::mt19937, boost::normal_distribution<> > normal(params.gen, nrand);
-    double u = gap + normal();
+    double u = gap + params.random.nextNormal(0, b[4]);
     double criGap = 0;
 
     if (u < -4.0)
@@ -407,7 +405,7 @@ void MITSIM_LC_Model::chooseTargetGap(DriverUpdateParams &params)
     double eubck = gapExpOfUtility(params, 2, effectiveGap, dis2gap, gapSpeed, remainderGap);
 
     double sum = eufwd + eubck + euadj;
-    double rnd = Utils::uRandom();
+    double rnd = params.random.nextUniform();
     if (rnd < euadj / sum) params.setStatus(STATUS_ADJACENT);
     else if (rnd < (euadj + eubck) / sum) params.setStatus(STATUS_BACKWARD);
     else params.setStatus(STATUS_FORWARD);
@@ -587,7 +585,7 @@ LaneChangeTo MITSIM_LC_Model::checkForLC_WithLookAhead(DriverUpdateParams &param
 
     sum += euc;
 
-    double rnd = Utils::generateFloat(0, 1);
+    double rnd = params.random.nextUniform();
     if (rnd >= 1.0) rnd = 0.99;
     params.lcDebugStr << ";rnd" << rnd;
     float probOfCurrentLane = euc / sum;
@@ -1259,13 +1257,13 @@ double MITSIM_LC_Model::lcCriticalGap(DriverUpdateParams &params, int type, doub
     case 0:
     {
         // lead gap
-        gap = a[0] + a[1] * dvNegative + a[2] * dvPositive + Utils::nRandom(0, a[3]);
+        gap = a[0] + a[1] * dvNegative + a[2] * dvPositive + params.random.nextNormal(0, a[3]);
         break;
     }
     case 1:
     {
         // lag gap
-        gap = a[4] + a[5] * dvNegative + a[6] * std::min<double>(dvPositive, maxdiff) + Utils::nRandom(0, a[7]);
+        gap = a[4] + a[5] * dvNegative + a[6] * std::min<double>(dvPositive, maxdiff) + params.random.nextNormal(0, a[7]);
         break;
     }
     }
@@ -1275,9 +1273,9 @@ double MITSIM_LC_Model::lcCriticalGap(DriverUpdateParams &params, int type, doub
     return cri_gap;
 }
 
-double MITSIM_LC_Model::mlcDistance()
+double MITSIM_LC_Model::mlcDistance(DriverUpdateParams &params)
 {
-    double n = Utils::generateFloat(0, 1.0);
+    double n = params.random.nextUniform();
     double dis = MLC_PARAMETERS.lowbound + n * (MLC_PARAMETERS.delta - MLC_PARAMETERS.lowbound);
     return dis;
 }
@@ -1493,7 +1491,7 @@ double MITSIM_LC_Model::executeLaneChanging(DriverUpdateParams &params)
                 // forced merging must be performed in current link
             }
 
-            nosing = Utils::brandom(pmf);
+            nosing = params.random.nextBernoulli(pmf);
         }
 
         params.unsetFlag(FLAG_NOSING); // reset the flag
@@ -2377,7 +2375,7 @@ LaneChangeTo MITSIM_LC_Model::checkMandatoryEventLC(DriverUpdateParams &params)
 
     sum += euc;
 
-    double rnd = Utils::urandom();  
+    double rnd = params.random.nextUniform();  
     float probOfCurrentLane = euc / sum;
     float probOfCL_LL = probOfCurrentLane + eul / sum;
 
@@ -5,7 +5,6 @@
 #include "geospatial/network/RoadNetwork.hpp"
 #include "OnCallDriver.hpp"
 #include "path/PathSetManager.hpp"
-#include "util/Utils.hpp"
 #include "entities/vehicle/Vehicle.hpp"
 #include "message/ST_Message.hpp"
 using namespace sim_mob;
@@ -347,7 +346,7 @@ void OnCallDriverMovement::frame_tick()
  #endif
 
      //Select one node from the reachable nodes at random
-     unsigned int random = Utils::generateInt(0, reachableNodes.size() - 1);
+     unsigned int random = onCallDriver->getParams().random.nextInt(0, reachableNodes.size() - 1);
      const Node *selectedNode = reachableNodes[random];
 
      //Check if we've selected a node which is the same as the fromNode
@@ -365,7 +364,7 @@ const Node* OnCallDriverBehaviour::chooseRandomNode() const
 {
     auto nodeMap = RoadNetwork::getInstance()->getMapOfIdvsNodes();
     auto itRandomNode = nodeMap.begin();
-    advance(itRandomNode, Utils::generateInt(0, nodeMap.size() - 1));
+    advance(itRandomNode, onCallDriver->getParams().random.nextInt(0, nodeMap.size() - 1));
 
     const Node *result = itRandomNode->second;
 
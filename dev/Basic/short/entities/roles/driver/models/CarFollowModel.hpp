@@ -147,9 +147,6 @@ private:
     /**Defines how close the lead vehicle needs to be in order for the following vehicle to brake (in meter)*/
     double visibilityDistance;
 
-    /**Random number generator for calculating update step sizes*/
-    boost::mt19937 updateSizeRNG;
-
     /**The car following parameters*/
     CarFollowingParams CF_parameters[2];
 
@@ -246,11 +243,12 @@ private:
     /**
      * Builds and gets a sample from the normal distribution created from the given parameters
      *
+     * @param params the driver parameters, whose random numbers are used
      * @param stepSizeParams the step size parameters from which the distribution is to be created and sampled
      *
      * @return sampled value from the distribution
      */
-    double sampleFromNormalDistribution(UpdateStepSizeParam &stepSizeParams);
+    double sampleFromNormalDistribution(DriverUpdateParams &params, UpdateStepSizeParam &stepSizeParams);
 
     /**
      * Returns the maximum acceleration for the given vehicle type
@@ -284,23 +282,29 @@ private:
     /**
      * Calculates the maximum acceleration scalar
      *
+     * @param params the driver parameters, whose random numbers are used
+     *
      * @return maximum acceleration scalar
      */
-    double getMaxAccScalar();
+    double getMaxAccScalar(DriverUpdateParams &params);
 
     /**
      * Calculates the normal deceleration scalar
      *
+     * @param params the driver parameters, whose random numbers are used
+     *
      * @return normal deceleration scalar
      */
-    double getNormalDecScalar();
+    double getNormalDecScalar(DriverUpdateParams &params);
 
     /**
      * Calculates the maximum deceleration scalar
      *
+     * @param params the driver parameters, whose random numbers are used
+     *
      * @return maximum deceleration scalar
      */
-    double getMaxDecScalar();
+    double getMaxDecScalar(DriverUpdateParams &params);
 
     /**
      * Calculates the acceleration based on the car-following constraints. 
@@ -526,44 +530,56 @@ private:
 
     /**
      * Calculates the step sizes for making car-following decisions
+     *
+     * @param params the driver parameters, whose random numbers are used
      */
-    void calcUpdateStepSizes();
+    void calcUpdateStepSizes(DriverUpdateParams &params);
 
     /**
      * Calculates the upper bound of the headway buffer
      *
+     * @param params the driver parameters, whose random numbers are used
+     *
      * @return upper bound of the headway buffer
      */
-    double getH_BufferUpperBound();
+    double getH_BufferUpperBound(DriverUpdateParams &params);
 
     /**
      * Calculates a headway buffer for a vehicle, which is a behavioural parameter that describes the aggressiveness
      * of a driver for accepting a headway gap in lane changing, merging, and car-following.
      *
+     * @param params the driver parameters, whose random numbers are used
+     *
      * @return headway (seconds)
      */
-    double getHeadwayBuffer();
+    double getHeadwayBuffer(DriverUpdateParams &params);
 
     /**
      * Calculates the add on for calculating the desired speed
      *
+     * @param params the driver parameters, whose random numbers are used
+     *
      * @return add on value (m/s)
      */
-    double getSpeedLimitAddon();
+    double getSpeedLimitAddon(DriverUpdateParams &params);
 
     /**
      * Calculates the add on for the acceleration
      *
+     * @param params the driver parameters, whose random numbers are used
+     *
      * @return add on value (m/s^2)
      */
-    double getAccelerationAddon();
+    double getAccelerationAddon(DriverUpdateParams &params);
 
     /**
      * Calculates the add on for the deceleration
      *
+     * @param params the driver parameters, whose random numbers are used
+     *
      * @return add on value (m/s^2)
      */
-    double getDecelerationAddon();
+    double getDecelerationAddon(DriverUpdateParams &params);
 
     double upMergingArea()
     {
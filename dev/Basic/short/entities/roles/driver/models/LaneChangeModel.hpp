@@ -403,9 +403,10 @@ private:
 
     /**
      * Mandatory lane change distance for lookahead vehicles
+     * @param params the driver parameters, whose random numbers are used
      * @return lookahead distance (metre)
      */
-    double mlcDistance();
+    double mlcDistance(DriverUpdateParams &params);
 
     /**
      * Uses the Kazi LC Gap Model to calculate the critical gap
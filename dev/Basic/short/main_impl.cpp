@@ -41,6 +41,7 @@
 #include "entities/PT_Statistics.hpp"
 #include "entities/roles/activityRole/ActivityPerformer.hpp"
 #include "entities/roles/driver/driverCommunication/DriverComm.hpp"
+#include "entities/roles/driver/DriverLaneIndex.hpp"
 #include "entities/roles/pedestrian/Pedestrian.hpp"
 #include "entities/fmodController/FMOD_Controller.hpp"
 #include "geospatial/network/NetworkLoader.hpp"
@@ -221,6 +222,12 @@ bool performMain(const std::string& configFileName, const std::string& shortConf
     //Initialise the aura manager
     AuraManager::instance().init(stCfg.aura_manager_impl());
 
+    //The order of the drivers on the lanes is rebuilt along with the aura manager
+    AuraManager::instance().addUpdateListener([](const std::set<Entity *> &removedAgents)
+    {
+        DriverLaneIndex::instance().update(removedAgents);
+    });
+
     //Initialise all work groups (this creates barriers, and locks down creation of new groups).
     wgMgr.initAllGroups();
     
@@ -333,6 +340,7 @@ bool performMain(const std::string& configFileName, const std::string& shortConf
     StateSwitcher<int> numTicksShown(0); //Only goes up to 10
     StateSwitcher<int> lastTickPercent(0); //So we have some idea how much time is left.
     int endTick = config.totalRuntimeTicks;
+    const unsigned int ttIntervalMS = config.PathSetMode() ? TravelTimeManager::getInstance()->intervalMS : 0;
     
     for (unsigned int currTick = 0; currTick < endTick; currTick++) 
     {
@@ -377,6 +385,13 @@ bool performMain(const std::string& configFileName, const std::string& shortConf
             ClosedLoopRunManager::waitForDynaMIT(config);
         }
 
+        //Publish the in-simulation travel times of the interval that ended, for path evaluation
+        //(the travel time intervals are aligned to the time of day, not to the start of the simulation)
+        if (ttIntervalMS > 0 && (config.simStartTime().getValue() + currTimeMS + config.baseGranMS()) % ttIntervalMS == 0)
+        {
+            TravelTimeManager::getInstance()->publishTravelTimeTable();
+        }
+
         if(stCfg.outputStats.segDensityMap.outputEnabled && ((currTimeMS + config.baseGranMS()) % stCfg.outputStats.segDensityMap.updateInterval == 0))
         {
             DriverMovement::outputDensityMap((unsigned int) (currTimeMS / stCfg.outputStats.segDensityMap.updateInterval));